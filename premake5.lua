@@ -26,7 +26,9 @@ workspace "helios"
     
     -- Projects
     include "projects/application"
+    include "projects/benchmarks"
     include "projects/containers"
+    include "projects/cooker"
     include "projects/core"
     include "projects/math"
     include "projects/tests"
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <helios/core/application.hpp>
+
+#include <functional>
+
+class DemoApplication final : public helios::Application
+{
+public:
+    void initialize() override;
+
+    // Runs the engine frame loop with the sample's input and render in
+    // place of the defaults, so the engine systems still tick every step.
+    // Returns once input returns false.
+    void runSample(std::function<bool()> input, std::function<void(f64 alpha)> render);
+
+protected:
+    bool input() override;
+    void render(f64 alpha) override;
+
+private:
+    std::function<bool()> _input;
+    std::function<void(f64)> _render;
+};
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <helios/containers/vector.hpp>
+#include <helios/core/cooked_mesh.hpp>
+#include <helios/core/cooked_texture.hpp>
 #include <helios/core/mesh.hpp>
 #include <helios/render/graphics.hpp>
+#include <helios/render/texture.hpp>
 
 helios::EPresentMode get_best_present_mode(
     const helios::vector<helios::EPresentMode>& supported);
@@ -16,3 +19,14 @@ void uploadMesh(helios::vector<helios::IBuffer*>& out,
                 helios::IBuffer** elements, helios::IDevice* device,
                 helios::IQueue* queue, helios::ICommandBuffer* commandBuffer,
                 helios::Mesh* mesh);
+
+void uploadMesh(helios::vector<helios::IBuffer*>& out,
+                helios::IBuffer** elements, helios::IDevice* device,
+                helios::IQueue* queue, helios::ICommandBuffer* commandBuffer,
+                const helios::CookedMesh::SubMesh& mesh);
+
+// Uploads every level of a cooked texture from one staging buffer with a
+// single copy and leaves the image ready for sampling.
+helios::Texture uploadTexture(helios::IDevice* device, helios::IQueue* queue,
+                              helios::ICommandBuffer* commandBuffer,
+                              const helios::CookedTexture& texture);
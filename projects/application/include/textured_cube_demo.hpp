@@ -1,6 +1,10 @@
 #pragma once
 
+class DemoApplication;
+
 namespace textured_cube
 {
-    void run();
+    // Renders from the frame loop of app until the window is closed or
+    // escape is pressed.
+    void run(DemoApplication& app);
 };
\ No newline at end of file
@@ -36,14 +36,15 @@ project "application"
         "%{IncludeDir.fxgltf}", -- TODO: Remove once abstraction created
         "%{IncludeDir.json}", -- TODO: Remove once abstraction created
         "%{IncludeDir.math}",
-        "%{IncludeDir.stb}", -- TODO: Remove once abstraction created
         "%{IncludeDir.tf}"
     }
 
     defines {
     	"GLFW_INCLUDE_NONE",
     }
-    
+
+    vectorextensions "AVX2"
+
     filter "system:windows"
         toolset "msc-ClangCL"
         systemversion "latest"
@@ -1,9 +1,11 @@
 #include "demo_utils.hpp"
 
+#include <helios/core/cooked_mesh.hpp>
+#include <helios/core/cooked_texture.hpp>
 #include <helios/core/mesh.hpp>
+#include <helios/io/file.hpp>
 #include <helios/render/graphics.hpp>
 
-#include <fstream>
 #include <iostream>
 
 helios::EPresentMode get_best_present_mode(
@@ -35,38 +37,30 @@ helios::ISurface::SurfaceFormat get_best_surface_format(
 
 helios::vector<uint8_t> read(const std::string& filename)
 {
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-    helios::vector<uint8_t> res;
-    if (file.is_open())
-    {
-        const size_t sz = static_cast<size_t>(file.tellg());
-        res.resize(sz);
-        file.seekg(0);
-        file.read(reinterpret_cast<char*>(res.data()), sz);
-        file.close();
-    }
-    return res;
+    return helios::File::read_binary(filename);
 }
 
-void uploadMesh(helios::vector<helios::IBuffer*>& out,
-                helios::IBuffer** elements, helios::IDevice* device,
-                helios::IQueue* queue, helios::ICommandBuffer* commandBuffer,
-                helios::Mesh* mesh)
+static void uploadStreams(helios::vector<helios::IBuffer*>& out,
+                          helios::IBuffer** elements, helios::IDevice* device,
+                          helios::IQueue* queue,
+                          helios::ICommandBuffer* commandBuffer,
+                          const helios::span<const u8>* streams,
+                          const u32 count,
+                          const helios::span<const u8> indices)
 {
     using namespace helios;
 
     commandBuffer->record();
     auto stagingFence = FenceBuilder().device(device).build();
     stagingFence->reset();
-    out.reserve(mesh->bufferCount());
-    u32 count = mesh->bufferCount();
+    out.reserve(count);
 
     vector<IBuffer*> staging;
 
     for (u32 i = 0; i < count; i++)
     {
-        void* data = mesh->readBuffer(i);
-        u64 size = mesh->bufferSize(i);
+        const void* data = streams[i].data();
+        u64 size = streams[i].size_bytes();
 
         auto stagingBuffer = BufferBuilder()
                                  .device(device)
@@ -94,9 +88,9 @@ void uploadMesh(helios::vector<helios::IBuffer*>& out,
         out.push_back(resultBuffer);
     }
 
-    if (!mesh->triangles.empty())
+    if (!indices.empty())
     {
-        u64 size = sizeof(u32) * mesh->triangles.size();
+        u64 size = indices.size_bytes();
         auto stagingBuffer = BufferBuilder()
                                  .device(device)
                                  .size(size)
@@ -106,7 +100,7 @@ void uploadMesh(helios::vector<helios::IBuffer*>& out,
                                  .build();
         staging.push_back(stagingBuffer);
         void* payload = stagingBuffer->map();
-        memcpy(payload, mesh->triangles.data(), size);
+        memcpy(payload, indices.data(), size);
         stagingBuffer->unmap();
 
         auto resultBuffer =
@@ -128,4 +122,151 @@ void uploadMesh(helios::vector<helios::IBuffer*>& out,
     stagingFence->wait();
 
     staging.clear();
-}
\ No newline at end of file
+}
+
+void uploadMesh(helios::vector<helios::IBuffer*>& out,
+                helios::IBuffer** elements, helios::IDevice* device,
+                helios::IQueue* queue, helios::ICommandBuffer* commandBuffer,
+                helios::Mesh* mesh)
+{
+    using namespace helios;
+
+    vector<span<const u8>> streams;
+    for (u32 i = 0; i < mesh->bufferCount(); i++)
+    {
+        streams.push_back(span<const u8>(
+            static_cast<const u8*>(mesh->readBuffer(i)),
+            static_cast<size_t>(mesh->bufferSize(i))));
+    }
+
+    const span<const u8> indices(
+        reinterpret_cast<const u8*>(mesh->triangles.data()),
+        mesh->triangles.size() * sizeof(u32));
+    uploadStreams(out, elements, device, queue, commandBuffer, streams.data(),
+                  static_cast<u32>(streams.size()), indices);
+}
+
+void uploadMesh(helios::vector<helios::IBuffer*>& out,
+                helios::IBuffer** elements, helios::IDevice* device,
+                helios::IQueue* queue, helios::ICommandBuffer* commandBuffer,
+                const helios::CookedMesh::SubMesh& mesh)
+{
+    // the cooked streams are copied from the mapping into staging as is
+    const helios::span<const u8> streams[] = {mesh.positions,
+                                                      mesh.attributes};
+    uploadStreams(out, elements, device, queue, commandBuffer, streams, 2,
+                  mesh.indices);
+}
+
+static helios::EFormat textureFormat(const helios::CookedTexture& texture)
+{
+    using namespace helios;
+
+    const bool srgb = texture.content() == ETextureContent::SRGB;
+    switch (texture.format())
+    {
+    case ETextureFormat::BC1:
+        return srgb ? EFormat::BC1_RGB_SRGB_BLOCK
+                    : EFormat::BC1_RGB_UNORM_BLOCK;
+    case ETextureFormat::BC3:
+        return srgb ? EFormat::BC3_SRGB_BLOCK : EFormat::BC3_UNORM_BLOCK;
+    case ETextureFormat::BC5:
+        return EFormat::BC5_UNORM_BLOCK;
+    case ETextureFormat::BC7:
+        return srgb ? EFormat::BC7_SRGB_BLOCK : EFormat::BC7_UNORM_BLOCK;
+    default:
+        return srgb ? EFormat::R8G8B8A8_SRGB : EFormat::R8G8B8A8_UNORM;
+    }
+}
+
+helios::Texture uploadTexture(helios::IDevice* device, helios::IQueue* queue,
+                              helios::ICommandBuffer* commandBuffer,
+                              const helios::CookedTexture& texture)
+{
+    using namespace helios;
+
+    const EFormat format = textureFormat(texture);
+    const u32 levels = texture.levelCount();
+
+    // the levels lie back to back in the payload, so the whole chain goes
+    // into staging with one memcpy
+    const span<const u8> payload = texture.payload();
+    auto stagingBuffer = BufferBuilder()
+                             .device(device)
+                             .size(payload.size_bytes())
+                             .usage(BUFFER_TYPE_TRANSFER_SRC)
+                             .requiredFlags(MEMORY_PROPERTY_HOST_VISIBLE)
+                             .memoryUsage(EMemoryUsage::CPU_TO_GPU)
+                             .build();
+    memcpy(stagingBuffer->map(), payload.data(), payload.size_bytes());
+    stagingBuffer->unmap();
+
+    auto image = ImageBuilder()
+                     .device(device)
+                     .type(EImageType::TYPE_2D)
+                     .format(format)
+                     .extent(texture.width(), texture.height(), 1)
+                     .mipLevels(levels)
+                     .arrayLayers(1)
+                     .samples(SAMPLE_COUNT_1)
+                     .tiling(EImageTiling::OPTIMAL)
+                     .usage(IMAGE_TRANSFER_DST | IMAGE_SAMPLED)
+                     .initialLayout(EImageLayout::UNDEFINED)
+                     .requiredFlags(MEMORY_PROPERTY_DEVICE_LOCAL)
+                     .memoryUsage(EMemoryUsage::GPU_ONLY)
+                     .build();
+    auto view = ImageViewBuilder()
+                    .image(image)
+                    .type(EImageViewType::TYPE_2D)
+                    .format(format)
+                    .aspect(ASPECT_COLOR)
+                    .mipLevels(levels)
+                    .build();
+    auto sampler = SamplerBuilder()
+                       .device(device)
+                       .anisotropy(1.0f)
+                       .unnormalized(false)
+                       .mipLodBias(0.0f)
+                       .minLod(0.0f)
+                       .maxLod(static_cast<f32>(levels))
+                       .mipmap(ESamplerMipMapMode::LINEAR)
+                       .magnification(EFilter::LINEAR)
+                       .minification(EFilter::LINEAR)
+                       .build();
+
+    // one region per level, tightly packed rows
+    vector<BufferImageCopyRegion> regions;
+    regions.reserve(levels);
+    for (u32 i = 0; i < levels; i++)
+    {
+        const CookedTexture::Level& level = texture.level(i);
+        regions.push_back({level.offset, 0, 0, ASPECT_COLOR, i, 0, 1, 0, 0, 0,
+                           level.width, level.height, 1});
+    }
+
+    auto stagingFence = FenceBuilder().device(device).build();
+    stagingFence->reset();
+    commandBuffer->record();
+    commandBuffer->barrier(
+        PIPELINE_STAGE_TOP_OF_PIPE_BIT, PIPELINE_STAGE_TRANSFER_BIT, 0, {},
+        {{0, ACCESS_TRANSFER_WRITE_BIT, EImageLayout::UNDEFINED,
+          EImageLayout::TRANSFER_DST_OPTIMAL, ~(0U), ~(0U), image,
+          ASPECT_COLOR, 0, levels, 0, 1}});
+    commandBuffer->copy(stagingBuffer, image, regions,
+                        EImageLayout::TRANSFER_DST_OPTIMAL);
+    commandBuffer->barrier(
+        PIPELINE_STAGE_TRANSFER_BIT, PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+        {},
+        {{ACCESS_TRANSFER_WRITE_BIT, ACCESS_SHADER_READ_BIT,
+          EImageLayout::TRANSFER_DST_OPTIMAL,
+          EImageLayout::SHADER_READ_ONLY_OPTIMAL, ~(0U), ~(0U), image,
+          ASPECT_COLOR, 0, levels, 0, 1}});
+    commandBuffer->end();
+    queue->submit({{{}, {}, {}, {commandBuffer}}}, stagingFence);
+    stagingFence->wait();
+
+    delete stagingFence;
+    delete stagingBuffer;
+
+    return Texture(image, view, sampler);
+}
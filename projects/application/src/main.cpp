@@ -1,17 +1,16 @@
+#include "demo_application.hpp"
 #include "render_system_demo.hpp"
 #include "simple_directional_lighting_demo.hpp"
 #include "simple_pbr_demo.hpp"
 #include "textured_cube_demo.hpp"
 #include "textured_quad_demo.hpp"
 
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
-
 #include <helios/core/entrypoint.hpp>
 #include <helios/core/engine_context.hpp>
 #include <helios/macros.hpp>
 
 #include <iostream>
+#include <utility>
 
 void printMessage()
 {
@@ -24,51 +23,69 @@ void printMessage()
     std::cout << "[0]: Exit" << std::endl << std::endl;
 }
 
-class DemoApplication final : public helios::Application
+void DemoApplication::initialize()
 {
-public:
-    void initialize() override
+    try
     {
-        try
+        i32 sample = -1;
+        do
         {
-            i32 sample = -1;
-            do
+            printMessage();
+            std::cin >> sample;
+            helios::EngineContext& ctx = helios::EngineContextFactory().create();
+            ctx.window().show();
+            if (sample == 1)
             {
-                printMessage();
-                std::cin >> sample;
-                helios::EngineContext& ctx = helios::EngineContextFactory().create();
-                ctx.window().show();
-                if (sample == 1)
-                {
-                    textured_quad::run();
-                }
-                else if (sample == 2)
-                {
-                    textured_cube::run();
-                }
-                else if (sample == 3)
-                {
-                    simple_directional_lighting::run();
-                }
-                else if (sample == 4)
-                {
-                    simple_pbr::run();
-                }
-                else if (sample == 5)
-                {
-                    render_system::run();
-                }
-                ctx.window().hide();
-                ctx.render().device().releaseResources();
-                ctx.render().reset();
-                std::cout << std::endl;
-            } while (sample != 0);
-        }
-        catch (...)
-        {
-            std::cout << "Error in Sample" << std::endl;
-        }
+                textured_quad::run();
+            }
+            else if (sample == 2)
+            {
+                textured_cube::run(*this);
+            }
+            else if (sample == 3)
+            {
+                simple_directional_lighting::run();
+            }
+            else if (sample == 4)
+            {
+                simple_pbr::run();
+            }
+            else if (sample == 5)
+            {
+                render_system::run();
+            }
+            ctx.window().hide();
+            ctx.render().device().releaseResources();
+            ctx.render().reset();
+            std::cout << std::endl;
+        } while (sample != 0);
+    }
+    catch (...)
+    {
+        std::cout << "Error in Sample" << std::endl;
+    }
+}
+
+void DemoApplication::runSample(std::function<bool()> input, std::function<void(f64 alpha)> render)
+{
+    _input = std::move(input);
+    _render = std::move(render);
+    run();
+    _input = nullptr;
+    _render = nullptr;
+}
+
+bool DemoApplication::input()
+{
+    return _input ? _input() : Application::input();
+}
+
+void DemoApplication::render(const f64 alpha)
+{
+    if (_render)
+    {
+        _render(alpha);
     }
-};
+}
 
 DEFAULT_ENTRYPOINT(DemoApplication)
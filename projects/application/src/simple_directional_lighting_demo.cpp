@@ -5,13 +5,12 @@
 #include <helios/core/engine_context.hpp>
 #include <helios/core/mesh.hpp>
 #include <helios/core/window.hpp>
+#include <helios/io/image_decoder.hpp>
 #include <helios/math/transformations.hpp>
 #include <helios/math/vector.hpp>
 #include <helios/render/graphics.hpp>
 #include <helios/render/light.hpp>
 
-#include <stb_image.h>
-
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -151,23 +150,21 @@ void simple_directional_lighting::run()
     IBuffer* elements;
     uploadMesh(buffers, &elements, &device, &transferQueue, stagingCmd, mesh->subMeshes[0]);
 
-    i32 width, height, channels;
-    stbi_set_flip_vertically_on_load(true);
-    void* pixels = stbi_load("assets/models/cube/Cube_BaseColor.png", &width, &height, &channels, STBI_rgb_alpha);
-    stbi_set_flip_vertically_on_load(false);
+    ImageDecoder decoder;
+    decoder.add("assets/models/cube/Cube_BaseColor.png", true);
+    const u32 width = decoder.info(0).width;
+    const u32 height = decoder.info(0).height;
 
     stagingCmd = transferCmdPool->allocate();
     auto stagingBuffer = BufferBuilder()
                              .device(&device)
-                             .size(sizeof(u8) * width * height * channels)
+                             .size(decoder.size())
                              .usage(BUFFER_TYPE_TRANSFER_SRC)
                              .requiredFlags(MEMORY_PROPERTY_HOST_VISIBLE)
                              .memoryUsage(EMemoryUsage::CPU_TO_GPU)
                              .build();
-    void* data = stagingBuffer->map();
-    memcpy(data, pixels, sizeof(u8) * width * height * channels);
+    decoder.decode(static_cast<u8*>(stagingBuffer->map()));
     stagingBuffer->unmap();
-    stbi_image_free(pixels);
 
     auto image = ImageBuilder()
                      .device(&device)
@@ -208,8 +205,7 @@ void simple_directional_lighting::run()
                         {{0, ACCESS_TRANSFER_WRITE_BIT, EImageLayout::UNDEFINED, EImageLayout::TRANSFER_DST_OPTIMAL,
                           ~(0U), ~(0U), image, ASPECT_COLOR, 0, 1, 0, 1}});
     stagingCmd->copy(stagingBuffer, image,
-                     {{0, static_cast<u32>(width), static_cast<u32>(height), ASPECT_COLOR, 0, 0, 1, 0, 0, 0,
-                       static_cast<u32>(width), static_cast<u32>(height), 1}},
+                     {{0, width, height, ASPECT_COLOR, 0, 0, 1, 0, 0, 0, width, height, 1}},
                      EImageLayout::TRANSFER_DST_OPTIMAL);
     stagingCmd->end();
     transferQueue.submit({{{}, {}, {}, {stagingCmd}}}, stagingFence);
@@ -5,13 +5,12 @@
 #include <helios/core/engine_context.hpp>
 #include <helios/core/mesh.hpp>
 #include <helios/core/window.hpp>
+#include <helios/io/image_decoder.hpp>
 #include <helios/math/transformations.hpp>
 #include <helios/math/vector.hpp>
 #include <helios/render/graphics.hpp>
 #include <helios/render/light.hpp>
 
-#include <stb_image.h>
-
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -159,121 +158,65 @@ void simple_pbr::run()
     IBuffer* elements;
     uploadMesh(buffers, &elements, &device, &transferQueue, stagingCmd, mesh->subMeshes[0]);
 
-    i32 aWidth, aHeight, aChannels;
-    i32 mWidth, mHeight, mChannels;
-    i32 nWidth, nHeight, nChannels;
-    stbi_set_flip_vertically_on_load(false);
-    void* pixels = stbi_load("assets/models/barramundi/BarramundiFish_baseColor.png", &aWidth, &aHeight, &aChannels,
-                             STBI_rgb_alpha);
+    // the three textures decode concurrently straight into one staging buffer
+    ImageDecoder decoder(&ctx.jobs());
+    const u32 albedoIndex = decoder.add("assets/models/barramundi/BarramundiFish_baseColor.png");
+    const u32 metalRoughIndex = decoder.add("assets/models/barramundi/BarramundiFish_occlusionRoughnessMetallic.png");
+    const u32 normalIndex = decoder.add("assets/models/barramundi/BarramundiFish_normal.png");
 
     stagingCmd = transferCmdPool->allocate();
     auto stagingBuffer = BufferBuilder()
                              .device(&device)
-                             .size(sizeof(u8) * aWidth * aHeight * STBI_rgb_alpha)
+                             .size(decoder.size())
                              .usage(BUFFER_TYPE_TRANSFER_SRC)
                              .requiredFlags(MEMORY_PROPERTY_HOST_VISIBLE)
                              .memoryUsage(EMemoryUsage::CPU_TO_GPU)
                              .build();
-    void* data = stagingBuffer->map();
-    memcpy(data, pixels, sizeof(u8) * aWidth * aHeight * STBI_rgb_alpha);
-    stagingBuffer->unmap();
-    stbi_image_free(pixels);
-
-    auto albedo = ImageBuilder()
-                      .device(&device)
-                      .type(EImageType::TYPE_2D)
-                      .format(EFormat::R8G8B8A8_SRGB)
-                      .extent(aWidth, aHeight, 1)
-                      .mipLevels(1)
-                      .arrayLayers(1)
-                      .samples(SAMPLE_COUNT_1)
-                      .tiling(EImageTiling::OPTIMAL)
-                      .usage(IMAGE_TRANSFER_DST | IMAGE_SAMPLED)
-                      .initialLayout(EImageLayout::UNDEFINED)
-                      .requiredFlags(MEMORY_PROPERTY_DEVICE_LOCAL)
-                      .memoryUsage(EMemoryUsage::GPU_ONLY)
-                      .build();
-    auto albedoImageView = ImageViewBuilder()
-                               .image(albedo)
-                               .type(EImageViewType::TYPE_2D)
-                               .format(EFormat::R8G8B8A8_SRGB)
-                               .aspect(ASPECT_COLOR)
-                               .build();
-
-    pixels = stbi_load("assets/models/barramundi/"
-                       "BarramundiFish_occlusionRoughnessMetallic.png",
-                       &mWidth, &mHeight, &mChannels, STBI_rgb_alpha);
-
-    auto metallicStagingBuffer = BufferBuilder()
-                                     .device(&device)
-                                     .size(sizeof(u8) * mWidth * mHeight * STBI_rgb_alpha)
-                                     .usage(BUFFER_TYPE_TRANSFER_SRC)
-                                     .requiredFlags(MEMORY_PROPERTY_HOST_VISIBLE)
-                                     .memoryUsage(EMemoryUsage::CPU_TO_GPU)
-                                     .build();
-    data = metallicStagingBuffer->map();
-    memcpy(data, pixels, sizeof(u8) * mWidth * mHeight * STBI_rgb_alpha);
-    metallicStagingBuffer->unmap();
-    stbi_image_free(pixels);
-
-    auto metalRough = ImageBuilder()
-                          .device(&device)
-                          .type(EImageType::TYPE_2D)
-                          .format(EFormat::R8G8B8A8_SRGB)
-                          .extent(mWidth, mHeight, 1)
-                          .mipLevels(1)
-                          .arrayLayers(1)
-                          .samples(SAMPLE_COUNT_1)
-                          .tiling(EImageTiling::OPTIMAL)
-                          .usage(IMAGE_TRANSFER_DST | IMAGE_SAMPLED)
-                          .initialLayout(EImageLayout::UNDEFINED)
-                          .requiredFlags(MEMORY_PROPERTY_DEVICE_LOCAL)
-                          .memoryUsage(EMemoryUsage::GPU_ONLY)
-                          .build();
-
-    auto metalRoughImageView = ImageViewBuilder()
-                                   .image(metalRough)
-                                   .type(EImageViewType::TYPE_2D)
-                                   .format(EFormat::R8G8B8A8_SRGB)
-                                   .aspect(ASPECT_COLOR)
-                                   .build();
-
-    pixels =
-        stbi_load("assets/models/barramundi/BarramundiFish_normal.png", &nWidth, &nHeight, &nChannels, STBI_rgb_alpha);
-
-    auto normalStagingBuffer = BufferBuilder()
-                                   .device(&device)
-                                   .size(sizeof(u8) * nWidth * nHeight * STBI_rgb_alpha)
-                                   .usage(BUFFER_TYPE_TRANSFER_SRC)
-                                   .requiredFlags(MEMORY_PROPERTY_HOST_VISIBLE)
-                                   .memoryUsage(EMemoryUsage::CPU_TO_GPU)
-                                   .build();
-    data = normalStagingBuffer->map();
-    memcpy(data, pixels, sizeof(u8) * nWidth * nHeight * STBI_rgb_alpha);
-    normalStagingBuffer->unmap();
-    stbi_image_free(pixels);
-
-    auto normal = ImageBuilder()
-                      .device(&device)
-                      .type(EImageType::TYPE_2D)
-                      .format(EFormat::R8G8B8A8_SRGB)
-                      .extent(nWidth, nHeight, 1)
-                      .mipLevels(1)
-                      .arrayLayers(1)
-                      .samples(SAMPLE_COUNT_1)
-                      .tiling(EImageTiling::OPTIMAL)
-                      .usage(IMAGE_TRANSFER_DST | IMAGE_SAMPLED)
-                      .initialLayout(EImageLayout::UNDEFINED)
-                      .requiredFlags(MEMORY_PROPERTY_DEVICE_LOCAL)
-                      .memoryUsage(EMemoryUsage::GPU_ONLY)
-                      .build();
-
-    auto normalImageView = ImageViewBuilder()
-                               .image(normal)
-                               .type(EImageViewType::TYPE_2D)
-                               .format(EFormat::R8G8B8A8_SRGB)
-                               .aspect(ASPECT_COLOR)
-                               .build();
+    if (decoder.size() > 0)
+    {
+        decoder.decode(static_cast<u8*>(stagingBuffer->map()));
+        stagingBuffer->unmap();
+    }
+
+    const auto createTexture = [&device, &decoder](const u32 index) {
+        const ImageInfo& info = decoder.info(index);
+        return ImageBuilder()
+            .device(&device)
+            .type(EImageType::TYPE_2D)
+            .format(EFormat::R8G8B8A8_SRGB)
+            .extent(info.width, info.height, 1)
+            .mipLevels(1)
+            .arrayLayers(1)
+            .samples(SAMPLE_COUNT_1)
+            .tiling(EImageTiling::OPTIMAL)
+            .usage(IMAGE_TRANSFER_DST | IMAGE_SAMPLED)
+            .initialLayout(EImageLayout::UNDEFINED)
+            .requiredFlags(MEMORY_PROPERTY_DEVICE_LOCAL)
+            .memoryUsage(EMemoryUsage::GPU_ONLY)
+            .build();
+    };
+    const auto createTextureView = [](IImage* image) {
+        return ImageViewBuilder()
+            .image(image)
+            .type(EImageViewType::TYPE_2D)
+            .format(EFormat::R8G8B8A8_SRGB)
+            .aspect(ASPECT_COLOR)
+            .build();
+    };
+    const auto copyTexture = [&stagingCmd, &stagingBuffer, &decoder](const u32 index, IImage* image) {
+        const ImageInfo& info = decoder.info(index);
+        stagingCmd->copy(stagingBuffer, image,
+                         {{decoder.offset(index), info.width, info.height, ASPECT_COLOR, 0, 0, 1, 0, 0, 0, info.width,
+                           info.height, 1}},
+                         EImageLayout::TRANSFER_DST_OPTIMAL);
+    };
+
+    auto albedo = createTexture(albedoIndex);
+    auto albedoImageView = createTextureView(albedo);
+    auto metalRough = createTexture(metalRoughIndex);
+    auto metalRoughImageView = createTextureView(metalRough);
+    auto normal = createTexture(normalIndex);
+    auto normalImageView = createTextureView(normal);
 
     auto stagingFence = FenceBuilder().device(&device).build();
     stagingCmd->record();
@@ -285,19 +228,9 @@ void simple_pbr::run()
                           ~(0U), ~(0U), metalRough, ASPECT_COLOR, 0, 1, 0, 1},
                          {0, ACCESS_TRANSFER_WRITE_BIT, EImageLayout::UNDEFINED, EImageLayout::TRANSFER_DST_OPTIMAL,
                           ~(0U), ~(0U), normal, ASPECT_COLOR, 0, 1, 0, 1}});
-    stagingCmd->copy(stagingBuffer, albedo,
-                     {{0, static_cast<u32>(aWidth), static_cast<u32>(aHeight), ASPECT_COLOR, 0, 0, 1, 0, 0, 0,
-                       static_cast<u32>(aWidth), static_cast<u32>(aHeight), 1}},
-                     EImageLayout::TRANSFER_DST_OPTIMAL);
-
-    stagingCmd->copy(metallicStagingBuffer, metalRough,
-                     {{0, static_cast<u32>(mWidth), static_cast<u32>(mHeight), ASPECT_COLOR, 0, 0, 1, 0, 0, 0,
-                       static_cast<u32>(mWidth), static_cast<u32>(mHeight), 1}},
-                     EImageLayout::TRANSFER_DST_OPTIMAL);
-    stagingCmd->copy(normalStagingBuffer, normal,
-                     {{0, static_cast<u32>(nWidth), static_cast<u32>(nHeight), ASPECT_COLOR, 0, 0, 1, 0, 0, 0,
-                       static_cast<u32>(nWidth), static_cast<u32>(nHeight), 1}},
-                     EImageLayout::TRANSFER_DST_OPTIMAL);
+    copyTexture(albedoIndex, albedo);
+    copyTexture(metalRoughIndex, metalRough);
+    copyTexture(normalIndex, normal);
 
     stagingCmd->end();
     transferQueue.submit({{{}, {}, {}, {stagingCmd}}}, stagingFence);
@@ -1,21 +1,23 @@
 #include "textured_cube_demo.hpp"
 
+#include "demo_application.hpp"
 #include "demo_utils.hpp"
 
+#include <helios/core/cooked_mesh.hpp>
+#include <helios/core/cooked_texture.hpp>
 #include <helios/core/engine_context.hpp>
 #include <helios/core/mesh.hpp>
 #include <helios/core/window.hpp>
+#include <helios/io/image_decoder.hpp>
 #include <helios/math/transformations.hpp>
 #include <helios/math/vector.hpp>
 #include <helios/render/graphics.hpp>
 
-#include <stb_image.h>
-
 #include <fstream>
 #include <iostream>
 #include <string>
 
-void textured_cube::run()
+void textured_cube::run(DemoApplication& app)
 {
     using namespace helios;
 
@@ -145,88 +147,113 @@ void textured_cube::run()
     auto transferCmdPool = CommandPoolBuilder().device(&device).queue(&transferQueue).build();
     auto stagingCmd = transferCmdPool->allocate();
 
-    Mesh* mesh = new Mesh("assets/models/cube/Cube.gltf");
+    // prefer the output of `cooker mesh`, it is uploaded straight from the
+    // mapped file
     vector<IBuffer*> buffers;
     IBuffer* elements;
-    uploadMesh(buffers, &elements, &device, &transferQueue, stagingCmd, mesh->subMeshes[0]);
-
-    i32 width, height, channels;
-    stbi_set_flip_vertically_on_load(true);
-    void* pixels = stbi_load("assets/models/cube/Cube_BaseColor.png", &width, &height, &channels, STBI_rgb_alpha);
-    stbi_set_flip_vertically_on_load(false);
-
-    stagingCmd = transferCmdPool->allocate();
-    auto stagingBuffer = BufferBuilder()
-                             .device(&device)
-                             .size(sizeof(u8) * width * height * channels)
-                             .usage(BUFFER_TYPE_TRANSFER_SRC)
-                             .requiredFlags(MEMORY_PROPERTY_HOST_VISIBLE)
-                             .memoryUsage(EMemoryUsage::CPU_TO_GPU)
-                             .build();
-    void* data = stagingBuffer->map();
-    memcpy(data, pixels, sizeof(u8) * width * height * channels);
-    stagingBuffer->unmap();
-    stbi_image_free(pixels);
-
-    auto image = ImageBuilder()
-                     .device(&device)
-                     .type(EImageType::TYPE_2D)
-                     .format(EFormat::R8G8B8A8_SRGB)
-                     .extent(width, height, 1)
-                     .mipLevels(1)
-                     .arrayLayers(1)
-                     .samples(SAMPLE_COUNT_1)
-                     .tiling(EImageTiling::OPTIMAL)
-                     .usage(IMAGE_TRANSFER_DST | IMAGE_SAMPLED)
-                     .initialLayout(EImageLayout::UNDEFINED)
-                     .requiredFlags(MEMORY_PROPERTY_DEVICE_LOCAL)
-                     .memoryUsage(EMemoryUsage::GPU_ONLY)
-                     .build();
-    auto imageView = ImageViewBuilder()
-                         .image(image)
-                         .type(EImageViewType::TYPE_2D)
+    u32 indexCount;
+    const CookedMesh cooked("assets/models/cube/Cube.hmesh");
+    if (cooked.valid() && cooked.subMeshCount() > 0)
+    {
+        uploadMesh(buffers, &elements, &device, &transferQueue, stagingCmd, cooked.subMesh(0));
+        indexCount = cooked.subMesh(0).indexCount;
+    }
+    else
+    {
+        Mesh mesh("assets/models/cube/Cube.gltf");
+        uploadMesh(buffers, &elements, &device, &transferQueue, stagingCmd, mesh.subMeshes[0]);
+        indexCount = static_cast<u32>(mesh.subMeshes[0]->triangles.size());
+    }
+
+    // prefer the output of `cooker texture`, it carries the whole mip chain
+    // already block compressed
+    IImageView* imageView;
+    ISampler* sampler;
+    const CookedTexture cookedTexture("assets/models/cube/Cube_BaseColor.htex");
+    if (cookedTexture.valid())
+    {
+        const Texture texture = uploadTexture(&device, &graphicsQueue, commandPool->allocate(), cookedTexture);
+        imageView = texture.getImageView();
+        sampler = texture.getSampler();
+    }
+    else
+    {
+        ImageDecoder decoder;
+        decoder.add("assets/models/cube/Cube_BaseColor.png", true);
+        const u32 width = decoder.info(0).width;
+        const u32 height = decoder.info(0).height;
+
+        stagingCmd = transferCmdPool->allocate();
+        auto stagingBuffer = BufferBuilder()
+                                 .device(&device)
+                                 .size(decoder.size())
+                                 .usage(BUFFER_TYPE_TRANSFER_SRC)
+                                 .requiredFlags(MEMORY_PROPERTY_HOST_VISIBLE)
+                                 .memoryUsage(EMemoryUsage::CPU_TO_GPU)
+                                 .build();
+        decoder.decode(static_cast<u8*>(stagingBuffer->map()));
+        stagingBuffer->unmap();
+
+        auto image = ImageBuilder()
+                         .device(&device)
+                         .type(EImageType::TYPE_2D)
                          .format(EFormat::R8G8B8A8_SRGB)
-                         .aspect(ASPECT_COLOR)
+                         .extent(width, height, 1)
+                         .mipLevels(1)
+                         .arrayLayers(1)
+                         .samples(SAMPLE_COUNT_1)
+                         .tiling(EImageTiling::OPTIMAL)
+                         .usage(IMAGE_TRANSFER_DST | IMAGE_SAMPLED)
+                         .initialLayout(EImageLayout::UNDEFINED)
+                         .requiredFlags(MEMORY_PROPERTY_DEVICE_LOCAL)
+                         .memoryUsage(EMemoryUsage::GPU_ONLY)
                          .build();
-    auto sampler = SamplerBuilder()
-                       .device(&device)
-                       .anisotropy(1.0f)
-                       .unnormalized(false)
-                       .mipLodBias(0.0f)
-                       .minLod(0.0f)
-                       .maxLod(1.0f)
-                       .mipmap(ESamplerMipMapMode::LINEAR)
-                       .magnification(EFilter::LINEAR)
-                       .minification(EFilter::LINEAR)
-                       .build();
-
-    auto stagingFence = FenceBuilder().device(&device).build();
-    stagingCmd->record();
-    stagingCmd->barrier(PIPELINE_STAGE_TOP_OF_PIPE_BIT, PIPELINE_STAGE_TRANSFER_BIT, 0,
-                        {},
-                        {{0, ACCESS_TRANSFER_WRITE_BIT, EImageLayout::UNDEFINED, EImageLayout::TRANSFER_DST_OPTIMAL,
-                          ~(0U), ~(0U), image, ASPECT_COLOR, 0, 1, 0, 1}});
-    stagingCmd->copy(stagingBuffer, image,
-                     {{0, static_cast<u32>(width), static_cast<u32>(height), ASPECT_COLOR, 0, 0, 1, 0, 0, 0,
-                       static_cast<u32>(width), static_cast<u32>(height), 1}},
-                     EImageLayout::TRANSFER_DST_OPTIMAL);
-    stagingCmd->end();
-    transferQueue.submit({{{}, {}, {}, {stagingCmd}}}, stagingFence);
-
-    auto transitionCmd = commandPool->allocate();
-    transitionCmd->record();
-    stagingFence->wait();
-    stagingFence->reset();
-    transitionCmd->barrier(PIPELINE_STAGE_TOP_OF_PIPE_BIT, PIPELINE_STAGE_TRANSFER_BIT, 0,
-                           {},
-                           {{0, ACCESS_TRANSFER_WRITE_BIT, EImageLayout::TRANSFER_DST_OPTIMAL,
-                             EImageLayout::SHADER_READ_ONLY_OPTIMAL, ~(0U), ~(0U), image, ASPECT_COLOR, 0, 1, 0, 1}});
-    transitionCmd->end();
-    graphicsQueue.submit({{{}, {}, {}, {transitionCmd}}}, stagingFence);
-    stagingFence->wait();
-
-    delete stagingFence;
-    delete stagingBuffer;
+        imageView = ImageViewBuilder()
+                        .image(image)
+                        .type(EImageViewType::TYPE_2D)
+                        .format(EFormat::R8G8B8A8_SRGB)
+                        .aspect(ASPECT_COLOR)
+                        .build();
+        sampler = SamplerBuilder()
+                     .device(&device)
+                     .anisotropy(1.0f)
+                     .unnormalized(false)
+                     .mipLodBias(0.0f)
+                     .minLod(0.0f)
+                     .maxLod(1.0f)
+                     .mipmap(ESamplerMipMapMode::LINEAR)
+                     .magnification(EFilter::LINEAR)
+                     .minification(EFilter::LINEAR)
+                     .build();
+
+        auto stagingFence = FenceBuilder().device(&device).build();
+        stagingCmd->record();
+        stagingCmd->barrier(PIPELINE_STAGE_TOP_OF_PIPE_BIT, PIPELINE_STAGE_TRANSFER_BIT, 0,
+                            {},
+                            {{0, ACCESS_TRANSFER_WRITE_BIT, EImageLayout::UNDEFINED, EImageLayout::TRANSFER_DST_OPTIMAL,
+                              ~(0U), ~(0U), image, ASPECT_COLOR, 0, 1, 0, 1}});
+        stagingCmd->copy(stagingBuffer, image,
+                         {{0, width, height, ASPECT_COLOR, 0, 0, 1, 0, 0, 0, width, height, 1}},
+                         EImageLayout::TRANSFER_DST_OPTIMAL);
+        stagingCmd->end();
+        transferQueue.submit({{{}, {}, {}, {stagingCmd}}}, stagingFence);
+
+        auto transitionCmd = commandPool->allocate();
+        transitionCmd->record();
+        stagingFence->wait();
+        stagingFence->reset();
+        transitionCmd->barrier(PIPELINE_STAGE_TOP_OF_PIPE_BIT, PIPELINE_STAGE_TRANSFER_BIT, 0,
+                               {},
+                               {{0, ACCESS_TRANSFER_WRITE_BIT, EImageLayout::TRANSFER_DST_OPTIMAL,
+                                 EImageLayout::SHADER_READ_ONLY_OPTIMAL, ~(0U), ~(0U), image, ASPECT_COLOR, 0, 1, 0, 1}});
+        transitionCmd->end();
+        graphicsQueue.submit({{{}, {}, {}, {transitionCmd}}}, stagingFence);
+        stagingFence->wait();
+
+        delete stagingFence;
+        delete stagingBuffer;
+    }
+
     delete stagingCmd;
     delete transferCmdPool;
 
@@ -296,18 +323,19 @@ void textured_cube::run()
         commandBuffers[i]->bind(pipeline);
         commandBuffers[i]->bind(elements, 0);
         commandBuffers[i]->bind({sets[i]}, pipeline, 0);
-        commandBuffers[i]->draw(static_cast<u32>(mesh->subMeshes[0]->triangles.size()), 1, 0, 0, 0);
+        commandBuffers[i]->draw(indexCount, 1, 0, 0, 0);
         commandBuffers[i]->endRenderPass();
         commandBuffers[i]->end();
     }
 
-    delete mesh;
-
     vector<IFence*> inFlightImages(frameComplete.size(), nullptr);
 
     size_t currentFrame = 0;
-    while (!window.shouldClose())
-    {
+    const auto input = [&]() {
+        window.poll();
+        return !window.shouldClose() && !window.getKeyboard().isPressed(EKey::KEY_ESCAPE);
+    };
+    const auto render = [&](f64) {
         const uint32_t imageIndex = swapchain.acquireNextImage(UINT64_MAX, imageAvailable[currentFrame], nullptr);
         if (inFlightImages[imageIndex] != nullptr)
         {
@@ -324,15 +352,9 @@ void textured_cube::run()
         graphicsQueue.submit({submitInfo}, frameComplete[currentFrame]);
         presentQueue.present({{renderFinished[currentFrame]}, &swapchain, imageIndex});
 
-        window.poll();
-
         currentFrame = (currentFrame + 1) % swapchain.imagesCount();
-
-        if (window.getKeyboard().isPressed(EKey::KEY_ESCAPE))
-        {
-            break;
-        }
-    }
+    };
+    app.runSample(input, render);
 
     device.idle();
 }
\ No newline at end of file
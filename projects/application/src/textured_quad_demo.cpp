@@ -4,11 +4,10 @@
 
 #include <helios/core/engine_context.hpp>
 #include <helios/core/window.hpp>
+#include <helios/io/image_decoder.hpp>
 #include <helios/math/vector.hpp>
 #include <helios/render/graphics.hpp>
 
-#include <stb_image.h>
-
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -178,25 +177,22 @@ void textured_quad::run()
     transferQueue.submit({{{}, {}, {}, {stagingCmd}}}, stagingFence);
     stagingFence->wait();
 
-    i32 width, height, channels;
-    stbi_set_flip_vertically_on_load(true);
-    void* pixels = stbi_load("assets/textures/dragon.png", &width, &height,
-                             &channels, STBI_rgb_alpha);
-    stbi_set_flip_vertically_on_load(false);
+    ImageDecoder decoder;
+    decoder.add("assets/textures/dragon.png", true);
+    const u32 width = decoder.info(0).width;
+    const u32 height = decoder.info(0).height;
 
     delete stagingBuffer;
     stagingCmd = transferCmdPool->allocate();
     stagingBuffer = BufferBuilder()
                         .device(&device)
-                        .size(sizeof(u8) * width * height * channels)
+                        .size(decoder.size())
                         .usage(BUFFER_TYPE_TRANSFER_SRC)
                         .requiredFlags(MEMORY_PROPERTY_HOST_VISIBLE)
                         .memoryUsage(EMemoryUsage::CPU_TO_GPU)
                         .build();
-    data = stagingBuffer->map();
-    memcpy(data, pixels, sizeof(u8) * width * height * channels);
+    decoder.decode(static_cast<u8*>(stagingBuffer->map()));
     stagingBuffer->unmap();
-    stbi_image_free(pixels);
 
     auto image = ImageBuilder()
                      .device(&device)
@@ -237,8 +233,7 @@ void textured_quad::run()
                           image, ASPECT_COLOR, 0, 1, 0, 1}});
     stagingCmd->copy(
         stagingBuffer, image,
-        {{0, static_cast<u32>(width), static_cast<u32>(height), ASPECT_COLOR, 0,
-          0, 1, 0, 0, 0, static_cast<u32>(width), static_cast<u32>(height), 1}},
+        {{0, width, height, ASPECT_COLOR, 0, 0, 1, 0, 0, 0, width, height, 1}},
         EImageLayout::TRANSFER_DST_OPTIMAL);
     stagingCmd->end();
     transferQueue.submit({{{}, {}, {}, {stagingCmd}}}, stagingFence);
@@ -0,0 +1,69 @@
+project "benchmarks"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    targetdir (binaries)
+    objdir (intermediate)
+
+    dependson {
+        "containers",
+        "core",
+        "math",
+    }
+
+    links {
+        "core",
+        "containers",
+        "math",
+    }
+
+    files {
+        "src/benchmark.hpp",
+        "src/benchmark.cpp",
+        "src/main.cpp"
+    }
+
+    includedirs {
+        "%{IncludeDir.containers}",
+        "%{IncludeDir.core}",
+        "%{IncludeDir.entt}",
+        "%{IncludeDir.json}",
+        "%{IncludeDir.math}",
+        "%{IncludeDir.stb}",
+        "src",
+    }
+
+    vectorextensions "AVX2"
+
+    filter "system:windows"
+        toolset "msc-ClangCL"
+        systemversion "latest"
+        staticruntime "Off"
+
+    filter "system:linux"
+        toolset "clang"
+        staticruntime "Off"
+
+        buildoptions {
+            "-fms-extensions"
+        }
+
+        links {
+            "pthread"
+        }
+
+    -- numbers from a debug build are meaningless, but keep the configuration
+    -- so the solution builds in either
+    filter "configurations:Debug"
+        runtime "Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        defines {
+            "NDEBUG"
+        }
+
+        optimize "Full"
+        runtime "Release"
+        symbols "Off"
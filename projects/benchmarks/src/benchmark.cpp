@@ -0,0 +1,299 @@
+#include "benchmark.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace helios::bench
+{
+    namespace
+    {
+        struct Options
+        {
+            std::string filter;
+            std::string output = "benchmarks.json";
+            std::string baseline;
+            f64 threshold = 0.1;
+            f64 minTimeSeconds = 0.05;
+            u32 repetitions = 5;
+        };
+
+        struct Result
+        {
+            std::string name;
+            u64 iterations;
+            u64 itemsPerIteration;
+            f64 medianNs;
+            f64 minNs;
+            f64 maxNs;
+        };
+
+        const char* optionValue(const char* arg, const char* option)
+        {
+            const size_t length = std::strlen(option);
+            if (std::strncmp(arg, option, length) == 0 && arg[length] == '=')
+            {
+                return arg + length + 1;
+            }
+            return nullptr;
+        }
+
+        bool parseOptions(int argc, char** argv, Options& options)
+        {
+            for (int i = 1; i < argc; i++)
+            {
+                const char* arg = argv[i];
+                if (const char* value = optionValue(arg, "--filter"))
+                {
+                    options.filter = value;
+                }
+                else if (const char* value = optionValue(arg, "--out"))
+                {
+                    options.output = value;
+                }
+                else if (const char* value = optionValue(arg, "--baseline"))
+                {
+                    options.baseline = value;
+                }
+                else if (const char* value = optionValue(arg, "--threshold"))
+                {
+                    options.threshold = std::atof(value);
+                }
+                else if (const char* value = optionValue(arg, "--min-time"))
+                {
+                    options.minTimeSeconds = std::atof(value);
+                }
+                else if (const char* value =
+                             optionValue(arg, "--repetitions"))
+                {
+                    options.repetitions =
+                        std::max(1, std::atoi(value));
+                }
+                else
+                {
+                    std::fprintf(
+                        stderr,
+                        "usage: %s [--filter=substring] [--out=file.json] "
+                        "[--baseline=file.json] [--threshold=0.1] "
+                        "[--min-time=seconds] [--repetitions=n]\n",
+                        argv[0]);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        f64 measure(const BenchmarkFunction function, const u64 iterations,
+                    const i64 size, u64& items)
+        {
+            State state(iterations, size);
+            function(state);
+            items = state.itemsPerIteration();
+            return state.elapsedNanoseconds();
+        }
+
+        Result runBenchmark(const std::string& name,
+                            const BenchmarkFunction function, const i64 size,
+                            const Options& options)
+        {
+            const f64 minTimeNs = options.minTimeSeconds * 1.0e9;
+            u64 items = 1;
+
+            // grow the iteration count until one run covers the minimum
+            // time, the first run doubles as a warm up
+            u64 iterations = 1;
+            while (true)
+            {
+                const f64 elapsed = measure(function, iterations, size, items);
+                if (elapsed >= minTimeNs || iterations >= (1ull << 40))
+                {
+                    break;
+                }
+
+                const f64 scale =
+                    elapsed > 0.0 ? minTimeNs * 1.4 / elapsed : 100.0;
+                const f64 next = static_cast<f64>(iterations) *
+                                 std::min(std::max(scale, 2.0), 100.0);
+                iterations = static_cast<u64>(next);
+            }
+
+            std::vector<f64> samples;
+            samples.reserve(options.repetitions);
+            for (u32 i = 0; i < options.repetitions; i++)
+            {
+                samples.push_back(measure(function, iterations, size, items) /
+                                  static_cast<f64>(iterations));
+            }
+            std::sort(samples.begin(), samples.end());
+
+            Result result;
+            result.name = name;
+            result.iterations = iterations;
+            result.itemsPerIteration = items;
+            result.medianNs = samples[samples.size() / 2];
+            result.minNs = samples.front();
+            result.maxNs = samples.back();
+            return result;
+        }
+
+        bool loadBaseline(const std::string& path,
+                          std::unordered_map<std::string, f64>& baseline)
+        {
+            std::ifstream file(path);
+            if (!file)
+            {
+                std::fprintf(stderr, "could not open baseline %s\n",
+                             path.c_str());
+                return false;
+            }
+
+            const nlohmann::json report = nlohmann::json::parse(file, nullptr,
+                                                                false);
+            if (report.is_discarded() || !report.contains("benchmarks"))
+            {
+                std::fprintf(stderr, "malformed baseline %s\n", path.c_str());
+                return false;
+            }
+
+            for (const auto& entry : report["benchmarks"])
+            {
+                baseline[entry["name"].get<std::string>()] =
+                    entry["median_ns"].get<f64>();
+            }
+            return true;
+        }
+
+        void writeReport(const std::string& path, const Options& options,
+                         const std::vector<Result>& results)
+        {
+            nlohmann::json report;
+            report["config"] = {
+                {"min_time_seconds", options.minTimeSeconds},
+                {"repetitions", options.repetitions},
+            };
+
+            nlohmann::json& benchmarks = report["benchmarks"];
+            benchmarks = nlohmann::json::array();
+            for (const Result& result : results)
+            {
+                benchmarks.push_back({
+                    {"name", result.name},
+                    {"iterations", result.iterations},
+                    {"items_per_iteration", result.itemsPerIteration},
+                    {"median_ns", result.medianNs},
+                    {"min_ns", result.minNs},
+                    {"max_ns", result.maxNs},
+                    {"ns_per_item", result.medianNs /
+                                        static_cast<f64>(
+                                            result.itemsPerIteration)},
+                });
+            }
+
+            std::ofstream file(path);
+            file << report.dump(4) << '\n';
+        }
+    } // namespace
+
+    Registration::Registration(const char* group, const char* name,
+                               BenchmarkFunction function,
+                               std::initializer_list<i64> sizes)
+    {
+        registry().push_back(
+            {std::string(group) + "/" + name, function, sizes});
+    }
+
+    std::vector<Benchmark>& registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    int run(int argc, char** argv)
+    {
+        Options options;
+        if (!parseOptions(argc, argv, options))
+        {
+            return 2;
+        }
+
+        std::unordered_map<std::string, f64> baseline;
+        if (!options.baseline.empty() &&
+            !loadBaseline(options.baseline, baseline))
+        {
+            return 2;
+        }
+
+        std::vector<Result> results;
+        u32 regressions = 0;
+
+        std::printf("%-48s %14s %12s %10s\n", "benchmark", "ns/iter",
+                    "ns/item", "baseline");
+        for (const Benchmark& benchmark : registry())
+        {
+            std::vector<i64> sizes = benchmark.sizes;
+            if (sizes.empty())
+            {
+                sizes.push_back(0);
+            }
+
+            for (const i64 size : sizes)
+            {
+                const std::string name =
+                    benchmark.sizes.empty()
+                        ? benchmark.name
+                        : benchmark.name + "/" + std::to_string(size);
+                if (name.find(options.filter) == std::string::npos)
+                {
+                    continue;
+                }
+
+                const Result result =
+                    runBenchmark(name, benchmark.function, size, options);
+                results.push_back(result);
+
+                char delta[32] = "";
+                const char* verdict = "";
+                const auto it = baseline.find(name);
+                if (it != baseline.end() && it->second > 0.0)
+                {
+                    const f64 change = result.medianNs / it->second - 1.0;
+                    std::snprintf(delta, sizeof(delta), "%+.1f%%",
+                                  change * 100.0);
+                    if (change > options.threshold)
+                    {
+                        verdict = "  REGRESSION";
+                        regressions++;
+                    }
+                }
+                else if (!baseline.empty())
+                {
+                    std::snprintf(delta, sizeof(delta), "new");
+                }
+
+                std::printf("%-48s %14.2f %12.3f %10s%s\n", name.c_str(),
+                            result.medianNs,
+                            result.medianNs /
+                                static_cast<f64>(result.itemsPerIteration),
+                            delta, verdict);
+            }
+        }
+
+        if (!options.output.empty())
+        {
+            writeReport(options.output, options, results);
+        }
+
+        if (regressions > 0)
+        {
+            std::printf("%u benchmark(s) regressed by more than %.1f%%\n",
+                        regressions, options.threshold * 100.0);
+            return 1;
+        }
+        return 0;
+    }
+} // namespace helios::bench
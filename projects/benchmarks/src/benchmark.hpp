@@ -0,0 +1,151 @@
+#pragma once
+
+#include <helios/macros.hpp>
+
+#include <chrono>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace helios::bench
+{
+    class State
+    {
+    public:
+        State(const u64 iterations, const i64 size) noexcept;
+        HELIOS_NO_COPY_MOVE(State)
+
+        // Drives the measured loop, `while (state.keepRunning()) { ... }`.
+        // The clock starts on the first call and stops on the last one.
+        bool keepRunning() noexcept;
+
+        // Excludes setup work inside the loop from the measurement.
+        void pauseTiming() noexcept;
+        void resumeTiming() noexcept;
+
+        void setItemsPerIteration(const u64 items) noexcept;
+
+        HELIOS_NO_DISCARD i64 size() const noexcept;
+        HELIOS_NO_DISCARD u64 iterations() const noexcept;
+        HELIOS_NO_DISCARD u64 itemsPerIteration() const noexcept;
+        HELIOS_NO_DISCARD f64 elapsedNanoseconds() const noexcept;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        u64 _iterations;
+        u64 _remaining;
+        i64 _size;
+        u64 _items = 1;
+        bool _started = false;
+        clock::time_point _start;
+        clock::duration _elapsed = clock::duration::zero();
+    };
+
+    using BenchmarkFunction = void (*)(State&);
+
+    struct Benchmark
+    {
+        std::string name;
+        BenchmarkFunction function;
+        std::vector<i64> sizes;
+    };
+
+    struct Registration
+    {
+        Registration(const char* group, const char* name,
+                     BenchmarkFunction function,
+                     std::initializer_list<i64> sizes);
+    };
+
+    std::vector<Benchmark>& registry();
+
+    // Runs every registered benchmark matching the command line filter,
+    // writes the JSON report and compares against a baseline report. Returns
+    // non-zero if any benchmark regressed past the threshold.
+    int run(int argc, char** argv);
+
+    // Keeps the optimiser from discarding a result or hoisting a computation
+    // out of the measured loop.
+    template <typename T>
+    inline void doNotOptimize(const T& value) noexcept
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline void clobberMemory() noexcept
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    inline State::State(const u64 iterations, const i64 size) noexcept
+        : _iterations(iterations), _remaining(iterations), _size(size)
+    {
+    }
+
+    inline bool State::keepRunning() noexcept
+    {
+        if (!_started)
+        {
+            _started = true;
+            _start = clock::now();
+        }
+
+        if (_remaining == 0)
+        {
+            _elapsed += clock::now() - _start;
+            return false;
+        }
+
+        --_remaining;
+        return true;
+    }
+
+    inline void State::pauseTiming() noexcept
+    {
+        _elapsed += clock::now() - _start;
+    }
+
+    inline void State::resumeTiming() noexcept
+    {
+        _start = clock::now();
+    }
+
+    inline void State::setItemsPerIteration(const u64 items) noexcept
+    {
+        _items = items;
+    }
+
+    inline i64 State::size() const noexcept
+    {
+        return _size;
+    }
+
+    inline u64 State::iterations() const noexcept
+    {
+        return _iterations;
+    }
+
+    inline u64 State::itemsPerIteration() const noexcept
+    {
+        return _items;
+    }
+
+    inline f64 State::elapsedNanoseconds() const noexcept
+    {
+        return std::chrono::duration<f64, std::nano>(_elapsed).count();
+    }
+} // namespace helios::bench
+
+#define HELIOS_BENCHMARK_IMPL(GROUP, NAME, ...)                                \
+    static void GROUP##_##NAME(::helios::bench::State& state);                 \
+    static const ::helios::bench::Registration GROUP##_##NAME##_registration(  \
+        #GROUP, #NAME, &GROUP##_##NAME, {__VA_ARGS__});                        \
+    static void GROUP##_##NAME(::helios::bench::State& state)
+
+// Registers a benchmark run once, reported as GROUP/NAME.
+#define HELIOS_BENCHMARK(GROUP, NAME) HELIOS_BENCHMARK_IMPL(GROUP, NAME, )
+
+// Registers a benchmark run once per size, reported as GROUP/NAME/size.
+#define HELIOS_BENCHMARK_SIZES(GROUP, NAME, ...)                               \
+    HELIOS_BENCHMARK_IMPL(GROUP, NAME, __VA_ARGS__)
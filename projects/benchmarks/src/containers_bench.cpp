@@ -0,0 +1,146 @@
+#include "benchmark.hpp"
+
+#include <helios/containers/slot_map.hpp>
+#include <helios/containers/unordered_map.hpp>
+#include <helios/containers/vector.hpp>
+
+#include <vector>
+
+using namespace helios;
+using helios::bench::doNotOptimize;
+
+#define HELIOS_CONTAINER_SIZES 16, 1024, 65536
+
+HELIOS_BENCHMARK_SIZES(vector, push_back, HELIOS_CONTAINER_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    while (state.keepRunning())
+    {
+        helios::vector<u32> values;
+        for (size_t i = 0; i < count; i++)
+        {
+            values.push_back(static_cast<u32>(i));
+        }
+        doNotOptimize(values.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(vector, push_back_reserved, HELIOS_CONTAINER_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    while (state.keepRunning())
+    {
+        helios::vector<u32> values;
+        values.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            values.push_back(static_cast<u32>(i));
+        }
+        doNotOptimize(values.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(slot_map, insert, HELIOS_CONTAINER_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    while (state.keepRunning())
+    {
+        slot_map<u32> map;
+        for (size_t i = 0; i < count; i++)
+        {
+            doNotOptimize(map.insert(static_cast<u32>(i)));
+        }
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(slot_map, erase, HELIOS_CONTAINER_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    slot_map<u32> map;
+    std::vector<slot_key<u32, allocator<u32>>> keys(count);
+
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        for (size_t i = 0; i < count; i++)
+        {
+            keys[i] = map.insert(static_cast<u32>(i));
+        }
+        state.resumeTiming();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            doNotOptimize(map.erase(keys[i]));
+        }
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(slot_map, get, HELIOS_CONTAINER_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    slot_map<u32> map;
+    std::vector<slot_key<u32, allocator<u32>>> keys(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        keys[i] = map.insert(static_cast<u32>(i));
+    }
+
+    while (state.keepRunning())
+    {
+        u32 sum = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            sum += map.get(keys[i]);
+        }
+        doNotOptimize(sum);
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(unordered_map, find, HELIOS_CONTAINER_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    unordered_map<u32, u32> map;
+    for (size_t i = 0; i < count; i++)
+    {
+        map.insert({static_cast<u32>(i * 7), static_cast<u32>(i)});
+    }
+
+    while (state.keepRunning())
+    {
+        u32 sum = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            sum += map.find(static_cast<u32>(i * 7))->second;
+        }
+        doNotOptimize(sum);
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(unordered_map, find_missing, HELIOS_CONTAINER_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    unordered_map<u32, u32> map;
+    for (size_t i = 0; i < count; i++)
+    {
+        map.insert({static_cast<u32>(i * 7), static_cast<u32>(i)});
+    }
+
+    while (state.keepRunning())
+    {
+        size_t misses = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            misses += map.find(static_cast<u32>(i * 7 + 1)) == map.end();
+        }
+        doNotOptimize(misses);
+    }
+    state.setItemsPerIteration(count);
+}
+
+#undef HELIOS_CONTAINER_SIZES
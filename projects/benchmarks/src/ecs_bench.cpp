@@ -0,0 +1,213 @@
+#include "benchmark.hpp"
+
+#include <helios/core/transformation.hpp>
+#include <helios/ecs/entity.hpp>
+#include <helios/ecs/snapshot.hpp>
+
+#include <memory>
+#include <thread>
+
+using namespace helios;
+using helios::bench::doNotOptimize;
+
+namespace
+{
+    struct Particle
+    {
+        Vector3f position;
+        Vector3f velocity;
+    };
+
+    struct Renderable
+    {
+        u32 mesh;
+        u32 material;
+    };
+
+    JobSystem& benchmarkJobs()
+    {
+        static JobSystem jobs(std::thread::hardware_concurrency() > 1
+                                  ? std::thread::hardware_concurrency() - 1
+                                  : 0);
+        return jobs;
+    }
+
+    void populateParticles(EntityManager& manager, const size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            const f32 f = static_cast<f32>(i);
+            manager.create().assign<Particle>(
+                Particle{Vector3f(f, 0.0f, -f), Vector3f(0.5f, 1.0f, 0.25f)});
+        }
+    }
+
+    // every entity moves, three in four render. Interleaving the two keeps
+    // the pools out of step so a view has to look components up.
+    void populateRenderables(EntityManager& manager, const size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            const f32 f = static_cast<f32>(i);
+            Entity e = manager.create();
+            if (i % 4 != 0)
+            {
+                e.assign<Renderable>(
+                    Renderable{static_cast<u32>(i), static_cast<u32>(i % 7)});
+            }
+            e.assign<Particle>(
+                Particle{Vector3f(f, 0.0f, -f), Vector3f(0.5f, 1.0f, 0.25f)});
+        }
+    }
+
+    void touch(Particle& p, const Renderable& r)
+    {
+        p.position.x += static_cast<f32>(r.material) * 0.016f;
+    }
+} // namespace
+
+#define HELIOS_ECS_SIZES 10000, 100000, 1000000
+
+HELIOS_BENCHMARK_SIZES(EntityManager, each, HELIOS_ECS_SIZES)
+{
+    EntityManager manager;
+    populateParticles(manager, static_cast<size_t>(state.size()));
+
+    while (state.keepRunning())
+    {
+        manager.each<void (*)(Particle&), Particle>([](Particle& p) {
+            p.position += p.velocity * 0.016f;
+        });
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(EntityManager, parallel_each, HELIOS_ECS_SIZES)
+{
+    EntityManager manager(&benchmarkJobs());
+    populateParticles(manager, static_cast<size_t>(state.size()));
+
+    while (state.keepRunning())
+    {
+        manager.parallel_each<Read<>, Write<Particle>>([](Particle& p) {
+            p.position += p.velocity * 0.016f;
+        });
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(EntityManager, parallel_reduce, HELIOS_ECS_SIZES)
+{
+    EntityManager manager(&benchmarkJobs());
+    populateParticles(manager, static_cast<size_t>(state.size()));
+
+    while (state.keepRunning())
+    {
+        const f32 sum = manager.parallel_reduce<Read<Particle>>(
+            0.0f, [](f32& acc, const Particle& p) { acc += p.position.y; },
+            [](f32 lhs, f32 rhs) { return lhs + rhs; });
+        doNotOptimize(sum);
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(EntityManager, view_pair, HELIOS_ECS_SIZES)
+{
+    EntityManager manager;
+    populateRenderables(manager, static_cast<size_t>(state.size()));
+
+    while (state.keepRunning())
+    {
+        manager.each<void (*)(Particle&, Renderable&), Particle, Renderable>(
+            [](Particle& p, Renderable& r) { touch(p, r); });
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(EntityManager, partial_group_pair, HELIOS_ECS_SIZES)
+{
+    EntityManager manager;
+    auto group = manager.group<Particle>(Get<Renderable>{});
+    populateRenderables(manager, static_cast<size_t>(state.size()));
+
+    while (state.keepRunning())
+    {
+        group.each([](Particle& p, Renderable& r) { touch(p, r); });
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(EntityManager, owning_group_pair, HELIOS_ECS_SIZES)
+{
+    EntityManager manager;
+    auto group = manager.group<Particle, Renderable>();
+    populateRenderables(manager, static_cast<size_t>(state.size()));
+
+    while (state.keepRunning())
+    {
+        group.each([](Particle& p, Renderable& r) { touch(p, r); });
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(EntityManager, owning_group_parallel_each,
+                       HELIOS_ECS_SIZES)
+{
+    EntityManager manager(&benchmarkJobs());
+    auto group = manager.group<Particle, Renderable>();
+    populateRenderables(manager, static_cast<size_t>(state.size()));
+
+    while (state.keepRunning())
+    {
+        group.parallel_each([](Particle& p, Renderable& r) { touch(p, r); });
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(Snapshot, save, HELIOS_ECS_SIZES)
+{
+    EntityManager manager;
+    populateRenderables(manager, static_cast<size_t>(state.size()));
+
+    Snapshot snapshot;
+    snapshot.component<Particle>("particle").component<Renderable>("renderable");
+
+    while (state.keepRunning())
+    {
+        doNotOptimize(snapshot.save(manager));
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(Snapshot, load, HELIOS_ECS_SIZES)
+{
+    Snapshot snapshot;
+    snapshot.component<Particle>("particle").component<Renderable>("renderable");
+
+    std::vector<u8> data;
+    {
+        EntityManager source;
+        populateRenderables(source, static_cast<size_t>(state.size()));
+        data = snapshot.save(source);
+    }
+
+    std::unique_ptr<EntityManager> manager;
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        manager = std::make_unique<EntityManager>();
+        state.resumeTiming();
+
+        doNotOptimize(snapshot.load(*manager, data.data(), data.size()));
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+#undef HELIOS_ECS_SIZES
@@ -0,0 +1,130 @@
+#include "benchmark.hpp"
+
+#include <helios/core/job_system.hpp>
+#include <helios/io/file.hpp>
+#include <helios/io/image_decoder.hpp>
+
+#include <stb_image.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // The PNGs shipped with the demos, read into memory once so the
+    // benchmarks measure decoding rather than the disk. Empty when the
+    // assets are not found from the working directory.
+    const std::vector<std::vector<u8>>& imageAssets()
+    {
+        static const std::vector<std::vector<u8>> assets = [] {
+            const char* paths[] = {
+                "textures/dragon.png",
+                "models/cube/Cube_BaseColor.png",
+                "models/cube/Cube_MetallicRoughness.png",
+                "models/barramundi/BarramundiFish_normal.png",
+            };
+
+            std::vector<std::vector<u8>> files;
+            for (const char* path : paths)
+            {
+                std::string prefix;
+                for (u32 depth = 0; depth < 5; depth++)
+                {
+                    const std::string file = prefix + "assets/" + path;
+                    if (std::filesystem::exists(file))
+                    {
+                        const MappedFile mapped(file);
+                        const span<const u8> bytes = mapped.bytes();
+                        files.emplace_back(bytes.data(),
+                                           bytes.data() + bytes.size());
+                        break;
+                    }
+                    prefix += "../";
+                }
+            }
+            return files;
+        }();
+        return assets;
+    }
+
+    JobSystem& imageJobs()
+    {
+        static JobSystem jobs(std::thread::hardware_concurrency() > 1
+                                  ? std::thread::hardware_concurrency() - 1
+                                  : 0);
+        return jobs;
+    }
+
+    void decodeAssets(bench::State& state, JobSystem* jobs)
+    {
+        ImageDecoder decoder(jobs);
+        u64 pixels = 0;
+        for (const std::vector<u8>& asset : imageAssets())
+        {
+            const u32 index =
+                decoder.add(span<const u8>(asset.data(), asset.size()), true);
+            pixels += u64(decoder.info(index).width) * decoder.info(index).height;
+        }
+        std::vector<u8> staging(decoder.size());
+
+        while (state.keepRunning())
+        {
+            decoder.decode(staging.data());
+            bench::clobberMemory();
+        }
+        state.setItemsPerIteration(pixels);
+    }
+} // namespace
+
+// The load path before the decoder: stb_image on one thread into its own
+// allocation, then copied into the staging memory.
+HELIOS_BENCHMARK(ImageDecode, stb_image)
+{
+    u64 pixels = 0;
+    for (const std::vector<u8>& asset : imageAssets())
+    {
+        ImageInfo info;
+        readImageInfo(span<const u8>(asset.data(), asset.size()), info);
+        pixels += u64(info.width) * info.height;
+    }
+    std::vector<u8> staging(pixels * 4);
+
+    while (state.keepRunning())
+    {
+        size_t offset = 0;
+        for (const std::vector<u8>& asset : imageAssets())
+        {
+            i32 width;
+            i32 height;
+            i32 channels;
+            stbi_uc* decoded = stbi_load_from_memory(
+                asset.data(), static_cast<i32>(asset.size()), &width, &height,
+                &channels, STBI_rgb_alpha);
+            if (decoded == nullptr)
+            {
+                continue;
+            }
+            const size_t size = static_cast<size_t>(width) * height * 4;
+            memcpy(staging.data() + offset, decoded, size);
+            offset += size;
+            stbi_image_free(decoded);
+        }
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(pixels);
+}
+
+HELIOS_BENCHMARK(ImageDecode, serial)
+{
+    decodeAssets(state, nullptr);
+}
+
+HELIOS_BENCHMARK(ImageDecode, parallel)
+{
+    decodeAssets(state, &imageJobs());
+}
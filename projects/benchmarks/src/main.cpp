@@ -0,0 +1,17 @@
+#include "containers_bench.cpp"
+#include "ecs_bench.cpp"
+#include "image_bench.cpp"
+#include "matrix_bench.cpp"
+#include "mesh_bench.cpp"
+#include "spatial_bench.cpp"
+#include "texture_bench.cpp"
+#include "transform_system_bench.cpp"
+#include "transformations_bench.cpp"
+#include "vector_bench.cpp"
+
+#include "benchmark.hpp"
+
+int main(int argc, char** argv)
+{
+    return helios::bench::run(argc, argv);
+}
@@ -0,0 +1,106 @@
+#include "benchmark.hpp"
+
+#include <helios/math/matrix.hpp>
+
+#include <vector>
+
+using namespace helios;
+using helios::bench::doNotOptimize;
+
+namespace
+{
+    std::vector<Matrix4f> makeMatrices(const size_t count, const f32 seed)
+    {
+        std::vector<Matrix4f> values(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            // diagonally dominant, so every matrix is invertible
+            Matrix4f m(4.0f + seed);
+            for (i32 j = 0; j < 16; j++)
+            {
+                m.data[j] += static_cast<f32>((i + j) % 7) * 0.125f;
+            }
+            values[i] = m;
+        }
+        return values;
+    }
+} // namespace
+
+#define HELIOS_MATRIX_SIZES 16, 1024, 16384
+
+HELIOS_BENCHMARK_SIZES(Matrix4f, multiply, HELIOS_MATRIX_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const std::vector<Matrix4f> lhs = makeMatrices(count, 1.0f);
+    const std::vector<Matrix4f> rhs = makeMatrices(count, 2.0f);
+    std::vector<Matrix4f> out(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = lhs[i] * rhs[i];
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(Matrix4f, inverse, HELIOS_MATRIX_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const std::vector<Matrix4f> src = makeMatrices(count, 1.0f);
+    std::vector<Matrix4f> out(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = src[i].inverse();
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(Matrix4f, transformVector, HELIOS_MATRIX_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const Matrix4f m = makeMatrices(1, 1.0f)[0];
+    std::vector<Vector4f> points(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        points[i] = Vector4f(static_cast<f32>(i), 1.0f, -2.0f, 1.0f);
+    }
+    std::vector<Vector4f> out(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = m * points[i];
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(Matrix4f, add, HELIOS_MATRIX_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const std::vector<Matrix4f> lhs = makeMatrices(count, 1.0f);
+    const std::vector<Matrix4f> rhs = makeMatrices(count, 2.0f);
+    std::vector<Matrix4f> out(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = lhs[i] + rhs[i];
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+#undef HELIOS_MATRIX_SIZES
@@ -0,0 +1,467 @@
+#include "benchmark.hpp"
+
+#include <helios/core/cooked_mesh.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/core/mesh.hpp>
+#include <helios/core/mesh_optimizer.hpp>
+#include <helios/core/mesh_simplifier.hpp>
+#include <helios/core/meshlet.hpp>
+#include <helios/math/packed.hpp>
+#include <helios/math/transformations.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace helios;
+using helios::bench::doNotOptimize;
+
+namespace
+{
+    template <typename T>
+    void appendBytes(std::vector<u8>& out, const T* data, const size_t count)
+    {
+        const size_t offset = out.size();
+        out.resize(offset + count * sizeof(T));
+        memcpy(out.data() + offset, data, count * sizeof(T));
+    }
+
+    // A .glb of a side x side vertex grid with positions, normals, uvs and
+    // u16 indices, drawn by as many primitives as asked for.
+    std::vector<u8> makeGridGlb(const u32 side, const u32 primitives = 1)
+    {
+        std::vector<f32> positions;
+        std::vector<f32> normals;
+        std::vector<f32> uvs;
+        std::vector<u16> indices;
+        for (u32 y = 0; y < side; y++)
+        {
+            for (u32 x = 0; x < side; x++)
+            {
+                positions.insert(positions.end(), {f32(x), 0.0f, f32(y)});
+                normals.insert(normals.end(), {0.0f, 1.0f, 0.0f});
+                uvs.insert(uvs.end(),
+                           {f32(x) / f32(side), f32(y) / f32(side)});
+            }
+        }
+        for (u32 y = 0; y + 1 < side; y++)
+        {
+            for (u32 x = 0; x + 1 < side; x++)
+            {
+                const u16 i = static_cast<u16>(y * side + x);
+                const u16 right = static_cast<u16>(i + 1);
+                const u16 below = static_cast<u16>(i + side);
+                indices.insert(indices.end(),
+                               {i, below, right, right, below,
+                                static_cast<u16>(below + 1)});
+            }
+        }
+
+        std::vector<u8> bin;
+        appendBytes(bin, positions.data(), positions.size());
+        appendBytes(bin, normals.data(), normals.size());
+        appendBytes(bin, uvs.data(), uvs.size());
+        appendBytes(bin, indices.data(), indices.size());
+        while (bin.size() % 4 != 0)
+        {
+            bin.push_back(0);
+        }
+
+        const size_t vertices = positions.size() / 3;
+        const size_t normalOffset = positions.size() * sizeof(f32);
+        const size_t uvOffset = normalOffset + normals.size() * sizeof(f32);
+        const size_t indexOffset = uvOffset + uvs.size() * sizeof(f32);
+
+        using nlohmann::json;
+        json document;
+        document["asset"] = {{"version", "2.0"}};
+        document["buffers"] = json::array({{{"byteLength", bin.size()}}});
+        document["bufferViews"] = json::array(
+            {{{"buffer", 0}, {"byteOffset", 0}, {"byteLength", normalOffset}},
+             {{"buffer", 0},
+              {"byteOffset", normalOffset},
+              {"byteLength", uvOffset - normalOffset}},
+             {{"buffer", 0},
+              {"byteOffset", uvOffset},
+              {"byteLength", indexOffset - uvOffset}},
+             {{"buffer", 0},
+              {"byteOffset", indexOffset},
+              {"byteLength", indices.size() * sizeof(u16)}}});
+        document["accessors"] = json::array(
+            {{{"bufferView", 0},
+              {"componentType", 5126},
+              {"count", vertices},
+              {"type", "VEC3"}},
+             {{"bufferView", 1},
+              {"componentType", 5126},
+              {"count", vertices},
+              {"type", "VEC3"}},
+             {{"bufferView", 2},
+              {"componentType", 5126},
+              {"count", vertices},
+              {"type", "VEC2"}},
+             {{"bufferView", 3},
+              {"componentType", 5123},
+              {"count", indices.size()},
+              {"type", "SCALAR"}}});
+        json primitive = {
+            {"attributes", {{"POSITION", 0}, {"NORMAL", 1}, {"TEXCOORD_0", 2}}},
+            {"indices", 3}};
+        json primitiveList = json::array();
+        for (u32 i = 0; i < primitives; i++)
+        {
+            primitiveList.push_back(primitive);
+        }
+        document["meshes"] = json::array({{{"primitives", primitiveList}}});
+
+        std::string text = document.dump();
+        while (text.size() % 4 != 0)
+        {
+            text.push_back(' ');
+        }
+
+        const u32 header[3] = {
+            0x46546C67, 2,
+            static_cast<u32>(12 + 8 + text.size() + 8 + bin.size())};
+        const u32 jsonChunk[2] = {static_cast<u32>(text.size()), 0x4E4F534A};
+        const u32 binChunk[2] = {static_cast<u32>(bin.size()), 0x004E4942};
+
+        std::vector<u8> glb;
+        appendBytes(glb, header, 3);
+        appendBytes(glb, jsonChunk, 2);
+        appendBytes(glb, text.data(), text.size());
+        appendBytes(glb, binChunk, 2);
+        appendBytes(glb, bin.data(), bin.size());
+        return glb;
+    }
+
+    // what the renderer does with either result, copy every stream into
+    // staging memory
+    void copyToStaging(const CookedMesh& mesh, std::vector<u8>& staging)
+    {
+        size_t offset = 0;
+        for (u32 i = 0; i < mesh.subMeshCount(); i++)
+        {
+            const CookedMesh::SubMesh& subMesh = mesh.subMesh(i);
+            for (const span<const u8> stream :
+                 {subMesh.positions, subMesh.attributes, subMesh.indices})
+            {
+                memcpy(staging.data() + offset, stream.data(), stream.size());
+                offset += stream.size();
+            }
+        }
+    }
+
+    void copyToStaging(const Mesh& mesh, std::vector<u8>& staging)
+    {
+        size_t offset = 0;
+        for (const Mesh* subMesh : mesh.subMeshes)
+        {
+            for (u32 i = 0; i < subMesh->bufferCount(); i++)
+            {
+                memcpy(staging.data() + offset, subMesh->readBuffer(i),
+                       subMesh->bufferSize(i));
+                offset += subMesh->bufferSize(i);
+            }
+            memcpy(staging.data() + offset, subMesh->triangles.data(),
+                   subMesh->triangles.size() * sizeof(u32));
+            offset += subMesh->triangles.size() * sizeof(u32);
+        }
+    }
+
+    // side x side quads of gently rolling terrain facing +y
+    void fillHeightfield(Mesh& mesh, const u32 side)
+    {
+        const u32 corners = side + 1;
+        mesh.positions.reserve(corners * corners);
+        mesh.triangles.reserve(side * side * 6);
+        for (u32 y = 0; y < corners; y++)
+        {
+            for (u32 x = 0; x < corners; x++)
+            {
+                const f32 height =
+                    std::sin(f32(x) * 0.2f) * std::cos(f32(y) * 0.15f);
+                mesh.positions.push_back(Vector3f(f32(x), height, f32(y)));
+            }
+        }
+        for (u32 y = 0; y < side; y++)
+        {
+            for (u32 x = 0; x < side; x++)
+            {
+                const u32 first = y * corners + x;
+                for (const u32 index :
+                     {first, first + corners, first + 1, first + 1,
+                      first + corners, first + corners + 1})
+                {
+                    mesh.triangles.push_back(index);
+                }
+            }
+        }
+    }
+} // namespace
+
+// sizes are the side of the vertex grid, indices are u16 so at most 255
+#define HELIOS_MESH_SIZES 64, 255
+
+HELIOS_BENCHMARK_SIZES(MeshLoad, gltf, HELIOS_MESH_SIZES)
+{
+    const std::vector<u8> glb = makeGridGlb(static_cast<u32>(state.size()));
+    std::vector<u8> staging;
+    {
+        const Mesh mesh(span<const u8>(glb.data(), glb.size()), "");
+        staging.resize(CookedMesh::cook(mesh).size());
+    }
+
+    while (state.keepRunning())
+    {
+        const Mesh mesh(span<const u8>(glb.data(), glb.size()), "");
+        copyToStaging(mesh, staging);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size() * state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(MeshLoad, cooked, HELIOS_MESH_SIZES)
+{
+    const std::vector<u8> glb = makeGridGlb(static_cast<u32>(state.size()));
+    std::vector<u8> cooked;
+    {
+        const Mesh mesh(span<const u8>(glb.data(), glb.size()), "");
+        cooked = CookedMesh::cook(mesh);
+    }
+    std::vector<u8> staging(cooked.size());
+
+    while (state.keepRunning())
+    {
+        const CookedMesh mesh(span<const u8>(cooked.data(), cooked.size()));
+        doNotOptimize(mesh.valid());
+        copyToStaging(mesh, staging);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size() * state.size()));
+}
+
+JobSystem& meshJobs()
+{
+    static JobSystem jobs(std::thread::hardware_concurrency() > 1
+                              ? std::thread::hardware_concurrency() - 1
+                              : 0);
+    return jobs;
+}
+
+// sizes are the primitive count, each a 64 x 64 grid
+#define HELIOS_MESH_PRIMITIVES 16, 128
+
+HELIOS_BENCHMARK_SIZES(MeshImport, serial, HELIOS_MESH_PRIMITIVES)
+{
+    const std::vector<u8> glb =
+        makeGridGlb(64, static_cast<u32>(state.size()));
+
+    while (state.keepRunning())
+    {
+        const Mesh mesh(span<const u8>(glb.data(), glb.size()), "");
+        doNotOptimize(mesh.subMeshes.size());
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(MeshImport, parallel, HELIOS_MESH_PRIMITIVES)
+{
+    const std::vector<u8> glb =
+        makeGridGlb(64, static_cast<u32>(state.size()));
+
+    while (state.keepRunning())
+    {
+        const Mesh mesh(span<const u8>(glb.data(), glb.size()), "",
+                        EVertexFormat::FULL, &meshJobs());
+        doNotOptimize(mesh.subMeshes.size());
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+// sizes are the side of an unshared quad grid, as flat shaded exports are
+#define HELIOS_OPTIMIZE_SIZES 64, 256
+
+HELIOS_BENCHMARK_SIZES(MeshOptimize, grid, HELIOS_OPTIMIZE_SIZES)
+{
+    const u32 side = static_cast<u32>(state.size());
+
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        Mesh mesh;
+        mesh.positions.reserve(side * side * 4);
+        mesh.triangles.reserve(side * side * 6);
+        for (u32 y = 0; y < side; y++)
+        {
+            for (u32 x = 0; x < side; x++)
+            {
+                const u32 first = static_cast<u32>(mesh.positions.size());
+                for (u32 corner = 0; corner < 4; corner++)
+                {
+                    mesh.positions.push_back(Vector3f(
+                        f32(x + (corner & 1)), 0.0f, f32(y + (corner >> 1))));
+                }
+                for (const u32 corner : {0, 2, 1, 1, 2, 3})
+                {
+                    mesh.triangles.push_back(first + corner);
+                }
+            }
+        }
+        state.resumeTiming();
+
+        optimizeMesh(mesh);
+        doNotOptimize(mesh.triangles.data());
+    }
+    state.setItemsPerIteration(static_cast<u64>(side * side * 2));
+}
+
+HELIOS_BENCHMARK_SIZES(MeshSimplify, heightfield, HELIOS_OPTIMIZE_SIZES)
+{
+    const u32 side = static_cast<u32>(state.size());
+    Mesh mesh;
+    fillHeightfield(mesh, side);
+
+    while (state.keepRunning())
+    {
+        const vector<u32> simplified = simplify(
+            span<const u32>(mesh.triangles.data(), mesh.triangles.size()),
+            span<const Vector3f>(mesh.positions.data(), mesh.positions.size()),
+            mesh.triangles.size() / 4, 0.01f);
+        doNotOptimize(simplified.data());
+    }
+    state.setItemsPerIteration(static_cast<u64>(side * side * 2));
+}
+
+HELIOS_BENCHMARK_SIZES(MeshletBuild, heightfield, HELIOS_OPTIMIZE_SIZES)
+{
+    const u32 side = static_cast<u32>(state.size());
+    Mesh mesh;
+    fillHeightfield(mesh, side);
+    optimizeMesh(mesh);
+
+    while (state.keepRunning())
+    {
+        buildMeshlets(mesh);
+        doNotOptimize(mesh.meshlets.data());
+    }
+    state.setItemsPerIteration(static_cast<u64>(side * side * 2));
+}
+
+// items are meshlets, seen from above one edge of the terrain looking
+// across it so part of it is outside the frustum
+HELIOS_BENCHMARK_SIZES(MeshletCull, heightfield, HELIOS_OPTIMIZE_SIZES)
+{
+    const u32 side = static_cast<u32>(state.size());
+    Mesh mesh;
+    fillHeightfield(mesh, side);
+    optimizeMesh(mesh);
+    buildMeshlets(mesh);
+
+    const Vector3f camera(f32(side) * 0.5f, 8.0f, f32(side) * 1.1f);
+    const Frustum frustum(perspective(60.0f, 1.5f, 0.1f, 1000.0f) *
+                          translate(Vector3f(0.0f, 0.0f, 0.0f) - camera));
+    vector<DrawIndexedIndirectCommand> commands;
+    commands.reserve(mesh.meshlets.size());
+
+    while (state.keepRunning())
+    {
+        const size_t visible = cullMeshlets(
+            span<const Meshlet>(mesh.meshlets.data(), mesh.meshlets.size()),
+            frustum, camera, commands);
+        doNotOptimize(visible);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(mesh.meshlets.size()));
+}
+
+#undef HELIOS_OPTIMIZE_SIZES
+
+// sizes are element counts of one accessor
+#define HELIOS_ACCESSOR_SIZES 4096, 1 << 20
+
+HELIOS_BENCHMARK_SIZES(AccessorDecode, indices_scalar, HELIOS_ACCESSOR_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    std::vector<u16> src(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        src[i] = static_cast<u16>(i * 7);
+    }
+    std::vector<u32> dst(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            dst[i] = src[i];
+        }
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(count));
+}
+
+HELIOS_BENCHMARK_SIZES(AccessorDecode, indices_batch, HELIOS_ACCESSOR_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    std::vector<u16> src(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        src[i] = static_cast<u16>(i * 7);
+    }
+    std::vector<u32> dst(count);
+
+    while (state.keepRunning())
+    {
+        widenIndices(src.data(), dst.data(), count);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(count));
+}
+
+HELIOS_BENCHMARK_SIZES(AccessorDecode, snorm16_scalar, HELIOS_ACCESSOR_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    std::vector<i16> src(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        src[i] = static_cast<i16>(i * 7);
+    }
+    std::vector<f32> dst(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            dst[i] = unpackSnorm16(src[i]);
+        }
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(count));
+}
+
+HELIOS_BENCHMARK_SIZES(AccessorDecode, snorm16_batch, HELIOS_ACCESSOR_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    std::vector<i16> src(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        src[i] = static_cast<i16>(i * 7);
+    }
+    std::vector<f32> dst(count);
+
+    while (state.keepRunning())
+    {
+        unpackSnorm16(src.data(), dst.data(), count);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(count));
+}
+
+#undef HELIOS_ACCESSOR_SIZES
+#undef HELIOS_MESH_PRIMITIVES
+#undef HELIOS_MESH_SIZES
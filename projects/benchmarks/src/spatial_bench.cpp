@@ -0,0 +1,279 @@
+#include "benchmark.hpp"
+
+#include <helios/core/aabb_tree.hpp>
+#include <helios/core/spatial_index.hpp>
+#include <helios/core/transform_system.hpp>
+#include <helios/math/transformations.hpp>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace helios;
+using helios::bench::doNotOptimize;
+
+namespace
+{
+    constexpr f32 world_extent = 1000.0f;
+
+    JobSystem& spatialJobs()
+    {
+        static JobSystem jobs(std::thread::hardware_concurrency() > 1
+                                  ? std::thread::hardware_concurrency() - 1
+                                  : 0);
+        return jobs;
+    }
+
+    std::vector<AABB> makeBoxes(const size_t count, const u32 seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<f32> position(-world_extent,
+                                                     world_extent);
+        std::uniform_real_distribution<f32> size(0.5f, 4.0f);
+
+        std::vector<AABB> boxes(count);
+        for (auto& box : boxes)
+        {
+            const Vector3f min(position(rng), position(rng), position(rng));
+            box = AABB(min, min + Vector3f(size(rng), size(rng), size(rng)));
+        }
+        return boxes;
+    }
+
+    AABB offset(const AABB& box, const Vector3f& delta)
+    {
+        return AABB(box.min + delta, box.max + delta);
+    }
+
+    std::vector<u32> fillTree(DynamicAABBTree& tree,
+                              const std::vector<AABB>& boxes)
+    {
+        std::vector<u32> proxies(boxes.size());
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            proxies[i] = tree.insert(boxes[i], static_cast<u32>(i));
+        }
+        return proxies;
+    }
+
+    Frustum benchmarkFrustum()
+    {
+        return Frustum(perspective(60.0f, 16.0f / 9.0f, 0.1f, 500.0f) *
+                       translate(Vector3f(0.0f, 0.0f, -world_extent * 0.5f)));
+    }
+} // namespace
+
+#define HELIOS_SPATIAL_SIZES 10000, 100000
+
+HELIOS_BENCHMARK_SIZES(DynamicAABBTree, insert, HELIOS_SPATIAL_SIZES)
+{
+    const std::vector<AABB> boxes =
+        makeBoxes(static_cast<size_t>(state.size()), 1);
+
+    while (state.keepRunning())
+    {
+        DynamicAABBTree tree;
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            doNotOptimize(tree.insert(boxes[i], static_cast<u32>(i)));
+        }
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+// one object in a hundred crosses its fat box per frame
+HELIOS_BENCHMARK_SIZES(DynamicAABBTree, move_incremental, HELIOS_SPATIAL_SIZES)
+{
+    std::vector<AABB> boxes = makeBoxes(static_cast<size_t>(state.size()), 2);
+    DynamicAABBTree tree;
+    const std::vector<u32> proxies = fillTree(tree, boxes);
+
+    const size_t moves = boxes.size() / 100;
+    size_t next = 0;
+    f32 direction = 1.0f;
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < moves; i++)
+        {
+            const size_t index = (next + i * 97) % boxes.size();
+            boxes[index] = offset(boxes[index], Vector3f(direction, 0.0f, 0.0f));
+            doNotOptimize(tree.move(proxies[index], boxes[index]));
+        }
+        next += moves;
+        direction = -direction;
+    }
+    state.setItemsPerIteration(moves);
+}
+
+// every object jitters, the batched path the SpatialIndex takes
+HELIOS_BENCHMARK_SIZES(DynamicAABBTree, refit_all, HELIOS_SPATIAL_SIZES)
+{
+    std::vector<AABB> boxes = makeBoxes(static_cast<size_t>(state.size()), 3);
+    DynamicAABBTree tree;
+    const std::vector<u32> proxies = fillTree(tree, boxes);
+    JobSystem& jobs = spatialJobs();
+
+    f32 direction = 0.25f;
+    while (state.keepRunning())
+    {
+        jobs.parallelFor(boxes.size(), 1024, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                boxes[i] = offset(boxes[i], Vector3f(direction));
+                tree.setBounds(proxies[i], boxes[i]);
+            }
+        });
+        tree.refit(&jobs);
+        direction = -direction;
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(DynamicAABBTree, rebuild, HELIOS_SPATIAL_SIZES)
+{
+    const std::vector<AABB> boxes =
+        makeBoxes(static_cast<size_t>(state.size()), 4);
+    DynamicAABBTree tree;
+    fillTree(tree, boxes);
+
+    while (state.keepRunning())
+    {
+        tree.rebuild(&spatialJobs());
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(DynamicAABBTree, query_frustum, HELIOS_SPATIAL_SIZES)
+{
+    const std::vector<AABB> boxes =
+        makeBoxes(static_cast<size_t>(state.size()), 5);
+    DynamicAABBTree tree;
+    fillTree(tree, boxes);
+    const Frustum frustum = benchmarkFrustum();
+
+    while (state.keepRunning())
+    {
+        u32 visible = 0;
+        tree.query(frustum, [&visible](u32) { ++visible; });
+        doNotOptimize(visible);
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+// the linear scan every consumer did before the index
+HELIOS_BENCHMARK_SIZES(DynamicAABBTree, query_frustum_linear,
+                       HELIOS_SPATIAL_SIZES)
+{
+    const std::vector<AABB> boxes =
+        makeBoxes(static_cast<size_t>(state.size()), 5);
+    const Frustum frustum = benchmarkFrustum();
+
+    while (state.keepRunning())
+    {
+        u32 visible = 0;
+        for (const AABB& box : boxes)
+        {
+            visible += frustum.intersects(box) ? 1 : 0;
+        }
+        doNotOptimize(visible);
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+HELIOS_BENCHMARK_SIZES(DynamicAABBTree, query_aabb, HELIOS_SPATIAL_SIZES)
+{
+    const std::vector<AABB> boxes =
+        makeBoxes(static_cast<size_t>(state.size()), 6);
+    DynamicAABBTree tree;
+    fillTree(tree, boxes);
+    const std::vector<AABB> queries = makeBoxes(256, 7);
+
+    while (state.keepRunning())
+    {
+        u32 hits = 0;
+        for (const AABB& query : queries)
+        {
+            const AABB grown(query.min - Vector3f(10.0f),
+                             query.max + Vector3f(10.0f));
+            tree.query(grown, [&hits](u32) { ++hits; });
+        }
+        doNotOptimize(hits);
+    }
+    state.setItemsPerIteration(256);
+}
+
+HELIOS_BENCHMARK_SIZES(DynamicAABBTree, raycast_closest, HELIOS_SPATIAL_SIZES)
+{
+    const std::vector<AABB> boxes =
+        makeBoxes(static_cast<size_t>(state.size()), 8);
+    DynamicAABBTree tree;
+    fillTree(tree, boxes);
+    const std::vector<AABB> targets = makeBoxes(256, 9);
+
+    while (state.keepRunning())
+    {
+        f32 total = 0.0f;
+        for (const AABB& target : targets)
+        {
+            const Ray ray(Vector3f(0.0f), target.center());
+            f32 closest = 1.0f;
+            tree.raycast(ray, closest, [&](u32 proxy, f32) {
+                f32 distance;
+                if (ray.intersects(boxes[tree.userData(proxy)], distance) &&
+                    distance < closest)
+                {
+                    closest = distance;
+                }
+                return closest;
+            });
+            total += closest;
+        }
+        doNotOptimize(total);
+    }
+    state.setItemsPerIteration(256);
+}
+
+// 100k dynamic entities all moving every frame, only the index update is
+// timed
+HELIOS_BENCHMARK_SIZES(SpatialIndex, update_all_moving, HELIOS_SPATIAL_SIZES)
+{
+    EntityManager manager;
+    TransformSystem transforms(manager, spatialJobs());
+    SpatialIndex index(manager, spatialJobs());
+
+    const std::vector<AABB> boxes =
+        makeBoxes(static_cast<size_t>(state.size()), 10);
+    std::vector<Entity> entities;
+    entities.reserve(boxes.size());
+    for (const AABB& box : boxes)
+    {
+        Entity e = manager.create();
+        e.assign<TransformationComponent>(box.center(), Vector3f(0.0f),
+                                          Vector3f(1.0f));
+        e.assign<BoundsComponent>(
+            BoundsComponent{AABB(box.extents() * -1.0f, box.extents())});
+        entities.push_back(e);
+    }
+    transforms.update();
+    index.update();
+
+    f32 direction = 0.25f;
+    while (state.keepRunning())
+    {
+        state.pauseTiming();
+        for (Entity& e : entities)
+        {
+            auto& transform = e.get<TransformationComponent>();
+            transform.setPosition(transform.getPosition() + Vector3f(direction));
+        }
+        transforms.update();
+        direction = -direction;
+        state.resumeTiming();
+
+        index.update();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
+
+#undef HELIOS_SPATIAL_SIZES
@@ -0,0 +1,125 @@
+#include "benchmark.hpp"
+
+#include <helios/core/cooked_texture.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/math/block_compression.hpp>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace helios;
+using helios::bench::doNotOptimize;
+
+#define HELIOS_TEXTURE_SIZES 64, 256, 1024
+
+namespace
+{
+    // side x side RGBA8 pixels of smooth gradients with a little noise, so
+    // blocks neither collapse to one colour nor are pure noise
+    std::vector<u8> makeTexture(const u32 side)
+    {
+        std::vector<u8> pixels(static_cast<size_t>(side) * side * 4);
+        u32 seed = 0x1234567u;
+        for (u32 y = 0; y < side; y++)
+        {
+            for (u32 x = 0; x < side; x++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                const u32 noise = (seed >> 24) & 15;
+                u8* pixel = pixels.data() + (static_cast<size_t>(y) * side + x) * 4;
+                pixel[0] = static_cast<u8>((x * 255 / side + noise) & 0xFF);
+                pixel[1] = static_cast<u8>((y * 255 / side + noise) & 0xFF);
+                pixel[2] = static_cast<u8>(((x + y) * 127 / side) & 0xFF);
+                pixel[3] = static_cast<u8>(255 - noise * 4);
+            }
+        }
+        return pixels;
+    }
+
+    JobSystem& textureJobs()
+    {
+        static JobSystem jobs(std::thread::hardware_concurrency() > 1
+                                  ? std::thread::hardware_concurrency() - 1
+                                  : 0);
+        return jobs;
+    }
+
+    template <typename Encode>
+    void encodeBlocks(bench::State& state, Encode&& encode,
+                      const size_t blockSize)
+    {
+        const u32 side = static_cast<u32>(state.size());
+        const std::vector<u8> pixels = makeTexture(side);
+        std::vector<u8> blocks(side / 4 * side / 4 * blockSize);
+
+        while (state.keepRunning())
+        {
+            u8 block[16 * 4];
+            size_t index = 0;
+            for (u32 by = 0; by < side; by += 4)
+            {
+                for (u32 bx = 0; bx < side; bx += 4)
+                {
+                    for (u32 y = 0; y < 4; y++)
+                    {
+                        memcpy(block + y * 16,
+                               pixels.data() +
+                                   (static_cast<size_t>(by + y) * side + bx) * 4,
+                               16);
+                    }
+                    encode(block, blocks.data() + index * blockSize);
+                    index++;
+                }
+            }
+            doNotOptimize(blocks.data());
+        }
+        state.setItemsPerIteration(static_cast<u64>(side / 4) * (side / 4));
+    }
+} // namespace
+
+// items are 4x4 blocks
+HELIOS_BENCHMARK_SIZES(BlockCompression, bc1, HELIOS_TEXTURE_SIZES)
+{
+    encodeBlocks(
+        state, [](const u8* pixels, u8* block) { encodeBC1(pixels, block); },
+        bc1_block_size);
+}
+
+HELIOS_BENCHMARK_SIZES(BlockCompression, bc3, HELIOS_TEXTURE_SIZES)
+{
+    encodeBlocks(
+        state, [](const u8* pixels, u8* block) { encodeBC3(pixels, block); },
+        bc3_block_size);
+}
+
+HELIOS_BENCHMARK_SIZES(BlockCompression, bc5, HELIOS_TEXTURE_SIZES)
+{
+    encodeBlocks(
+        state, [](const u8* pixels, u8* block) { encodeBC5(pixels, block); },
+        bc5_block_size);
+}
+
+HELIOS_BENCHMARK_SIZES(BlockCompression, bc7, HELIOS_TEXTURE_SIZES)
+{
+    encodeBlocks(
+        state, [](const u8* pixels, u8* block) { encodeBC7(pixels, block); },
+        bc7_block_size);
+}
+
+// the whole cooker path: mip chain plus BC7 of every level, items are
+// texels of the top level
+HELIOS_BENCHMARK_SIZES(CookedTexture, bc7_mips, HELIOS_TEXTURE_SIZES)
+{
+    const u32 side = static_cast<u32>(state.size());
+    const std::vector<u8> pixels = makeTexture(side);
+
+    while (state.keepRunning())
+    {
+        const std::vector<u8> cooked =
+            CookedTexture::cook(pixels.data(), side, side, ETextureFormat::BC7,
+                                ETextureContent::SRGB, &textureJobs());
+        doNotOptimize(cooked.data());
+    }
+    state.setItemsPerIteration(static_cast<u64>(side) * side);
+}
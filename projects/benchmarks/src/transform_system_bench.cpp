@@ -0,0 +1,63 @@
+#include "benchmark.hpp"
+
+#include <helios/core/transform_system.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    JobSystem& transformJobs()
+    {
+        static JobSystem jobs(std::thread::hardware_concurrency() > 1
+                                  ? std::thread::hardware_concurrency() - 1
+                                  : 0);
+        return jobs;
+    }
+
+    // a tree with eight children per node, so 100k nodes sit six levels deep
+    std::vector<Entity> populateHierarchy(EntityManager& manager,
+                                          TransformSystem& transforms,
+                                          const size_t count)
+    {
+        std::vector<Entity> entities;
+        entities.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const f32 f = static_cast<f32>(i % 64);
+            Entity e = manager.create();
+            e.assign<TransformationComponent>(Vector3f(f, 0.0f, -f),
+                                              Vector3f(0.0f), Vector3f(1.0f));
+            if (i > 0)
+            {
+                transforms.setParent(e, entities[(i - 1) / 8]);
+            }
+            entities.push_back(e);
+        }
+        return entities;
+    }
+} // namespace
+
+// Reparenting one leaf forces the depth ordered node arrays to be rebuilt
+// from scratch, which should stay linear in the number of transformations.
+HELIOS_BENCHMARK_SIZES(TransformSystem, rebuild, 25000, 100000)
+{
+    EntityManager manager;
+    TransformSystem transforms(manager, transformJobs());
+    std::vector<Entity> entities = populateHierarchy(
+        manager, transforms, static_cast<size_t>(state.size()));
+    transforms.update();
+
+    Entity& leaf = entities.back();
+    u32 parent = 0;
+    while (state.keepRunning())
+    {
+        transforms.setParent(leaf, entities[parent]);
+        parent ^= 1;
+        transforms.update();
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<u64>(state.size()));
+}
@@ -0,0 +1,134 @@
+#include "benchmark.hpp"
+
+#include <helios/math/transform_batch.hpp>
+#include <helios/math/transformations.hpp>
+
+#include <vector>
+
+using namespace helios;
+using helios::bench::doNotOptimize;
+
+namespace
+{
+    struct TransformInput
+    {
+        Vector3f translation;
+        Vector3f rotation;
+        Vector3f scale;
+    };
+
+    std::vector<TransformInput> makeTransformInputs(const size_t count)
+    {
+        std::vector<TransformInput> values(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const f32 f = static_cast<f32>(i % 360);
+            values[i] = {Vector3f(f, -f, 2.0f * f),
+                         Vector3f(f, 0.5f * f, 90.0f - f),
+                         Vector3f(1.0f + f * 0.01f)};
+        }
+        return values;
+    }
+} // namespace
+
+#define HELIOS_TRANSFORM_SIZES 16, 1024, 16384
+
+HELIOS_BENCHMARK_SIZES(Transformations, transform, HELIOS_TRANSFORM_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const std::vector<TransformInput> inputs = makeTransformInputs(count);
+    std::vector<Matrix4f> out(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = transform(inputs[i].translation, inputs[i].rotation,
+                               inputs[i].scale);
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(Transformations, composeTransforms,
+                       HELIOS_TRANSFORM_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const std::vector<TransformInput> inputs = makeTransformInputs(count);
+
+    std::vector<f32> components[9];
+    for (const TransformInput& input : inputs)
+    {
+        for (u32 axis = 0; axis < 3; axis++)
+        {
+            components[axis].push_back(input.translation.data[axis]);
+            components[3 + axis].push_back(input.rotation.data[axis]);
+            components[6 + axis].push_back(input.scale.data[axis]);
+        }
+    }
+
+    TransformArrays arrays;
+    for (u32 axis = 0; axis < 3; axis++)
+    {
+        arrays.position[axis] = components[axis].data();
+        arrays.rotation[axis] = components[3 + axis].data();
+        arrays.scale[axis] = components[6 + axis].data();
+    }
+    std::vector<Matrix4f> out(count);
+
+    while (state.keepRunning())
+    {
+        composeTransforms(arrays, 0, count, out.data());
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(Transformations, rotateEuler, HELIOS_TRANSFORM_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const std::vector<TransformInput> inputs = makeTransformInputs(count);
+    std::vector<Matrix4f> out(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = rotate(inputs[i].rotation);
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK_SIZES(Transformations, rotateAxis, HELIOS_TRANSFORM_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const std::vector<TransformInput> inputs = makeTransformInputs(count);
+    const Vector3f axis(0.0f, 1.0f, 0.0f);
+    std::vector<Matrix4f> out(count);
+
+    while (state.keepRunning())
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = rotate(Matrix4f(1.0f), axis, inputs[i].rotation.x);
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+HELIOS_BENCHMARK(Transformations, perspective)
+{
+    f32 fov = 60.0f;
+    while (state.keepRunning())
+    {
+        doNotOptimize(fov);
+        const Matrix4f proj = perspective(fov, 16.0f / 9.0f, 0.1f, 1000.0f);
+        doNotOptimize(proj);
+    }
+}
+
+#undef HELIOS_TRANSFORM_SIZES
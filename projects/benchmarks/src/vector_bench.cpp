@@ -0,0 +1,144 @@
+#include "benchmark.hpp"
+
+#include <helios/math/vector.hpp>
+
+#include <vector>
+
+using namespace helios;
+using helios::bench::doNotOptimize;
+
+namespace
+{
+    template <typename V>
+    std::vector<V> makeVectors(const size_t count, const f32 seed)
+    {
+        std::vector<V> values(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            values[i] = V(seed + static_cast<f32>(i % 97) * 0.25f);
+        }
+        return values;
+    }
+
+    template <typename V, typename Op>
+    void binaryOp(bench::State& state, Op op)
+    {
+        const size_t count = static_cast<size_t>(state.size());
+        const std::vector<V> lhs = makeVectors<V>(count, 1.0f);
+        const std::vector<V> rhs = makeVectors<V>(count, 2.0f);
+        std::vector<V> out(count);
+
+        while (state.keepRunning())
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                out[i] = op(lhs[i], rhs[i]);
+            }
+            doNotOptimize(out.data());
+        }
+        state.setItemsPerIteration(count);
+    }
+
+    template <typename V, typename Op>
+    void reduceOp(bench::State& state, Op op)
+    {
+        const size_t count = static_cast<size_t>(state.size());
+        const std::vector<V> lhs = makeVectors<V>(count, 1.0f);
+        const std::vector<V> rhs = makeVectors<V>(count, 2.0f);
+
+        while (state.keepRunning())
+        {
+            f32 sum = 0.0f;
+            for (size_t i = 0; i < count; i++)
+            {
+                sum += op(lhs[i], rhs[i]);
+            }
+            doNotOptimize(sum);
+        }
+        state.setItemsPerIteration(count);
+    }
+} // namespace
+
+#define HELIOS_VECTOR_SIZES 16, 1024, 65536
+
+HELIOS_BENCHMARK_SIZES(Vector2f, add, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector2f>(state, [](const Vector2f& a, const Vector2f& b) { return a + b; });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector2f, dot, HELIOS_VECTOR_SIZES)
+{
+    reduceOp<Vector2f>(state, [](const Vector2f& a, const Vector2f& b) { return dot(a, b); });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector3f, add, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector3f>(state, [](const Vector3f& a, const Vector3f& b) { return a + b; });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector3f, mul, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector3f>(state, [](const Vector3f& a, const Vector3f& b) { return a * b; });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector3f, div, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector3f>(state, [](const Vector3f& a, const Vector3f& b) { return a / b; });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector3f, cross, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector3f>(state, [](const Vector3f& a, const Vector3f& b) { return cross(a, b); });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector3f, dot, HELIOS_VECTOR_SIZES)
+{
+    reduceOp<Vector3f>(state, [](const Vector3f& a, const Vector3f& b) { return dot(a, b); });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector3f, length, HELIOS_VECTOR_SIZES)
+{
+    reduceOp<Vector3f>(state, [](const Vector3f& a, const Vector3f&) { return a.length(); });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector4f, add, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector4f>(state, [](const Vector4f& a, const Vector4f& b) { return a + b; });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector4f, scale, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector4f>(state, [](const Vector4f& a, const Vector4f&) { return a * 0.5f; });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector4f, dot, HELIOS_VECTOR_SIZES)
+{
+    reduceOp<Vector4f>(state, [](const Vector4f& a, const Vector4f& b) { return dot(a, b); });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector3d, add, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector3d>(state, [](const Vector3d& a, const Vector3d& b) { return a + b; });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector4i, mul, HELIOS_VECTOR_SIZES)
+{
+    binaryOp<Vector4i>(state, [](const Vector4i& a, const Vector4i& b) { return a * b; });
+}
+
+HELIOS_BENCHMARK_SIZES(Vector3d, toCameraRelative, HELIOS_VECTOR_SIZES)
+{
+    const size_t count = static_cast<size_t>(state.size());
+    const std::vector<Vector3d> positions = makeVectors<Vector3d>(count, 1.0e6f);
+    const Vector3d origin(1.0e6, 1.0e6, 1.0e6);
+    std::vector<Vector3f> out(count);
+
+    while (state.keepRunning())
+    {
+        toCameraRelative(positions.data(), origin, out.data(), count);
+        doNotOptimize(out.data());
+    }
+    state.setItemsPerIteration(count);
+}
+
+#undef HELIOS_VECTOR_SIZES
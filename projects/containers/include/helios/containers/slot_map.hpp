@@ -181,12 +181,12 @@ namespace helios
           _values(nullptr), _erase(nullptr), _free_head(~0U)
     {
         _resize(other._capacity);
-        memcpy(_indices, other._indices, other._count * sizeof(slot_index));
+        memcpy(_indices, other._indices, other._capacity * sizeof(slot_index));
         memcpy(_erase, other._erase, other._count * sizeof(u32));
 
         for (u64 i = 0; i < _count; i++)
         {
-            _values[i] = other._values[i];
+            ::new (_values + i) Value(other._values[i]);
         }
 
         _alloc = other._alloc;
@@ -229,19 +229,33 @@ namespace helios
     slot_map<Value, Allocator>& slot_map<Value, Allocator>::operator=(
         const slot_map<Value, Allocator>& other)
     {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        // start from empty storage so the slot layout matches other exactly
         clear();
-        _count = other._count;
+        delete[] _indices;
+        delete[] _erase;
+        _alloc.release(_values);
+        _indices = nullptr;
+        _erase = nullptr;
+        _values = nullptr;
+        _capacity = 0;
+        _free_head = ~0U;
 
+        _alloc = other._alloc;
         _resize(other._capacity);
-        memcpy(_indices, other._indices, other._count * sizeof(slot_index));
+        memcpy(_indices, other._indices, other._capacity * sizeof(slot_index));
         memcpy(_erase, other._erase, other._count * sizeof(u32));
 
-        for (u64 i = 0; i < _count; i++)
+        for (u64 i = 0; i < other._count; i++)
         {
-            _values[i] = other._values[i];
+            ::new (_values + i) Value(other._values[i]);
         }
 
-        _alloc = other._alloc;
+        _count = other._count;
         _free_head = other._free_head;
 
         return *this;
@@ -287,17 +301,17 @@ namespace helios
     {
         if (_count > 0)
         {
-            // release all the values
+            // release all the values, invalidating the keys of their slots
             for (u64 i = 0; i < _count; i++)
             {
                 _values[i].~Value();
-                _indices[i].generation += 1;
+                _indices[_erase[i]].generation += 1;
             }
 
             // Reset the free slots
-            _indices[_count - 1].next = ~0U;
+            _indices[_capacity - 1].next = ~0U;
             _free_head = 0;
-            for (u32 i = 0; i < _count - 1; i++)
+            for (u32 i = 0; i < _capacity - 1; i++)
             {
                 _indices[i].next = i + 1;
             }
@@ -311,7 +325,7 @@ namespace helios
         const slot_key<Value, Allocator>& key)
     {
         u32 idx = key._index;
-        if (idx < _count)
+        if (idx < _capacity)
         {
             u32 generation = key._generation;
             return _indices[idx].generation == generation;
@@ -336,24 +350,29 @@ namespace helios
         const slot_key<Value, Allocator>& key)
     {
         u32 idx = key._index;
-        if (idx < _count)
+        if (idx < _capacity)
         {
             u32 generation = key._generation;
             if (_indices[idx].generation == generation)
             {
                 u32 valueIndex = _indices[idx].index;
+                const u32 last = static_cast<u32>(_count - 1);
                 // destruct value in place
                 _values[valueIndex].~Value();
 
-                // move the value at the end
-                ::new (_values + valueIndex)
-                    Value(helios::move(_values[_indices[_count - 1].index]));
+                if (valueIndex != last)
+                {
+                    // move the value at the end into the hole
+                    ::new (_values + valueIndex)
+                        Value(helios::move(_values[last]));
+                    _values[last].~Value();
 
-                // move the erase value
-                _erase[valueIndex] = _erase[_count - 1];
+                    // move the erase value
+                    _erase[valueIndex] = _erase[last];
 
-                // update the indices
-                _indices[_erase[valueIndex]].index = valueIndex;
+                    // update the indices
+                    _indices[_erase[valueIndex]].index = valueIndex;
+                }
                 _indices[idx].generation += 1;
 
                 // update the free list
@@ -428,7 +447,7 @@ namespace helios
 
         _count++;
 
-        return slot_key<Value, Allocator>(this, free, idx.generation);
+        return slot_key<Value, Allocator>(this, idx.generation, free);
     }
 
     template <typename Value, typename Allocator>
@@ -448,7 +467,7 @@ namespace helios
 
         _count++;
 
-        return slot_key<Value, Allocator>(this, free, idx.generation);
+        return slot_key<Value, Allocator>(this, idx.generation, free);
     }
 
     template <typename Value, typename Allocator>
@@ -470,7 +489,7 @@ namespace helios
 
             _count++;
 
-            return slot_key<Value, Allocator>(this, free, idx.generation);
+            return slot_key<Value, Allocator>(this, idx.generation, free);
     }
 
     template <typename Value, typename Allocator>
@@ -501,7 +520,7 @@ namespace helios
         const slot_key<Value, Allocator>& key) const noexcept
     {
         u32 index = key._index;
-        if (index < _count)
+        if (index < _capacity)
         {
             u32 generation = key._generation;
             auto idx = _indices[index];
@@ -525,7 +544,7 @@ namespace helios
 
         if (_indices)
         {
-            memcpy(indices, _indices, sizeof(slot_index) * _count);
+            memcpy(indices, _indices, sizeof(slot_index) * _capacity);
             delete[] _indices;
         }
         _indices = indices;
@@ -549,26 +568,23 @@ namespace helios
 
         // go to the end of the free chain
         u32 idx = _free_head;
-        while (idx != ~0U)
+        while (idx != ~0U && _indices[idx].next != ~0U)
         {
-            auto tmp = _indices[idx].next;
-            if (tmp != ~0U)
-            {
-                idx = tmp;
-                continue;
-            }
-            break;
-        }
-        if (idx == ~0U)
-        {
-            idx = 0;
-            _free_head = 0;
+            idx = _indices[idx].next;
         }
 
-        for (u64 i = _count; i < capacity; i++)
+        // append the new slots
+        for (u64 i = _capacity; i < capacity; i++)
         {
-            _indices[idx].next = i;
-            idx = i;
+            if (idx == ~0U)
+            {
+                _free_head = static_cast<u32>(i);
+            }
+            else
+            {
+                _indices[idx].next = static_cast<u32>(i);
+            }
+            idx = static_cast<u32>(i);
         }
         _indices[capacity - 1].next = ~0U;
 
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <helios/macros.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace helios
+{
+    // Non-owning view over a contiguous range, the subset of std::span the
+    // engine needs until it moves to C++20.
+    template <typename Type>
+    class span
+    {
+    public:
+        using element_type = Type;
+        using value_type = std::remove_cv_t<Type>;
+        using size_type = size_t;
+        using pointer = Type*;
+        using reference = Type&;
+        using iterator = Type*;
+
+        constexpr span() noexcept;
+        constexpr span(Type* data, const size_type size) noexcept;
+        constexpr span(Type* first, Type* last) noexcept;
+
+        // Any container with data() and size(), e.g. helios::vector or
+        // std::string, as long as its elements convert.
+        template <typename Container,
+                  typename = std::enable_if_t<std::is_convertible_v<
+                      std::remove_pointer_t<decltype(
+                          std::declval<Container&>().data())> (*)[],
+                      Type (*)[]>>>
+        constexpr span(Container& container) noexcept;
+
+        template <typename U, typename = std::enable_if_t<
+                                  std::is_convertible_v<U (*)[], Type (*)[]>>>
+        constexpr span(const span<U>& other) noexcept;
+
+        constexpr span(const span& other) noexcept = default;
+        constexpr span& operator=(const span& other) noexcept = default;
+        ~span() = default;
+
+        [[nodiscard]] constexpr pointer data() const noexcept;
+        [[nodiscard]] constexpr size_type size() const noexcept;
+        [[nodiscard]] constexpr size_type size_bytes() const noexcept;
+        [[nodiscard]] constexpr bool empty() const noexcept;
+
+        constexpr reference operator[](const size_type index) const noexcept;
+        [[nodiscard]] constexpr iterator begin() const noexcept;
+        [[nodiscard]] constexpr iterator end() const noexcept;
+
+        [[nodiscard]] constexpr span first(const size_type count) const noexcept;
+        [[nodiscard]] constexpr span subspan(
+            const size_type offset, const size_type count) const noexcept;
+
+    private:
+        Type* _data;
+        size_type _size;
+    };
+
+    template <typename Type>
+    inline constexpr span<Type>::span() noexcept : _data(nullptr), _size(0)
+    {
+    }
+
+    template <typename Type>
+    inline constexpr span<Type>::span(Type* data, const size_type size) noexcept
+        : _data(data), _size(size)
+    {
+    }
+
+    template <typename Type>
+    inline constexpr span<Type>::span(Type* first, Type* last) noexcept
+        : _data(first), _size(static_cast<size_type>(last - first))
+    {
+    }
+
+    template <typename Type>
+    template <typename Container, typename>
+    inline constexpr span<Type>::span(Container& container) noexcept
+        : _data(container.data()), _size(container.size())
+    {
+    }
+
+    template <typename Type>
+    template <typename U, typename>
+    inline constexpr span<Type>::span(const span<U>& other) noexcept
+        : _data(other.data()), _size(other.size())
+    {
+    }
+
+    template <typename Type>
+    inline constexpr typename span<Type>::pointer span<Type>::data()
+        const noexcept
+    {
+        return _data;
+    }
+
+    template <typename Type>
+    inline constexpr typename span<Type>::size_type span<Type>::size()
+        const noexcept
+    {
+        return _size;
+    }
+
+    template <typename Type>
+    inline constexpr typename span<Type>::size_type span<Type>::size_bytes()
+        const noexcept
+    {
+        return _size * sizeof(Type);
+    }
+
+    template <typename Type>
+    inline constexpr bool span<Type>::empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    template <typename Type>
+    inline constexpr typename span<Type>::reference span<Type>::operator[](
+        const size_type index) const noexcept
+    {
+        assert(index < _size);
+        return _data[index];
+    }
+
+    template <typename Type>
+    inline constexpr typename span<Type>::iterator span<Type>::begin()
+        const noexcept
+    {
+        return _data;
+    }
+
+    template <typename Type>
+    inline constexpr typename span<Type>::iterator span<Type>::end()
+        const noexcept
+    {
+        return _data + _size;
+    }
+
+    template <typename Type>
+    inline constexpr span<Type> span<Type>::first(
+        const size_type count) const noexcept
+    {
+        assert(count <= _size);
+        return span(_data, count);
+    }
+
+    template <typename Type>
+    inline constexpr span<Type> span<Type>::subspan(
+        const size_type offset, const size_type count) const noexcept
+    {
+        assert(offset <= _size && count <= _size - offset);
+        return span(_data + offset, count);
+    }
+} // namespace helios
@@ -309,7 +309,7 @@ namespace helios
                     _data[nextIdx].probe_count++;
                     if (_data[nextIdx].probe_count > _data[idx].probe_count)
                     {
-                        swap(_data[nextIdx], _data[idx]);
+                        _data[nextIdx].swap(_data[idx]);
                         return forward_iterator(_data, idx, _capacity);
                     }
                     else
@@ -350,7 +350,7 @@ namespace helios
                     _data[nextIdx].probe_count++;
                     if (_data[nextIdx].probe_count > _data[idx].probe_count)
                     {
-                        swap(_data[nextIdx], _data[idx]);
+                        _data[nextIdx].swap(_data[idx]);
                         return const_forward_iterator(_data, idx, _capacity);
                     }
                     else
@@ -17,6 +17,10 @@
 
 #define HELIOS_NO_DISCARD [[nodiscard]]
 
+// std::is_constant_evaluated is C++20, the builtin is available in C++17 mode
+// on clang, clang-cl and gcc.
+#define HELIOS_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+
 #define GEN_HANDLE_DEFN(name, type) using name = type*;
 #define PREGEN_HANDLE_DEFN(name, type)                                         \
     class type;                                                                \
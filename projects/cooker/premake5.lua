@@ -0,0 +1,86 @@
+project "cooker"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+
+    targetdir (binaries)
+    objdir (intermediate)
+    debugdir("%{sln.location}")
+
+    dependson {
+        "containers",
+        "core",
+        "math",
+    }
+
+    links {
+        "core",
+        "containers",
+        "math",
+    }
+
+    files {
+        "src/**.hpp",
+        "src/**.cpp"
+    }
+
+    includedirs {
+        "%{IncludeDir.containers}",
+        "%{IncludeDir.core}",
+        "%{IncludeDir.math}",
+        "src",
+    }
+
+    vectorextensions "AVX2"
+
+    filter "system:windows"
+        toolset "msc-ClangCL"
+        systemversion "latest"
+        staticruntime "Off"
+
+        ignoredefaultlibraries {
+            "LIBCMT",
+            "LIBCMTD"
+        }
+
+        defines {
+            "HELIOS_PLATFORM_WINDOWS",
+            "_CRT_SECURE_NO_WARNINGS",
+        }
+
+    filter "system:linux"
+        toolset "clang"
+        staticruntime "Off"
+
+        defines {
+            "HELIOS_PLATFORM_LINUX"
+        }
+
+        buildoptions {
+            "-Wall",
+            "-Wextra",
+            "-fms-extensions"
+        }
+
+        links {
+            "pthread"
+        }
+
+    filter "configurations:Debug"
+        defines {
+            "HELIOS_DEBUG",
+            "HELIOS_ENABLE_ASSERTS"
+        }
+
+        runtime "Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        defines {
+            "HELIOS_RELEASE",
+            "NDEBUG"
+        }
+
+        optimize "Full"
+        runtime "Release"
+        symbols "Off"
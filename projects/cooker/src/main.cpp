@@ -0,0 +1,218 @@
+#include <helios/core/cooked_mesh.hpp>
+#include <helios/core/cooked_texture.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/core/mesh.hpp>
+#include <helios/core/mesh_optimizer.hpp>
+#include <helios/io/file.hpp>
+#include <helios/io/image_decoder.hpp>
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void printUsage()
+{
+    std::cout << "Usage: cooker <command> [options]" << std::endl
+              << std::endl;
+    std::cout << "  mesh <input.gltf|input.glb> <output> [--packed] "
+                 "[--no-optimize]"
+              << std::endl;
+    std::cout << "      Cooks every mesh of a glTF into one cooked mesh. "
+                 "--packed stores the quantised vertex format, "
+                 "--no-optimize keeps the glTF vertex and triangle order."
+              << std::endl;
+    std::cout << "  texture <input.png> <output> "
+                 "[--format rgba8|bc1|bc3|bc5|bc7] [--linear|--normal] "
+                 "[--flip]"
+              << std::endl;
+    std::cout << "      Cooks an image and its mip chain into one cooked "
+                 "texture, BC7 unless --format says otherwise. Colour is "
+                 "filtered as sRGB unless --linear, --normal renormalises "
+                 "the filtered normals, --flip stores the rows bottom up."
+              << std::endl;
+}
+
+static helios::JobSystem& jobs()
+{
+    static helios::JobSystem system(std::thread::hardware_concurrency() > 1
+                                        ? std::thread::hardware_concurrency() - 1
+                                        : 0);
+    return system;
+}
+
+static int cookMesh(const std::vector<std::string>& args)
+{
+    using namespace helios;
+
+    if (args.size() < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    EVertexFormat format = EVertexFormat::FULL;
+    bool optimize = true;
+    for (size_t i = 2; i < args.size(); i++)
+    {
+        if (args[i] == "--packed")
+        {
+            format = EVertexFormat::PACKED;
+        }
+        else if (args[i] == "--no-optimize")
+        {
+            optimize = false;
+        }
+        else
+        {
+            std::cerr << "Unknown option " << args[i] << std::endl;
+            return 1;
+        }
+    }
+
+    Mesh mesh(args[0], format, &jobs());
+    if (optimize)
+    {
+        optimizeMesh(mesh, &jobs());
+    }
+
+    const std::vector<u8> cooked = CookedMesh::cook(mesh);
+    if (!File::write_binary(args[1], cooked.data(), cooked.size()))
+    {
+        std::cerr << "Failed to write " << args[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << args[0] << " -> " << args[1] << " (" << mesh.subMeshes.size()
+              << " sub meshes, " << cooked.size() << " bytes)" << std::endl;
+    return 0;
+}
+
+static int cookTexture(const std::vector<std::string>& args)
+{
+    using namespace helios;
+
+    if (args.size() < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    ETextureFormat format = ETextureFormat::BC7;
+    ETextureContent content = ETextureContent::SRGB;
+    bool flip = false;
+    for (size_t i = 2; i < args.size(); i++)
+    {
+        if (args[i] == "--format" && i + 1 < args.size())
+        {
+            const std::string& name = args[++i];
+            if (name == "rgba8")
+            {
+                format = ETextureFormat::RGBA8;
+            }
+            else if (name == "bc1")
+            {
+                format = ETextureFormat::BC1;
+            }
+            else if (name == "bc3")
+            {
+                format = ETextureFormat::BC3;
+            }
+            else if (name == "bc5")
+            {
+                format = ETextureFormat::BC5;
+            }
+            else if (name == "bc7")
+            {
+                format = ETextureFormat::BC7;
+            }
+            else
+            {
+                std::cerr << "Unknown format " << name << std::endl;
+                return 1;
+            }
+        }
+        else if (args[i] == "--linear")
+        {
+            content = ETextureContent::LINEAR;
+        }
+        else if (args[i] == "--normal")
+        {
+            content = ETextureContent::NORMAL;
+        }
+        else if (args[i] == "--flip")
+        {
+            flip = true;
+        }
+        else
+        {
+            std::cerr << "Unknown option " << args[i] << std::endl;
+            return 1;
+        }
+    }
+
+    const MappedFile input(args[0], EFileAccess::WILL_NEED);
+    ImageInfo info;
+    if (!input.valid() || !readImageInfo(input.bytes(), info))
+    {
+        std::cerr << "Failed to load " << args[0] << std::endl;
+        return 1;
+    }
+
+    std::vector<u8> pixels(static_cast<size_t>(info.width) * info.height * 4);
+    if (!decodeImage(input.bytes(), pixels.data(), flip))
+    {
+        std::cerr << "Failed to decode " << args[0] << std::endl;
+        return 1;
+    }
+
+    const std::vector<u8> cooked =
+        CookedTexture::cook(pixels.data(), info.width, info.height, format,
+                            content, &jobs());
+
+    if (!File::write_binary(args[1], cooked.data(), cooked.size()))
+    {
+        std::cerr << "Failed to write " << args[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << args[0] << " -> " << args[1] << " (" << info.width << "x"
+              << info.height << ", "
+              << textureMipCount(info.width, info.height) << " mips, "
+              << cooked.size() << " bytes)" << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    const std::string command = argv[1];
+    const std::vector<std::string> args(argv + 2, argv + argc);
+
+    try
+    {
+        if (command == "mesh")
+        {
+            return cookMesh(args);
+        }
+        if (command == "texture")
+        {
+            return cookTexture(args);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <helios/core/job_system.hpp>
+#include <helios/macros.hpp>
+#include <helios/math/bounds.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace helios
+{
+    // Bounding volume hierarchy over fattened boxes. Leaves are inserted by
+    // surface area cost and kept balanced with rotations, and a move that
+    // stays inside its fat box does not touch the tree. Large batches of
+    // moves go through setBounds and refit instead, rebuild re-creates the
+    // internal nodes top down once refits have let the tree degrade.
+    //
+    // Proxies are leaf node indices and stay valid until removed, including
+    // across rebuilds.
+    class DynamicAABBTree
+    {
+    public:
+        static constexpr u32 null_node = ~0U;
+
+        explicit DynamicAABBTree(const f32 margin = 0.1f);
+        ~DynamicAABBTree() = default;
+        HELIOS_NO_COPY_MOVE(DynamicAABBTree)
+
+        u32 insert(const AABB& box, const u32 userData);
+        void remove(const u32 proxy);
+
+        // Returns true if the box left the fat box and the leaf was
+        // reinserted.
+        bool move(const u32 proxy, const AABB& box);
+
+        // Grows the fat box of a leaf without fixing its ancestors. Safe to
+        // call from several threads for distinct proxies, call refit before
+        // the next query. Returns true if the fat box changed.
+        bool setBounds(const u32 proxy, const AABB& box) noexcept;
+
+        // Recomputes every internal box bottom up. Subtrees are split across
+        // the job system when one is given.
+        void refit(JobSystem* jobs = nullptr);
+
+        // Rebuilds the internal nodes by splitting the leaves at the median
+        // of their longest axis.
+        void rebuild(JobSystem* jobs = nullptr);
+
+        // Sum of internal node surface areas relative to the root. Lower is
+        // better, queries visit roughly this many nodes per unit of volume.
+        [[nodiscard]] f32 cost() const noexcept;
+
+        [[nodiscard]] size_t size() const noexcept;
+        [[nodiscard]] u32 height() const noexcept;
+        [[nodiscard]] const AABB& fatBounds(const u32 proxy) const noexcept;
+        [[nodiscard]] u32 userData(const u32 proxy) const noexcept;
+
+        // Calls fn(proxy) for every leaf whose fat box overlaps.
+        template <typename Func>
+        void query(const AABB& box, Func&& fn) const;
+
+        template <typename Func>
+        void query(const BoundingSphere& sphere, Func&& fn) const;
+
+        template <typename Func>
+        void query(const Frustum& frustum, Func&& fn) const;
+
+        // Calls fn(proxy, distance) for leaves whose fat box the ray
+        // enters within maxDistance, distance being the entry distance. fn
+        // returns the new maxDistance, so returning the distance of an exact
+        // hit turns this into a closest hit search and returning 0 stops it.
+        template <typename Func>
+        void raycast(const Ray& ray, const f32 maxDistance, Func&& fn) const;
+
+    private:
+        struct Node
+        {
+            AABB box;
+            // next free node while on the free list
+            u32 parent;
+            u32 left;
+            u32 right;
+            u32 userData;
+            // 0 for leaves, -1 for free nodes
+            i32 height;
+
+            [[nodiscard]] bool leaf() const noexcept
+            {
+                return left == null_node;
+            }
+        };
+
+        // deep enough for any tree the balancing or the median split
+        // produces, heights stay logarithmic in the leaf count
+        static constexpr u32 max_stack = 256;
+
+        std::vector<Node> _nodes;
+        u32 _root;
+        u32 _free;
+        size_t _leafCount;
+        f32 _margin;
+        std::atomic<bool> _refitPending;
+
+        u32 _allocate();
+        void _release(const u32 node);
+        void _insertLeaf(const u32 leaf);
+        void _removeLeaf(const u32 leaf);
+        u32 _balance(const u32 node);
+        void _fixUpwards(u32 node);
+        void _refitSubtree(const u32 node);
+        u32 _build(u32* leaves, const u32 count, const u32 offset,
+                   const u32* internal, JobSystem* jobs);
+
+        template <typename Overlaps, typename Func>
+        void _traverse(Overlaps&& overlaps, Func& fn) const;
+    };
+
+    template <typename Func>
+    inline void DynamicAABBTree::query(const AABB& box, Func&& fn) const
+    {
+        _traverse([&box](const AABB& node) { return node.intersects(box); },
+                  fn);
+    }
+
+    template <typename Func>
+    inline void DynamicAABBTree::query(const BoundingSphere& sphere,
+                                       Func&& fn) const
+    {
+        _traverse(
+            [&sphere](const AABB& node) { return node.intersects(sphere); },
+            fn);
+    }
+
+    template <typename Func>
+    inline void DynamicAABBTree::query(const Frustum& frustum, Func&& fn) const
+    {
+        _traverse(
+            [&frustum](const AABB& node) { return frustum.intersects(node); },
+            fn);
+    }
+
+    template <typename Func>
+    inline void DynamicAABBTree::raycast(const Ray& ray, const f32 maxDistance,
+                                         Func&& fn) const
+    {
+        if (_root == null_node)
+        {
+            return;
+        }
+
+        f32 limit = maxDistance;
+        u32 stack[max_stack];
+        u32 top = 0;
+        stack[top++] = _root;
+        while (top > 0)
+        {
+            const u32 index = stack[--top];
+            const Node& node = _nodes[index];
+            f32 distance;
+            if (!ray.intersects(node.box, distance) || distance > limit)
+            {
+                continue;
+            }
+
+            if (node.leaf())
+            {
+                limit = fn(index, distance);
+                if (limit <= 0.0f)
+                {
+                    return;
+                }
+            }
+            else
+            {
+                stack[top++] = node.left;
+                stack[top++] = node.right;
+            }
+        }
+    }
+
+    template <typename Overlaps, typename Func>
+    inline void DynamicAABBTree::_traverse(Overlaps&& overlaps, Func& fn) const
+    {
+        if (_root == null_node)
+        {
+            return;
+        }
+
+        u32 stack[max_stack];
+        u32 top = 0;
+        stack[top++] = _root;
+        while (top > 0)
+        {
+            const u32 index = stack[--top];
+            const Node& node = _nodes[index];
+            if (!overlaps(node.box))
+            {
+                continue;
+            }
+
+            if (node.leaf())
+            {
+                fn(index);
+            }
+            else
+            {
+                stack[top++] = node.left;
+                stack[top++] = node.right;
+            }
+        }
+    }
+} // namespace helios
@@ -1,16 +1,56 @@
 #pragma once
 
+#include <helios/core/frame_loop.hpp>
+
 #include <string>
 
 namespace helios
 {
+    class IWindow;
+    class SystemScheduler;
+
     class Application
     {
     public:
         Application();
         virtual ~Application();
         virtual void initialize() = 0;
+
+        // Runs the engine frame loop until the window is closed or stop is
+        // called, polling the window for input and calling the phases
+        // below.
+        void run(const FrameLoop::Settings& settings = {});
+        void stop() noexcept;
+
+    protected:
+        // Runs against the given jobs and systems instead of the engine
+        // context, without a window. run only returns once stop is called.
+        Application(JobSystem& jobs, SystemScheduler& systems);
+
+        // Runs first every frame, returning false ends the loop. Polls the
+        // window and checks whether it was closed unless overridden.
+        virtual bool input();
+
+        // Advances the simulation by one fixed step. Runs the systems
+        // registered with the engine scheduler unless overridden.
+        virtual void simulate(f64 step);
+
+        // Copies what render needs out of the simulation, see FrameLoop.
+        virtual void extract(f64 alpha);
+
+        // Records and submits a frame from the extracted state.
+        virtual void render(f64 alpha);
+
+        // Phase timings of the last frame run completed.
+        [[nodiscard]] const FrameLoop::Timings& frameTimings() const noexcept;
+
+    private:
+        JobSystem* _jobs;
+        SystemScheduler* _systems;
+        IWindow* _window;
+        FrameLoop* _loop;
+        FrameLoop::Timings _timings;
     };
 
     Application* CreateApplication();
-} // namespace helios
\ No newline at end of file
+} // namespace helios
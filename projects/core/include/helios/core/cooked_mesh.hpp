@@ -0,0 +1,71 @@
+#pragma once
+
+#include <helios/containers/span.hpp>
+#include <helios/core/mesh.hpp>
+#include <helios/io/file.hpp>
+#include <helios/macros.hpp>
+#include <helios/math/bounds.hpp>
+
+#include <string>
+#include <vector>
+
+namespace helios
+{
+    // Mesh data laid out the way the renderer consumes it: a header, one
+    // table entry per sub mesh and the already built vertex streams and
+    // u32 index buffers, every blob starting on a 64 byte boundary. Loading
+    // validates the tables and hands out spans into the file, so a cooked
+    // mesh goes from disk to staging memory with a single copy.
+    class CookedMesh
+    {
+    public:
+        static constexpr u32 format_version = 1;
+
+        struct SubMesh
+        {
+            u32 vertexCount;
+            u32 indexCount;
+            // buffer 0 and 1 of the built Mesh, see Mesh::readBuffer
+            span<const u8> positions;
+            span<const u8> attributes;
+            span<const u8> indices;
+            AABB bounds;
+            BoundingSphere boundingSphere;
+        };
+
+        CookedMesh() = default;
+
+        // Maps and validates a cooked mesh file.
+        explicit CookedMesh(const std::string& path);
+
+        // Validates a cooked mesh already in memory. The bytes must outlive
+        // the CookedMesh.
+        explicit CookedMesh(const span<const u8> bytes);
+
+        ~CookedMesh() = default;
+        CookedMesh(CookedMesh&& other) noexcept = default;
+        CookedMesh& operator=(CookedMesh&& other) noexcept = default;
+        HELIOS_NO_COPY(CookedMesh)
+
+        [[nodiscard]] bool valid() const noexcept;
+        [[nodiscard]] EVertexFormat vertexFormat() const noexcept;
+        [[nodiscard]] const AABB& bounds() const noexcept;
+        [[nodiscard]] const BoundingSphere& boundingSphere() const noexcept;
+        [[nodiscard]] u32 subMeshCount() const noexcept;
+        [[nodiscard]] const SubMesh& subMesh(const u32 index) const noexcept;
+
+        // Serialises the built sub meshes of mesh, or mesh itself when it
+        // has buffers of its own.
+        [[nodiscard]] static std::vector<u8> cook(const Mesh& mesh);
+
+    private:
+        MappedFile _file;
+        std::vector<SubMesh> _subMeshes;
+        AABB _bounds;
+        BoundingSphere _boundingSphere;
+        EVertexFormat _format = EVertexFormat::FULL;
+        bool _valid = false;
+
+        void _parse(const span<const u8> bytes);
+    };
+} // namespace helios
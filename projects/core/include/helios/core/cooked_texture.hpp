@@ -0,0 +1,116 @@
+#pragma once
+
+#include <helios/containers/span.hpp>
+#include <helios/io/file.hpp>
+#include <helios/macros.hpp>
+
+#include <string>
+#include <vector>
+
+namespace helios
+{
+    class JobSystem;
+
+    enum class ETextureFormat : u32
+    {
+        RGBA8,
+        BC1,
+        BC3,
+        BC5,
+        BC7
+    };
+
+    // Colour textures are filtered in linear space and stored as sRGB, normal
+    // maps are averaged as unit vectors and renormalised. Linear textures are
+    // filtered as stored.
+    enum class ETextureContent : u32
+    {
+        SRGB,
+        LINEAR,
+        NORMAL
+    };
+
+    // Number of levels down to 1x1.
+    u32 textureMipCount(const u32 width, const u32 height) noexcept;
+
+    // Size of one level stored in format. BCn levels are rounded up to whole
+    // 4x4 blocks.
+    u64 textureLevelSize(const ETextureFormat format, const u32 width,
+                         const u32 height) noexcept;
+
+    // Every level of the mip chain of an RGBA8 image, the image itself first,
+    // each level half the size of the previous one from a box filter that
+    // takes three texels along odd sized axes. sRGB colour is weighted by
+    // alpha.
+    std::vector<std::vector<u8>> buildTextureMips(const u8* pixels,
+                                                  const u32 width,
+                                                  const u32 height,
+                                                  const ETextureContent content);
+
+    // Encodes an RGBA8 image into format, splitting block rows over jobs when
+    // given. Blocks past the edge of the image repeat its last row and column.
+    std::vector<u8> compressTexture(const u8* pixels, const u32 width,
+                                    const u32 height,
+                                    const ETextureFormat format,
+                                    JobSystem* jobs = nullptr);
+
+    // A texture laid out the way the renderer consumes it: a header, a table
+    // with one entry per mip level and the encoded levels back to back in one
+    // payload, every level starting on a 16 byte boundary. The payload is
+    // uploaded with a single staging copy, one copy region per level.
+    class CookedTexture
+    {
+    public:
+        static constexpr u32 format_version = 1;
+
+        struct Level
+        {
+            u32 width;
+            u32 height;
+            // offset of the level from the start of payload()
+            u64 offset;
+            span<const u8> bytes;
+        };
+
+        CookedTexture() = default;
+
+        // Maps and validates a cooked texture file.
+        explicit CookedTexture(const std::string& path);
+
+        // Validates a cooked texture already in memory. The bytes must
+        // outlive the CookedTexture.
+        explicit CookedTexture(const span<const u8> bytes);
+
+        ~CookedTexture() = default;
+        CookedTexture(CookedTexture&& other) noexcept = default;
+        CookedTexture& operator=(CookedTexture&& other) noexcept = default;
+        HELIOS_NO_COPY(CookedTexture)
+
+        [[nodiscard]] bool valid() const noexcept;
+        [[nodiscard]] ETextureFormat format() const noexcept;
+        [[nodiscard]] ETextureContent content() const noexcept;
+        [[nodiscard]] u32 width() const noexcept;
+        [[nodiscard]] u32 height() const noexcept;
+        [[nodiscard]] u32 levelCount() const noexcept;
+        [[nodiscard]] const Level& level(const u32 index) const noexcept;
+        [[nodiscard]] span<const u8> payload() const noexcept;
+
+        // Builds the mip chain of an RGBA8 image and encodes every level.
+        [[nodiscard]] static std::vector<u8> cook(
+            const u8* pixels, const u32 width, const u32 height,
+            const ETextureFormat format, const ETextureContent content,
+            JobSystem* jobs = nullptr);
+
+    private:
+        MappedFile _file;
+        std::vector<Level> _levels;
+        span<const u8> _payload;
+        ETextureFormat _format = ETextureFormat::RGBA8;
+        ETextureContent _content = ETextureContent::SRGB;
+        u32 _width = 0;
+        u32 _height = 0;
+        bool _valid = false;
+
+        void _parse(const span<const u8> bytes);
+    };
+} // namespace helios
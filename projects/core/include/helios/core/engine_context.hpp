@@ -1,8 +1,13 @@
 #pragma once
 
 #include <helios/containers/vector.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/core/spatial_index.hpp>
+#include <helios/core/transform_system.hpp>
 #include <helios/core/window.hpp>
 #include <helios/ecs/entity.hpp>
+#include <helios/ecs/system_scheduler.hpp>
+#include <helios/io/async_file.hpp>
 #include <helios/macros.hpp>
 #include <helios/render/graphics.hpp>
 #include <helios/render/resource_manager.hpp>
@@ -86,11 +91,21 @@ namespace helios
         virtual IWindow& window();
         virtual RenderContext& render();
         virtual EntityManager& entities();
+        virtual JobSystem& jobs();
+        virtual TransformSystem& transforms();
+        virtual SpatialIndex& spatial();
+        virtual SystemScheduler& systems();
+        virtual AsyncFileReader& files();
 
     private:
         IWindow* _win;
         RenderContext* _render;
         EntityManager* _entities;
+        JobSystem* _jobs;
+        TransformSystem* _transforms;
+        SpatialIndex* _spatial;
+        SystemScheduler* _systems;
+        AsyncFileReader* _files;
 
         void _initialize();
         void _close();
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <helios/core/job_system.hpp>
+#include <helios/macros.hpp>
+
+#include <atomic>
+#include <functional>
+
+namespace helios
+{
+    // Drives a frame as input, a fixed number of simulation steps, extract
+    // and render. Simulation always advances by the fixed step, render gets
+    // the fraction of a step the accumulated time is ahead of the last step
+    // so it can interpolate between the last two simulated states.
+    //
+    // Extract is the only phase that may touch both simulation and render
+    // state. When pipelined the steps of frame N+1 run on the job system
+    // while the calling thread renders what was extracted at the end of
+    // frame N, so render must only read extracted state.
+    class FrameLoop
+    {
+    public:
+        struct Settings
+        {
+            f64 fixedStep = 1.0 / 60.0;
+            // steps beyond this are dropped instead of letting a slow frame
+            // make the next one slower
+            u32 maxStepsPerFrame = 8;
+            bool pipelined = false;
+        };
+
+        // Phase times of the last frame in milliseconds. simulate is spent
+        // on a worker when pipelined, wait is the part of it render did not
+        // hide.
+        struct Timings
+        {
+            f64 input = 0.0;
+            f64 simulate = 0.0;
+            f64 wait = 0.0;
+            f64 extract = 0.0;
+            f64 render = 0.0;
+            f64 frame = 0.0;
+            u32 steps = 0;
+        };
+
+        FrameLoop(JobSystem& jobs, const Settings& settings);
+        ~FrameLoop() = default;
+        HELIOS_NO_COPY_MOVE(FrameLoop)
+
+        // Runs first every frame on the calling thread, returning false ends
+        // the loop after the current frame.
+        void onInput(std::function<bool()> fn);
+        void onSimulate(std::function<void(f64 step)> fn);
+        void onExtract(std::function<void(f64 alpha)> fn);
+        void onRender(std::function<void(f64 alpha)> fn);
+
+        // Runs frames until input returns false or stop is called.
+        void run();
+
+        // Runs one frame as if elapsed seconds had passed since the last
+        // one. Returns false once the loop was asked to stop.
+        bool advance(const f64 elapsed);
+
+        void stop() noexcept;
+
+        [[nodiscard]] const Settings& settings() const noexcept;
+        [[nodiscard]] const Timings& timings() const noexcept;
+        [[nodiscard]] u64 frameCount() const noexcept;
+        [[nodiscard]] u64 stepCount() const noexcept;
+
+        // Simulated time, always a multiple of the fixed step.
+        [[nodiscard]] f64 simulationTime() const noexcept;
+
+    private:
+        JobSystem& _jobs;
+        Settings _settings;
+        // written during the frame, published to _timings at its end
+        Timings _current;
+        Timings _timings;
+
+        std::function<bool()> _input;
+        std::function<void(f64)> _simulate;
+        std::function<void(f64)> _extract;
+        std::function<void(f64)> _render;
+
+        f64 _accumulator;
+        f64 _alpha;
+        // alpha of the state render sees, one frame behind when pipelined
+        f64 _renderAlpha;
+        u64 _frames;
+        u64 _steps;
+        std::atomic<bool> _running;
+
+        u32 _takeSteps(const f64 elapsed);
+        void _step(const u32 steps);
+    };
+} // namespace helios
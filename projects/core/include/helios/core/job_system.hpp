@@ -0,0 +1,81 @@
+#pragma once
+
+#include <helios/macros.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace helios
+{
+    class JobSystem
+    {
+    public:
+        explicit JobSystem(const u32 workerCount);
+        ~JobSystem();
+        HELIOS_NO_COPY_MOVE(JobSystem)
+
+        [[nodiscard]] u32 workerCount() const noexcept;
+
+        // Queues a job to run on one of the workers.
+        void submit(std::function<void()> job);
+
+        // Splits [0, count) into ranges of at most grain indices and calls
+        // fn(begin, end) for each range on the workers and the calling
+        // thread. Returns once every range has run. Safe to call from inside
+        // a job, the waiting thread runs queued jobs instead of blocking.
+        template <typename Func>
+        void parallelFor(const size_t count, const size_t grain, Func&& fn);
+
+        // Blocks until every submitted job has run, helping with the queue in
+        // the meantime.
+        void wait();
+
+        // Blocks until counter drops to zero, helping with the queue in the
+        // meantime. Lets a caller wait on its own jobs only.
+        void wait(const std::atomic<size_t>& counter);
+
+        // Identifies the job running on the calling thread, 0 outside of any
+        // job. Every job gets a fresh id, including one a waiting thread
+        // picks up while helping, so per thread state can tell the code that
+        // waits apart from the jobs it runs meanwhile.
+        [[nodiscard]] static u64 currentJob() noexcept;
+
+    private:
+        std::vector<std::thread> _workers;
+        std::deque<std::function<void()>> _queue;
+        std::mutex _mutex;
+        std::condition_variable _available;
+        std::atomic<size_t> _pending;
+        bool _stopping;
+
+        void _work();
+        bool _runOne();
+        static void _run(const std::function<void()>& job);
+        void _parallelFor(
+            const size_t count, const size_t grain,
+            const std::function<void(size_t, size_t)>& fn);
+    };
+
+    template <typename Func>
+    inline void JobSystem::parallelFor(const size_t count, const size_t grain,
+                                       Func&& fn)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (_workers.empty() || count <= grain)
+        {
+            fn(size_t(0), count);
+            return;
+        }
+
+        _parallelFor(count, grain, fn);
+    }
+} // namespace helios
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <helios/containers/span.hpp>
 #include <helios/containers/vector.hpp>
 #include <helios/macros.hpp>
+#include <helios/math/bounds.hpp>
+#include <helios/math/packed.hpp>
 #include <helios/math/vector.hpp>
 #include <string>
 
@@ -26,11 +29,75 @@ namespace helios
         Vector4fView color;
     };
 
+    // Quantised counterpart of VertexNoPosition, 16 bytes per vertex.
+    // uv      - R16G16_SFLOAT
+    // normal  - R16G16_SNORM, octahedral encoded
+    // tangent - A2B10G10R10_SNORM_PACK32, w holds the bitangent sign
+    // color   - R8G8B8A8_UNORM
+    // The bitangent is reconstructed as cross(normal, tangent.xyz) * tangent.w
+    struct PackedVertexNoPosition
+    {
+        Half2 uv;
+        Snorm16x2 normal;
+        Snorm1010102 tangent;
+        Unorm8x4 color;
+    };
+
+    enum class EVertexFormat
+    {
+        FULL,
+        PACKED
+    };
+
+    class JobSystem;
+
+    // A simplified index list over the vertices of its mesh
+    struct MeshLod
+    {
+        vector<u32> triangles;
+
+        // Largest distance the surface moved from the full mesh, in local
+        // space units
+        f32 error = 0.0f;
+    };
+
+    // A cluster of nearby triangles culled as a whole, see buildMeshlets
+    struct Meshlet
+    {
+        // First of its entries in Mesh::meshletVertices
+        u32 vertexOffset = 0;
+
+        // First of its entries in Mesh::meshletTriangles, three per triangle
+        u32 triangleOffset = 0;
+
+        u32 vertexCount = 0;
+        u32 triangleCount = 0;
+
+        BoundingSphere bounds;
+
+        // Every triangle normal lies within the cone around coneAxis whose
+        // half angle has the sine coneCutoff. 1 when the cone is too wide
+        // to ever cull.
+        Vector3f coneAxis;
+        f32 coneCutoff = 1.0f;
+    };
+
     class Mesh
     {
     public:
         Mesh();
-        Mesh(const std::string& filePath);
+
+        // Every glTF primitive becomes a sub mesh. With a job system the
+        // primitives are decoded and built in parallel.
+        Mesh(const std::string& filePath,
+             const EVertexFormat format = EVertexFormat::FULL,
+             JobSystem* jobs = nullptr);
+
+        // Parses a .gltf or .glb already in memory, e.g. a MappedFile.
+        // External buffers of a .gltf are resolved against rootPath.
+        Mesh(const span<const u8> bytes, const std::string& rootPath,
+             const EVertexFormat format = EVertexFormat::FULL,
+             JobSystem* jobs = nullptr);
         ~Mesh();
         HELIOS_NO_COPY_MOVE(Mesh);
 
@@ -43,14 +110,38 @@ namespace helios
 
         vector<u32> triangles;
 
+        // Coarser levels of triangles, see generateLods. Level 0 is the
+        // full mesh, level i is lods[i - 1].
+        vector<MeshLod> lods;
+
+        // Clusters of triangles, see buildMeshlets. Each meshlet triangle is
+        // three indices into the meshlet's range of meshletVertices, which
+        // holds mesh vertex indices.
+        vector<Meshlet> meshlets;
+        vector<u32> meshletVertices;
+        vector<u8> meshletTriangles;
+
         vector<Mesh*> subMeshes;
 
-        void build();
+        // Local space bounds, enclosing all sub meshes
+        AABB bounds;
+        BoundingSphere boundingSphere;
+
+        void build(const EVertexFormat format = EVertexFormat::FULL);
         void calculateBitangents();
+        void calculateBounds();
+
+        // Picks the coarsest level whose error stays under maxPixelError
+        // when the bounding sphere covers screenRadius pixels.
+        HELIOS_NO_DISCARD u32 selectLod(const f32 screenRadius,
+                                        const f32 maxPixelError = 1.0f) const;
+        HELIOS_NO_DISCARD u32 lodCount() const;
+        HELIOS_NO_DISCARD const vector<u32>& lodTriangles(const u32 level) const;
 
         void* readBuffer(const u32 id) const;
         u32 bufferCount() const;
         u64 bufferSize(const u32 id) const;
+        EVertexFormat vertexFormat() const;
 
     private:
         struct InternalBuffer
@@ -59,5 +150,9 @@ namespace helios
             u64 size;
         };
         vector<InternalBuffer> _buffers;
+        EVertexFormat _format = EVertexFormat::FULL;
+
+        void _buildPacked();
+        void _releaseBuffers();
     };
 } // namespace helios
\ No newline at end of file
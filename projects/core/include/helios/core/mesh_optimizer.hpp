@@ -0,0 +1,64 @@
+#pragma once
+
+#include <helios/containers/span.hpp>
+#include <helios/core/mesh.hpp>
+#include <helios/macros.hpp>
+#include <helios/math/vector.hpp>
+
+namespace helios
+{
+    class JobSystem;
+
+    // Post-transform cache size the reordering stages target. Small enough
+    // to hold on any GPU that still has a FIFO cache, and ACMR measured
+    // with it tracks the batch based reuse of newer ones well.
+    constexpr u32 default_vertex_cache_size = 16;
+
+    // How much worse than the cache optimised order the overdraw stage may
+    // make the ACMR.
+    constexpr f32 default_overdraw_threshold = 1.05f;
+
+    struct VertexCacheStatistics
+    {
+        // Vertex shader invocations, the misses of a FIFO cache
+        u32 vertexTransforms = 0;
+
+        // Average cache miss ratio, transforms per triangle. 3 means no
+        // reuse at all, a regular grid approaches 0.5.
+        f32 acmr = 0.0f;
+
+        // Average transform to vertex ratio, transforms per referenced
+        // vertex. 1 is optimal.
+        f32 atvr = 0.0f;
+    };
+
+    HELIOS_NO_DISCARD VertexCacheStatistics analyzeVertexCache(
+        const span<const u32> indices, const u32 vertexCount,
+        const u32 cacheSize = default_vertex_cache_size);
+
+    // Merges vertices whose attributes are all bitwise equal and rewrites
+    // the triangles to match. Returns the new vertex count.
+    u32 deduplicateVertices(Mesh& mesh);
+
+    // Reorders triangles for the post-transform vertex cache with Tipsify
+    // (Sander, Nehab and Barczak 2007), linear in the index count.
+    void optimizeVertexCache(span<u32> indices, const u32 vertexCount,
+                             const u32 cacheSize = default_vertex_cache_size);
+
+    // Splits cache optimised triangles into clusters whose ACMR stays within
+    // threshold times the input's and draws outward facing clusters first,
+    // so later ones are more likely to fail the depth test.
+    void optimizeOverdraw(span<u32> indices, const span<const Vector3f> positions,
+                          const f32 threshold = default_overdraw_threshold,
+                          const u32 cacheSize = default_vertex_cache_size);
+
+    // Renumbers vertices in the order the triangles first use them, dropping
+    // unreferenced ones, so vertex fetch walks memory linearly. Returns the
+    // new vertex count.
+    u32 optimizeVertexFetch(Mesh& mesh);
+
+    // Runs every stage above on a mesh and each of its sub meshes,
+    // rebuilding the ones that were already built. With a job system the
+    // sub meshes are optimised in parallel.
+    void optimizeMesh(Mesh& mesh, JobSystem* jobs = nullptr);
+} // namespace helios
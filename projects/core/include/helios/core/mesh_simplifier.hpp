@@ -0,0 +1,46 @@
+#pragma once
+
+#include <helios/containers/span.hpp>
+#include <helios/containers/vector.hpp>
+#include <helios/core/mesh.hpp>
+#include <helios/macros.hpp>
+#include <helios/math/vector.hpp>
+
+namespace helios
+{
+    class JobSystem;
+
+    // Collapses edges of an indexed triangle list by quadric error until at
+    // most targetIndexCount indices remain or the next collapse would move
+    // the surface further than targetError. Errors are relative to the
+    // largest extent of the positions, so 0.01 is 1% of the mesh size.
+    //
+    // Vertices are never moved, only merged into neighbours, so the result
+    // indexes the same vertex buffer. Vertices on open borders slide along
+    // the border only, and a uv or normal seam (several vertices at one
+    // position) collapses on both sides at once so it never cracks open.
+    // resultError receives the largest relative error introduced.
+    HELIOS_NO_DISCARD vector<u32> simplify(const span<const u32> indices,
+                                           const span<const Vector3f> positions,
+                                           const size_t targetIndexCount,
+                                           const f32 targetError,
+                                           f32* resultError = nullptr);
+
+    struct LodSettings
+    {
+        // Triangle count of every level relative to the full mesh, finest
+        // first. The chain stops early once a level no longer gets smaller
+        // within the error budget.
+        vector<f32> ratios = {0.5f, 0.25f, 0.125f, 0.0625f};
+
+        // The error a single level may add, relative to the mesh extent
+        f32 maxError = 0.01f;
+    };
+
+    // Fills Mesh::lods of a mesh and each of its sub meshes, every level
+    // simplified from the one before and ordered for the vertex cache. With
+    // a job system the sub meshes are processed in parallel. Run
+    // optimizeMesh first, as it renumbers vertices.
+    void generateLods(Mesh& mesh, const LodSettings& settings = LodSettings(),
+                      JobSystem* jobs = nullptr);
+} // namespace helios
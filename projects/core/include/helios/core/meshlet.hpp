@@ -0,0 +1,67 @@
+#pragma once
+
+#include <helios/containers/span.hpp>
+#include <helios/containers/vector.hpp>
+#include <helios/core/mesh.hpp>
+#include <helios/macros.hpp>
+#include <helios/math/bounds.hpp>
+#include <helios/math/vector.hpp>
+
+namespace helios
+{
+    class JobSystem;
+
+    // Limits of one meshlet. They fit the output of a mesh shader workgroup,
+    // and 124 triangles of three byte indices end on a four byte boundary.
+    constexpr u32 max_meshlet_vertices = 64;
+    constexpr u32 max_meshlet_triangles = 124;
+
+    // Same layout as VkDrawIndexedIndirectCommand
+    struct DrawIndexedIndirectCommand
+    {
+        u32 indexCount;
+        u32 instanceCount;
+        u32 firstIndex;
+        i32 vertexOffset;
+        u32 firstInstance;
+    };
+
+    // Partitions an indexed triangle list into meshlets, growing each from
+    // a seed triangle through the triangles sharing the most vertices with
+    // it, and computes their bounding spheres and normal cones. The output
+    // vectors are replaced.
+    void buildMeshlets(const span<const u32> indices,
+                       const span<const Vector3f> positions,
+                       vector<Meshlet>& meshlets, vector<u32>& meshletVertices,
+                       vector<u8>& meshletTriangles);
+
+    // Fills the meshlets of a mesh and each of its sub meshes from their
+    // triangles. With a job system the sub meshes are processed in
+    // parallel. Run optimizeMesh first, its triangle order keeps meshlets
+    // spatially coherent.
+    void buildMeshlets(Mesh& mesh, JobSystem* jobs = nullptr);
+
+    // The meshlet triangles of a mesh as mesh vertex indices, laid out like
+    // meshletTriangles so meshlet i starts at meshlets[i].triangleOffset.
+    // This is the index buffer the draw commands of cullMeshlets refer to.
+    HELIOS_NO_DISCARD vector<u32> meshletIndices(const Mesh& mesh);
+
+    // Frustum and backface cone test. frustum and cameraPosition are in the
+    // mesh's local space. A culled meshlet is guaranteed to have no visible
+    // triangle with counter clockwise front faces.
+    HELIOS_NO_DISCARD bool isMeshletVisible(const Meshlet& meshlet,
+                                            const Frustum& frustum,
+                                            const Vector3f& cameraPosition);
+
+    // Replaces commands with one draw per run of consecutive visible
+    // meshlets, indexing the buffer from meshletIndices. Returns the number
+    // of visible meshlets.
+    size_t cullMeshlets(const span<const Meshlet> meshlets,
+                        const Frustum& frustum, const Vector3f& cameraPosition,
+                        vector<DrawIndexedIndirectCommand>& commands);
+
+    // Replaces indices with the triangles of the visible meshlets of a mesh,
+    // as mesh vertex indices. Returns the number of visible meshlets.
+    size_t cullMeshlets(const Mesh& mesh, const Frustum& frustum,
+                        const Vector3f& cameraPosition, vector<u32>& indices);
+} // namespace helios
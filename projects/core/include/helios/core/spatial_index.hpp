@@ -0,0 +1,141 @@
+#pragma once
+
+#include <helios/core/aabb_tree.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/core/transformation.hpp>
+#include <helios/ecs/entity.hpp>
+#include <helios/macros.hpp>
+#include <helios/math/bounds.hpp>
+
+#include <entt/entt.hpp>
+
+#include <vector>
+
+namespace helios
+{
+    // Local space bounds of an entity, usually Mesh::bounds. Entities with a
+    // TransformationComponent are placed by its world matrix.
+    struct BoundsComponent
+    {
+        AABB local;
+    };
+
+    // Keeps a DynamicAABBTree over every entity with a BoundsComponent.
+    // update picks up the transformations stamped since the last update, so
+    // it has to run after the TransformSystem. Small batches of moves are
+    // applied one by one, large ones refit the tree in parallel and rebuild
+    // it once the refits have made it noticeably worse than the last build.
+    //
+    // Queries test the exact world bounds after the tree narrowed the
+    // candidates down, and call fn(Entity).
+    class SpatialIndex
+    {
+    public:
+        SpatialIndex(EntityManager& manager, JobSystem& jobs);
+        ~SpatialIndex();
+        HELIOS_NO_COPY_MOVE(SpatialIndex)
+
+        void update();
+
+        template <typename Func>
+        void query(const AABB& box, Func&& fn) const;
+
+        template <typename Func>
+        void query(const BoundingSphere& sphere, Func&& fn) const;
+
+        template <typename Func>
+        void query(const Frustum& frustum, Func&& fn) const;
+
+        // Hits arrive in no particular order, fn(Entity, distance) returns
+        // the new maximum distance like DynamicAABBTree::raycast.
+        template <typename Func>
+        void raycast(const Ray& ray, const f32 maxDistance, Func&& fn) const;
+
+        // Closest entity hit by the ray, false if there is none within
+        // maxDistance.
+        bool raycastClosest(const Ray& ray, const f32 maxDistance,
+                            Entity& hit, f32& distance) const;
+
+        [[nodiscard]] size_t size() const noexcept;
+        [[nodiscard]] const DynamicAABBTree& tree() const noexcept;
+
+    private:
+        struct Moved
+        {
+            u32 proxy;
+            const AABB* local;
+            const TransformationComponent* transform;
+        };
+
+        EntityManager& _manager;
+        entt::registry& _registry;
+        JobSystem& _jobs;
+        DynamicAABBTree _tree;
+
+        // exact world bounds and entity by proxy, proxy by entity slot
+        std::vector<AABB> _bounds;
+        std::vector<entt::entity> _entities;
+        std::vector<u32> _proxies;
+
+        std::vector<entt::entity> _added;
+        std::vector<Moved> _moved;
+        u64 _seen;
+        f32 _builtCost;
+
+        u32 _proxy(const entt::entity entity) const noexcept;
+        void _place(const entt::entity entity, const u32 proxy);
+        AABB _worldBounds(const entt::entity entity) const;
+        void _onAdded(entt::registry& registry, entt::entity entity);
+        void _onRemoved(entt::registry& registry, entt::entity entity);
+        Entity _entity(const u32 proxy) const;
+    };
+
+    template <typename Func>
+    inline void SpatialIndex::query(const AABB& box, Func&& fn) const
+    {
+        _tree.query(box, [&](const u32 proxy) {
+            if (_bounds[proxy].intersects(box))
+            {
+                fn(_entity(proxy));
+            }
+        });
+    }
+
+    template <typename Func>
+    inline void SpatialIndex::query(const BoundingSphere& sphere,
+                                    Func&& fn) const
+    {
+        _tree.query(sphere, [&](const u32 proxy) {
+            if (_bounds[proxy].intersects(sphere))
+            {
+                fn(_entity(proxy));
+            }
+        });
+    }
+
+    template <typename Func>
+    inline void SpatialIndex::query(const Frustum& frustum, Func&& fn) const
+    {
+        _tree.query(frustum, [&](const u32 proxy) {
+            if (frustum.intersects(_bounds[proxy]))
+            {
+                fn(_entity(proxy));
+            }
+        });
+    }
+
+    template <typename Func>
+    inline void SpatialIndex::raycast(const Ray& ray, const f32 maxDistance,
+                                      Func&& fn) const
+    {
+        f32 limit = maxDistance;
+        _tree.raycast(ray, maxDistance, [&](const u32 proxy, f32) {
+            f32 distance;
+            if (ray.intersects(_bounds[proxy], distance) && distance <= limit)
+            {
+                limit = fn(_entity(proxy), distance);
+            }
+            return limit;
+        });
+    }
+} // namespace helios
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <helios/core/job_system.hpp>
+#include <helios/macros.hpp>
+#include <helios/math/matrix.hpp>
+#include <helios/math/transform_batch.hpp>
+#include <helios/math/vector.hpp>
+
+#include <vector>
+
+namespace helios
+{
+    // Flat transformations for large numbers of instances that do not need
+    // a hierarchy. Positions, rotations and scales live in one array per
+    // component and the matrices in one contiguous array, so rebuild runs
+    // the AVX2 kernel over whole blocks of 8 and matrices() can be copied
+    // straight into a model buffer.
+    //
+    // Indices are dense, remove moves the last transformation into the
+    // freed index.
+    class TransformBatch
+    {
+    public:
+        explicit TransformBatch(const size_t capacity = 0);
+        ~TransformBatch() = default;
+        HELIOS_NO_COPY_MOVE(TransformBatch)
+
+        u32 add(const Vector3f& position, const Vector3f& rotation,
+                const Vector3f& scale);
+
+        // Returns the index of the transformation that now lives at index,
+        // which was the last one before the call.
+        u32 remove(const u32 index);
+        void clear();
+
+        [[nodiscard]] Vector3f position(const u32 index) const noexcept;
+        [[nodiscard]] Vector3f rotation(const u32 index) const noexcept;
+        [[nodiscard]] Vector3f scale(const u32 index) const noexcept;
+        void setPosition(const u32 index, const Vector3f& position) noexcept;
+        void setRotation(const u32 index, const Vector3f& rotation) noexcept;
+        void setScale(const u32 index, const Vector3f& scale) noexcept;
+
+        // Rebuilds the matrices of every block of 8 with a changed
+        // transformation, split across the job system when one is given.
+        void rebuild(JobSystem* jobs = nullptr);
+
+        [[nodiscard]] bool dirty(const u32 index) const noexcept;
+        [[nodiscard]] size_t size() const noexcept;
+
+        // size() matrices, valid until the next add. Only current after
+        // rebuild.
+        [[nodiscard]] const Matrix4f* matrices() const noexcept;
+        [[nodiscard]] size_t matrixBytes() const noexcept;
+
+    private:
+        static constexpr size_t block_size = 8;
+
+        // x, y and z of position, rotation and scale
+        std::vector<f32> _components[9];
+        std::vector<Matrix4f> _matrices;
+        // one flag per block of 8 transformations
+        std::vector<u8> _dirty;
+        size_t _size;
+
+        void _set(const u32 index, const size_t component,
+                  const Vector3f& value) noexcept;
+        [[nodiscard]] Vector3f _get(const u32 index,
+                                    const size_t component) const noexcept;
+        [[nodiscard]] TransformArrays _arrays() const noexcept;
+        void _rebuildBlocks(const size_t first, const size_t last) noexcept;
+    };
+} // namespace helios
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <helios/containers/vector.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/core/transformation.hpp>
+#include <helios/ecs/entity.hpp>
+#include <helios/macros.hpp>
+
+#include <entt/entt.hpp>
+
+namespace helios
+{
+    // Rebuilds the local and world matrices of every TransformationComponent
+    // once per frame. Nodes are kept in a depth ordered array, so each level
+    // only reads world matrices finished by the level before it and can be
+    // split across the job system. Nodes whose local transformation and
+    // parent are unchanged skip the matrix work entirely. TransformationComponent
+    // is tracked, every node whose world matrix changed gets stamped, so
+    // consumers can use EntityManager::changed_since to see only those.
+    class TransformSystem
+    {
+    public:
+        TransformSystem(EntityManager& manager, JobSystem& jobs);
+        ~TransformSystem();
+        HELIOS_NO_COPY_MOVE(TransformSystem)
+
+        // Returns false and leaves the hierarchy untouched if parent is child
+        // or one of its descendants.
+        bool setParent(Entity child, Entity parent);
+        void removeParent(Entity child);
+
+        void update();
+
+    private:
+        EntityManager& _manager;
+        entt::registry& _registry;
+        JobSystem& _jobs;
+
+        // nodes in depth order, _levels[d] is the first node of depth d
+        vector<TransformationComponent*> _nodes;
+        vector<ComponentVersion<TransformationComponent>*> _versions;
+        vector<u32> _parents;
+        vector<u8> _changed;
+        vector<u32> _levels;
+        bool _topologyChanged;
+
+        void _rebuild();
+        void _updateNode(const u32 index, const bool force,
+                         const u64 version) noexcept;
+        void _onTopologyChanged(entt::registry& registry, entt::entity entity);
+    };
+} // namespace helios
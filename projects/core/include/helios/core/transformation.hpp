@@ -4,10 +4,14 @@
 #include <helios/math/matrix.hpp>
 #include <helios/math/vector.hpp>
 
+#include <entt/entt.hpp>
+
 namespace helios
 {
     class alignas(64) TransformationComponent
     {
+        friend class TransformSystem;
+
     public:
         TransformationComponent() noexcept = default;
         TransformationComponent(const Vector3f& pos, const Vector3f& rot,
@@ -20,16 +24,30 @@ namespace helios
         Vector3f getScale() const noexcept;
         void setScale(const Vector3f& sca) noexcept;
         Matrix4f getTransform() const noexcept;
+        Matrix4f getWorldTransform() const noexcept;
+        bool isDirty() const noexcept;
 
         PROPERTY(Vector3f, position, getPosition, setPosition);
         PROPERTY(Vector3f, rotation, getRotation, setRotation);
         PROPERTY(Vector3f, scale, getScale, setScale);
         PROPERTY_READONLY(Matrix4f, matrix, getTransform);
+        PROPERTY_READONLY(Matrix4f, world, getWorldTransform);
 
     private:
         Vector3f _position;
         Vector3f _rotation;
         Vector3f _scale;
+        // local and world matrices, rebuilt by the TransformSystem
         Matrix4f _transform;
+        Matrix4f _world;
+        bool _dirty = true;
+    };
+
+    // Parents an entity's transformation to another entity's. Use
+    // TransformSystem::setParent to change it so the system can reject cycles
+    // and reorder its update.
+    struct HierarchyComponent
+    {
+        entt::entity parent = entt::null;
     };
-} // namespace helios
\ No newline at end of file
+} // namespace helios
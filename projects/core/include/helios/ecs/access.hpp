@@ -0,0 +1,69 @@
+#pragma once
+
+#include <helios/containers/vector.hpp>
+#include <helios/macros.hpp>
+
+#include <entt/entt.hpp>
+
+#include <type_traits>
+
+namespace helios
+{
+    // Declares the components a piece of work only reads.
+    template <typename... Components>
+    struct Read
+    {
+    };
+
+    // Declares the components a piece of work may modify.
+    template <typename... Components>
+    struct Write
+    {
+    };
+
+    // Runtime form of a Read/Write declaration. Two accesses conflict when
+    // either one writes a component the other reads or writes.
+    class ComponentAccess
+    {
+    public:
+        ComponentAccess() = default;
+
+        template <typename... Reads, typename... Writes>
+        static ComponentAccess of(Read<Reads...>, Write<Writes...>);
+
+        template <typename Component>
+        void read();
+
+        template <typename Component>
+        void write();
+
+        [[nodiscard]] bool reads(const entt::id_type component) const noexcept;
+        [[nodiscard]] bool writes(const entt::id_type component) const noexcept;
+        [[nodiscard]] bool conflicts(const ComponentAccess& other) const noexcept;
+
+    private:
+        vector<entt::id_type> _reads;
+        vector<entt::id_type> _writes;
+    };
+
+    template <typename... Reads, typename... Writes>
+    inline ComponentAccess ComponentAccess::of(Read<Reads...>, Write<Writes...>)
+    {
+        ComponentAccess access;
+        (access.read<Reads>(), ...);
+        (access.write<Writes>(), ...);
+        return access;
+    }
+
+    template <typename Component>
+    inline void ComponentAccess::read()
+    {
+        _reads.push_back(entt::type_info<std::decay_t<Component>>::id());
+    }
+
+    template <typename Component>
+    inline void ComponentAccess::write()
+    {
+        _writes.push_back(entt::type_info<std::decay_t<Component>>::id());
+    }
+} // namespace helios
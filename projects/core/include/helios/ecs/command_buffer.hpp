@@ -0,0 +1,223 @@
+#pragma once
+
+#include <helios/ecs/entity.hpp>
+#include <helios/macros.hpp>
+
+#include <entt/entt.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace helios
+{
+    // Entity created through a CommandBuffer. It only turns into a real
+    // entity on playback, see CommandBuffer::resolve.
+    class PendingEntity
+    {
+        friend class CommandBuffer;
+
+    public:
+        PendingEntity() = default;
+
+    private:
+        u32 _stream = ~0U;
+        u32 _index = ~0U;
+    };
+
+    // Records structural changes from any thread and applies them to the
+    // manager at a sync point. Recording never touches the registry, every
+    // thread writes into its own stream.
+    //
+    // Playback is deterministic: commands are ordered by the sort key of the
+    // recorder and the order they were recorded in through it, never by the
+    // thread that recorded them. Creations run first, then component changes
+    // grouped by component type, then releases. Commands targeting an entity
+    // that is no longer valid are dropped.
+    class CommandBuffer
+    {
+        struct Stream;
+
+    public:
+        class Recorder
+        {
+            friend class CommandBuffer;
+
+            Recorder(Stream& stream, const u64 key);
+
+        public:
+            PendingEntity create();
+            void release(const Entity& entity);
+
+            // Assigns or replaces the component.
+            template <typename Component, typename... Args>
+            void assign(const Entity& entity, Args&&... args);
+
+            template <typename Component, typename... Args>
+            void assign(const PendingEntity& entity, Args&&... args);
+
+            template <typename Component>
+            void remove(const Entity& entity);
+
+        private:
+            Stream& _stream;
+            u64 _key;
+            u32 _sequence;
+
+            template <typename Component, typename... Args>
+            void _assign(const entt::entity entity, const u32 pending,
+                         Args&&... args);
+        };
+
+        explicit CommandBuffer(EntityManager& manager);
+        ~CommandBuffer();
+        HELIOS_NO_COPY_MOVE(CommandBuffer)
+
+        // Recorder for the calling thread. Keys should be unique per
+        // recorder, e.g. the index of the work item, ties between threads
+        // are not ordered deterministically.
+        Recorder record(const u64 sortKey);
+
+        // Uses the entity being processed as the sort key.
+        Recorder record(const Entity& source);
+
+        // Applies and clears every recorded command. Must not overlap with
+        // recording.
+        void playback();
+
+        // Entity created for a pending entity by the last playback.
+        [[nodiscard]] Entity resolve(const PendingEntity& entity) const;
+
+        [[nodiscard]] bool empty() const;
+
+    private:
+        struct ComponentOps
+        {
+            entt::id_type id;
+            void (*assign)(entt::registry&, entt::entity, void*);
+            void (*remove)(entt::registry&, entt::entity);
+            void (*reserve)(entt::registry&, size_t);
+            void (*destroy)(void*);
+        };
+
+        enum class CommandKind : u8
+        {
+            CREATE,
+            RELEASE,
+            ASSIGN,
+            REMOVE
+        };
+
+        struct Command
+        {
+            u64 key;
+            u32 sequence;
+            CommandKind kind;
+            entt::entity entity;
+            // index of the pending entity in the stream, ~0U for live ones
+            u32 pending;
+            const ComponentOps* ops;
+            void* payload;
+        };
+
+        struct Stream
+        {
+            u32 index;
+            u32 created;
+            std::vector<Command> commands;
+            std::vector<entt::entity> resolved;
+
+            // component values live in fixed blocks so recording more never
+            // moves the earlier ones
+            std::vector<std::unique_ptr<std::byte[]>> blocks;
+            size_t blockUsed;
+            size_t blockSize;
+
+            void* allocate(const size_t size, const size_t alignment);
+            void clear();
+        };
+
+        EntityManager& _manager;
+        entt::registry& _registry;
+        u64 _id;
+
+        mutable std::mutex _streamMutex;
+        std::vector<std::unique_ptr<Stream>> _streams;
+        std::unordered_map<std::thread::id, Stream*> _threadStreams;
+
+        Stream& _local();
+
+        template <typename Component>
+        static const ComponentOps* _ops();
+    };
+
+    template <typename Component, typename... Args>
+    inline void CommandBuffer::Recorder::assign(const Entity& entity,
+                                                Args&&... args)
+    {
+        _assign<Component>(entity.handle(), ~0U, std::forward<Args>(args)...);
+    }
+
+    template <typename Component, typename... Args>
+    inline void CommandBuffer::Recorder::assign(const PendingEntity& entity,
+                                                Args&&... args)
+    {
+        _assign<Component>(entt::null, entity._index,
+                           std::forward<Args>(args)...);
+    }
+
+    template <typename Component>
+    inline void CommandBuffer::Recorder::remove(const Entity& entity)
+    {
+        _stream.commands.push_back({_key, _sequence++, CommandKind::REMOVE,
+                                    entity.handle(), ~0U, _ops<Component>(),
+                                    nullptr});
+    }
+
+    template <typename Component, typename... Args>
+    inline void CommandBuffer::Recorder::_assign(const entt::entity entity,
+                                                 const u32 pending,
+                                                 Args&&... args)
+    {
+        void* payload = _stream.allocate(sizeof(Component), alignof(Component));
+        if constexpr (std::is_aggregate_v<Component>)
+        {
+            new (payload) Component{std::forward<Args>(args)...};
+        }
+        else
+        {
+            new (payload) Component(std::forward<Args>(args)...);
+        }
+
+        _stream.commands.push_back({_key, _sequence++, CommandKind::ASSIGN,
+                                    entity, pending, _ops<Component>(),
+                                    payload});
+    }
+
+    template <typename Component>
+    inline const CommandBuffer::ComponentOps* CommandBuffer::_ops()
+    {
+        static const ComponentOps ops = {
+            entt::type_info<Component>::id(),
+            [](entt::registry& registry, entt::entity entity, void* payload) {
+                registry.emplace_or_replace<Component>(
+                    entity, std::move(*static_cast<Component*>(payload)));
+            },
+            [](entt::registry& registry, entt::entity entity) {
+                registry.remove_if_exists<Component>(entity);
+            },
+            [](entt::registry& registry, size_t additional) {
+                registry.reserve<Component>(registry.size<Component>() +
+                                            additional);
+            },
+            [](void* payload) { static_cast<Component*>(payload)->~Component(); },
+        };
+        return &ops;
+    }
+} // namespace helios
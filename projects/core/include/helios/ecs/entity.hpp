@@ -1,17 +1,53 @@
 #pragma once
 
 #include <helios/containers/utility.hpp>
+#include <helios/containers/vector.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/ecs/access.hpp>
 
 #include <entt/entt.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
 namespace helios
 {
     class Entity;
     class EntityManager;
 
+    // Components a group looks up per entity without owning their storage.
+    template <typename... Components>
+    struct Get
+    {
+    };
+
+    // Components an entity must not have to be part of a group.
+    template <typename... Components>
+    struct Exclude
+    {
+    };
+
+    template <typename Gets, typename Excludes, typename... Owned>
+    class Group;
+
+    // Version of the last change to Component on an entity. Only present
+    // for components registered with EntityManager::track.
+    template <typename Component>
+    struct ComponentVersion
+    {
+        u64 version;
+    };
+
     class Entity
     {
+        friend class CommandBuffer;
         friend class EntityManager;
+        friend class SpatialIndex;
+        template <typename Gets, typename Excludes, typename... Owned>
+        friend class Group;
 
         Entity(entt::entity e, EntityManager* manager);
 
@@ -33,9 +69,21 @@ namespace helios
         template <typename Component>
         void remove();
 
+        // Stamps a tracked component as changed at the current version. Use
+        // after modifying it through get, assign and replace stamp on their
+        // own. Safe to call from parallel queries for distinct entities.
+        template <typename Component>
+        void touch();
+
+        // Calls fn(Component&) and stamps the component.
+        template <typename Component, typename Func>
+        void patch(Func&& fn);
+
         template <typename Component, typename... Args>
         Component& replace(Args&&... args);
 
+        entt::entity handle() const noexcept;
+
     private:
         entt::entity _ent;
         EntityManager* _manager;
@@ -46,6 +94,11 @@ namespace helios
         friend class Entity;
 
     public:
+        // Without a job system the parallel variants run on the calling
+        // thread.
+        explicit EntityManager(JobSystem* jobs = nullptr);
+        HELIOS_NO_COPY_MOVE(EntityManager)
+
         Entity create();
         void release(Entity ent);
         void releaseAll();
@@ -53,10 +106,226 @@ namespace helios
         template <typename Func, typename ... Components>
         void each(Func fn);
 
+        // Returns the group of entities holding every Owned and Gets
+        // component and none of the Excludes. The group takes over the
+        // storage of the Owned components and keeps its members packed at
+        // the front of those pools, so iterating them is a linear walk. A
+        // component can only be owned by one group at a time, nesting groups
+        // that own a superset is fine. With no Owned components the group is
+        // a cached list of matching entities.
+        template <typename... Owned, typename... Gets, typename... Excludes>
+        Group<Get<Gets...>, Exclude<Excludes...>, Owned...> group(
+            Get<Gets...>, Exclude<Excludes...> = {});
+
+        template <typename... Owned, typename... Excludes>
+        Group<Get<>, Exclude<Excludes...>, Owned...> group(
+            Exclude<Excludes...> = {});
+
+        // Fires whenever an owning group created through group() moves
+        // Component around inside its pool: once when the group is created
+        // and whenever an entity may have joined or left it. References to
+        // Component kept across calls are stale afterwards. The listener
+        // signature matches the registry construct and destroy signals, the
+        // entity is null for the creation of the group.
+        template <typename Component>
+        entt::sink<void(entt::registry&, entt::entity)> on_reorder();
+
+        // Runs fn over every entity holding all the read and written
+        // components, split into contiguous ranges of grain entities across
+        // the job system. fn takes the read components as const references
+        // followed by the written ones, optionally preceded by the Entity.
+        // The ranges only depend on the entity count and grain. Blocks while
+        // another parallel query with conflicting access is running.
+        // Started from a callback of a conflicting query it would wait on
+        // itself. If that query and every one in between run their
+        // callbacks one at a time on this thread, it runs inline as a plain
+        // nested loop. Otherwise sibling ranges would race with it, so it
+        // asserts and does not run.
+        template <typename Reads, typename Writes = Write<>, typename Func>
+        void parallel_each(Func&& fn, const size_t grain = default_grain);
+
+        // Like parallel_each, but fn folds each entity into a per-range
+        // accumulator, fn(T& acc, components...). The range results are
+        // combined left to right with combine(T, T), so the result does not
+        // depend on the number of workers.
+        template <typename Reads, typename Writes = Write<>, typename T,
+                  typename Func, typename Combine>
+        T parallel_reduce(T identity, Func&& fn, Combine&& combine,
+                          const size_t grain = default_grain);
+
+        // Starts stamping Component with the current version whenever it is
+        // assigned, replaced or touched. Entities already holding it count as
+        // changed now.
+        template <typename Component>
+        void track();
+
+        template <typename Component>
+        [[nodiscard]] bool tracked() const;
+
+        [[nodiscard]] u64 version() const noexcept;
+
+        // Ends the current version and returns it. A consumer keeps the value
+        // from its previous call and asks for changes since then:
+        //
+        //     const u64 now = manager.advanceVersion();
+        //     manager.changed_since<T>(_seen, upload);
+        //     _seen = now;
+        //
+        // Changes made while it iterates are stamped after now and show up
+        // on its next pass.
+        u64 advanceVersion() noexcept;
+
+        // Calls fn for every entity whose tracked Component was stamped
+        // after since. fn takes the component, optionally preceded by the
+        // Entity. Cost is linear in the number of stamps, which are packed
+        // and much smaller than most components.
+        template <typename Component, typename Func>
+        void changed_since(const u64 since, Func&& fn);
+
+        static constexpr size_t default_grain = 1024;
+
     private:
         friend entt::registry& get_entt(EntityManager& manager);
+        template <typename Gets, typename Excludes, typename... Owned>
+        friend class Group;
+
+        // A query the calling thread holds, or runs callbacks of. parent is
+        // the callback the query was started from, possibly on another
+        // thread, and job the JobSystem::currentJob the entry was made in.
+        struct HeldAccess
+        {
+            const EntityManager* manager;
+            const ComponentAccess* access;
+            const HeldAccess* parent;
+            u64 job;
+            bool serial;
+            bool callback;
+        };
+
+        class AccessScope;
+
+        class AccessGuard
+        {
+        public:
+            AccessGuard(EntityManager& manager, const ComponentAccess& access);
+            ~AccessGuard();
+            HELIOS_NO_COPY_MOVE(AccessGuard)
+
+            // true when started from the callback of a conflicting query,
+            // with that query and every one in between running their
+            // callbacks one at a time on this thread. The guard then holds
+            // nothing and the query has to run serially.
+            [[nodiscard]] bool nested() const noexcept;
+
+            // true when the query must not run, because it conflicts with a
+            // query it was started from that runs in parallel, or with one
+            // this thread holds below a job it picked up while waiting
+            [[nodiscard]] bool rejected() const noexcept;
+
+        private:
+            friend class AccessScope;
+
+            EntityManager& _manager;
+            const ComponentAccess& _access;
+            HeldAccess _held;
+            bool _nested;
+            bool _rejected;
+        };
+
+        // Marks the calling thread as running callbacks of the query of
+        // guard, either all of them or one range of many.
+        class AccessScope
+        {
+        public:
+            AccessScope(const AccessGuard& guard, const bool serial);
+            ~AccessScope();
+            HELIOS_NO_COPY_MOVE(AccessScope)
+
+        private:
+            HeldAccess _held;
+        };
+
+        template <typename Component>
+        struct ReorderSignal
+        {
+            entt::sigh<void(entt::registry&, entt::entity)> signal;
+        };
+
+        // marks an owning group whose membership signals are forwarded to
+        // the ReorderSignal of its owned components
+        template <typename GroupType>
+        struct ReorderHooks
+        {
+        };
 
         entt::registry _registry;
+        JobSystem* _jobs;
+
+        std::atomic<u64> _version;
+        std::vector<entt::id_type> _tracked;
+
+        std::mutex _accessMutex;
+        std::condition_variable _accessReleased;
+        std::vector<const ComponentAccess*> _activeAccess;
+
+        static std::vector<const HeldAccess*>& _heldAccess() noexcept;
+
+        template <typename... Reads, typename... Writes, typename Prepare,
+                  typename Func>
+        void _forEachRange(Read<Reads...>, Write<Writes...>, const size_t grain,
+                           Prepare&& prepare, Func&& rangeFn);
+
+        template <typename Func, typename... Components>
+        void _invoke(Func& fn, const entt::entity entity,
+                     Components&... components);
+
+        template <typename Component>
+        void _stamp(entt::registry& registry, entt::entity entity);
+
+        template <typename Component>
+        void _unstamp(entt::registry& registry, entt::entity entity);
+
+        template <typename... Owned>
+        static void _publishReorder(entt::registry& registry,
+                                    entt::entity entity);
+    };
+
+    template <typename... Gets, typename... Excludes, typename... Owned>
+    class Group<Get<Gets...>, Exclude<Excludes...>, Owned...>
+    {
+        friend class EntityManager;
+
+        using handle_type =
+            entt::basic_group<entt::entity, entt::exclude_t<Excludes...>,
+                              entt::get_t<Gets...>, Owned...>;
+
+        Group(handle_type handle, EntityManager* manager);
+
+    public:
+        [[nodiscard]] size_t size() const noexcept;
+        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] bool contains(const Entity& entity) const;
+
+        // fn takes the owned components followed by the looked up ones,
+        // optionally preceded by the Entity.
+        template <typename Func>
+        void each(Func&& fn);
+
+        // Like each, split into contiguous ranges of grain entities across
+        // the job system of the manager. Every component of the group counts
+        // as written, so this blocks while a conflicting parallel query runs.
+        // Started from one of its callbacks, it behaves like
+        // EntityManager::parallel_each.
+        template <typename Func>
+        void parallel_each(Func&& fn,
+                           const size_t grain = EntityManager::default_grain);
+
+    private:
+        handle_type _handle;
+        EntityManager* _manager;
+
+        template <typename Func>
+        void _visit(Func& fn, const size_t begin, const size_t end);
     };
 
     template <typename Component>
@@ -97,9 +366,403 @@ namespace helios
         return _manager->_registry.remove<Component>(_ent);
     }
     
+    template <typename Component>
+    inline void Entity::touch()
+    {
+        if (auto* stamp =
+                _manager->_registry.try_get<ComponentVersion<Component>>(_ent))
+        {
+            stamp->version = _manager->version();
+        }
+    }
+
+    template <typename Component, typename Func>
+    inline void Entity::patch(Func&& fn)
+    {
+        fn(get<Component>());
+        touch<Component>();
+    }
+
+    inline entt::entity Entity::handle() const noexcept
+    {
+        return _ent;
+    }
+
     template <typename Func, typename... Components>
     inline void EntityManager::each(Func fn)
     {
         _registry.view<Components...>().each(fn);
     }
+
+    template <typename Component>
+    inline void EntityManager::track()
+    {
+        if (tracked<Component>())
+        {
+            return;
+        }
+        _tracked.push_back(entt::type_info<Component>::id());
+
+        _registry.on_construct<Component>()
+            .template connect<&EntityManager::_stamp<Component>>(*this);
+        _registry.on_update<Component>()
+            .template connect<&EntityManager::_stamp<Component>>(*this);
+        _registry.on_destroy<Component>()
+            .template connect<&EntityManager::_unstamp<Component>>(*this);
+
+        const u64 current = version();
+        _registry.view<Component>().each(
+            [this, current](const entt::entity entity, Component&) {
+                _registry.emplace_or_replace<ComponentVersion<Component>>(
+                    entity, current);
+            });
+    }
+
+    template <typename Component>
+    inline bool EntityManager::tracked() const
+    {
+        const entt::id_type id = entt::type_info<Component>::id();
+        for (const entt::id_type tracked : _tracked)
+        {
+            if (tracked == id)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline u64 EntityManager::version() const noexcept
+    {
+        return _version.load(std::memory_order_relaxed);
+    }
+
+    inline u64 EntityManager::advanceVersion() noexcept
+    {
+        return _version.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename Component, typename Func>
+    inline void EntityManager::changed_since(const u64 since, Func&& fn)
+    {
+        auto stamps = _registry.view<ComponentVersion<Component>>();
+        const entt::entity* entities = stamps.data();
+        const ComponentVersion<Component>* versions = stamps.raw();
+        const size_t count = stamps.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (versions[i].version > since)
+            {
+                const entt::entity entity = entities[i];
+                _invoke(fn, entity, _registry.get<Component>(entity));
+            }
+        }
+    }
+
+    template <typename Component>
+    inline void EntityManager::_stamp(entt::registry& registry,
+                                      entt::entity entity)
+    {
+        registry.emplace_or_replace<ComponentVersion<Component>>(entity,
+                                                                 version());
+    }
+
+    template <typename Component>
+    inline void EntityManager::_unstamp(entt::registry& registry,
+                                        entt::entity entity)
+    {
+        registry.remove_if_exists<ComponentVersion<Component>>(entity);
+    }
+
+    template <typename Component>
+    inline entt::sink<void(entt::registry&, entt::entity)>
+    EntityManager::on_reorder()
+    {
+        return entt::sink<void(entt::registry&, entt::entity)>(
+            _registry.ctx_or_set<ReorderSignal<Component>>().signal);
+    }
+
+    template <typename... Owned>
+    inline void EntityManager::_publishReorder(entt::registry& registry,
+                                               entt::entity entity)
+    {
+        (registry.ctx_or_set<ReorderSignal<Owned>>().signal.publish(registry,
+                                                                    entity),
+         ...);
+    }
+
+    template <typename... Owned, typename... Gets, typename... Excludes>
+    inline Group<Get<Gets...>, Exclude<Excludes...>, Owned...>
+    EntityManager::group(Get<Gets...>, Exclude<Excludes...>)
+    {
+        static_assert(sizeof...(Owned) + sizeof...(Gets) > 0,
+                      "a group needs at least one component");
+        using group_type = Group<Get<Gets...>, Exclude<Excludes...>, Owned...>;
+
+        auto handle = _registry.group<Owned...>(entt::get<Gets...>,
+                                                entt::exclude<Excludes...>);
+        if constexpr (sizeof...(Owned) > 0)
+        {
+            // An entity joins or leaves an owning group on the same signals
+            // the group listens to, and is swapped inside the owned pools
+            // without any signal of the owned components firing. Forward
+            // them, connected after the group so listeners see the final
+            // order.
+            if (_registry.try_ctx<ReorderHooks<group_type>>() == nullptr)
+            {
+                _registry.set<ReorderHooks<group_type>>();
+                constexpr auto publish = &EntityManager::_publishReorder<Owned...>;
+                (_registry.on_construct<Owned>().template connect<publish>(), ...);
+                (_registry.on_destroy<Owned>().template connect<publish>(), ...);
+                (_registry.on_construct<Gets>().template connect<publish>(), ...);
+                (_registry.on_destroy<Gets>().template connect<publish>(), ...);
+                (_registry.on_construct<Excludes>().template connect<publish>(), ...);
+                (_registry.on_destroy<Excludes>().template connect<publish>(), ...);
+
+                // creating the group packed its members already
+                _publishReorder<Owned...>(_registry, entt::null);
+            }
+        }
+        return group_type(handle, this);
+    }
+
+    template <typename... Owned, typename... Excludes>
+    inline Group<Get<>, Exclude<Excludes...>, Owned...> EntityManager::group(
+        Exclude<Excludes...>)
+    {
+        return group<Owned...>(Get<>{}, Exclude<Excludes...>{});
+    }
+
+    template <typename Reads, typename Writes, typename Func>
+    inline void EntityManager::parallel_each(Func&& fn, const size_t grain)
+    {
+        _forEachRange(Reads{}, Writes{}, grain, [](size_t) {},
+                      [&fn](auto&& visit, size_t, size_t begin, size_t end) {
+                          visit(fn, begin, end);
+                      });
+    }
+
+    template <typename Reads, typename Writes, typename T, typename Func,
+              typename Combine>
+    inline T EntityManager::parallel_reduce(T identity, Func&& fn,
+                                            Combine&& combine,
+                                            const size_t grain)
+    {
+        std::vector<T> partials;
+        _forEachRange(
+            Reads{}, Writes{}, grain,
+            [&](size_t ranges) { partials.assign(ranges, identity); },
+            [&](auto&& visit, size_t range, size_t begin, size_t end) {
+                T& acc = partials[range];
+                // the trailing return type keeps the Entity overload check
+                // in _invoke honest
+                auto fold = [&acc, &fn](auto&&... args)
+                    -> decltype(fn(acc, std::forward<decltype(args)>(args)...)) {
+                    return fn(acc, std::forward<decltype(args)>(args)...);
+                };
+                visit(fold, begin, end);
+            });
+
+        T result = identity;
+        for (T& partial : partials)
+        {
+            result = combine(std::move(result), std::move(partial));
+        }
+        return result;
+    }
+
+    template <typename... Reads, typename... Writes, typename Prepare,
+              typename Func>
+    inline void EntityManager::_forEachRange(Read<Reads...>, Write<Writes...>,
+                                             const size_t grain,
+                                             Prepare&& prepare, Func&& rangeFn)
+    {
+        constexpr size_t componentCount = sizeof...(Reads) + sizeof...(Writes);
+        static_assert(componentCount > 0,
+                      "a parallel query needs at least one component");
+
+        const ComponentAccess access =
+            ComponentAccess::of(Read<Reads...>{}, Write<Writes...>{});
+        AccessGuard guard(*this, access);
+        if (guard.rejected())
+        {
+            return;
+        }
+
+        auto view = _registry.view<const Reads..., Writes...>();
+
+        // walk the smallest pool, multi component views then check the other
+        // pools per entity
+        const entt::entity* entities = nullptr;
+        size_t count = 0;
+        if constexpr (componentCount == 1)
+        {
+            entities = view.data();
+            count = view.size();
+        }
+        else
+        {
+            count = ~size_t(0);
+            auto candidate = [&](const entt::entity* data, const size_t size) {
+                if (size < count)
+                {
+                    entities = data;
+                    count = size;
+                }
+            };
+            (candidate(view.template data<const Reads>(),
+                       view.template size<const Reads>()),
+             ...);
+            (candidate(view.template data<Writes>(),
+                       view.template size<Writes>()),
+             ...);
+        }
+
+        auto visit = [this, &view, entities](auto& fn, const size_t begin,
+                                             const size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const entt::entity entity = entities[i];
+                if constexpr (componentCount == 1)
+                {
+                    // a single pool is dense, no lookup needed
+                    _invoke(fn, entity, view.raw()[i]);
+                }
+                else if (view.contains(entity))
+                {
+                    _invoke(fn, entity,
+                            view.template get<const Reads>(entity)...,
+                            view.template get<Writes>(entity)...);
+                }
+            }
+        };
+
+        const size_t step = grain == 0 ? 1 : grain;
+        const size_t ranges = (count + step - 1) / step;
+        prepare(ranges);
+
+        auto runRanges = [&](const size_t first, const size_t last) {
+            for (size_t range = first; range < last; ++range)
+            {
+                const size_t begin = range * step;
+                const size_t end = begin + step < count ? begin + step : count;
+                rangeFn(visit, range, begin, end);
+            }
+        };
+
+        const bool serial = _jobs == nullptr || _jobs->workerCount() == 0 ||
+                            guard.nested() || ranges <= 1;
+        if (serial)
+        {
+            AccessScope scope(guard, true);
+            runRanges(0, ranges);
+        }
+        else
+        {
+            _jobs->parallelFor(ranges, 1,
+                               [&guard, &runRanges](const size_t first,
+                                                    const size_t last) {
+                                   AccessScope scope(guard, false);
+                                   runRanges(first, last);
+                               });
+        }
+    }
+
+    template <typename Func, typename... Components>
+    inline void EntityManager::_invoke(Func& fn, const entt::entity entity,
+                                       Components&... components)
+    {
+        if constexpr (std::is_invocable_v<Func&, Entity, Components&...>)
+        {
+            fn(Entity(entity, this), components...);
+        }
+        else
+        {
+            fn(components...);
+        }
+    }
+
+    template <typename... Gets, typename... Excludes, typename... Owned>
+    inline Group<Get<Gets...>, Exclude<Excludes...>, Owned...>::Group(
+        handle_type handle, EntityManager* manager)
+        : _handle(handle), _manager(manager)
+    {
+    }
+
+    template <typename... Gets, typename... Excludes, typename... Owned>
+    inline size_t Group<Get<Gets...>, Exclude<Excludes...>, Owned...>::size()
+        const noexcept
+    {
+        return _handle.size();
+    }
+
+    template <typename... Gets, typename... Excludes, typename... Owned>
+    inline bool Group<Get<Gets...>, Exclude<Excludes...>, Owned...>::empty()
+        const noexcept
+    {
+        return _handle.empty();
+    }
+
+    template <typename... Gets, typename... Excludes, typename... Owned>
+    inline bool Group<Get<Gets...>, Exclude<Excludes...>, Owned...>::contains(
+        const Entity& entity) const
+    {
+        return _handle.contains(entity.handle());
+    }
+
+    template <typename... Gets, typename... Excludes, typename... Owned>
+    template <typename Func>
+    inline void Group<Get<Gets...>, Exclude<Excludes...>, Owned...>::each(
+        Func&& fn)
+    {
+        _visit(fn, 0, _handle.size());
+    }
+
+    template <typename... Gets, typename... Excludes, typename... Owned>
+    template <typename Func>
+    inline void Group<Get<Gets...>, Exclude<Excludes...>, Owned...>::
+        parallel_each(Func&& fn, const size_t grain)
+    {
+        const ComponentAccess access =
+            ComponentAccess::of(Read<>{}, Write<Owned..., Gets...>{});
+        EntityManager::AccessGuard guard(*_manager, access);
+        if (guard.rejected())
+        {
+            return;
+        }
+
+        const size_t count = _handle.size();
+        const size_t step = grain == 0 ? 1 : grain;
+        JobSystem* jobs = _manager->_jobs;
+        if (jobs == nullptr || jobs->workerCount() == 0 || guard.nested() ||
+            count <= step)
+        {
+            EntityManager::AccessScope scope(guard, true);
+            _visit(fn, 0, count);
+            return;
+        }
+
+        jobs->parallelFor(count, step,
+                          [this, &fn, &guard](const size_t begin,
+                                              const size_t end) {
+                              EntityManager::AccessScope scope(guard, false);
+                              _visit(fn, begin, end);
+                          });
+    }
+
+    template <typename... Gets, typename... Excludes, typename... Owned>
+    template <typename Func>
+    inline void Group<Get<Gets...>, Exclude<Excludes...>, Owned...>::_visit(
+        Func& fn, const size_t begin, const size_t end)
+    {
+        // owned pools hold the members in the same order as data(), looked
+        // up components still go through the sparse set
+        const entt::entity* entities = _handle.data();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const entt::entity entity = entities[i];
+            _manager->_invoke(fn, entity, _handle.template raw<Owned>()[i]...,
+                              _handle.template get<Gets>(entity)...);
+        }
+    }
 } // namespace helios
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <helios/ecs/entity.hpp>
+#include <helios/macros.hpp>
+
+#include <entt/entt.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace helios
+{
+    enum class ESnapshotResult : u32
+    {
+        SUCCESS,
+        INVALID_HEADER,
+        UNSUPPORTED_VERSION,
+        TRUNCATED,
+        INVALID_ENTITY,
+        COMPONENT_MISMATCH
+    };
+
+    // Maps the entities stored in a snapshot to the ones load created for
+    // them. Entities that were not part of the snapshot map to entt::null.
+    class EntityRemap
+    {
+        friend class Snapshot;
+
+    public:
+        entt::entity operator()(const entt::entity saved) const noexcept;
+
+    private:
+        std::vector<entt::entity> _saved;
+        std::vector<entt::entity> _loaded;
+    };
+
+    // Binary save and load of whole component pools. Every registered
+    // component is written as its entity list followed by one contiguous
+    // blob of the pool storage, loading copies the blob straight back into
+    // the new pool. Components are identified by the name they were
+    // registered with, pools of components this snapshot does not know are
+    // skipped on load.
+    //
+    // Components are copied as raw bytes, so they must not own memory or
+    // hold pointers. Entity handles inside components are only valid after
+    // they went through a remap function.
+    class Snapshot
+    {
+    public:
+        static constexpr u32 format_version = 1;
+
+        Snapshot() = default;
+        ~Snapshot() = default;
+
+        template <typename Component>
+        Snapshot& component(const std::string& name);
+
+        // remap(Component&, const EntityRemap&) fixes up the entity handles
+        // of every loaded component.
+        template <typename Component, typename Remap>
+        Snapshot& component(const std::string& name, Remap&& remap);
+
+        [[nodiscard]] std::vector<u8> save(EntityManager& manager) const;
+
+        // Creates every saved entity in addition to the ones already alive
+        // and fills in their components. Nothing is created unless the whole
+        // snapshot is valid. Construction signals fire before the component
+        // values are copied in.
+        ESnapshotResult load(EntityManager& manager, const u8* data,
+                             const size_t size) const;
+
+        bool saveFile(EntityManager& manager, const std::string& path) const;
+        ESnapshotResult loadFile(EntityManager& manager,
+                                 const std::string& path) const;
+
+    private:
+        struct Pool
+        {
+            u64 type;
+            u32 size;
+            u32 alignment;
+            size_t (*count)(const entt::registry&);
+            void (*save)(const entt::registry&, entt::entity*, u8*);
+            void (*load)(entt::registry&, const entt::entity*, const size_t,
+                         const u8*);
+            std::function<void(entt::registry&, const entt::entity*,
+                               const size_t, const EntityRemap&)>
+                remap;
+        };
+
+        std::vector<Pool> _pools;
+
+        template <typename Component>
+        Snapshot& _add(const std::string& name);
+
+        static u64 _hash(const std::string& name) noexcept;
+    };
+
+    template <typename Component>
+    inline Snapshot& Snapshot::component(const std::string& name)
+    {
+        return _add<Component>(name);
+    }
+
+    template <typename Component, typename Remap>
+    inline Snapshot& Snapshot::component(const std::string& name,
+                                         Remap&& remap)
+    {
+        _add<Component>(name);
+        _pools.back().remap = [fn = std::forward<Remap>(remap)](
+                                  entt::registry& registry,
+                                  const entt::entity* entities,
+                                  const size_t count, const EntityRemap& map) {
+            for (size_t i = 0; i < count; i++)
+            {
+                fn(registry.get<Component>(entities[i]), map);
+            }
+        };
+        return *this;
+    }
+
+    template <typename Component>
+    inline Snapshot& Snapshot::_add(const std::string& name)
+    {
+        // the math types declare their own copy operators without being
+        // anything but plain data, so trivial copyability is too strict
+        static_assert(std::is_trivially_copyable_v<Component> ||
+                          (std::is_standard_layout_v<Component> &&
+                           std::is_trivially_destructible_v<Component>),
+                      "snapshot components are copied as raw bytes");
+        static_assert(!std::is_empty_v<Component>,
+                      "empty components have no storage to snapshot");
+
+        Pool pool;
+        pool.type = _hash(name);
+        pool.size = static_cast<u32>(sizeof(Component));
+        pool.alignment = static_cast<u32>(alignof(Component));
+        pool.count = [](const entt::registry& registry) {
+            return registry.size<Component>();
+        };
+        pool.save = [](const entt::registry& registry, entt::entity* entities,
+                       u8* blob) {
+            const size_t count = registry.size<Component>();
+            if (count == 0)
+            {
+                return;
+            }
+            memcpy(entities, registry.data<Component>(),
+                   count * sizeof(entt::entity));
+            memcpy(blob, registry.raw<Component>(), count * sizeof(Component));
+        };
+        pool.load = [](entt::registry& registry, const entt::entity* entities,
+                       const size_t count, const u8* blob) {
+            if (registry.sortable<Component>())
+            {
+                // insert appends to the pool in order, the values are copied
+                // over the default constructed ones in one go
+                const size_t before = registry.size<Component>();
+                registry.insert<Component>(entities, entities + count);
+                memcpy(static_cast<void*>(registry.raw<Component>() + before),
+                       blob, count * sizeof(Component));
+                return;
+            }
+
+            // owning groups move components around while they are added
+            for (size_t i = 0; i < count; i++)
+            {
+                Component& value = registry.emplace<Component>(entities[i]);
+                memcpy(static_cast<void*>(&value),
+                       blob + i * sizeof(Component), sizeof(Component));
+            }
+        };
+
+        for (const Pool& existing : _pools)
+        {
+            assert(existing.type != pool.type &&
+                   "component registered twice or name hash collision");
+        }
+        _pools.push_back(std::move(pool));
+        return *this;
+    }
+} // namespace helios
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <helios/containers/vector.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/ecs/access.hpp>
+#include <helios/ecs/entity.hpp>
+#include <helios/macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace helios
+{
+    // Runs registered systems once per frame. Each system declares the
+    // components it reads and writes, a system waits for every earlier
+    // registered system it conflicts with and runs concurrently with the
+    // rest on the job system.
+    class SystemScheduler
+    {
+    public:
+        struct Timing
+        {
+            std::string name;
+            // offset from the start of the frame and time spent in the system
+            f64 startMilliseconds;
+            f64 milliseconds;
+        };
+
+        SystemScheduler(EntityManager& manager, JobSystem& jobs);
+        ~SystemScheduler() = default;
+        HELIOS_NO_COPY_MOVE(SystemScheduler)
+
+        // fn is called as fn(EntityManager&). It may use the parallel queries
+        // of the manager as long as they stay within the declared access.
+        template <typename Reads, typename Writes = Write<>, typename Func>
+        void add(const std::string& name, Func&& fn);
+
+        void run();
+
+        // Timings of the last run, in registration order.
+        [[nodiscard]] const vector<Timing>& timings() const noexcept;
+        [[nodiscard]] f64 frameMilliseconds() const noexcept;
+
+    private:
+        struct System
+        {
+            std::string name;
+            ComponentAccess access;
+            std::function<void(EntityManager&)> fn;
+            std::vector<u32> dependents;
+            u32 dependencyCount;
+        };
+
+        EntityManager& _manager;
+        JobSystem& _jobs;
+        std::vector<System> _systems;
+        std::unique_ptr<std::atomic<u32>[]> _waiting;
+        vector<Timing> _timings;
+        f64 _frameMilliseconds;
+        bool _graphChanged;
+
+        void _add(const std::string& name, ComponentAccess access,
+                  std::function<void(EntityManager&)> fn);
+        void _buildGraph();
+        void _schedule(const u32 index, std::atomic<size_t>& remaining,
+                       const std::chrono::steady_clock::time_point frameStart);
+    };
+
+    template <typename Reads, typename Writes, typename Func>
+    inline void SystemScheduler::add(const std::string& name, Func&& fn)
+    {
+        _add(name, ComponentAccess::of(Reads{}, Writes{}),
+             std::forward<Func>(fn));
+    }
+} // namespace helios
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <helios/containers/span.hpp>
+#include <helios/macros.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace helios
+{
+    enum class EReadStatus : u32
+    {
+        QUEUED,
+        READING,
+        COMPLETE,
+        FAILED,
+        CANCELLED
+    };
+
+    enum class EReadPriority : u32
+    {
+        LOW,
+        NORMAL,
+        HIGH
+    };
+
+    namespace detail
+    {
+        struct ReadState;
+    }
+
+    // Handle to a read submitted to an AsyncFileReader. Copies share the
+    // same read, the bytes stay alive as long as any copy does.
+    class ReadHandle
+    {
+        friend class AsyncFileReader;
+
+    public:
+        ReadHandle() = default;
+
+        [[nodiscard]] bool valid() const noexcept;
+        [[nodiscard]] EReadStatus status() const noexcept;
+
+        // Complete, failed or cancelled.
+        [[nodiscard]] bool done() const noexcept;
+
+        // Blocks until the read is done and returns how it ended.
+        EReadStatus wait() const;
+
+        // The bytes read, empty until the read completed.
+        [[nodiscard]] span<const u8> data() const noexcept;
+
+        // Moves the bytes out of a completed read.
+        std::vector<u8> take();
+
+        // Returns true if the read was still queued and is now cancelled,
+        // its callback has then already run on the calling thread. Reads
+        // already in flight finish as cancelled on the I/O thread once their
+        // I/O returns and drop what they read.
+        bool cancel();
+
+    private:
+        std::shared_ptr<detail::ReadState> _state;
+
+        explicit ReadHandle(std::shared_ptr<detail::ReadState> state);
+    };
+
+    // Reads whole files or ranges of them off the calling thread. On Linux
+    // reads are batched into an io_uring and completed by a single thread,
+    // elsewhere or when the kernel refuses to create a ring a pool of
+    // threads runs blocking reads. Queued reads are started highest
+    // priority first and in submission order within a priority.
+    //
+    // Completion callbacks run on the I/O thread before waiters are woken,
+    // they should hand the bytes off instead of parsing them in place. Reads
+    // cancelled while still queued are the exception, their callback runs on
+    // the thread that cancelled them, inside ReadHandle::cancel or the
+    // destructor of the reader.
+    class AsyncFileReader
+    {
+    public:
+        enum class EBackend : u32
+        {
+            IO_URING,
+            THREAD_POOL
+        };
+
+        struct Settings
+        {
+            EBackend backend = EBackend::IO_URING;
+            // io_uring entries, the number of reads in flight at once
+            u32 queueDepth = 64;
+            // worker count of the thread pool backend
+            u32 threads = 2;
+        };
+
+        using Callback = std::function<void(EReadStatus, std::vector<u8>&)>;
+
+        // reads to the end of the file
+        static constexpr u64 to_end = ~u64(0);
+
+        AsyncFileReader();
+        explicit AsyncFileReader(const Settings& settings);
+
+        // Cancels everything still queued, running their callbacks on this
+        // thread, and waits for reads in flight.
+        ~AsyncFileReader();
+        HELIOS_NO_COPY_MOVE(AsyncFileReader)
+
+        [[nodiscard]] EBackend backend() const noexcept;
+
+        ReadHandle read(const std::string& path,
+                        const EReadPriority priority = EReadPriority::NORMAL,
+                        Callback callback = {});
+
+        // Reads up to size bytes starting at offset, short when the file
+        // ends first.
+        ReadHandle read(const std::string& path, const u64 offset,
+                        const u64 size,
+                        const EReadPriority priority = EReadPriority::NORMAL,
+                        Callback callback = {});
+
+        // Queues every path with one wakeup of the I/O thread.
+        std::vector<ReadHandle> readBatch(
+            const std::vector<std::string>& paths,
+            const EReadPriority priority = EReadPriority::NORMAL);
+
+        // Reads queued or in flight.
+        [[nodiscard]] size_t pending() const noexcept;
+
+    private:
+        struct Ring;
+
+        EBackend _backend;
+        std::unique_ptr<Ring> _ring;
+        std::vector<std::thread> _threads;
+
+        // binary heap ordered by priority, then submission order
+        std::vector<std::shared_ptr<detail::ReadState>> _queue;
+        mutable std::mutex _mutex;
+        std::condition_variable _available;
+        std::atomic<size_t> _pending;
+        u64 _sequence;
+        bool _stopping;
+
+        void _enqueue(const std::shared_ptr<detail::ReadState>* states,
+                      const size_t count);
+        std::shared_ptr<detail::ReadState> _pop();
+        void _wake();
+
+        void _work();
+        void _runRing();
+    };
+} // namespace helios
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <helios/macros.hpp>
+#include <helios/containers/span.hpp>
 #include <helios/containers/vector.hpp>
 
+#include <cstdio>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace helios
 {
@@ -12,5 +16,79 @@ namespace helios
     public:
         static vector<uint8_t> read_binary(const std::string& filepath);
         static std::string read_text(const std::string& filepath);
+        static bool write_binary(const std::string& filepath, const uint8_t* data,
+                                 const size_t size);
     };
-} // namespace helios
\ No newline at end of file
+
+    // Access pattern hint passed to the kernel for a mapping.
+    enum class EFileAccess
+    {
+        SEQUENTIAL,
+        RANDOM,
+        // read ahead the whole file right away
+        WILL_NEED
+    };
+
+    // Read-only mapping of a whole file. The bytes are paged in on first
+    // touch and stay valid until the MappedFile is destroyed, so loaders can
+    // parse them in place instead of copying the file into a buffer first.
+    // Empty files map to a valid, empty span.
+    class MappedFile
+    {
+    public:
+        MappedFile() noexcept;
+        explicit MappedFile(const std::string& filepath,
+                            const EFileAccess access = EFileAccess::SEQUENTIAL);
+        ~MappedFile();
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        HELIOS_NO_COPY(MappedFile)
+
+        [[nodiscard]] bool valid() const noexcept;
+        explicit operator bool() const noexcept;
+        [[nodiscard]] size_t size() const noexcept;
+        [[nodiscard]] span<const u8> bytes() const noexcept;
+        [[nodiscard]] std::string_view text() const noexcept;
+
+        // Asks the kernel to start paging in [offset, offset + size).
+        void prefetch(const size_t offset, const size_t size) const noexcept;
+
+    private:
+        const u8* _data;
+        size_t _size;
+        bool _valid;
+#if defined(HELIOS_PLATFORM_WINDOWS)
+        void* _file;
+        void* _mapping;
+#endif
+
+        void _close() noexcept;
+    };
+
+    // Reads a file front to back in fixed size chunks through one reusable
+    // buffer, for files too large to map or consumed as a stream.
+    class FileChunkReader
+    {
+    public:
+        static constexpr size_t default_chunk_size = 1 << 20;
+
+        explicit FileChunkReader(const std::string& filepath,
+                                 const size_t chunkSize = default_chunk_size);
+        ~FileChunkReader();
+        HELIOS_NO_COPY_MOVE(FileChunkReader)
+
+        [[nodiscard]] bool valid() const noexcept;
+        [[nodiscard]] u64 size() const noexcept;
+        [[nodiscard]] u64 offset() const noexcept;
+
+        // Next chunk of the file, empty once the end was reached. Only valid
+        // until the next call.
+        span<const u8> next();
+
+    private:
+        std::FILE* _file;
+        std::vector<u8> _buffer;
+        u64 _size;
+        u64 _offset;
+    };
+} // namespace helios
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <helios/containers/span.hpp>
+#include <helios/io/file.hpp>
+#include <helios/macros.hpp>
+
+#include <string>
+#include <vector>
+
+namespace helios
+{
+    class JobSystem;
+
+    struct ImageInfo
+    {
+        u32 width = 0;
+        u32 height = 0;
+    };
+
+    // Reads the size of an encoded image from its header.
+    bool readImageInfo(const span<const u8> bytes, ImageInfo& info) noexcept;
+
+    // Decodes an image into RGBA8 rows packed tightly into pixels, which
+    // must hold width * height * 4 bytes, bottom row first when flipped.
+    // PNG goes through the built in decoder, which inflates with
+    // helios::inflate and unfilters with SSE2, straight into pixels.
+    // Interlaced PNG and every other format stb_image reads are decoded by
+    // stb_image and copied in.
+    bool decodeImage(const span<const u8> bytes, u8* pixels,
+                     const bool flipVertically = false);
+
+    // Decodes a batch of images concurrently on a job system into one
+    // caller owned block of memory, usually a mapped staging buffer, so the
+    // pixels are written once and never copied on the CPU. Images are added
+    // first, which maps the files and reads their headers, then the caller
+    // allocates size() bytes and decodes every image to its offset.
+    class ImageDecoder
+    {
+    public:
+        // every image starts on a multiple of this, which satisfies the
+        // buffer offset rules of buffer to image copies
+        static constexpr u64 image_alignment = 16;
+
+        explicit ImageDecoder(JobSystem* jobs = nullptr);
+        ~ImageDecoder() = default;
+        HELIOS_NO_COPY_MOVE(ImageDecoder)
+
+        // Maps the file and reads its header. Images that cannot be read
+        // keep their index but take no space and never decode.
+        u32 add(const std::string& path, const bool flipVertically = false);
+
+        // An image already in memory. The bytes must outlive the decode.
+        u32 add(const span<const u8> bytes, const bool flipVertically = false);
+
+        [[nodiscard]] u32 imageCount() const noexcept;
+        [[nodiscard]] bool valid(const u32 index) const noexcept;
+        [[nodiscard]] const ImageInfo& info(const u32 index) const noexcept;
+        [[nodiscard]] u64 offset(const u32 index) const noexcept;
+
+        // Bytes decode() writes, every image included.
+        [[nodiscard]] u64 size() const noexcept;
+
+        // Decodes every image to destination + offset(i), one job per image.
+        // Returns whether all of them decoded.
+        bool decode(u8* destination);
+
+        // Whether the image decoded in the last decode().
+        [[nodiscard]] bool decoded(const u32 index) const noexcept;
+
+        void clear();
+
+    private:
+        struct Image
+        {
+            MappedFile file;
+            span<const u8> bytes;
+            ImageInfo info;
+            u64 offset;
+            bool flip;
+            bool valid;
+            bool decoded;
+        };
+
+        JobSystem* _jobs;
+        std::vector<Image> _images;
+        u64 _size = 0;
+
+        u32 _add(Image&& image);
+    };
+} // namespace helios
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <helios/containers/span.hpp>
+#include <helios/macros.hpp>
+
+#include <cstddef>
+
+namespace helios
+{
+    // Returned by the inflate functions when the stream is malformed, ends
+    // early or does not fit the output.
+    constexpr size_t inflate_error = ~size_t(0);
+
+    // Decompresses a raw DEFLATE stream (RFC 1951) into output and returns
+    // the number of bytes written. Decoding refills a 64 bit bit buffer once
+    // per symbol, resolves codes through one table lookup and copies matches
+    // a word at a time, so output is fastest when capacity leaves a few
+    // bytes of slack past the decompressed size.
+    size_t inflate(const span<const u8> input, u8* output,
+                   const size_t capacity) noexcept;
+
+    // Decompresses a zlib stream (RFC 1950), the wrapper PNG uses. The
+    // trailing checksum is not verified.
+    size_t inflateZlib(const span<const u8> input, u8* output,
+                       const size_t capacity) noexcept;
+} // namespace helios
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <helios/containers/optional.hpp>
+#include <helios/containers/span.hpp>
 #include <helios/containers/utility.hpp>
 #include <helios/containers/vector.hpp>
 #include <helios/core/window.hpp>
@@ -558,6 +559,10 @@ namespace helios
 
         ShaderModuleBuilder& device(const IDevice* device);
         ShaderModuleBuilder& source(const vector<u8>& source);
+
+        // Uses the bytes in place, they have to stay alive until build and
+        // be 4 byte aligned like SPIR-V words, e.g. a MappedFile.
+        ShaderModuleBuilder& source(const span<const u8> source);
         [[nodiscard]] IShaderModule* build() const;
 
         HELIOS_NO_COPY_MOVE(ShaderModuleBuilder)
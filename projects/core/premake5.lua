@@ -48,6 +48,8 @@ project "core"
         "MultiProcessorCompile"
     }
 
+    vectorextensions "AVX2"
+
     filter "system:windows"
         toolset "msc-ClangCL"
         systemversion "latest"
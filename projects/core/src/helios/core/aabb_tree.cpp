@@ -0,0 +1,495 @@
+#include <helios/core/aabb_tree.hpp>
+
+#include <algorithm>
+
+namespace helios
+{
+    // below these sizes the job overhead outweighs the work
+    static constexpr size_t parallel_refit_leaves = 16 * 1024;
+    static constexpr u32 parallel_build_leaves = 8 * 1024;
+
+    static AABB merge(const AABB& lhs, const AABB& rhs) noexcept
+    {
+        AABB result = lhs;
+        result.expand(rhs);
+        return result;
+    }
+
+    DynamicAABBTree::DynamicAABBTree(const f32 margin)
+        : _root(null_node), _free(null_node), _leafCount(0), _margin(margin),
+          _refitPending(false)
+    {
+    }
+
+    u32 DynamicAABBTree::insert(const AABB& box, const u32 userData)
+    {
+        const u32 leaf = _allocate();
+        Node& node = _nodes[leaf];
+        node.box = AABB(box.min - Vector3f(_margin), box.max + Vector3f(_margin));
+        node.left = null_node;
+        node.right = null_node;
+        node.userData = userData;
+        node.height = 0;
+
+        _insertLeaf(leaf);
+        ++_leafCount;
+        return leaf;
+    }
+
+    void DynamicAABBTree::remove(const u32 proxy)
+    {
+        _removeLeaf(proxy);
+        _release(proxy);
+        --_leafCount;
+    }
+
+    bool DynamicAABBTree::move(const u32 proxy, const AABB& box)
+    {
+        if (_nodes[proxy].box.contains(box))
+        {
+            return false;
+        }
+
+        _removeLeaf(proxy);
+        _nodes[proxy].box =
+            AABB(box.min - Vector3f(_margin), box.max + Vector3f(_margin));
+        _insertLeaf(proxy);
+        return true;
+    }
+
+    bool DynamicAABBTree::setBounds(const u32 proxy, const AABB& box) noexcept
+    {
+        Node& node = _nodes[proxy];
+        if (node.box.contains(box))
+        {
+            return false;
+        }
+
+        node.box =
+            AABB(box.min - Vector3f(_margin), box.max + Vector3f(_margin));
+        _refitPending.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    void DynamicAABBTree::refit(JobSystem* jobs)
+    {
+        if (!_refitPending.exchange(false) || _root == null_node)
+        {
+            return;
+        }
+
+        if (jobs == nullptr || jobs->workerCount() == 0 ||
+            _leafCount < parallel_refit_leaves)
+        {
+            _refitSubtree(_root);
+            return;
+        }
+
+        // split the top of the tree into enough subtrees to keep every
+        // worker busy, refit those in parallel and the nodes above them last
+        const size_t target = static_cast<size_t>(jobs->workerCount()) * 8;
+        std::vector<u32> above;
+        std::vector<u32> frontier(1, _root);
+        std::vector<u32> next;
+        while (frontier.size() < target)
+        {
+            next.clear();
+            bool expanded = false;
+            for (const u32 index : frontier)
+            {
+                const Node& node = _nodes[index];
+                if (node.leaf())
+                {
+                    next.push_back(index);
+                }
+                else
+                {
+                    above.push_back(index);
+                    next.push_back(node.left);
+                    next.push_back(node.right);
+                    expanded = true;
+                }
+            }
+            frontier.swap(next);
+            if (!expanded)
+            {
+                break;
+            }
+        }
+
+        jobs->parallelFor(frontier.size(), 1,
+                          [this, &frontier](size_t begin, size_t end) {
+                              for (size_t i = begin; i < end; ++i)
+                              {
+                                  _refitSubtree(frontier[i]);
+                              }
+                          });
+
+        // breadth first order reversed puts children before their parents
+        for (auto it = above.rbegin(); it != above.rend(); ++it)
+        {
+            Node& node = _nodes[*it];
+            node.box = merge(_nodes[node.left].box, _nodes[node.right].box);
+        }
+    }
+
+    void DynamicAABBTree::rebuild(JobSystem* jobs)
+    {
+        _refitPending.store(false, std::memory_order_relaxed);
+        if (_leafCount < 2)
+        {
+            return;
+        }
+
+        std::vector<u32> leaves;
+        std::vector<u32> internal;
+        leaves.reserve(_leafCount);
+        internal.reserve(_leafCount - 1);
+        for (u32 i = 0; i < static_cast<u32>(_nodes.size()); ++i)
+        {
+            const Node& node = _nodes[i];
+            if (node.height < 0)
+            {
+                continue;
+            }
+            (node.leaf() ? leaves : internal).push_back(i);
+        }
+
+        // a full binary tree over n leaves has n - 1 internal nodes, the one
+        // splitting the leaves before and after position m reuses
+        // internal[m - 1], so both halves can be built independently
+        if (jobs != nullptr && jobs->workerCount() == 0)
+        {
+            jobs = nullptr;
+        }
+        _root = _build(leaves.data(), static_cast<u32>(leaves.size()), 0,
+                       internal.data(), jobs);
+        _nodes[_root].parent = null_node;
+    }
+
+    f32 DynamicAABBTree::cost() const noexcept
+    {
+        if (_root == null_node)
+        {
+            return 0.0f;
+        }
+
+        f32 area = 0.0f;
+        for (const Node& node : _nodes)
+        {
+            if (node.height > 0)
+            {
+                area += node.box.surfaceArea();
+            }
+        }
+
+        const f32 rootArea = _nodes[_root].box.surfaceArea();
+        return rootArea > 0.0f ? area / rootArea : 0.0f;
+    }
+
+    size_t DynamicAABBTree::size() const noexcept
+    {
+        return _leafCount;
+    }
+
+    u32 DynamicAABBTree::height() const noexcept
+    {
+        return _root == null_node ? 0
+                                  : static_cast<u32>(_nodes[_root].height);
+    }
+
+    const AABB& DynamicAABBTree::fatBounds(const u32 proxy) const noexcept
+    {
+        return _nodes[proxy].box;
+    }
+
+    u32 DynamicAABBTree::userData(const u32 proxy) const noexcept
+    {
+        return _nodes[proxy].userData;
+    }
+
+    u32 DynamicAABBTree::_allocate()
+    {
+        if (_free == null_node)
+        {
+            _nodes.emplace_back();
+            return static_cast<u32>(_nodes.size() - 1);
+        }
+
+        const u32 node = _free;
+        _free = _nodes[node].parent;
+        return node;
+    }
+
+    void DynamicAABBTree::_release(const u32 node)
+    {
+        _nodes[node].parent = _free;
+        _nodes[node].height = -1;
+        _free = node;
+    }
+
+    void DynamicAABBTree::_insertLeaf(const u32 leaf)
+    {
+        if (_root == null_node)
+        {
+            _root = leaf;
+            _nodes[leaf].parent = null_node;
+            return;
+        }
+
+        // walk down towards the sibling that increases the surface area of
+        // the tree the least, every node passed on the way grows to enclose
+        // the leaf which is the inherited cost
+        const AABB box = _nodes[leaf].box;
+        u32 index = _root;
+        while (!_nodes[index].leaf())
+        {
+            const Node& node = _nodes[index];
+            const f32 area = node.box.surfaceArea();
+            const f32 combinedArea = merge(node.box, box).surfaceArea();
+
+            const f32 pairCost = 2.0f * combinedArea;
+            const f32 inherited = 2.0f * (combinedArea - area);
+
+            const auto descendCost = [&](const u32 child) {
+                const AABB& childBox = _nodes[child].box;
+                const f32 grown = merge(childBox, box).surfaceArea();
+                return _nodes[child].leaf()
+                           ? grown + inherited
+                           : grown - childBox.surfaceArea() + inherited;
+            };
+            const f32 leftCost = descendCost(node.left);
+            const f32 rightCost = descendCost(node.right);
+
+            if (pairCost < leftCost && pairCost < rightCost)
+            {
+                break;
+            }
+            index = leftCost < rightCost ? node.left : node.right;
+        }
+
+        const u32 sibling = index;
+        const u32 oldParent = _nodes[sibling].parent;
+        const u32 parent = _allocate();
+
+        Node& created = _nodes[parent];
+        created.parent = oldParent;
+        created.box = merge(box, _nodes[sibling].box);
+        created.left = sibling;
+        created.right = leaf;
+        created.userData = 0;
+        created.height = _nodes[sibling].height + 1;
+        _nodes[sibling].parent = parent;
+        _nodes[leaf].parent = parent;
+
+        if (oldParent == null_node)
+        {
+            _root = parent;
+        }
+        else if (_nodes[oldParent].left == sibling)
+        {
+            _nodes[oldParent].left = parent;
+        }
+        else
+        {
+            _nodes[oldParent].right = parent;
+        }
+
+        _fixUpwards(_nodes[leaf].parent);
+    }
+
+    void DynamicAABBTree::_removeLeaf(const u32 leaf)
+    {
+        if (leaf == _root)
+        {
+            _root = null_node;
+            return;
+        }
+
+        const u32 parent = _nodes[leaf].parent;
+        const u32 grandParent = _nodes[parent].parent;
+        const u32 sibling = _nodes[parent].left == leaf
+                                ? _nodes[parent].right
+                                : _nodes[parent].left;
+
+        _release(parent);
+        _nodes[sibling].parent = grandParent;
+        if (grandParent == null_node)
+        {
+            _root = sibling;
+            return;
+        }
+
+        if (_nodes[grandParent].left == parent)
+        {
+            _nodes[grandParent].left = sibling;
+        }
+        else
+        {
+            _nodes[grandParent].right = sibling;
+        }
+        _fixUpwards(grandParent);
+    }
+
+    void DynamicAABBTree::_fixUpwards(u32 node)
+    {
+        while (node != null_node)
+        {
+            node = _balance(node);
+
+            Node& current = _nodes[node];
+            const Node& left = _nodes[current.left];
+            const Node& right = _nodes[current.right];
+            current.height = 1 + std::max(left.height, right.height);
+            current.box = merge(left.box, right.box);
+            node = current.parent;
+        }
+    }
+
+    u32 DynamicAABBTree::_balance(const u32 a)
+    {
+        Node& nodeA = _nodes[a];
+        if (nodeA.leaf() || nodeA.height < 2)
+        {
+            return a;
+        }
+
+        const u32 b = nodeA.left;
+        const u32 c = nodeA.right;
+        const i32 balance = _nodes[c].height - _nodes[b].height;
+
+        // promotes child up into the place of a, a keeps the other child and
+        // takes the shorter grandchild, up keeps the taller one
+        const auto rotate = [&](const u32 up, const u32 other) {
+            Node& nodeUp = _nodes[up];
+            const u32 f = nodeUp.left;
+            const u32 g = nodeUp.right;
+
+            nodeUp.left = a;
+            nodeUp.parent = nodeA.parent;
+            nodeA.parent = up;
+
+            if (nodeUp.parent == null_node)
+            {
+                _root = up;
+            }
+            else if (_nodes[nodeUp.parent].left == a)
+            {
+                _nodes[nodeUp.parent].left = up;
+            }
+            else
+            {
+                _nodes[nodeUp.parent].right = up;
+            }
+
+            const bool keepF = _nodes[f].height > _nodes[g].height;
+            const u32 kept = keepF ? f : g;
+            const u32 given = keepF ? g : f;
+
+            nodeUp.right = kept;
+            if (up == c)
+            {
+                nodeA.right = given;
+            }
+            else
+            {
+                nodeA.left = given;
+            }
+            _nodes[given].parent = a;
+
+            nodeA.box = merge(_nodes[other].box, _nodes[given].box);
+            nodeA.height =
+                1 + std::max(_nodes[other].height, _nodes[given].height);
+            nodeUp.box = merge(nodeA.box, _nodes[kept].box);
+            nodeUp.height = 1 + std::max(nodeA.height, _nodes[kept].height);
+            return up;
+        };
+
+        if (balance > 1)
+        {
+            return rotate(c, b);
+        }
+        if (balance < -1)
+        {
+            return rotate(b, c);
+        }
+        return a;
+    }
+
+    void DynamicAABBTree::_refitSubtree(const u32 index)
+    {
+        Node& node = _nodes[index];
+        if (node.leaf())
+        {
+            return;
+        }
+
+        _refitSubtree(node.left);
+        _refitSubtree(node.right);
+        node.box = merge(_nodes[node.left].box, _nodes[node.right].box);
+    }
+
+    u32 DynamicAABBTree::_build(u32* leaves, const u32 count, const u32 offset,
+                                const u32* internal, JobSystem* jobs)
+    {
+        if (count == 1)
+        {
+            return leaves[offset];
+        }
+
+        AABB centroids;
+        for (u32 i = offset; i < offset + count; ++i)
+        {
+            centroids.expand(_nodes[leaves[i]].box.center());
+        }
+        const Vector3f extent = centroids.size();
+        const u32 axis = extent.x >= extent.y && extent.x >= extent.z ? 0
+                         : extent.y >= extent.z                       ? 1
+                                                                      : 2;
+
+        const u32 half = count / 2;
+        std::nth_element(leaves + offset, leaves + offset + half,
+                         leaves + offset + count,
+                         [this, axis](const u32 lhs, const u32 rhs) {
+                             const Node& l = _nodes[lhs];
+                             const Node& r = _nodes[rhs];
+                             return l.box.min.data[axis] + l.box.max.data[axis] <
+                                    r.box.min.data[axis] + r.box.max.data[axis];
+                         });
+
+        u32 children[2];
+        const auto buildHalf = [&](const size_t side) {
+            children[side] =
+                side == 0 ? _build(leaves, half, offset, internal, jobs)
+                          : _build(leaves, count - half, offset + half,
+                                   internal, jobs);
+        };
+
+        if (jobs != nullptr && count >= parallel_build_leaves)
+        {
+            jobs->parallelFor(2, 1, [&buildHalf](size_t begin, size_t end) {
+                for (size_t side = begin; side < end; ++side)
+                {
+                    buildHalf(side);
+                }
+            });
+        }
+        else
+        {
+            buildHalf(0);
+            buildHalf(1);
+        }
+
+        const u32 index = internal[offset + half - 1];
+        Node& node = _nodes[index];
+        node.left = children[0];
+        node.right = children[1];
+        node.userData = 0;
+        node.height = 1 + std::max(_nodes[children[0]].height,
+                                   _nodes[children[1]].height);
+        node.box = merge(_nodes[children[0]].box, _nodes[children[1]].box);
+        _nodes[children[0]].parent = index;
+        _nodes[children[1]].parent = index;
+        return index;
+    }
+} // namespace helios
@@ -4,13 +4,76 @@
 
 namespace helios
 {
-    Application::Application()
+    Application::Application() : _loop(nullptr)
+    {
+        EngineContext& ctx = EngineContextFactory().create();
+        _jobs = &ctx.jobs();
+        _systems = &ctx.systems();
+        _window = &ctx.window();
+    }
+
+    Application::Application(JobSystem& jobs, SystemScheduler& systems)
+        : _jobs(&jobs), _systems(&systems), _window(nullptr), _loop(nullptr)
     {
-        EngineContextFactory().create();
     }
 
     Application::~Application()
     {
-        EngineContextFactory().release();
+        // only the engine owned application created the context
+        if (_window != nullptr)
+        {
+            EngineContextFactory().release();
+        }
+    }
+
+    void Application::run(const FrameLoop::Settings& settings)
+    {
+        FrameLoop loop(*_jobs, settings);
+        loop.onInput([this]() { return input(); });
+        loop.onSimulate([this](const f64 step) { simulate(step); });
+        loop.onExtract([this](const f64 alpha) { extract(alpha); });
+        loop.onRender([this](const f64 alpha) { render(alpha); });
+
+        _loop = &loop;
+        loop.run();
+        _timings = loop.timings();
+        _loop = nullptr;
+    }
+
+    void Application::stop() noexcept
+    {
+        if (_loop != nullptr)
+        {
+            _loop->stop();
+        }
+    }
+
+    bool Application::input()
+    {
+        if (_window == nullptr)
+        {
+            return true;
+        }
+
+        _window->poll();
+        return !_window->shouldClose();
+    }
+
+    void Application::simulate(f64)
+    {
+        _systems->run();
+    }
+
+    void Application::extract(f64)
+    {
+    }
+
+    void Application::render(f64)
+    {
+    }
+
+    const FrameLoop::Timings& Application::frameTimings() const noexcept
+    {
+        return _loop != nullptr ? _loop->timings() : _timings;
     }
-}
\ No newline at end of file
+}
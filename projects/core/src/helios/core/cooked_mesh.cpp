@@ -0,0 +1,274 @@
+#include <helios/core/cooked_mesh.hpp>
+
+#include <cstring>
+
+namespace helios
+{
+    static constexpr u32 cooked_mesh_magic = 0x48534D48; // "HMSH"
+
+    // blobs start on a cache line, which also covers any vertex attribute
+    // or index alignment the device asks for
+    static constexpr u64 cooked_blob_alignment = 64;
+
+    struct CookedBounds
+    {
+        f32 min[3];
+        f32 max[3];
+        f32 sphere[4];
+    };
+
+    struct CookedMeshHeader
+    {
+        u32 magic;
+        u32 version;
+        u32 format;
+        u32 subMeshes;
+        u64 size;
+        CookedBounds bounds;
+    };
+
+    struct CookedSubMeshEntry
+    {
+        u32 vertexCount;
+        u32 indexCount;
+        u64 positionOffset;
+        u64 positionSize;
+        u64 attributeOffset;
+        u64 attributeSize;
+        u64 indexOffset;
+        u64 indexSize;
+        CookedBounds bounds;
+    };
+
+    static u64 align_blob(const u64 offset)
+    {
+        return (offset + cooked_blob_alignment - 1) &
+               ~(cooked_blob_alignment - 1);
+    }
+
+    static CookedBounds write_bounds(const AABB& box,
+                                     const BoundingSphere& sphere)
+    {
+        return CookedBounds{
+            {box.min.x, box.min.y, box.min.z},
+            {box.max.x, box.max.y, box.max.z},
+            {sphere.center.x, sphere.center.y, sphere.center.z, sphere.radius}};
+    }
+
+    static void read_bounds(const CookedBounds& bounds, AABB& box,
+                            BoundingSphere& sphere)
+    {
+        box = AABB(Vector3f(bounds.min[0], bounds.min[1], bounds.min[2]),
+                   Vector3f(bounds.max[0], bounds.max[1], bounds.max[2]));
+        sphere = BoundingSphere(
+            Vector3f(bounds.sphere[0], bounds.sphere[1], bounds.sphere[2]),
+            bounds.sphere[3]);
+    }
+
+    // the blob lies inside the file and its end does not overflow
+    static bool blob_in_range(const u64 offset, const u64 size,
+                              const u64 fileSize)
+    {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+
+    CookedMesh::CookedMesh(const std::string& path)
+        : _file(path, EFileAccess::WILL_NEED)
+    {
+        if (_file.valid())
+        {
+            _parse(_file.bytes());
+        }
+    }
+
+    CookedMesh::CookedMesh(const span<const u8> bytes)
+    {
+        _parse(bytes);
+    }
+
+    bool CookedMesh::valid() const noexcept
+    {
+        return _valid;
+    }
+
+    EVertexFormat CookedMesh::vertexFormat() const noexcept
+    {
+        return _format;
+    }
+
+    const AABB& CookedMesh::bounds() const noexcept
+    {
+        return _bounds;
+    }
+
+    const BoundingSphere& CookedMesh::boundingSphere() const noexcept
+    {
+        return _boundingSphere;
+    }
+
+    u32 CookedMesh::subMeshCount() const noexcept
+    {
+        return static_cast<u32>(_subMeshes.size());
+    }
+
+    const CookedMesh::SubMesh& CookedMesh::subMesh(
+        const u32 index) const noexcept
+    {
+        return _subMeshes[index];
+    }
+
+    std::vector<u8> CookedMesh::cook(const Mesh& mesh)
+    {
+        vector<const Mesh*> sources;
+        if (mesh.bufferCount() >= 2)
+        {
+            sources.push_back(&mesh);
+        }
+        for (const Mesh* subMesh : mesh.subMeshes)
+        {
+            if (subMesh->bufferCount() >= 2)
+            {
+                sources.push_back(subMesh);
+            }
+        }
+
+        const EVertexFormat format =
+            sources.empty() ? EVertexFormat::FULL : sources[0]->vertexFormat();
+
+        std::vector<CookedSubMeshEntry> entries(sources.size());
+        u64 offset = sizeof(CookedMeshHeader) +
+                     sources.size() * sizeof(CookedSubMeshEntry);
+        for (size_t i = 0; i < sources.size(); i++)
+        {
+            const Mesh& source = *sources[i];
+            CookedSubMeshEntry& entry = entries[i];
+
+            entry.vertexCount = static_cast<u32>(source.positions.size());
+            entry.indexCount = static_cast<u32>(source.triangles.size());
+            entry.bounds =
+                write_bounds(source.bounds, source.boundingSphere);
+
+            entry.positionOffset = align_blob(offset);
+            entry.positionSize = source.bufferSize(0);
+            entry.attributeOffset =
+                align_blob(entry.positionOffset + entry.positionSize);
+            entry.attributeSize = source.bufferSize(1);
+            entry.indexOffset =
+                align_blob(entry.attributeOffset + entry.attributeSize);
+            entry.indexSize = entry.indexCount * sizeof(u32);
+            offset = entry.indexOffset + entry.indexSize;
+        }
+
+        std::vector<u8> data(static_cast<size_t>(offset));
+
+        CookedMeshHeader header;
+        header.magic = cooked_mesh_magic;
+        header.version = format_version;
+        header.format = static_cast<u32>(format);
+        header.subMeshes = static_cast<u32>(sources.size());
+        header.size = offset;
+        header.bounds = write_bounds(mesh.bounds, mesh.boundingSphere);
+        memcpy(data.data(), &header, sizeof(header));
+        if (!entries.empty())
+        {
+            memcpy(data.data() + sizeof(header), entries.data(),
+                   entries.size() * sizeof(CookedSubMeshEntry));
+        }
+
+        for (size_t i = 0; i < sources.size(); i++)
+        {
+            const Mesh& source = *sources[i];
+            const CookedSubMeshEntry& entry = entries[i];
+            if (entry.positionSize > 0)
+            {
+                memcpy(data.data() + entry.positionOffset,
+                       source.readBuffer(0), entry.positionSize);
+            }
+            if (entry.attributeSize > 0)
+            {
+                memcpy(data.data() + entry.attributeOffset,
+                       source.readBuffer(1), entry.attributeSize);
+            }
+            if (entry.indexSize > 0)
+            {
+                memcpy(data.data() + entry.indexOffset,
+                       source.triangles.data(), entry.indexSize);
+            }
+        }
+
+        return data;
+    }
+
+    void CookedMesh::_parse(const span<const u8> bytes)
+    {
+        if (bytes.size() < sizeof(CookedMeshHeader))
+        {
+            return;
+        }
+
+        CookedMeshHeader header;
+        memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic != cooked_mesh_magic ||
+            header.version != format_version ||
+            header.format > static_cast<u32>(EVertexFormat::PACKED) ||
+            header.size != bytes.size())
+        {
+            return;
+        }
+
+        const u64 size = bytes.size();
+        const u64 tableSize =
+            static_cast<u64>(header.subMeshes) * sizeof(CookedSubMeshEntry);
+        if (!blob_in_range(sizeof(CookedMeshHeader), tableSize, size))
+        {
+            return;
+        }
+
+        const u64 positionStride = sizeof(Vector3fView);
+        const u64 attributeStride =
+            header.format == static_cast<u32>(EVertexFormat::PACKED)
+                ? sizeof(PackedVertexNoPosition)
+                : sizeof(VertexNoPosition);
+
+        std::vector<SubMesh> subMeshes(header.subMeshes);
+        for (u32 i = 0; i < header.subMeshes; i++)
+        {
+            CookedSubMeshEntry entry;
+            memcpy(&entry,
+                   bytes.data() + sizeof(CookedMeshHeader) +
+                       i * sizeof(CookedSubMeshEntry),
+                   sizeof(entry));
+
+            if (entry.positionSize != entry.vertexCount * positionStride ||
+                entry.attributeSize != entry.vertexCount * attributeStride ||
+                entry.indexSize != entry.indexCount * sizeof(u32) ||
+                !blob_in_range(entry.positionOffset, entry.positionSize,
+                               size) ||
+                !blob_in_range(entry.attributeOffset, entry.attributeSize,
+                               size) ||
+                !blob_in_range(entry.indexOffset, entry.indexSize, size))
+            {
+                return;
+            }
+
+            SubMesh& subMesh = subMeshes[i];
+            subMesh.vertexCount = entry.vertexCount;
+            subMesh.indexCount = entry.indexCount;
+            subMesh.positions =
+                bytes.subspan(static_cast<size_t>(entry.positionOffset),
+                              static_cast<size_t>(entry.positionSize));
+            subMesh.attributes =
+                bytes.subspan(static_cast<size_t>(entry.attributeOffset),
+                              static_cast<size_t>(entry.attributeSize));
+            subMesh.indices =
+                bytes.subspan(static_cast<size_t>(entry.indexOffset),
+                              static_cast<size_t>(entry.indexSize));
+            read_bounds(entry.bounds, subMesh.bounds, subMesh.boundingSphere);
+        }
+
+        _subMeshes = std::move(subMeshes);
+        _format = static_cast<EVertexFormat>(header.format);
+        read_bounds(header.bounds, _bounds, _boundingSphere);
+        _valid = true;
+    }
+} // namespace helios
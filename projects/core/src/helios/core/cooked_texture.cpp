@@ -0,0 +1,573 @@
+#include <helios/core/cooked_texture.hpp>
+
+#include <helios/core/job_system.hpp>
+#include <helios/math/block_compression.hpp>
+
+#include <cmath>
+#include <cstring>
+
+namespace helios
+{
+    static constexpr u32 cooked_texture_magic = 0x58455448; // "HTEX"
+
+    // the first level starts on a cache line, every level on a multiple of
+    // the largest block size, as buffer to image copies need
+    static constexpr u64 cooked_payload_alignment = 64;
+    static constexpr u64 cooked_level_alignment = 16;
+
+    struct CookedTextureHeader
+    {
+        u32 magic;
+        u32 version;
+        u32 format;
+        u32 content;
+        u32 width;
+        u32 height;
+        u32 levels;
+        u32 reserved;
+        u64 payloadOffset;
+        u64 size;
+    };
+
+    struct CookedLevelEntry
+    {
+        u32 width;
+        u32 height;
+        u64 offset;
+        u64 size;
+    };
+
+    static u64 align_to(const u64 offset, const u64 alignment)
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    static u64 block_size(const ETextureFormat format)
+    {
+        switch (format)
+        {
+        case ETextureFormat::BC1:
+            return bc1_block_size;
+        case ETextureFormat::BC3:
+            return bc3_block_size;
+        case ETextureFormat::BC5:
+            return bc5_block_size;
+        case ETextureFormat::BC7:
+            return bc7_block_size;
+        default:
+            return 0;
+        }
+    }
+
+    static f32 srgb_to_linear(const u8 value)
+    {
+        static const auto table = [] {
+            std::vector<f32> values(256);
+            for (u32 i = 0; i < 256; i++)
+            {
+                const f32 v = static_cast<f32>(i) / 255.0f;
+                values[i] = v <= 0.04045f
+                                ? v / 12.92f
+                                : std::pow((v + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table[value];
+    }
+
+    static u8 to_byte(const f32 value)
+    {
+        const f32 scaled = value * 255.0f + 0.5f;
+        return static_cast<u8>(scaled <= 0.0f
+                                   ? 0.0f
+                                   : (scaled >= 255.0f ? 255.0f : scaled));
+    }
+
+    static u8 linear_to_srgb(const f32 value)
+    {
+        const f32 v = value <= 0.0031308f
+                          ? value * 12.92f
+                          : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        return to_byte(v);
+    }
+
+    // Levels are filtered as four floats per pixel: linear colour for sRGB
+    // textures and unit vectors in [-1, 1] for normal maps.
+    static std::vector<f32> decode_level(const u8* pixels, const u32 width,
+                                         const u32 height,
+                                         const ETextureContent content)
+    {
+        const size_t count = static_cast<size_t>(width) * height;
+        std::vector<f32> level(count * 4);
+        for (size_t i = 0; i < count; i++)
+        {
+            const u8* source = pixels + i * 4;
+            f32* target = level.data() + i * 4;
+            for (u32 c = 0; c < 3; c++)
+            {
+                switch (content)
+                {
+                case ETextureContent::SRGB:
+                    target[c] = srgb_to_linear(source[c]);
+                    break;
+                case ETextureContent::NORMAL:
+                    target[c] = static_cast<f32>(source[c]) / 127.5f - 1.0f;
+                    break;
+                default:
+                    target[c] = static_cast<f32>(source[c]) / 255.0f;
+                    break;
+                }
+            }
+            target[3] = static_cast<f32>(source[3]) / 255.0f;
+        }
+        return level;
+    }
+
+    static std::vector<u8> encode_level(const std::vector<f32>& level,
+                                        const ETextureContent content)
+    {
+        std::vector<u8> pixels(level.size());
+        for (size_t i = 0; i < level.size(); i += 4)
+        {
+            for (u32 c = 0; c < 3; c++)
+            {
+                switch (content)
+                {
+                case ETextureContent::SRGB:
+                    pixels[i + c] = linear_to_srgb(level[i + c]);
+                    break;
+                case ETextureContent::NORMAL:
+                    pixels[i + c] = to_byte(level[i + c] * 0.5f + 0.5f);
+                    break;
+                default:
+                    pixels[i + c] = to_byte(level[i + c]);
+                    break;
+                }
+            }
+            pixels[i + 3] = to_byte(level[i + 3]);
+        }
+        return pixels;
+    }
+
+    // Texels of a level and their weights that one texel of the next level
+    // covers along an axis. Odd sizes take three taps so every texel of the
+    // level is covered, the middle one shared between two neighbours.
+    struct DownsampleTaps
+    {
+        u32 index[3];
+        f32 weight[3];
+        u32 count;
+    };
+
+    static DownsampleTaps downsample_taps(const u32 size, const u32 target)
+    {
+        DownsampleTaps taps = {};
+        if (size == 1)
+        {
+            taps.weight[0] = 1.0f;
+            taps.count = 1;
+        }
+        else if (size % 2 == 0)
+        {
+            taps.index[0] = 2 * target;
+            taps.index[1] = 2 * target + 1;
+            taps.weight[0] = 0.5f;
+            taps.weight[1] = 0.5f;
+            taps.count = 2;
+        }
+        else
+        {
+            const u32 next = size / 2;
+            const f32 scale = 1.0f / static_cast<f32>(size);
+            taps.index[0] = 2 * target;
+            taps.index[1] = 2 * target + 1;
+            taps.index[2] = 2 * target + 2;
+            taps.weight[0] = static_cast<f32>(next - target) * scale;
+            taps.weight[1] = static_cast<f32>(next) * scale;
+            taps.weight[2] = static_cast<f32>(target + 1) * scale;
+            taps.count = 3;
+        }
+        return taps;
+    }
+
+    // Box filter, 2 taps per even axis and 3 per odd one. sRGB colour is
+    // weighted by alpha so transparent texels do not bleed into the rest.
+    static std::vector<f32> downsample(const std::vector<f32>& level,
+                                       const u32 width, const u32 height,
+                                       const ETextureContent content)
+    {
+        const u32 nextWidth = width > 1 ? width / 2 : 1;
+        const u32 nextHeight = height > 1 ? height / 2 : 1;
+        std::vector<DownsampleTaps> columns(nextWidth);
+        for (u32 x = 0; x < nextWidth; x++)
+        {
+            columns[x] = downsample_taps(width, x);
+        }
+
+        std::vector<f32> next(static_cast<size_t>(nextWidth) * nextHeight * 4);
+        for (u32 y = 0; y < nextHeight; y++)
+        {
+            const DownsampleTaps rows = downsample_taps(height, y);
+            for (u32 x = 0; x < nextWidth; x++)
+            {
+                const DownsampleTaps& cols = columns[x];
+                f32 sum[4] = {};
+                f32 premultiplied[3] = {};
+                for (u32 r = 0; r < rows.count; r++)
+                {
+                    for (u32 c = 0; c < cols.count; c++)
+                    {
+                        const f32 weight = rows.weight[r] * cols.weight[c];
+                        const f32* texel =
+                            level.data() +
+                            (static_cast<size_t>(rows.index[r]) * width +
+                             cols.index[c]) *
+                                4;
+                        for (u32 i = 0; i < 4; i++)
+                        {
+                            sum[i] += texel[i] * weight;
+                        }
+                        for (u32 i = 0; i < 3; i++)
+                        {
+                            premultiplied[i] += texel[i] * texel[3] * weight;
+                        }
+                    }
+                }
+
+                f32* target =
+                    next.data() + (static_cast<size_t>(y) * nextWidth + x) * 4;
+                // fully transparent areas keep their plain average
+                const bool weighted =
+                    content == ETextureContent::SRGB && sum[3] > 0.0f;
+                for (u32 i = 0; i < 3; i++)
+                {
+                    target[i] = weighted ? premultiplied[i] / sum[3] : sum[i];
+                }
+                target[3] = sum[3];
+
+                if (content == ETextureContent::NORMAL)
+                {
+                    const f32 length =
+                        std::sqrt(target[0] * target[0] +
+                                  target[1] * target[1] + target[2] * target[2]);
+                    if (length > 0.0f)
+                    {
+                        target[0] /= length;
+                        target[1] /= length;
+                        target[2] /= length;
+                    }
+                }
+            }
+        }
+        return next;
+    }
+
+    u32 textureMipCount(const u32 width, const u32 height) noexcept
+    {
+        u32 largest = width > height ? width : height;
+        u32 count = 1;
+        while (largest > 1)
+        {
+            largest /= 2;
+            count++;
+        }
+        return count;
+    }
+
+    u64 textureLevelSize(const ETextureFormat format, const u32 width,
+                         const u32 height) noexcept
+    {
+        if (format == ETextureFormat::RGBA8)
+        {
+            return static_cast<u64>(width) * height * 4;
+        }
+        const u64 blocksX = (width + 3) / 4;
+        const u64 blocksY = (height + 3) / 4;
+        return blocksX * blocksY * block_size(format);
+    }
+
+    std::vector<std::vector<u8>> buildTextureMips(const u8* pixels,
+                                                  const u32 width,
+                                                  const u32 height,
+                                                  const ETextureContent content)
+    {
+        const u32 count = textureMipCount(width, height);
+        std::vector<std::vector<u8>> levels;
+        levels.reserve(count);
+        levels.emplace_back(pixels,
+                            pixels + static_cast<size_t>(width) * height * 4);
+
+        std::vector<f32> level = decode_level(pixels, width, height, content);
+        u32 levelWidth = width;
+        u32 levelHeight = height;
+        for (u32 i = 1; i < count; i++)
+        {
+            level = downsample(level, levelWidth, levelHeight, content);
+            levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+            levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+            levels.push_back(encode_level(level, content));
+        }
+        return levels;
+    }
+
+    std::vector<u8> compressTexture(const u8* pixels, const u32 width,
+                                    const u32 height,
+                                    const ETextureFormat format,
+                                    JobSystem* jobs)
+    {
+        std::vector<u8> result(
+            static_cast<size_t>(textureLevelSize(format, width, height)));
+        if (format == ETextureFormat::RGBA8)
+        {
+            memcpy(result.data(), pixels, result.size());
+            return result;
+        }
+
+        const u32 blocksX = (width + 3) / 4;
+        const u32 blocksY = (height + 3) / 4;
+        const u64 blockBytes = block_size(format);
+
+        const auto encodeRows = [&](const size_t begin, const size_t end) {
+            u8 block[16 * 4];
+            for (size_t by = begin; by < end; by++)
+            {
+                for (u32 bx = 0; bx < blocksX; bx++)
+                {
+                    for (u32 y = 0; y < 4; y++)
+                    {
+                        const u32 py = static_cast<u32>(by) * 4 + y;
+                        const u32 sy = py < height ? py : height - 1;
+                        for (u32 x = 0; x < 4; x++)
+                        {
+                            const u32 px = bx * 4 + x;
+                            const u32 sx = px < width ? px : width - 1;
+                            memcpy(block + (y * 4 + x) * 4,
+                                   pixels + (static_cast<size_t>(sy) * width + sx) * 4,
+                                   4);
+                        }
+                    }
+
+                    u8* target = result.data() +
+                                 (by * blocksX + bx) * blockBytes;
+                    switch (format)
+                    {
+                    case ETextureFormat::BC1:
+                        encodeBC1(block, target);
+                        break;
+                    case ETextureFormat::BC3:
+                        encodeBC3(block, target);
+                        break;
+                    case ETextureFormat::BC5:
+                        encodeBC5(block, target);
+                        break;
+                    default:
+                        encodeBC7(block, target);
+                        break;
+                    }
+                }
+            }
+        };
+
+        if (jobs != nullptr)
+        {
+            jobs->parallelFor(blocksY, 4, encodeRows);
+        }
+        else
+        {
+            encodeRows(0, blocksY);
+        }
+        return result;
+    }
+
+    CookedTexture::CookedTexture(const std::string& path)
+        : _file(path, EFileAccess::WILL_NEED)
+    {
+        if (_file.valid())
+        {
+            _parse(_file.bytes());
+        }
+    }
+
+    CookedTexture::CookedTexture(const span<const u8> bytes)
+    {
+        _parse(bytes);
+    }
+
+    bool CookedTexture::valid() const noexcept
+    {
+        return _valid;
+    }
+
+    ETextureFormat CookedTexture::format() const noexcept
+    {
+        return _format;
+    }
+
+    ETextureContent CookedTexture::content() const noexcept
+    {
+        return _content;
+    }
+
+    u32 CookedTexture::width() const noexcept
+    {
+        return _width;
+    }
+
+    u32 CookedTexture::height() const noexcept
+    {
+        return _height;
+    }
+
+    u32 CookedTexture::levelCount() const noexcept
+    {
+        return static_cast<u32>(_levels.size());
+    }
+
+    const CookedTexture::Level& CookedTexture::level(
+        const u32 index) const noexcept
+    {
+        return _levels[index];
+    }
+
+    span<const u8> CookedTexture::payload() const noexcept
+    {
+        return _payload;
+    }
+
+    std::vector<u8> CookedTexture::cook(const u8* pixels, const u32 width,
+                                        const u32 height,
+                                        const ETextureFormat format,
+                                        const ETextureContent content,
+                                        JobSystem* jobs)
+    {
+        const std::vector<std::vector<u8>> mips =
+            buildTextureMips(pixels, width, height, content);
+
+        std::vector<std::vector<u8>> encoded;
+        encoded.reserve(mips.size());
+        std::vector<CookedLevelEntry> entries(mips.size());
+        u64 offset = 0;
+        u32 levelWidth = width;
+        u32 levelHeight = height;
+        for (size_t i = 0; i < mips.size(); i++)
+        {
+            encoded.push_back(compressTexture(mips[i].data(), levelWidth,
+                                              levelHeight, format, jobs));
+
+            CookedLevelEntry& entry = entries[i];
+            entry.width = levelWidth;
+            entry.height = levelHeight;
+            entry.offset = align_to(offset, cooked_level_alignment);
+            entry.size = encoded.back().size();
+            offset = entry.offset + entry.size;
+
+            levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+            levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+        }
+
+        const u64 payloadOffset = align_to(
+            sizeof(CookedTextureHeader) + entries.size() * sizeof(CookedLevelEntry),
+            cooked_payload_alignment);
+        std::vector<u8> data(static_cast<size_t>(payloadOffset + offset));
+
+        CookedTextureHeader header;
+        header.magic = cooked_texture_magic;
+        header.version = format_version;
+        header.format = static_cast<u32>(format);
+        header.content = static_cast<u32>(content);
+        header.width = width;
+        header.height = height;
+        header.levels = static_cast<u32>(entries.size());
+        header.reserved = 0;
+        header.payloadOffset = payloadOffset;
+        header.size = data.size();
+        memcpy(data.data(), &header, sizeof(header));
+        memcpy(data.data() + sizeof(header), entries.data(),
+               entries.size() * sizeof(CookedLevelEntry));
+
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            memcpy(data.data() + payloadOffset + entries[i].offset,
+                   encoded[i].data(), encoded[i].size());
+        }
+
+        return data;
+    }
+
+    void CookedTexture::_parse(const span<const u8> bytes)
+    {
+        if (bytes.size() < sizeof(CookedTextureHeader))
+        {
+            return;
+        }
+
+        CookedTextureHeader header;
+        memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic != cooked_texture_magic ||
+            header.version != format_version ||
+            header.format > static_cast<u32>(ETextureFormat::BC7) ||
+            header.content > static_cast<u32>(ETextureContent::NORMAL) ||
+            header.width == 0 || header.height == 0 ||
+            header.levels == 0 ||
+            header.levels > textureMipCount(header.width, header.height) ||
+            header.size != bytes.size())
+        {
+            return;
+        }
+
+        const u64 size = bytes.size();
+        const u64 tableEnd = sizeof(CookedTextureHeader) +
+                             static_cast<u64>(header.levels) *
+                                 sizeof(CookedLevelEntry);
+        if (tableEnd > header.payloadOffset || header.payloadOffset > size)
+        {
+            return;
+        }
+
+        const ETextureFormat format = static_cast<ETextureFormat>(header.format);
+        const span<const u8> payload =
+            bytes.subspan(static_cast<size_t>(header.payloadOffset),
+                          static_cast<size_t>(size - header.payloadOffset));
+
+        std::vector<Level> levels(header.levels);
+        u32 levelWidth = header.width;
+        u32 levelHeight = header.height;
+        for (u32 i = 0; i < header.levels; i++)
+        {
+            CookedLevelEntry entry;
+            memcpy(&entry,
+                   bytes.data() + sizeof(CookedTextureHeader) +
+                       i * sizeof(CookedLevelEntry),
+                   sizeof(entry));
+
+            // the levels are the mip chain of the header size, packed in
+            // order
+            if (entry.width != levelWidth || entry.height != levelHeight ||
+                entry.size != textureLevelSize(format, levelWidth, levelHeight) ||
+                entry.offset % cooked_level_alignment != 0 ||
+                entry.offset > payload.size() ||
+                entry.size > payload.size() - entry.offset)
+            {
+                return;
+            }
+
+            Level& level = levels[i];
+            level.width = entry.width;
+            level.height = entry.height;
+            level.offset = entry.offset;
+            level.bytes = payload.subspan(static_cast<size_t>(entry.offset),
+                                          static_cast<size_t>(entry.size));
+
+            levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+            levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+        }
+
+        _levels = std::move(levels);
+        _payload = payload;
+        _format = format;
+        _content = static_cast<ETextureContent>(header.content);
+        _width = header.width;
+        _height = header.height;
+        _valid = true;
+    }
+} // namespace helios
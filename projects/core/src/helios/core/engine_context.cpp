@@ -193,6 +193,31 @@ namespace helios
         return *_entities;
     }
 
+    JobSystem& EngineContext::jobs()
+    {
+        return *_jobs;
+    }
+
+    TransformSystem& EngineContext::transforms()
+    {
+        return *_transforms;
+    }
+
+    SpatialIndex& EngineContext::spatial()
+    {
+        return *_spatial;
+    }
+
+    SystemScheduler& EngineContext::systems()
+    {
+        return *_systems;
+    }
+
+    AsyncFileReader& EngineContext::files()
+    {
+        return *_files;
+    }
+
     void EngineContext::_initialize()
     {
         using nlohmann::json;
@@ -313,11 +338,26 @@ namespace helios
 
         _render->_resourceManager = new ResourceManager();
 
-        _entities = new EntityManager();
+        _jobs = new JobSystem(requestedThreadCount);
+        _files = new AsyncFileReader();
+        _entities = new EntityManager(_jobs);
+        _transforms = new TransformSystem(*_entities, *_jobs);
+        _spatial = new SpatialIndex(*_entities, *_jobs);
+
+        _systems = new SystemScheduler(*_entities, *_jobs);
+        _systems->add<Read<HierarchyComponent>, Write<TransformationComponent>>(
+            "transforms", [this](EntityManager&) { _transforms->update(); });
+        _systems->add<Read<TransformationComponent, BoundsComponent>>(
+            "spatial", [this](EntityManager&) { _spatial->update(); });
     }
 
     void EngineContext::_close()
     {
+        delete _systems;
+        delete _spatial;
+        delete _transforms;
+        delete _files;
+        delete _jobs;
         delete _render;
         delete _win;
     }
@@ -0,0 +1,191 @@
+#include <helios/core/frame_loop.hpp>
+
+#include <chrono>
+#include <cmath>
+
+namespace helios
+{
+    static f64 milliseconds_since(
+        const std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<f64, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    FrameLoop::FrameLoop(JobSystem& jobs, const Settings& settings)
+        : _jobs(jobs), _settings(settings), _accumulator(0.0), _alpha(0.0),
+          _renderAlpha(0.0), _frames(0), _steps(0), _running(true)
+    {
+    }
+
+    void FrameLoop::onInput(std::function<bool()> fn)
+    {
+        _input = std::move(fn);
+    }
+
+    void FrameLoop::onSimulate(std::function<void(f64 step)> fn)
+    {
+        _simulate = std::move(fn);
+    }
+
+    void FrameLoop::onExtract(std::function<void(f64 alpha)> fn)
+    {
+        _extract = std::move(fn);
+    }
+
+    void FrameLoop::onRender(std::function<void(f64 alpha)> fn)
+    {
+        _render = std::move(fn);
+    }
+
+    void FrameLoop::run()
+    {
+        _running.store(true, std::memory_order_relaxed);
+        auto last = std::chrono::steady_clock::now();
+        while (_running.load(std::memory_order_relaxed))
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const f64 elapsed = std::chrono::duration<f64>(now - last).count();
+            last = now;
+            advance(elapsed);
+        }
+    }
+
+    bool FrameLoop::advance(const f64 elapsed)
+    {
+        const auto frameStart = std::chrono::steady_clock::now();
+        _current = Timings();
+
+        if (_input)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            if (!_input())
+            {
+                stop();
+            }
+            _current.input = milliseconds_since(start);
+        }
+
+        const u32 steps = _takeSteps(elapsed);
+        _current.steps = steps;
+
+        const bool pipelined = _settings.pipelined && _jobs.workerCount() > 0;
+        if (pipelined)
+        {
+            // nothing has been extracted before the first frame, render it
+            // from the initial state
+            if (_frames == 0 && _extract)
+            {
+                _extract(0.0);
+            }
+
+            std::atomic<size_t> simulating(1);
+            _jobs.submit([this, steps, &simulating]() {
+                _step(steps);
+                simulating.fetch_sub(1, std::memory_order_release);
+            });
+
+            if (_render)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                _render(_renderAlpha);
+                _current.render = milliseconds_since(start);
+            }
+
+            const auto waitStart = std::chrono::steady_clock::now();
+            _jobs.wait(simulating);
+            _current.wait = milliseconds_since(waitStart);
+        }
+        else
+        {
+            _step(steps);
+        }
+
+        if (_extract)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            _extract(_alpha);
+            _current.extract = milliseconds_since(start);
+        }
+        _renderAlpha = _alpha;
+
+        if (!pipelined && _render)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            _render(_renderAlpha);
+            _current.render = milliseconds_since(start);
+        }
+
+        ++_frames;
+        _current.frame = milliseconds_since(frameStart);
+        _timings = _current;
+        return _running.load(std::memory_order_relaxed);
+    }
+
+    void FrameLoop::stop() noexcept
+    {
+        _running.store(false, std::memory_order_relaxed);
+    }
+
+    const FrameLoop::Settings& FrameLoop::settings() const noexcept
+    {
+        return _settings;
+    }
+
+    const FrameLoop::Timings& FrameLoop::timings() const noexcept
+    {
+        return _timings;
+    }
+
+    u64 FrameLoop::frameCount() const noexcept
+    {
+        return _frames;
+    }
+
+    u64 FrameLoop::stepCount() const noexcept
+    {
+        return _steps;
+    }
+
+    f64 FrameLoop::simulationTime() const noexcept
+    {
+        return static_cast<f64>(_steps) * _settings.fixedStep;
+    }
+
+    u32 FrameLoop::_takeSteps(const f64 elapsed)
+    {
+        const f64 step = _settings.fixedStep;
+        _accumulator += elapsed > 0.0 ? elapsed : 0.0;
+
+        u32 steps;
+        const f64 due = std::floor(_accumulator / step);
+        if (due > static_cast<f64>(_settings.maxStepsPerFrame))
+        {
+            steps = _settings.maxStepsPerFrame;
+            _accumulator = std::fmod(_accumulator, step);
+        }
+        else
+        {
+            steps = static_cast<u32>(due);
+            _accumulator -= static_cast<f64>(steps) * step;
+        }
+
+        _alpha = _accumulator / step;
+        return steps;
+    }
+
+    void FrameLoop::_step(const u32 steps)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (_simulate)
+        {
+            for (u32 i = 0; i < steps; i++)
+            {
+                _simulate(_settings.fixedStep);
+            }
+        }
+        _steps += steps;
+        _current.simulate = milliseconds_since(start);
+    }
+} // namespace helios
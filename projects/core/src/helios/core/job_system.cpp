@@ -0,0 +1,151 @@
+#include <helios/core/job_system.hpp>
+
+namespace helios
+{
+    static std::atomic<u64> next_job_id(1);
+    static thread_local u64 current_job = 0;
+
+    JobSystem::JobSystem(const u32 workerCount)
+        : _pending(0), _stopping(false)
+    {
+        _workers.reserve(workerCount);
+        for (u32 i = 0; i < workerCount; ++i)
+        {
+            _workers.emplace_back([this]() { _work(); });
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        wait();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _available.notify_all();
+
+        for (auto& worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    u32 JobSystem::workerCount() const noexcept
+    {
+        return static_cast<u32>(_workers.size());
+    }
+
+    void JobSystem::submit(std::function<void()> job)
+    {
+        if (_workers.empty())
+        {
+            _run(job);
+            return;
+        }
+
+        _pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queue.push_back([this, job = std::move(job)]() {
+                job();
+                _pending.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        _available.notify_one();
+    }
+
+    u64 JobSystem::currentJob() noexcept
+    {
+        return current_job;
+    }
+
+    void JobSystem::wait()
+    {
+        wait(_pending);
+    }
+
+    void JobSystem::wait(const std::atomic<size_t>& counter)
+    {
+        while (counter.load(std::memory_order_acquire) != 0)
+        {
+            if (!_runOne())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::_work()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _available.wait(lock,
+                                [this]() { return _stopping || !_queue.empty(); });
+                if (_queue.empty())
+                {
+                    return;
+                }
+                job = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            _run(job);
+        }
+    }
+
+    bool JobSystem::_runOne()
+    {
+        std::function<void()> job;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_queue.empty())
+            {
+                return false;
+            }
+            job = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        _run(job);
+        return true;
+    }
+
+    void JobSystem::_run(const std::function<void()>& job)
+    {
+        // jobs run while waiting nest, so put the id of the waiter back
+        const u64 previous = current_job;
+        current_job = next_job_id.fetch_add(1, std::memory_order_relaxed);
+        job();
+        current_job = previous;
+    }
+
+    void JobSystem::_parallelFor(
+        const size_t count, const size_t grain,
+        const std::function<void(size_t, size_t)>& fn)
+    {
+        const size_t step = grain == 0 ? 1 : grain;
+        const size_t ranges = (count + step - 1) / step;
+
+        // the caller takes the first range itself, the rest are queued in one
+        // go so the workers wake up to a full queue
+        std::atomic<size_t> remaining(ranges - 1);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (size_t i = 1; i < ranges; ++i)
+            {
+                const size_t begin = i * step;
+                const size_t end = begin + step < count ? begin + step : count;
+                _queue.push_back([&fn, &remaining, begin, end]() {
+                    fn(begin, end);
+                    remaining.fetch_sub(1, std::memory_order_release);
+                });
+            }
+        }
+        _available.notify_all();
+
+        fn(0, step < count ? step : count);
+        wait(remaining);
+    }
+} // namespace helios
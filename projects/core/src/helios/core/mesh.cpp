@@ -1,18 +1,26 @@
 #include <helios/core/mesh.hpp>
 
+#include <helios/core/job_system.hpp>
+#include <helios/io/file.hpp>
+#include <helios/math/packed.hpp>
+
 #include <fx/gltf.h>
 
+#include <cstring>
+#include <istream>
+#include <streambuf>
+#include <vector>
+
 namespace helios
 {
     namespace detail
     {
-        struct BufferInfo
+        // Where an accessor's elements start and how far apart they are.
+        struct AccessorView
         {
-            fx::gltf::Accessor const* accessor;
-
-            u8 const* data;
-            u32 dataStride;
-            u32 totalSize;
+            const u8* data;
+            u32 stride;
+            u32 count;
 
             bool hasData() const noexcept
             {
@@ -20,243 +28,667 @@ namespace helios
             }
         };
 
-        static u32 calculateDataTypeSize(
-            const fx::gltf::Accessor& accessor) noexcept
+        // Reused by every accessor of a primitive so decoding one does not
+        // allocate per attribute.
+        struct DecodeScratch
+        {
+            std::vector<f32> values;
+            std::vector<u8> bytes;
+        };
+
+        static u32 componentSize(
+            const fx::gltf::Accessor::ComponentType type) noexcept
         {
-            u32 elementSize;
-            switch (accessor.componentType)
+            switch (type)
             {
             case fx::gltf::Accessor::ComponentType::Byte:
             case fx::gltf::Accessor::ComponentType::UnsignedByte:
-                elementSize = 1;
-                break;
+                return 1;
 
             case fx::gltf::Accessor::ComponentType::Short:
             case fx::gltf::Accessor::ComponentType::UnsignedShort:
-                elementSize = 2;
-                break;
+                return 2;
 
             case fx::gltf::Accessor::ComponentType::Float:
             case fx::gltf::Accessor::ComponentType::UnsignedInt:
-                elementSize = 4;
-                break;
+                return 4;
 
             default:
-                elementSize = 0;
-                break;
+                return 0;
             }
+        }
 
-            switch (accessor.type)
+        static u32 componentCount(const fx::gltf::Accessor::Type type) noexcept
+        {
+            switch (type)
             {
-            case fx::gltf::Accessor::Type::Mat2:
-                return 4 * elementSize;
-            case fx::gltf::Accessor::Type::Mat3:
-                return 9 * elementSize;
-            case fx::gltf::Accessor::Type::Mat4:
-                return 16 * elementSize;
             case fx::gltf::Accessor::Type::Scalar:
-                return elementSize;
+                return 1;
             case fx::gltf::Accessor::Type::Vec2:
-                return 2 * elementSize;
+                return 2;
             case fx::gltf::Accessor::Type::Vec3:
-                return 3 * elementSize;
+                return 3;
             case fx::gltf::Accessor::Type::Vec4:
-                return 4 * elementSize;
+            case fx::gltf::Accessor::Type::Mat2:
+                return 4;
+            case fx::gltf::Accessor::Type::Mat3:
+                return 9;
+            case fx::gltf::Accessor::Type::Mat4:
+                return 16;
             default:
                 return 0;
             }
         }
 
-        /*static u32 getAccessorTypeSize(fx::gltf::Accessor const& accessor)
+        // Resolves count elements of elementSize bytes inside a buffer view,
+        // empty when they do not fit or their components are not aligned
+        // the way glTF requires.
+        static AccessorView viewBuffer(const fx::gltf::Document& document,
+                                       const i32 bufferViewIndex,
+                                       const u64 byteOffset,
+                                       const u32 elementSize,
+                                       const u32 alignment, const u32 count)
+        {
+            if (bufferViewIndex < 0 ||
+                static_cast<size_t>(bufferViewIndex) >=
+                    document.bufferViews.size() ||
+                elementSize == 0)
+            {
+                return {nullptr, 0, 0};
+            }
+
+            const fx::gltf::BufferView& bufferView =
+                document.bufferViews[bufferViewIndex];
+            if (bufferView.buffer < 0 ||
+                static_cast<size_t>(bufferView.buffer) >=
+                    document.buffers.size())
+            {
+                return {nullptr, 0, 0};
+            }
+            const fx::gltf::Buffer& buffer = document.buffers[bufferView.buffer];
+
+            const u32 stride =
+                bufferView.byteStride != 0 ? bufferView.byteStride : elementSize;
+            const u64 offset =
+                static_cast<u64>(bufferView.byteOffset) + byteOffset;
+            const u64 extent =
+                count == 0 ? 0
+                           : static_cast<u64>(count - 1) * stride + elementSize;
+            if (stride < elementSize || offset % alignment != 0 ||
+                stride % alignment != 0 ||
+                byteOffset + extent > bufferView.byteLength ||
+                offset + extent > buffer.data.size())
+            {
+                return {nullptr, 0, 0};
+            }
+
+            return {buffer.data.data() + offset, stride, count};
+        }
+
+        static AccessorView viewAccessor(const fx::gltf::Document& document,
+                                         const fx::gltf::Accessor& accessor)
+        {
+            const u32 size = componentSize(accessor.componentType);
+            return viewBuffer(document, accessor.bufferView, accessor.byteOffset,
+                              size * componentCount(accessor.type), size,
+                              accessor.count);
+        }
+
+        template <size_t Size>
+        static void gatherFixed(const AccessorView& view, u8* dst)
+        {
+            for (u32 i = 0; i < view.count; i++)
+            {
+                memcpy(dst + static_cast<size_t>(i) * Size,
+                       view.data + static_cast<size_t>(i) * view.stride, Size);
+            }
+        }
+
+        // Packs the first size bytes of every element next to each other.
+        // The usual attribute sizes get a fixed size copy that compiles to
+        // plain moves.
+        static void gatherElements(const AccessorView& view, const u32 size,
+                                   u8* dst)
         {
-            switch (accessor.componentType)
+            if (view.stride == size)
+            {
+                memcpy(dst, view.data, static_cast<size_t>(view.count) * size);
+                return;
+            }
+
+            switch (size)
+            {
+            case 4:
+                gatherFixed<4>(view, dst);
+                break;
+            case 8:
+                gatherFixed<8>(view, dst);
+                break;
+            case 12:
+                gatherFixed<12>(view, dst);
+                break;
+            case 16:
+                gatherFixed<16>(view, dst);
+                break;
+            default:
+                for (u32 i = 0; i < view.count; i++)
+                {
+                    memcpy(dst + static_cast<size_t>(i) * size,
+                           view.data + static_cast<size_t>(i) * view.stride,
+                           size);
+                }
+                break;
+            }
+        }
+
+        template <typename T>
+        static void castComponents(const u8* src, f32* dst, const size_t count)
+        {
+            const T* values = reinterpret_cast<const T*>(src);
+            for (size_t i = 0; i < count; i++)
+            {
+                dst[i] = static_cast<f32>(values[i]);
+            }
+        }
+
+        // Converts packed components to floats. Normalised integers go
+        // through the batch unpackers, the others keep their value as
+        // KHR_mesh_quantization expects.
+        static void convertComponents(
+            const u8* src, const fx::gltf::Accessor::ComponentType type,
+            const bool normalized, const size_t count, f32* dst)
+        {
+            switch (type)
             {
             case fx::gltf::Accessor::ComponentType::Byte:
+                if (normalized)
+                {
+                    unpackSnorm8(reinterpret_cast<const i8*>(src), dst, count);
+                }
+                else
+                {
+                    castComponents<i8>(src, dst, count);
+                }
+                break;
             case fx::gltf::Accessor::ComponentType::UnsignedByte:
-                return 1;
-
+                if (normalized)
+                {
+                    unpackUnorm8(src, dst, count);
+                }
+                else
+                {
+                    castComponents<u8>(src, dst, count);
+                }
+                break;
             case fx::gltf::Accessor::ComponentType::Short:
+                if (normalized)
+                {
+                    unpackSnorm16(reinterpret_cast<const i16*>(src), dst,
+                                  count);
+                }
+                else
+                {
+                    castComponents<i16>(src, dst, count);
+                }
+                break;
             case fx::gltf::Accessor::ComponentType::UnsignedShort:
-                return 2;
-
-            case fx::gltf::Accessor::ComponentType::Float:
+                if (normalized)
+                {
+                    unpackUnorm16(reinterpret_cast<const u16*>(src), dst,
+                                  count);
+                }
+                else
+                {
+                    castComponents<u16>(src, dst, count);
+                }
+                break;
             case fx::gltf::Accessor::ComponentType::UnsignedInt:
-                return 4;
-
+                castComponents<u32>(src, dst, count);
+                break;
+            case fx::gltf::Accessor::ComponentType::Float:
+                memcpy(dst, src, count * sizeof(f32));
+                break;
             default:
-                return 0;
+                break;
             }
-        }*/
+        }
 
-        static BufferInfo getData(fx::gltf::Document const& document,
-                                  fx::gltf::Accessor const& accessor)
+        // Reads the first components of every element of a view as packed
+        // floats. Float data is gathered straight into the output, anything
+        // else is converted in bulk, after packing it when it is strided.
+        static void readComponents(const AccessorView& view,
+                                   const fx::gltf::Accessor::ComponentType type,
+                                   const bool normalized, const u32 components,
+                                   f32* dst, std::vector<u8>& scratch)
         {
-            fx::gltf::BufferView const& bufferView =
-                document.bufferViews[accessor.bufferView];
-            fx::gltf::Buffer const& buffer =
-                document.buffers[bufferView.buffer];
-
-            const uint32_t dataTypeSize = calculateDataTypeSize(accessor);
-            return BufferInfo{&accessor,
-                              buffer.data.data() + (static_cast<uint64_t>(
-                                                        bufferView.byteOffset) +
-                                                    accessor.byteOffset),
-                              dataTypeSize, accessor.count * dataTypeSize};
+            const u32 size = componentSize(type) * components;
+            const size_t count = static_cast<size_t>(view.count) * components;
+            if (type == fx::gltf::Accessor::ComponentType::Float)
+            {
+                gatherElements(view, size, reinterpret_cast<u8*>(dst));
+            }
+            else if (view.stride == size)
+            {
+                convertComponents(view.data, type, normalized, count, dst);
+            }
+            else
+            {
+                scratch.resize(static_cast<size_t>(view.count) * size);
+                gatherElements(view, size, scratch.data());
+                convertComponents(scratch.data(), type, normalized, count, dst);
+            }
         }
-    } // namespace detail
 
-    Mesh::Mesh()
-    {
-    }
+        // Reads a view of unsigned indices, widened to 32 bits.
+        static bool readIndexValues(const AccessorView& view,
+                                    const fx::gltf::Accessor::ComponentType type,
+                                    u32* dst, std::vector<u8>& scratch)
+        {
+            const u32 size = componentSize(type);
+            const u8* src = view.data;
+            if (view.stride != size)
+            {
+                scratch.resize(static_cast<size_t>(view.count) * size);
+                gatherElements(view, size, scratch.data());
+                src = scratch.data();
+            }
 
-    Mesh::Mesh(const std::string& filePath)
-    {
-        std::string suffix = "gltf";
+            switch (type)
+            {
+            case fx::gltf::Accessor::ComponentType::UnsignedByte:
+                widenIndices(src, dst, view.count);
+                return true;
+            case fx::gltf::Accessor::ComponentType::UnsignedShort:
+                widenIndices(reinterpret_cast<const u16*>(src), dst,
+                             view.count);
+                return true;
+            case fx::gltf::Accessor::ComponentType::UnsignedInt:
+                memcpy(dst, src, static_cast<size_t>(view.count) * sizeof(u32));
+                return true;
+            default:
+                return false;
+            }
+        }
 
-        const bool isText =
-            (0 == filePath.compare(filePath.length() - suffix.length(),
-                                   suffix.length(), suffix));
-        suffix = "glb";
+        // Overwrites the elements a sparse accessor lists with its
+        // substitutes, which readValues decodes the same way as the dense
+        // data.
+        template <typename T, typename ReadValues>
+        static bool applySparse(const fx::gltf::Document& document,
+                                const fx::gltf::Accessor& accessor,
+                                const u32 components, T* dst,
+                                std::vector<u8>& scratch,
+                                ReadValues&& readValues)
+        {
+            const fx::gltf::Accessor::Sparse& sparse = accessor.sparse;
+            if (sparse.empty())
+            {
+                return true;
+            }
+            if (sparse.count < 0)
+            {
+                return false;
+            }
 
-        const bool isBinary =
-            (0 == filePath.compare(filePath.length() - suffix.length(),
-                                   suffix.length(), suffix));
+            const u32 count = static_cast<u32>(sparse.count);
+            const u32 indexSize = componentSize(sparse.indices.componentType);
+            const u32 valueSize = componentSize(accessor.componentType);
+            const AccessorView indexView = viewBuffer(
+                document, static_cast<i32>(sparse.indices.bufferView),
+                sparse.indices.byteOffset, indexSize, indexSize, count);
+            const AccessorView valueView = viewBuffer(
+                document, static_cast<i32>(sparse.values.bufferView),
+                sparse.values.byteOffset,
+                valueSize * componentCount(accessor.type), valueSize, count);
+            if (!indexView.hasData() || !valueView.hasData())
+            {
+                return false;
+            }
 
-        fx::gltf::Document document;
+            std::vector<u32> indices(count);
+            std::vector<T> values(static_cast<size_t>(count) * components);
+            if (!readIndexValues(indexView, sparse.indices.componentType,
+                                 indices.data(), scratch) ||
+                !readValues(valueView, values.data()))
+            {
+                return false;
+            }
+
+            for (u32 i = 0; i < count; i++)
+            {
+                if (indices[i] >= accessor.count)
+                {
+                    return false;
+                }
+                memcpy(dst + static_cast<size_t>(indices[i]) * components,
+                       values.data() + static_cast<size_t>(i) * components,
+                       components * sizeof(T));
+            }
+            return true;
+        }
 
-        if (isText)
+        // Decodes an accessor to packed floats, components per element. An
+        // accessor without a buffer view starts out as zeros for its sparse
+        // substitutes to land on.
+        static bool readAccessor(const fx::gltf::Document& document,
+                                 const fx::gltf::Accessor& accessor,
+                                 const u32 components, DecodeScratch& scratch)
         {
-            document = fx::gltf::LoadFromText(filePath);
+            if (componentSize(accessor.componentType) == 0 ||
+                componentCount(accessor.type) < components)
+            {
+                return false;
+            }
+
+            std::vector<f32>& out = scratch.values;
+            if (accessor.bufferView >= 0)
+            {
+                const AccessorView view = viewAccessor(document, accessor);
+                if (!view.hasData())
+                {
+                    return false;
+                }
+                out.resize(static_cast<size_t>(accessor.count) * components);
+                readComponents(view, accessor.componentType,
+                               accessor.normalized, components, out.data(),
+                               scratch.bytes);
+            }
+            else if (!accessor.sparse.empty())
+            {
+                out.assign(static_cast<size_t>(accessor.count) * components,
+                           0.0f);
+            }
+            else
+            {
+                return false;
+            }
+
+            return applySparse(document, accessor, components, out.data(),
+                               scratch.bytes,
+                               [&](const AccessorView& view, f32* values) {
+                                   readComponents(view, accessor.componentType,
+                                                  accessor.normalized,
+                                                  components, values,
+                                                  scratch.bytes);
+                                   return true;
+                               });
         }
 
-        if (isBinary)
+        template <size_t Components, typename Out>
+        static bool readVectors(const fx::gltf::Document& document,
+                                const fx::gltf::Accessor& accessor,
+                                vector<Out>& out, DecodeScratch& scratch)
         {
-            document = fx::gltf::LoadFromBinary(filePath);
+            if (!readAccessor(document, accessor, Components, scratch))
+            {
+                return false;
+            }
+
+            const f32* values = scratch.values.data();
+            const size_t count = scratch.values.size() / Components;
+            out.reserve(count);
+            for (size_t i = 0; i < count; i++, values += Components)
+            {
+                if constexpr (Components == 2)
+                {
+                    out.push_back(Out(values[0], values[1]));
+                }
+                else if constexpr (Components == 3)
+                {
+                    out.push_back(Out(values[0], values[1], values[2]));
+                }
+                else
+                {
+                    out.push_back(
+                        Out(values[0], values[1], values[2], values[3]));
+                }
+            }
+            return true;
         }
 
-        for (const auto& mesh : document.meshes)
+        // Fails on indices at or past vertexCount, they would read past the
+        // end of the vertex buffers.
+        static bool readIndices(const fx::gltf::Document& document,
+                                const fx::gltf::Accessor& accessor,
+                                const size_t vertexCount, vector<u32>& out,
+                                DecodeScratch& scratch)
         {
-            vector<Vector3f> mpositions;
-            vector<Vector2f> muvs;
-            vector<Vector3f> mnormals;
-            vector<Vector3f> mtangents;
-            vector<Vector3f> mbitangents;
+            if (accessor.type != fx::gltf::Accessor::Type::Scalar)
+            {
+                return false;
+            }
 
-            vector<u32> mindices;
+            if (accessor.bufferView >= 0)
+            {
+                const AccessorView view = viewAccessor(document, accessor);
+                if (!view.hasData())
+                {
+                    return false;
+                }
+                out.resize(accessor.count);
+                if (!readIndexValues(view, accessor.componentType, out.data(),
+                                     scratch.bytes))
+                {
+                    out.clear();
+                    return false;
+                }
+            }
+            else if (!accessor.sparse.empty())
+            {
+                out.resize(accessor.count);
+            }
+            else
+            {
+                return false;
+            }
 
-            for (const auto& primitive : mesh.primitives)
+            if (!applySparse(document, accessor, 1, out.data(), scratch.bytes,
+                             [&](const AccessorView& view, u32* values) {
+                                 return readIndexValues(view,
+                                                        accessor.componentType,
+                                                        values, scratch.bytes);
+                             }))
+            {
+                out.clear();
+                return false;
+            }
+
+            for (const u32 index : out)
             {
-                for (const auto& attribute : primitive.attributes)
+                if (index >= vertexCount)
                 {
-                    if (attribute.first == "POSITION")
-                    {
-                        auto accessor = document.accessors[attribute.second];
-                        auto positionBuffer =
-                            detail::getData(document, accessor);
-
-                        if (positionBuffer.hasData())
-                        {
-                            for (uint32_t i = 0;
-                                 i < positionBuffer.totalSize / sizeof(float);
-                                 i += 3)
-                            {
-                                float x = ((float*)positionBuffer.data)[i];
-                                float y = ((float*)positionBuffer.data)[i + 1];
-                                float z = ((float*)positionBuffer.data)[i + 2];
-
-                                mpositions.push_back({x, y, z});
-                            }
-                        }
-                    }
-                    else if (attribute.first == "TEXCOORD_0")
+                    out.clear();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static void decodePrimitive(const fx::gltf::Document& document,
+                                    const fx::gltf::Primitive& primitive,
+                                    const EVertexFormat format, Mesh& mesh)
+        {
+            DecodeScratch scratch;
+            for (const auto& attribute : primitive.attributes)
+            {
+                const fx::gltf::Accessor& accessor =
+                    document.accessors[attribute.second];
+                if (attribute.first == "POSITION")
+                {
+                    readVectors<3>(document, accessor, mesh.positions, scratch);
+                }
+                else if (attribute.first == "TEXCOORD_0")
+                {
+                    readVectors<2>(document, accessor, mesh.uvs, scratch);
+                }
+                else if (attribute.first == "NORMAL")
+                {
+                    readVectors<3>(document, accessor, mesh.normals, scratch);
+                }
+                else if (attribute.first == "COLOR_0")
+                {
+                    // colours may leave out alpha
+                    const u32 components =
+                        accessor.type == fx::gltf::Accessor::Type::Vec3 ? 3 : 4;
+                    if (!readAccessor(document, accessor, components, scratch))
                     {
-                        auto accessor = document.accessors[attribute.second];
-                        auto uvBuffer = detail::getData(document, accessor);
-
-                        if (uvBuffer.hasData())
-                        {
-                            for (uint32_t i = 0;
-                                 i < uvBuffer.totalSize / sizeof(f32); i += 2)
-                            {
-                                float x = ((float*)uvBuffer.data)[i];
-                                float y = ((float*)uvBuffer.data)[i + 1];
-
-                                muvs.push_back({x, y});
-                            }
-                        }
+                        continue;
                     }
-                    else if (attribute.first == "NORMAL")
+
+                    const f32* values = scratch.values.data();
+                    const size_t count = scratch.values.size() / components;
+                    mesh.colors.reserve(count);
+                    for (size_t i = 0; i < count; i++, values += components)
                     {
-                        auto accessor = document.accessors[attribute.second];
-                        auto normalBuffer = detail::getData(document, accessor);
-
-                        if (normalBuffer.hasData())
-                        {
-                            for (uint32_t i = 0;
-                                 i < normalBuffer.totalSize / sizeof(float);
-                                 i += 3)
-                            {
-                                float x = ((float*)normalBuffer.data)[i];
-                                float y = ((float*)normalBuffer.data)[i + 1];
-                                float z = ((float*)normalBuffer.data)[i + 2];
-
-                                mnormals.push_back({x, y, z});
-                            }
-                        }
+                        mesh.colors.push_back(
+                            Vector4f(values[0], values[1], values[2],
+                                     components == 4 ? values[3] : 1.0f));
                     }
-                    else if (attribute.first == "TANGENT")
+                }
+                else if (attribute.first == "TANGENT" &&
+                         readAccessor(document, accessor, 4, scratch))
+                {
+                    // w is the handedness, parked in the bitangent until
+                    // calculateBitangents turns it into the real one
+                    const f32* values = scratch.values.data();
+                    const size_t count = scratch.values.size() / 4;
+                    mesh.tangents.reserve(count);
+                    mesh.bitangents.reserve(count);
+                    for (size_t i = 0; i < count; i++, values += 4)
                     {
-                        auto accessor = document.accessors[attribute.second];
-                        auto tangentBuffer =
-                            detail::getData(document, accessor);
-
-                        if (tangentBuffer.hasData())
-                        {
-                            for (uint32_t i = 0;
-                                 i < tangentBuffer.totalSize / sizeof(float);
-                                 i += 4)
-                            {
-                                float x = ((float*)tangentBuffer.data)[i];
-                                float y = ((float*)tangentBuffer.data)[i + 1];
-                                float z = ((float*)tangentBuffer.data)[i + 2];
-                                float w = ((float*)tangentBuffer.data)[i + 3];
-
-                                mtangents.push_back({x, y, z});
-                                mbitangents.push_back({w, 0, 0});
-                            }
-                        }
+                        mesh.tangents.push_back(
+                            Vector3f(values[0], values[1], values[2]));
+                        mesh.bitangents.push_back(Vector3f(values[3], 0, 0));
                     }
                 }
+            }
 
-                auto indexAccessor = document.accessors[primitive.indices];
-                auto indexBuffer = detail::getData(document, indexAccessor);
+            if (primitive.indices >= 0 &&
+                !readIndices(document, document.accessors[primitive.indices],
+                             mesh.positions.size(), mesh.triangles, scratch))
+            {
+                // the primitive is rejected, its sub mesh stays empty
+                mesh.positions.clear();
+                mesh.uvs.clear();
+                mesh.normals.clear();
+                mesh.tangents.clear();
+                mesh.bitangents.clear();
+                mesh.colors.clear();
+                mesh.calculateBounds();
+                return;
+            }
 
-                if (indexBuffer.hasData())
+            if (primitive.indices < 0)
+            {
+                // non-indexed primitives draw their vertices in order
+                mesh.triangles.reserve(mesh.positions.size());
+                for (size_t i = 0; i < mesh.positions.size(); i++)
                 {
-                    for (uint32_t i = 0;
-                         i < indexBuffer.totalSize / sizeof(uint16_t); i++)
-                    {
-                        uint16_t idx = ((uint16_t*)indexBuffer.data)[i];
-
-                        mindices.push_back({idx});
-                    }
+                    mesh.triangles.push_back(static_cast<u32>(i));
                 }
+            }
 
-                Mesh* heliosMesh = new Mesh();
-                heliosMesh->positions = mpositions;
-                heliosMesh->uvs = muvs;
-                heliosMesh->normals = mnormals;
-                heliosMesh->tangents = mtangents;
-                heliosMesh->bitangents = mbitangents;
+            if (mesh.normals.size() < mesh.tangents.size())
+            {
+                mesh.tangents.clear();
+                mesh.bitangents.clear();
+            }
+
+            mesh.calculateBitangents();
+            mesh.calculateBounds();
+            mesh.build(format);
+        }
+
+        // Lets the istream based glTF loaders read straight from memory.
+        class SpanStreamBuffer final : public std::streambuf
+        {
+        public:
+            explicit SpanStreamBuffer(const span<const u8> bytes)
+            {
+                char* begin =
+                    const_cast<char*>(reinterpret_cast<const char*>(bytes.data()));
+                setg(begin, begin, begin + bytes.size());
+            }
+        };
+    } // namespace detail
+
+    Mesh::Mesh()
+    {
+    }
+
+    Mesh::Mesh(const std::string& filePath, const EVertexFormat format,
+               JobSystem* jobs)
+        : Mesh(MappedFile(filePath).bytes(),
+               fx::gltf::detail::GetDocumentRootPath(filePath), format, jobs)
+    {
+    }
+
+    Mesh::Mesh(const span<const u8> bytes, const std::string& rootPath,
+               const EVertexFormat format, JobSystem* jobs)
+    {
+        const bool isBinary =
+            bytes.size() >= sizeof(u32) &&
+            memcmp(bytes.data(), &fx::gltf::detail::GLBHeaderMagic,
+                   sizeof(u32)) == 0;
+
+        detail::SpanStreamBuffer buffer(bytes);
+        std::istream input(&buffer);
+
+        fx::gltf::Document document;
+
+        if (isBinary)
+        {
+            document = fx::gltf::LoadFromBinary(input, rootPath);
+        }
+        else
+        {
+            document = fx::gltf::LoadFromText(input, rootPath);
+        }
 
-                heliosMesh->triangles = mindices;
+        // every primitive becomes a sub mesh, decoded and built on its own
+        struct PrimitiveJob
+        {
+            const fx::gltf::Primitive* primitive;
+            Mesh* mesh;
+        };
 
-                heliosMesh->calculateBitangents();
-                heliosMesh->build();
+        std::vector<PrimitiveJob> primitives;
+        size_t primitiveCount = 0;
+        for (const auto& mesh : document.meshes)
+        {
+            primitiveCount += mesh.primitives.size();
+        }
+        primitives.reserve(primitiveCount);
+        subMeshes.reserve(primitiveCount);
 
+        for (const auto& mesh : document.meshes)
+        {
+            for (const auto& primitive : mesh.primitives)
+            {
+                Mesh* heliosMesh = new Mesh();
                 subMeshes.push_back(heliosMesh);
+                primitives.push_back({&primitive, heliosMesh});
             }
         }
+
+        const auto decode = [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                detail::decodePrimitive(document, *primitives[i].primitive,
+                                        format, *primitives[i].mesh);
+            }
+        };
+
+        if (jobs != nullptr)
+        {
+            jobs->parallelFor(primitives.size(), 1, decode);
+        }
+        else
+        {
+            decode(0, primitives.size());
+        }
+
+        calculateBounds();
     }
 
     Mesh::~Mesh()
@@ -266,17 +698,25 @@ namespace helios
             delete mesh;
         }
 
-        for (auto& buf : _buffers)
-        {
-            free(buf.data);
-        }
-        _buffers.clear();
+        _releaseBuffers();
     }
 
-    void Mesh::build()
+    void Mesh::build(const EVertexFormat format)
     {
+        // a rebuild, e.g. after optimising, replaces the old buffers
+        _releaseBuffers();
+
+        _format = format;
+        if (format == EVertexFormat::PACKED)
+        {
+            _buildPacked();
+            return;
+        }
+
         vector<Vector3fView> positionView;
         vector<VertexNoPosition> vNoPosition;
+        positionView.reserve(positions.size());
+        vNoPosition.reserve(positions.size());
         for (size_t i = 0; i < positions.size(); i++)
         {
             positionView.push_back(positions[i]);
@@ -346,6 +786,90 @@ namespace helios
         }
     }
 
+    void Mesh::_buildPacked()
+    {
+        const size_t count = positions.size();
+
+        vector<Vector2f> fullUvs;
+        vector<Vector3f> fullNormals;
+        vector<Vector4f> fullTangents;
+        vector<Vector4f> fullColors;
+        fullUvs.reserve(count);
+        fullNormals.reserve(count);
+        fullTangents.reserve(count);
+        fullColors.reserve(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            fullUvs.push_back(uvs.size() > i ? uvs[i] : Vector2f(0, 0));
+
+            // the octahedral encoding needs a non-zero normal
+            const Vector3f normal =
+                normals.size() > i ? normals[i] : Vector3f(0, 0, 1);
+            fullNormals.push_back(normal);
+
+            if (tangents.size() > i)
+            {
+                // recover the handedness baked into the bitangent
+                f32 sign = 1.0f;
+                if (bitangents.size() > i &&
+                    normal.cross(tangents[i]).dot(bitangents[i]) < 0.0f)
+                {
+                    sign = -1.0f;
+                }
+                fullTangents.push_back(Vector4f(tangents[i], sign));
+            }
+            else
+            {
+                fullTangents.push_back(Vector4f(0, 0, 0, 1));
+            }
+
+            fullColors.push_back(colors.size() > i ? colors[i]
+                                                   : Vector4f(1, 1, 1, 1));
+        }
+
+        vector<Half2> packedUvs(count);
+        vector<Snorm16x2> packedNormals(count);
+        vector<Snorm1010102> packedTangents(count);
+        vector<Unorm8x4> packedColors(count);
+
+        packHalf(fullUvs.data(), packedUvs.data(), count);
+        packOctahedral(fullNormals.data(), packedNormals.data(), count);
+        packSnorm1010102(fullTangents.data(), packedTangents.data(), count);
+        packUnorm8(fullColors.data(), packedColors.data(), count);
+
+        {
+            void* data = malloc(count * sizeof(Vector3fView));
+            Vector3fView* views = static_cast<Vector3fView*>(data);
+            for (size_t i = 0; i < count; i++)
+            {
+                views[i] = positions[i];
+            }
+            _buffers.push_back({data, count * sizeof(Vector3fView)});
+        }
+
+        {
+            void* data = malloc(count * sizeof(PackedVertexNoPosition));
+            PackedVertexNoPosition* vertices =
+                static_cast<PackedVertexNoPosition*>(data);
+            for (size_t i = 0; i < count; i++)
+            {
+                vertices[i] = {packedUvs[i], packedNormals[i],
+                               packedTangents[i], packedColors[i]};
+            }
+            _buffers.push_back({data, count * sizeof(PackedVertexNoPosition)});
+        }
+    }
+
+    void Mesh::_releaseBuffers()
+    {
+        for (auto& buf : _buffers)
+        {
+            free(buf.data);
+        }
+        _buffers.clear();
+    }
+
     void Mesh::calculateBitangents()
     {
         for (size_t i = 0; i < tangents.size(); i++)
@@ -355,6 +879,47 @@ namespace helios
         }
     }
 
+    void Mesh::calculateBounds()
+    {
+        bounds = AABB::fromPoints(positions.data(), positions.size());
+        boundingSphere =
+            BoundingSphere::fromPoints(positions.data(), positions.size());
+
+        for (const Mesh* subMesh : subMeshes)
+        {
+            bounds.expand(subMesh->bounds);
+            boundingSphere.expand(subMesh->boundingSphere);
+        }
+    }
+
+    u32 Mesh::selectLod(const f32 screenRadius, const f32 maxPixelError) const
+    {
+        if (boundingSphere.radius <= 0.0f)
+        {
+            return 0;
+        }
+
+        // errors grow along the chain, so stop at the first one too large
+        const f32 pixelsPerUnit = screenRadius / boundingSphere.radius;
+        u32 level = 0;
+        while (level < lods.size() &&
+               lods[level].error * pixelsPerUnit <= maxPixelError)
+        {
+            level++;
+        }
+        return level;
+    }
+
+    u32 Mesh::lodCount() const
+    {
+        return static_cast<u32>(lods.size()) + 1;
+    }
+
+    const vector<u32>& Mesh::lodTriangles(const u32 level) const
+    {
+        return level == 0 ? triangles : lods[level - 1].triangles;
+    }
+
     void* Mesh::readBuffer(const u32 id) const
     {
         return _buffers[id].data;
@@ -369,4 +934,9 @@ namespace helios
     {
         return _buffers[id].size;
     }
+
+    EVertexFormat Mesh::vertexFormat() const
+    {
+        return _format;
+    }
 } // namespace helios
\ No newline at end of file
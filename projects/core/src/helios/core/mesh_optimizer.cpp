@@ -0,0 +1,571 @@
+#include <helios/core/mesh_optimizer.hpp>
+
+#include <helios/core/job_system.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace helios
+{
+    static constexpr u32 unused_vertex = ~0u;
+
+    // A FIFO post-transform cache kept as load timestamps. A vertex is
+    // cached while fewer than cacheSize others were loaded after it.
+    class FifoCache
+    {
+    public:
+        FifoCache(const u32 vertexCount, const u32 cacheSize)
+            : _loadedAt(vertexCount, 0), _time(cacheSize + 1),
+              _cacheSize(cacheSize)
+        {
+        }
+
+        // Returns 1 when the vertex had to be transformed.
+        u32 access(const u32 vertex)
+        {
+            if (_time - _loadedAt[vertex] > _cacheSize)
+            {
+                _loadedAt[vertex] = _time++;
+                return 1;
+            }
+            return 0;
+        }
+
+        u32 access(const u32* triangle)
+        {
+            return access(triangle[0]) + access(triangle[1]) +
+                   access(triangle[2]);
+        }
+
+        void flush()
+        {
+            _time += _cacheSize + 1;
+        }
+
+    private:
+        std::vector<u32> _loadedAt;
+        u32 _time;
+        u32 _cacheSize;
+    };
+
+    // whole triangles, every one of them addressing an existing vertex
+    static bool valid_triangles(const span<const u32> indices,
+                                const u32 vertexCount)
+    {
+        if (indices.size() % 3 != 0)
+        {
+            return false;
+        }
+        for (const u32 index : indices)
+        {
+            if (index >= vertexCount)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // attribute streams are either absent or one entry per position, as the
+    // stages below reorder them all together
+    static bool streams_match(const Mesh& mesh)
+    {
+        const size_t count = mesh.positions.size();
+        const auto matches = [count](const size_t size) {
+            return size == 0 || size == count;
+        };
+        return matches(mesh.uvs.size()) && matches(mesh.normals.size()) &&
+               matches(mesh.tangents.size()) &&
+               matches(mesh.bitangents.size()) && matches(mesh.colors.size());
+    }
+
+    template <typename T>
+    static void remap_stream(vector<T>& stream, const std::vector<u32>& remap,
+                             const u32 newCount)
+    {
+        if (stream.empty())
+        {
+            return;
+        }
+
+        vector<T> remapped(newCount);
+        for (size_t i = 0; i < stream.size(); i++)
+        {
+            if (remap[i] != unused_vertex)
+            {
+                remapped[remap[i]] = stream[i];
+            }
+        }
+        stream = std::move(remapped);
+    }
+
+    static void remap_vertices(Mesh& mesh, const std::vector<u32>& remap,
+                               const u32 newCount)
+    {
+        remap_stream(mesh.positions, remap, newCount);
+        remap_stream(mesh.uvs, remap, newCount);
+        remap_stream(mesh.normals, remap, newCount);
+        remap_stream(mesh.tangents, remap, newCount);
+        remap_stream(mesh.bitangents, remap, newCount);
+        remap_stream(mesh.colors, remap, newCount);
+
+        for (u32& index : mesh.triangles)
+        {
+            index = remap[index];
+        }
+        for (MeshLod& lod : mesh.lods)
+        {
+            for (u32& index : lod.triangles)
+            {
+                index = remap[index];
+            }
+        }
+        for (u32& index : mesh.meshletVertices)
+        {
+            index = remap[index];
+        }
+    }
+
+    static void append_key(std::vector<f32>& key, const Vector2f& value)
+    {
+        key.insert(key.end(), {value.x, value.y});
+    }
+
+    static void append_key(std::vector<f32>& key, const Vector3f& value)
+    {
+        key.insert(key.end(), {value.x, value.y, value.z});
+    }
+
+    static void append_key(std::vector<f32>& key, const Vector4f& value)
+    {
+        key.insert(key.end(), {value.x, value.y, value.z, value.w});
+    }
+
+    static u32 hash_key(const f32* key, const size_t length)
+    {
+        u32 hash = 0x811C9DC5u;
+        for (size_t i = 0; i < length; i++)
+        {
+            u32 bits;
+            memcpy(&bits, key + i, sizeof(bits));
+            hash = (hash ^ bits) * 0x9E3779B1u;
+            hash ^= hash >> 15;
+        }
+        return hash;
+    }
+
+    VertexCacheStatistics analyzeVertexCache(const span<const u32> indices,
+                                             const u32 vertexCount,
+                                             const u32 cacheSize)
+    {
+        VertexCacheStatistics statistics;
+        if (indices.size() < 3 || !valid_triangles(indices, vertexCount))
+        {
+            return statistics;
+        }
+
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<u8> referenced(vertexCount, 0);
+        u32 referencedCount = 0;
+        for (const u32 index : indices)
+        {
+            statistics.vertexTransforms += cache.access(index);
+            if (referenced[index] == 0)
+            {
+                referenced[index] = 1;
+                referencedCount++;
+            }
+        }
+
+        statistics.acmr = static_cast<f32>(statistics.vertexTransforms) /
+                          static_cast<f32>(indices.size() / 3);
+        statistics.atvr = static_cast<f32>(statistics.vertexTransforms) /
+                          static_cast<f32>(referencedCount);
+        return statistics;
+    }
+
+    u32 deduplicateVertices(Mesh& mesh)
+    {
+        const u32 vertexCount = static_cast<u32>(mesh.positions.size());
+        if (vertexCount == 0 || !streams_match(mesh) ||
+            !valid_triangles(span<const u32>(mesh.triangles.data(),
+                                             mesh.triangles.size()),
+                             vertexCount))
+        {
+            return vertexCount;
+        }
+
+        // every attribute of a vertex side by side, compared as raw bits
+        std::vector<f32> keys;
+        for (u32 i = 0; i < vertexCount; i++)
+        {
+            append_key(keys, mesh.positions[i]);
+            if (!mesh.uvs.empty())
+            {
+                append_key(keys, mesh.uvs[i]);
+            }
+            if (!mesh.normals.empty())
+            {
+                append_key(keys, mesh.normals[i]);
+            }
+            if (!mesh.tangents.empty())
+            {
+                append_key(keys, mesh.tangents[i]);
+            }
+            if (!mesh.bitangents.empty())
+            {
+                append_key(keys, mesh.bitangents[i]);
+            }
+            if (!mesh.colors.empty())
+            {
+                append_key(keys, mesh.colors[i]);
+            }
+        }
+        const size_t keyLength = keys.size() / vertexCount;
+
+        // open addressing, at most half full
+        size_t tableSize = 1;
+        while (tableSize < static_cast<size_t>(vertexCount) * 2)
+        {
+            tableSize *= 2;
+        }
+        std::vector<u32> table(tableSize, unused_vertex);
+
+        std::vector<u32> remap(vertexCount);
+        u32 unique = 0;
+        for (u32 i = 0; i < vertexCount; i++)
+        {
+            const f32* key = keys.data() + i * keyLength;
+            size_t slot = hash_key(key, keyLength) & (tableSize - 1);
+            while (true)
+            {
+                const u32 existing = table[slot];
+                if (existing == unused_vertex)
+                {
+                    table[slot] = i;
+                    remap[i] = unique++;
+                    break;
+                }
+                if (memcmp(keys.data() + existing * keyLength, key,
+                           keyLength * sizeof(f32)) == 0)
+                {
+                    remap[i] = remap[existing];
+                    break;
+                }
+                slot = (slot + 1) & (tableSize - 1);
+            }
+        }
+
+        if (unique != vertexCount)
+        {
+            remap_vertices(mesh, remap, unique);
+        }
+        return unique;
+    }
+
+    void optimizeVertexCache(span<u32> indices, const u32 vertexCount,
+                             const u32 cacheSize)
+    {
+        if (indices.size() < 3 || !valid_triangles(indices, vertexCount))
+        {
+            return;
+        }
+
+        const size_t triangleCount = indices.size() / 3;
+
+        // triangles around every vertex, and how many are still to be drawn
+        std::vector<u32> live(vertexCount, 0);
+        for (const u32 index : indices)
+        {
+            live[index]++;
+        }
+        std::vector<u32> offsets(static_cast<size_t>(vertexCount) + 1, 0);
+        for (u32 i = 0; i < vertexCount; i++)
+        {
+            offsets[i + 1] = offsets[i] + live[i];
+        }
+        std::vector<u32> adjacency(indices.size());
+        {
+            std::vector<u32> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                adjacency[cursor[indices[i]]++] = static_cast<u32>(i / 3);
+            }
+        }
+
+        std::vector<u32> cacheTime(vertexCount, 0);
+        std::vector<u8> emitted(triangleCount, 0);
+        std::vector<u32> deadEnd;
+        std::vector<u32> candidates;
+        std::vector<u32> output;
+        deadEnd.reserve(indices.size());
+        candidates.reserve(64);
+        output.reserve(indices.size());
+
+        u32 time = cacheSize + 1;
+        u32 scan = 0;
+
+        // falls back to recently used vertices, then to input order
+        const auto skipDeadEnd = [&]() {
+            while (!deadEnd.empty())
+            {
+                const u32 vertex = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[vertex] > 0)
+                {
+                    return vertex;
+                }
+            }
+            while (scan < vertexCount)
+            {
+                if (live[scan] > 0)
+                {
+                    return scan;
+                }
+                scan++;
+            }
+            return unused_vertex;
+        };
+
+        u32 fanning = skipDeadEnd();
+        while (fanning != unused_vertex)
+        {
+            // emit every triangle around the fanning vertex
+            candidates.clear();
+            for (u32 i = offsets[fanning]; i < offsets[fanning + 1]; i++)
+            {
+                const u32 triangle = adjacency[i];
+                if (emitted[triangle] != 0)
+                {
+                    continue;
+                }
+                emitted[triangle] = 1;
+
+                for (u32 corner = 0; corner < 3; corner++)
+                {
+                    const u32 vertex = indices[triangle * 3 + corner];
+                    output.push_back(vertex);
+                    deadEnd.push_back(vertex);
+                    candidates.push_back(vertex);
+                    live[vertex]--;
+                    if (time - cacheTime[vertex] > cacheSize)
+                    {
+                        cacheTime[vertex] = time++;
+                    }
+                }
+            }
+
+            // the oldest candidate that stays cached while its own fan is
+            // drawn, any live candidate when none does
+            u32 next = unused_vertex;
+            i64 bestPriority = -1;
+            for (const u32 vertex : candidates)
+            {
+                if (live[vertex] == 0)
+                {
+                    continue;
+                }
+
+                i64 priority = 0;
+                if (time - cacheTime[vertex] + 2 * live[vertex] <= cacheSize)
+                {
+                    priority = time - cacheTime[vertex];
+                }
+                if (priority > bestPriority)
+                {
+                    bestPriority = priority;
+                    next = vertex;
+                }
+            }
+
+            fanning = next != unused_vertex ? next : skipDeadEnd();
+        }
+
+        memcpy(indices.data(), output.data(), output.size() * sizeof(u32));
+    }
+
+    void optimizeOverdraw(span<u32> indices, const span<const Vector3f> positions,
+                          const f32 threshold, const u32 cacheSize)
+    {
+        const u32 vertexCount = static_cast<u32>(positions.size());
+        if (indices.size() < 3 || !valid_triangles(indices, vertexCount))
+        {
+            return;
+        }
+
+        const size_t triangleCount = indices.size() / 3;
+
+        // a triangle missing the cache on every vertex is where the vertex
+        // cache stage started a new fan from scratch, clusters can move
+        // freely there
+        FifoCache cache(vertexCount, cacheSize);
+        std::vector<u32> hardBoundaries;
+        u32 totalMisses = 0;
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            const u32 misses = cache.access(indices.data() + t * 3);
+            if (misses == 3)
+            {
+                hardBoundaries.push_back(static_cast<u32>(t));
+            }
+            totalMisses += misses;
+        }
+        hardBoundaries.push_back(static_cast<u32>(triangleCount));
+        const f32 acmr =
+            static_cast<f32>(totalMisses) / static_cast<f32>(triangleCount);
+
+        // split further wherever the part so far already reuses the cache
+        // about as well as the whole mesh does
+        std::vector<u32> clusters;
+        for (size_t h = 0; h + 1 < hardBoundaries.size(); h++)
+        {
+            const u32 end = hardBoundaries[h + 1];
+            u32 start = hardBoundaries[h];
+            u32 misses = 0;
+            clusters.push_back(start);
+            cache.flush();
+            for (u32 t = start; t < end; t++)
+            {
+                misses += cache.access(indices.data() + t * 3);
+                if (t + 1 < end && static_cast<f32>(misses) <=
+                                       threshold * acmr *
+                                           static_cast<f32>(t + 1 - start))
+                {
+                    start = t + 1;
+                    misses = 0;
+                    clusters.push_back(start);
+                    cache.flush();
+                }
+            }
+        }
+        clusters.push_back(static_cast<u32>(triangleCount));
+
+        // area weighted centroid and normal of every cluster
+        const size_t clusterCount = clusters.size() - 1;
+        std::vector<Vector3f> centroids(clusterCount);
+        std::vector<Vector3f> clusterNormals(clusterCount);
+        Vector3f meshCentroid(0, 0, 0);
+        f32 meshArea = 0.0f;
+        for (size_t c = 0; c < clusterCount; c++)
+        {
+            Vector3f centroid(0, 0, 0);
+            Vector3f normal(0, 0, 0);
+            f32 area = 0.0f;
+            for (u32 t = clusters[c]; t < clusters[c + 1]; t++)
+            {
+                const Vector3f& p0 = positions[indices[t * 3 + 0]];
+                const Vector3f& p1 = positions[indices[t * 3 + 1]];
+                const Vector3f& p2 = positions[indices[t * 3 + 2]];
+                const Vector3f n = (p1 - p0).cross(p2 - p0);
+                const f32 a = n.length();
+                centroid = centroid + (p0 + p1 + p2) * (a / 3.0f);
+                normal = normal + n;
+                area += a;
+            }
+
+            meshCentroid = meshCentroid + centroid;
+            meshArea += area;
+            centroids[c] = area > 0.0f ? centroid / area : centroid;
+            const f32 length = normal.length();
+            clusterNormals[c] = length > 0.0f ? normal / length : normal;
+        }
+        if (meshArea > 0.0f)
+        {
+            meshCentroid = meshCentroid / meshArea;
+        }
+
+        // clusters facing away from the centre first, they occlude the rest
+        std::vector<f32> keys(clusterCount);
+        std::vector<u32> order(clusterCount);
+        for (size_t c = 0; c < clusterCount; c++)
+        {
+            keys[c] = (centroids[c] - meshCentroid).dot(clusterNormals[c]);
+            order[c] = static_cast<u32>(c);
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&keys](const u32 lhs, const u32 rhs) {
+                             return keys[lhs] > keys[rhs];
+                         });
+
+        std::vector<u32> output;
+        output.reserve(indices.size());
+        for (const u32 c : order)
+        {
+            output.insert(output.end(), indices.data() + clusters[c] * 3,
+                          indices.data() + clusters[c + 1] * 3);
+        }
+        memcpy(indices.data(), output.data(), output.size() * sizeof(u32));
+    }
+
+    u32 optimizeVertexFetch(Mesh& mesh)
+    {
+        const u32 vertexCount = static_cast<u32>(mesh.positions.size());
+        if (mesh.triangles.empty() || !streams_match(mesh) ||
+            !valid_triangles(span<const u32>(mesh.triangles.data(),
+                                             mesh.triangles.size()),
+                             vertexCount))
+        {
+            return vertexCount;
+        }
+
+        std::vector<u32> remap(vertexCount, unused_vertex);
+        u32 next = 0;
+        for (const u32 index : mesh.triangles)
+        {
+            if (remap[index] == unused_vertex)
+            {
+                remap[index] = next++;
+            }
+        }
+
+        remap_vertices(mesh, remap, next);
+        return next;
+    }
+
+    static void optimize_single(Mesh& mesh)
+    {
+        if (mesh.triangles.empty() || mesh.positions.empty())
+        {
+            return;
+        }
+
+        deduplicateVertices(mesh);
+
+        const span<u32> indices(mesh.triangles.data(), mesh.triangles.size());
+        optimizeVertexCache(indices, static_cast<u32>(mesh.positions.size()));
+        optimizeOverdraw(indices, span<const Vector3f>(mesh.positions.data(),
+                                                       mesh.positions.size()));
+
+        optimizeVertexFetch(mesh);
+        mesh.calculateBounds();
+
+        if (mesh.bufferCount() > 0)
+        {
+            mesh.build(mesh.vertexFormat());
+        }
+    }
+
+    void optimizeMesh(Mesh& mesh, JobSystem* jobs)
+    {
+        const auto optimizeSubMeshes = [&mesh](const size_t begin,
+                                               const size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                optimize_single(*mesh.subMeshes[i]);
+            }
+        };
+
+        if (jobs != nullptr)
+        {
+            jobs->parallelFor(mesh.subMeshes.size(), 1, optimizeSubMeshes);
+        }
+        else
+        {
+            optimizeSubMeshes(0, mesh.subMeshes.size());
+        }
+
+        optimize_single(mesh);
+        mesh.calculateBounds();
+    }
+} // namespace helios
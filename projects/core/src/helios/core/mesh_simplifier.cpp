@@ -0,0 +1,730 @@
+#include <helios/core/mesh_simplifier.hpp>
+
+#include <helios/core/job_system.hpp>
+#include <helios/core/mesh_optimizer.hpp>
+#include <helios/math/bounds.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace helios
+{
+    static constexpr u32 no_vertex = ~0u;
+
+    // more than one open edge leaves or enters the vertex
+    static constexpr u32 many_vertices = ~0u - 1;
+
+    // Border and seam edges also get a quadric keeping them in place, this
+    // much stronger than the surface around them.
+    static constexpr f32 open_edge_weight = 2.0f;
+
+    // What a vertex may do, decided from the open edges around it. An edge
+    // is open when no triangle uses it the other way round.
+    enum class EVertexKind : u8
+    {
+        // closed fan, collapses into any neighbour
+        MANIFOLD,
+        // one open edge in and one out, slides along them
+        BORDER,
+        // one of two vertices at a position, each with one open edge in and
+        // out mirroring the other's, both slide along the seam together
+        SEAM,
+        // anything else stays
+        LOCKED
+    };
+
+    struct Quadric
+    {
+        f32 a00 = 0.0f;
+        f32 a11 = 0.0f;
+        f32 a22 = 0.0f;
+        f32 a10 = 0.0f;
+        f32 a20 = 0.0f;
+        f32 a21 = 0.0f;
+        f32 b0 = 0.0f;
+        f32 b1 = 0.0f;
+        f32 b2 = 0.0f;
+        f32 c = 0.0f;
+        f32 w = 0.0f;
+    };
+
+    struct Collapse
+    {
+        u32 from;
+        u32 to;
+        f32 error;
+    };
+
+    // Directed edges of a triangle list in an open addressed table.
+    class EdgeSet
+    {
+    public:
+        explicit EdgeSet(const size_t edges)
+        {
+            size_t size = 1;
+            while (size < edges * 2)
+            {
+                size *= 2;
+            }
+            _slots.assign(size, empty_slot);
+        }
+
+        void insert(const u32 from, const u32 to)
+        {
+            const u64 key = edge_key(from, to);
+            size_t slot = hash(key);
+            while (_slots[slot] != empty_slot && _slots[slot] != key)
+            {
+                slot = (slot + 1) & (_slots.size() - 1);
+            }
+            _slots[slot] = key;
+        }
+
+        bool contains(const u32 from, const u32 to) const
+        {
+            const u64 key = edge_key(from, to);
+            size_t slot = hash(key);
+            while (_slots[slot] != empty_slot)
+            {
+                if (_slots[slot] == key)
+                {
+                    return true;
+                }
+                slot = (slot + 1) & (_slots.size() - 1);
+            }
+            return false;
+        }
+
+    private:
+        static constexpr u64 empty_slot = ~u64(0);
+
+        static u64 edge_key(const u32 from, const u32 to)
+        {
+            return (static_cast<u64>(from) << 32) | to;
+        }
+
+        size_t hash(const u64 key) const
+        {
+            u64 h = key * 0x9E3779B97F4A7C15ull;
+            h ^= h >> 29;
+            return static_cast<size_t>(h) & (_slots.size() - 1);
+        }
+
+        std::vector<u64> _slots;
+    };
+
+    static Quadric plane_quadric(const Vector3f& normal, const f32 distance,
+                                 const f32 weight)
+    {
+        Quadric q;
+        q.a00 = normal.x * normal.x * weight;
+        q.a11 = normal.y * normal.y * weight;
+        q.a22 = normal.z * normal.z * weight;
+        q.a10 = normal.y * normal.x * weight;
+        q.a20 = normal.z * normal.x * weight;
+        q.a21 = normal.z * normal.y * weight;
+        q.b0 = normal.x * distance * weight;
+        q.b1 = normal.y * distance * weight;
+        q.b2 = normal.z * distance * weight;
+        q.c = distance * distance * weight;
+        q.w = weight;
+        return q;
+    }
+
+    static void add_quadric(Quadric& q, const Quadric& other)
+    {
+        q.a00 += other.a00;
+        q.a11 += other.a11;
+        q.a22 += other.a22;
+        q.a10 += other.a10;
+        q.a20 += other.a20;
+        q.a21 += other.a21;
+        q.b0 += other.b0;
+        q.b1 += other.b1;
+        q.b2 += other.b2;
+        q.c += other.c;
+        q.w += other.w;
+    }
+
+    // weighted mean squared distance of the point to the planes
+    static f32 quadric_error(const Quadric& q, const Vector3f& v)
+    {
+        const f32 rx = q.b0 + q.a00 * v.x + q.a10 * v.y + q.a20 * v.z;
+        const f32 ry = q.b1 + q.a10 * v.x + q.a11 * v.y + q.a21 * v.z;
+        const f32 rz = q.b2 + q.a20 * v.x + q.a21 * v.y + q.a22 * v.z;
+        const f32 r = rx * v.x + ry * v.y + rz * v.z +
+                      (q.b0 * v.x + q.b1 * v.y + q.b2 * v.z) + q.c;
+        return q.w > 0.0f ? std::fabs(r) / q.w : std::fabs(r);
+    }
+
+    static f32 position_extent(const span<const Vector3f> positions)
+    {
+        const AABB box = AABB::fromPoints(positions.data(), positions.size());
+        return std::max(std::max(box.max.x - box.min.x, box.max.y - box.min.y),
+                        box.max.z - box.min.z);
+    }
+
+    // Links every vertex into a ring of the vertices sharing its exact
+    // position and names the first of them as the position's id.
+    static void build_wedges(const span<const Vector3f> positions,
+                             std::vector<u32>& positionIds,
+                             std::vector<u32>& wedges)
+    {
+        const u32 vertexCount = static_cast<u32>(positions.size());
+        size_t tableSize = 1;
+        while (tableSize < static_cast<size_t>(vertexCount) * 2)
+        {
+            tableSize *= 2;
+        }
+        std::vector<u32> table(tableSize, no_vertex);
+
+        positionIds.resize(vertexCount);
+        wedges.resize(vertexCount);
+        for (u32 i = 0; i < vertexCount; i++)
+        {
+            const f32 xyz[3] = {positions[i].x, positions[i].y, positions[i].z};
+            u32 bits[3];
+            memcpy(bits, xyz, sizeof(bits));
+            u32 hash = 0x811C9DC5u;
+            for (const u32 value : bits)
+            {
+                hash = (hash ^ value) * 0x9E3779B1u;
+                hash ^= hash >> 15;
+            }
+
+            size_t slot = hash & (tableSize - 1);
+            while (true)
+            {
+                const u32 existing = table[slot];
+                if (existing == no_vertex)
+                {
+                    table[slot] = i;
+                    positionIds[i] = i;
+                    wedges[i] = i;
+                    break;
+                }
+                if (memcmp(&positions[existing].x, &xyz[0], sizeof(f32)) == 0 &&
+                    memcmp(&positions[existing].y, &xyz[1], sizeof(f32)) == 0 &&
+                    memcmp(&positions[existing].z, &xyz[2], sizeof(f32)) == 0)
+                {
+                    positionIds[i] = existing;
+                    wedges[i] = wedges[existing];
+                    wedges[existing] = i;
+                    break;
+                }
+                slot = (slot + 1) & (tableSize - 1);
+            }
+        }
+    }
+
+    static void record_open_edge(u32& slot, const u32 vertex)
+    {
+        slot = slot == no_vertex ? vertex : many_vertices;
+    }
+
+    static bool single_edge(const u32 vertex)
+    {
+        return vertex != no_vertex && vertex != many_vertices;
+    }
+
+    static void classify_vertices(const vector<u32>& indices,
+                                  const std::vector<u32>& positionIds,
+                                  const std::vector<u32>& wedges,
+                                  std::vector<EVertexKind>& kinds,
+                                  std::vector<u32>& openIn,
+                                  std::vector<u32>& openOut)
+    {
+        const size_t vertexCount = positionIds.size();
+        EdgeSet edges(indices.size());
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            for (u32 e = 0; e < 3; e++)
+            {
+                edges.insert(indices[t + e], indices[t + (e + 1) % 3]);
+            }
+        }
+
+        openIn.assign(vertexCount, no_vertex);
+        openOut.assign(vertexCount, no_vertex);
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            for (u32 e = 0; e < 3; e++)
+            {
+                const u32 from = indices[t + e];
+                const u32 to = indices[t + (e + 1) % 3];
+                if (!edges.contains(to, from))
+                {
+                    record_open_edge(openOut[from], to);
+                    record_open_edge(openIn[to], from);
+                }
+            }
+        }
+
+        kinds.assign(vertexCount, EVertexKind::LOCKED);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            const u32 sibling = wedges[v];
+            if (sibling == v)
+            {
+                if (openIn[v] == no_vertex && openOut[v] == no_vertex)
+                {
+                    kinds[v] = EVertexKind::MANIFOLD;
+                }
+                else if (single_edge(openIn[v]) && single_edge(openOut[v]))
+                {
+                    kinds[v] = EVertexKind::BORDER;
+                }
+            }
+            else if (wedges[sibling] == v && single_edge(openIn[v]) &&
+                     single_edge(openOut[v]) && single_edge(openIn[sibling]) &&
+                     single_edge(openOut[sibling]) &&
+                     positionIds[openOut[v]] == positionIds[openIn[sibling]] &&
+                     positionIds[openIn[v]] == positionIds[openOut[sibling]])
+            {
+                kinds[v] = EVertexKind::SEAM;
+            }
+        }
+    }
+
+    // Each position gets the planes of its triangles, and open edges a
+    // plane through the edge at right angles to the triangle. normals
+    // receives the area weighted normal of every position.
+    static void build_quadrics(const vector<u32>& indices,
+                               const std::vector<Vector3f>& points,
+                               const std::vector<u32>& positionIds,
+                               const std::vector<u32>& openOut,
+                               std::vector<Quadric>& quadrics,
+                               std::vector<Vector3f>& normals)
+    {
+        quadrics.assign(points.size(), Quadric());
+        normals.assign(points.size(), Vector3f(0.0f, 0.0f, 0.0f));
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            const Vector3f& p0 = points[indices[t + 0]];
+            const Vector3f& p1 = points[indices[t + 1]];
+            const Vector3f& p2 = points[indices[t + 2]];
+            Vector3f normal = (p1 - p0).cross(p2 - p0);
+            const f32 area = normal.length();
+            if (area <= 0.0f)
+            {
+                continue;
+            }
+            normal = normal / area;
+
+            const Quadric q = plane_quadric(normal, -normal.dot(p0), area);
+            for (u32 e = 0; e < 3; e++)
+            {
+                add_quadric(quadrics[positionIds[indices[t + e]]], q);
+                normals[positionIds[indices[t + e]]] += normal * area;
+            }
+
+            for (u32 e = 0; e < 3; e++)
+            {
+                const u32 from = indices[t + e];
+                const u32 to = indices[t + (e + 1) % 3];
+                if (openOut[from] != to)
+                {
+                    continue;
+                }
+
+                const Vector3f edge = points[to] - points[from];
+                const f32 length = edge.length();
+                Vector3f edgeNormal = edge.cross(normal);
+                const f32 edgeNormalLength = edgeNormal.length();
+                if (edgeNormalLength <= 0.0f)
+                {
+                    continue;
+                }
+                edgeNormal = edgeNormal / edgeNormalLength;
+
+                const Quadric edgeQuadric =
+                    plane_quadric(edgeNormal, -edgeNormal.dot(points[from]),
+                                  length * length * open_edge_weight);
+                add_quadric(quadrics[positionIds[from]], edgeQuadric);
+                add_quadric(quadrics[positionIds[to]], edgeQuadric);
+            }
+        }
+    }
+
+    static bool can_collapse(const u32 from, const u32 to,
+                             const std::vector<EVertexKind>& kinds,
+                             const std::vector<u32>& openIn,
+                             const std::vector<u32>& openOut)
+    {
+        switch (kinds[from])
+        {
+        case EVertexKind::MANIFOLD:
+            return true;
+        case EVertexKind::BORDER:
+        case EVertexKind::SEAM:
+            return openOut[from] == to || openIn[from] == to;
+        default:
+            return false;
+        }
+    }
+
+    // Would moving every vertex at the collapsed position to the target turn
+    // a surviving triangle around by more than about 75 degrees?
+    static bool flips_triangles(const u32 from, const u32 to,
+                                const vector<u32>& indices,
+                                const std::vector<Vector3f>& points,
+                                const std::vector<Vector3f>& normals,
+                                const std::vector<u32>& positionIds,
+                                const std::vector<u32>& wedges,
+                                const std::vector<u32>& adjacencyOffsets,
+                                const std::vector<u32>& adjacency)
+    {
+        const u32 target = positionIds[to];
+        u32 vertex = from;
+        do
+        {
+            for (u32 i = adjacencyOffsets[vertex];
+                 i < adjacencyOffsets[vertex + 1]; i++)
+            {
+                const u32* triangle = indices.data() + adjacency[i] * 3;
+                if (positionIds[triangle[0]] == target ||
+                    positionIds[triangle[1]] == target ||
+                    positionIds[triangle[2]] == target)
+                {
+                    continue;
+                }
+
+                Vector3f corners[3];
+                for (u32 c = 0; c < 3; c++)
+                {
+                    corners[c] = points[triangle[c]];
+                }
+                const Vector3f before =
+                    (corners[1] - corners[0]).cross(corners[2] - corners[0]);
+                for (u32 c = 0; c < 3; c++)
+                {
+                    if (positionIds[triangle[c]] == positionIds[from])
+                    {
+                        corners[c] = points[to];
+                    }
+                }
+                const Vector3f after =
+                    (corners[1] - corners[0]).cross(corners[2] - corners[0]);
+
+                if (before.dot(after) <=
+                    0.25f * before.length() * after.length())
+                {
+                    return true;
+                }
+
+                // small turns add up over many passes, so the result also
+                // has to face the way the original surface did
+                for (u32 c = 0; c < 3; c++)
+                {
+                    if (after.dot(normals[positionIds[triangle[c]]]) <= 0.0f)
+                    {
+                        return true;
+                    }
+                }
+            }
+            vertex = wedges[vertex];
+        } while (vertex != from);
+        return false;
+    }
+
+    vector<u32> simplify(const span<const u32> indices,
+                         const span<const Vector3f> positions,
+                         const size_t targetIndexCount, const f32 targetError,
+                         f32* resultError)
+    {
+        vector<u32> result;
+        result.reserve(indices.size());
+        for (const u32 index : indices)
+        {
+            result.push_back(index);
+        }
+        if (resultError != nullptr)
+        {
+            *resultError = 0.0f;
+        }
+
+        const u32 vertexCount = static_cast<u32>(positions.size());
+        if (result.size() % 3 != 0 || result.size() <= targetIndexCount)
+        {
+            return result;
+        }
+        for (const u32 index : result)
+        {
+            if (index >= vertexCount)
+            {
+                return result;
+            }
+        }
+
+        // work in the unit cube so errors are relative to the mesh size
+        const AABB box = AABB::fromPoints(positions.data(), positions.size());
+        const f32 extent = position_extent(positions);
+        const f32 scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+        std::vector<Vector3f> points(vertexCount);
+        for (u32 i = 0; i < vertexCount; i++)
+        {
+            points[i] = (positions[i] - box.min) * scale;
+        }
+
+        std::vector<u32> positionIds;
+        std::vector<u32> wedges;
+        build_wedges(positions, positionIds, wedges);
+
+        std::vector<EVertexKind> kinds;
+        std::vector<u32> openIn;
+        std::vector<u32> openOut;
+        classify_vertices(result, positionIds, wedges, kinds, openIn, openOut);
+
+        std::vector<Quadric> quadrics;
+        std::vector<Vector3f> normals;
+        build_quadrics(result, points, positionIds, openOut, quadrics, normals);
+
+        const f32 errorLimit = targetError * targetError;
+        f32 largestError = 0.0f;
+
+        std::vector<u32> adjacencyOffsets;
+        std::vector<u32> adjacency;
+        std::vector<Collapse> collapses;
+        std::vector<u32> remap(vertexCount);
+        std::vector<u8> locked(vertexCount);
+
+        while (result.size() > targetIndexCount)
+        {
+            // triangles around every vertex
+            adjacencyOffsets.assign(static_cast<size_t>(vertexCount) + 1, 0);
+            for (const u32 index : result)
+            {
+                adjacencyOffsets[index + 1]++;
+            }
+            for (u32 i = 0; i < vertexCount; i++)
+            {
+                adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+            }
+            adjacency.resize(result.size());
+            {
+                std::vector<u32> cursor(adjacencyOffsets.begin(),
+                                        adjacencyOffsets.end() - 1);
+                for (size_t i = 0; i < result.size(); i++)
+                {
+                    adjacency[cursor[result[i]]++] = static_cast<u32>(i / 3);
+                }
+            }
+
+            // every allowed collapse along a triangle edge, cheapest first
+            collapses.clear();
+            for (size_t t = 0; t < result.size(); t += 3)
+            {
+                for (u32 e = 0; e < 3; e++)
+                {
+                    const u32 a = result[t + e];
+                    const u32 b = result[t + (e + 1) % 3];
+                    if (can_collapse(a, b, kinds, openIn, openOut))
+                    {
+                        collapses.push_back(
+                            {a, b,
+                             quadric_error(quadrics[positionIds[a]], points[b])});
+                    }
+                    if (can_collapse(b, a, kinds, openIn, openOut))
+                    {
+                        collapses.push_back(
+                            {b, a,
+                             quadric_error(quadrics[positionIds[b]], points[a])});
+                    }
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(),
+                      [](const Collapse& lhs, const Collapse& rhs) {
+                          return lhs.error < rhs.error;
+                      });
+
+            // Apply them while they stay within the error and the triangle
+            // goal, touching each position once per pass so the costs above
+            // stay valid.
+            for (u32 i = 0; i < vertexCount; i++)
+            {
+                remap[i] = i;
+            }
+            std::fill(locked.begin(), locked.end(), u8(0));
+
+            const size_t trianglesToRemove =
+                (result.size() - targetIndexCount) / 3 + 1;
+            size_t trianglesRemoved = 0;
+            size_t applied = 0;
+            for (const Collapse& collapse : collapses)
+            {
+                if (collapse.error > errorLimit ||
+                    trianglesRemoved >= trianglesToRemove)
+                {
+                    break;
+                }
+
+                const u32 from = collapse.from;
+                const u32 to = collapse.to;
+                const u32 fromId = positionIds[from];
+                const u32 toId = positionIds[to];
+                if (locked[fromId] != 0 || locked[toId] != 0 ||
+                    flips_triangles(from, to, result, points, normals, positionIds,
+                                    wedges, adjacencyOffsets, adjacency))
+                {
+                    continue;
+                }
+
+                remap[from] = to;
+                if (kinds[from] == EVertexKind::SEAM)
+                {
+                    // the other side of the seam follows along its own edge
+                    const u32 sibling = wedges[from];
+                    remap[sibling] =
+                        openOut[from] == to ? openIn[sibling] : openOut[sibling];
+                }
+
+                // The triangles on the collapsed edge disappear. Every
+                // vertex around the collapse is locked as well, so no other
+                // collapse this pass changes a triangle the flip test above
+                // looked at.
+                u32 vertex = from;
+                do
+                {
+                    for (u32 a = adjacencyOffsets[vertex];
+                         a < adjacencyOffsets[vertex + 1]; a++)
+                    {
+                        const u32* triangle = result.data() + adjacency[a] * 3;
+                        bool onEdge = false;
+                        for (u32 c = 0; c < 3; c++)
+                        {
+                            onEdge |= positionIds[triangle[c]] == toId;
+                            locked[positionIds[triangle[c]]] = 1;
+                        }
+                        trianglesRemoved += onEdge ? 1 : 0;
+                    }
+                    vertex = wedges[vertex];
+                } while (vertex != from);
+
+                add_quadric(quadrics[toId], quadrics[fromId]);
+                largestError = std::max(largestError, collapse.error);
+                applied++;
+            }
+
+            if (applied == 0)
+            {
+                break;
+            }
+
+            // rewrite the triangles, dropping the ones that became lines
+            size_t write = 0;
+            for (size_t t = 0; t < result.size(); t += 3)
+            {
+                const u32 a = remap[result[t + 0]];
+                const u32 b = remap[result[t + 1]];
+                const u32 c = remap[result[t + 2]];
+                if (positionIds[a] == positionIds[b] ||
+                    positionIds[b] == positionIds[c] ||
+                    positionIds[a] == positionIds[c])
+                {
+                    continue;
+                }
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+
+            // collapsed vertices leave their wedge rings
+            for (u32 i = 0; i < vertexCount; i++)
+            {
+                if (remap[i] != i)
+                {
+                    u32 previous = i;
+                    while (wedges[previous] != i)
+                    {
+                        previous = wedges[previous];
+                    }
+                    wedges[previous] = wedges[i];
+                    wedges[i] = i;
+                }
+            }
+
+            classify_vertices(result, positionIds, wedges, kinds, openIn,
+                              openOut);
+        }
+
+        if (resultError != nullptr)
+        {
+            *resultError = std::sqrt(largestError);
+        }
+        return result;
+    }
+
+    static void generate_single(Mesh& mesh, const LodSettings& settings)
+    {
+        mesh.lods.clear();
+        if (mesh.triangles.size() < 3 || mesh.positions.empty())
+        {
+            return;
+        }
+
+        const span<const Vector3f> positions(mesh.positions.data(),
+                                             mesh.positions.size());
+        const f32 extent = position_extent(positions);
+        const size_t triangleCount = mesh.triangles.size() / 3;
+
+        mesh.lods.reserve(settings.ratios.size());
+        f32 error = 0.0f;
+        for (const f32 ratio : settings.ratios)
+        {
+            const vector<u32>& previous = mesh.lodTriangles(mesh.lodCount() - 1);
+            const size_t target =
+                static_cast<size_t>(static_cast<f32>(triangleCount) * ratio) * 3;
+            if (target >= previous.size())
+            {
+                continue;
+            }
+
+            f32 levelError = 0.0f;
+            vector<u32> triangles =
+                simplify(span<const u32>(previous.data(), previous.size()),
+                         positions, target, settings.maxError, &levelError);
+
+            // not worth a level of its own
+            if (triangles.empty() ||
+                triangles.size() * 20 > previous.size() * 19)
+            {
+                break;
+            }
+
+            optimizeVertexCache(span<u32>(triangles.data(), triangles.size()),
+                                static_cast<u32>(mesh.positions.size()));
+
+            // each level starts from the one before, their errors add up
+            error += levelError * extent;
+            MeshLod lod;
+            lod.triangles = std::move(triangles);
+            lod.error = error;
+            mesh.lods.push_back(std::move(lod));
+        }
+    }
+
+    void generateLods(Mesh& mesh, const LodSettings& settings, JobSystem* jobs)
+    {
+        const auto generateSubMeshes = [&](const size_t begin,
+                                           const size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                generate_single(*mesh.subMeshes[i], settings);
+            }
+        };
+
+        if (jobs != nullptr)
+        {
+            jobs->parallelFor(mesh.subMeshes.size(), 1, generateSubMeshes);
+        }
+        else
+        {
+            generateSubMeshes(0, mesh.subMeshes.size());
+        }
+
+        generate_single(mesh, settings);
+    }
+} // namespace helios
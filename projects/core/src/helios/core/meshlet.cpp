@@ -0,0 +1,437 @@
+#include <helios/core/meshlet.hpp>
+
+#include <helios/core/job_system.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace helios
+{
+    static constexpr u32 no_slot = ~0u;
+
+    // Cones whose normals spread further than this, as the smallest dot
+    // product with the axis, would almost never cull and are not worth a
+    // test.
+    static constexpr f32 min_cone_spread = 0.1f;
+
+    // The meshlet being grown, with the local slot of every mesh vertex it
+    // uses so far.
+    struct MeshletBuilder
+    {
+        std::vector<u32> slots;
+        std::vector<u32> vertices;
+        std::vector<u32> triangles;
+        f32 centroidSum[3] = {0.0f, 0.0f, 0.0f};
+
+        // scratch for the bounds
+        std::vector<Vector3f> points;
+        std::vector<Vector3f> normals;
+    };
+
+    static u32 new_vertices(const MeshletBuilder& builder, const u32* triangle)
+    {
+        return (builder.slots[triangle[0]] == no_slot ? 1 : 0) +
+               (builder.slots[triangle[1]] == no_slot ? 1 : 0) +
+               (builder.slots[triangle[2]] == no_slot ? 1 : 0);
+    }
+
+    // Triangle centres as plain floats, the growing loop compares a lot of
+    // them.
+    static void triangle_centroids(const span<const u32> indices,
+                                   const span<const Vector3f> positions,
+                                   std::vector<f32>& centroids)
+    {
+        centroids.resize(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            const Vector3f& p0 = positions[indices[i + 0]];
+            const Vector3f& p1 = positions[indices[i + 1]];
+            const Vector3f& p2 = positions[indices[i + 2]];
+            centroids[i + 0] = (p0.x + p1.x + p2.x) * (1.0f / 3.0f);
+            centroids[i + 1] = (p0.y + p1.y + p2.y) * (1.0f / 3.0f);
+            centroids[i + 2] = (p0.z + p1.z + p2.z) * (1.0f / 3.0f);
+        }
+    }
+
+    static void compute_bounds(Meshlet& meshlet, MeshletBuilder& builder,
+                               const span<const Vector3f> positions,
+                               const vector<u32>& meshletVertices,
+                               const vector<u8>& meshletTriangles)
+    {
+        std::vector<Vector3f>& points = builder.points;
+        std::vector<Vector3f>& normals = builder.normals;
+        points.clear();
+        normals.clear();
+        for (u32 i = 0; i < meshlet.vertexCount; i++)
+        {
+            points.push_back(positions[meshletVertices[meshlet.vertexOffset + i]]);
+        }
+        meshlet.bounds = BoundingSphere::fromPoints(points.data(), points.size());
+
+        // the cone around the mean of the unit normals
+        Vector3f axis(0.0f, 0.0f, 0.0f);
+        for (u32 t = 0; t < meshlet.triangleCount; t++)
+        {
+            const u8* triangle =
+                meshletTriangles.data() + meshlet.triangleOffset + t * 3;
+            const Vector3f& p0 = points[triangle[0]];
+            const Vector3f& p1 = points[triangle[1]];
+            const Vector3f& p2 = points[triangle[2]];
+            const Vector3f normal = (p1 - p0).cross(p2 - p0);
+            const f32 length = normal.length();
+            if (length <= 0.0f)
+            {
+                continue;
+            }
+            normals.push_back(normal / length);
+            axis += normals.back();
+        }
+
+        meshlet.coneAxis = Vector3f(0.0f, 0.0f, 0.0f);
+        meshlet.coneCutoff = 1.0f;
+        const f32 axisLength = axis.length();
+        if (axisLength <= 0.0f)
+        {
+            return;
+        }
+        axis = axis / axisLength;
+
+        f32 minDot = 1.0f;
+        for (const Vector3f& normal : normals)
+        {
+            minDot = std::min(minDot, normal.dot(axis));
+        }
+        if (minDot <= min_cone_spread)
+        {
+            return;
+        }
+
+        meshlet.coneAxis = axis;
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    static void flush_meshlet(MeshletBuilder& builder,
+                              const span<const Vector3f> positions,
+                              vector<Meshlet>& meshlets,
+                              vector<u32>& meshletVertices,
+                              vector<u8>& meshletTriangles)
+    {
+        if (builder.triangles.empty())
+        {
+            return;
+        }
+
+        Meshlet meshlet;
+        meshlet.vertexOffset = static_cast<u32>(meshletVertices.size());
+        meshlet.triangleOffset = static_cast<u32>(meshletTriangles.size());
+        meshlet.vertexCount = static_cast<u32>(builder.vertices.size());
+        meshlet.triangleCount = static_cast<u32>(builder.triangles.size() / 3);
+
+        if (meshletVertices.size() + builder.vertices.size() >
+            meshletVertices.capacity())
+        {
+            meshletVertices.reserve(meshletVertices.capacity() * 2 +
+                                    max_meshlet_vertices);
+        }
+        for (const u32 vertex : builder.vertices)
+        {
+            meshletVertices.push_back(vertex);
+        }
+        for (const u32 vertex : builder.triangles)
+        {
+            meshletTriangles.push_back(static_cast<u8>(builder.slots[vertex]));
+        }
+        compute_bounds(meshlet, builder, positions, meshletVertices,
+                       meshletTriangles);
+        if (meshlets.size() == meshlets.capacity())
+        {
+            meshlets.reserve(meshlets.capacity() * 2 + 1);
+        }
+        meshlets.push_back(meshlet);
+
+        for (const u32 vertex : builder.vertices)
+        {
+            builder.slots[vertex] = no_slot;
+        }
+        builder.vertices.clear();
+        builder.triangles.clear();
+        builder.centroidSum[0] = 0.0f;
+        builder.centroidSum[1] = 0.0f;
+        builder.centroidSum[2] = 0.0f;
+    }
+
+    void buildMeshlets(const span<const u32> indices,
+                       const span<const Vector3f> positions,
+                       vector<Meshlet>& meshlets, vector<u32>& meshletVertices,
+                       vector<u8>& meshletTriangles)
+    {
+        meshlets.clear();
+        meshletVertices.clear();
+        meshletTriangles.clear();
+
+        const u32 vertexCount = static_cast<u32>(positions.size());
+        const size_t triangleCount = indices.size() / 3;
+        for (const u32 index : indices)
+        {
+            if (index >= vertexCount)
+            {
+                return;
+            }
+        }
+
+        // triangles around every vertex
+        std::vector<u32> offsets(static_cast<size_t>(vertexCount) + 1, 0);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+        {
+            offsets[indices[i] + 1]++;
+        }
+        for (u32 i = 0; i < vertexCount; i++)
+        {
+            offsets[i + 1] += offsets[i];
+        }
+        std::vector<u32> adjacency(triangleCount * 3);
+        {
+            std::vector<u32> cursor(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < triangleCount * 3; i++)
+            {
+                adjacency[cursor[indices[i]]++] = static_cast<u32>(i / 3);
+            }
+        }
+
+        // most meshlets come out close to full, flush_meshlet grows these
+        // when they do not
+        const size_t expected = triangleCount / (max_meshlet_triangles / 2) + 1;
+        meshlets.reserve(expected);
+        meshletVertices.reserve(expected * max_meshlet_vertices);
+        meshletTriangles.reserve(triangleCount * 3);
+
+        MeshletBuilder builder;
+        builder.slots.assign(vertexCount, no_slot);
+        builder.vertices.reserve(max_meshlet_vertices);
+        builder.triangles.reserve(max_meshlet_triangles * 3);
+        builder.points.reserve(max_meshlet_vertices);
+        builder.normals.reserve(max_meshlet_triangles);
+
+        std::vector<f32> centroids;
+        triangle_centroids(indices.first(triangleCount * 3), positions,
+                           centroids);
+        std::vector<u8> emitted(triangleCount, 0);
+        size_t seed = 0;
+        size_t remaining = triangleCount;
+
+        while (remaining > 0)
+        {
+            // Among the triangles touching the meshlet, take the one adding
+            // the fewest vertices and then the one closest to its centre.
+            u32 best = no_slot;
+            u32 bestNew = 4;
+            f32 bestDistance = 0.0f;
+            if (!builder.triangles.empty())
+            {
+                const f32 scale =
+                    3.0f / static_cast<f32>(builder.triangles.size());
+                const f32 centre[3] = {builder.centroidSum[0] * scale,
+                                       builder.centroidSum[1] * scale,
+                                       builder.centroidSum[2] * scale};
+                for (const u32 vertex : builder.vertices)
+                {
+                    for (u32 a = offsets[vertex]; a < offsets[vertex + 1]; a++)
+                    {
+                        const u32 triangle = adjacency[a];
+                        if (emitted[triangle] != 0)
+                        {
+                            continue;
+                        }
+                        const u32* corners = indices.data() + triangle * 3;
+                        const u32 added = new_vertices(builder, corners);
+                        if (added > bestNew ||
+                            builder.vertices.size() + added >
+                                max_meshlet_vertices)
+                        {
+                            continue;
+                        }
+                        const f32* centroid = centroids.data() + triangle * 3;
+                        const f32 dx = centroid[0] - centre[0];
+                        const f32 dy = centroid[1] - centre[1];
+                        const f32 dz = centroid[2] - centre[2];
+                        const f32 distance = dx * dx + dy * dy + dz * dz;
+                        if (added < bestNew || distance < bestDistance)
+                        {
+                            best = triangle;
+                            bestNew = added;
+                            bestDistance = distance;
+                        }
+                    }
+                }
+            }
+
+            // Nothing connected fits, continue with the next triangle in
+            // order. After optimizeMesh that is usually close by.
+            if (best == no_slot)
+            {
+                while (emitted[seed] != 0)
+                {
+                    seed++;
+                }
+                if (builder.vertices.size() +
+                        new_vertices(builder, indices.data() + seed * 3) >
+                    max_meshlet_vertices)
+                {
+                    flush_meshlet(builder, positions, meshlets, meshletVertices,
+                                  meshletTriangles);
+                }
+                best = static_cast<u32>(seed);
+            }
+
+            const u32* corners = indices.data() + best * 3;
+            for (u32 c = 0; c < 3; c++)
+            {
+                if (builder.slots[corners[c]] == no_slot)
+                {
+                    builder.slots[corners[c]] =
+                        static_cast<u32>(builder.vertices.size());
+                    builder.vertices.push_back(corners[c]);
+                }
+                builder.triangles.push_back(corners[c]);
+            }
+            for (u32 c = 0; c < 3; c++)
+            {
+                builder.centroidSum[c] += centroids[best * 3 + c];
+            }
+            emitted[best] = 1;
+            remaining--;
+
+            if (builder.triangles.size() == max_meshlet_triangles * 3)
+            {
+                flush_meshlet(builder, positions, meshlets, meshletVertices,
+                              meshletTriangles);
+            }
+        }
+        flush_meshlet(builder, positions, meshlets, meshletVertices,
+                      meshletTriangles);
+    }
+
+    static void build_single(Mesh& mesh)
+    {
+        buildMeshlets(span<const u32>(mesh.triangles.data(), mesh.triangles.size()),
+                      span<const Vector3f>(mesh.positions.data(),
+                                           mesh.positions.size()),
+                      mesh.meshlets, mesh.meshletVertices, mesh.meshletTriangles);
+    }
+
+    void buildMeshlets(Mesh& mesh, JobSystem* jobs)
+    {
+        const auto buildSubMeshes = [&mesh](const size_t begin,
+                                            const size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                build_single(*mesh.subMeshes[i]);
+            }
+        };
+
+        if (jobs != nullptr)
+        {
+            jobs->parallelFor(mesh.subMeshes.size(), 1, buildSubMeshes);
+        }
+        else
+        {
+            buildSubMeshes(0, mesh.subMeshes.size());
+        }
+
+        build_single(mesh);
+    }
+
+    vector<u32> meshletIndices(const Mesh& mesh)
+    {
+        vector<u32> indices(mesh.meshletTriangles.size(), 0);
+        for (const Meshlet& meshlet : mesh.meshlets)
+        {
+            const u32* vertices = mesh.meshletVertices.data() + meshlet.vertexOffset;
+            for (u32 i = 0; i < meshlet.triangleCount * 3; i++)
+            {
+                const u32 index = meshlet.triangleOffset + i;
+                indices[index] = vertices[mesh.meshletTriangles[index]];
+            }
+        }
+        return indices;
+    }
+
+    bool isMeshletVisible(const Meshlet& meshlet, const Frustum& frustum,
+                          const Vector3f& cameraPosition)
+    {
+        if (!frustum.intersects(meshlet.bounds))
+        {
+            return false;
+        }
+        if (meshlet.coneCutoff >= 1.0f)
+        {
+            return true;
+        }
+
+        // Every triangle faces away when the direction to every point of
+        // the sphere lies within the cone, widened by the sphere's angular
+        // size.
+        const Vector3f toCentre = meshlet.bounds.center - cameraPosition;
+        return toCentre.dot(meshlet.coneAxis) <
+               meshlet.coneCutoff * toCentre.length() + meshlet.bounds.radius;
+    }
+
+    size_t cullMeshlets(const span<const Meshlet> meshlets,
+                        const Frustum& frustum, const Vector3f& cameraPosition,
+                        vector<DrawIndexedIndirectCommand>& commands)
+    {
+        commands.clear();
+        size_t visible = 0;
+        for (const Meshlet& meshlet : meshlets)
+        {
+            if (!isMeshletVisible(meshlet, frustum, cameraPosition))
+            {
+                continue;
+            }
+            visible++;
+
+            const u32 indexCount = meshlet.triangleCount * 3;
+            if (!commands.empty())
+            {
+                DrawIndexedIndirectCommand& last = commands.back();
+                if (last.firstIndex + last.indexCount == meshlet.triangleOffset)
+                {
+                    last.indexCount += indexCount;
+                    continue;
+                }
+            }
+            if (commands.size() == commands.capacity())
+            {
+                commands.reserve(commands.size() * 2 + 16);
+            }
+            commands.push_back({indexCount, 1, meshlet.triangleOffset, 0, 0});
+        }
+        return visible;
+    }
+
+    size_t cullMeshlets(const Mesh& mesh, const Frustum& frustum,
+                        const Vector3f& cameraPosition, vector<u32>& indices)
+    {
+        indices.clear();
+        indices.reserve(mesh.meshletTriangles.size());
+        size_t visible = 0;
+        for (const Meshlet& meshlet : mesh.meshlets)
+        {
+            if (!isMeshletVisible(meshlet, frustum, cameraPosition))
+            {
+                continue;
+            }
+            visible++;
+
+            const u32* vertices = mesh.meshletVertices.data() + meshlet.vertexOffset;
+            const u8* triangles =
+                mesh.meshletTriangles.data() + meshlet.triangleOffset;
+            for (u32 i = 0; i < meshlet.triangleCount * 3; i++)
+            {
+                indices.push_back(vertices[triangles[i]]);
+            }
+        }
+        return visible;
+    }
+} // namespace helios
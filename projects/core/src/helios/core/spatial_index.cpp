@@ -0,0 +1,223 @@
+#include <helios/core/spatial_index.hpp>
+
+namespace helios
+{
+    extern entt::registry& get_entt(EntityManager& manager);
+
+    // a batch at least this large, and at least 1/batch_fraction of the
+    // proxies, is refit instead of moved one by one
+    static constexpr size_t batch_min_moves = 1024;
+    static constexpr size_t batch_fraction = 8;
+
+    // moved proxies per job, a move costs one box transformation
+    static constexpr size_t update_grain = 512;
+
+    // rebuild once refits have grown the tree cost by this much
+    static constexpr f32 rebuild_cost_ratio = 1.5f;
+
+    static size_t entitySlot(const entt::entity entity) noexcept
+    {
+        using traits = entt::entt_traits<std::underlying_type_t<entt::entity>>;
+        return static_cast<size_t>(entt::to_integral(entity) &
+                                   traits::entity_mask);
+    }
+
+    SpatialIndex::SpatialIndex(EntityManager& manager, JobSystem& jobs)
+        : _manager(manager), _registry(get_entt(manager)), _jobs(jobs),
+          _seen(0), _builtCost(0.0f)
+    {
+        _manager.track<TransformationComponent>();
+
+        _registry.on_construct<BoundsComponent>()
+            .connect<&SpatialIndex::_onAdded>(*this);
+        _registry.on_update<BoundsComponent>()
+            .connect<&SpatialIndex::_onAdded>(*this);
+        _registry.on_destroy<BoundsComponent>()
+            .connect<&SpatialIndex::_onRemoved>(*this);
+
+        _registry.view<BoundsComponent>().each(
+            [this](const entt::entity entity, BoundsComponent&) {
+                _added.push_back(entity);
+            });
+    }
+
+    SpatialIndex::~SpatialIndex()
+    {
+        _registry.on_construct<BoundsComponent>().disconnect(*this);
+        _registry.on_update<BoundsComponent>().disconnect(*this);
+        _registry.on_destroy<BoundsComponent>().disconnect(*this);
+    }
+
+    void SpatialIndex::update()
+    {
+        const u64 now = _manager.advanceVersion();
+
+        for (const entt::entity entity : _added)
+        {
+            if (!_registry.valid(entity) ||
+                !_registry.has<BoundsComponent>(entity))
+            {
+                continue;
+            }
+
+            if (const u32 proxy = _proxy(entity);
+                proxy != DynamicAABBTree::null_node)
+            {
+                _place(entity, proxy);
+                continue;
+            }
+
+            const AABB bounds = _worldBounds(entity);
+            const u32 proxy = _tree.insert(bounds, 0);
+            if (proxy >= _bounds.size())
+            {
+                _bounds.resize(proxy + 1);
+                _entities.resize(proxy + 1, entt::null);
+            }
+            _bounds[proxy] = bounds;
+            _entities[proxy] = entity;
+
+            const size_t slot = entitySlot(entity);
+            if (slot >= _proxies.size())
+            {
+                _proxies.resize(slot + 1, DynamicAABBTree::null_node);
+            }
+            _proxies[slot] = proxy;
+            _builtCost = 0.0f;
+        }
+        _added.clear();
+
+        _moved.clear();
+        _manager.changed_since<TransformationComponent>(
+            _seen, [this](Entity e, const TransformationComponent& transform) {
+                const u32 proxy = _proxy(e._ent);
+                if (proxy != DynamicAABBTree::null_node)
+                {
+                    _moved.push_back(
+                        {proxy, &_registry.get<BoundsComponent>(e._ent).local,
+                         &transform});
+                }
+            });
+        _seen = now;
+
+        const bool batched = _moved.size() >= batch_min_moves &&
+                             _moved.size() * batch_fraction >= _tree.size();
+        if (!batched)
+        {
+            for (const Moved& moved : _moved)
+            {
+                const AABB bounds =
+                    moved.local->transform(moved.transform->getWorldTransform());
+                _bounds[moved.proxy] = bounds;
+                if (_tree.move(moved.proxy, bounds))
+                {
+                    _builtCost = 0.0f;
+                }
+            }
+            return;
+        }
+
+        if (_builtCost == 0.0f)
+        {
+            _builtCost = _tree.cost();
+        }
+
+        _jobs.parallelFor(_moved.size(), update_grain,
+                          [this](size_t begin, size_t end) {
+                              for (size_t i = begin; i < end; ++i)
+                              {
+                                  const Moved& moved = _moved[i];
+                                  const AABB bounds = moved.local->transform(
+                                      moved.transform->getWorldTransform());
+                                  _bounds[moved.proxy] = bounds;
+                                  _tree.setBounds(moved.proxy, bounds);
+                              }
+                          });
+        _tree.refit(&_jobs);
+
+        if (_tree.cost() > _builtCost * rebuild_cost_ratio)
+        {
+            _tree.rebuild(&_jobs);
+            _builtCost = _tree.cost();
+        }
+    }
+
+    bool SpatialIndex::raycastClosest(const Ray& ray, const f32 maxDistance,
+                                      Entity& hit, f32& distance) const
+    {
+        bool found = false;
+        raycast(ray, maxDistance, [&](Entity entity, const f32 d) {
+            found = true;
+            hit = entity;
+            distance = d;
+            return d;
+        });
+        return found;
+    }
+
+    size_t SpatialIndex::size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    const DynamicAABBTree& SpatialIndex::tree() const noexcept
+    {
+        return _tree;
+    }
+
+    u32 SpatialIndex::_proxy(const entt::entity entity) const noexcept
+    {
+        const size_t slot = entitySlot(entity);
+        if (slot >= _proxies.size())
+        {
+            return DynamicAABBTree::null_node;
+        }
+
+        // slots are reused, the entity check rejects an older version
+        const u32 proxy = _proxies[slot];
+        return proxy != DynamicAABBTree::null_node && _entities[proxy] == entity
+                   ? proxy
+                   : DynamicAABBTree::null_node;
+    }
+
+    void SpatialIndex::_place(const entt::entity entity, const u32 proxy)
+    {
+        const AABB bounds = _worldBounds(entity);
+        _bounds[proxy] = bounds;
+        if (_tree.move(proxy, bounds))
+        {
+            _builtCost = 0.0f;
+        }
+    }
+
+    AABB SpatialIndex::_worldBounds(const entt::entity entity) const
+    {
+        const AABB& local = _registry.get<BoundsComponent>(entity).local;
+        const auto* transform =
+            _registry.try_get<TransformationComponent>(entity);
+        return transform ? local.transform(transform->getWorldTransform())
+                         : local;
+    }
+
+    void SpatialIndex::_onAdded(entt::registry&, entt::entity entity)
+    {
+        _added.push_back(entity);
+    }
+
+    void SpatialIndex::_onRemoved(entt::registry&, entt::entity entity)
+    {
+        const u32 proxy = _proxy(entity);
+        if (proxy != DynamicAABBTree::null_node)
+        {
+            _tree.remove(proxy);
+            _entities[proxy] = entt::null;
+            _proxies[entitySlot(entity)] = DynamicAABBTree::null_node;
+            _builtCost = 0.0f;
+        }
+    }
+
+    Entity SpatialIndex::_entity(const u32 proxy) const
+    {
+        return Entity(_entities[proxy], &_manager);
+    }
+} // namespace helios
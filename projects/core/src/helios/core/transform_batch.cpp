@@ -0,0 +1,203 @@
+#include <helios/core/transform_batch.hpp>
+
+namespace helios
+{
+    // position, rotation and scale start at these component indices
+    static constexpr size_t position_component = 0;
+    static constexpr size_t rotation_component = 3;
+    static constexpr size_t scale_component = 6;
+
+    // blocks handed to a single job when rebuilding in parallel
+    static constexpr size_t rebuild_grain = 256;
+
+    TransformBatch::TransformBatch(const size_t capacity) : _size(0)
+    {
+        const size_t padded = (capacity + block_size - 1) / block_size *
+                              block_size;
+        for (auto& component : _components)
+        {
+            component.reserve(padded);
+        }
+        _matrices.reserve(padded);
+        _dirty.reserve(padded / block_size);
+    }
+
+    u32 TransformBatch::add(const Vector3f& position, const Vector3f& rotation,
+                            const Vector3f& scale)
+    {
+        const u32 index = static_cast<u32>(_size++);
+        if (_size > _matrices.size())
+        {
+            // grow a whole block at a time, the unused lanes hold the
+            // identity so the kernel can always process full blocks
+            const size_t padded = _matrices.size() + block_size;
+            for (size_t i = 0; i < 9; i++)
+            {
+                _components[i].resize(padded, i >= scale_component ? 1.0f
+                                                                   : 0.0f);
+            }
+            _matrices.resize(padded, Matrix4f(1.0f));
+            _dirty.push_back(0);
+        }
+
+        _set(index, position_component, position);
+        _set(index, rotation_component, rotation);
+        _set(index, scale_component, scale);
+        return index;
+    }
+
+    u32 TransformBatch::remove(const u32 index)
+    {
+        const u32 last = static_cast<u32>(_size - 1);
+        if (index != last)
+        {
+            for (auto& component : _components)
+            {
+                component[index] = component[last];
+            }
+            _matrices[index] = _matrices[last];
+            _dirty[index / block_size] = 1;
+        }
+
+        _set(last, position_component, Vector3f(0.0f, 0.0f, 0.0f));
+        _set(last, rotation_component, Vector3f(0.0f, 0.0f, 0.0f));
+        _set(last, scale_component, Vector3f(1.0f, 1.0f, 1.0f));
+        --_size;
+        return last;
+    }
+
+    void TransformBatch::clear()
+    {
+        for (auto& component : _components)
+        {
+            component.clear();
+        }
+        _matrices.clear();
+        _dirty.clear();
+        _size = 0;
+    }
+
+    Vector3f TransformBatch::position(const u32 index) const noexcept
+    {
+        return _get(index, position_component);
+    }
+
+    Vector3f TransformBatch::rotation(const u32 index) const noexcept
+    {
+        return _get(index, rotation_component);
+    }
+
+    Vector3f TransformBatch::scale(const u32 index) const noexcept
+    {
+        return _get(index, scale_component);
+    }
+
+    void TransformBatch::setPosition(const u32 index,
+                                     const Vector3f& position) noexcept
+    {
+        _set(index, position_component, position);
+    }
+
+    void TransformBatch::setRotation(const u32 index,
+                                     const Vector3f& rotation) noexcept
+    {
+        _set(index, rotation_component, rotation);
+    }
+
+    void TransformBatch::setScale(const u32 index,
+                                  const Vector3f& scale) noexcept
+    {
+        _set(index, scale_component, scale);
+    }
+
+    void TransformBatch::rebuild(JobSystem* jobs)
+    {
+        const size_t blocks = _dirty.size();
+        if (jobs == nullptr)
+        {
+            _rebuildBlocks(0, blocks);
+            return;
+        }
+
+        jobs->parallelFor(blocks, rebuild_grain,
+                          [this](const size_t begin, const size_t end) {
+                              _rebuildBlocks(begin, end);
+                          });
+    }
+
+    bool TransformBatch::dirty(const u32 index) const noexcept
+    {
+        return _dirty[index / block_size] != 0;
+    }
+
+    size_t TransformBatch::size() const noexcept
+    {
+        return _size;
+    }
+
+    const Matrix4f* TransformBatch::matrices() const noexcept
+    {
+        return _matrices.data();
+    }
+
+    size_t TransformBatch::matrixBytes() const noexcept
+    {
+        return _size * sizeof(Matrix4f);
+    }
+
+    void TransformBatch::_set(const u32 index, const size_t component,
+                              const Vector3f& value) noexcept
+    {
+        _components[component][index] = value.x;
+        _components[component + 1][index] = value.y;
+        _components[component + 2][index] = value.z;
+        _dirty[index / block_size] = 1;
+    }
+
+    Vector3f TransformBatch::_get(const u32 index,
+                                  const size_t component) const noexcept
+    {
+        return Vector3f(_components[component][index],
+                        _components[component + 1][index],
+                        _components[component + 2][index]);
+    }
+
+    TransformArrays TransformBatch::_arrays() const noexcept
+    {
+        TransformArrays arrays;
+        for (size_t i = 0; i < 3; i++)
+        {
+            arrays.position[i] = _components[position_component + i].data();
+            arrays.rotation[i] = _components[rotation_component + i].data();
+            arrays.scale[i] = _components[scale_component + i].data();
+        }
+        return arrays;
+    }
+
+    void TransformBatch::_rebuildBlocks(const size_t first,
+                                        const size_t last) noexcept
+    {
+        const TransformArrays arrays = _arrays();
+        size_t block = first;
+        while (block < last)
+        {
+            if (_dirty[block] == 0)
+            {
+                ++block;
+                continue;
+            }
+
+            // consecutive dirty blocks go through the kernel in one call
+            size_t end = block;
+            while (end < last && _dirty[end] != 0)
+            {
+                _dirty[end] = 0;
+                ++end;
+            }
+            composeTransforms(arrays, block * block_size,
+                              (end - block) * block_size,
+                              _matrices.data() + block * block_size);
+            block = end;
+        }
+    }
+} // namespace helios
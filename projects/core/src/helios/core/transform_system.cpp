@@ -0,0 +1,226 @@
+#include <helios/core/transform_system.hpp>
+
+#include <helios/math/transformations.hpp>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace helios
+{
+    extern entt::registry& get_entt(EntityManager& manager);
+
+    static constexpr u32 no_parent = ~0U;
+
+    // nodes per job, a node costs roughly one matrix multiply
+    static constexpr size_t update_grain = 256;
+
+    TransformSystem::TransformSystem(EntityManager& manager, JobSystem& jobs)
+        : _manager(manager), _registry(get_entt(manager)), _jobs(jobs),
+          _topologyChanged(true)
+    {
+        _manager.track<TransformationComponent>();
+
+        // component storage moves on construction and destruction, so the
+        // cached node pointers have to be rebuilt
+        _registry.on_construct<TransformationComponent>()
+            .connect<&TransformSystem::_onTopologyChanged>(*this);
+        _registry.on_destroy<TransformationComponent>()
+            .connect<&TransformSystem::_onTopologyChanged>(*this);
+        _registry.on_construct<HierarchyComponent>()
+            .connect<&TransformSystem::_onTopologyChanged>(*this);
+        _registry.on_update<HierarchyComponent>()
+            .connect<&TransformSystem::_onTopologyChanged>(*this);
+        _registry.on_destroy<HierarchyComponent>()
+            .connect<&TransformSystem::_onTopologyChanged>(*this);
+
+        // an owning group over TransformationComponent swaps entities inside
+        // its pool when they join or leave, without any of the above firing
+        _manager.on_reorder<TransformationComponent>()
+            .connect<&TransformSystem::_onTopologyChanged>(*this);
+        _manager.on_reorder<ComponentVersion<TransformationComponent>>()
+            .connect<&TransformSystem::_onTopologyChanged>(*this);
+    }
+
+    TransformSystem::~TransformSystem()
+    {
+        _registry.on_construct<TransformationComponent>().disconnect(*this);
+        _registry.on_destroy<TransformationComponent>().disconnect(*this);
+        _registry.on_construct<HierarchyComponent>().disconnect(*this);
+        _registry.on_update<HierarchyComponent>().disconnect(*this);
+        _registry.on_destroy<HierarchyComponent>().disconnect(*this);
+        _manager.on_reorder<TransformationComponent>().disconnect(*this);
+        _manager.on_reorder<ComponentVersion<TransformationComponent>>()
+            .disconnect(*this);
+    }
+
+    bool TransformSystem::setParent(Entity child, Entity parent)
+    {
+        const entt::entity c = child.handle();
+        entt::entity ancestor = parent.handle();
+        while (ancestor != entt::null && _registry.valid(ancestor))
+        {
+            if (ancestor == c)
+            {
+                return false;
+            }
+
+            const auto* hierarchy =
+                _registry.try_get<HierarchyComponent>(ancestor);
+            ancestor = hierarchy ? hierarchy->parent : entt::entity(entt::null);
+        }
+
+        _registry.emplace_or_replace<HierarchyComponent>(c, parent.handle());
+        _topologyChanged = true;
+        if (auto* transform = _registry.try_get<TransformationComponent>(c))
+        {
+            transform->_dirty = true;
+        }
+        return true;
+    }
+
+    void TransformSystem::removeParent(Entity child)
+    {
+        const entt::entity c = child.handle();
+        if (_registry.has<HierarchyComponent>(c))
+        {
+            _registry.remove<HierarchyComponent>(c);
+            if (auto* transform = _registry.try_get<TransformationComponent>(c))
+            {
+                transform->_dirty = true;
+            }
+        }
+    }
+
+    void TransformSystem::update()
+    {
+        const bool force = _topologyChanged;
+        if (_topologyChanged)
+        {
+            _rebuild();
+            _topologyChanged = false;
+        }
+
+        const u64 version = _manager.version();
+        const size_t levelCount = _levels.size() - 1;
+        for (size_t level = 0; level < levelCount; ++level)
+        {
+            const u32 first = _levels[level];
+            const u32 count = _levels[level + 1] - first;
+            _jobs.parallelFor(
+                count, update_grain,
+                [this, first, force, version](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        _updateNode(first + static_cast<u32>(i), force,
+                                    version);
+                    }
+                });
+        }
+    }
+
+    void TransformSystem::_rebuild()
+    {
+        _nodes.clear();
+        _versions.clear();
+        _parents.clear();
+        _levels.clear();
+
+        // helios::vector grows one element at a time, so size everything up
+        // front or the rebuild turns quadratic in the node count
+        const size_t count = _registry.size<TransformationComponent>();
+        _nodes.reserve(count);
+        _versions.reserve(count);
+        _parents.reserve(count);
+
+        // entities whose parent is missing or has no transformation are roots
+        std::unordered_map<entt::entity, std::vector<entt::entity>> children;
+        children.reserve(count);
+        std::vector<std::pair<entt::entity, u32>> frontier;
+        frontier.reserve(count);
+        _registry.view<TransformationComponent>().each(
+            [&](const entt::entity entity, TransformationComponent&) {
+                const auto* hierarchy =
+                    _registry.try_get<HierarchyComponent>(entity);
+                const bool hasParent =
+                    hierarchy && hierarchy->parent != entt::null &&
+                    _registry.valid(hierarchy->parent) &&
+                    _registry.has<TransformationComponent>(hierarchy->parent);
+                if (hasParent)
+                {
+                    children[hierarchy->parent].push_back(entity);
+                }
+                else
+                {
+                    frontier.emplace_back(entity, no_parent);
+                }
+            });
+
+        // breadth first, so every level is one contiguous run of nodes
+        std::vector<std::pair<entt::entity, u32>> next;
+        next.reserve(count);
+        while (!frontier.empty())
+        {
+            // the depth is only known once the walk is done, so double
+            if (_levels.size() + 1 >= _levels.capacity())
+            {
+                _levels.reserve(_levels.capacity() * 2 + 16);
+            }
+            _levels.push_back(static_cast<u32>(_nodes.size()));
+            next.clear();
+            for (const auto& [entity, parent] : frontier)
+            {
+                const u32 index = static_cast<u32>(_nodes.size());
+                _nodes.push_back(
+                    &_registry.get<TransformationComponent>(entity));
+                _versions.push_back(
+                    &_registry.get<ComponentVersion<TransformationComponent>>(
+                        entity));
+                _parents.push_back(parent);
+
+                const auto it = children.find(entity);
+                if (it != children.end())
+                {
+                    for (const entt::entity child : it->second)
+                    {
+                        next.emplace_back(child, index);
+                    }
+                }
+            }
+            std::swap(frontier, next);
+        }
+        _levels.push_back(static_cast<u32>(_nodes.size()));
+
+        _changed.resize(_nodes.size());
+    }
+
+    void TransformSystem::_updateNode(const u32 index, const bool force,
+                                      const u64 version) noexcept
+    {
+        TransformationComponent& node = *_nodes[index];
+        const u32 parent = _parents[index];
+
+        bool changed = force || (parent != no_parent && _changed[parent]);
+        if (node._dirty)
+        {
+            node._transform =
+                transform(node._position, node._rotation, node._scale);
+            node._dirty = false;
+            changed = true;
+        }
+
+        if (changed)
+        {
+            node._world = parent == no_parent
+                              ? node._transform
+                              : _nodes[parent]->_world * node._transform;
+            _versions[index]->version = version;
+        }
+        _changed[index] = changed ? 1 : 0;
+    }
+
+    void TransformSystem::_onTopologyChanged(entt::registry&, entt::entity)
+    {
+        _topologyChanged = true;
+    }
+} // namespace helios
@@ -10,7 +10,6 @@ namespace helios
         _position = pos;
         _rotation = rot;
         _scale = sca;
-        _transform = transform(_position, _rotation, _scale);
     }
 
     Vector3f TransformationComponent::getPosition() const noexcept
@@ -21,7 +20,7 @@ namespace helios
     void TransformationComponent::setPosition(const Vector3f& pos) noexcept
     {
         _position = pos;
-        _transform = transform(_position, _rotation, _scale);
+        _dirty = true;
     }
 
     Vector3f TransformationComponent::getRotation() const noexcept
@@ -32,7 +31,7 @@ namespace helios
     void TransformationComponent::setRotation(const Vector3f& rot) noexcept
     {
         _rotation = rot;
-        _transform = transform(_position, _rotation, _scale);
+        _dirty = true;
     }
 
     Vector3f TransformationComponent::getScale() const noexcept
@@ -43,11 +42,27 @@ namespace helios
     void TransformationComponent::setScale(const Vector3f& sca) noexcept
     {
         _scale = sca;
-        _transform = transform(_position, _rotation, _scale);
+        _dirty = true;
     }
 
     Matrix4f TransformationComponent::getTransform() const noexcept
     {
+        // setters only flag the component, build the matrix on demand until
+        // the system catches up
+        if (_dirty)
+        {
+            return transform(_position, _rotation, _scale);
+        }
         return _transform;
     }
-} // namespace helios
\ No newline at end of file
+
+    Matrix4f TransformationComponent::getWorldTransform() const noexcept
+    {
+        return _world;
+    }
+
+    bool TransformationComponent::isDirty() const noexcept
+    {
+        return _dirty;
+    }
+} // namespace helios
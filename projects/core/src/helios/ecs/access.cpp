@@ -0,0 +1,48 @@
+#include <helios/ecs/access.hpp>
+
+namespace helios
+{
+    bool ComponentAccess::reads(const entt::id_type component) const noexcept
+    {
+        for (const entt::id_type id : _reads)
+        {
+            if (id == component)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ComponentAccess::writes(const entt::id_type component) const noexcept
+    {
+        for (const entt::id_type id : _writes)
+        {
+            if (id == component)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ComponentAccess::conflicts(const ComponentAccess& other) const noexcept
+    {
+        for (const entt::id_type id : _writes)
+        {
+            if (other.reads(id) || other.writes(id))
+            {
+                return true;
+            }
+        }
+
+        for (const entt::id_type id : other._writes)
+        {
+            if (reads(id))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace helios
@@ -0,0 +1,277 @@
+#include <helios/ecs/command_buffer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <tuple>
+
+namespace helios
+{
+    extern entt::registry& get_entt(EntityManager& manager);
+
+    static constexpr size_t command_block_size = 16 * 1024;
+
+    // streams the calling thread recently used, so recording only takes the
+    // buffer lock the first time a thread records into a buffer
+    static constexpr size_t cached_stream_count = 8;
+
+    static std::atomic<u64> next_buffer_id(1);
+
+    CommandBuffer::Recorder::Recorder(Stream& stream, const u64 key)
+        : _stream(stream), _key(key), _sequence(0)
+    {
+    }
+
+    PendingEntity CommandBuffer::Recorder::create()
+    {
+        PendingEntity entity;
+        entity._stream = _stream.index;
+        entity._index = _stream.created++;
+        _stream.commands.push_back({_key, _sequence++, CommandKind::CREATE,
+                                    entt::null, entity._index, nullptr,
+                                    nullptr});
+        return entity;
+    }
+
+    void CommandBuffer::Recorder::release(const Entity& entity)
+    {
+        _stream.commands.push_back({_key, _sequence++, CommandKind::RELEASE,
+                                    entity.handle(), ~0U, nullptr, nullptr});
+    }
+
+    void* CommandBuffer::Stream::allocate(const size_t size,
+                                          const size_t alignment)
+    {
+        const auto fits = [&](size_t& offset) {
+            if (blocks.empty())
+            {
+                return false;
+            }
+            const auto base = reinterpret_cast<uintptr_t>(blocks.back().get());
+            const uintptr_t aligned =
+                (base + blockUsed + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            offset = static_cast<size_t>(aligned - base);
+            return offset + size <= blockSize;
+        };
+
+        size_t offset = 0;
+        if (!fits(offset))
+        {
+            blockSize = std::max(command_block_size, size + alignment);
+            blocks.push_back(std::make_unique<std::byte[]>(blockSize));
+            blockUsed = 0;
+            fits(offset);
+        }
+
+        blockUsed = offset + size;
+        return blocks.back().get() + offset;
+    }
+
+    void CommandBuffer::Stream::clear()
+    {
+        for (const Command& command : commands)
+        {
+            if (command.payload)
+            {
+                command.ops->destroy(command.payload);
+            }
+        }
+        commands.clear();
+        created = 0;
+
+        // keep the first block around for the next frame
+        if (blocks.size() > 1 || blockSize != command_block_size)
+        {
+            blocks.clear();
+        }
+        blockUsed = 0;
+    }
+
+    CommandBuffer::CommandBuffer(EntityManager& manager)
+        : _manager(manager), _registry(get_entt(manager)),
+          _id(next_buffer_id.fetch_add(1, std::memory_order_relaxed))
+    {
+    }
+
+    CommandBuffer::~CommandBuffer()
+    {
+        for (auto& stream : _streams)
+        {
+            stream->clear();
+        }
+    }
+
+    CommandBuffer::Recorder CommandBuffer::record(const u64 sortKey)
+    {
+        return Recorder(_local(), sortKey);
+    }
+
+    CommandBuffer::Recorder CommandBuffer::record(const Entity& source)
+    {
+        return record(static_cast<u64>(entt::to_integral(source.handle())));
+    }
+
+    void CommandBuffer::playback()
+    {
+        struct Entry
+        {
+            const Command* command;
+            Stream* stream;
+        };
+
+        std::vector<Entry> structural;
+        std::vector<Entry> changes;
+        for (auto& stream : _streams)
+        {
+            stream->resolved.assign(stream->created, entt::null);
+            for (const Command& command : stream->commands)
+            {
+                const bool component = command.kind == CommandKind::ASSIGN ||
+                                       command.kind == CommandKind::REMOVE;
+                (component ? changes : structural)
+                    .push_back({&command, stream.get()});
+            }
+        }
+
+        // streams are per thread, so the stream index only breaks ties
+        // between recorders that shared a key on the same thread
+        const auto recorded = [](const Entry& lhs, const Entry& rhs) {
+            return std::make_tuple(lhs.command->key, lhs.command->sequence,
+                                   lhs.stream->index) <
+                   std::make_tuple(rhs.command->key, rhs.command->sequence,
+                                   rhs.stream->index);
+        };
+        std::sort(structural.begin(), structural.end(), recorded);
+        std::sort(changes.begin(), changes.end(), recorded);
+        std::stable_sort(changes.begin(), changes.end(),
+                         [](const Entry& lhs, const Entry& rhs) {
+                             return lhs.command->ops->id < rhs.command->ops->id;
+                         });
+
+        for (const Entry& entry : structural)
+        {
+            if (entry.command->kind == CommandKind::CREATE)
+            {
+                entry.stream->resolved[entry.command->pending] =
+                    _registry.create();
+            }
+        }
+
+        const auto target = [](const Entry& entry) {
+            const Command& command = *entry.command;
+            return command.pending == ~0U
+                       ? command.entity
+                       : entry.stream->resolved[command.pending];
+        };
+
+        for (size_t first = 0; first < changes.size();)
+        {
+            const ComponentOps* ops = changes[first].command->ops;
+            size_t last = first;
+            size_t assigns = 0;
+            while (last < changes.size() &&
+                   changes[last].command->ops->id == ops->id)
+            {
+                assigns += changes[last].command->kind == CommandKind::ASSIGN;
+                ++last;
+            }
+
+            ops->reserve(_registry, assigns);
+            for (size_t i = first; i < last; ++i)
+            {
+                const Command& command = *changes[i].command;
+                const entt::entity entity = target(changes[i]);
+                if (!_registry.valid(entity))
+                {
+                    continue;
+                }
+
+                if (command.kind == CommandKind::ASSIGN)
+                {
+                    ops->assign(_registry, entity, command.payload);
+                }
+                else
+                {
+                    ops->remove(_registry, entity);
+                }
+            }
+            first = last;
+        }
+
+        for (const Entry& entry : structural)
+        {
+            if (entry.command->kind == CommandKind::RELEASE &&
+                _registry.valid(entry.command->entity))
+            {
+                _registry.destroy(entry.command->entity);
+            }
+        }
+
+        for (auto& stream : _streams)
+        {
+            stream->clear();
+        }
+    }
+
+    Entity CommandBuffer::resolve(const PendingEntity& entity) const
+    {
+        std::lock_guard<std::mutex> lock(_streamMutex);
+        return Entity(_streams[entity._stream]->resolved[entity._index],
+                      &_manager);
+    }
+
+    bool CommandBuffer::empty() const
+    {
+        std::lock_guard<std::mutex> lock(_streamMutex);
+        for (const auto& stream : _streams)
+        {
+            if (!stream->commands.empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    CommandBuffer::Stream& CommandBuffer::_local()
+    {
+        struct CachedStream
+        {
+            u64 buffer;
+            Stream* stream;
+        };
+        static thread_local std::vector<CachedStream> cache;
+
+        for (const CachedStream& cached : cache)
+        {
+            if (cached.buffer == _id)
+            {
+                return *cached.stream;
+            }
+        }
+
+        Stream* stream = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_streamMutex);
+            Stream*& slot = _threadStreams[std::this_thread::get_id()];
+            if (slot == nullptr)
+            {
+                auto created = std::make_unique<Stream>();
+                created->index = static_cast<u32>(_streams.size());
+                created->created = 0;
+                created->blockUsed = 0;
+                created->blockSize = 0;
+                slot = created.get();
+                _streams.push_back(std::move(created));
+            }
+            stream = slot;
+        }
+
+        if (cache.size() == cached_stream_count)
+        {
+            cache.erase(cache.begin());
+        }
+        cache.push_back({_id, stream});
+        return *stream;
+    }
+} // namespace helios
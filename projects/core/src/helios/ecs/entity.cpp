@@ -2,6 +2,10 @@
 
 #include <entt/entt.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
 namespace helios
 {
     Entity::Entity(entt::entity e, EntityManager* manager)
@@ -9,6 +13,10 @@ namespace helios
     {
     }
 
+    EntityManager::EntityManager(JobSystem* jobs) : _jobs(jobs), _version(1)
+    {
+    }
+
     Entity EntityManager::create()
     {
         return Entity(_registry.create(), this);
@@ -24,6 +32,120 @@ namespace helios
         _registry.clear();
     }
 
+    std::vector<const EntityManager::HeldAccess*>& EntityManager::
+        _heldAccess() noexcept
+    {
+        // innermost last
+        static thread_local std::vector<const HeldAccess*> held;
+        return held;
+    }
+
+    EntityManager::AccessGuard::AccessGuard(EntityManager& manager,
+                                            const ComponentAccess& access)
+        : _manager(manager), _access(access),
+          _held{&manager, &access, nullptr, JobSystem::currentJob(), false,
+                false},
+          _nested(false), _rejected(false)
+    {
+        std::vector<const HeldAccess*>& held = _heldAccess();
+
+        // the callback running on this thread, unless a job picked up while
+        // waiting started this query
+        for (auto it = held.rbegin();
+             it != held.rend() && (*it)->job == _held.job; ++it)
+        {
+            if ((*it)->callback)
+            {
+                _held.parent = *it;
+                break;
+            }
+        }
+
+        // Waiting for a query this one was started from would never return.
+        // Running inline is a plain nested loop while every callback up to it
+        // runs one at a time, otherwise sibling ranges would race with it.
+        bool serial = true;
+        for (const HeldAccess* outer = _held.parent; outer != nullptr;
+             outer = outer->parent)
+        {
+            serial = serial && outer->serial;
+            if (outer->manager == &_manager && outer->access->conflicts(_access))
+            {
+                assert(serial &&
+                       "conflicting query started from a parallel range");
+                _nested = serial;
+                _rejected = !serial;
+                return;
+            }
+        }
+
+        // whatever else this thread holds sits below a job it picked up while
+        // waiting, and only finishes after this query
+        for (const HeldAccess* below : held)
+        {
+            if (below->manager == &_manager && below->access->conflicts(_access))
+            {
+                assert(!"conflicting query started from a job run while "
+                        "waiting on it");
+                _rejected = true;
+                return;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(_manager._accessMutex);
+        _manager._accessReleased.wait(lock, [this]() {
+            for (const ComponentAccess* active : _manager._activeAccess)
+            {
+                if (active->conflicts(_access))
+                {
+                    return false;
+                }
+            }
+            return true;
+        });
+        _manager._activeAccess.push_back(&_access);
+        held.push_back(&_held);
+    }
+
+    EntityManager::AccessGuard::~AccessGuard()
+    {
+        if (_nested || _rejected)
+        {
+            return;
+        }
+
+        _heldAccess().pop_back();
+        {
+            std::lock_guard<std::mutex> lock(_manager._accessMutex);
+            auto& active = _manager._activeAccess;
+            active.erase(std::find(active.begin(), active.end(), &_access));
+        }
+        _manager._accessReleased.notify_all();
+    }
+
+    bool EntityManager::AccessGuard::nested() const noexcept
+    {
+        return _nested;
+    }
+
+    bool EntityManager::AccessGuard::rejected() const noexcept
+    {
+        return _rejected;
+    }
+
+    EntityManager::AccessScope::AccessScope(const AccessGuard& guard,
+                                            const bool serial)
+        : _held{guard._held.manager, guard._held.access, guard._held.parent,
+                JobSystem::currentJob(), serial, true}
+    {
+        _heldAccess().push_back(&_held);
+    }
+
+    EntityManager::AccessScope::~AccessScope()
+    {
+        _heldAccess().pop_back();
+    }
+
     entt::registry& get_entt(EntityManager& manager)
     {
         return manager._registry;
@@ -0,0 +1,351 @@
+#include <helios/ecs/snapshot.hpp>
+
+#include <helios/io/file.hpp>
+
+#include <algorithm>
+
+namespace helios
+{
+    extern entt::registry& get_entt(EntityManager& manager);
+
+    static constexpr u32 snapshot_magic = 0x504E5348; // "HSNP"
+
+    // component blobs start on a cache line so they can be copied or mapped
+    // without fixing up their alignment
+    static constexpr size_t blob_alignment = 64;
+
+    static_assert(sizeof(entt::entity) == sizeof(u32),
+                  "snapshots store entities as 32 bit identifiers");
+
+    struct SnapshotHeader
+    {
+        u32 magic;
+        u32 version;
+        u32 pools;
+        u32 reserved;
+        u64 entities;
+    };
+
+    struct SnapshotPoolHeader
+    {
+        u64 type;
+        u32 size;
+        u32 alignment;
+        u64 count;
+    };
+
+    static size_t align_up(const size_t offset, const size_t alignment)
+    {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    static size_t entity_slot(const entt::entity entity)
+    {
+        return static_cast<size_t>(entt::to_integral(entity) &
+                                   entt::entt_traits<u32>::entity_mask);
+    }
+
+    entt::entity EntityRemap::operator()(const entt::entity saved) const noexcept
+    {
+        if (saved == entt::null)
+        {
+            return entt::null;
+        }
+
+        const size_t slot = entity_slot(saved);
+        if (slot >= _saved.size() || _saved[slot] != saved)
+        {
+            return entt::null;
+        }
+        return _loaded[slot];
+    }
+
+    std::vector<u8> Snapshot::save(EntityManager& manager) const
+    {
+        const entt::registry& registry = get_entt(manager);
+
+        std::vector<entt::entity> entities;
+        entities.reserve(registry.alive());
+        registry.each([&](const entt::entity entity) {
+            entities.push_back(entity);
+        });
+
+        size_t size = sizeof(SnapshotHeader) +
+                      entities.size() * sizeof(entt::entity);
+        for (const Pool& pool : _pools)
+        {
+            const size_t count = pool.count(registry);
+            size = align_up(size, alignof(SnapshotPoolHeader)) +
+                   sizeof(SnapshotPoolHeader) + count * sizeof(entt::entity);
+            size = align_up(size, blob_alignment) + count * pool.size;
+        }
+
+        std::vector<u8> data(size);
+        u8* output = data.data();
+
+        SnapshotHeader header;
+        header.magic = snapshot_magic;
+        header.version = format_version;
+        header.pools = static_cast<u32>(_pools.size());
+        header.reserved = 0;
+        header.entities = entities.size();
+        memcpy(output, &header, sizeof(header));
+
+        size_t offset = sizeof(SnapshotHeader);
+        if (!entities.empty())
+        {
+            memcpy(output + offset, entities.data(),
+                   entities.size() * sizeof(entt::entity));
+        }
+        offset += entities.size() * sizeof(entt::entity);
+
+        for (const Pool& pool : _pools)
+        {
+            SnapshotPoolHeader poolHeader;
+            poolHeader.type = pool.type;
+            poolHeader.size = pool.size;
+            poolHeader.alignment = pool.alignment;
+            poolHeader.count = pool.count(registry);
+
+            offset = align_up(offset, alignof(SnapshotPoolHeader));
+            memcpy(output + offset, &poolHeader, sizeof(poolHeader));
+            offset += sizeof(poolHeader);
+
+            u8* ids = output + offset;
+            offset = align_up(offset + poolHeader.count * sizeof(entt::entity),
+                              blob_alignment);
+            u8* blob = output + offset;
+            offset += poolHeader.count * pool.size;
+
+            // the entity list is not aligned for entt::entity, copy through
+            // a scratch buffer
+            std::vector<entt::entity> scratch(poolHeader.count);
+            pool.save(registry, scratch.data(), blob);
+            if (!scratch.empty())
+            {
+                memcpy(ids, scratch.data(),
+                       scratch.size() * sizeof(entt::entity));
+            }
+        }
+
+        return data;
+    }
+
+    ESnapshotResult Snapshot::load(EntityManager& manager, const u8* data,
+                                   const size_t size) const
+    {
+        struct LoadedPool
+        {
+            const Pool* pool;
+            size_t count;
+            const u8* ids;
+            const u8* blob;
+        };
+
+        if (size < sizeof(SnapshotHeader))
+        {
+            return ESnapshotResult::INVALID_HEADER;
+        }
+
+        SnapshotHeader header;
+        memcpy(&header, data, sizeof(header));
+        if (header.magic != snapshot_magic)
+        {
+            return ESnapshotResult::INVALID_HEADER;
+        }
+        if (header.version != format_version)
+        {
+            return ESnapshotResult::UNSUPPORTED_VERSION;
+        }
+
+        size_t offset = sizeof(SnapshotHeader);
+        if (header.entities > (size - offset) / sizeof(entt::entity))
+        {
+            return ESnapshotResult::TRUNCATED;
+        }
+
+        const size_t entityCount = static_cast<size_t>(header.entities);
+        std::vector<entt::entity> saved(entityCount);
+        if (entityCount > 0)
+        {
+            memcpy(saved.data(), data + offset,
+                   entityCount * sizeof(entt::entity));
+        }
+        offset += entityCount * sizeof(entt::entity);
+
+        EntityRemap remap;
+        for (const entt::entity entity : saved)
+        {
+            if (entity == entt::null)
+            {
+                return ESnapshotResult::INVALID_ENTITY;
+            }
+
+            const size_t slot = entity_slot(entity);
+            if (slot >= remap._saved.size())
+            {
+                remap._saved.resize(slot + 1, entt::null);
+            }
+            if (remap._saved[slot] != entt::null)
+            {
+                return ESnapshotResult::INVALID_ENTITY;
+            }
+            remap._saved[slot] = entity;
+        }
+
+        // validate everything before touching the registry. Both the pool
+        // types and the entities of a pool are unique in a valid snapshot,
+        // duplicates would insert the same component twice.
+        std::vector<LoadedPool> pools;
+        std::vector<u64> types;
+        std::vector<u32> listedIn(remap._saved.size(), ~0u);
+        for (u32 i = 0; i < header.pools; i++)
+        {
+            offset = align_up(offset, alignof(SnapshotPoolHeader));
+            if (offset > size || size - offset < sizeof(SnapshotPoolHeader))
+            {
+                return ESnapshotResult::TRUNCATED;
+            }
+
+            SnapshotPoolHeader poolHeader;
+            memcpy(&poolHeader, data + offset, sizeof(poolHeader));
+            offset += sizeof(poolHeader);
+
+            if (poolHeader.count > entityCount)
+            {
+                return ESnapshotResult::INVALID_ENTITY;
+            }
+
+            const size_t count = static_cast<size_t>(poolHeader.count);
+            const u8* ids = data + offset;
+            if (size - offset < count * sizeof(entt::entity))
+            {
+                return ESnapshotResult::TRUNCATED;
+            }
+            offset = align_up(offset + count * sizeof(entt::entity),
+                              blob_alignment);
+
+            const size_t blobSize = count * poolHeader.size;
+            if (offset > size || size - offset < blobSize)
+            {
+                return ESnapshotResult::TRUNCATED;
+            }
+            const u8* blob = data + offset;
+            offset += blobSize;
+
+            if (std::find(types.begin(), types.end(), poolHeader.type) !=
+                types.end())
+            {
+                return ESnapshotResult::COMPONENT_MISMATCH;
+            }
+            types.push_back(poolHeader.type);
+
+            const Pool* pool = nullptr;
+            for (const Pool& candidate : _pools)
+            {
+                if (candidate.type == poolHeader.type)
+                {
+                    pool = &candidate;
+                    break;
+                }
+            }
+            if (pool == nullptr)
+            {
+                continue;
+            }
+            if (pool->size != poolHeader.size ||
+                pool->alignment != poolHeader.alignment)
+            {
+                return ESnapshotResult::COMPONENT_MISMATCH;
+            }
+
+            for (size_t j = 0; j < count; j++)
+            {
+                entt::entity entity;
+                memcpy(&entity, ids + j * sizeof(entt::entity), sizeof(entity));
+                const size_t slot = entity_slot(entity);
+                if (slot >= remap._saved.size() ||
+                    remap._saved[slot] != entity || listedIn[slot] == i)
+                {
+                    return ESnapshotResult::INVALID_ENTITY;
+                }
+                listedIn[slot] = i;
+            }
+
+            pools.push_back({pool, count, ids, blob});
+        }
+
+        entt::registry& registry = get_entt(manager);
+
+        std::vector<entt::entity> created(entityCount);
+        registry.reserve(registry.size() + entityCount);
+        registry.create(created.begin(), created.end());
+        remap._loaded.assign(remap._saved.size(), entt::null);
+        for (size_t i = 0; i < entityCount; i++)
+        {
+            remap._loaded[entity_slot(saved[i])] = created[i];
+        }
+
+        std::vector<std::vector<entt::entity>> remapped;
+        std::vector<entt::entity> entities;
+        for (const LoadedPool& loaded : pools)
+        {
+            entities.resize(loaded.count);
+            memcpy(entities.data(), loaded.ids,
+                   loaded.count * sizeof(entt::entity));
+            for (entt::entity& entity : entities)
+            {
+                entity = remap._loaded[entity_slot(entity)];
+            }
+
+            loaded.pool->load(registry, entities.data(), loaded.count,
+                              loaded.blob);
+            if (loaded.pool->remap)
+            {
+                remapped.push_back(entities);
+            }
+        }
+
+        // handles are fixed up once every pool is in, remap functions may
+        // look at other components
+        size_t next = 0;
+        for (const LoadedPool& loaded : pools)
+        {
+            if (loaded.pool->remap)
+            {
+                const std::vector<entt::entity>& targets = remapped[next++];
+                loaded.pool->remap(registry, targets.data(), targets.size(),
+                                   remap);
+            }
+        }
+
+        return ESnapshotResult::SUCCESS;
+    }
+
+    bool Snapshot::saveFile(EntityManager& manager,
+                            const std::string& path) const
+    {
+        const std::vector<u8> data = save(manager);
+        return File::write_binary(path, data.data(), data.size());
+    }
+
+    ESnapshotResult Snapshot::loadFile(EntityManager& manager,
+                                       const std::string& path) const
+    {
+        const MappedFile file(path, EFileAccess::WILL_NEED);
+        const span<const u8> data = file.bytes();
+        return load(manager, data.data(), data.size());
+    }
+
+    u64 Snapshot::_hash(const std::string& name) noexcept
+    {
+        // FNV-1a, stable across builds unlike entt's type ids
+        u64 hash = 0xCBF29CE484222325ULL;
+        for (const char c : name)
+        {
+            hash ^= static_cast<u8>(c);
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+} // namespace helios
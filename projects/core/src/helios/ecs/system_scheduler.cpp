@@ -0,0 +1,125 @@
+#include <helios/ecs/system_scheduler.hpp>
+
+#include <chrono>
+
+namespace helios
+{
+    SystemScheduler::SystemScheduler(EntityManager& manager, JobSystem& jobs)
+        : _manager(manager), _jobs(jobs), _frameMilliseconds(0.0),
+          _graphChanged(false)
+    {
+    }
+
+    void SystemScheduler::run()
+    {
+        if (_systems.empty())
+        {
+            return;
+        }
+
+        if (_graphChanged)
+        {
+            _buildGraph();
+            _graphChanged = false;
+        }
+
+        for (size_t i = 0; i < _systems.size(); ++i)
+        {
+            _waiting[i].store(_systems[i].dependencyCount,
+                              std::memory_order_relaxed);
+        }
+
+        const auto frameStart = std::chrono::steady_clock::now();
+        std::atomic<size_t> remaining(_systems.size());
+        for (u32 i = 0; i < _systems.size(); ++i)
+        {
+            if (_systems[i].dependencyCount == 0)
+            {
+                _schedule(i, remaining, frameStart);
+            }
+        }
+        _jobs.wait(remaining);
+
+        _frameMilliseconds = std::chrono::duration<f64, std::milli>(
+                                 std::chrono::steady_clock::now() - frameStart)
+                                 .count();
+    }
+
+    const vector<SystemScheduler::Timing>& SystemScheduler::timings()
+        const noexcept
+    {
+        return _timings;
+    }
+
+    f64 SystemScheduler::frameMilliseconds() const noexcept
+    {
+        return _frameMilliseconds;
+    }
+
+    void SystemScheduler::_add(const std::string& name,
+                               ComponentAccess access,
+                               std::function<void(EntityManager&)> fn)
+    {
+        _systems.push_back({name, std::move(access), std::move(fn), {}, 0});
+        _timings.push_back({name, 0.0, 0.0});
+        _graphChanged = true;
+    }
+
+    void SystemScheduler::_buildGraph()
+    {
+        // registration order breaks ties, so a later system waits for every
+        // earlier one it conflicts with. Keeping only the edges to the
+        // nearest conflicting systems is not worth it for a few dozen
+        // systems.
+        for (auto& system : _systems)
+        {
+            system.dependents.clear();
+            system.dependencyCount = 0;
+        }
+
+        for (u32 later = 0; later < _systems.size(); ++later)
+        {
+            for (u32 earlier = 0; earlier < later; ++earlier)
+            {
+                if (_systems[later].access.conflicts(_systems[earlier].access))
+                {
+                    _systems[earlier].dependents.push_back(later);
+                    _systems[later].dependencyCount++;
+                }
+            }
+        }
+
+        _waiting = std::make_unique<std::atomic<u32>[]>(_systems.size());
+    }
+
+    void SystemScheduler::_schedule(
+        const u32 index, std::atomic<size_t>& remaining,
+        const std::chrono::steady_clock::time_point frameStart)
+    {
+        _jobs.submit([this, index, &remaining, frameStart]() {
+            System& system = _systems[index];
+
+            const auto start = std::chrono::steady_clock::now();
+            system.fn(_manager);
+            const auto end = std::chrono::steady_clock::now();
+
+            Timing& timing = _timings[index];
+            timing.startMilliseconds =
+                std::chrono::duration<f64, std::milli>(start - frameStart)
+                    .count();
+            timing.milliseconds =
+                std::chrono::duration<f64, std::milli>(end - start).count();
+
+            for (const u32 dependent : system.dependents)
+            {
+                if (_waiting[dependent].fetch_sub(
+                        1, std::memory_order_acq_rel) == 1)
+                {
+                    _schedule(dependent, remaining, frameStart);
+                }
+            }
+
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+} // namespace helios
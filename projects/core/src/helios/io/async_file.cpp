@@ -0,0 +1,855 @@
+#include <helios/io/async_file.hpp>
+
+#include <algorithm>
+#include <cerrno>
+
+#if defined(HELIOS_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(HELIOS_PLATFORM_LINUX) && __has_include(<linux/io_uring.h>)
+#define HELIOS_IO_URING 1
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#else
+#define HELIOS_IO_URING 0
+#endif
+
+namespace helios
+{
+    namespace detail
+    {
+        struct ReadState
+        {
+            std::string path;
+            u64 offset = 0;
+            u64 size = 0;
+            EReadPriority priority = EReadPriority::NORMAL;
+            u64 sequence = 0;
+            AsyncFileReader::Callback callback;
+            std::vector<u8> data;
+
+            std::atomic<u32> status{static_cast<u32>(EReadStatus::QUEUED)};
+            std::atomic<bool> cancelled{false};
+            std::atomic<size_t>* pending = nullptr;
+
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+    } // namespace detail
+
+    using detail::ReadState;
+
+    // reads are issued in pieces of at most this size so a cancelled read
+    // of a large file stops early
+    static constexpr u64 read_chunk = 16ULL << 20;
+
+    static bool is_done(const u32 status) noexcept
+    {
+        return status >= static_cast<u32>(EReadStatus::COMPLETE);
+    }
+
+    // Takes a queued read for whoever wins, the I/O side starting it or a
+    // handle cancelling it.
+    static bool claim(ReadState& state) noexcept
+    {
+        u32 expected = static_cast<u32>(EReadStatus::QUEUED);
+        return state.status.compare_exchange_strong(
+            expected, static_cast<u32>(EReadStatus::READING),
+            std::memory_order_acq_rel);
+    }
+
+    static void finish(ReadState& state, EReadStatus status)
+    {
+        if (status == EReadStatus::COMPLETE &&
+            state.cancelled.load(std::memory_order_relaxed))
+        {
+            status = EReadStatus::CANCELLED;
+        }
+        if (status != EReadStatus::COMPLETE)
+        {
+            state.data = std::vector<u8>();
+        }
+
+        if (state.callback)
+        {
+            state.callback(status, state.data);
+            state.callback = nullptr;
+        }
+
+        // dropped before waiters wake so they never see their own read as
+        // pending, the reader may be gone right after
+        state.pending->fetch_sub(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.status.store(static_cast<u32>(status),
+                               std::memory_order_release);
+        }
+        state.finished.notify_all();
+    }
+
+    // heap order, the read started next compares greatest
+    static bool starts_later(const std::shared_ptr<ReadState>& lhs,
+                             const std::shared_ptr<ReadState>& rhs) noexcept
+    {
+        if (lhs->priority != rhs->priority)
+        {
+            return lhs->priority < rhs->priority;
+        }
+        return lhs->sequence > rhs->sequence;
+    }
+
+    static void clamp_range(ReadState& state, const u64 fileSize, u64& begin,
+                            u64& count) noexcept
+    {
+        begin = std::min(state.offset, fileSize);
+        count = std::min(state.size, fileSize - begin);
+    }
+
+#if defined(HELIOS_PLATFORM_WINDOWS)
+    static bool read_blocking(ReadState& state)
+    {
+        HANDLE file = CreateFileA(state.path.c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL |
+                                      FILE_FLAG_SEQUENTIAL_SCAN,
+                                  nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        u64 begin;
+        u64 count;
+        clamp_range(state, static_cast<u64>(size.QuadPart), begin, count);
+        state.data.resize(static_cast<size_t>(count));
+
+        u64 done = 0;
+        while (done < count && !state.cancelled.load(std::memory_order_relaxed))
+        {
+            const u64 position = begin + done;
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = static_cast<DWORD>(position);
+            overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+
+            DWORD read = 0;
+            const DWORD want =
+                static_cast<DWORD>(std::min(count - done, read_chunk));
+            if (!ReadFile(file, state.data.data() + done, want, &read,
+                          &overlapped))
+            {
+                CloseHandle(file);
+                return false;
+            }
+            if (read == 0)
+            {
+                break;
+            }
+            done += read;
+        }
+
+        CloseHandle(file);
+        state.data.resize(static_cast<size_t>(done));
+        return true;
+    }
+#else
+    static int open_for_read(const std::string& path, u64& size)
+    {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            close(fd);
+            return -1;
+        }
+
+        size = static_cast<u64>(info.st_size);
+        return fd;
+    }
+
+    static bool read_blocking(ReadState& state)
+    {
+        u64 size;
+        const int fd = open_for_read(state.path, size);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        u64 begin;
+        u64 count;
+        clamp_range(state, size, begin, count);
+        state.data.resize(static_cast<size_t>(count));
+        posix_fadvise(fd, static_cast<off_t>(begin), static_cast<off_t>(count),
+                      POSIX_FADV_SEQUENTIAL);
+
+        u64 done = 0;
+        while (done < count && !state.cancelled.load(std::memory_order_relaxed))
+        {
+            const ssize_t read =
+                pread(fd, state.data.data() + done,
+                      static_cast<size_t>(std::min(count - done, read_chunk)),
+                      static_cast<off_t>(begin + done));
+            if (read < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                close(fd);
+                return false;
+            }
+            if (read == 0)
+            {
+                break;
+            }
+            done += static_cast<u64>(read);
+        }
+
+        close(fd);
+        state.data.resize(static_cast<size_t>(done));
+        return true;
+    }
+#endif
+
+#if HELIOS_IO_URING
+    // Just enough of an io_uring to queue reads and a poll on the wakeup
+    // eventfd from one thread, without depending on liburing.
+    struct AsyncFileReader::Ring
+    {
+        int fd = -1;
+        int wake = -1;
+        u32 entries = 0;
+        u32 unsubmitted = 0;
+
+        void* sqMap = MAP_FAILED;
+        size_t sqMapSize = 0;
+        void* cqMap = MAP_FAILED;
+        size_t cqMapSize = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        size_t sqesSize = 0;
+
+        u32* sqTail = nullptr;
+        u32* sqMask = nullptr;
+        u32* sqArray = nullptr;
+        u32* cqHead = nullptr;
+        u32* cqTail = nullptr;
+        u32* cqMask = nullptr;
+        io_uring_cqe* cqes = nullptr;
+
+        Ring() = default;
+        ~Ring();
+        HELIOS_NO_COPY_MOVE(Ring)
+
+        bool open(const u32 depth);
+
+        // Zeroed entry at the tail of the submission queue. Callers keep
+        // the number of entries in flight below the ring size.
+        io_uring_sqe& next();
+
+        // Submits what was queued and blocks for at least one completion.
+        bool submitAndWait();
+
+        template <typename Func>
+        void reap(Func&& fn);
+    };
+
+    AsyncFileReader::Ring::~Ring()
+    {
+        if (sqes != MAP_FAILED)
+        {
+            munmap(sqes, sqesSize);
+        }
+        if (cqMap != MAP_FAILED && cqMap != sqMap)
+        {
+            munmap(cqMap, cqMapSize);
+        }
+        if (sqMap != MAP_FAILED)
+        {
+            munmap(sqMap, sqMapSize);
+        }
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        if (wake >= 0)
+        {
+            close(wake);
+        }
+    }
+
+    bool AsyncFileReader::Ring::open(const u32 depth)
+    {
+        io_uring_params params = {};
+        fd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+        if (fd < 0)
+        {
+            // kernels without io_uring or sandboxes that filter it
+            return false;
+        }
+        entries = params.sq_entries;
+
+        sqMapSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+        cqMapSize =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+        {
+            sqMapSize = std::max(sqMapSize, cqMapSize);
+            cqMapSize = sqMapSize;
+        }
+
+        sqMap = mmap(nullptr, sqMapSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sqMap == MAP_FAILED)
+        {
+            return false;
+        }
+        cqMap = single ? sqMap
+                       : mmap(nullptr, cqMapSize, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, fd,
+                              IORING_OFF_CQ_RING);
+        if (cqMap == MAP_FAILED)
+        {
+            return false;
+        }
+
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(
+            mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED)
+        {
+            return false;
+        }
+
+        u8* sq = static_cast<u8*>(sqMap);
+        sqTail = reinterpret_cast<u32*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<u32*>(sq + params.sq_off.array);
+
+        u8* cq = static_cast<u8*>(cqMap);
+        cqHead = reinterpret_cast<u32*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<u32*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        wake = eventfd(0, EFD_CLOEXEC);
+        return wake >= 0;
+    }
+
+    io_uring_sqe& AsyncFileReader::Ring::next()
+    {
+        // only this thread moves the tail, the kernel moves the head
+        const u32 tail = *sqTail;
+        const u32 index = tail & *sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        sqe = {};
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++unsubmitted;
+        return sqe;
+    }
+
+    bool AsyncFileReader::Ring::submitAndWait()
+    {
+        while (true)
+        {
+            const long submitted =
+                syscall(__NR_io_uring_enter, fd, unsubmitted, 1,
+                        IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted >= 0)
+            {
+                unsubmitted -= static_cast<u32>(submitted);
+                return true;
+            }
+            if (errno != EINTR)
+            {
+                return false;
+            }
+        }
+    }
+
+    template <typename Func>
+    void AsyncFileReader::Ring::reap(Func&& fn)
+    {
+        u32 head = *cqHead;
+        const u32 tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail)
+        {
+            const io_uring_cqe& cqe = cqes[head & *cqMask];
+            fn(cqe.user_data, cqe.res);
+            ++head;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+#else
+    struct AsyncFileReader::Ring
+    {
+    };
+#endif
+
+    ReadHandle::ReadHandle(std::shared_ptr<ReadState> state)
+        : _state(std::move(state))
+    {
+    }
+
+    bool ReadHandle::valid() const noexcept
+    {
+        return _state != nullptr;
+    }
+
+    EReadStatus ReadHandle::status() const noexcept
+    {
+        return static_cast<EReadStatus>(
+            _state->status.load(std::memory_order_acquire));
+    }
+
+    bool ReadHandle::done() const noexcept
+    {
+        return is_done(_state->status.load(std::memory_order_acquire));
+    }
+
+    EReadStatus ReadHandle::wait() const
+    {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        _state->finished.wait(lock, [this]() {
+            return is_done(_state->status.load(std::memory_order_acquire));
+        });
+        return status();
+    }
+
+    span<const u8> ReadHandle::data() const noexcept
+    {
+        if (status() != EReadStatus::COMPLETE)
+        {
+            return {};
+        }
+        return span<const u8>(_state->data.data(), _state->data.size());
+    }
+
+    std::vector<u8> ReadHandle::take()
+    {
+        if (status() != EReadStatus::COMPLETE)
+        {
+            return {};
+        }
+        return std::move(_state->data);
+    }
+
+    bool ReadHandle::cancel()
+    {
+        _state->cancelled.store(true, std::memory_order_relaxed);
+        if (!claim(*_state))
+        {
+            return false;
+        }
+
+        // the queue still holds the read, whoever pops it skips it
+        finish(*_state, EReadStatus::CANCELLED);
+        return true;
+    }
+
+    AsyncFileReader::AsyncFileReader() : AsyncFileReader(Settings())
+    {
+    }
+
+    AsyncFileReader::AsyncFileReader(const Settings& settings)
+        : _backend(EBackend::THREAD_POOL), _pending(0), _sequence(0),
+          _stopping(false)
+    {
+#if HELIOS_IO_URING
+        if (settings.backend == EBackend::IO_URING)
+        {
+            auto ring = std::make_unique<Ring>();
+            if (ring->open(std::max(settings.queueDepth, 2U)))
+            {
+                _ring = std::move(ring);
+                _backend = EBackend::IO_URING;
+                _threads.emplace_back([this]() { _runRing(); });
+                return;
+            }
+        }
+#endif
+
+        const u32 count = std::max(settings.threads, 1U);
+        _threads.reserve(count);
+        for (u32 i = 0; i < count; i++)
+        {
+            _threads.emplace_back([this]() { _work(); });
+        }
+    }
+
+    AsyncFileReader::~AsyncFileReader()
+    {
+        std::vector<std::shared_ptr<ReadState>> queued;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            queued.swap(_queue);
+        }
+
+        for (const std::shared_ptr<ReadState>& state : queued)
+        {
+            state->cancelled.store(true, std::memory_order_relaxed);
+            if (claim(*state))
+            {
+                finish(*state, EReadStatus::CANCELLED);
+            }
+        }
+
+        _wake();
+        for (std::thread& thread : _threads)
+        {
+            thread.join();
+        }
+
+        // a handle that won a cancel race may still be finishing its read
+        // and is the only one left touching _pending
+        while (_pending.load(std::memory_order_acquire) > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    AsyncFileReader::EBackend AsyncFileReader::backend() const noexcept
+    {
+        return _backend;
+    }
+
+    ReadHandle AsyncFileReader::read(const std::string& path,
+                                     const EReadPriority priority,
+                                     Callback callback)
+    {
+        return read(path, 0, to_end, priority, std::move(callback));
+    }
+
+    ReadHandle AsyncFileReader::read(const std::string& path, const u64 offset,
+                                     const u64 size,
+                                     const EReadPriority priority,
+                                     Callback callback)
+    {
+        auto state = std::make_shared<ReadState>();
+        state->path = path;
+        state->offset = offset;
+        state->size = size;
+        state->priority = priority;
+        state->callback = std::move(callback);
+        _enqueue(&state, 1);
+        return ReadHandle(std::move(state));
+    }
+
+    std::vector<ReadHandle> AsyncFileReader::readBatch(
+        const std::vector<std::string>& paths, const EReadPriority priority)
+    {
+        std::vector<std::shared_ptr<ReadState>> states;
+        states.reserve(paths.size());
+        for (const std::string& path : paths)
+        {
+            auto state = std::make_shared<ReadState>();
+            state->path = path;
+            state->size = to_end;
+            state->priority = priority;
+            states.push_back(std::move(state));
+        }
+        _enqueue(states.data(), states.size());
+
+        std::vector<ReadHandle> handles;
+        handles.reserve(states.size());
+        for (std::shared_ptr<ReadState>& state : states)
+        {
+            handles.push_back(ReadHandle(std::move(state)));
+        }
+        return handles;
+    }
+
+    size_t AsyncFileReader::pending() const noexcept
+    {
+        return _pending.load(std::memory_order_acquire);
+    }
+
+    void AsyncFileReader::_enqueue(const std::shared_ptr<ReadState>* states,
+                                   const size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        _pending.fetch_add(count, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (size_t i = 0; i < count; i++)
+            {
+                states[i]->pending = &_pending;
+                states[i]->sequence = _sequence++;
+                _queue.push_back(states[i]);
+                std::push_heap(_queue.begin(), _queue.end(), starts_later);
+            }
+        }
+        _wake();
+    }
+
+    std::shared_ptr<ReadState> AsyncFileReader::_pop()
+    {
+        std::pop_heap(_queue.begin(), _queue.end(), starts_later);
+        std::shared_ptr<ReadState> state = std::move(_queue.back());
+        _queue.pop_back();
+        return state;
+    }
+
+    void AsyncFileReader::_wake()
+    {
+#if HELIOS_IO_URING
+        if (_ring)
+        {
+            const u64 signal = 1;
+            [[maybe_unused]] const ssize_t written =
+                write(_ring->wake, &signal, sizeof(signal));
+            return;
+        }
+#endif
+        _available.notify_all();
+    }
+
+    void AsyncFileReader::_work()
+    {
+        while (true)
+        {
+            std::shared_ptr<ReadState> state;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _available.wait(lock, [this]() {
+                    return _stopping || !_queue.empty();
+                });
+                if (_queue.empty())
+                {
+                    return;
+                }
+                state = _pop();
+            }
+
+            if (claim(*state))
+            {
+                finish(*state, read_blocking(*state) ? EReadStatus::COMPLETE
+                                                     : EReadStatus::FAILED);
+            }
+        }
+    }
+
+    void AsyncFileReader::_runRing()
+    {
+#if HELIOS_IO_URING
+        struct InFlight
+        {
+            std::shared_ptr<ReadState> state;
+            int fd;
+            u64 begin;
+            u64 count;
+            u64 done;
+            iovec target;
+        };
+
+        Ring& ring = *_ring;
+        const u64 wake_tag = ~u64(0);
+
+        // one entry stays reserved for the wakeup poll
+        std::vector<InFlight> slots(ring.entries - 1);
+        std::vector<u32> free;
+        free.reserve(slots.size());
+        for (u32 i = static_cast<u32>(slots.size()); i > 0; i--)
+        {
+            free.push_back(i - 1);
+        }
+
+        const auto submit = [&](const u32 index) {
+            InFlight& slot = slots[index];
+            slot.target.iov_base = slot.state->data.data() + slot.done;
+            slot.target.iov_len =
+                static_cast<size_t>(std::min(slot.count - slot.done,
+                                             read_chunk));
+
+            io_uring_sqe& sqe = ring.next();
+            sqe.opcode = IORING_OP_READV;
+            sqe.fd = slot.fd;
+            sqe.off = slot.begin + slot.done;
+            sqe.addr = reinterpret_cast<u64>(&slot.target);
+            sqe.len = 1;
+            sqe.user_data = index;
+        };
+
+        const auto complete = [&](const u32 index, const EReadStatus status) {
+            InFlight& slot = slots[index];
+            close(slot.fd);
+            if (status == EReadStatus::COMPLETE)
+            {
+                slot.state->data.resize(static_cast<size_t>(slot.done));
+            }
+            finish(*slot.state, status);
+            slot.state.reset();
+            free.push_back(index);
+        };
+
+        bool armed = false;
+        while (true)
+        {
+            if (!armed)
+            {
+                io_uring_sqe& sqe = ring.next();
+                sqe.opcode = IORING_OP_POLL_ADD;
+                sqe.fd = ring.wake;
+                sqe.poll32_events = POLLIN;
+                sqe.user_data = wake_tag;
+                armed = true;
+            }
+
+            bool stopping = false;
+            while (!free.empty())
+            {
+                std::shared_ptr<ReadState> state;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    stopping = _stopping;
+                    if (_queue.empty())
+                    {
+                        break;
+                    }
+                    state = _pop();
+                }
+                if (!claim(*state))
+                {
+                    continue;
+                }
+
+                // opening stays synchronous, it is cheap next to the read
+                u64 size;
+                const int fd = open_for_read(state->path, size);
+                if (fd < 0)
+                {
+                    finish(*state, EReadStatus::FAILED);
+                    continue;
+                }
+
+                u64 begin;
+                u64 count;
+                clamp_range(*state, size, begin, count);
+                if (count == 0)
+                {
+                    close(fd);
+                    finish(*state, EReadStatus::COMPLETE);
+                    continue;
+                }
+                state->data.resize(static_cast<size_t>(count));
+
+                const u32 index = free.back();
+                free.pop_back();
+                slots[index] = InFlight{std::move(state), fd, begin, count, 0,
+                                        iovec{}};
+                submit(index);
+            }
+
+            if (stopping && free.size() == slots.size())
+            {
+                break;
+            }
+
+            if (!ring.submitAndWait())
+            {
+                // the ring is unusable, fail what is in flight and finish
+                // with blocking reads, waiting on the eventfd for more
+                for (u32 i = 0; i < slots.size(); i++)
+                {
+                    if (slots[i].state)
+                    {
+                        complete(i, EReadStatus::FAILED);
+                    }
+                }
+
+                while (true)
+                {
+                    std::shared_ptr<ReadState> state;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (_queue.empty() && _stopping)
+                        {
+                            return;
+                        }
+                        if (!_queue.empty())
+                        {
+                            state = _pop();
+                        }
+                    }
+
+                    if (!state)
+                    {
+                        u64 signals;
+                        [[maybe_unused]] const ssize_t drained =
+                            ::read(ring.wake, &signals, sizeof(signals));
+                    }
+                    else if (claim(*state))
+                    {
+                        finish(*state, read_blocking(*state)
+                                           ? EReadStatus::COMPLETE
+                                           : EReadStatus::FAILED);
+                    }
+                }
+            }
+
+            ring.reap([&](const u64 tag, const i32 result) {
+                if (tag == wake_tag)
+                {
+                    u64 signals;
+                    [[maybe_unused]] const ssize_t drained =
+                        ::read(ring.wake, &signals, sizeof(signals));
+                    armed = false;
+                    return;
+                }
+
+                const u32 index = static_cast<u32>(tag);
+                InFlight& slot = slots[index];
+                if (result == -EINTR || result == -EAGAIN)
+                {
+                    submit(index);
+                    return;
+                }
+                if (result < 0)
+                {
+                    complete(index, EReadStatus::FAILED);
+                    return;
+                }
+
+                slot.done += static_cast<u64>(result);
+                if (result > 0 && slot.done < slot.count &&
+                    !slot.state->cancelled.load(std::memory_order_relaxed))
+                {
+                    submit(index);
+                    return;
+                }
+                complete(index, EReadStatus::COMPLETE);
+            });
+        }
+#endif
+    }
+} // namespace helios
@@ -1,21 +1,30 @@
 #include <helios/io/file.hpp>
 
+#include <cstring>
 #include <fstream>
 
+#if defined(HELIOS_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace helios
 {
     vector<uint8_t> File::read_binary(const std::string& filepath)
     {
         vector<uint8_t> bytes;
 
-        std::ifstream file(filepath, std::ios::ate | std::ios::binary);
-        if (file.is_open())
+        const MappedFile file(filepath, EFileAccess::SEQUENTIAL);
+        if (file.valid() && file.size() > 0)
         {
-            const size_t sz = static_cast<size_t>(file.tellg());
-            bytes.resize(sz);
-            file.seekg(0);
-            file.read(reinterpret_cast<char*>(bytes.data()), sz);
-            file.close();
+            bytes.resize(file.size());
+            memcpy(bytes.data(), file.bytes().data(), file.size());
         }
 
         return bytes;
@@ -23,8 +32,312 @@ namespace helios
     
     std::string File::read_text(const std::string& filepath)
     {
-        std::ifstream file(filepath);
-        return std::string(std::istreambuf_iterator<char>(file),
-                           std::istreambuf_iterator<char>());
+        const MappedFile file(filepath, EFileAccess::SEQUENTIAL);
+        return std::string(file.text());
+    }
+
+    bool File::write_binary(const std::string& filepath, const uint8_t* data,
+                            const size_t size)
+    {
+        std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(data),
+                   static_cast<std::streamsize>(size));
+        return file.good();
+    }
+
+    MappedFile::MappedFile() noexcept : _data(nullptr), _size(0), _valid(false)
+    {
+#if defined(HELIOS_PLATFORM_WINDOWS)
+        _file = nullptr;
+        _mapping = nullptr;
+#endif
+    }
+
+#if defined(HELIOS_PLATFORM_WINDOWS)
+    MappedFile::MappedFile(const std::string& filepath,
+                           const EFileAccess access)
+        : MappedFile()
+    {
+        const DWORD flags = access == EFileAccess::RANDOM
+                                ? FILE_FLAG_RANDOM_ACCESS
+                                : FILE_FLAG_SEQUENTIAL_SCAN;
+        HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+        _file = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            _close();
+            return;
+        }
+
+        _size = static_cast<size_t>(size.QuadPart);
+        _valid = true;
+        if (_size == 0)
+        {
+            return;
+        }
+
+        _mapping =
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping == nullptr)
+        {
+            _close();
+            return;
+        }
+
+        _data = static_cast<const u8*>(
+            MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (_data == nullptr)
+        {
+            _close();
+            return;
+        }
+
+        if (access == EFileAccess::WILL_NEED)
+        {
+            prefetch(0, _size);
+        }
+    }
+
+    void MappedFile::prefetch(const size_t offset,
+                              const size_t size) const noexcept
+    {
+        if (_data == nullptr || offset >= _size)
+        {
+            return;
+        }
+
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<u8*>(_data + offset);
+        range.NumberOfBytes = size < _size - offset ? size : _size - offset;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
+    void MappedFile::_close() noexcept
+    {
+        if (_data != nullptr)
+        {
+            UnmapViewOfFile(_data);
+        }
+        if (_mapping != nullptr)
+        {
+            CloseHandle(_mapping);
+        }
+        if (_file != nullptr)
+        {
+            CloseHandle(_file);
+        }
+        _data = nullptr;
+        _mapping = nullptr;
+        _file = nullptr;
+        _size = 0;
+        _valid = false;
+    }
+#else
+    MappedFile::MappedFile(const std::string& filepath,
+                           const EFileAccess access)
+        : MappedFile()
+    {
+        const int fd = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            close(fd);
+            return;
+        }
+
+        _size = static_cast<size_t>(info.st_size);
+        _valid = true;
+        if (_size > 0)
+        {
+            void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                _size = 0;
+                _valid = false;
+            }
+            else
+            {
+                _data = static_cast<const u8*>(data);
+                const int advice =
+                    access == EFileAccess::RANDOM
+                        ? MADV_RANDOM
+                        : (access == EFileAccess::WILL_NEED ? MADV_WILLNEED
+                                                            : MADV_SEQUENTIAL);
+                madvise(data, _size, advice);
+            }
+        }
+
+        // the mapping keeps the file alive on its own
+        close(fd);
+    }
+
+    void MappedFile::prefetch(const size_t offset,
+                              const size_t size) const noexcept
+    {
+        if (_data == nullptr || offset >= _size)
+        {
+            return;
+        }
+
+        // madvise wants a page aligned start
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t start = offset / page * page;
+        const size_t end = size < _size - offset ? offset + size : _size;
+        madvise(const_cast<u8*>(_data + start), end - start, MADV_WILLNEED);
+    }
+
+    void MappedFile::_close() noexcept
+    {
+        if (_data != nullptr)
+        {
+            munmap(const_cast<u8*>(_data), _size);
+        }
+        _data = nullptr;
+        _size = 0;
+        _valid = false;
+    }
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        _close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : _data(other._data), _size(other._size), _valid(other._valid)
+    {
+#if defined(HELIOS_PLATFORM_WINDOWS)
+        _file = other._file;
+        _mapping = other._mapping;
+        other._file = nullptr;
+        other._mapping = nullptr;
+#endif
+        other._data = nullptr;
+        other._size = 0;
+        other._valid = false;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            _close();
+            _data = other._data;
+            _size = other._size;
+            _valid = other._valid;
+#if defined(HELIOS_PLATFORM_WINDOWS)
+            _file = other._file;
+            _mapping = other._mapping;
+            other._file = nullptr;
+            other._mapping = nullptr;
+#endif
+            other._data = nullptr;
+            other._size = 0;
+            other._valid = false;
+        }
+        return *this;
+    }
+
+    bool MappedFile::valid() const noexcept
+    {
+        return _valid;
+    }
+
+    MappedFile::operator bool() const noexcept
+    {
+        return _valid;
+    }
+
+    size_t MappedFile::size() const noexcept
+    {
+        return _size;
+    }
+
+    span<const u8> MappedFile::bytes() const noexcept
+    {
+        return span<const u8>(_data, _size);
+    }
+
+    std::string_view MappedFile::text() const noexcept
+    {
+        return std::string_view(reinterpret_cast<const char*>(_data), _size);
+    }
+
+    FileChunkReader::FileChunkReader(const std::string& filepath,
+                                     const size_t chunkSize)
+        : _file(std::fopen(filepath.c_str(), "rb")), _size(0), _offset(0)
+    {
+        if (_file == nullptr)
+        {
+            return;
+        }
+
+        // chunks are already large, the stdio buffer would only add a copy
+        std::setvbuf(_file, nullptr, _IONBF, 0);
+        _buffer.resize(chunkSize > 0 ? chunkSize : default_chunk_size);
+
+        if (std::fseek(_file, 0, SEEK_END) == 0)
+        {
+            const long end = std::ftell(_file);
+            _size = end > 0 ? static_cast<u64>(end) : 0;
+        }
+        std::fseek(_file, 0, SEEK_SET);
+
+#if !defined(HELIOS_PLATFORM_WINDOWS)
+        posix_fadvise(fileno(_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+    FileChunkReader::~FileChunkReader()
+    {
+        if (_file != nullptr)
+        {
+            std::fclose(_file);
+        }
+    }
+
+    bool FileChunkReader::valid() const noexcept
+    {
+        return _file != nullptr;
+    }
+
+    u64 FileChunkReader::size() const noexcept
+    {
+        return _size;
+    }
+
+    u64 FileChunkReader::offset() const noexcept
+    {
+        return _offset;
+    }
+
+    span<const u8> FileChunkReader::next()
+    {
+        if (_file == nullptr)
+        {
+            return {};
+        }
+
+        const size_t read = std::fread(_buffer.data(), 1, _buffer.size(), _file);
+        _offset += read;
+        return span<const u8>(_buffer.data(), read);
     }
-} // namespace helios
\ No newline at end of file
+} // namespace helios
@@ -0,0 +1,748 @@
+#include <helios/io/image_decoder.hpp>
+
+#include <helios/core/job_system.hpp>
+#include <helios/io/inflate.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <emmintrin.h>
+
+#include <cstring>
+#include <limits>
+
+namespace helios
+{
+    static constexpr u8 png_signature[8] = {0x89, 'P',  'N',  'G',
+                                            '\r', '\n', 0x1A, '\n'};
+
+    // larger images would overflow the 32 bit sizes stb_image works with
+    static constexpr u32 max_image_dimension = 1 << 16;
+
+    enum : u32
+    {
+        png_grey = 0,
+        png_rgb = 2,
+        png_palette = 3,
+        png_grey_alpha = 4,
+        png_rgba = 6
+    };
+
+    struct PngImage
+    {
+        u32 width = 0;
+        u32 height = 0;
+        u32 depth = 0;
+        u32 colorType = 0;
+        u32 interlace = 0;
+        std::vector<span<const u8>> data;
+        // every entry is filled, indices past the palette read opaque black
+        u8 palette[256][4];
+        u32 paletteSize = 0;
+        // the grey or RGB sample that is fully transparent, from tRNS
+        bool hasKey = false;
+        u32 key[3] = {};
+    };
+
+    static u32 read_be32(const u8* bytes)
+    {
+        return (static_cast<u32>(bytes[0]) << 24) |
+               (static_cast<u32>(bytes[1]) << 16) |
+               (static_cast<u32>(bytes[2]) << 8) | bytes[3];
+    }
+
+    static bool is_png(const span<const u8> bytes)
+    {
+        return bytes.size() >= sizeof(png_signature) &&
+               memcmp(bytes.data(), png_signature, sizeof(png_signature)) == 0;
+    }
+
+    static u32 png_channels(const u32 colorType)
+    {
+        switch (colorType)
+        {
+        case png_rgb:
+            return 3;
+        case png_grey_alpha:
+            return 2;
+        case png_rgba:
+            return 4;
+        default:
+            return 1;
+        }
+    }
+
+    static bool valid_png_depth(const u32 colorType, const u32 depth)
+    {
+        switch (colorType)
+        {
+        case png_grey:
+            return depth == 1 || depth == 2 || depth == 4 || depth == 8 ||
+                   depth == 16;
+        case png_palette:
+            return depth == 1 || depth == 2 || depth == 4 || depth == 8;
+        case png_rgb:
+        case png_grey_alpha:
+        case png_rgba:
+            return depth == 8 || depth == 16;
+        default:
+            return false;
+        }
+    }
+
+    // Walks the chunks of a PNG, keeping the header, palette, transparency
+    // and the spans of the image data. Chunk checksums are not verified.
+    static bool parse_png(const span<const u8> bytes, PngImage& png)
+    {
+        if (!is_png(bytes))
+        {
+            return false;
+        }
+
+        size_t position = sizeof(png_signature);
+        bool header = false;
+        while (position + 12 <= bytes.size())
+        {
+            const u32 length = read_be32(bytes.data() + position);
+            const u8* type = bytes.data() + position + 4;
+            const u8* chunk = type + 4;
+            if (length > bytes.size() - position - 12)
+            {
+                return false;
+            }
+            position += 12 + static_cast<size_t>(length);
+
+            if (memcmp(type, "IHDR", 4) == 0)
+            {
+                if (header || length != 13)
+                {
+                    return false;
+                }
+                png.width = read_be32(chunk);
+                png.height = read_be32(chunk + 4);
+                png.depth = chunk[8];
+                png.colorType = chunk[9];
+                png.interlace = chunk[12];
+                if (png.width == 0 || png.height == 0 ||
+                    png.width > max_image_dimension ||
+                    png.height > max_image_dimension ||
+                    !valid_png_depth(png.colorType, png.depth) ||
+                    chunk[10] != 0 || chunk[11] != 0 || png.interlace > 1)
+                {
+                    return false;
+                }
+                header = true;
+            }
+            else if (!header)
+            {
+                return false;
+            }
+            else if (memcmp(type, "PLTE", 4) == 0)
+            {
+                if (length % 3 != 0 || length / 3 > 256)
+                {
+                    return false;
+                }
+                png.paletteSize = length / 3;
+                for (u32 i = 0; i < 256; i++)
+                {
+                    const bool listed = i < png.paletteSize;
+                    png.palette[i][0] = listed ? chunk[i * 3] : 0;
+                    png.palette[i][1] = listed ? chunk[i * 3 + 1] : 0;
+                    png.palette[i][2] = listed ? chunk[i * 3 + 2] : 0;
+                    png.palette[i][3] = 255;
+                }
+            }
+            else if (memcmp(type, "tRNS", 4) == 0)
+            {
+                if (png.colorType == png_palette)
+                {
+                    if (length > png.paletteSize)
+                    {
+                        return false;
+                    }
+                    for (u32 i = 0; i < length; i++)
+                    {
+                        png.palette[i][3] = chunk[i];
+                    }
+                }
+                else if (png.colorType == png_grey && length == 2)
+                {
+                    png.hasKey = true;
+                    png.key[0] = (chunk[0] << 8) | chunk[1];
+                }
+                else if (png.colorType == png_rgb && length == 6)
+                {
+                    png.hasKey = true;
+                    for (u32 c = 0; c < 3; c++)
+                    {
+                        png.key[c] = (chunk[c * 2] << 8) | chunk[c * 2 + 1];
+                    }
+                }
+            }
+            else if (memcmp(type, "IDAT", 4) == 0)
+            {
+                png.data.push_back(bytes.subspan(
+                    static_cast<size_t>(chunk - bytes.data()), length));
+            }
+            else if (memcmp(type, "IEND", 4) == 0)
+            {
+                break;
+            }
+        }
+
+        return header && !png.data.empty() &&
+               (png.colorType != png_palette || png.paletteSize > 0);
+    }
+
+    // Loads four bytes whatever the pixel size, a 3 byte load assembled on
+    // the stack stalls store forwarding on every pixel. The byte past a 3
+    // byte pixel lands in a lane of its own that is never stored, the rows
+    // leave slack for it after the last pixel.
+    static __m128i load_pixel(const u8* source)
+    {
+        i32 value;
+        memcpy(&value, source, sizeof(value));
+        return _mm_cvtsi32_si128(value);
+    }
+
+    template <u32 Bpp>
+    static void store_pixel(u8* target, const __m128i pixel)
+    {
+        const i32 value = _mm_cvtsi128_si32(pixel);
+        memcpy(target, &value, Bpp);
+    }
+
+    // The filters of 3 and 4 byte pixels run a whole pixel per SSE2
+    // operation, the pixels of a row still depend on each other.
+    template <u32 Bpp>
+    static void unfilter_sub(u8* row, const size_t size)
+    {
+        __m128i left = _mm_setzero_si128();
+        for (size_t i = 0; i + Bpp <= size; i += Bpp)
+        {
+            left = _mm_add_epi8(load_pixel(row + i), left);
+            store_pixel<Bpp>(row + i, left);
+        }
+    }
+
+    template <u32 Bpp>
+    static void unfilter_average(u8* row, const u8* prior, const size_t size)
+    {
+        const __m128i one = _mm_set1_epi8(1);
+        __m128i left = _mm_setzero_si128();
+        for (size_t i = 0; i + Bpp <= size; i += Bpp)
+        {
+            const __m128i up = load_pixel(prior + i);
+            // avg_epu8 rounds up, the filter rounds down
+            const __m128i average = _mm_sub_epi8(
+                _mm_avg_epu8(left, up),
+                _mm_and_si128(_mm_xor_si128(left, up), one));
+            left = _mm_add_epi8(load_pixel(row + i), average);
+            store_pixel<Bpp>(row + i, left);
+        }
+    }
+
+    static __m128i abs_epi16(const __m128i value)
+    {
+        return _mm_max_epi16(value, _mm_sub_epi16(_mm_setzero_si128(), value));
+    }
+
+    static __m128i select_epi16(const __m128i mask, const __m128i a,
+                                const __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    template <u32 Bpp>
+    static void unfilter_paeth(u8* row, const u8* prior, const size_t size)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i a = zero;
+        __m128i c = zero;
+        for (size_t i = 0; i + Bpp <= size; i += Bpp)
+        {
+            const __m128i b =
+                _mm_unpacklo_epi8(load_pixel(prior + i), zero);
+            const __m128i x = load_pixel(row + i);
+
+            // with p = a + b - c: |p - a| = |b - c|, |p - b| = |a - c| and
+            // |p - c| is the sum of both before taking the magnitude
+            const __m128i toA = _mm_sub_epi16(b, c);
+            const __m128i toB = _mm_sub_epi16(a, c);
+            const __m128i pa = abs_epi16(toA);
+            const __m128i pb = abs_epi16(toB);
+            const __m128i pc = abs_epi16(_mm_add_epi16(toA, toB));
+            const __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            const __m128i predictor = select_epi16(
+                _mm_cmpeq_epi16(smallest, pa), a,
+                select_epi16(_mm_cmpeq_epi16(smallest, pb), b, c));
+
+            const __m128i result =
+                _mm_add_epi8(x, _mm_packus_epi16(predictor, predictor));
+            store_pixel<Bpp>(row + i, result);
+            a = _mm_unpacklo_epi8(result, zero);
+            c = b;
+        }
+    }
+
+    static u8 paeth_predictor(const i32 a, const i32 b, const i32 c)
+    {
+        const i32 pa = b > c ? b - c : c - b;
+        const i32 pb = a > c ? a - c : c - a;
+        const i32 pcSigned = a + b - c - c;
+        const i32 pc = pcSigned < 0 ? -pcSigned : pcSigned;
+        if (pa <= pb && pa <= pc)
+        {
+            return static_cast<u8>(a);
+        }
+        return static_cast<u8>(pb <= pc ? b : c);
+    }
+
+    // Reverses the filter of one row in place. prior is the previous row
+    // already unfiltered, or zeros for the first row.
+    static bool unfilter_row(const u32 filter, u8* row, const u8* prior,
+                             const size_t size, const u32 bpp)
+    {
+        switch (filter)
+        {
+        case 0:
+            return true;
+        case 1:
+            if (bpp == 4)
+            {
+                unfilter_sub<4>(row, size);
+            }
+            else if (bpp == 3)
+            {
+                unfilter_sub<3>(row, size);
+            }
+            else
+            {
+                for (size_t i = bpp; i < size; i++)
+                {
+                    row[i] = static_cast<u8>(row[i] + row[i - bpp]);
+                }
+            }
+            return true;
+        case 2:
+        {
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                const __m128i up = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(prior + i));
+                __m128i* target = reinterpret_cast<__m128i*>(row + i);
+                _mm_storeu_si128(target,
+                                 _mm_add_epi8(_mm_loadu_si128(target), up));
+            }
+            for (; i < size; i++)
+            {
+                row[i] = static_cast<u8>(row[i] + prior[i]);
+            }
+            return true;
+        }
+        case 3:
+            if (bpp == 4)
+            {
+                unfilter_average<4>(row, prior, size);
+            }
+            else if (bpp == 3)
+            {
+                unfilter_average<3>(row, prior, size);
+            }
+            else
+            {
+                for (size_t i = 0; i < size; i++)
+                {
+                    const u32 left = i >= bpp ? row[i - bpp] : 0;
+                    row[i] = static_cast<u8>(row[i] + ((left + prior[i]) >> 1));
+                }
+            }
+            return true;
+        case 4:
+            if (bpp == 4)
+            {
+                unfilter_paeth<4>(row, prior, size);
+            }
+            else if (bpp == 3)
+            {
+                unfilter_paeth<3>(row, prior, size);
+            }
+            else
+            {
+                for (size_t i = 0; i < size; i++)
+                {
+                    const i32 left = i >= bpp ? row[i - bpp] : 0;
+                    const i32 corner = i >= bpp ? prior[i - bpp] : 0;
+                    row[i] = static_cast<u8>(
+                        row[i] + paeth_predictor(left, prior[i], corner));
+                }
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static u32 read_sample(const u8* row, const u32 index, const u32 depth)
+    {
+        if (depth == 8)
+        {
+            return row[index];
+        }
+        if (depth == 16)
+        {
+            return (static_cast<u32>(row[index * 2]) << 8) | row[index * 2 + 1];
+        }
+        const u32 bit = index * depth;
+        const u32 shift = 8 - depth - (bit & 7);
+        return (row[bit >> 3] >> shift) & ((1u << depth) - 1);
+    }
+
+    static u8 scale_sample(const u32 value, const u32 depth)
+    {
+        if (depth == 16)
+        {
+            return static_cast<u8>(value >> 8);
+        }
+        return static_cast<u8>(value * 255 / ((1u << depth) - 1));
+    }
+
+    // Expands one unfiltered row to RGBA8.
+    static void convert_row(const PngImage& png, const u8* row, u8* target)
+    {
+        const u32 width = png.width;
+        const u32 depth = png.depth;
+        switch (png.colorType)
+        {
+        case png_rgba:
+            if (depth == 8)
+            {
+                memcpy(target, row, static_cast<size_t>(width) * 4);
+                return;
+            }
+            for (u32 i = 0; i < width * 4; i++)
+            {
+                target[i] = scale_sample(read_sample(row, i, depth), depth);
+            }
+            return;
+        case png_rgb:
+            if (depth == 8 && !png.hasKey)
+            {
+                // four bytes in, the fourth replaced by opaque alpha, the
+                // byte past the last pixel is slack
+                for (u32 x = 0; x < width; x++)
+                {
+                    u32 pixel;
+                    memcpy(&pixel, row + x * 3, sizeof(pixel));
+                    pixel = (pixel & 0x00FFFFFFu) | 0xFF000000u;
+                    memcpy(target + x * 4, &pixel, sizeof(pixel));
+                }
+                return;
+            }
+            for (u32 x = 0; x < width; x++)
+            {
+                bool keyed = png.hasKey;
+                for (u32 c = 0; c < 3; c++)
+                {
+                    const u32 value = read_sample(row, x * 3 + c, depth);
+                    keyed = keyed && value == png.key[c];
+                    target[x * 4 + c] = scale_sample(value, depth);
+                }
+                target[x * 4 + 3] = keyed ? 0 : 255;
+            }
+            return;
+        case png_palette:
+        {
+            // indices packed below a byte are shifted out of each byte in turn
+            const u32 perByte = 8 / depth;
+            const u32 mask = (1u << depth) - 1;
+            u32 x = 0;
+            for (size_t i = 0; x < width; i++)
+            {
+                u32 bits = row[i];
+                for (u32 k = 0; k < perByte && x < width; k++, x++)
+                {
+                    const u32 index = (bits >> (8 - depth)) & mask;
+                    bits <<= depth;
+                    memcpy(target + x * 4, png.palette[index], 4);
+                }
+            }
+            return;
+        }
+        case png_grey:
+            for (u32 x = 0; x < width; x++)
+            {
+                const u32 value = read_sample(row, x, depth);
+                const u8 grey = scale_sample(value, depth);
+                u8* pixel = target + x * 4;
+                pixel[0] = grey;
+                pixel[1] = grey;
+                pixel[2] = grey;
+                pixel[3] = png.hasKey && value == png.key[0] ? 0 : 255;
+            }
+            return;
+        default:
+            for (u32 x = 0; x < width; x++)
+            {
+                const u8 grey = scale_sample(read_sample(row, x * 2, depth), depth);
+                u8* pixel = target + x * 4;
+                pixel[0] = grey;
+                pixel[1] = grey;
+                pixel[2] = grey;
+                pixel[3] = scale_sample(read_sample(row, x * 2 + 1, depth), depth);
+            }
+            return;
+        }
+    }
+
+    static bool decode_png(const PngImage& png, u8* pixels,
+                           const bool flipVertically)
+    {
+        const u32 bitsPerPixel = png_channels(png.colorType) * png.depth;
+        const size_t rowSize =
+            (static_cast<size_t>(png.width) * bitsPerPixel + 7) / 8;
+        const u32 bpp = bitsPerPixel >= 8 ? bitsPerPixel / 8 : 1;
+        const size_t filteredSize = (rowSize + 1) * png.height;
+
+        // The image data is usually one chunk and inflates straight from
+        // the file, split data is joined first. The slack past the rows
+        // lets inflate copy the last matches a word at a time.
+        std::vector<u8> joined;
+        span<const u8> stream = png.data[0];
+        if (png.data.size() > 1)
+        {
+            size_t total = 0;
+            for (const span<const u8>& chunk : png.data)
+            {
+                total += chunk.size();
+            }
+            joined.resize(total);
+            size_t offset = 0;
+            for (const span<const u8>& chunk : png.data)
+            {
+                memcpy(joined.data() + offset, chunk.data(), chunk.size());
+                offset += chunk.size();
+            }
+            stream = span<const u8>(joined.data(), joined.size());
+        }
+
+        std::vector<u8> filtered(filteredSize + 16 + rowSize + 4);
+        const size_t written =
+            inflateZlib(stream, filtered.data(), filteredSize + 16);
+        if (written == inflate_error || written < filteredSize)
+        {
+            return false;
+        }
+
+        // the zero row past the image data stands in above the first row
+        u8* zeros = filtered.data() + filteredSize + 16;
+        memset(zeros, 0, rowSize);
+        const u8* prior = zeros;
+        const size_t targetStride = static_cast<size_t>(png.width) * 4;
+        for (u32 y = 0; y < png.height; y++)
+        {
+            u8* row = filtered.data() + y * (rowSize + 1);
+            if (!unfilter_row(row[0], row + 1, prior, rowSize, bpp))
+            {
+                return false;
+            }
+            const u32 targetRow = flipVertically ? png.height - 1 - y : y;
+            convert_row(png, row + 1, pixels + targetRow * targetStride);
+            prior = row + 1;
+        }
+        return true;
+    }
+
+    static bool decode_with_stb(const span<const u8> bytes, u8* pixels,
+                                const bool flipVertically)
+    {
+        if (bytes.size() > static_cast<size_t>(std::numeric_limits<i32>::max()))
+        {
+            return false;
+        }
+        i32 width;
+        i32 height;
+        i32 channels;
+        stbi_uc* decoded =
+            stbi_load_from_memory(bytes.data(), static_cast<i32>(bytes.size()),
+                                  &width, &height, &channels, STBI_rgb_alpha);
+        if (decoded == nullptr)
+        {
+            return false;
+        }
+
+        // flipped here, the stb flag is global state shared by all threads
+        const size_t stride = static_cast<size_t>(width) * 4;
+        for (i32 y = 0; y < height; y++)
+        {
+            const i32 targetRow = flipVertically ? height - 1 - y : y;
+            memcpy(pixels + targetRow * stride, decoded + y * stride, stride);
+        }
+        stbi_image_free(decoded);
+        return true;
+    }
+
+    bool readImageInfo(const span<const u8> bytes, ImageInfo& info) noexcept
+    {
+        if (is_png(bytes))
+        {
+            // the header is always the first chunk
+            if (bytes.size() < 33 || memcmp(bytes.data() + 12, "IHDR", 4) != 0)
+            {
+                return false;
+            }
+            info.width = read_be32(bytes.data() + 16);
+            info.height = read_be32(bytes.data() + 20);
+            return info.width > 0 && info.height > 0 &&
+                   info.width <= max_image_dimension &&
+                   info.height <= max_image_dimension;
+        }
+
+        if (bytes.size() > static_cast<size_t>(std::numeric_limits<i32>::max()))
+        {
+            return false;
+        }
+        i32 width;
+        i32 height;
+        i32 channels;
+        if (stbi_info_from_memory(bytes.data(), static_cast<i32>(bytes.size()),
+                                  &width, &height, &channels) == 0)
+        {
+            return false;
+        }
+        info.width = static_cast<u32>(width);
+        info.height = static_cast<u32>(height);
+        return true;
+    }
+
+    bool decodeImage(const span<const u8> bytes, u8* pixels,
+                     const bool flipVertically)
+    {
+        if (is_png(bytes))
+        {
+            PngImage png;
+            if (!parse_png(bytes, png))
+            {
+                return false;
+            }
+            if (png.interlace == 0)
+            {
+                return decode_png(png, pixels, flipVertically);
+            }
+        }
+        return decode_with_stb(bytes, pixels, flipVertically);
+    }
+
+    ImageDecoder::ImageDecoder(JobSystem* jobs) : _jobs(jobs)
+    {
+    }
+
+    u32 ImageDecoder::add(const std::string& path, const bool flipVertically)
+    {
+        Image image;
+        image.file = MappedFile(path, EFileAccess::WILL_NEED);
+        image.bytes = image.file.bytes();
+        image.flip = flipVertically;
+        image.valid = image.file.valid();
+        return _add(std::move(image));
+    }
+
+    u32 ImageDecoder::add(const span<const u8> bytes, const bool flipVertically)
+    {
+        Image image;
+        image.bytes = bytes;
+        image.flip = flipVertically;
+        image.valid = true;
+        return _add(std::move(image));
+    }
+
+    u32 ImageDecoder::_add(Image&& image)
+    {
+        image.valid = image.valid && readImageInfo(image.bytes, image.info);
+        image.offset = (_size + image_alignment - 1) & ~(image_alignment - 1);
+        image.decoded = false;
+        if (image.valid)
+        {
+            _size = image.offset +
+                    static_cast<u64>(image.info.width) * image.info.height * 4;
+        }
+        else
+        {
+            image.info = ImageInfo();
+        }
+
+        _images.push_back(std::move(image));
+        return static_cast<u32>(_images.size() - 1);
+    }
+
+    u32 ImageDecoder::imageCount() const noexcept
+    {
+        return static_cast<u32>(_images.size());
+    }
+
+    bool ImageDecoder::valid(const u32 index) const noexcept
+    {
+        return _images[index].valid;
+    }
+
+    const ImageInfo& ImageDecoder::info(const u32 index) const noexcept
+    {
+        return _images[index].info;
+    }
+
+    u64 ImageDecoder::offset(const u32 index) const noexcept
+    {
+        return _images[index].offset;
+    }
+
+    u64 ImageDecoder::size() const noexcept
+    {
+        return _size;
+    }
+
+    bool ImageDecoder::decode(u8* destination)
+    {
+        const auto decodeImages = [this, destination](const size_t begin,
+                                                      const size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                Image& image = _images[i];
+                image.decoded =
+                    image.valid && decodeImage(image.bytes,
+                                               destination + image.offset,
+                                               image.flip);
+            }
+        };
+
+        if (_jobs != nullptr)
+        {
+            _jobs->parallelFor(_images.size(), 1, decodeImages);
+        }
+        else
+        {
+            decodeImages(0, _images.size());
+        }
+
+        for (const Image& image : _images)
+        {
+            if (!image.decoded)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ImageDecoder::decoded(const u32 index) const noexcept
+    {
+        return _images[index].decoded;
+    }
+
+    void ImageDecoder::clear()
+    {
+        _images.clear();
+        _size = 0;
+    }
+} // namespace helios
@@ -0,0 +1,588 @@
+#include <helios/io/inflate.hpp>
+
+#include <cstring>
+
+namespace helios
+{
+    // Codes up to this many bits resolve with one lookup, longer ones go
+    // through a second level table hanging off the first.
+    static constexpr u32 litlen_table_bits = 10;
+    static constexpr u32 distance_table_bits = 8;
+    static constexpr u32 precode_table_bits = 7;
+    static constexpr u32 max_code_length = 15;
+
+    static constexpr u32 litlen_symbols = 288;
+    static constexpr u32 distance_symbols = 32;
+    static constexpr u32 precode_symbols = 19;
+
+    // the first level plus room for one second level table per symbol
+    static constexpr u32 litlen_table_size =
+        (1 << litlen_table_bits) +
+        litlen_symbols * (1 << (max_code_length - litlen_table_bits));
+    static constexpr u32 distance_table_size =
+        (1 << distance_table_bits) +
+        distance_symbols * (1 << (max_code_length - distance_table_bits));
+    static constexpr u32 precode_table_size = 1 << precode_table_bits;
+
+    // A table entry packs the number of bits to consume, what the code
+    // stands for, its extra bit count and a value: the literal, the base of
+    // a length or distance, or where a second level table starts.
+    enum : u32
+    {
+        entry_literal = 0,
+        entry_base = 1,
+        entry_end = 2,
+        entry_subtable = 3,
+        entry_invalid = 4
+    };
+
+    static constexpr u32 make_entry(const u32 bits, const u32 kind,
+                                    const u32 extra, const u32 value)
+    {
+        return bits | (kind << 8) | (extra << 12) | (value << 16);
+    }
+
+    static u32 entry_bits(const u32 entry)
+    {
+        return entry & 0xFF;
+    }
+
+    static u32 entry_kind(const u32 entry)
+    {
+        return (entry >> 8) & 0xF;
+    }
+
+    static u32 entry_extra(const u32 entry)
+    {
+        return (entry >> 12) & 0xF;
+    }
+
+    static u32 entry_value(const u32 entry)
+    {
+        return entry >> 16;
+    }
+
+    static constexpr u16 length_base[29] = {
+        3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+        31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static constexpr u8 length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                            1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                            4, 4, 4, 4, 5, 5, 5, 5, 0};
+    static constexpr u16 distance_base[30] = {
+        1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+        33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+        1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+    static constexpr u8 distance_extra[30] = {0, 0, 0,  0,  1,  1,  2,  2,
+                                              3, 3, 4,  4,  5,  5,  6,  6,
+                                              7, 7, 8,  8,  9,  9,  10, 10,
+                                              11, 11, 12, 12, 13, 13};
+    static constexpr u8 precode_order[precode_symbols] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+    struct DeflateTables
+    {
+        // what each symbol decodes to, without the bit count
+        u32 litlenSymbols[litlen_symbols];
+        u32 distanceSymbols[distance_symbols];
+        u32 precodeSymbols[precode_symbols];
+        u32 fixedLitlen[litlen_table_size];
+        u32 fixedDistance[distance_table_size];
+    };
+
+    struct HuffmanTables
+    {
+        u32 litlen[litlen_table_size];
+        u32 distance[distance_table_size];
+    };
+
+    // Fills a decode table for the canonical code given by the lengths.
+    // Incomplete codes are allowed, their unused entries decode as invalid.
+    static bool build_table(const u8* lengths, const u32 count,
+                            const u32* symbols, const u32 tableBits,
+                            u32* table, const u32 capacity)
+    {
+        u32 counts[max_code_length + 1] = {};
+        for (u32 s = 0; s < count; s++)
+        {
+            counts[lengths[s]]++;
+        }
+        counts[0] = 0;
+
+        i32 left = 1;
+        u32 next[max_code_length + 1] = {};
+        u32 code = 0;
+        for (u32 length = 1; length <= max_code_length; length++)
+        {
+            left = (left << 1) - static_cast<i32>(counts[length]);
+            if (left < 0)
+            {
+                return false;
+            }
+            code = (code + counts[length - 1]) << 1;
+            next[length] = code;
+        }
+
+        const u32 primarySize = 1u << tableBits;
+        const u32 mask = primarySize - 1;
+        const u32 invalid = make_entry(0, entry_invalid, 0, 0);
+        for (u32 i = 0; i < primarySize; i++)
+        {
+            table[i] = invalid;
+        }
+
+        // codes are stored most significant bit first, the bit buffer
+        // hands them out least significant first
+        u16 reversed[litlen_symbols];
+        u8 longest[1 << litlen_table_bits] = {};
+        for (u32 s = 0; s < count; s++)
+        {
+            const u32 length = lengths[s];
+            if (length == 0)
+            {
+                continue;
+            }
+            const u32 value = next[length]++;
+            u32 bits = 0;
+            for (u32 b = 0; b < length; b++)
+            {
+                bits |= ((value >> b) & 1) << (length - 1 - b);
+            }
+            reversed[s] = static_cast<u16>(bits);
+            if (length > tableBits && length > longest[bits & mask])
+            {
+                longest[bits & mask] = static_cast<u8>(length);
+            }
+        }
+
+        u32 used = primarySize;
+        for (u32 prefix = 0; prefix < primarySize; prefix++)
+        {
+            if (longest[prefix] == 0)
+            {
+                continue;
+            }
+            const u32 subBits = longest[prefix] - tableBits;
+            if (used + (1u << subBits) > capacity)
+            {
+                return false;
+            }
+            table[prefix] = make_entry(tableBits, entry_subtable, subBits, used);
+            for (u32 i = 0; i < (1u << subBits); i++)
+            {
+                table[used + i] = invalid;
+            }
+            used += 1u << subBits;
+        }
+
+        for (u32 s = 0; s < count; s++)
+        {
+            const u32 length = lengths[s];
+            if (length == 0)
+            {
+                continue;
+            }
+            const u32 bits = reversed[s];
+            if (length <= tableBits)
+            {
+                for (u32 i = bits; i < primarySize; i += 1u << length)
+                {
+                    table[i] = symbols[s] | length;
+                }
+            }
+            else
+            {
+                const u32 pointer = table[bits & mask];
+                const u32 offset = entry_value(pointer);
+                const u32 subSize = 1u << entry_extra(pointer);
+                const u32 remaining = length - tableBits;
+                for (u32 i = bits >> tableBits; i < subSize;
+                     i += 1u << remaining)
+                {
+                    table[offset + i] = symbols[s] | remaining;
+                }
+            }
+        }
+        return true;
+    }
+
+    static DeflateTables make_tables()
+    {
+        DeflateTables tables;
+        for (u32 s = 0; s < litlen_symbols; s++)
+        {
+            if (s < 256)
+            {
+                tables.litlenSymbols[s] = make_entry(0, entry_literal, 0, s);
+            }
+            else if (s == 256)
+            {
+                tables.litlenSymbols[s] = make_entry(0, entry_end, 0, 0);
+            }
+            else if (s < 286)
+            {
+                tables.litlenSymbols[s] =
+                    make_entry(0, entry_base, length_extra[s - 257],
+                               length_base[s - 257]);
+            }
+            else
+            {
+                tables.litlenSymbols[s] = make_entry(0, entry_invalid, 0, 0);
+            }
+        }
+        for (u32 s = 0; s < distance_symbols; s++)
+        {
+            tables.distanceSymbols[s] =
+                s < 30 ? make_entry(0, entry_base, distance_extra[s],
+                                    distance_base[s])
+                       : make_entry(0, entry_invalid, 0, 0);
+        }
+        for (u32 s = 0; s < precode_symbols; s++)
+        {
+            tables.precodeSymbols[s] = make_entry(0, entry_literal, 0, s);
+        }
+
+        u8 lengths[litlen_symbols];
+        for (u32 s = 0; s < litlen_symbols; s++)
+        {
+            lengths[s] = s < 144 ? 8 : (s < 256 ? 9 : (s < 280 ? 7 : 8));
+        }
+        build_table(lengths, litlen_symbols, tables.litlenSymbols,
+                    litlen_table_bits, tables.fixedLitlen, litlen_table_size);
+        memset(lengths, 5, distance_symbols);
+        build_table(lengths, distance_symbols, tables.distanceSymbols,
+                    distance_table_bits, tables.fixedDistance,
+                    distance_table_size);
+        return tables;
+    }
+
+    static const DeflateTables& deflate_tables()
+    {
+        static const DeflateTables tables = make_tables();
+        return tables;
+    }
+
+    struct BitReader
+    {
+        const u8* begin;
+        const u8* next;
+        const u8* end;
+        u64 buffer;
+        u32 count;
+        // zero bytes fed in past the end of the input
+        u32 overread;
+    };
+
+    // Tops the buffer up to at least 56 bits. With 8 bytes of input left it
+    // is one unaligned load, whole bytes are consumed and the partial byte
+    // above the count is loaded again next time.
+    static void refill(BitReader& reader)
+    {
+        if (reader.end - reader.next >= 8)
+        {
+            u64 word;
+            memcpy(&word, reader.next, sizeof(word));
+            reader.buffer |= word << reader.count;
+            reader.next += (63 - reader.count) >> 3;
+            reader.count |= 56;
+            return;
+        }
+        while (reader.count < 56)
+        {
+            u64 byte = 0;
+            if (reader.next < reader.end)
+            {
+                byte = *reader.next++;
+            }
+            else
+            {
+                reader.overread++;
+            }
+            reader.buffer |= byte << reader.count;
+            reader.count += 8;
+        }
+    }
+
+    static u32 read_bits(BitReader& reader, const u32 count)
+    {
+        const u32 value =
+            static_cast<u32>(reader.buffer & ((u64(1) << count) - 1));
+        reader.buffer >>= count;
+        reader.count -= count;
+        return value;
+    }
+
+    static u32 decode_symbol(BitReader& reader, const u32* table,
+                             const u32 tableBits)
+    {
+        u32 entry = table[reader.buffer & ((1u << tableBits) - 1)];
+        if (entry_kind(entry) == entry_subtable)
+        {
+            read_bits(reader, tableBits);
+            entry = table[entry_value(entry) +
+                          (reader.buffer & ((1u << entry_extra(entry)) - 1))];
+        }
+        read_bits(reader, entry_bits(entry));
+        return entry;
+    }
+
+    static bool read_dynamic_tables(BitReader& reader, HuffmanTables& tables)
+    {
+        const DeflateTables& shared = deflate_tables();
+
+        refill(reader);
+        const u32 litlenCount = read_bits(reader, 5) + 257;
+        const u32 distanceCount = read_bits(reader, 5) + 1;
+        const u32 precodeCount = read_bits(reader, 4) + 4;
+        if (litlenCount > 286 || distanceCount > 30)
+        {
+            return false;
+        }
+
+        u8 precodeLengths[precode_symbols] = {};
+        for (u32 i = 0; i < precodeCount; i++)
+        {
+            refill(reader);
+            precodeLengths[precode_order[i]] =
+                static_cast<u8>(read_bits(reader, 3));
+        }
+        u32 precode[precode_table_size];
+        if (!build_table(precodeLengths, precode_symbols,
+                         shared.precodeSymbols, precode_table_bits, precode,
+                         precode_table_size))
+        {
+            return false;
+        }
+
+        u8 lengths[litlen_symbols + distance_symbols] = {};
+        const u32 total = litlenCount + distanceCount;
+        u32 i = 0;
+        while (i < total)
+        {
+            refill(reader);
+            const u32 entry =
+                decode_symbol(reader, precode, precode_table_bits);
+            if (entry_kind(entry) != entry_literal)
+            {
+                return false;
+            }
+
+            const u32 symbol = entry_value(entry);
+            if (symbol < 16)
+            {
+                lengths[i++] = static_cast<u8>(symbol);
+                continue;
+            }
+
+            u32 repeat;
+            u8 value = 0;
+            if (symbol == 16)
+            {
+                if (i == 0)
+                {
+                    return false;
+                }
+                value = lengths[i - 1];
+                repeat = 3 + read_bits(reader, 2);
+            }
+            else if (symbol == 17)
+            {
+                repeat = 3 + read_bits(reader, 3);
+            }
+            else
+            {
+                repeat = 11 + read_bits(reader, 7);
+            }
+            if (i + repeat > total)
+            {
+                return false;
+            }
+            memset(lengths + i, value, repeat);
+            i += repeat;
+        }
+
+        // a block without an end of block code can never finish
+        if (lengths[256] == 0)
+        {
+            return false;
+        }
+
+        return build_table(lengths, litlenCount, shared.litlenSymbols,
+                           litlen_table_bits, tables.litlen,
+                           litlen_table_size) &&
+               build_table(lengths + litlenCount, distanceCount,
+                           shared.distanceSymbols, distance_table_bits,
+                           tables.distance, distance_table_size);
+    }
+
+    static bool copy_stored(BitReader& reader, u8*& out, const u8* outEnd)
+    {
+        // skip to the byte boundary, then find where the reader really is
+        read_bits(reader, reader.count % 8);
+        const size_t unread = reader.count / 8;
+        const size_t loaded =
+            static_cast<size_t>(reader.next - reader.begin) + reader.overread;
+        const size_t position = loaded - unread;
+        const size_t size = static_cast<size_t>(reader.end - reader.begin);
+        if (unread < reader.overread || position + 4 > size)
+        {
+            return false;
+        }
+
+        const u8* header = reader.begin + position;
+        const u32 length = header[0] | (header[1] << 8);
+        const u32 inverse = header[2] | (header[3] << 8);
+        if (length != (~inverse & 0xFFFF) || position + 4 + length > size ||
+            length > static_cast<size_t>(outEnd - out))
+        {
+            return false;
+        }
+
+        memcpy(out, header + 4, length);
+        out += length;
+        reader.next = header + 4 + length;
+        reader.buffer = 0;
+        reader.count = 0;
+        reader.overread = 0;
+        return true;
+    }
+
+    size_t inflate(const span<const u8> input, u8* output,
+                   const size_t capacity) noexcept
+    {
+        const DeflateTables& shared = deflate_tables();
+        HuffmanTables dynamic;
+
+        BitReader reader{input.data(), input.data(),
+                         input.data() + input.size(), 0, 0, 0};
+        u8* out = output;
+        u8* const outEnd = output + capacity;
+
+        u32 final = 0;
+        while (final == 0)
+        {
+            refill(reader);
+            final = read_bits(reader, 1);
+            const u32 type = read_bits(reader, 2);
+
+            const u32* litlen;
+            const u32* distance;
+            if (type == 0)
+            {
+                if (!copy_stored(reader, out, outEnd))
+                {
+                    return inflate_error;
+                }
+                continue;
+            }
+            else if (type == 1)
+            {
+                litlen = shared.fixedLitlen;
+                distance = shared.fixedDistance;
+            }
+            else if (type == 2)
+            {
+                if (!read_dynamic_tables(reader, dynamic))
+                {
+                    return inflate_error;
+                }
+                litlen = dynamic.litlen;
+                distance = dynamic.distance;
+            }
+            else
+            {
+                return inflate_error;
+            }
+
+            // one refill covers the longest length code, its extra bits,
+            // the longest distance code and its extra bits
+            for (;;)
+            {
+                refill(reader);
+                u32 entry = decode_symbol(reader, litlen, litlen_table_bits);
+                const u32 kind = entry_kind(entry);
+                if (kind == entry_literal)
+                {
+                    if (out == outEnd)
+                    {
+                        return inflate_error;
+                    }
+                    *out++ = static_cast<u8>(entry_value(entry));
+                    continue;
+                }
+                if (kind == entry_end)
+                {
+                    break;
+                }
+                if (kind != entry_base)
+                {
+                    return inflate_error;
+                }
+
+                const size_t length =
+                    entry_value(entry) + read_bits(reader, entry_extra(entry));
+                entry = decode_symbol(reader, distance, distance_table_bits);
+                if (entry_kind(entry) != entry_base)
+                {
+                    return inflate_error;
+                }
+                const size_t offset =
+                    entry_value(entry) + read_bits(reader, entry_extra(entry));
+                if (offset > static_cast<size_t>(out - output) ||
+                    length > static_cast<size_t>(outEnd - out))
+                {
+                    return inflate_error;
+                }
+
+                const u8* source = out - offset;
+                u8* const stop = out + length;
+                if (offset >= 8 && static_cast<size_t>(outEnd - out) >= length + 8)
+                {
+                    // whole words, the source stays at least a word behind
+                    do
+                    {
+                        memcpy(out, source, 8);
+                        out += 8;
+                        source += 8;
+                    } while (out < stop);
+                }
+                else if (offset == 1)
+                {
+                    memset(out, *source, length);
+                }
+                else
+                {
+                    for (size_t i = 0; i < length; i++)
+                    {
+                        out[i] = source[i];
+                    }
+                }
+                out = stop;
+            }
+
+            // bits fed in past the end of the input were used
+            if (reader.overread * 8 > reader.count)
+            {
+                return inflate_error;
+            }
+        }
+
+        return static_cast<size_t>(out - output);
+    }
+
+    size_t inflateZlib(const span<const u8> input, u8* output,
+                       const size_t capacity) noexcept
+    {
+        if (input.size() < 2)
+        {
+            return inflate_error;
+        }
+        const u32 method = input[0];
+        const u32 flags = input[1];
+        if ((method & 0xF) != 8 || (method >> 4) > 7 ||
+            (method * 256 + flags) % 31 != 0 || (flags & 0x20) != 0)
+        {
+            return inflate_error;
+        }
+        return inflate(input.subspan(2, input.size() - 2), output, capacity);
+    }
+} // namespace helios
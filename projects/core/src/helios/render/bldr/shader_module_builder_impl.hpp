@@ -1,5 +1,6 @@
 #pragma once
 
+#include <helios/containers/span.hpp>
 #include <helios/containers/vector.hpp>
 #include <helios/render/graphics.hpp>
 
@@ -7,7 +8,10 @@ namespace helios
 {
     struct ShaderModuleBuilder::ShaderModuleBuilderImpl
     {
+        // owned copy when built from a vector, code always points at the
+        // bytes the module is created from
         vector<uint8_t> data;
+        span<const u8> code;
         IDevice* device = nullptr;
     };
 } // namespace helios
\ No newline at end of file
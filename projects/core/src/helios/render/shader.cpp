@@ -42,9 +42,6 @@ namespace helios
     Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource, IRenderPass* pass,
                    const u32 subpass)
     {
-        const vector<uint8_t> vertexSourceBytes = File::read_binary(vertexSource);
-        const vector<uint8_t> fragSourceBytes = File::read_binary(fragmentSource);
-
         _read_reflection(vertexSource + ".refl");
         _read_reflection(fragmentSource + ".refl");
         _build_layout();
@@ -62,8 +59,9 @@ namespace helios
 
     void Shader::_read_reflection(const std::string& source)
     {
-        const std::string refl = File::read_text(source);
-        nlohmann::json json = nlohmann::json::parse(refl);
+        const MappedFile refl(source);
+        const std::string_view text = refl.text();
+        nlohmann::json json = nlohmann::json::parse(text.begin(), text.end());
 
         std::string entrypoint;
 
@@ -249,10 +247,10 @@ namespace helios
 
     IShaderModule* Shader::_read_module(const std::string& source)
     {
-        vector<u8> src = File::read_binary(source);
+        const MappedFile src(source);
         IDevice* device = &EngineContextFactory().create().render().device();
 
-        return ShaderModuleBuilder().device(device).source(src).build();
+        return ShaderModuleBuilder().device(device).source(src.bytes()).build();
     }
 
     void Shader::_build_pipeline(const std::string& vertexSource, const std::string fragmentSource)
@@ -29,6 +29,14 @@ namespace helios
         const vector<uint8_t>& source)
     {
         _impl->data = source;
+        _impl->code = _impl->data;
+        return *this;
+    }
+
+    ShaderModuleBuilder& ShaderModuleBuilder::source(const span<const u8> source)
+    {
+        _impl->data.clear();
+        _impl->code = source;
         return *this;
     }
 
@@ -39,8 +47,8 @@ namespace helios
 
         VkShaderModuleCreateInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        info.codeSize = static_cast<u32>(_impl->data.size());
-        info.pCode = reinterpret_cast<u32*>(_impl->data.data());
+        info.codeSize = static_cast<u32>(_impl->code.size());
+        info.pCode = reinterpret_cast<const u32*>(_impl->code.data());
         vkCreateShaderModule(shader->device->device, &info, nullptr,
                              &shader->shaderModule);
         shader->device->modules.push_back(shader);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <helios/macros.hpp>
+
+#include <cstddef>
+
+namespace helios
+{
+    // Encoders and decoders of the BCn block compressed texture formats.
+    // Every call handles one 4x4 block, given as 16 RGBA8 pixels in row
+    // order. The encoders fit endpoints along the principal axis of the
+    // block, refine them by least squares and pick indices with AVX2, and
+    // return the summed squared error of the encoded block over the
+    // channels the format stores.
+
+    constexpr size_t bc1_block_size = 8;
+    constexpr size_t bc3_block_size = 16;
+    constexpr size_t bc4_block_size = 8;
+    constexpr size_t bc5_block_size = 16;
+    constexpr size_t bc7_block_size = 16;
+
+    // Opaque RGB in the four colour mode, alpha is ignored
+    u32 encodeBC1(const u8* pixels, u8* block) noexcept;
+
+    // BC1 colour followed by a BC4 alpha block
+    u32 encodeBC3(const u8* pixels, u8* block) noexcept;
+
+    // One channel of the pixels, 0 to 3 for red to alpha
+    u32 encodeBC4(const u8* pixels, const u32 channel, u8* block) noexcept;
+
+    // Red and green as two BC4 blocks, the format for normal maps
+    u32 encodeBC5(const u8* pixels, u8* block) noexcept;
+
+    // RGBA in mode 6: one subset, 7 bit endpoints with a shared low bit
+    // and 16 interpolation steps
+    u32 encodeBC7(const u8* pixels, u8* block) noexcept;
+
+    // The decoders write all four channels, those the format does not store
+    // as 0 for colour and 255 for alpha. decodeBC4 only writes its channel.
+    void decodeBC1(const u8* block, u8* pixels) noexcept;
+    void decodeBC3(const u8* block, u8* pixels) noexcept;
+    void decodeBC4(const u8* block, const u32 channel, u8* pixels) noexcept;
+    void decodeBC5(const u8* block, u8* pixels) noexcept;
+
+    // Mode 6 only, the mode encodeBC7 writes. Other modes decode to zero.
+    void decodeBC7(const u8* block, u8* pixels) noexcept;
+} // namespace helios
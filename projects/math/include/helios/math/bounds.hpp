@@ -0,0 +1,212 @@
+#pragma once
+
+#include <helios/macros.hpp>
+#include <helios/math/matrix.hpp>
+#include <helios/math/vector.hpp>
+
+namespace helios
+{
+    struct BoundingSphere;
+
+    struct AABB
+    {
+        Vector3f min;
+        Vector3f max;
+
+        AABB() noexcept;
+        AABB(const Vector3f& min, const Vector3f& max) noexcept;
+        AABB(const AABB& other) noexcept = default;
+        AABB(AABB&& other) noexcept = default;
+        ~AABB() = default;
+        AABB& operator=(const AABB& rhs) noexcept = default;
+        AABB& operator=(AABB&& rhs) noexcept = default;
+
+        HELIOS_NO_DISCARD bool empty() const noexcept;
+        HELIOS_NO_DISCARD Vector3f center() const noexcept;
+        HELIOS_NO_DISCARD Vector3f extents() const noexcept;
+        HELIOS_NO_DISCARD Vector3f size() const noexcept;
+        HELIOS_NO_DISCARD f32 surfaceArea() const noexcept;
+        HELIOS_NO_DISCARD bool contains(const Vector3f& point) const noexcept;
+        HELIOS_NO_DISCARD bool contains(const AABB& other) const noexcept;
+        HELIOS_NO_DISCARD bool intersects(const AABB& other) const noexcept;
+        HELIOS_NO_DISCARD bool intersects(
+            const BoundingSphere& sphere) const noexcept;
+        HELIOS_NO_DISCARD AABB transform(const Matrix4f& mat) const noexcept;
+        AABB& expand(const Vector3f& point) noexcept;
+        AABB& expand(const AABB& other) noexcept;
+
+        HELIOS_NO_DISCARD static AABB fromCenterExtents(
+            const Vector3f& center, const Vector3f& extents) noexcept;
+        HELIOS_NO_DISCARD static AABB fromPoints(const Vector3f* points,
+                                                 const size_t count) noexcept;
+    };
+
+    struct BoundingSphere
+    {
+        Vector3f center;
+        f32 radius;
+
+        BoundingSphere() noexcept;
+        BoundingSphere(const Vector3f& center, const f32 radius) noexcept;
+        BoundingSphere(const BoundingSphere& other) noexcept = default;
+        BoundingSphere(BoundingSphere&& other) noexcept = default;
+        ~BoundingSphere() = default;
+        BoundingSphere& operator=(const BoundingSphere& rhs) noexcept =
+            default;
+        BoundingSphere& operator=(BoundingSphere&& rhs) noexcept = default;
+
+        HELIOS_NO_DISCARD bool empty() const noexcept;
+        HELIOS_NO_DISCARD bool contains(const Vector3f& point) const noexcept;
+        HELIOS_NO_DISCARD bool intersects(
+            const BoundingSphere& other) const noexcept;
+        HELIOS_NO_DISCARD bool intersects(const AABB& box) const noexcept;
+        HELIOS_NO_DISCARD BoundingSphere transform(
+            const Matrix4f& mat) const noexcept;
+        BoundingSphere& expand(const Vector3f& point) noexcept;
+        BoundingSphere& expand(const BoundingSphere& other) noexcept;
+
+        HELIOS_NO_DISCARD static BoundingSphere fromAABB(
+            const AABB& box) noexcept;
+        HELIOS_NO_DISCARD static BoundingSphere fromPoints(
+            const Vector3f* points, const size_t count) noexcept;
+    };
+
+    struct OBB
+    {
+        Vector3f center;
+        Vector3f extents;
+        Vector3f axes[3];
+
+        OBB() noexcept;
+        OBB(const Vector3f& center, const Vector3f& extents,
+            const Vector3f& axisX, const Vector3f& axisY,
+            const Vector3f& axisZ) noexcept;
+        OBB(const OBB& other) noexcept = default;
+        OBB(OBB&& other) noexcept = default;
+        ~OBB() = default;
+        OBB& operator=(const OBB& rhs) noexcept = default;
+        OBB& operator=(OBB&& rhs) noexcept = default;
+
+        HELIOS_NO_DISCARD bool contains(const Vector3f& point) const noexcept;
+        HELIOS_NO_DISCARD AABB toAABB() const noexcept;
+
+        HELIOS_NO_DISCARD static OBB fromAABB(const AABB& box,
+                                              const Matrix4f& mat) noexcept;
+    };
+
+    struct Plane
+    {
+        Vector3f normal;
+        f32 distance;
+
+        Plane() noexcept;
+        Plane(const Vector3f& normal, const f32 distance) noexcept;
+        Plane(const Vector3f& normal, const Vector3f& point) noexcept;
+        explicit Plane(const Vector4f& coefficients) noexcept;
+        Plane(const Plane& other) noexcept = default;
+        Plane(Plane&& other) noexcept = default;
+        ~Plane() = default;
+        Plane& operator=(const Plane& rhs) noexcept = default;
+        Plane& operator=(Plane&& rhs) noexcept = default;
+
+        HELIOS_NO_DISCARD f32 signedDistance(
+            const Vector3f& point) const noexcept;
+        HELIOS_NO_DISCARD Plane normalize() const noexcept;
+    };
+
+    struct Ray
+    {
+        Vector3f origin;
+        Vector3f direction;
+
+        Ray() noexcept;
+        Ray(const Vector3f& origin, const Vector3f& direction) noexcept;
+        Ray(const Ray& other) noexcept = default;
+        Ray(Ray&& other) noexcept = default;
+        ~Ray() = default;
+        Ray& operator=(const Ray& rhs) noexcept = default;
+        Ray& operator=(Ray&& rhs) noexcept = default;
+
+        HELIOS_NO_DISCARD Vector3f at(const f32 distance) const noexcept;
+
+        // On a hit, distance receives the entry distance along the ray in
+        // units of direction, 0 if the origin is inside the volume.
+        HELIOS_NO_DISCARD bool intersects(const AABB& box,
+                                          f32& distance) const noexcept;
+        HELIOS_NO_DISCARD bool intersects(const BoundingSphere& sphere,
+                                          f32& distance) const noexcept;
+    };
+
+    struct Frustum
+    {
+        enum EPlane : u32
+        {
+            LEFT_PLANE = 0,
+            RIGHT_PLANE,
+            BOTTOM_PLANE,
+            TOP_PLANE,
+            NEAR_PLANE,
+            FAR_PLANE,
+            PLANE_COUNT
+        };
+
+        Plane planes[PLANE_COUNT];
+
+        Frustum() noexcept = default;
+        explicit Frustum(const Matrix4f& viewProjection) noexcept;
+
+        HELIOS_NO_DISCARD bool contains(const Vector3f& point) const noexcept;
+        HELIOS_NO_DISCARD bool intersects(const AABB& box) const noexcept;
+        HELIOS_NO_DISCARD bool intersects(
+            const BoundingSphere& sphere) const noexcept;
+        HELIOS_NO_DISCARD bool intersects(const OBB& box) const noexcept;
+
+        HELIOS_NO_DISCARD static Frustum fromMatrix(
+            const Matrix4f& viewProjection) noexcept;
+    };
+
+    // Structure of arrays views over bounding volumes, consumed eight at a
+    // time by the batch culling routines. Each pointer references `count`
+    // contiguous floats.
+    struct AABBSoA
+    {
+        const f32* centerX;
+        const f32* centerY;
+        const f32* centerZ;
+        const f32* extentX;
+        const f32* extentY;
+        const f32* extentZ;
+    };
+
+    struct BoundingSphereSoA
+    {
+        const f32* centerX;
+        const f32* centerY;
+        const f32* centerZ;
+        const f32* radius;
+    };
+
+    HELIOS_NO_DISCARD constexpr size_t visibilityMaskSize(
+        const size_t count) noexcept;
+
+    // Writes one bit per volume into visibility, bit (i % 8) of byte (i / 8)
+    // set if volume i intersects the frustum. visibility must hold at least
+    // visibilityMaskSize(count) bytes. Returns the number of visible volumes.
+    size_t cull(const Frustum& frustum, const AABBSoA& boxes,
+                const size_t count, u8* visibility) noexcept;
+    size_t cull(const Frustum& frustum, const BoundingSphereSoA& spheres,
+                const size_t count, u8* visibility) noexcept;
+
+    HELIOS_NO_DISCARD constexpr bool isVisible(const u8* visibility,
+                                               const size_t index) noexcept;
+
+    constexpr size_t visibilityMaskSize(const size_t count) noexcept
+    {
+        return (count + 7) / 8;
+    }
+
+    constexpr bool isVisible(const u8* visibility, const size_t index) noexcept
+    {
+        return (visibility[index / 8] >> (index % 8)) & 1;
+    }
+} // namespace helios
@@ -19,25 +19,25 @@ namespace helios
             f32 data[16];
         };
 
-        Matrix4f() noexcept;
-        Matrix4f(const f32 diagonal) noexcept;
-        Matrix4f(const Vector4f& col0, const Vector4f& col1,
-                 const Vector4f& col2, const Vector4f& col3) noexcept;
-        explicit Matrix4f(const float values[16],
-                          const bool aligned = false) noexcept;
-        Matrix4f(const Matrix4f& other) noexcept;
-        Matrix4f(Matrix4f&& other) noexcept;
+        constexpr Matrix4f() noexcept;
+        constexpr Matrix4f(const f32 diagonal) noexcept;
+        constexpr Matrix4f(const Vector4f& col0, const Vector4f& col1,
+                           const Vector4f& col2, const Vector4f& col3) noexcept;
+        constexpr explicit Matrix4f(const float values[16],
+                                    const bool aligned = false) noexcept;
+        constexpr Matrix4f(const Matrix4f& other) noexcept;
+        constexpr Matrix4f(Matrix4f&& other) noexcept;
         ~Matrix4f() = default;
-        Matrix4f& operator=(const f32 diagonal) noexcept;
-        Matrix4f& operator=(const Matrix4f& rhs) noexcept;
-        Matrix4f& operator=(Matrix4f&& rhs) noexcept;
-        bool operator==(const Matrix4f& rhs) const noexcept;
-        bool operator!=(const Matrix4f& rhs) const noexcept;
+        constexpr Matrix4f& operator=(const f32 diagonal) noexcept;
+        constexpr Matrix4f& operator=(const Matrix4f& rhs) noexcept;
+        constexpr Matrix4f& operator=(Matrix4f&& rhs) noexcept;
+        constexpr bool operator==(const Matrix4f& rhs) const noexcept;
+        constexpr bool operator!=(const Matrix4f& rhs) const noexcept;
 
         Matrix4f& operator+=(const Matrix4f& rhs);
         Matrix4f& operator-=(const Matrix4f& rhs);
         Matrix4f& operator*=(const f32 scalar);
-        Matrix4f& operator*=(const Matrix4f& rhs);
+        constexpr Matrix4f& operator*=(const Matrix4f& rhs);
 
         HELIOS_NO_DISCARD Matrix4f inverse() const noexcept;
     };
@@ -50,10 +50,190 @@ namespace helios
                                          const f32 rhs) noexcept;
     HELIOS_NO_DISCARD Matrix4f operator*(const f32 lhs,
                                          const Matrix4f& rhs) noexcept;
-    HELIOS_NO_DISCARD Vector4f operator*(const Matrix4f& lhs,
-                                         const Vector4f& rhs) noexcept;
-    HELIOS_NO_DISCARD Matrix4f operator*(const Matrix4f& lhs,
-                                         const Matrix4f& rhs) noexcept;
+    HELIOS_NO_DISCARD constexpr Vector4f operator*(
+        const Matrix4f& lhs, const Vector4f& rhs) noexcept;
+    HELIOS_NO_DISCARD constexpr Matrix4f operator*(
+        const Matrix4f& lhs, const Matrix4f& rhs) noexcept;
 
     HELIOS_NO_DISCARD Matrix4f inverse(const Matrix4f& mat) noexcept;
+
+    namespace detail
+    {
+        // SSE kernels backing the constexpr operators at runtime, see
+        // matrix.cpp. out may alias lhs, but not rhs.
+        void multiply(const f32* lhs, const f32* rhs, f32* out) noexcept;
+        void transform(const f32* lhs, const f32* rhs, f32* out) noexcept;
+        bool equals(const f32* lhs, const f32* rhs) noexcept;
+
+        constexpr void multiplyScalar(const f32* lhs, const f32* rhs,
+                                      f32* out) noexcept
+        {
+            f32 res[16] = {};
+            for (i32 col = 0; col < 4; col++)
+            {
+                for (i32 row = 0; row < 4; row++)
+                {
+                    res[col * 4 + row] = lhs[0 * 4 + row] * rhs[col * 4 + 0] +
+                                         lhs[1 * 4 + row] * rhs[col * 4 + 1] +
+                                         lhs[2 * 4 + row] * rhs[col * 4 + 2] +
+                                         lhs[3 * 4 + row] * rhs[col * 4 + 3];
+                }
+            }
+
+            for (i32 i = 0; i < 16; i++)
+            {
+                out[i] = res[i];
+            }
+        }
+    } // namespace detail
+
+    constexpr Matrix4f::Matrix4f() noexcept : data()
+    {
+    }
+
+    constexpr Matrix4f::Matrix4f(const f32 diagonal) noexcept : data()
+    {
+        data[0] = data[5] = data[10] = data[15] = diagonal;
+    }
+
+    constexpr Matrix4f::Matrix4f(const Vector4f& col0, const Vector4f& col1,
+                                 const Vector4f& col2,
+                                 const Vector4f& col3) noexcept
+        : data()
+    {
+        for (i32 i = 0; i < 4; i++)
+        {
+            data[0 + i] = col0.data[i];
+            data[4 + i] = col1.data[i];
+            data[8 + i] = col2.data[i];
+            data[12 + i] = col3.data[i];
+        }
+    }
+
+    constexpr Matrix4f::Matrix4f(const float values[16],
+                                 const bool aligned) noexcept
+        : data()
+    {
+        // alignment only mattered to the old SSE loads, the copy below is
+        // vectorised either way
+        (void)aligned;
+        for (i32 i = 0; i < 16; i++)
+        {
+            data[i] = values[i];
+        }
+    }
+
+    constexpr Matrix4f::Matrix4f(const Matrix4f& other) noexcept : data()
+    {
+        for (i32 i = 0; i < 16; i++)
+        {
+            data[i] = other.data[i];
+        }
+    }
+
+    constexpr Matrix4f::Matrix4f(Matrix4f&& other) noexcept : data()
+    {
+        for (i32 i = 0; i < 16; i++)
+        {
+            data[i] = other.data[i];
+        }
+    }
+
+    constexpr Matrix4f& Matrix4f::operator=(const f32 diagonal) noexcept
+    {
+        for (i32 i = 0; i < 16; i++)
+        {
+            data[i] = 0.0f;
+        }
+        data[0] = data[5] = data[10] = data[15] = diagonal;
+        return *this;
+    }
+
+    constexpr Matrix4f& Matrix4f::operator=(const Matrix4f& rhs) noexcept
+    {
+        for (i32 i = 0; i < 16; i++)
+        {
+            data[i] = rhs.data[i];
+        }
+        return *this;
+    }
+
+    constexpr Matrix4f& Matrix4f::operator=(Matrix4f&& rhs) noexcept
+    {
+        for (i32 i = 0; i < 16; i++)
+        {
+            data[i] = rhs.data[i];
+        }
+        return *this;
+    }
+
+    constexpr bool Matrix4f::operator==(const Matrix4f& rhs) const noexcept
+    {
+        if (HELIOS_IS_CONSTANT_EVALUATED())
+        {
+            for (i32 i = 0; i < 16; i++)
+            {
+                if (data[i] != rhs.data[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return detail::equals(data, rhs.data);
+    }
+
+    constexpr bool Matrix4f::operator!=(const Matrix4f& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    constexpr Matrix4f& Matrix4f::operator*=(const Matrix4f& rhs)
+    {
+        if (HELIOS_IS_CONSTANT_EVALUATED())
+        {
+            detail::multiplyScalar(data, rhs.data, data);
+        }
+        else
+        {
+            detail::multiply(data, rhs.data, data);
+        }
+        return *this;
+    }
+
+    constexpr Vector4f operator*(const Matrix4f& lhs,
+                                 const Vector4f& rhs) noexcept
+    {
+        Vector4f res;
+        if (HELIOS_IS_CONSTANT_EVALUATED())
+        {
+            for (i32 row = 0; row < 4; row++)
+            {
+                res.data[row] = lhs.data[0 * 4 + row] * rhs.data[0] +
+                                lhs.data[1 * 4 + row] * rhs.data[1] +
+                                lhs.data[2 * 4 + row] * rhs.data[2] +
+                                lhs.data[3 * 4 + row] * rhs.data[3];
+            }
+        }
+        else
+        {
+            detail::transform(lhs.data, rhs.data, res.data);
+        }
+        return res;
+    }
+
+    constexpr Matrix4f operator*(const Matrix4f& lhs,
+                                 const Matrix4f& rhs) noexcept
+    {
+        Matrix4f res;
+        if (HELIOS_IS_CONSTANT_EVALUATED())
+        {
+            detail::multiplyScalar(lhs.data, rhs.data, res.data);
+        }
+        else
+        {
+            detail::multiply(lhs.data, rhs.data, res.data);
+        }
+        return res;
+    }
 } // namespace helios
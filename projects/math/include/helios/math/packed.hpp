@@ -0,0 +1,236 @@
+#pragma once
+
+#include <helios/macros.hpp>
+#include <helios/math/vector.hpp>
+
+namespace helios
+{
+    HELIOS_NO_DISCARD u16 packHalf(const f32 value) noexcept;
+    HELIOS_NO_DISCARD f32 unpackHalf(const u16 value) noexcept;
+    HELIOS_NO_DISCARD i16 packSnorm16(const f32 value) noexcept;
+    HELIOS_NO_DISCARD f32 unpackSnorm16(const i16 value) noexcept;
+    HELIOS_NO_DISCARD i8 packSnorm8(const f32 value) noexcept;
+    HELIOS_NO_DISCARD f32 unpackSnorm8(const i8 value) noexcept;
+    HELIOS_NO_DISCARD u8 packUnorm8(const f32 value) noexcept;
+    HELIOS_NO_DISCARD f32 unpackUnorm8(const u8 value) noexcept;
+    HELIOS_NO_DISCARD u16 packUnorm16(const f32 value) noexcept;
+    HELIOS_NO_DISCARD f32 unpackUnorm16(const u16 value) noexcept;
+
+    // Octahedral mapping of a unit vector onto the [-1, 1] square
+    HELIOS_NO_DISCARD Vector2f encodeOctahedral(
+        const Vector3f& normal) noexcept;
+    HELIOS_NO_DISCARD Vector3f decodeOctahedral(
+        const Vector2f& encoded) noexcept;
+
+    // Matches R16G16_SFLOAT
+    struct Half2
+    {
+        u16 x;
+        u16 y;
+
+        constexpr Half2() noexcept;
+        constexpr Half2(const u16 x, const u16 y) noexcept;
+        explicit Half2(const Vector2f& value) noexcept;
+
+        HELIOS_NO_DISCARD Vector2f unpack() const noexcept;
+    };
+
+    // Matches R16G16B16A16_SFLOAT
+    struct Half4
+    {
+        u16 x;
+        u16 y;
+        u16 z;
+        u16 w;
+
+        constexpr Half4() noexcept;
+        constexpr Half4(const u16 x, const u16 y, const u16 z,
+                        const u16 w) noexcept;
+        explicit Half4(const Vector4f& value) noexcept;
+
+        HELIOS_NO_DISCARD Vector4f unpack() const noexcept;
+    };
+
+    // Matches R16G16_SNORM
+    struct Snorm16x2
+    {
+        i16 x;
+        i16 y;
+
+        constexpr Snorm16x2() noexcept;
+        constexpr Snorm16x2(const i16 x, const i16 y) noexcept;
+        explicit Snorm16x2(const Vector2f& value) noexcept;
+
+        HELIOS_NO_DISCARD Vector2f unpack() const noexcept;
+    };
+
+    // Matches R16G16B16A16_SNORM
+    struct Snorm16x4
+    {
+        i16 x;
+        i16 y;
+        i16 z;
+        i16 w;
+
+        constexpr Snorm16x4() noexcept;
+        constexpr Snorm16x4(const i16 x, const i16 y, const i16 z,
+                            const i16 w) noexcept;
+        explicit Snorm16x4(const Vector4f& value) noexcept;
+
+        HELIOS_NO_DISCARD Vector4f unpack() const noexcept;
+    };
+
+    // Matches R8G8B8A8_SNORM
+    struct Snorm8x4
+    {
+        i8 x;
+        i8 y;
+        i8 z;
+        i8 w;
+
+        constexpr Snorm8x4() noexcept;
+        constexpr Snorm8x4(const i8 x, const i8 y, const i8 z,
+                           const i8 w) noexcept;
+        explicit Snorm8x4(const Vector4f& value) noexcept;
+
+        HELIOS_NO_DISCARD Vector4f unpack() const noexcept;
+    };
+
+    // Matches R8G8B8A8_UNORM
+    struct Unorm8x4
+    {
+        u8 x;
+        u8 y;
+        u8 z;
+        u8 w;
+
+        constexpr Unorm8x4() noexcept;
+        constexpr Unorm8x4(const u8 x, const u8 y, const u8 z,
+                           const u8 w) noexcept;
+        explicit Unorm8x4(const Vector4f& value) noexcept;
+
+        HELIOS_NO_DISCARD Vector4f unpack() const noexcept;
+    };
+
+    // Matches A2B10G10R10_UNORM_PACK32, x in the low bits
+    struct Unorm1010102
+    {
+        u32 bits;
+
+        constexpr Unorm1010102() noexcept;
+        constexpr explicit Unorm1010102(const u32 bits) noexcept;
+        explicit Unorm1010102(const Vector4f& value) noexcept;
+
+        HELIOS_NO_DISCARD Vector4f unpack() const noexcept;
+    };
+
+    // Matches A2B10G10R10_SNORM_PACK32, x in the low bits
+    struct Snorm1010102
+    {
+        u32 bits;
+
+        constexpr Snorm1010102() noexcept;
+        constexpr explicit Snorm1010102(const u32 bits) noexcept;
+        explicit Snorm1010102(const Vector4f& value) noexcept;
+
+        HELIOS_NO_DISCARD Vector4f unpack() const noexcept;
+    };
+
+    // Batch converters. These process eight elements per iteration using
+    // AVX2 (and F16C for half precision, when enabled) with a scalar tail.
+    void packHalf(const f32* src, u16* dst, const size_t count) noexcept;
+    void unpackHalf(const u16* src, f32* dst, const size_t count) noexcept;
+    void packHalf(const Vector2f* src, Half2* dst, const size_t count) noexcept;
+    void packSnorm16(const f32* src, i16* dst, const size_t count) noexcept;
+    void packSnorm8(const f32* src, i8* dst, const size_t count) noexcept;
+    void packUnorm8(const f32* src, u8* dst, const size_t count) noexcept;
+    void packUnorm8(const Vector4f* src, Unorm8x4* dst,
+                    const size_t count) noexcept;
+    void packSnorm1010102(const Vector4f* src, Snorm1010102* dst,
+                          const size_t count) noexcept;
+    void packUnorm1010102(const Vector4f* src, Unorm1010102* dst,
+                          const size_t count) noexcept;
+    void packOctahedral(const Vector3f* src, Snorm16x2* dst,
+                        const size_t count) noexcept;
+    void unpackSnorm16(const i16* src, f32* dst, const size_t count) noexcept;
+    void unpackSnorm8(const i8* src, f32* dst, const size_t count) noexcept;
+    void unpackUnorm16(const u16* src, f32* dst, const size_t count) noexcept;
+    void unpackUnorm8(const u8* src, f32* dst, const size_t count) noexcept;
+
+    // Zero extends 8 and 16 bit indices to 32 bits, sixteen per iteration.
+    void widenIndices(const u8* src, u32* dst, const size_t count) noexcept;
+    void widenIndices(const u16* src, u32* dst, const size_t count) noexcept;
+
+    constexpr Half2::Half2() noexcept : x(0), y(0)
+    {
+    }
+
+    constexpr Half2::Half2(const u16 x, const u16 y) noexcept : x(x), y(y)
+    {
+    }
+
+    constexpr Half4::Half4() noexcept : x(0), y(0), z(0), w(0)
+    {
+    }
+
+    constexpr Half4::Half4(const u16 x, const u16 y, const u16 z,
+                           const u16 w) noexcept
+        : x(x), y(y), z(z), w(w)
+    {
+    }
+
+    constexpr Snorm16x2::Snorm16x2() noexcept : x(0), y(0)
+    {
+    }
+
+    constexpr Snorm16x2::Snorm16x2(const i16 x, const i16 y) noexcept
+        : x(x), y(y)
+    {
+    }
+
+    constexpr Snorm16x4::Snorm16x4() noexcept : x(0), y(0), z(0), w(0)
+    {
+    }
+
+    constexpr Snorm16x4::Snorm16x4(const i16 x, const i16 y, const i16 z,
+                                   const i16 w) noexcept
+        : x(x), y(y), z(z), w(w)
+    {
+    }
+
+    constexpr Snorm8x4::Snorm8x4() noexcept : x(0), y(0), z(0), w(0)
+    {
+    }
+
+    constexpr Snorm8x4::Snorm8x4(const i8 x, const i8 y, const i8 z,
+                                 const i8 w) noexcept
+        : x(x), y(y), z(z), w(w)
+    {
+    }
+
+    constexpr Unorm8x4::Unorm8x4() noexcept : x(0), y(0), z(0), w(0)
+    {
+    }
+
+    constexpr Unorm8x4::Unorm8x4(const u8 x, const u8 y, const u8 z,
+                                 const u8 w) noexcept
+        : x(x), y(y), z(z), w(w)
+    {
+    }
+
+    constexpr Unorm1010102::Unorm1010102() noexcept : bits(0)
+    {
+    }
+
+    constexpr Unorm1010102::Unorm1010102(const u32 bits) noexcept : bits(bits)
+    {
+    }
+
+    constexpr Snorm1010102::Snorm1010102() noexcept : bits(0)
+    {
+    }
+
+    constexpr Snorm1010102::Snorm1010102(const u32 bits) noexcept : bits(bits)
+    {
+    }
+} // namespace helios
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <helios/macros.hpp>
+#include <helios/math/matrix.hpp>
+
+#include <cstddef>
+
+namespace helios
+{
+    // Transformations stored as one array per component, see
+    // composeTransforms.
+    struct TransformArrays
+    {
+        const f32* position[3];
+        // euler angles in degrees, applied like rotate(Vector3f)
+        const f32* rotation[3];
+        const f32* scale[3];
+    };
+
+    // Writes transform(position, rotation, scale) of the transformations in
+    // [first, first + count) to out[0, count). Runs of 8 go through one AVX2
+    // pass that computes the sines and cosines of all 8 at once and
+    // transposes the results into matrices, the rest falls back to
+    // transform.
+    void composeTransforms(const TransformArrays& transforms,
+                           const size_t first, const size_t count,
+                           Matrix4f* out) noexcept;
+} // namespace helios
@@ -12,6 +12,47 @@ namespace helios
     constexpr f32 radians(const f32 degrees);
     constexpr u32 sign(const f32 num);
 
+    // Evaluated with a polynomial approximation at compile time and the
+    // standard library at runtime.
+    constexpr f32 sin(const f32 radians);
+    constexpr f32 cos(const f32 radians);
+    constexpr f32 tan(const f32 radians);
+
+    namespace detail
+    {
+        // Reduces to [-pi/2, pi/2] before a Taylor series, accurate to well
+        // below f32 precision over that range.
+        constexpr f64 sinSeries(f64 x)
+        {
+            constexpr f64 dpi = 3.14159265358979323846;
+            constexpr f64 twoPi = 2.0 * dpi;
+
+            const f64 turns = x / twoPi;
+            const i64 whole =
+                static_cast<i64>(turns < 0.0 ? turns - 0.5 : turns + 0.5);
+            x -= static_cast<f64>(whole) * twoPi;
+
+            if (x > dpi / 2.0)
+            {
+                x = dpi - x;
+            }
+            else if (x < -dpi / 2.0)
+            {
+                x = -dpi - x;
+            }
+
+            const f64 x2 = x * x;
+            f64 term = x;
+            f64 sum = x;
+            for (i32 i = 1; i < 10; i++)
+            {
+                term *= -x2 / static_cast<f64>((2 * i) * (2 * i + 1));
+                sum += term;
+            }
+            return sum;
+        }
+    } // namespace detail
+
     // implementation
     inline constexpr f32 abs(const f32 num)
     {
@@ -41,6 +82,38 @@ namespace helios
         return num < 0.0f ? -1 : (num > 0.0f ? 1 : 0);
     }
 
+    inline constexpr f32 sin(const f32 radians)
+    {
+        if (HELIOS_IS_CONSTANT_EVALUATED())
+        {
+            return static_cast<f32>(detail::sinSeries(radians));
+        }
+        return __builtin_sinf(radians);
+    }
+
+    inline constexpr f32 cos(const f32 radians)
+    {
+        if (HELIOS_IS_CONSTANT_EVALUATED())
+        {
+            return static_cast<f32>(
+                detail::sinSeries(static_cast<f64>(radians) +
+                                  3.14159265358979323846 / 2.0));
+        }
+        return __builtin_cosf(radians);
+    }
+
+    inline constexpr f32 tan(const f32 radians)
+    {
+        if (HELIOS_IS_CONSTANT_EVALUATED())
+        {
+            return static_cast<f32>(
+                detail::sinSeries(radians) /
+                detail::sinSeries(static_cast<f64>(radians) +
+                                  3.14159265358979323846 / 2.0));
+        }
+        return __builtin_tanf(radians);
+    }
+
     inline constexpr f32 to_radians(const f32 degs)
     {
         return degs * pi / 180.0f;
@@ -0,0 +1,777 @@
+#pragma once
+
+#include <helios/containers/utility.hpp>
+#include <helios/macros.hpp>
+
+#include <cmath>
+#include <type_traits>
+
+#include <immintrin.h>
+
+// The f64 and i32 kernels of Vec are inline AVX2. Every project including
+// this header builds with vectorextensions "AVX2", a translation unit built
+// without it would compile a different body for the same inline function.
+#if !defined(__AVX2__)
+#error "helios/math/vec.hpp needs AVX2, add vectorextensions \"AVX2\" to the project"
+#endif
+
+namespace helios
+{
+    // Element type and dimension agnostic vector. The f32 vectors of size 2, 3
+    // and 4 are hand written specialisations living in vector.hpp. All other
+    // combinations use the generic implementation below, with arithmetic
+    // dispatched through detail::VecOps so common SIMD widths (f64x4, i32x4 and
+    // i32x8) can be accelerated without specialising the whole type.
+    template <typename T, size_t N>
+    struct Vec;
+
+    template <>
+    struct Vec<f32, 2>;
+    template <>
+    struct Vec<f32, 3>;
+    template <>
+    struct Vec<f32, 4>;
+
+    using Vector2f = Vec<f32, 2>;
+    using Vector3f = Vec<f32, 3>;
+    using Vector4f = Vec<f32, 4>;
+    using Vector2d = Vec<f64, 2>;
+    using Vector3d = Vec<f64, 3>;
+    using Vector4d = Vec<f64, 4>;
+    using Vector2i = Vec<i32, 2>;
+    using Vector3i = Vec<i32, 3>;
+    using Vector4i = Vec<i32, 4>;
+    using Vector8i = Vec<i32, 8>;
+
+    namespace detail
+    {
+        // Three component vectors are padded to four so they fit a single
+        // SIMD register. The padding element is kept at zero.
+        template <typename T, size_t N>
+        struct VecStorage
+        {
+            T data[N];
+
+            constexpr VecStorage() noexcept : data()
+            {
+            }
+        };
+
+        template <typename T>
+        struct VecStorage<T, 2>
+        {
+            union
+            {
+                struct
+                {
+                    T x;
+                    T y;
+                };
+                T data[2];
+            };
+
+            constexpr VecStorage() noexcept : data()
+            {
+            }
+        };
+
+        template <typename T>
+        struct VecStorage<T, 3>
+        {
+            union
+            {
+                struct
+                {
+                    T x;
+                    T y;
+                    T z;
+                };
+                T data[4];
+            };
+
+            constexpr VecStorage() noexcept : data()
+            {
+            }
+        };
+
+        template <typename T>
+        struct VecStorage<T, 4>
+        {
+            union
+            {
+                struct
+                {
+                    T x;
+                    T y;
+                    T z;
+                    T w;
+                };
+                T data[4];
+            };
+
+            constexpr VecStorage() noexcept : data()
+            {
+            }
+        };
+
+        template <typename T, size_t N>
+        constexpr size_t vecAlignment() noexcept
+        {
+            constexpr size_t bytes = sizeof(VecStorage<T, N>);
+            constexpr bool pow2 = (bytes & (bytes - 1)) == 0;
+            return pow2 && bytes <= 32 ? bytes : alignof(T);
+        }
+
+        template <typename T, size_t N>
+        struct VecOps
+        {
+            static void add(const T* lhs, const T* rhs, T* out) noexcept;
+            static void sub(const T* lhs, const T* rhs, T* out) noexcept;
+            static void mul(const T* lhs, const T* rhs, T* out) noexcept;
+            static void div(const T* lhs, const T* rhs, T* out) noexcept;
+            static T dot(const T* lhs, const T* rhs) noexcept;
+        };
+
+        // The 256 bit kernels use unaligned loads and stores. helios::vector
+        // and the heap only guarantee 16 byte alignment, so a 32 byte aligned
+        // Vec is not guaranteed once it lives in a container.
+        inline f64 horizontalAdd(const __m256d value) noexcept
+        {
+            const __m128d lo = _mm256_castpd256_pd128(value);
+            const __m128d hi = _mm256_extractf128_pd(value, 1);
+            const __m128d sum = _mm_add_pd(lo, hi);
+            return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+        }
+
+        template <>
+        struct VecOps<f64, 4>
+        {
+            static void add(const f64* lhs, const f64* rhs, f64* out) noexcept
+            {
+                _mm256_storeu_pd(out, _mm256_add_pd(_mm256_loadu_pd(lhs),
+                                                   _mm256_loadu_pd(rhs)));
+            }
+
+            static void sub(const f64* lhs, const f64* rhs, f64* out) noexcept
+            {
+                _mm256_storeu_pd(out, _mm256_sub_pd(_mm256_loadu_pd(lhs),
+                                                   _mm256_loadu_pd(rhs)));
+            }
+
+            static void mul(const f64* lhs, const f64* rhs, f64* out) noexcept
+            {
+                _mm256_storeu_pd(out, _mm256_mul_pd(_mm256_loadu_pd(lhs),
+                                                   _mm256_loadu_pd(rhs)));
+            }
+
+            static void div(const f64* lhs, const f64* rhs, f64* out) noexcept
+            {
+                _mm256_storeu_pd(out, _mm256_div_pd(_mm256_loadu_pd(lhs),
+                                                   _mm256_loadu_pd(rhs)));
+            }
+
+            static f64 dot(const f64* lhs, const f64* rhs) noexcept
+            {
+                return horizontalAdd(
+                    _mm256_mul_pd(_mm256_loadu_pd(lhs), _mm256_loadu_pd(rhs)));
+            }
+        };
+
+        template <>
+        struct VecOps<f64, 3>
+        {
+            static void add(const f64* lhs, const f64* rhs, f64* out) noexcept
+            {
+                VecOps<f64, 4>::add(lhs, rhs, out);
+            }
+
+            static void sub(const f64* lhs, const f64* rhs, f64* out) noexcept
+            {
+                VecOps<f64, 4>::sub(lhs, rhs, out);
+            }
+
+            static void mul(const f64* lhs, const f64* rhs, f64* out) noexcept
+            {
+                VecOps<f64, 4>::mul(lhs, rhs, out);
+            }
+
+            static void div(const f64* lhs, const f64* rhs, f64* out) noexcept
+            {
+                // the padding lane divides 0 by 0, clear it again
+                const __m256d res =
+                    _mm256_div_pd(_mm256_loadu_pd(lhs), _mm256_loadu_pd(rhs));
+                _mm256_storeu_pd(
+                    out, _mm256_blend_pd(res, _mm256_setzero_pd(), 0b1000));
+            }
+
+            static f64 dot(const f64* lhs, const f64* rhs) noexcept
+            {
+                return VecOps<f64, 4>::dot(lhs, rhs);
+            }
+        };
+
+        inline i32 horizontalAdd(const __m128i value) noexcept
+        {
+            const __m128i pairs = _mm_hadd_epi32(value, value);
+            return _mm_cvtsi128_si32(_mm_hadd_epi32(pairs, pairs));
+        }
+
+        template <>
+        struct VecOps<i32, 4>
+        {
+            static void add(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                const __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(lhs));
+                const __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(rhs));
+                _mm_store_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi32(a, b));
+            }
+
+            static void sub(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                const __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(lhs));
+                const __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(rhs));
+                _mm_store_si128(reinterpret_cast<__m128i*>(out), _mm_sub_epi32(a, b));
+            }
+
+            static void mul(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                const __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(lhs));
+                const __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(rhs));
+                _mm_store_si128(reinterpret_cast<__m128i*>(out),
+                                _mm_mullo_epi32(a, b));
+            }
+
+            static void div(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                // no integer division instructions, leave it to the compiler
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    out[i] = lhs[i] / rhs[i];
+                }
+            }
+
+            static i32 dot(const i32* lhs, const i32* rhs) noexcept
+            {
+                const __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(lhs));
+                const __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(rhs));
+                return horizontalAdd(_mm_mullo_epi32(a, b));
+            }
+        };
+
+        template <>
+        struct VecOps<i32, 3>
+        {
+            static void add(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                VecOps<i32, 4>::add(lhs, rhs, out);
+            }
+
+            static void sub(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                VecOps<i32, 4>::sub(lhs, rhs, out);
+            }
+
+            static void mul(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                VecOps<i32, 4>::mul(lhs, rhs, out);
+            }
+
+            static void div(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                // skip the zero padding lane
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    out[i] = lhs[i] / rhs[i];
+                }
+            }
+
+            static i32 dot(const i32* lhs, const i32* rhs) noexcept
+            {
+                return VecOps<i32, 4>::dot(lhs, rhs);
+            }
+        };
+
+        template <>
+        struct VecOps<i32, 8>
+        {
+            static void add(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                const __m256i a =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+                const __m256i b =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                                   _mm256_add_epi32(a, b));
+            }
+
+            static void sub(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                const __m256i a =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+                const __m256i b =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                                   _mm256_sub_epi32(a, b));
+            }
+
+            static void mul(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                const __m256i a =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+                const __m256i b =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                                   _mm256_mullo_epi32(a, b));
+            }
+
+            static void div(const i32* lhs, const i32* rhs, i32* out) noexcept
+            {
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    out[i] = lhs[i] / rhs[i];
+                }
+            }
+
+            static i32 dot(const i32* lhs, const i32* rhs) noexcept
+            {
+                const __m256i a =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+                const __m256i b =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+                const __m256i prod = _mm256_mullo_epi32(a, b);
+                return horizontalAdd(
+                    _mm_add_epi32(_mm256_castsi256_si128(prod),
+                                  _mm256_extracti128_si256(prod, 1)));
+            }
+        };
+    } // namespace detail
+
+    template <typename T, size_t N>
+    struct alignas(detail::vecAlignment<T, N>()) Vec : detail::VecStorage<T, N>
+    {
+        static_assert(N >= 2, "Vectors must have at least two components.");
+        static_assert(std::is_arithmetic_v<T>,
+                      "Vector elements must be arithmetic.");
+
+        using value_type = T;
+        static constexpr size_t dimensions = N;
+
+        constexpr Vec() noexcept;
+        constexpr explicit Vec(const T scalar) noexcept;
+        template <typename... Ts,
+                  typename = std::enable_if_t<sizeof...(Ts) == N>>
+        constexpr Vec(const Ts... values) noexcept;
+        template <typename U>
+        constexpr explicit Vec(const Vec<U, N>& other) noexcept;
+        constexpr Vec(const Vec& other) noexcept = default;
+        constexpr Vec(Vec&& other) noexcept = default;
+        ~Vec() = default;
+        constexpr Vec& operator=(const Vec& rhs) noexcept = default;
+        constexpr Vec& operator=(Vec&& rhs) noexcept = default;
+        constexpr T& operator[](const size_t index) noexcept;
+        constexpr const T& operator[](const size_t index) const noexcept;
+        constexpr bool operator==(const Vec& rhs) const noexcept;
+        constexpr bool operator!=(const Vec& rhs) const noexcept;
+        Vec& operator+=(const T rhs) noexcept;
+        Vec& operator+=(const Vec& rhs) noexcept;
+        Vec& operator-=(const T rhs) noexcept;
+        Vec& operator-=(const Vec& rhs) noexcept;
+        Vec& operator*=(const T rhs) noexcept;
+        Vec& operator*=(const Vec& rhs) noexcept;
+        Vec& operator/=(const T rhs) noexcept;
+        Vec& operator/=(const Vec& rhs) noexcept;
+        HELIOS_NO_DISCARD constexpr Vec abs() const noexcept;
+        HELIOS_NO_DISCARD Vec cross(const Vec& other) const noexcept;
+        HELIOS_NO_DISCARD T dot(const Vec& other) const noexcept;
+        HELIOS_NO_DISCARD T length() const noexcept;
+        HELIOS_NO_DISCARD T norm1() const noexcept;
+
+        template <typename U>
+        HELIOS_NO_DISCARD constexpr Vec<U, N> as() const noexcept;
+    };
+
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator+(Vec<T, N> lhs, const Vec<T, N>& rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator+(Vec<T, N> lhs,
+                                          const typename Vec<T, N>::value_type rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator+(const typename Vec<T, N>::value_type lhs,
+                                          const Vec<T, N>& rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator-(Vec<T, N> lhs, const Vec<T, N>& rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator-(Vec<T, N> lhs,
+                                          const typename Vec<T, N>::value_type rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator-(const typename Vec<T, N>::value_type lhs,
+                                          const Vec<T, N>& rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator*(Vec<T, N> lhs, const Vec<T, N>& rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator*(Vec<T, N> lhs,
+                                          const typename Vec<T, N>::value_type rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator*(const typename Vec<T, N>::value_type lhs,
+                                          const Vec<T, N>& rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator/(Vec<T, N> lhs, const Vec<T, N>& rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator/(Vec<T, N> lhs,
+                                          const typename Vec<T, N>::value_type rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> operator/(const typename Vec<T, N>::value_type lhs,
+                                          const Vec<T, N>& rhs);
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD constexpr Vec<T, N> abs(const Vec<T, N>& vec) noexcept;
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD Vec<T, N> cross(const Vec<T, N>& lhs,
+                                      const Vec<T, N>& rhs) noexcept;
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD T dot(const Vec<T, N>& lhs, const Vec<T, N>& rhs) noexcept;
+    template <typename T, size_t N>
+    HELIOS_NO_DISCARD T length(const Vec<T, N>& vec) noexcept;
+
+    // Converts double precision world positions into single precision
+    // positions relative to origin, typically the camera. Subtracting in
+    // double precision before narrowing keeps precision where it matters,
+    // close to the viewer, regardless of how far the scene extends.
+    void toCameraRelative(const Vector3d* positions, const Vector3d& origin,
+                          Vector3f* out, const size_t count) noexcept;
+
+    namespace detail
+    {
+        template <typename T, size_t N>
+        inline void VecOps<T, N>::add(const T* lhs, const T* rhs,
+                                      T* out) noexcept
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                out[i] = lhs[i] + rhs[i];
+            }
+        }
+
+        template <typename T, size_t N>
+        inline void VecOps<T, N>::sub(const T* lhs, const T* rhs,
+                                      T* out) noexcept
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                out[i] = lhs[i] - rhs[i];
+            }
+        }
+
+        template <typename T, size_t N>
+        inline void VecOps<T, N>::mul(const T* lhs, const T* rhs,
+                                      T* out) noexcept
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                out[i] = lhs[i] * rhs[i];
+            }
+        }
+
+        template <typename T, size_t N>
+        inline void VecOps<T, N>::div(const T* lhs, const T* rhs,
+                                      T* out) noexcept
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                out[i] = lhs[i] / rhs[i];
+            }
+        }
+
+        template <typename T, size_t N>
+        inline T VecOps<T, N>::dot(const T* lhs, const T* rhs) noexcept
+        {
+            T res = T(0);
+            for (size_t i = 0; i < N; ++i)
+            {
+                res += lhs[i] * rhs[i];
+            }
+            return res;
+        }
+    } // namespace detail
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N>::Vec() noexcept : detail::VecStorage<T, N>()
+    {
+    }
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N>::Vec(const T scalar) noexcept
+        : detail::VecStorage<T, N>()
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            this->data[i] = scalar;
+        }
+    }
+
+    template <typename T, size_t N>
+    template <typename... Ts, typename>
+    constexpr Vec<T, N>::Vec(const Ts... values) noexcept
+        : detail::VecStorage<T, N>()
+    {
+        const T elements[] = {static_cast<T>(values)...};
+        for (size_t i = 0; i < N; ++i)
+        {
+            this->data[i] = elements[i];
+        }
+    }
+
+    template <typename T, size_t N>
+    template <typename U>
+    constexpr Vec<T, N>::Vec(const Vec<U, N>& other) noexcept
+        : detail::VecStorage<T, N>()
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            this->data[i] = static_cast<T>(other.data[i]);
+        }
+    }
+
+    template <typename T, size_t N>
+    constexpr T& Vec<T, N>::operator[](const size_t index) noexcept
+    {
+        return this->data[index];
+    }
+
+    template <typename T, size_t N>
+    constexpr const T& Vec<T, N>::operator[](const size_t index) const noexcept
+    {
+        return this->data[index];
+    }
+
+    template <typename T, size_t N>
+    constexpr bool Vec<T, N>::operator==(const Vec& rhs) const noexcept
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            if (this->data[i] != rhs.data[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T, size_t N>
+    constexpr bool Vec<T, N>::operator!=(const Vec& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N>& Vec<T, N>::operator+=(const T rhs) noexcept
+    {
+        return *this += Vec(rhs);
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N>& Vec<T, N>::operator+=(const Vec& rhs) noexcept
+    {
+        detail::VecOps<T, N>::add(this->data, rhs.data, this->data);
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N>& Vec<T, N>::operator-=(const T rhs) noexcept
+    {
+        return *this -= Vec(rhs);
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N>& Vec<T, N>::operator-=(const Vec& rhs) noexcept
+    {
+        detail::VecOps<T, N>::sub(this->data, rhs.data, this->data);
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N>& Vec<T, N>::operator*=(const T rhs) noexcept
+    {
+        return *this *= Vec(rhs);
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N>& Vec<T, N>::operator*=(const Vec& rhs) noexcept
+    {
+        detail::VecOps<T, N>::mul(this->data, rhs.data, this->data);
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N>& Vec<T, N>::operator/=(const T rhs) noexcept
+    {
+        return *this /= Vec(rhs);
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N>& Vec<T, N>::operator/=(const Vec& rhs) noexcept
+    {
+        detail::VecOps<T, N>::div(this->data, rhs.data, this->data);
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N> Vec<T, N>::abs() const noexcept
+    {
+        Vec res;
+        for (size_t i = 0; i < N; ++i)
+        {
+            res.data[i] = this->data[i] < T(0) ? -this->data[i] : this->data[i];
+        }
+        return res;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> Vec<T, N>::cross(const Vec& other) const noexcept
+    {
+        static_assert(N == 3, "Cross product is only defined in 3 dimensions.");
+        return Vec(this->y * other.z - this->z * other.y,
+                   this->z * other.x - this->x * other.z,
+                   this->x * other.y - this->y * other.x);
+    }
+
+    template <typename T, size_t N>
+    inline T Vec<T, N>::dot(const Vec& other) const noexcept
+    {
+        return detail::VecOps<T, N>::dot(this->data, other.data);
+    }
+
+    template <typename T, size_t N>
+    inline T Vec<T, N>::length() const noexcept
+    {
+        static_assert(std::is_floating_point_v<T>,
+                      "Length requires a floating point vector.");
+        return std::sqrt(dot(*this));
+    }
+
+    template <typename T, size_t N>
+    inline T Vec<T, N>::norm1() const noexcept
+    {
+        T res = T(0);
+        for (size_t i = 0; i < N; ++i)
+        {
+            res += this->data[i] < T(0) ? -this->data[i] : this->data[i];
+        }
+        return res;
+    }
+
+    template <typename T, size_t N>
+    template <typename U>
+    constexpr Vec<U, N> Vec<T, N>::as() const noexcept
+    {
+        Vec<U, N> res;
+        for (size_t i = 0; i < N; ++i)
+        {
+            res.data[i] = static_cast<U>(this->data[i]);
+        }
+        return res;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator+(Vec<T, N> lhs, const Vec<T, N>& rhs)
+    {
+        return lhs += rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator+(Vec<T, N> lhs,
+                               const typename Vec<T, N>::value_type rhs)
+    {
+        return lhs += rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator+(const typename Vec<T, N>::value_type lhs,
+                               const Vec<T, N>& rhs)
+    {
+        return Vec<T, N>(lhs) += rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator-(Vec<T, N> lhs, const Vec<T, N>& rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator-(Vec<T, N> lhs,
+                               const typename Vec<T, N>::value_type rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator-(const typename Vec<T, N>::value_type lhs,
+                               const Vec<T, N>& rhs)
+    {
+        return Vec<T, N>(lhs) -= rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator*(Vec<T, N> lhs, const Vec<T, N>& rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator*(Vec<T, N> lhs,
+                               const typename Vec<T, N>::value_type rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator*(const typename Vec<T, N>::value_type lhs,
+                               const Vec<T, N>& rhs)
+    {
+        return Vec<T, N>(lhs) *= rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator/(Vec<T, N> lhs, const Vec<T, N>& rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator/(Vec<T, N> lhs,
+                               const typename Vec<T, N>::value_type rhs)
+    {
+        return lhs /= rhs;
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> operator/(const typename Vec<T, N>::value_type lhs,
+                               const Vec<T, N>& rhs)
+    {
+        return Vec<T, N>(lhs) /= rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr Vec<T, N> abs(const Vec<T, N>& vec) noexcept
+    {
+        return vec.abs();
+    }
+
+    template <typename T, size_t N>
+    inline Vec<T, N> cross(const Vec<T, N>& lhs, const Vec<T, N>& rhs) noexcept
+    {
+        return lhs.cross(rhs);
+    }
+
+    template <typename T, size_t N>
+    inline T dot(const Vec<T, N>& lhs, const Vec<T, N>& rhs) noexcept
+    {
+        return lhs.dot(rhs);
+    }
+
+    template <typename T, size_t N>
+    inline T length(const Vec<T, N>& vec) noexcept
+    {
+        return vec.length();
+    }
+} // namespace helios
@@ -3,6 +3,7 @@
 #include <helios/containers/utility.hpp>
 #include <helios/macros.hpp>
 #include <helios/math/utils.hpp>
+#include <helios/math/vec.hpp>
 
 #include <cmath>
 
@@ -12,7 +13,8 @@ namespace helios
     struct Vector3fView;
     struct Vector4fView;
 
-    struct alignas(16) Vector2f
+    template <>
+    struct alignas(16) Vec<f32, 2>
     {
         union
         {
@@ -39,14 +41,14 @@ namespace helios
             f32 data[4]; // for intrinsics, we need 4 floats
         };
 
-        constexpr Vector2f() noexcept;
-        constexpr explicit Vector2f(const f32 scalar) noexcept;
-        constexpr Vector2f(const f32 x, const f32 y) noexcept;
-        constexpr Vector2f(const Vector2f& other) noexcept;
-        constexpr Vector2f(Vector2f&& other) noexcept;
-        constexpr Vector2f(const Vector2fView& view) noexcept;
-        constexpr Vector2f(Vector2fView&& view) noexcept;
-        ~Vector2f() = default;
+        constexpr Vec() noexcept;
+        constexpr explicit Vec(const f32 scalar) noexcept;
+        constexpr Vec(const f32 x, const f32 y) noexcept;
+        constexpr Vec(const Vector2f& other) noexcept;
+        constexpr Vec(Vector2f&& other) noexcept;
+        constexpr Vec(const Vector2fView& view) noexcept;
+        constexpr Vec(Vector2fView&& view) noexcept;
+        ~Vec() = default;
         constexpr Vector2f& operator=(const f32 rhs) noexcept;
         constexpr Vector2f& operator=(const Vector2f& rhs) noexcept;
         constexpr Vector2f& operator=(Vector2f&& rhs) noexcept;
@@ -140,7 +142,8 @@ namespace helios
     HELIOS_NO_DISCARD Vector2f reflect(const Vector2f vec,
                                        const Vector2f& line) noexcept;
 
-    struct alignas(16) Vector3f
+    template <>
+    struct alignas(16) Vec<f32, 3>
     {
         union
         {
@@ -171,16 +174,16 @@ namespace helios
             f32 data[4];
         };
 
-        constexpr Vector3f() noexcept;
-        constexpr explicit Vector3f(const f32 scalar) noexcept;
-        constexpr Vector3f(const f32 x, const f32 y, const f32 z) noexcept;
-        constexpr Vector3f(const Vector2f& xy, const f32 z = 0.0f);
-        constexpr Vector3f(const Vector3f& other) noexcept;
-        constexpr Vector3f(Vector2f&& xy, const f32 z = 0.0f);
-        constexpr Vector3f(Vector3f&& other) noexcept;
-        constexpr Vector3f(const Vector3fView& other) noexcept;
-        constexpr Vector3f(Vector3fView&& other) noexcept;
-        ~Vector3f() = default;
+        constexpr Vec() noexcept;
+        constexpr explicit Vec(const f32 scalar) noexcept;
+        constexpr Vec(const f32 x, const f32 y, const f32 z) noexcept;
+        constexpr Vec(const Vector2f& xy, const f32 z = 0.0f);
+        constexpr Vec(const Vector3f& other) noexcept;
+        constexpr Vec(Vector2f&& xy, const f32 z = 0.0f);
+        constexpr Vec(Vector3f&& other) noexcept;
+        constexpr Vec(const Vector3fView& other) noexcept;
+        constexpr Vec(Vector3fView&& other) noexcept;
+        ~Vec() = default;
         constexpr Vector3f& operator=(const f32 rhs) noexcept;
         constexpr Vector3f& operator=(const Vector2f& rhs) noexcept;
         constexpr Vector3f& operator=(const Vector3f& rhs) noexcept;
@@ -282,7 +285,8 @@ namespace helios
     HELIOS_NO_DISCARD Vector3f reflect(const Vector3f vec,
                                        const Vector3f& line) noexcept;
 
-    struct alignas(16) Vector4f
+    template <>
+    struct alignas(16) Vec<f32, 4>
     {
         union
         {
@@ -310,23 +314,23 @@ namespace helios
             f32 data[4];
         };
 
-        constexpr Vector4f() noexcept;
-        constexpr explicit Vector4f(const f32 scalar) noexcept;
-        constexpr Vector4f(const f32 x, const f32 y, const f32 z,
-                           const f32 w) noexcept;
-        constexpr Vector4f(const Vector2f& xy, const f32 z = 0.0f,
-                           const f32 w = 0.0f);
-        constexpr Vector4f(const Vector2f& xy, const Vector2f& zw);
-        constexpr Vector4f(const Vector3f& xyz, const f32 w = 0.0f);
-        constexpr Vector4f(const Vector4f& other) noexcept;
-        constexpr Vector4f(const Vector4fView& other) noexcept;
-        constexpr Vector4f(Vector2f&& xy, Vector2f&& zw);
-        constexpr Vector4f(Vector2f&& xy, const f32 z = 0.0f,
-                           const f32 w = 0.0f);
-        constexpr Vector4f(Vector3f&& xyz, const f32 w = 0.0f);
-        constexpr Vector4f(Vector4f&& other) noexcept;
-        constexpr Vector4f(Vector4fView&& other) noexcept;
-        ~Vector4f() = default;
+        constexpr Vec() noexcept;
+        constexpr explicit Vec(const f32 scalar) noexcept;
+        constexpr Vec(const f32 x, const f32 y, const f32 z,
+                      const f32 w) noexcept;
+        constexpr Vec(const Vector2f& xy, const f32 z = 0.0f,
+                      const f32 w = 0.0f);
+        constexpr Vec(const Vector2f& xy, const Vector2f& zw);
+        constexpr Vec(const Vector3f& xyz, const f32 w = 0.0f);
+        constexpr Vec(const Vector4f& other) noexcept;
+        constexpr Vec(const Vector4fView& other) noexcept;
+        constexpr Vec(Vector2f&& xy, Vector2f&& zw);
+        constexpr Vec(Vector2f&& xy, const f32 z = 0.0f,
+                      const f32 w = 0.0f);
+        constexpr Vec(Vector3f&& xyz, const f32 w = 0.0f);
+        constexpr Vec(Vector4f&& other) noexcept;
+        constexpr Vec(Vector4fView&& other) noexcept;
+        ~Vec() = default;
         constexpr Vector4f& operator=(const f32 rhs) noexcept;
         constexpr Vector4f& operator=(const Vector2f& rhs) noexcept;
         constexpr Vector4f& operator=(const Vector3f& rhs) noexcept;
@@ -430,36 +434,36 @@ namespace helios
     HELIOS_NO_DISCARD Vector4f reflect(const Vector4f vec,
                                        const Vector4f& line) noexcept;
 
-    constexpr Vector2f::Vector2f() noexcept : Vector2f(0.0f){};
+    constexpr Vector2f::Vec() noexcept : Vector2f(0.0f){};
 
-    constexpr Vector2f::Vector2f(const f32 scalar) noexcept
+    constexpr Vector2f::Vec(const f32 scalar) noexcept
         : Vector2f(scalar, scalar)
     {
     }
 
-    constexpr Vector2f::Vector2f(const f32 x, const f32 y) noexcept : data()
+    constexpr Vector2f::Vec(const f32 x, const f32 y) noexcept : data()
     {
         data[0] = x;
         data[1] = y;
     }
 
-    constexpr Vector2f::Vector2f(const Vector2f& other) noexcept
-        : Vector2f(other.x, other.y)
+    constexpr Vector2f::Vec(const Vector2f& other) noexcept
+        : Vector2f(other.data[0], other.data[1])
     {
     }
 
-    constexpr Vector2f::Vector2f(Vector2f&& other) noexcept
-        : Vector2f(helios::move(other.x), helios::move(other.y))
+    constexpr Vector2f::Vec(Vector2f&& other) noexcept
+        : Vector2f(helios::move(other.data[0]), helios::move(other.data[1]))
     {
     }
 
-    constexpr Vector2f::Vector2f(const Vector2fView& view) noexcept : data()
+    constexpr Vector2f::Vec(const Vector2fView& view) noexcept : data()
     {
         data[0] = view.data[0];
         data[1] = view.data[1];
     }
 
-    constexpr Vector2f::Vector2f(Vector2fView&& view) noexcept : data()
+    constexpr Vector2f::Vec(Vector2fView&& view) noexcept : data()
     {
         data[0] = helios::move(view.data[0]);
         data[1] = helios::move(view.data[1]);
@@ -601,16 +605,16 @@ namespace helios
         return *this;
     }
 
-    constexpr Vector3f::Vector3f() noexcept : Vector3f(0.0f)
+    constexpr Vector3f::Vec() noexcept : Vector3f(0.0f)
     {
     }
 
-    constexpr Vector3f::Vector3f(const f32 scalar) noexcept
+    constexpr Vector3f::Vec(const f32 scalar) noexcept
         : Vector3f(scalar, scalar, scalar)
     {
     }
 
-    constexpr Vector3f::Vector3f(const f32 x, const f32 y, const f32 z) noexcept
+    constexpr Vector3f::Vec(const f32 x, const f32 y, const f32 z) noexcept
         : data()
     {
         data[0] = x;
@@ -618,33 +622,33 @@ namespace helios
         data[2] = z;
     }
 
-    constexpr Vector3f::Vector3f(const Vector2f& xy, const f32 z)
+    constexpr Vector3f::Vec(const Vector2f& xy, const f32 z)
         : Vector3f(xy.data[0], xy.data[1], z)
     {
     }
 
-    constexpr Vector3f::Vector3f(const Vector3f& other) noexcept
+    constexpr Vector3f::Vec(const Vector3f& other) noexcept
         : Vector3f(other.data[0], other.data[1], other.data[2])
     {
     }
 
-    constexpr Vector3f::Vector3f(Vector2f&& xy, const f32 z)
+    constexpr Vector3f::Vec(Vector2f&& xy, const f32 z)
         : Vector3f(helios::move(xy.data[0]), helios::move(xy.data[1]), z)
     {
     }
 
-    constexpr Vector3f::Vector3f(Vector3f&& other) noexcept
+    constexpr Vector3f::Vec(Vector3f&& other) noexcept
         : Vector3f(helios::move(other.data[0]), helios::move(other.data[1]),
                    helios::move(other.data[2]))
     {
     }
 
-    constexpr Vector3f::Vector3f(const Vector3fView& other) noexcept
+    constexpr Vector3f::Vec(const Vector3fView& other) noexcept
         : Vector3f(other.data[0], other.data[1], other.data[2])
     {
     }
 
-    constexpr Vector3f::Vector3f(Vector3fView&& other) noexcept
+    constexpr Vector3f::Vec(Vector3fView&& other) noexcept
         : Vector3f(helios::move(other.data[0]), helios::move(other.data[1]),
                    helios::move(other.data[2]))
     {
@@ -817,17 +821,17 @@ namespace helios
         return *this;
     }
 
-    constexpr Vector4f::Vector4f() noexcept : Vector4f(0.0f)
+    constexpr Vector4f::Vec() noexcept : Vector4f(0.0f)
     {
     }
 
-    constexpr Vector4f::Vector4f(const f32 scalar) noexcept
+    constexpr Vector4f::Vec(const f32 scalar) noexcept
         : Vector4f(scalar, scalar, scalar, scalar)
     {
     }
 
-    constexpr Vector4f::Vector4f(const f32 x, const f32 y, const f32 z,
-                                 const f32 w) noexcept
+    constexpr Vector4f::Vec(const f32 x, const f32 y, const f32 z,
+                            const f32 w) noexcept
         : data()
     {
         data[0] = x;
@@ -836,57 +840,57 @@ namespace helios
         data[3] = w;
     }
 
-    constexpr Vector4f::Vector4f(const Vector2f& xy, const f32 z, const f32 w)
-        : Vector4f(xy.x, xy.y, z, w)
+    constexpr Vector4f::Vec(const Vector2f& xy, const f32 z, const f32 w)
+        : Vector4f(xy.data[0], xy.data[1], z, w)
     {
     }
 
-    constexpr Vector4f::Vector4f(const Vector2f& xy, const Vector2f& zw)
-        : Vector4f(xy.x, xy.y, zw.x, zw.y)
+    constexpr Vector4f::Vec(const Vector2f& xy, const Vector2f& zw)
+        : Vector4f(xy.data[0], xy.data[1], zw.data[0], zw.data[1])
     {
     }
 
-    constexpr Vector4f::Vector4f(const Vector3f& xyz, const f32 w)
-        : Vector4f(xyz.x, xyz.y, xyz.z, w)
+    constexpr Vector4f::Vec(const Vector3f& xyz, const f32 w)
+        : Vector4f(xyz.data[0], xyz.data[1], xyz.data[2], w)
     {
     }
 
-    constexpr Vector4f::Vector4f(const Vector4f& other) noexcept
-        : Vector4f(other.x, other.y, other.z, other.w)
+    constexpr Vector4f::Vec(const Vector4f& other) noexcept
+        : Vector4f(other.data[0], other.data[1], other.data[2], other.data[3])
     {
     }
 
-    constexpr Vector4f::Vector4f(const Vector4fView& other) noexcept
-        : Vector4f(other.x, other.y, other.z, other.w)
+    constexpr Vector4f::Vec(const Vector4fView& other) noexcept
+        : Vector4f(other.data[0], other.data[1], other.data[2], other.data[3])
     {
     }
 
-    constexpr Vector4f::Vector4f(Vector2f&& xy, Vector2f&& zw)
-        : Vector4f(helios::move(xy.x), helios::move(xy.y), helios::move(zw.x),
-                   helios::move(zw.y))
+    constexpr Vector4f::Vec(Vector2f&& xy, Vector2f&& zw)
+        : Vector4f(helios::move(xy.data[0]), helios::move(xy.data[1]),
+                   helios::move(zw.data[0]), helios::move(zw.data[1]))
     {
     }
 
-    constexpr Vector4f::Vector4f(Vector2f&& xy, const f32 z, const f32 w)
-        : Vector4f(helios::move(xy.x), helios::move(xy.y), z, w)
+    constexpr Vector4f::Vec(Vector2f&& xy, const f32 z, const f32 w)
+        : Vector4f(helios::move(xy.data[0]), helios::move(xy.data[1]), z, w)
     {
     }
 
-    constexpr Vector4f::Vector4f(Vector3f&& xyz, const f32 w)
-        : Vector4f(helios::move(xyz.x), helios::move(xyz.y),
-                   helios::move(xyz.z), w)
+    constexpr Vector4f::Vec(Vector3f&& xyz, const f32 w)
+        : Vector4f(helios::move(xyz.data[0]), helios::move(xyz.data[1]),
+                   helios::move(xyz.data[2]), w)
     {
     }
 
-    constexpr Vector4f::Vector4f(Vector4f&& other) noexcept
-        : Vector4f(helios::move(other.x), helios::move(other.y),
-                   helios::move(other.z), helios::move(other.w))
+    constexpr Vector4f::Vec(Vector4f&& other) noexcept
+        : Vector4f(helios::move(other.data[0]), helios::move(other.data[1]),
+                   helios::move(other.data[2]), helios::move(other.data[3]))
     {
     }
 
-    constexpr Vector4f::Vector4f(Vector4fView&& other) noexcept
-        : Vector4f(helios::move(other.x), helios::move(other.y),
-                   helios::move(other.z), helios::move(other.w))
+    constexpr Vector4f::Vec(Vector4fView&& other) noexcept
+        : Vector4f(helios::move(other.data[0]), helios::move(other.data[1]),
+                   helios::move(other.data[2]), helios::move(other.data[3]))
     {
     }
 
@@ -51,7 +51,8 @@ project "math"
         buildoptions {
             "-Wall",
             "-Wextra",
-            "-Werror"
+            "-Werror",
+            "-mf16c"
         }
 
         linkoptions {
@@ -0,0 +1,663 @@
+#include <helios/math/block_compression.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace helios
+{
+    static constexpr u32 block_pixels = 16;
+
+    // interpolation weights of BC7 4 bit indices, in 64ths
+    static constexpr u32 bc7_weights[16] = {0,  4,  9,  13, 17, 21, 26, 30,
+                                            34, 38, 43, 47, 51, 55, 60, 64};
+
+    static f32 clampByte(const f32 value) noexcept
+    {
+        return value < 0.0f ? 0.0f : (value > 255.0f ? 255.0f : value);
+    }
+
+    // rounds the non negative values the encoders produce, without the
+    // library call of lround
+    static u32 roundToInt(const f32 value) noexcept
+    {
+        return static_cast<u32>(value + 0.5f);
+    }
+
+    // Writes and reads little endian bit fields of a 64 or 128 bit block.
+    class BlockBits
+    {
+    public:
+        void write(const u32 value, const u32 count) noexcept
+        {
+            const u32 word = _position / 64;
+            const u32 shift = _position % 64;
+            _bits[word] |= static_cast<u64>(value) << shift;
+            if (shift + count > 64)
+            {
+                _bits[word + 1] |= static_cast<u64>(value) >> (64 - shift);
+            }
+            _position += count;
+        }
+
+        u32 read(const u32 count) noexcept
+        {
+            const u32 word = _position / 64;
+            const u32 shift = _position % 64;
+            u64 value = _bits[word] >> shift;
+            if (shift + count > 64)
+            {
+                value |= _bits[word + 1] << (64 - shift);
+            }
+            _position += count;
+            return static_cast<u32>(value & ((u64(1) << count) - 1));
+        }
+
+        void load(const u8* block, const size_t size) noexcept
+        {
+            memcpy(_bits, block, size);
+        }
+
+        void store(u8* block, const size_t size) const noexcept
+        {
+            memcpy(block, _bits, size);
+        }
+
+    private:
+        u64 _bits[2] = {0, 0};
+        u32 _position = 0;
+    };
+
+    // Picks the closest palette entry for every pixel over the first
+    // `channels` channels, eight pixels per AVX2 register, and returns the
+    // summed squared error.
+    static u32 selectIndices(const u8* pixels, const u8 (*palette)[4],
+                             const u32 paletteSize, const u32 channels,
+                             u8* indices) noexcept
+    {
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        u32 total = 0;
+        for (u32 half = 0; half < 2; half++)
+        {
+            const __m256i raw = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(pixels + half * 32));
+            __m256i channel[4];
+            for (u32 c = 0; c < 4; c++)
+            {
+                channel[c] =
+                    _mm256_and_si256(_mm256_srli_epi32(raw, c * 8), byteMask);
+            }
+
+            __m256i best = _mm256_set1_epi32(0x7FFFFFFF);
+            __m256i bestIndex = _mm256_setzero_si256();
+            for (u32 p = 0; p < paletteSize; p++)
+            {
+                __m256i error = _mm256_setzero_si256();
+                for (u32 c = 0; c < channels; c++)
+                {
+                    const __m256i diff = _mm256_sub_epi32(
+                        channel[c], _mm256_set1_epi32(palette[p][c]));
+                    error = _mm256_add_epi32(error,
+                                             _mm256_mullo_epi32(diff, diff));
+                }
+                const __m256i closer = _mm256_cmpgt_epi32(best, error);
+                best = _mm256_min_epi32(best, error);
+                bestIndex = _mm256_blendv_epi8(
+                    bestIndex, _mm256_set1_epi32(static_cast<i32>(p)), closer);
+            }
+
+            alignas(32) u32 lanes[8];
+            alignas(32) u32 errors[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), bestIndex);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(errors), best);
+            for (u32 i = 0; i < 8; i++)
+            {
+                indices[half * 8 + i] = static_cast<u8>(lanes[i]);
+                total += errors[i];
+            }
+        }
+        return total;
+    }
+
+    // End points of the segment the pixels spread along: the principal
+    // axis from a few power iterations of the covariance, cut at the
+    // extreme projections.
+    template <u32 Channels>
+    static void principalEndpoints(const u8* pixels, f32 (&low)[4],
+                                   f32 (&high)[4]) noexcept
+    {
+        f32 mean[Channels] = {};
+        f32 minimum[Channels];
+        f32 maximum[Channels];
+        for (u32 c = 0; c < Channels; c++)
+        {
+            minimum[c] = 255.0f;
+            maximum[c] = 0.0f;
+        }
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            for (u32 c = 0; c < Channels; c++)
+            {
+                const f32 value = pixels[i * 4 + c];
+                mean[c] += value;
+                minimum[c] = value < minimum[c] ? value : minimum[c];
+                maximum[c] = value > maximum[c] ? value : maximum[c];
+            }
+        }
+        for (u32 c = 0; c < Channels; c++)
+        {
+            mean[c] /= static_cast<f32>(block_pixels);
+        }
+
+        f32 covariance[Channels][Channels] = {};
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            f32 offset[Channels];
+            for (u32 c = 0; c < Channels; c++)
+            {
+                offset[c] = pixels[i * 4 + c] - mean[c];
+            }
+            for (u32 a = 0; a < Channels; a++)
+            {
+                for (u32 b = 0; b < Channels; b++)
+                {
+                    covariance[a][b] += offset[a] * offset[b];
+                }
+            }
+        }
+
+        f32 axis[Channels];
+        for (u32 c = 0; c < Channels; c++)
+        {
+            axis[c] = maximum[c] - minimum[c];
+        }
+        for (u32 iteration = 0; iteration < 6; iteration++)
+        {
+            f32 next[Channels] = {};
+            f32 largest = 0.0f;
+            for (u32 a = 0; a < Channels; a++)
+            {
+                for (u32 b = 0; b < Channels; b++)
+                {
+                    next[a] += covariance[a][b] * axis[b];
+                }
+                largest = std::fabs(next[a]) > largest ? std::fabs(next[a])
+                                                       : largest;
+            }
+            if (largest <= 0.0f)
+            {
+                break;
+            }
+            for (u32 c = 0; c < Channels; c++)
+            {
+                axis[c] = next[c] / largest;
+            }
+        }
+
+        f32 lengthSquared = 0.0f;
+        for (u32 c = 0; c < Channels; c++)
+        {
+            lengthSquared += axis[c] * axis[c];
+        }
+        if (lengthSquared <= 0.0f)
+        {
+            for (u32 c = 0; c < Channels; c++)
+            {
+                low[c] = mean[c];
+                high[c] = mean[c];
+            }
+            return;
+        }
+
+        f32 lowest = 0.0f;
+        f32 highest = 0.0f;
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            f32 t = 0.0f;
+            for (u32 c = 0; c < Channels; c++)
+            {
+                t += (pixels[i * 4 + c] - mean[c]) * axis[c];
+            }
+            lowest = t < lowest ? t : lowest;
+            highest = t > highest ? t : highest;
+        }
+        for (u32 c = 0; c < Channels; c++)
+        {
+            low[c] = clampByte(mean[c] + axis[c] * lowest / lengthSquared);
+            high[c] = clampByte(mean[c] + axis[c] * highest / lengthSquared);
+        }
+    }
+
+    // Least squares end points for the chosen indices, where weights[i] is
+    // how far index i lies from low to high. Returns false when every
+    // pixel uses the same weight and the system has no single solution.
+    template <u32 Channels>
+    static bool refineEndpoints(const u8* pixels, const u8* indices,
+                                const f32* weights, f32 (&low)[4],
+                                f32 (&high)[4]) noexcept
+    {
+        f32 aa = 0.0f;
+        f32 ab = 0.0f;
+        f32 bb = 0.0f;
+        f32 ax[Channels] = {};
+        f32 bx[Channels] = {};
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            const f32 b = weights[indices[i]];
+            const f32 a = 1.0f - b;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (u32 c = 0; c < Channels; c++)
+            {
+                ax[c] += a * pixels[i * 4 + c];
+                bx[c] += b * pixels[i * 4 + c];
+            }
+        }
+
+        const f32 determinant = aa * bb - ab * ab;
+        if (std::fabs(determinant) < 1e-6f)
+        {
+            return false;
+        }
+        const f32 inverse = 1.0f / determinant;
+        for (u32 c = 0; c < Channels; c++)
+        {
+            low[c] = clampByte((bb * ax[c] - ab * bx[c]) * inverse);
+            high[c] = clampByte((aa * bx[c] - ab * ax[c]) * inverse);
+        }
+        return true;
+    }
+
+    static u16 packRgb565(const f32 (&color)[4]) noexcept
+    {
+        const u32 r = roundToInt(color[0] * 31.0f / 255.0f);
+        const u32 g = roundToInt(color[1] * 63.0f / 255.0f);
+        const u32 b = roundToInt(color[2] * 31.0f / 255.0f);
+        return static_cast<u16>((r << 11) | (g << 5) | b);
+    }
+
+    static void unpackRgb565(const u16 color, u8* rgb) noexcept
+    {
+        const u32 r = (color >> 11) & 31;
+        const u32 g = (color >> 5) & 63;
+        const u32 b = color & 31;
+        rgb[0] = static_cast<u8>((r << 3) | (r >> 2));
+        rgb[1] = static_cast<u8>((g << 2) | (g >> 4));
+        rgb[2] = static_cast<u8>((b << 3) | (b >> 2));
+    }
+
+    // palette order of the four colour mode: the end points, then a third
+    // and two thirds of the way
+    static void bc1Palette(const u16 color0, const u16 color1,
+                           u8 (&palette)[4][4]) noexcept
+    {
+        unpackRgb565(color0, palette[0]);
+        unpackRgb565(color1, palette[1]);
+        for (u32 c = 0; c < 3; c++)
+        {
+            palette[2][c] =
+                static_cast<u8>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+            palette[3][c] =
+                static_cast<u8>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+        }
+        for (u32 p = 0; p < 4; p++)
+        {
+            palette[p][3] = 255;
+        }
+    }
+
+    u32 encodeBC1(const u8* pixels, u8* block) noexcept
+    {
+        static constexpr f32 weights[4] = {0.0f, 1.0f, 1.0f / 3.0f,
+                                           2.0f / 3.0f};
+
+        f32 low[4];
+        f32 high[4];
+        principalEndpoints<3>(pixels, low, high);
+
+        u16 bestColors[2] = {0, 0};
+        u8 bestIndices[block_pixels] = {};
+        u32 bestError = ~0u;
+        for (u32 iteration = 0; iteration < 2; iteration++)
+        {
+            const u16 color0 = packRgb565(high);
+            const u16 color1 = packRgb565(low);
+            u8 palette[4][4];
+            bc1Palette(color0, color1, palette);
+
+            u8 indices[block_pixels];
+            const u32 error = selectIndices(pixels, palette, 4, 3, indices);
+            if (error < bestError)
+            {
+                bestError = error;
+                bestColors[0] = color0;
+                bestColors[1] = color1;
+                memcpy(bestIndices, indices, sizeof(indices));
+            }
+            if (error == 0 ||
+                !refineEndpoints<3>(pixels, indices, weights, high, low))
+            {
+                break;
+            }
+        }
+
+        // The four colour mode needs color0 > color1. Swapping the end
+        // points swaps the index pairs, equal ones leave a single colour.
+        u32 flip = 0;
+        if (bestColors[0] < bestColors[1])
+        {
+            const u16 swap = bestColors[0];
+            bestColors[0] = bestColors[1];
+            bestColors[1] = swap;
+            flip = 1;
+        }
+        u32 indexBits = 0;
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            const u32 index = bestColors[0] == bestColors[1]
+                                  ? 0
+                                  : bestIndices[i] ^ flip;
+            indexBits |= index << (i * 2);
+        }
+
+        memcpy(block, &bestColors[0], 2);
+        memcpy(block + 2, &bestColors[1], 2);
+        memcpy(block + 4, &indexBits, 4);
+
+        if (bestColors[0] == bestColors[1])
+        {
+            u8 palette[4][4];
+            bc1Palette(bestColors[0], bestColors[1], palette);
+            u8 indices[block_pixels];
+            return selectIndices(pixels, palette, 1, 3, indices);
+        }
+        return bestError;
+    }
+
+    void decodeBC1(const u8* block, u8* pixels) noexcept
+    {
+        u16 color0;
+        u16 color1;
+        u32 indexBits;
+        memcpy(&color0, block, 2);
+        memcpy(&color1, block + 2, 2);
+        memcpy(&indexBits, block + 4, 4);
+
+        u8 palette[4][4];
+        bc1Palette(color0, color1, palette);
+        if (color0 <= color1)
+        {
+            // three colour mode with transparent black
+            for (u32 c = 0; c < 3; c++)
+            {
+                palette[2][c] =
+                    static_cast<u8>((palette[0][c] + palette[1][c] + 1) / 2);
+                palette[3][c] = 0;
+            }
+            palette[3][3] = 0;
+        }
+
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            memcpy(pixels + i * 4, palette[(indexBits >> (i * 2)) & 3], 4);
+        }
+    }
+
+    // the eight value mode, a0 > a1: the end points, then six steps
+    // between them
+    static void bc4Palette(const u32 value0, const u32 value1,
+                           u32 (&palette)[8]) noexcept
+    {
+        palette[0] = value0;
+        palette[1] = value1;
+        if (value0 > value1)
+        {
+            for (u32 i = 2; i < 8; i++)
+            {
+                palette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+            }
+        }
+        else
+        {
+            for (u32 i = 2; i < 6; i++)
+            {
+                palette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+    }
+
+    u32 encodeBC4(const u8* pixels, const u32 channel, u8* block) noexcept
+    {
+        u32 minimum = 255;
+        u32 maximum = 0;
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            const u32 value = pixels[i * 4 + channel];
+            minimum = value < minimum ? value : minimum;
+            maximum = value > maximum ? value : maximum;
+        }
+
+        u32 palette[8];
+        bc4Palette(maximum, minimum, palette);
+
+        // The steps are evenly spaced, so the closest one follows from the
+        // position between the end points. Position 0 is index 0, 7 is
+        // index 1 and the ones between are shifted up by one.
+        u64 indexBits = 0;
+        u32 error = 0;
+        const f32 scale =
+            maximum > minimum ? 7.0f / static_cast<f32>(maximum - minimum) : 0.0f;
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            const u32 value = pixels[i * 4 + channel];
+            const u32 step =
+                roundToInt(static_cast<f32>(maximum - value) * scale);
+            const u32 index = step == 0 ? 0 : (step == 7 ? 1 : step + 1);
+            indexBits |= static_cast<u64>(index) << (i * 3);
+
+            const i32 diff =
+                static_cast<i32>(value) - static_cast<i32>(palette[index]);
+            error += static_cast<u32>(diff * diff);
+        }
+
+        block[0] = static_cast<u8>(maximum);
+        block[1] = static_cast<u8>(minimum);
+        memcpy(block + 2, &indexBits, 6);
+        return error;
+    }
+
+    void decodeBC4(const u8* block, const u32 channel, u8* pixels) noexcept
+    {
+        u32 palette[8];
+        bc4Palette(block[0], block[1], palette);
+
+        u64 indexBits = 0;
+        memcpy(&indexBits, block + 2, 6);
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            pixels[i * 4 + channel] =
+                static_cast<u8>(palette[(indexBits >> (i * 3)) & 7]);
+        }
+    }
+
+    u32 encodeBC3(const u8* pixels, u8* block) noexcept
+    {
+        return encodeBC4(pixels, 3, block) + encodeBC1(pixels, block + 8);
+    }
+
+    void decodeBC3(const u8* block, u8* pixels) noexcept
+    {
+        // the colour block of BC3 always uses the four colour mode
+        u16 color0;
+        u16 color1;
+        u32 indexBits;
+        memcpy(&color0, block + 8, 2);
+        memcpy(&color1, block + 10, 2);
+        memcpy(&indexBits, block + 12, 4);
+
+        u8 palette[4][4];
+        bc1Palette(color0, color1, palette);
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            memcpy(pixels + i * 4, palette[(indexBits >> (i * 2)) & 3], 3);
+        }
+        decodeBC4(block, 3, pixels);
+    }
+
+    u32 encodeBC5(const u8* pixels, u8* block) noexcept
+    {
+        return encodeBC4(pixels, 0, block) + encodeBC4(pixels, 1, block + 8);
+    }
+
+    void decodeBC5(const u8* block, u8* pixels) noexcept
+    {
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            pixels[i * 4 + 2] = 0;
+            pixels[i * 4 + 3] = 255;
+        }
+        decodeBC4(block, 0, pixels);
+        decodeBC4(block + 8, 1, pixels);
+    }
+
+    // Rounds an end point to 7 bits per channel plus the shared low bit
+    // that fits it best.
+    static void quantizeBC7Endpoint(const f32 (&endpoint)[4], u8 (&bits)[4],
+                                    u32& pBit) noexcept
+    {
+        f32 bestError = 0.0f;
+        for (u32 p = 0; p < 2; p++)
+        {
+            u8 candidate[4];
+            f32 error = 0.0f;
+            for (u32 c = 0; c < 4; c++)
+            {
+                const f32 half = (endpoint[c] - static_cast<f32>(p)) * 0.5f;
+                const u32 rounded = roundToInt(half < 0.0f ? 0.0f : half);
+                candidate[c] = static_cast<u8>(rounded > 127 ? 127 : rounded);
+                const f32 diff =
+                    static_cast<f32>((candidate[c] << 1) | p) - endpoint[c];
+                error += diff * diff;
+            }
+            if (p == 0 || error < bestError)
+            {
+                bestError = error;
+                memcpy(bits, candidate, 4);
+                pBit = p;
+            }
+        }
+    }
+
+    static void bc7Palette(const u8 (&bits0)[4], const u32 pBit0,
+                           const u8 (&bits1)[4], const u32 pBit1,
+                           u8 (&palette)[16][4]) noexcept
+    {
+        for (u32 c = 0; c < 4; c++)
+        {
+            const u32 value0 = (static_cast<u32>(bits0[c]) << 1) | pBit0;
+            const u32 value1 = (static_cast<u32>(bits1[c]) << 1) | pBit1;
+            for (u32 i = 0; i < 16; i++)
+            {
+                palette[i][c] = static_cast<u8>(
+                    ((64 - bc7_weights[i]) * value0 + bc7_weights[i] * value1 +
+                     32) >>
+                    6);
+            }
+        }
+    }
+
+    u32 encodeBC7(const u8* pixels, u8* block) noexcept
+    {
+        f32 weights[16];
+        for (u32 i = 0; i < 16; i++)
+        {
+            weights[i] = static_cast<f32>(bc7_weights[i]) / 64.0f;
+        }
+
+        f32 low[4];
+        f32 high[4];
+        principalEndpoints<4>(pixels, low, high);
+
+        u8 bestBits[2][4] = {};
+        u32 bestPBits[2] = {0, 0};
+        u8 bestIndices[block_pixels] = {};
+        u32 bestError = ~0u;
+        for (u32 iteration = 0; iteration < 3; iteration++)
+        {
+            u8 bits[2][4];
+            u32 pBits[2];
+            quantizeBC7Endpoint(low, bits[0], pBits[0]);
+            quantizeBC7Endpoint(high, bits[1], pBits[1]);
+            u8 palette[16][4];
+            bc7Palette(bits[0], pBits[0], bits[1], pBits[1], palette);
+
+            u8 indices[block_pixels];
+            const u32 error = selectIndices(pixels, palette, 16, 4, indices);
+            if (error < bestError)
+            {
+                bestError = error;
+                memcpy(bestBits, bits, sizeof(bits));
+                memcpy(bestPBits, pBits, sizeof(pBits));
+                memcpy(bestIndices, indices, sizeof(indices));
+            }
+            if (error == 0 ||
+                !refineEndpoints<4>(pixels, indices, weights, low, high))
+            {
+                break;
+            }
+        }
+
+        // the first index is stored without its top bit, so it has to be
+        // in the lower half
+        const u32 flip = bestIndices[0] >= 8 ? 1 : 0;
+        const u32 first = flip;
+        const u32 second = 1 - flip;
+
+        BlockBits out;
+        out.write(1 << 6, 7);
+        for (u32 c = 0; c < 4; c++)
+        {
+            out.write(bestBits[first][c], 7);
+            out.write(bestBits[second][c], 7);
+        }
+        out.write(bestPBits[first], 1);
+        out.write(bestPBits[second], 1);
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            const u32 index = flip != 0 ? 15 - bestIndices[i] : bestIndices[i];
+            out.write(index, i == 0 ? 3 : 4);
+        }
+        out.store(block, bc7_block_size);
+        return bestError;
+    }
+
+    void decodeBC7(const u8* block, u8* pixels) noexcept
+    {
+        BlockBits in;
+        in.load(block, bc7_block_size);
+        if (in.read(7) != (1 << 6))
+        {
+            memset(pixels, 0, block_pixels * 4);
+            return;
+        }
+
+        u8 bits[2][4];
+        for (u32 c = 0; c < 4; c++)
+        {
+            bits[0][c] = static_cast<u8>(in.read(7));
+            bits[1][c] = static_cast<u8>(in.read(7));
+        }
+        const u32 pBit0 = in.read(1);
+        const u32 pBit1 = in.read(1);
+
+        u8 palette[16][4];
+        bc7Palette(bits[0], pBit0, bits[1], pBit1, palette);
+        for (u32 i = 0; i < block_pixels; i++)
+        {
+            memcpy(pixels + i * 4, palette[in.read(i == 0 ? 3 : 4)], 4);
+        }
+    }
+} // namespace helios
@@ -0,0 +1,682 @@
+#include <helios/math/bounds.hpp>
+
+#include <helios/math/utils.hpp>
+
+#include <cfloat>
+#include <immintrin.h>
+
+namespace helios
+{
+    static Vector3f componentMin(const Vector3f& lhs,
+                                 const Vector3f& rhs) noexcept
+    {
+        return Vector3f(helios::min(lhs.x, rhs.x), helios::min(lhs.y, rhs.y),
+                        helios::min(lhs.z, rhs.z));
+    }
+
+    static Vector3f componentMax(const Vector3f& lhs,
+                                 const Vector3f& rhs) noexcept
+    {
+        return Vector3f(helios::max(lhs.x, rhs.x), helios::max(lhs.y, rhs.y),
+                        helios::max(lhs.z, rhs.z));
+    }
+
+    static Vector3f transformPoint(const Matrix4f& mat,
+                                   const Vector3f& point) noexcept
+    {
+        const Vector4f res = mat * Vector4f(point, 1.0f);
+        return Vector3f(res.x, res.y, res.z);
+    }
+
+    static f32 distanceSquared(const Vector3f& lhs,
+                               const Vector3f& rhs) noexcept
+    {
+        const Vector3f delta = lhs - rhs;
+        return delta.dot(delta);
+    }
+
+    AABB::AABB() noexcept : min(FLT_MAX), max(-FLT_MAX)
+    {
+    }
+
+    AABB::AABB(const Vector3f& min, const Vector3f& max) noexcept
+        : min(min), max(max)
+    {
+    }
+
+    bool AABB::empty() const noexcept
+    {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    Vector3f AABB::center() const noexcept
+    {
+        return (min + max) * 0.5f;
+    }
+
+    Vector3f AABB::extents() const noexcept
+    {
+        return (max - min) * 0.5f;
+    }
+
+    Vector3f AABB::size() const noexcept
+    {
+        return max - min;
+    }
+
+    f32 AABB::surfaceArea() const noexcept
+    {
+        const Vector3f sz = size();
+        return 2.0f * (sz.x * sz.y + sz.y * sz.z + sz.z * sz.x);
+    }
+
+    bool AABB::contains(const Vector3f& point) const noexcept
+    {
+        return point.x >= min.x && point.x <= max.x && point.y >= min.y &&
+               point.y <= max.y && point.z >= min.z && point.z <= max.z;
+    }
+
+    bool AABB::contains(const AABB& other) const noexcept
+    {
+        return contains(other.min) && contains(other.max);
+    }
+
+    bool AABB::intersects(const AABB& other) const noexcept
+    {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    bool AABB::intersects(const BoundingSphere& sphere) const noexcept
+    {
+        const Vector3f closest =
+            componentMin(componentMax(sphere.center, min), max);
+        return distanceSquared(closest, sphere.center) <=
+               sphere.radius * sphere.radius;
+    }
+
+    AABB AABB::transform(const Matrix4f& mat) const noexcept
+    {
+        // Arvo's method: project the extents onto the absolute basis
+        const Vector3f c = transformPoint(mat, center());
+        const Vector3f e = extents();
+
+        Vector3f res;
+        for (u32 row = 0; row < 3; ++row)
+        {
+            res.data[row] = helios::abs(mat.data[0 + row]) * e.x +
+                            helios::abs(mat.data[4 + row]) * e.y +
+                            helios::abs(mat.data[8 + row]) * e.z;
+        }
+
+        return AABB(c - res, c + res);
+    }
+
+    AABB& AABB::expand(const Vector3f& point) noexcept
+    {
+        min = componentMin(min, point);
+        max = componentMax(max, point);
+        return *this;
+    }
+
+    AABB& AABB::expand(const AABB& other) noexcept
+    {
+        min = componentMin(min, other.min);
+        max = componentMax(max, other.max);
+        return *this;
+    }
+
+    AABB AABB::fromCenterExtents(const Vector3f& center,
+                                 const Vector3f& extents) noexcept
+    {
+        return AABB(center - extents, center + extents);
+    }
+
+    AABB AABB::fromPoints(const Vector3f* points, const size_t count) noexcept
+    {
+        __m128 lo = _mm_set1_ps(FLT_MAX);
+        __m128 hi = _mm_set1_ps(-FLT_MAX);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const __m128 p = _mm_load_ps(points[i].data);
+            lo = _mm_min_ps(lo, p);
+            hi = _mm_max_ps(hi, p);
+        }
+
+        AABB res;
+        _mm_store_ps(res.min.data, lo);
+        _mm_store_ps(res.max.data, hi);
+        res.min.data[3] = res.max.data[3] = 0.0f;
+        return res;
+    }
+
+    BoundingSphere::BoundingSphere() noexcept : center(0.0f), radius(-1.0f)
+    {
+    }
+
+    BoundingSphere::BoundingSphere(const Vector3f& center,
+                                   const f32 radius) noexcept
+        : center(center), radius(radius)
+    {
+    }
+
+    bool BoundingSphere::empty() const noexcept
+    {
+        return radius < 0.0f;
+    }
+
+    bool BoundingSphere::contains(const Vector3f& point) const noexcept
+    {
+        return distanceSquared(point, center) <= radius * radius;
+    }
+
+    bool BoundingSphere::intersects(const BoundingSphere& other) const noexcept
+    {
+        const f32 r = radius + other.radius;
+        return distanceSquared(center, other.center) <= r * r;
+    }
+
+    bool BoundingSphere::intersects(const AABB& box) const noexcept
+    {
+        return box.intersects(*this);
+    }
+
+    BoundingSphere BoundingSphere::transform(const Matrix4f& mat) const noexcept
+    {
+        // Scale the radius by the largest axis scale to stay conservative
+        const Vector3f x(mat.data[0], mat.data[1], mat.data[2]);
+        const Vector3f y(mat.data[4], mat.data[5], mat.data[6]);
+        const Vector3f z(mat.data[8], mat.data[9], mat.data[10]);
+        const f32 scale =
+            sqrtf(helios::max(x.dot(x), helios::max(y.dot(y), z.dot(z))));
+        return BoundingSphere(transformPoint(mat, center), radius * scale);
+    }
+
+    BoundingSphere& BoundingSphere::expand(const Vector3f& point) noexcept
+    {
+        if (empty())
+        {
+            center = point;
+            radius = 0.0f;
+            return *this;
+        }
+
+        const f32 dist2 = distanceSquared(point, center);
+        if (dist2 > radius * radius)
+        {
+            // Grow towards the point, keeping the far side of the sphere fixed
+            const f32 dist = sqrtf(dist2);
+            const f32 newRadius = (radius + dist) * 0.5f;
+            const f32 k = (newRadius - radius) / dist;
+            center += (point - center) * k;
+            radius = newRadius;
+        }
+        return *this;
+    }
+
+    BoundingSphere& BoundingSphere::expand(const BoundingSphere& other) noexcept
+    {
+        if (other.empty())
+        {
+            return *this;
+        }
+
+        if (empty())
+        {
+            return *this = other;
+        }
+
+        const f32 dist = sqrtf(distanceSquared(center, other.center));
+        if (dist + other.radius <= radius)
+        {
+            return *this;
+        }
+
+        if (dist + radius <= other.radius)
+        {
+            return *this = other;
+        }
+
+        const f32 newRadius = (dist + radius + other.radius) * 0.5f;
+        center += (other.center - center) * ((newRadius - radius) / dist);
+        radius = newRadius;
+        return *this;
+    }
+
+    BoundingSphere BoundingSphere::fromAABB(const AABB& box) noexcept
+    {
+        if (box.empty())
+        {
+            return BoundingSphere();
+        }
+        return BoundingSphere(box.center(), box.extents().length());
+    }
+
+    BoundingSphere BoundingSphere::fromPoints(const Vector3f* points,
+                                              const size_t count) noexcept
+    {
+        // Ritter's bounding sphere: seed from an approximately most distant
+        // pair of points, then grow the sphere to cover any outliers.
+        if (count == 0)
+        {
+            return BoundingSphere();
+        }
+
+        size_t a = 0;
+        f32 best = -1.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const f32 d = distanceSquared(points[0], points[i]);
+            if (d > best)
+            {
+                best = d;
+                a = i;
+            }
+        }
+
+        size_t b = a;
+        best = -1.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const f32 d = distanceSquared(points[a], points[i]);
+            if (d > best)
+            {
+                best = d;
+                b = i;
+            }
+        }
+
+        BoundingSphere res((points[a] + points[b]) * 0.5f, sqrtf(best) * 0.5f);
+        for (size_t i = 0; i < count; ++i)
+        {
+            res.expand(points[i]);
+        }
+        return res;
+    }
+
+    OBB::OBB() noexcept
+        : center(0.0f), extents(0.0f),
+          axes{Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f),
+               Vector3f(0.0f, 0.0f, 1.0f)}
+    {
+    }
+
+    OBB::OBB(const Vector3f& center, const Vector3f& extents,
+             const Vector3f& axisX, const Vector3f& axisY,
+             const Vector3f& axisZ) noexcept
+        : center(center), extents(extents), axes{axisX, axisY, axisZ}
+    {
+    }
+
+    bool OBB::contains(const Vector3f& point) const noexcept
+    {
+        const Vector3f delta = point - center;
+        for (u32 i = 0; i < 3; ++i)
+        {
+            if (helios::abs(delta.dot(axes[i])) > extents.data[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    AABB OBB::toAABB() const noexcept
+    {
+        Vector3f e;
+        for (u32 i = 0; i < 3; ++i)
+        {
+            e.data[i] = helios::abs(axes[0].data[i]) * extents.x +
+                        helios::abs(axes[1].data[i]) * extents.y +
+                        helios::abs(axes[2].data[i]) * extents.z;
+        }
+        return AABB::fromCenterExtents(center, e);
+    }
+
+    OBB OBB::fromAABB(const AABB& box, const Matrix4f& mat) noexcept
+    {
+        Vector3f axes[3];
+        Vector3f extents = box.extents();
+        for (u32 i = 0; i < 3; ++i)
+        {
+            const Vector3f axis(mat.data[i * 4 + 0], mat.data[i * 4 + 1],
+                                mat.data[i * 4 + 2]);
+            const f32 len = axis.length();
+            axes[i] = len > 0.0f ? axis / len : axis;
+            extents.data[i] *= len;
+        }
+        return OBB(transformPoint(mat, box.center()), extents, axes[0],
+                   axes[1], axes[2]);
+    }
+
+    Plane::Plane() noexcept : normal(0.0f, 1.0f, 0.0f), distance(0.0f)
+    {
+    }
+
+    Plane::Plane(const Vector3f& normal, const f32 distance) noexcept
+        : normal(normal), distance(distance)
+    {
+    }
+
+    Plane::Plane(const Vector3f& normal, const Vector3f& point) noexcept
+        : normal(normal), distance(-normal.dot(point))
+    {
+    }
+
+    Plane::Plane(const Vector4f& coefficients) noexcept
+        : normal(coefficients.x, coefficients.y, coefficients.z),
+          distance(coefficients.w)
+    {
+    }
+
+    f32 Plane::signedDistance(const Vector3f& point) const noexcept
+    {
+        return normal.dot(point) + distance;
+    }
+
+    Plane Plane::normalize() const noexcept
+    {
+        const f32 len = normal.length();
+        if (len == 0.0f)
+        {
+            return *this;
+        }
+        const f32 inv = 1.0f / len;
+        return Plane(normal * inv, distance * inv);
+    }
+
+    Ray::Ray() noexcept : origin(0.0f), direction(0.0f, 0.0f, -1.0f)
+    {
+    }
+
+    Ray::Ray(const Vector3f& origin, const Vector3f& direction) noexcept
+        : origin(origin), direction(direction)
+    {
+    }
+
+    Vector3f Ray::at(const f32 distance) const noexcept
+    {
+        return origin + direction * distance;
+    }
+
+    bool Ray::intersects(const AABB& box, f32& distance) const noexcept
+    {
+        // slab test, a zero direction component divides to +-inf which the
+        // min/max below handle as long as the origin is not on a slab plane
+        f32 entry = 0.0f;
+        f32 exit = FLT_MAX;
+        for (u32 axis = 0; axis < 3; ++axis)
+        {
+            const f32 inv = 1.0f / direction.data[axis];
+            f32 t0 = (box.min.data[axis] - origin.data[axis]) * inv;
+            f32 t1 = (box.max.data[axis] - origin.data[axis]) * inv;
+            if (t0 > t1)
+            {
+                const f32 tmp = t0;
+                t0 = t1;
+                t1 = tmp;
+            }
+            entry = helios::max(entry, t0);
+            exit = helios::min(exit, t1);
+            if (entry > exit)
+            {
+                return false;
+            }
+        }
+
+        distance = entry;
+        return true;
+    }
+
+    bool Ray::intersects(const BoundingSphere& sphere,
+                         f32& distance) const noexcept
+    {
+        const Vector3f offset = origin - sphere.center;
+        const f32 a = direction.dot(direction);
+        const f32 b = offset.dot(direction);
+        const f32 c = offset.dot(offset) - sphere.radius * sphere.radius;
+        const f32 discriminant = b * b - a * c;
+        if (discriminant < 0.0f || a == 0.0f)
+        {
+            return false;
+        }
+
+        const f32 root = sqrtf(discriminant);
+        const f32 exit = (-b + root) / a;
+        if (exit < 0.0f)
+        {
+            return false;
+        }
+
+        const f32 entry = (-b - root) / a;
+        distance = entry < 0.0f ? 0.0f : entry;
+        return true;
+    }
+
+    Frustum::Frustum(const Matrix4f& viewProjection) noexcept
+    {
+        // Gribb/Hartmann plane extraction for a column major matrix with a
+        // clip space depth range of [-w, w], as produced by perspective() and
+        // orthographic().
+        const f32* m = viewProjection.data;
+        const Vector4f row0(m[0], m[4], m[8], m[12]);
+        const Vector4f row1(m[1], m[5], m[9], m[13]);
+        const Vector4f row2(m[2], m[6], m[10], m[14]);
+        const Vector4f row3(m[3], m[7], m[11], m[15]);
+
+        planes[LEFT_PLANE] = Plane(row3 + row0).normalize();
+        planes[RIGHT_PLANE] = Plane(row3 - row0).normalize();
+        planes[BOTTOM_PLANE] = Plane(row3 + row1).normalize();
+        planes[TOP_PLANE] = Plane(row3 - row1).normalize();
+        planes[NEAR_PLANE] = Plane(row3 + row2).normalize();
+        planes[FAR_PLANE] = Plane(row3 - row2).normalize();
+    }
+
+    bool Frustum::contains(const Vector3f& point) const noexcept
+    {
+        for (const Plane& plane : planes)
+        {
+            if (plane.signedDistance(point) < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::intersects(const AABB& box) const noexcept
+    {
+        const Vector3f c = box.center();
+        const Vector3f e = box.extents();
+        for (const Plane& plane : planes)
+        {
+            const f32 r = helios::abs(plane.normal.x) * e.x +
+                          helios::abs(plane.normal.y) * e.y +
+                          helios::abs(plane.normal.z) * e.z;
+            if (plane.signedDistance(c) < -r)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::intersects(const BoundingSphere& sphere) const noexcept
+    {
+        for (const Plane& plane : planes)
+        {
+            if (plane.signedDistance(sphere.center) < -sphere.radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::intersects(const OBB& box) const noexcept
+    {
+        for (const Plane& plane : planes)
+        {
+            const f32 r =
+                helios::abs(plane.normal.dot(box.axes[0])) * box.extents.x +
+                helios::abs(plane.normal.dot(box.axes[1])) * box.extents.y +
+                helios::abs(plane.normal.dot(box.axes[2])) * box.extents.z;
+            if (plane.signedDistance(box.center) < -r)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Frustum Frustum::fromMatrix(const Matrix4f& viewProjection) noexcept
+    {
+        return Frustum(viewProjection);
+    }
+
+    static void writeTail(u8* visibility, const size_t start,
+                          const size_t count, const u32 bits) noexcept
+    {
+        if (start < count)
+        {
+            visibility[start / 8] = static_cast<u8>(bits);
+        }
+    }
+
+    size_t cull(const Frustum& frustum, const AABBSoA& boxes,
+                const size_t count, u8* visibility) noexcept
+    {
+        __m256 nx[Frustum::PLANE_COUNT];
+        __m256 ny[Frustum::PLANE_COUNT];
+        __m256 nz[Frustum::PLANE_COUNT];
+        __m256 ax[Frustum::PLANE_COUNT];
+        __m256 ay[Frustum::PLANE_COUNT];
+        __m256 az[Frustum::PLANE_COUNT];
+        __m256 d[Frustum::PLANE_COUNT];
+
+        for (u32 p = 0; p < Frustum::PLANE_COUNT; ++p)
+        {
+            const Plane& plane = frustum.planes[p];
+            nx[p] = _mm256_set1_ps(plane.normal.x);
+            ny[p] = _mm256_set1_ps(plane.normal.y);
+            nz[p] = _mm256_set1_ps(plane.normal.z);
+            ax[p] = _mm256_set1_ps(helios::abs(plane.normal.x));
+            ay[p] = _mm256_set1_ps(helios::abs(plane.normal.y));
+            az[p] = _mm256_set1_ps(helios::abs(plane.normal.z));
+            d[p] = _mm256_set1_ps(plane.distance);
+        }
+
+        size_t visible = 0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 cx = _mm256_loadu_ps(boxes.centerX + i);
+            const __m256 cy = _mm256_loadu_ps(boxes.centerY + i);
+            const __m256 cz = _mm256_loadu_ps(boxes.centerZ + i);
+            const __m256 ex = _mm256_loadu_ps(boxes.extentX + i);
+            const __m256 ey = _mm256_loadu_ps(boxes.extentY + i);
+            const __m256 ez = _mm256_loadu_ps(boxes.extentZ + i);
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (u32 p = 0; p < Frustum::PLANE_COUNT; ++p)
+            {
+                // dist + radius >= 0, where radius is the extents projected
+                // onto the absolute plane normal
+                const __m256 dist = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(nx[p], cx),
+                                  _mm256_mul_ps(ny[p], cy)),
+                    _mm256_add_ps(_mm256_mul_ps(nz[p], cz), d[p]));
+                const __m256 radius = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(ax[p], ex),
+                                  _mm256_mul_ps(ay[p], ey)),
+                    _mm256_mul_ps(az[p], ez));
+                inside = _mm256_and_ps(
+                    inside, _mm256_cmp_ps(_mm256_add_ps(dist, radius),
+                                          _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+
+            const u32 bits = static_cast<u32>(_mm256_movemask_ps(inside));
+            visibility[i / 8] = static_cast<u8>(bits);
+            visible += static_cast<size_t>(__builtin_popcount(bits));
+        }
+
+        u32 bits = 0;
+        for (size_t j = i; j < count; ++j)
+        {
+            const AABB box = AABB::fromCenterExtents(
+                Vector3f(boxes.centerX[j], boxes.centerY[j], boxes.centerZ[j]),
+                Vector3f(boxes.extentX[j], boxes.extentY[j],
+                         boxes.extentZ[j]));
+            if (frustum.intersects(box))
+            {
+                bits |= 1u << (j - i);
+                ++visible;
+            }
+        }
+        writeTail(visibility, i, count, bits);
+
+        return visible;
+    }
+
+    size_t cull(const Frustum& frustum, const BoundingSphereSoA& spheres,
+                const size_t count, u8* visibility) noexcept
+    {
+        __m256 nx[Frustum::PLANE_COUNT];
+        __m256 ny[Frustum::PLANE_COUNT];
+        __m256 nz[Frustum::PLANE_COUNT];
+        __m256 d[Frustum::PLANE_COUNT];
+
+        for (u32 p = 0; p < Frustum::PLANE_COUNT; ++p)
+        {
+            const Plane& plane = frustum.planes[p];
+            nx[p] = _mm256_set1_ps(plane.normal.x);
+            ny[p] = _mm256_set1_ps(plane.normal.y);
+            nz[p] = _mm256_set1_ps(plane.normal.z);
+            d[p] = _mm256_set1_ps(plane.distance);
+        }
+
+        size_t visible = 0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 cx = _mm256_loadu_ps(spheres.centerX + i);
+            const __m256 cy = _mm256_loadu_ps(spheres.centerY + i);
+            const __m256 cz = _mm256_loadu_ps(spheres.centerZ + i);
+            const __m256 negRadius = _mm256_sub_ps(
+                _mm256_setzero_ps(), _mm256_loadu_ps(spheres.radius + i));
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (u32 p = 0; p < Frustum::PLANE_COUNT; ++p)
+            {
+                const __m256 dist = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(nx[p], cx),
+                                  _mm256_mul_ps(ny[p], cy)),
+                    _mm256_add_ps(_mm256_mul_ps(nz[p], cz), d[p]));
+                inside = _mm256_and_ps(
+                    inside, _mm256_cmp_ps(dist, negRadius, _CMP_GE_OQ));
+            }
+
+            const u32 bits = static_cast<u32>(_mm256_movemask_ps(inside));
+            visibility[i / 8] = static_cast<u8>(bits);
+            visible += static_cast<size_t>(__builtin_popcount(bits));
+        }
+
+        u32 bits = 0;
+        for (size_t j = i; j < count; ++j)
+        {
+            const BoundingSphere sphere(
+                Vector3f(spheres.centerX[j], spheres.centerY[j],
+                         spheres.centerZ[j]),
+                spheres.radius[j]);
+            if (frustum.intersects(sphere))
+            {
+                bits |= 1u << (j - i);
+                ++visible;
+            }
+        }
+        writeTail(visibility, i, count, bits);
+
+        return visible;
+    }
+} // namespace helios
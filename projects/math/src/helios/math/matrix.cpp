@@ -12,138 +12,6 @@ namespace helios
         __m128i i;
     };
 
-    Matrix4f::Matrix4f() noexcept : data()
-    {
-        constexpr f32 zero = 0.0f;
-        for (i32 i = 0; i < 4; i++)
-        {
-            f32* offset = data + (i * 4);
-            __m128 value = _mm_broadcast_ss(&zero);
-            _mm_store_ps(offset, value);
-        }
-    }
-
-    Matrix4f::Matrix4f(const f32 diagonal) noexcept : data()
-    {
-        alignas(16) f32 row[] = {diagonal, 0.0f, 0.0f, 0.0f};
-        __m128 col0 = _mm_load_ps(row);
-        __m128 col1 = _mm_shuffle_ps(col0, col0, _MM_SHUFFLE(1, 1, 0, 1));
-        __m128 col2 = _mm_shuffle_ps(col0, col0, _MM_SHUFFLE(1, 0, 1, 1));
-        __m128 col3 = _mm_shuffle_ps(col0, col0, _MM_SHUFFLE(0, 1, 1, 1));
-        _mm_store_ps(data + 0, col0);
-        _mm_store_ps(data + 4, col1);
-        _mm_store_ps(data + 8, col2);
-        _mm_store_ps(data + 12, col3);
-    }
-
-    Matrix4f::Matrix4f(const Vector4f& col0, const Vector4f& col1,
-                       const Vector4f& col2, const Vector4f& col3) noexcept
-        : data()
-    {
-        _mm_store_ps(data + 0, _mm_load_ps(col0.data));
-        _mm_store_ps(data + 4, _mm_load_ps(col1.data));
-        _mm_store_ps(data + 8, _mm_load_ps(col2.data));
-        _mm_store_ps(data + 12, _mm_load_ps(col3.data));
-    }
-
-    Matrix4f::Matrix4f(const float values[16], const bool aligned) noexcept
-        : data()
-    {
-        if (__builtin_expect(aligned, true))
-        {
-            _mm_store_ps(data + 0, _mm_load_ps(values + 0));
-            _mm_store_ps(data + 4, _mm_load_ps(values + 4));
-            _mm_store_ps(data + 8, _mm_load_ps(values + 8));
-            _mm_store_ps(data + 12, _mm_load_ps(values + 12));
-        }
-        else
-        {
-            _mm_store_ps(data + 0, _mm_loadu_ps(values + 0));
-            _mm_store_ps(data + 4, _mm_loadu_ps(values + 4));
-            _mm_store_ps(data + 8, _mm_loadu_ps(values + 8));
-            _mm_store_ps(data + 12, _mm_loadu_ps(values + 12));
-        }
-    }
-
-    Matrix4f::Matrix4f(const Matrix4f& other) noexcept : data()
-    {
-        _mm_store_ps(data + 0, _mm_load_ps(other.data + 0));
-        _mm_store_ps(data + 4, _mm_load_ps(other.data + 4));
-        _mm_store_ps(data + 8, _mm_load_ps(other.data + 8));
-        _mm_store_ps(data + 12, _mm_load_ps(other.data + 12));
-    }
-
-    Matrix4f::Matrix4f(Matrix4f&& other) noexcept : data()
-    {
-        _mm_store_ps(data + 0, _mm_load_ps(other.data + 0));
-        _mm_store_ps(data + 4, _mm_load_ps(other.data + 4));
-        _mm_store_ps(data + 8, _mm_load_ps(other.data + 8));
-        _mm_store_ps(data + 12, _mm_load_ps(other.data + 12));
-    }
-
-    Matrix4f& Matrix4f::operator=(const f32 diagonal) noexcept
-    {
-        alignas(16) f32 row[] = {diagonal, 0.0f, 0.0f, 0.0f};
-        __m128 col0 = _mm_load_ps(row);
-        __m128 col1 = _mm_shuffle_ps(col0, col0, _MM_SHUFFLE(1, 1, 0, 1));
-        __m128 col2 = _mm_shuffle_ps(col0, col0, _MM_SHUFFLE(1, 0, 1, 1));
-        __m128 col3 = _mm_shuffle_ps(col0, col0, _MM_SHUFFLE(0, 1, 1, 1));
-        _mm_store_ps(data + 0, col0);
-        _mm_store_ps(data + 4, col1);
-        _mm_store_ps(data + 8, col2);
-        _mm_store_ps(data + 12, col3);
-
-        return *this;
-    }
-
-    Matrix4f& Matrix4f::operator=(const Matrix4f& rhs) noexcept
-    {
-        _mm_store_ps(data + 0, _mm_load_ps(rhs.data + 0));
-        _mm_store_ps(data + 4, _mm_load_ps(rhs.data + 4));
-        _mm_store_ps(data + 8, _mm_load_ps(rhs.data + 8));
-        _mm_store_ps(data + 12, _mm_load_ps(rhs.data + 12));
-
-        return *this;
-    }
-
-    Matrix4f& Matrix4f::operator=(Matrix4f&& rhs) noexcept
-    {
-        _mm_store_ps(data + 0, _mm_load_ps(rhs.data + 0));
-        _mm_store_ps(data + 4, _mm_load_ps(rhs.data + 4));
-        _mm_store_ps(data + 8, _mm_load_ps(rhs.data + 8));
-        _mm_store_ps(data + 12, _mm_load_ps(rhs.data + 12));
-
-        return *this;
-    }
-
-    bool Matrix4f::operator==(const Matrix4f& rhs) const noexcept
-    {
-        i32 result = 0x0000;
-        for (i32 i = 0; i < 4; i++)
-        {
-            __m128 me = _mm_load_ps(data + (4 * i));
-            __m128 ot = _mm_load_ps(rhs.data + (4 * i));
-            m128 cmp = {_mm_cmpneq_ps(me, ot)};
-            i32 res = _mm_movemask_epi8(cmp.i);
-            result |= res;
-        }
-        return result == 0;
-    }
-
-    bool Matrix4f::operator!=(const Matrix4f& rhs) const noexcept
-    {
-        i32 result = 0xFFFF;
-        for (i32 i = 0; i < 4; i++)
-        {
-            __m128 me = _mm_load_ps(data + (4 * i));
-            __m128 ot = _mm_load_ps(rhs.data + (4 * i));
-            m128 cmp = {_mm_cmpeq_ps(me, ot)};
-            i32 res = _mm_movemask_epi8(cmp.i);
-            result &= res;
-        }
-        return result != 0xFFFF;
-    }
-
     Matrix4f& Matrix4f::operator+=(const Matrix4f& rhs)
     {
         __m128 lCol0 = _mm_load_ps(data + 0);
@@ -216,30 +84,6 @@ namespace helios
         return *this;
     }
 
-    Matrix4f& Matrix4f::operator*=(const Matrix4f& rhs)
-    {
-        __m128 col0 = _mm_load_ps(data + 0);
-        __m128 col1 = _mm_load_ps(data + 4);
-        __m128 col2 = _mm_load_ps(data + 8);
-        __m128 col3 = _mm_load_ps(data + 12);
-
-        for (i32 i = 0; i < 4; i++)
-        {
-            __m128 element0 = _mm_broadcast_ss(rhs.data + (4 * i + 0));
-            __m128 element1 = _mm_broadcast_ss(rhs.data + (4 * i + 1));
-            __m128 element2 = _mm_broadcast_ss(rhs.data + (4 * i + 2));
-            __m128 element3 = _mm_broadcast_ss(rhs.data + (4 * i + 3));
-
-            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(element0, col0),
-                                                  _mm_mul_ps(element1, col1)),
-                                       _mm_add_ps(_mm_mul_ps(element2, col2),
-                                                  _mm_mul_ps(element3, col3)));
-            _mm_store_ps(data + 4 * i, result);
-        }
-
-        return *this;
-    }
-
     Matrix4f Matrix4f::inverse() const noexcept
     {
         // based on GLM implementation
@@ -422,56 +266,66 @@ namespace helios
         return res;
     }
 
-    Matrix4f operator*(const Matrix4f& lhs, const Matrix4f& rhs) noexcept
+    Matrix4f inverse(const Matrix4f& mat) noexcept
     {
-        Matrix4f res;
-
-        __m128 col0 = _mm_load_ps(lhs.data + 0);
-        __m128 col1 = _mm_load_ps(lhs.data + 4);
-        __m128 col2 = _mm_load_ps(lhs.data + 8);
-        __m128 col3 = _mm_load_ps(lhs.data + 12);
-
-        for (i32 i = 0; i < 4; i++)
-        {
-            __m128 element0 = _mm_broadcast_ss(rhs.data + (4 * i + 0));
-            __m128 element1 = _mm_broadcast_ss(rhs.data + (4 * i + 1));
-            __m128 element2 = _mm_broadcast_ss(rhs.data + (4 * i + 2));
-            __m128 element3 = _mm_broadcast_ss(rhs.data + (4 * i + 3));
-
-            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(element0, col0),
-                                                  _mm_mul_ps(element1, col1)),
-                                       _mm_add_ps(_mm_mul_ps(element2, col2),
-                                                  _mm_mul_ps(element3, col3)));
-            _mm_store_ps(res.data + 4 * i, result);
-        }
-
-        return res;
+        return mat.inverse();
     }
 
-    Vector4f operator*(const Matrix4f& lhs, const Vector4f& rhs) noexcept
+    namespace detail
     {
-        Vector4f res;
-
-        __m128 x = _mm_broadcast_ss(rhs.data + 0);
-        __m128 y = _mm_broadcast_ss(rhs.data + 1);
-        __m128 z = _mm_broadcast_ss(rhs.data + 2);
-        __m128 w = _mm_broadcast_ss(rhs.data + 3);
-
-        __m128 c0 = _mm_load_ps(lhs.data + 0);
-        __m128 c1 = _mm_load_ps(lhs.data + 4);
-        __m128 c2 = _mm_load_ps(lhs.data + 8);
-        __m128 c3 = _mm_load_ps(lhs.data + 12);
-
-        _mm_store_ps(
-            res.data,
-            _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, c0), _mm_mul_ps(y, c1)),
-                       _mm_add_ps(_mm_mul_ps(z, c2), _mm_mul_ps(w, c3))));
+        void multiply(const f32* lhs, const f32* rhs, f32* out) noexcept
+        {
+            __m128 col0 = _mm_load_ps(lhs + 0);
+            __m128 col1 = _mm_load_ps(lhs + 4);
+            __m128 col2 = _mm_load_ps(lhs + 8);
+            __m128 col3 = _mm_load_ps(lhs + 12);
+
+            for (i32 i = 0; i < 4; i++)
+            {
+                __m128 element0 = _mm_broadcast_ss(rhs + (4 * i + 0));
+                __m128 element1 = _mm_broadcast_ss(rhs + (4 * i + 1));
+                __m128 element2 = _mm_broadcast_ss(rhs + (4 * i + 2));
+                __m128 element3 = _mm_broadcast_ss(rhs + (4 * i + 3));
+
+                __m128 result =
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(element0, col0),
+                                          _mm_mul_ps(element1, col1)),
+                               _mm_add_ps(_mm_mul_ps(element2, col2),
+                                          _mm_mul_ps(element3, col3)));
+                _mm_store_ps(out + 4 * i, result);
+            }
+        }
 
-        return res;
-    };
+        void transform(const f32* lhs, const f32* rhs, f32* out) noexcept
+        {
+            __m128 x = _mm_broadcast_ss(rhs + 0);
+            __m128 y = _mm_broadcast_ss(rhs + 1);
+            __m128 z = _mm_broadcast_ss(rhs + 2);
+            __m128 w = _mm_broadcast_ss(rhs + 3);
+
+            __m128 c0 = _mm_load_ps(lhs + 0);
+            __m128 c1 = _mm_load_ps(lhs + 4);
+            __m128 c2 = _mm_load_ps(lhs + 8);
+            __m128 c3 = _mm_load_ps(lhs + 12);
+
+            _mm_store_ps(
+                out,
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, c0), _mm_mul_ps(y, c1)),
+                           _mm_add_ps(_mm_mul_ps(z, c2), _mm_mul_ps(w, c3))));
+        }
 
-    Matrix4f inverse(const Matrix4f& mat) noexcept
-    {
-        return mat.inverse();
-    }
+        bool equals(const f32* lhs, const f32* rhs) noexcept
+        {
+            i32 result = 0x0000;
+            for (i32 i = 0; i < 4; i++)
+            {
+                __m128 me = _mm_load_ps(lhs + (4 * i));
+                __m128 ot = _mm_load_ps(rhs + (4 * i));
+                m128 cmp = {_mm_cmpneq_ps(me, ot)};
+                i32 res = _mm_movemask_epi8(cmp.i);
+                result |= res;
+            }
+            return result == 0;
+        }
+    } // namespace detail
 } // namespace helios
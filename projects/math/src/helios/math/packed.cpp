@@ -0,0 +1,726 @@
+#include <helios/math/packed.hpp>
+
+#include <helios/math/utils.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+namespace helios
+{
+    static f32 clampf(const f32 value, const f32 low, const f32 high) noexcept
+    {
+        return helios::min(helios::max(value, low), high);
+    }
+
+    // Uses the current rounding mode (round to nearest even) to match the
+    // behaviour of _mm256_cvtps_epi32 in the batch converters.
+    static i32 roundToInt(const f32 value) noexcept
+    {
+        return static_cast<i32>(std::nearbyint(value));
+    }
+
+    static f32 signNotZero(const f32 value) noexcept
+    {
+        return value >= 0.0f ? 1.0f : -1.0f;
+    }
+
+    // Loads eight consecutive 16 byte vectors and transposes them into one
+    // register per component.
+    static void loadTransposed(const f32* src, __m256& x, __m256& y, __m256& z,
+                               __m256& w) noexcept
+    {
+        __m128 r0 = _mm_load_ps(src + 0);
+        __m128 r1 = _mm_load_ps(src + 4);
+        __m128 r2 = _mm_load_ps(src + 8);
+        __m128 r3 = _mm_load_ps(src + 12);
+        __m128 r4 = _mm_load_ps(src + 16);
+        __m128 r5 = _mm_load_ps(src + 20);
+        __m128 r6 = _mm_load_ps(src + 24);
+        __m128 r7 = _mm_load_ps(src + 28);
+
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _MM_TRANSPOSE4_PS(r4, r5, r6, r7);
+
+        x = _mm256_insertf128_ps(_mm256_castps128_ps256(r0), r4, 1);
+        y = _mm256_insertf128_ps(_mm256_castps128_ps256(r1), r5, 1);
+        z = _mm256_insertf128_ps(_mm256_castps128_ps256(r2), r6, 1);
+        w = _mm256_insertf128_ps(_mm256_castps128_ps256(r3), r7, 1);
+    }
+
+    static __m256i quantize(const __m256 value, const __m256 low,
+                            const __m256 high, const __m256 scale) noexcept
+    {
+        const __m256 clamped = _mm256_min_ps(_mm256_max_ps(value, low), high);
+        return _mm256_cvtps_epi32(_mm256_mul_ps(clamped, scale));
+    }
+
+    u16 packHalf(const f32 value) noexcept
+    {
+#if defined(__F16C__)
+        return _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+        constexpr u32 f32Infinity = 255u << 23;
+        constexpr u32 f16Max = (127u + 16u) << 23;
+        constexpr u32 denormMagicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+        constexpr u32 signMask = 0x80000000u;
+
+        u32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        const u32 sign = bits & signMask;
+        bits ^= sign;
+
+        u16 result;
+        if (bits >= f16Max)
+        {
+            // overflow to infinity, NaN stays a quiet NaN
+            result = bits > f32Infinity ? 0x7E00 : 0x7C00;
+        }
+        else if (bits < (113u << 23))
+        {
+            // denormalised half, let the FPU do the rounding
+            f32 denormMagic;
+            memcpy(&denormMagic, &denormMagicBits, sizeof(denormMagic));
+
+            f32 f;
+            memcpy(&f, &bits, sizeof(f));
+            f += denormMagic;
+            memcpy(&bits, &f, sizeof(bits));
+            result = static_cast<u16>(bits - denormMagicBits);
+        }
+        else
+        {
+            // rebias the exponent and round the mantissa to nearest even
+            const u32 mantissaOdd = (bits >> 13) & 1;
+            bits += ((15u - 127u) << 23) + 0xFFF;
+            bits += mantissaOdd;
+            result = static_cast<u16>(bits >> 13);
+        }
+
+        return static_cast<u16>(result | (sign >> 16));
+#endif
+    }
+
+    f32 unpackHalf(const u16 value) noexcept
+    {
+#if defined(__F16C__)
+        return _cvtsh_ss(value);
+#else
+        constexpr u32 magicBits = 113u << 23;
+        constexpr u32 shiftedExponent = 0x7C00u << 13;
+
+        u32 bits = (value & 0x7FFFu) << 13;
+        const u32 exponent = shiftedExponent & bits;
+        bits += (127u - 15u) << 23;
+
+        if (exponent == shiftedExponent)
+        {
+            // infinity or NaN
+            bits += (128u - 16u) << 23;
+        }
+        else if (exponent == 0)
+        {
+            // zero or denormalised half
+            f32 magic;
+            memcpy(&magic, &magicBits, sizeof(magic));
+
+            bits += 1u << 23;
+            f32 f;
+            memcpy(&f, &bits, sizeof(f));
+            f -= magic;
+            memcpy(&bits, &f, sizeof(bits));
+        }
+
+        bits |= static_cast<u32>(value & 0x8000u) << 16;
+
+        f32 result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+#endif
+    }
+
+    i16 packSnorm16(const f32 value) noexcept
+    {
+        return static_cast<i16>(roundToInt(clampf(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    f32 unpackSnorm16(const i16 value) noexcept
+    {
+        return helios::max(static_cast<f32>(value) / 32767.0f, -1.0f);
+    }
+
+    i8 packSnorm8(const f32 value) noexcept
+    {
+        return static_cast<i8>(roundToInt(clampf(value, -1.0f, 1.0f) * 127.0f));
+    }
+
+    f32 unpackSnorm8(const i8 value) noexcept
+    {
+        return helios::max(static_cast<f32>(value) / 127.0f, -1.0f);
+    }
+
+    u8 packUnorm8(const f32 value) noexcept
+    {
+        return static_cast<u8>(roundToInt(clampf(value, 0.0f, 1.0f) * 255.0f));
+    }
+
+    f32 unpackUnorm8(const u8 value) noexcept
+    {
+        return static_cast<f32>(value) / 255.0f;
+    }
+
+    u16 packUnorm16(const f32 value) noexcept
+    {
+        return static_cast<u16>(
+            roundToInt(clampf(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    f32 unpackUnorm16(const u16 value) noexcept
+    {
+        return static_cast<f32>(value) / 65535.0f;
+    }
+
+    Vector2f encodeOctahedral(const Vector3f& normal) noexcept
+    {
+        const f32 invL1 = 1.0f / (helios::abs(normal.x) + helios::abs(normal.y) +
+                                  helios::abs(normal.z));
+        const f32 x = normal.x * invL1;
+        const f32 y = normal.y * invL1;
+
+        if (normal.z < 0.0f)
+        {
+            // fold the lower hemisphere over the diagonals
+            return Vector2f((1.0f - helios::abs(y)) * signNotZero(x),
+                            (1.0f - helios::abs(x)) * signNotZero(y));
+        }
+        return Vector2f(x, y);
+    }
+
+    Vector3f decodeOctahedral(const Vector2f& encoded) noexcept
+    {
+        f32 x = encoded.x;
+        f32 y = encoded.y;
+        const f32 z = 1.0f - helios::abs(x) - helios::abs(y);
+        const f32 t = helios::max(-z, 0.0f);
+        x += x >= 0.0f ? -t : t;
+        y += y >= 0.0f ? -t : t;
+
+        const Vector3f res(x, y, z);
+        return res / res.length();
+    }
+
+    Half2::Half2(const Vector2f& value) noexcept
+        : x(packHalf(value.x)), y(packHalf(value.y))
+    {
+    }
+
+    Vector2f Half2::unpack() const noexcept
+    {
+        return Vector2f(unpackHalf(x), unpackHalf(y));
+    }
+
+    Half4::Half4(const Vector4f& value) noexcept
+        : x(packHalf(value.x)), y(packHalf(value.y)), z(packHalf(value.z)),
+          w(packHalf(value.w))
+    {
+    }
+
+    Vector4f Half4::unpack() const noexcept
+    {
+        return Vector4f(unpackHalf(x), unpackHalf(y), unpackHalf(z),
+                        unpackHalf(w));
+    }
+
+    Snorm16x2::Snorm16x2(const Vector2f& value) noexcept
+        : x(packSnorm16(value.x)), y(packSnorm16(value.y))
+    {
+    }
+
+    Vector2f Snorm16x2::unpack() const noexcept
+    {
+        return Vector2f(unpackSnorm16(x), unpackSnorm16(y));
+    }
+
+    Snorm16x4::Snorm16x4(const Vector4f& value) noexcept
+        : x(packSnorm16(value.x)), y(packSnorm16(value.y)),
+          z(packSnorm16(value.z)), w(packSnorm16(value.w))
+    {
+    }
+
+    Vector4f Snorm16x4::unpack() const noexcept
+    {
+        return Vector4f(unpackSnorm16(x), unpackSnorm16(y), unpackSnorm16(z),
+                        unpackSnorm16(w));
+    }
+
+    Snorm8x4::Snorm8x4(const Vector4f& value) noexcept
+        : x(packSnorm8(value.x)), y(packSnorm8(value.y)),
+          z(packSnorm8(value.z)), w(packSnorm8(value.w))
+    {
+    }
+
+    Vector4f Snorm8x4::unpack() const noexcept
+    {
+        return Vector4f(unpackSnorm8(x), unpackSnorm8(y), unpackSnorm8(z),
+                        unpackSnorm8(w));
+    }
+
+    Unorm8x4::Unorm8x4(const Vector4f& value) noexcept
+        : x(packUnorm8(value.x)), y(packUnorm8(value.y)),
+          z(packUnorm8(value.z)), w(packUnorm8(value.w))
+    {
+    }
+
+    Vector4f Unorm8x4::unpack() const noexcept
+    {
+        return Vector4f(unpackUnorm8(x), unpackUnorm8(y), unpackUnorm8(z),
+                        unpackUnorm8(w));
+    }
+
+    Unorm1010102::Unorm1010102(const Vector4f& value) noexcept
+    {
+        const u32 x = roundToInt(clampf(value.x, 0.0f, 1.0f) * 1023.0f);
+        const u32 y = roundToInt(clampf(value.y, 0.0f, 1.0f) * 1023.0f);
+        const u32 z = roundToInt(clampf(value.z, 0.0f, 1.0f) * 1023.0f);
+        const u32 w = roundToInt(clampf(value.w, 0.0f, 1.0f) * 3.0f);
+        bits = x | (y << 10) | (z << 20) | (w << 30);
+    }
+
+    Vector4f Unorm1010102::unpack() const noexcept
+    {
+        return Vector4f(static_cast<f32>(bits & 0x3FF) / 1023.0f,
+                        static_cast<f32>((bits >> 10) & 0x3FF) / 1023.0f,
+                        static_cast<f32>((bits >> 20) & 0x3FF) / 1023.0f,
+                        static_cast<f32>(bits >> 30) / 3.0f);
+    }
+
+    Snorm1010102::Snorm1010102(const Vector4f& value) noexcept
+    {
+        const i32 x = roundToInt(clampf(value.x, -1.0f, 1.0f) * 511.0f);
+        const i32 y = roundToInt(clampf(value.y, -1.0f, 1.0f) * 511.0f);
+        const i32 z = roundToInt(clampf(value.z, -1.0f, 1.0f) * 511.0f);
+        const i32 w = roundToInt(clampf(value.w, -1.0f, 1.0f));
+        bits = (static_cast<u32>(x) & 0x3FF) |
+               ((static_cast<u32>(y) & 0x3FF) << 10) |
+               ((static_cast<u32>(z) & 0x3FF) << 20) |
+               ((static_cast<u32>(w) & 0x3) << 30);
+    }
+
+    Vector4f Snorm1010102::unpack() const noexcept
+    {
+        // shift each field to the top of the word to sign extend it
+        const i32 x = static_cast<i32>(bits << 22) >> 22;
+        const i32 y = static_cast<i32>(bits << 12) >> 22;
+        const i32 z = static_cast<i32>(bits << 2) >> 22;
+        const i32 w = static_cast<i32>(bits) >> 30;
+        return Vector4f(helios::max(static_cast<f32>(x) / 511.0f, -1.0f),
+                        helios::max(static_cast<f32>(y) / 511.0f, -1.0f),
+                        helios::max(static_cast<f32>(z) / 511.0f, -1.0f),
+                        helios::max(static_cast<f32>(w), -1.0f));
+    }
+
+    void packHalf(const f32* src, u16* dst, const size_t count) noexcept
+    {
+        size_t i = 0;
+#if defined(__F16C__)
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i res = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                                _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), res);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            dst[i] = packHalf(src[i]);
+        }
+    }
+
+    void unpackHalf(const u16* src, f32* dst, const size_t count) noexcept
+    {
+        size_t i = 0;
+#if defined(__F16C__)
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i halves =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(halves));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            dst[i] = unpackHalf(src[i]);
+        }
+    }
+
+    void packHalf(const Vector2f* src, Half2* dst, const size_t count) noexcept
+    {
+        size_t i = 0;
+#if defined(__F16C__)
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x, y, z, w;
+            loadTransposed(src[i].data, x, y, z, w);
+
+            const __m128i hx = _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT);
+            const __m128i hy = _mm256_cvtps_ph(y, _MM_FROUND_TO_NEAREST_INT);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm_unpacklo_epi16(hx, hy));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4),
+                             _mm_unpackhi_epi16(hx, hy));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            dst[i] = Half2(src[i]);
+        }
+    }
+
+    void packSnorm16(const f32* src, i16* dst, const size_t count) noexcept
+    {
+        const __m256 low = _mm256_set1_ps(-1.0f);
+        const __m256 high = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(32767.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i ints =
+                quantize(_mm256_loadu_ps(src + i), low, high, scale);
+            // packs works per 128 bit lane, gather the low halves together
+            const __m256i packed = _mm256_permute4x64_epi64(
+                _mm256_packs_epi32(ints, ints), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm256_castsi256_si128(packed));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = packSnorm16(src[i]);
+        }
+    }
+
+    void packSnorm8(const f32* src, i8* dst, const size_t count) noexcept
+    {
+        const __m256 low = _mm256_set1_ps(-1.0f);
+        const __m256 high = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(127.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i ints =
+                quantize(_mm256_loadu_ps(src + i), low, high, scale);
+            const __m256i shorts = _mm256_packs_epi32(ints, ints);
+            const __m256i bytes = _mm256_packs_epi16(shorts, shorts);
+            const i32 lo = _mm256_extract_epi32(bytes, 0);
+            const i32 hi = _mm256_extract_epi32(bytes, 4);
+            memcpy(dst + i, &lo, sizeof(lo));
+            memcpy(dst + i + 4, &hi, sizeof(hi));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = packSnorm8(src[i]);
+        }
+    }
+
+    void packUnorm8(const f32* src, u8* dst, const size_t count) noexcept
+    {
+        const __m256 low = _mm256_setzero_ps();
+        const __m256 high = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(255.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i ints =
+                quantize(_mm256_loadu_ps(src + i), low, high, scale);
+            const __m256i shorts = _mm256_packus_epi32(ints, ints);
+            const __m256i bytes = _mm256_packus_epi16(shorts, shorts);
+            const i32 lo = _mm256_extract_epi32(bytes, 0);
+            const i32 hi = _mm256_extract_epi32(bytes, 4);
+            memcpy(dst + i, &lo, sizeof(lo));
+            memcpy(dst + i + 4, &hi, sizeof(hi));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = packUnorm8(src[i]);
+        }
+    }
+
+    void packUnorm8(const Vector4f* src, Unorm8x4* dst,
+                    const size_t count) noexcept
+    {
+        const __m256 low = _mm256_setzero_ps();
+        const __m256 high = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(255.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x, y, z, w;
+            loadTransposed(src[i].data, x, y, z, w);
+
+            __m256i res = quantize(x, low, high, scale);
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(quantize(y, low, high, scale), 8));
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(quantize(z, low, high, scale), 16));
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(quantize(w, low, high, scale), 24));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), res);
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = Unorm8x4(src[i]);
+        }
+    }
+
+    void packSnorm1010102(const Vector4f* src, Snorm1010102* dst,
+                          const size_t count) noexcept
+    {
+        const __m256 low = _mm256_set1_ps(-1.0f);
+        const __m256 high = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(511.0f);
+        const __m256i mask10 = _mm256_set1_epi32(0x3FF);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x, y, z, w;
+            loadTransposed(src[i].data, x, y, z, w);
+
+            __m256i res = _mm256_and_si256(quantize(x, low, high, scale), mask10);
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(
+                         _mm256_and_si256(quantize(y, low, high, scale), mask10),
+                         10));
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(
+                         _mm256_and_si256(quantize(z, low, high, scale), mask10),
+                         20));
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(quantize(w, low, high, high), 30));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), res);
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = Snorm1010102(src[i]);
+        }
+    }
+
+    void packUnorm1010102(const Vector4f* src, Unorm1010102* dst,
+                          const size_t count) noexcept
+    {
+        const __m256 low = _mm256_setzero_ps();
+        const __m256 high = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(1023.0f);
+        const __m256 alphaScale = _mm256_set1_ps(3.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x, y, z, w;
+            loadTransposed(src[i].data, x, y, z, w);
+
+            __m256i res = quantize(x, low, high, scale);
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(quantize(y, low, high, scale), 10));
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(quantize(z, low, high, scale), 20));
+            res = _mm256_or_si256(
+                res, _mm256_slli_epi32(quantize(w, low, high, alphaScale), 30));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), res);
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = Unorm1010102(src[i]);
+        }
+    }
+
+    void packOctahedral(const Vector3f* src, Snorm16x2* dst,
+                        const size_t count) noexcept
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 low = _mm256_set1_ps(-1.0f);
+        const __m256 scale = _mm256_set1_ps(32767.0f);
+        const __m256i mask16 = _mm256_set1_epi32(0xFFFF);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x, y, z, w;
+            loadTransposed(src[i].data, x, y, z, w);
+
+            const __m256 absX = _mm256_andnot_ps(signMask, x);
+            const __m256 absY = _mm256_andnot_ps(signMask, y);
+            const __m256 absZ = _mm256_andnot_ps(signMask, z);
+            const __m256 invL1 =
+                _mm256_div_ps(one, _mm256_add_ps(_mm256_add_ps(absX, absY), absZ));
+
+            const __m256 px = _mm256_mul_ps(x, invL1);
+            const __m256 py = _mm256_mul_ps(y, invL1);
+
+            // sign of px and py as +-1, treating zero as positive
+            const __m256 signX = _mm256_or_ps(
+                _mm256_and_ps(_mm256_cmp_ps(px, _mm256_setzero_ps(), _CMP_LT_OQ),
+                              signMask),
+                one);
+            const __m256 signY = _mm256_or_ps(
+                _mm256_and_ps(_mm256_cmp_ps(py, _mm256_setzero_ps(), _CMP_LT_OQ),
+                              signMask),
+                one);
+
+            const __m256 foldX = _mm256_mul_ps(
+                _mm256_sub_ps(one, _mm256_andnot_ps(signMask, py)), signX);
+            const __m256 foldY = _mm256_mul_ps(
+                _mm256_sub_ps(one, _mm256_andnot_ps(signMask, px)), signY);
+
+            const __m256 lower = _mm256_cmp_ps(z, _mm256_setzero_ps(), _CMP_LT_OQ);
+            const __m256 ox = _mm256_blendv_ps(px, foldX, lower);
+            const __m256 oy = _mm256_blendv_ps(py, foldY, lower);
+
+            const __m256i qx = _mm256_and_si256(quantize(ox, low, one, scale), mask16);
+            const __m256i qy = quantize(oy, low, one, scale);
+            const __m256i res = _mm256_or_si256(qx, _mm256_slli_epi32(qy, 16));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), res);
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = Snorm16x2(encodeOctahedral(src[i]));
+        }
+    }
+
+    // The batch unpackers divide rather than multiply by the reciprocal so
+    // they give the same bits as the scalar versions.
+    void unpackSnorm16(const i16* src, f32* dst, const size_t count) noexcept
+    {
+        const __m256 low = _mm256_set1_ps(-1.0f);
+        const __m256 scale = _mm256_set1_ps(32767.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i ints = _mm256_cvtepi16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+            _mm256_storeu_ps(dst + i,
+                             _mm256_max_ps(_mm256_div_ps(
+                                               _mm256_cvtepi32_ps(ints), scale),
+                                           low));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = unpackSnorm16(src[i]);
+        }
+    }
+
+    void unpackSnorm8(const i8* src, f32* dst, const size_t count) noexcept
+    {
+        const __m256 low = _mm256_set1_ps(-1.0f);
+        const __m256 scale = _mm256_set1_ps(127.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i ints = _mm256_cvtepi8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+            _mm256_storeu_ps(dst + i,
+                             _mm256_max_ps(_mm256_div_ps(
+                                               _mm256_cvtepi32_ps(ints), scale),
+                                           low));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = unpackSnorm8(src[i]);
+        }
+    }
+
+    void unpackUnorm16(const u16* src, f32* dst, const size_t count) noexcept
+    {
+        const __m256 scale = _mm256_set1_ps(65535.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i ints = _mm256_cvtepu16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+            _mm256_storeu_ps(dst + i,
+                             _mm256_div_ps(_mm256_cvtepi32_ps(ints), scale));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = unpackUnorm16(src[i]);
+        }
+    }
+
+    void unpackUnorm8(const u8* src, f32* dst, const size_t count) noexcept
+    {
+        const __m256 scale = _mm256_set1_ps(255.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i ints = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+            _mm256_storeu_ps(dst + i,
+                             _mm256_div_ps(_mm256_cvtepi32_ps(ints), scale));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = unpackUnorm8(src[i]);
+        }
+    }
+
+    void widenIndices(const u8* src, u32* dst, const size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i bytes =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                                _mm256_cvtepu8_epi32(bytes));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 8),
+                                _mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = src[i];
+        }
+    }
+
+    void widenIndices(const u16* src, u32* dst, const size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m256i shorts =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(dst + i),
+                _mm256_cvtepu16_epi32(_mm256_castsi256_si128(shorts)));
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(dst + i + 8),
+                _mm256_cvtepu16_epi32(_mm256_extracti128_si256(shorts, 1)));
+        }
+
+        for (; i < count; ++i)
+        {
+            dst[i] = src[i];
+        }
+    }
+} // namespace helios
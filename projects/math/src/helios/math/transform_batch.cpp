@@ -0,0 +1,197 @@
+#include <helios/math/transform_batch.hpp>
+
+#include <helios/math/transformations.hpp>
+
+#include <immintrin.h>
+
+namespace helios
+{
+    namespace detail
+    {
+        struct SinCos8
+        {
+            __m256 sin;
+            __m256 cos;
+        };
+
+        // Cephes single precision sincos. The argument is reduced to
+        // [-pi/4, pi/4] in three steps, accurate to a few ulp for the angle
+        // range transformations use.
+        static SinCos8 sincos(__m256 x) noexcept
+        {
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+            __m256 sinSign = _mm256_and_ps(x, signMask);
+            x = _mm256_andnot_ps(signMask, x);
+
+            __m256i octant = _mm256_cvttps_epi32(
+                _mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f)));
+            octant = _mm256_and_si256(_mm256_add_epi32(octant,
+                                                       _mm256_set1_epi32(1)),
+                                      _mm256_set1_epi32(~1));
+            const __m256 y = _mm256_cvtepi32_ps(octant);
+
+            const __m256 swapSin = _mm256_castsi256_ps(_mm256_slli_epi32(
+                _mm256_and_si256(octant, _mm256_set1_epi32(4)), 29));
+            const __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+                _mm256_and_si256(octant, _mm256_set1_epi32(2)),
+                _mm256_setzero_si256()));
+            const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(
+                _mm256_andnot_si256(
+                    _mm256_sub_epi32(octant, _mm256_set1_epi32(2)),
+                    _mm256_set1_epi32(4)),
+                29));
+            sinSign = _mm256_xor_ps(sinSign, swapSin);
+
+            x = _mm256_add_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(-0.78515625f)));
+            x = _mm256_add_ps(
+                x, _mm256_mul_ps(y, _mm256_set1_ps(-2.4187564849853515625e-4f)));
+            x = _mm256_add_ps(
+                x, _mm256_mul_ps(y, _mm256_set1_ps(-3.77489497744594108e-8f)));
+            const __m256 z = _mm256_mul_ps(x, x);
+
+            __m256 cosPoly = _mm256_set1_ps(2.443315711809948e-5f);
+            cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z),
+                                    _mm256_set1_ps(-1.388731625493765e-3f));
+            cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z),
+                                    _mm256_set1_ps(4.166664568298827e-2f));
+            cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, z), z);
+            cosPoly = _mm256_sub_ps(cosPoly,
+                                    _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+            cosPoly = _mm256_add_ps(cosPoly, _mm256_set1_ps(1.0f));
+
+            __m256 sinPoly = _mm256_set1_ps(-1.9515295891e-4f);
+            sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z),
+                                    _mm256_set1_ps(8.3321608736e-3f));
+            sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z),
+                                    _mm256_set1_ps(-1.6666654611e-1f));
+            sinPoly = _mm256_mul_ps(_mm256_mul_ps(sinPoly, z), x);
+            sinPoly = _mm256_add_ps(sinPoly, x);
+
+            // octants 1, 2, 5 and 6 swap the two polynomials
+            const __m256 sinValue = _mm256_blendv_ps(cosPoly, sinPoly, polyMask);
+            const __m256 cosValue = _mm256_blendv_ps(sinPoly, cosPoly, polyMask);
+            return {_mm256_xor_ps(sinValue, sinSign),
+                    _mm256_xor_ps(cosValue, cosSign)};
+        }
+
+        // Transposes 8 rows of 8 floats in place.
+        static void transpose8(__m256 (&rows)[8]) noexcept
+        {
+            const __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+            const __m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+            const __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+            const __m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+            const __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+            const __m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+            const __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+            const __m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+
+            const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+            rows[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+            rows[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+            rows[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+            rows[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+            rows[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+            rows[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+            rows[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+            rows[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+        }
+
+        static void compose8(const TransformArrays& transforms,
+                             const size_t first, Matrix4f* out) noexcept
+        {
+            const __m256 radians = _mm256_set1_ps(pi / 180.0f);
+            const SinCos8 x = sincos(_mm256_mul_ps(
+                _mm256_loadu_ps(transforms.rotation[0] + first), radians));
+            const SinCos8 y = sincos(_mm256_mul_ps(
+                _mm256_loadu_ps(transforms.rotation[1] + first), radians));
+            const SinCos8 z = sincos(_mm256_mul_ps(
+                _mm256_loadu_ps(transforms.rotation[2] + first), radians));
+
+            const __m256 scaleX = _mm256_loadu_ps(transforms.scale[0] + first);
+            const __m256 scaleY = _mm256_loadu_ps(transforms.scale[1] + first);
+            const __m256 scaleZ = _mm256_loadu_ps(transforms.scale[2] + first);
+
+            // rotate(euler) is Rx * Ry * Rz
+            const __m256 sxsy = _mm256_mul_ps(x.sin, y.sin);
+            const __m256 cxsy = _mm256_mul_ps(x.cos, y.sin);
+            const __m256 zero = _mm256_setzero_ps();
+
+            // the first two columns, one lane per transformation
+            __m256 low[8] = {
+                _mm256_mul_ps(_mm256_mul_ps(y.cos, z.cos), scaleX),
+                _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(x.cos, z.sin),
+                                            _mm256_mul_ps(sxsy, z.cos)),
+                              scaleX),
+                _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(x.sin, z.sin),
+                                            _mm256_mul_ps(cxsy, z.cos)),
+                              scaleX),
+                zero,
+                _mm256_mul_ps(_mm256_sub_ps(zero, _mm256_mul_ps(y.cos, z.sin)),
+                              scaleY),
+                _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(x.cos, z.cos),
+                                            _mm256_mul_ps(sxsy, z.sin)),
+                              scaleY),
+                _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(x.sin, z.cos),
+                                            _mm256_mul_ps(cxsy, z.sin)),
+                              scaleY),
+                zero,
+            };
+
+            // the last two columns
+            __m256 high[8] = {
+                _mm256_mul_ps(y.sin, scaleZ),
+                _mm256_mul_ps(_mm256_sub_ps(zero, _mm256_mul_ps(x.sin, y.cos)),
+                              scaleZ),
+                _mm256_mul_ps(_mm256_mul_ps(x.cos, y.cos), scaleZ),
+                zero,
+                _mm256_loadu_ps(transforms.position[0] + first),
+                _mm256_loadu_ps(transforms.position[1] + first),
+                _mm256_loadu_ps(transforms.position[2] + first),
+                _mm256_set1_ps(1.0f),
+            };
+
+            transpose8(low);
+            transpose8(high);
+            for (size_t i = 0; i < 8; i++)
+            {
+                _mm256_storeu_ps(out[i].data, low[i]);
+                _mm256_storeu_ps(out[i].data + 8, high[i]);
+            }
+        }
+    } // namespace detail
+
+    void composeTransforms(const TransformArrays& transforms,
+                           const size_t first, const size_t count,
+                           Matrix4f* out) noexcept
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            detail::compose8(transforms, first + i, out + i);
+        }
+
+        for (; i < count; i++)
+        {
+            const size_t index = first + i;
+            out[i] = transform(Vector3f(transforms.position[0][index],
+                                        transforms.position[1][index],
+                                        transforms.position[2][index]),
+                               Vector3f(transforms.rotation[0][index],
+                                        transforms.rotation[1][index],
+                                        transforms.rotation[2][index]),
+                               Vector3f(transforms.scale[0][index],
+                                        transforms.scale[1][index],
+                                        transforms.scale[2][index]));
+        }
+    }
+} // namespace helios
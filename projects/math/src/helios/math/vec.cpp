@@ -0,0 +1,23 @@
+#include <helios/math/vec.hpp>
+
+#include <helios/math/vector.hpp>
+
+#include <immintrin.h>
+
+namespace helios
+{
+    void toCameraRelative(const Vector3d* positions, const Vector3d& origin,
+                          Vector3f* out, const size_t count) noexcept
+    {
+        // the padding lane of both operands is zero, so it stays zero in the
+        // narrowed result as Vector3f expects
+        const __m256d eye = _mm256_loadu_pd(origin.data);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const __m256d rel =
+                _mm256_sub_pd(_mm256_loadu_pd(positions[i].data), eye);
+            _mm_store_ps(out[i].data, _mm256_cvtpd_ps(rel));
+        }
+    }
+} // namespace helios
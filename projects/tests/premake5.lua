@@ -7,11 +7,15 @@ project "tests"
     objdir (intermediate)
 
     dependson {
+        "containers",
+        "core",
         "googletest",
         "math",
     }
 
     links {
+        "core",
+        "containers",
         "googletest",
         "math",
     }
@@ -22,10 +26,15 @@ project "tests"
 
     includedirs {
         "%{IncludeDir.containers}",
+        "%{IncludeDir.core}",
+        "%{IncludeDir.entt}",
         "%{IncludeDir.gtest}",
         "%{IncludeDir.math}",
+        "%{IncludeDir.stb}",
     }
 
+    vectorextensions "AVX2"
+
     filter "system:windows"
         toolset "msc-ClangCL"
         systemversion "latest"
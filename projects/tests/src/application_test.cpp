@@ -0,0 +1,56 @@
+#include <helios/core/application.hpp>
+#include <helios/ecs/system_scheduler.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace helios;
+
+namespace
+{
+    // stops itself once the registered system ran a few times
+    class TickedApplication final : public Application
+    {
+    public:
+        TickedApplication(JobSystem& jobs, SystemScheduler& systems, const u32& ticks)
+            : Application(jobs, systems), frames(0), _ticks(ticks)
+        {
+        }
+
+        void initialize() override
+        {
+        }
+
+        u32 frames;
+
+    protected:
+        void render(f64) override
+        {
+            ++frames;
+            if (_ticks >= 3)
+            {
+                stop();
+            }
+        }
+
+    private:
+        const u32& _ticks;
+    };
+} // namespace
+
+TEST(Application, RunTicksRegisteredSystems)
+{
+    JobSystem jobs(2);
+    EntityManager manager(&jobs);
+    SystemScheduler systems(manager, jobs);
+
+    u32 ticks = 0;
+    systems.add<Read<>>("tick", [&](EntityManager&) { ++ticks; });
+
+    TickedApplication app(jobs, systems, ticks);
+    FrameLoop::Settings settings;
+    settings.fixedStep = 0.001;
+    app.run(settings);
+
+    EXPECT_GE(ticks, 3U);
+    EXPECT_GT(app.frames, 0U);
+}
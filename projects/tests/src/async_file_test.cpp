@@ -0,0 +1,273 @@
+#include <helios/io/async_file.hpp>
+#include <helios/io/file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    struct AsyncTestFile
+    {
+        std::string path;
+
+        explicit AsyncTestFile(const std::vector<u8>& contents)
+        {
+            static u32 counter = 0;
+            path = (std::filesystem::temp_directory_path() /
+                    ("helios_async_file_test_" + std::to_string(counter++)))
+                       .string();
+            File::write_binary(path, contents.data(), contents.size());
+        }
+
+        ~AsyncTestFile()
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+    std::vector<u8> async_pattern(const size_t size, const u8 seed)
+    {
+        std::vector<u8> bytes(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            bytes[i] = static_cast<u8>(i * 13 + seed);
+        }
+        return bytes;
+    }
+
+    // one read in flight at a time, so completion order is start order
+    AsyncFileReader::Settings serial(const AsyncFileReader::EBackend backend)
+    {
+        AsyncFileReader::Settings settings;
+        settings.backend = backend;
+        settings.queueDepth = 2;
+        settings.threads = 1;
+        return settings;
+    }
+
+    const AsyncFileReader::EBackend async_backends[] = {
+        AsyncFileReader::EBackend::IO_URING,
+        AsyncFileReader::EBackend::THREAD_POOL};
+} // namespace
+
+TEST(AsyncFileReader, ReadsWholeFilesAndRanges)
+{
+    const std::vector<u8> contents = async_pattern(3 << 20, 1);
+    const AsyncTestFile file(contents);
+
+    for (const auto backend : async_backends)
+    {
+        AsyncFileReader::Settings settings;
+        settings.backend = backend;
+        AsyncFileReader reader(settings);
+
+        ReadHandle whole = reader.read(file.path);
+        ReadHandle range = reader.read(file.path, 1000, 5000);
+        ReadHandle tail = reader.read(file.path, contents.size() - 10, 100);
+        ReadHandle past = reader.read(file.path, contents.size() + 10, 100);
+
+        ASSERT_EQ(EReadStatus::COMPLETE, whole.wait());
+        EXPECT_EQ(contents, whole.take());
+
+        ASSERT_EQ(EReadStatus::COMPLETE, range.wait());
+        ASSERT_EQ(5000U, range.data().size());
+        EXPECT_TRUE(std::equal(range.data().begin(), range.data().end(),
+                               contents.begin() + 1000));
+
+        ASSERT_EQ(EReadStatus::COMPLETE, tail.wait());
+        EXPECT_EQ(10U, tail.data().size());
+        EXPECT_EQ(contents.back(), tail.data()[9]);
+
+        ASSERT_EQ(EReadStatus::COMPLETE, past.wait());
+        EXPECT_TRUE(past.data().empty());
+    }
+}
+
+TEST(AsyncFileReader, FailsMissingFiles)
+{
+    for (const auto backend : async_backends)
+    {
+        AsyncFileReader::Settings settings;
+        settings.backend = backend;
+        AsyncFileReader reader(settings);
+
+        EReadStatus reported = EReadStatus::QUEUED;
+        ReadHandle missing = reader.read(
+            "helios_async_file_test_missing", EReadPriority::NORMAL,
+            [&](const EReadStatus status, std::vector<u8>&) {
+                reported = status;
+            });
+        EXPECT_EQ(EReadStatus::FAILED, missing.wait());
+        EXPECT_EQ(EReadStatus::FAILED, reported);
+        EXPECT_EQ(0U, reader.pending());
+    }
+}
+
+TEST(AsyncFileReader, BatchesManyConcurrentReads)
+{
+    std::vector<std::unique_ptr<AsyncTestFile>> files;
+    std::vector<std::string> paths;
+    for (u32 i = 0; i < 40; i++)
+    {
+        files.push_back(std::make_unique<AsyncTestFile>(
+            async_pattern(10000 + i * 4096, static_cast<u8>(i))));
+        paths.push_back(files.back()->path);
+    }
+
+    for (const auto backend : async_backends)
+    {
+        AsyncFileReader::Settings settings;
+        settings.backend = backend;
+        settings.queueDepth = 16;
+        AsyncFileReader reader(settings);
+
+        std::vector<ReadHandle> handles = reader.readBatch(paths);
+        ASSERT_EQ(paths.size(), handles.size());
+        for (size_t i = 0; i < handles.size(); i++)
+        {
+            ASSERT_EQ(EReadStatus::COMPLETE, handles[i].wait());
+            EXPECT_EQ(async_pattern(10000 + i * 4096, static_cast<u8>(i)),
+                      handles[i].take());
+        }
+        EXPECT_EQ(0U, reader.pending());
+    }
+}
+
+TEST(AsyncFileReader, StartsHigherPrioritiesFirst)
+{
+    const AsyncTestFile file(async_pattern(100, 3));
+
+    for (const auto backend : async_backends)
+    {
+        AsyncFileReader reader(serial(backend));
+
+        std::mutex mutex;
+        std::vector<u32> order;
+        const auto record = [&](const u32 id) {
+            return [&, id](const EReadStatus, std::vector<u8>&) {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(id);
+            };
+        };
+
+        // hold the I/O thread in a callback until everything is queued
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        ReadHandle blocker =
+            reader.read(file.path, EReadPriority::NORMAL,
+                        [released](const EReadStatus, std::vector<u8>&) {
+                            released.wait();
+                        });
+        while (blocker.status() == EReadStatus::QUEUED)
+        {
+            std::this_thread::yield();
+        }
+
+        ReadHandle low = reader.read(file.path, EReadPriority::LOW, record(0));
+        ReadHandle normal =
+            reader.read(file.path, EReadPriority::NORMAL, record(1));
+        ReadHandle high = reader.read(file.path, EReadPriority::HIGH, record(2));
+        ReadHandle normalLater =
+            reader.read(file.path, EReadPriority::NORMAL, record(3));
+        release.set_value();
+
+        low.wait();
+        normal.wait();
+        high.wait();
+        normalLater.wait();
+        EXPECT_EQ((std::vector<u32>{2, 1, 3, 0}), order);
+    }
+}
+
+TEST(AsyncFileReader, CancelsQueuedReads)
+{
+    const AsyncTestFile file(async_pattern(100, 5));
+
+    for (const auto backend : async_backends)
+    {
+        AsyncFileReader reader(serial(backend));
+
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        ReadHandle blocker =
+            reader.read(file.path, EReadPriority::NORMAL,
+                        [released](const EReadStatus, std::vector<u8>&) {
+                            released.wait();
+                        });
+        while (blocker.status() == EReadStatus::QUEUED)
+        {
+            std::this_thread::yield();
+        }
+
+        EReadStatus reported = EReadStatus::QUEUED;
+        std::thread::id reportedOn;
+        ReadHandle cancelled = reader.read(
+            file.path, EReadPriority::HIGH,
+            [&](const EReadStatus status, std::vector<u8>&) {
+                reported = status;
+                reportedOn = std::this_thread::get_id();
+            });
+        ReadHandle kept = reader.read(file.path);
+
+        EXPECT_TRUE(cancelled.cancel());
+        EXPECT_EQ(EReadStatus::CANCELLED, cancelled.status());
+        EXPECT_EQ(EReadStatus::CANCELLED, reported);
+        EXPECT_EQ(std::this_thread::get_id(), reportedOn);
+        EXPECT_TRUE(cancelled.data().empty());
+        EXPECT_FALSE(cancelled.cancel());
+
+        release.set_value();
+        EXPECT_EQ(EReadStatus::COMPLETE, blocker.wait());
+        EXPECT_EQ(EReadStatus::COMPLETE, kept.wait());
+        EXPECT_EQ(100U, kept.data().size());
+        EXPECT_EQ(0U, reader.pending());
+    }
+}
+
+TEST(AsyncFileReader, CancelsQueuedReadsWhenDestroyed)
+{
+    const AsyncTestFile file(async_pattern(100, 9));
+
+    for (const auto backend : async_backends)
+    {
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        EReadStatus reported = EReadStatus::QUEUED;
+        std::thread::id reportedOn;
+        ReadHandle queued;
+        {
+            AsyncFileReader reader(serial(backend));
+            ReadHandle blocker =
+                reader.read(file.path, EReadPriority::NORMAL,
+                            [released](const EReadStatus, std::vector<u8>&) {
+                                released.wait();
+                            });
+            while (blocker.status() == EReadStatus::QUEUED)
+            {
+                std::this_thread::yield();
+            }
+
+            // only cancelling it in the destructor lets the blocker finish
+            queued = reader.read(
+                file.path, EReadPriority::NORMAL,
+                [&](const EReadStatus status, std::vector<u8>&) {
+                    reported = status;
+                    reportedOn = std::this_thread::get_id();
+                    release.set_value();
+                });
+        }
+
+        EXPECT_EQ(EReadStatus::CANCELLED, queued.status());
+        EXPECT_EQ(EReadStatus::CANCELLED, reported);
+        EXPECT_EQ(std::this_thread::get_id(), reportedOn);
+    }
+}
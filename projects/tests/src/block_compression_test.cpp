@@ -0,0 +1,345 @@
+#include <helios/math/block_compression.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    constexpr u32 bc_test_side = 64;
+
+    // smooth gradients in every channel with a little noise on top
+    std::vector<u8> make_bc_image(const u32 noiseMask)
+    {
+        std::vector<u8> pixels(bc_test_side * bc_test_side * 4);
+        u32 seed = 12345u;
+        for (u32 y = 0; y < bc_test_side; y++)
+        {
+            for (u32 x = 0; x < bc_test_side; x++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                const u32 noise = (seed >> 24) & noiseMask;
+                u8* pixel = pixels.data() + (y * bc_test_side + x) * 4;
+                pixel[0] = static_cast<u8>(x * 4 + noise);
+                pixel[1] = static_cast<u8>(y * 4 + noise);
+                pixel[2] = static_cast<u8>(255 - (x + y) * 2);
+                pixel[3] = static_cast<u8>(128 + x * 2 - noise);
+            }
+        }
+        return pixels;
+    }
+
+    // Encodes and decodes every block of the test image and returns the
+    // PSNR over the channels in [first, last]. Those are all the channels
+    // the format stores unless partial is set.
+    template <typename Encode, typename Decode>
+    f64 bc_round_trip_psnr(const std::vector<u8>& pixels, Encode&& encode,
+                           Decode&& decode, const u32 first, const u32 last,
+                           const bool partial = false)
+    {
+        f64 squared = 0.0;
+        u64 reported = 0;
+        for (u32 by = 0; by < bc_test_side; by += 4)
+        {
+            for (u32 bx = 0; bx < bc_test_side; bx += 4)
+            {
+                u8 source[64];
+                for (u32 y = 0; y < 4; y++)
+                {
+                    memcpy(source + y * 16,
+                           pixels.data() + ((by + y) * bc_test_side + bx) * 4,
+                           16);
+                }
+
+                u8 block[16];
+                reported += encode(source, block);
+                u8 decoded[64] = {};
+                decode(block, decoded);
+                for (u32 i = 0; i < 16; i++)
+                {
+                    for (u32 c = first; c <= last; c++)
+                    {
+                        const f64 diff = f64(source[i * 4 + c]) -
+                                         f64(decoded[i * 4 + c]);
+                        squared += diff * diff;
+                    }
+                }
+            }
+        }
+
+        // the encoders report the error of what they wrote
+        if (!partial)
+        {
+            EXPECT_EQ(reported, static_cast<u64>(squared));
+        }
+
+        const f64 mse =
+            squared / (f64(bc_test_side) * bc_test_side * (last - first + 1));
+        return mse == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+    // The known answer blocks below are built by hand from the format
+    // specifications. Their endpoints are chosen so every palette entry is
+    // an exact integer, the pixels use each entry without error, and only
+    // one block encodes them losslessly.
+
+    // greys 255, 170, 85 and 0, the full BC1 palette of white and black
+    constexpr u8 bc1_known_greys[16] = {255, 170, 85,  0,   0,   85,  170, 255,
+                                        255, 255, 255, 255, 0,   0,   0,   0};
+    // color0 white and color1 black in 565, then 2 bit indices, pixel 0 in
+    // the low bits: 0 picks color0, 1 color1, 2 and 3 the thirds
+    constexpr u8 bc1_known_block[8] = {0xFF, 0xFF, 0x00, 0x00,
+                                       0x78, 0x2D, 0x00, 0x55};
+
+    // alpha0 238 above alpha1 0 selects eight levels 34 apart
+    constexpr u8 bc4_known_levels[16] = {0,  34,  68,  102, 136, 170, 204, 238,
+                                         0,  34,  68,  102, 136, 170, 204, 238};
+    constexpr u8 bc4_known_reversed[16] = {238, 204, 170, 136, 102, 68, 34, 0,
+                                           238, 204, 170, 136, 102, 68, 34, 0};
+    // 3 bit indices, 0 and 1 pick the endpoints, 2 to 7 step from alpha0
+    // towards alpha1
+    constexpr u8 bc4_known_block[8] = {0xEE, 0x00, 0xB9, 0xCB,
+                                       0x09, 0xB9, 0xCB, 0x09};
+    constexpr u8 bc4_known_reversed_block[8] = {0xEE, 0x00, 0xD0, 0x58,
+                                                0x3F, 0xD0, 0x58, 0x3F};
+
+    // every mode 6 weight applied between 0 and 255, pixel i uses index i
+    constexpr u8 bc7_known_ramp[16] = {0,   16,  36,  52,  68,  84,  104, 120,
+                                       135, 151, 171, 187, 203, 219, 239, 255};
+    // mode bit 6, endpoints 0 and 127 in R, G, B and A, p bits 0 and 1,
+    // then a 3 bit anchor index and fifteen 4 bit indices
+    constexpr u8 bc7_known_block[16] = {0x40, 0xC0, 0x1F, 0xF0, 0x07, 0xFC,
+                                        0x01, 0x7F, 0x11, 0x32, 0x54, 0x76,
+                                        0x98, 0xBA, 0xDC, 0xFE};
+
+    void expect_bc_bytes(const u8* expected, const u8* actual,
+                         const size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            EXPECT_EQ(expected[i], actual[i]) << "byte " << i;
+        }
+    }
+} // namespace
+
+TEST(BlockCompression, BC1Quality)
+{
+    const std::vector<u8> pixels = make_bc_image(7);
+    const f64 psnr = bc_round_trip_psnr(
+        pixels, [](const u8* p, u8* b) { return encodeBC1(p, b); },
+        [](const u8* b, u8* p) { decodeBC1(b, p); }, 0, 2);
+    EXPECT_GT(psnr, 35.0);
+}
+
+TEST(BlockCompression, BC3Quality)
+{
+    const std::vector<u8> pixels = make_bc_image(7);
+    const f64 color = bc_round_trip_psnr(
+        pixels, [](const u8* p, u8* b) { return encodeBC3(p, b); },
+        [](const u8* b, u8* p) { decodeBC3(b, p); }, 0, 3);
+    EXPECT_GT(color, 36.5);
+}
+
+TEST(BlockCompression, BC5Quality)
+{
+    const std::vector<u8> pixels = make_bc_image(7);
+    const f64 psnr = bc_round_trip_psnr(
+        pixels, [](const u8* p, u8* b) { return encodeBC5(p, b); },
+        [](const u8* b, u8* p) { decodeBC5(b, p); }, 0, 1);
+    EXPECT_GT(psnr, 42.0);
+}
+
+TEST(BlockCompression, BC7Quality)
+{
+    const std::vector<u8> pixels = make_bc_image(7);
+    const f64 psnr = bc_round_trip_psnr(
+        pixels, [](const u8* p, u8* b) { return encodeBC7(p, b); },
+        [](const u8* b, u8* p) { decodeBC7(b, p); }, 0, 3);
+    EXPECT_GT(psnr, 36.5);
+
+    // BC7 keeps more of the colour than BC1 on the same image
+    const f64 bc1 = bc_round_trip_psnr(
+        pixels, [](const u8* p, u8* b) { return encodeBC1(p, b); },
+        [](const u8* b, u8* p) { decodeBC1(b, p); }, 0, 2);
+    const f64 bc7 = bc_round_trip_psnr(
+        pixels, [](const u8* p, u8* b) { return encodeBC7(p, b); },
+        [](const u8* b, u8* p) { decodeBC7(b, p); }, 0, 2, true);
+    EXPECT_GT(bc7, bc1);
+}
+
+TEST(BlockCompression, EncodesFlatAndTwoToneBlocks)
+{
+    u8 flat[64];
+    for (u32 i = 0; i < 16; i++)
+    {
+        flat[i * 4 + 0] = 200;
+        flat[i * 4 + 1] = 40;
+        flat[i * 4 + 2] = 90;
+        flat[i * 4 + 3] = 255;
+    }
+
+    u8 block[16];
+    u8 decoded[64];
+    encodeBC7(flat, block);
+    decodeBC7(block, decoded);
+    for (u32 i = 0; i < 64; i++)
+    {
+        EXPECT_NEAR(flat[i], decoded[i], 1);
+    }
+
+    // two values per channel are the BC4 end points and come back exactly
+    u8 twoTone[64] = {};
+    for (u32 i = 0; i < 16; i++)
+    {
+        twoTone[i * 4 + 0] = (i % 3) == 0 ? 17 : 230;
+        twoTone[i * 4 + 1] = (i % 2) == 0 ? 0 : 255;
+    }
+    EXPECT_EQ(0U, encodeBC5(twoTone, block));
+    decodeBC5(block, decoded);
+    for (u32 i = 0; i < 16; i++)
+    {
+        EXPECT_EQ(twoTone[i * 4 + 0], decoded[i * 4 + 0]);
+        EXPECT_EQ(twoTone[i * 4 + 1], decoded[i * 4 + 1]);
+        EXPECT_EQ(0, decoded[i * 4 + 2]);
+        EXPECT_EQ(255, decoded[i * 4 + 3]);
+    }
+
+    // BC1 stays in the four colour mode, even for a single colour
+    encodeBC1(flat, block);
+    u16 color0;
+    u16 color1;
+    memcpy(&color0, block, 2);
+    memcpy(&color1, block + 2, 2);
+    EXPECT_GE(color0, color1);
+    decodeBC1(block, decoded);
+    for (u32 i = 0; i < 16; i++)
+    {
+        EXPECT_NEAR(flat[i * 4 + 0], decoded[i * 4 + 0], 4);
+        EXPECT_NEAR(flat[i * 4 + 1], decoded[i * 4 + 1], 2);
+        EXPECT_NEAR(flat[i * 4 + 2], decoded[i * 4 + 2], 4);
+        EXPECT_EQ(255, decoded[i * 4 + 3]);
+    }
+}
+
+TEST(BlockCompression, BC7KeepsRamps)
+{
+    // sixteen grey levels on one line, which four BC1 colours cannot hold
+    u8 ramp[64];
+    for (u32 i = 0; i < 16; i++)
+    {
+        const u8 value = static_cast<u8>(40 + i * 10);
+        ramp[i * 4 + 0] = value;
+        ramp[i * 4 + 1] = value;
+        ramp[i * 4 + 2] = value;
+        ramp[i * 4 + 3] = 255;
+    }
+
+    u8 block[16];
+    const u32 bc7 = encodeBC7(ramp, block);
+    const u32 bc1 = encodeBC1(ramp, block);
+    EXPECT_LT(bc7 * 10, bc1);
+    EXPECT_LT(bc7, 16U * 3 * 4);
+}
+
+TEST(BlockCompression, BC7WritesMode6)
+{
+    const std::vector<u8> pixels = make_bc_image(15);
+    u8 block[16];
+    encodeBC7(pixels.data(), block);
+    EXPECT_EQ(0x40, block[0] & 0x7F);
+
+    // modes other than 6 are not decoded
+    block[0] = 0x01;
+    u8 other[64];
+    decodeBC7(block, other);
+    for (u32 i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(0, other[i]);
+    }
+}
+
+TEST(BlockCompression, BC1KnownAnswer)
+{
+    u8 pixels[64];
+    for (u32 i = 0; i < 16; i++)
+    {
+        memset(pixels + i * 4, bc1_known_greys[i], 3);
+        pixels[i * 4 + 3] = 255;
+    }
+
+    u8 block[bc1_block_size];
+    EXPECT_EQ(0U, encodeBC1(pixels, block));
+    expect_bc_bytes(bc1_known_block, block, bc1_block_size);
+
+    u8 decoded[64];
+    decodeBC1(bc1_known_block, decoded);
+    expect_bc_bytes(pixels, decoded, 64);
+}
+
+TEST(BlockCompression, BC3KnownAnswer)
+{
+    u8 pixels[64];
+    for (u32 i = 0; i < 16; i++)
+    {
+        memset(pixels + i * 4, bc1_known_greys[i], 3);
+        pixels[i * 4 + 3] = bc4_known_levels[i];
+    }
+
+    // the alpha block comes first
+    u8 expected[bc3_block_size];
+    memcpy(expected, bc4_known_block, bc4_block_size);
+    memcpy(expected + bc4_block_size, bc1_known_block, bc1_block_size);
+
+    u8 block[bc3_block_size];
+    EXPECT_EQ(0U, encodeBC3(pixels, block));
+    expect_bc_bytes(expected, block, bc3_block_size);
+
+    u8 decoded[64];
+    decodeBC3(expected, decoded);
+    expect_bc_bytes(pixels, decoded, 64);
+}
+
+TEST(BlockCompression, BC5KnownAnswer)
+{
+    u8 pixels[64];
+    for (u32 i = 0; i < 16; i++)
+    {
+        pixels[i * 4 + 0] = bc4_known_levels[i];
+        pixels[i * 4 + 1] = bc4_known_reversed[i];
+        pixels[i * 4 + 2] = 0;
+        pixels[i * 4 + 3] = 255;
+    }
+
+    // red then green
+    u8 expected[bc5_block_size];
+    memcpy(expected, bc4_known_block, bc4_block_size);
+    memcpy(expected + bc4_block_size, bc4_known_reversed_block, bc4_block_size);
+
+    u8 block[bc5_block_size];
+    EXPECT_EQ(0U, encodeBC5(pixels, block));
+    expect_bc_bytes(expected, block, bc5_block_size);
+
+    u8 decoded[64];
+    decodeBC5(expected, decoded);
+    expect_bc_bytes(pixels, decoded, 64);
+}
+
+TEST(BlockCompression, BC7KnownAnswer)
+{
+    u8 pixels[64];
+    for (u32 i = 0; i < 16; i++)
+    {
+        memset(pixels + i * 4, bc7_known_ramp[i], 4);
+    }
+
+    u8 block[bc7_block_size];
+    EXPECT_EQ(0U, encodeBC7(pixels, block));
+    expect_bc_bytes(bc7_known_block, block, bc7_block_size);
+
+    u8 decoded[64];
+    decodeBC7(bc7_known_block, decoded);
+    expect_bc_bytes(pixels, decoded, 64);
+}
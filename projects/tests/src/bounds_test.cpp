@@ -0,0 +1,186 @@
+#include <helios/math/bounds.hpp>
+#include <helios/math/transformations.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace helios;
+
+TEST(AABB, DefaultIsEmpty)
+{
+    AABB box;
+    EXPECT_TRUE(box.empty());
+
+    box.expand(Vector3f(1.0f, 2.0f, 3.0f));
+    EXPECT_FALSE(box.empty());
+    EXPECT_EQ(box.min, Vector3f(1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(box.max, Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+TEST(AABB, FromPoints)
+{
+    Vector3f points[] = {
+        {-1.0f, 2.0f, 0.5f},
+        {3.0f, -4.0f, 1.0f},
+        {0.0f, 0.0f, -2.0f},
+    };
+
+    AABB box = AABB::fromPoints(points, 3);
+    EXPECT_EQ(box.min, Vector3f(-1.0f, -4.0f, -2.0f));
+    EXPECT_EQ(box.max, Vector3f(3.0f, 2.0f, 1.0f));
+    EXPECT_EQ(box.center(), Vector3f(1.0f, -1.0f, -0.5f));
+    EXPECT_EQ(box.extents(), Vector3f(2.0f, 3.0f, 1.5f));
+
+    for (const auto& point : points)
+    {
+        EXPECT_TRUE(box.contains(point));
+    }
+}
+
+TEST(AABB, Intersects)
+{
+    AABB a(Vector3f(0.0f), Vector3f(1.0f));
+    AABB b(Vector3f(0.5f), Vector3f(2.0f));
+    AABB c(Vector3f(1.5f), Vector3f(2.0f));
+
+    EXPECT_TRUE(a.intersects(b));
+    EXPECT_FALSE(a.intersects(c));
+    EXPECT_TRUE(a.intersects(BoundingSphere(Vector3f(1.5f, 0.5f, 0.5f), 0.6f)));
+    EXPECT_FALSE(a.intersects(BoundingSphere(Vector3f(3.0f), 1.0f)));
+}
+
+TEST(AABB, Transform)
+{
+    AABB box(Vector3f(-1.0f), Vector3f(1.0f));
+
+    AABB moved = box.transform(translate(Vector3f(5.0f, 0.0f, 0.0f)));
+    EXPECT_EQ(moved.min, Vector3f(4.0f, -1.0f, -1.0f));
+    EXPECT_EQ(moved.max, Vector3f(6.0f, 1.0f, 1.0f));
+
+    AABB rotated = box.transform(rotate(Vector3f(0.0f, 0.0f, 45.0f)));
+    EXPECT_NEAR(rotated.max.x, sqrtf(2.0f), 0.0001f);
+    EXPECT_NEAR(rotated.max.y, sqrtf(2.0f), 0.0001f);
+    EXPECT_NEAR(rotated.max.z, 1.0f, 0.0001f);
+}
+
+TEST(BoundingSphere, FromPointsContainsAll)
+{
+    Vector3f points[] = {
+        {-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},  {0.0f, 3.0f, 0.0f},
+        {0.0f, 0.0f, 2.0f},  {0.5f, 0.5f, -0.5f},
+    };
+
+    BoundingSphere sphere = BoundingSphere::fromPoints(points, 5);
+    for (const auto& point : points)
+    {
+        EXPECT_LE(length(point - sphere.center), sphere.radius + 0.0001f);
+    }
+}
+
+TEST(BoundingSphere, Expand)
+{
+    BoundingSphere sphere;
+    EXPECT_TRUE(sphere.empty());
+
+    sphere.expand(BoundingSphere(Vector3f(0.0f), 1.0f));
+    sphere.expand(BoundingSphere(Vector3f(4.0f, 0.0f, 0.0f), 1.0f));
+    EXPECT_NEAR(sphere.radius, 3.0f, 0.0001f);
+    EXPECT_NEAR(sphere.center.x, 2.0f, 0.0001f);
+}
+
+TEST(Frustum, Perspective)
+{
+    Frustum frustum(perspective(90.0f, 1.0f, 0.1f, 100.0f));
+
+    EXPECT_TRUE(frustum.contains(Vector3f(0.0f, 0.0f, -5.0f)));
+    EXPECT_FALSE(frustum.contains(Vector3f(0.0f, 0.0f, 5.0f)));
+    EXPECT_FALSE(frustum.contains(Vector3f(0.0f, 0.0f, -200.0f)));
+    EXPECT_FALSE(frustum.contains(Vector3f(10.0f, 0.0f, -5.0f)));
+
+    EXPECT_TRUE(frustum.intersects(BoundingSphere(Vector3f(6.0f, 0.0f, -5.0f), 1.5f)));
+    EXPECT_FALSE(frustum.intersects(BoundingSphere(Vector3f(8.0f, 0.0f, -5.0f), 1.0f)));
+    EXPECT_TRUE(frustum.intersects(AABB(Vector3f(-1.0f), Vector3f(1.0f))));
+    EXPECT_FALSE(frustum.intersects(AABB(Vector3f(-1.0f, -1.0f, 1.0f), Vector3f(1.0f, 1.0f, 2.0f))));
+}
+
+TEST(Frustum, Orthographic)
+{
+    Frustum frustum(orthographic(-1.0f, 1.0f, -1.0f, 1.0f, 0.1f, 10.0f));
+
+    EXPECT_TRUE(frustum.contains(Vector3f(0.5f, -0.5f, -1.0f)));
+    EXPECT_FALSE(frustum.contains(Vector3f(1.5f, 0.0f, -1.0f)));
+    EXPECT_FALSE(frustum.contains(Vector3f(0.0f, 0.0f, -11.0f)));
+
+    OBB box = OBB::fromAABB(AABB(Vector3f(-0.5f), Vector3f(0.5f)),
+                            translate(Vector3f(1.4f, 0.0f, -1.0f)) * rotate(Vector3f(0.0f, 0.0f, 45.0f)));
+    EXPECT_TRUE(frustum.intersects(box));
+    EXPECT_TRUE(frustum.intersects(box.toAABB()));
+}
+
+TEST(Frustum, BatchCullMatchesScalar)
+{
+    Frustum frustum(perspective(60.0f, 16.0f / 9.0f, 0.1f, 50.0f));
+
+    constexpr size_t count = 19;
+    f32 cx[count], cy[count], cz[count], ex[count], ey[count], ez[count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        cx[i] = static_cast<f32>(i) * 2.5f - 20.0f;
+        cy[i] = static_cast<f32>(i % 3) - 1.0f;
+        cz[i] = -static_cast<f32>(i) * 3.0f + 5.0f;
+        ex[i] = ey[i] = ez[i] = 0.5f + static_cast<f32>(i % 4) * 0.25f;
+    }
+
+    u8 boxMask[visibilityMaskSize(count)] = {};
+    u8 sphereMask[visibilityMaskSize(count)] = {};
+
+    const size_t visibleBoxes = cull(frustum, AABBSoA{cx, cy, cz, ex, ey, ez}, count, boxMask);
+    const size_t visibleSpheres = cull(frustum, BoundingSphereSoA{cx, cy, cz, ex}, count, sphereMask);
+
+    size_t expectedBoxes = 0;
+    size_t expectedSpheres = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Vector3f center(cx[i], cy[i], cz[i]);
+        const bool boxVisible = frustum.intersects(AABB::fromCenterExtents(center, Vector3f(ex[i], ey[i], ez[i])));
+        const bool sphereVisible = frustum.intersects(BoundingSphere(center, ex[i]));
+
+        EXPECT_EQ(isVisible(boxMask, i), boxVisible);
+        EXPECT_EQ(isVisible(sphereMask, i), sphereVisible);
+
+        expectedBoxes += boxVisible ? 1 : 0;
+        expectedSpheres += sphereVisible ? 1 : 0;
+    }
+
+    EXPECT_EQ(visibleBoxes, expectedBoxes);
+    EXPECT_EQ(visibleSpheres, expectedSpheres);
+    EXPECT_GT(visibleBoxes, 0u);
+    EXPECT_LT(visibleBoxes, count);
+}
+
+TEST(Ray, IntersectsAABB)
+{
+    AABB box(Vector3f(-1.0f), Vector3f(1.0f));
+    f32 distance = -1.0f;
+
+    EXPECT_TRUE(Ray(Vector3f(-5.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f)).intersects(box, distance));
+    EXPECT_FLOAT_EQ(distance, 4.0f);
+
+    EXPECT_TRUE(Ray(Vector3f(0.0f), Vector3f(0.0f, 1.0f, 0.0f)).intersects(box, distance));
+    EXPECT_FLOAT_EQ(distance, 0.0f);
+
+    EXPECT_FALSE(Ray(Vector3f(-5.0f, 0.0f, 0.0f), Vector3f(-1.0f, 0.0f, 0.0f)).intersects(box, distance));
+    EXPECT_FALSE(Ray(Vector3f(-5.0f, 2.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f)).intersects(box, distance));
+}
+
+TEST(Ray, IntersectsBoundingSphere)
+{
+    BoundingSphere sphere(Vector3f(0.0f, 0.0f, -10.0f), 2.0f);
+    f32 distance = -1.0f;
+
+    EXPECT_TRUE(Ray(Vector3f(0.0f), Vector3f(0.0f, 0.0f, -1.0f)).intersects(sphere, distance));
+    EXPECT_FLOAT_EQ(distance, 8.0f);
+    EXPECT_FLOAT_EQ(Ray(Vector3f(0.0f), Vector3f(0.0f, 0.0f, -1.0f)).at(distance).z, -8.0f);
+
+    EXPECT_FALSE(Ray(Vector3f(0.0f), Vector3f(0.0f, 0.0f, 1.0f)).intersects(sphere, distance));
+    EXPECT_FALSE(Ray(Vector3f(3.0f, 0.0f, 0.0f), Vector3f(0.0f, 0.0f, -1.0f)).intersects(sphere, distance));
+}
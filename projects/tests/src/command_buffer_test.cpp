@@ -0,0 +1,112 @@
+#include <helios/ecs/command_buffer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace helios
+{
+    extern entt::registry& get_entt(EntityManager& manager);
+}
+
+using namespace helios;
+
+namespace
+{
+    struct Health
+    {
+        i32 value;
+    };
+
+    struct Spawned
+    {
+        u32 parent;
+    };
+
+    struct Tagged
+    {
+        std::string name;
+    };
+
+    // entities and their Spawned component in registry order, after letting
+    // every entity with no health spawn a replacement and die
+    std::vector<std::pair<u32, u32>> simulate(const u32 workers)
+    {
+        JobSystem jobs(workers);
+        EntityManager manager(&jobs);
+        CommandBuffer commands(manager);
+
+        for (u32 i = 0; i < 20000; i++)
+        {
+            manager.create().assign<Health>(Health{static_cast<i32>(i % 3)});
+        }
+
+        manager.parallel_each<Read<Health>>(
+            [&](Entity e, const Health& health) {
+                if (health.value == 0)
+                {
+                    auto recorder = commands.record(e);
+                    const PendingEntity spawned = recorder.create();
+                    recorder.assign<Spawned>(
+                        spawned, static_cast<u32>(entt::to_integral(e.handle())));
+                    recorder.assign<Health>(spawned, 10);
+                    recorder.release(e);
+                }
+            },
+            64);
+        commands.playback();
+
+        std::vector<std::pair<u32, u32>> result;
+        get_entt(manager).view<Spawned>().each(
+            [&](const entt::entity entity, const Spawned& spawned) {
+                result.emplace_back(static_cast<u32>(entt::to_integral(entity)),
+                                    spawned.parent);
+            });
+        return result;
+    }
+} // namespace
+
+TEST(CommandBuffer, PlaybackIsIndependentOfWorkerCount)
+{
+    const auto serial = simulate(0);
+    const auto parallel = simulate(3);
+    EXPECT_EQ(serial.size(), 6667u);
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST(CommandBuffer, AppliesChangesInOrder)
+{
+    EntityManager manager;
+    CommandBuffer commands(manager);
+
+    Entity a = manager.create();
+    a.assign<Health>(Health{5});
+    Entity b = manager.create();
+    b.assign<Health>(Health{7});
+
+    PendingEntity pending;
+    {
+        auto recorder = commands.record(0);
+        recorder.assign<Health>(a, 1);
+        recorder.assign<Health>(a, 2);
+        recorder.remove<Health>(b);
+        pending = recorder.create();
+        recorder.assign<Tagged>(pending, std::string("spawned"));
+        recorder.assign<Tagged>(b, std::string("doomed"));
+        recorder.release(b);
+    }
+    EXPECT_FALSE(commands.empty());
+    EXPECT_EQ(a.get<Health>().value, 5);
+
+    commands.playback();
+    EXPECT_TRUE(commands.empty());
+
+    EXPECT_EQ(a.get<Health>().value, 2);
+    EXPECT_FALSE(get_entt(manager).valid(b.handle()));
+
+    Entity spawned = commands.resolve(pending);
+    ASSERT_TRUE(spawned.has<Tagged>());
+    EXPECT_EQ(spawned.get<Tagged>().name, "spawned");
+    EXPECT_FALSE(spawned.has<Health>());
+}
@@ -0,0 +1,147 @@
+#include <helios/core/cooked_mesh.hpp>
+#include <helios/io/file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // a side x side grid of quads in the xz plane, offset along x
+    Mesh* make_grid(const u32 side, const f32 offset,
+                    const EVertexFormat format)
+    {
+        Mesh* mesh = new Mesh();
+        for (u32 y = 0; y < side; y++)
+        {
+            for (u32 x = 0; x < side; x++)
+            {
+                mesh->positions.push_back(Vector3f(offset + f32(x), 0, f32(y)));
+                mesh->uvs.push_back(Vector2f(f32(x), f32(y)));
+                mesh->normals.push_back(Vector3f(0, 1, 0));
+            }
+        }
+        for (u32 y = 0; y + 1 < side; y++)
+        {
+            for (u32 x = 0; x + 1 < side; x++)
+            {
+                const u32 i = y * side + x;
+                for (const u32 index : {i, i + side, i + 1, i + 1, i + side,
+                                        i + side + 1})
+                {
+                    mesh->triangles.push_back(index);
+                }
+            }
+        }
+        mesh->calculateBounds();
+        mesh->build(format);
+        return mesh;
+    }
+
+    void expect_same_bytes(const void* expected, const span<const u8> actual,
+                           const size_t size)
+    {
+        ASSERT_EQ(size, actual.size());
+        EXPECT_EQ(0, memcmp(expected, actual.data(), size));
+    }
+} // namespace
+
+TEST(CookedMesh, RoundTripsBuiltSubMeshes)
+{
+    for (const EVertexFormat format :
+         {EVertexFormat::FULL, EVertexFormat::PACKED})
+    {
+        Mesh mesh;
+        mesh.subMeshes.push_back(make_grid(4, 0.0f, format));
+        mesh.subMeshes.push_back(make_grid(7, 10.0f, format));
+        mesh.calculateBounds();
+
+        const std::vector<u8> data = CookedMesh::cook(mesh);
+        const CookedMesh cooked(span<const u8>(data.data(), data.size()));
+        ASSERT_TRUE(cooked.valid());
+        EXPECT_EQ(format, cooked.vertexFormat());
+        ASSERT_EQ(2U, cooked.subMeshCount());
+        EXPECT_EQ(mesh.bounds.min, cooked.bounds().min);
+        EXPECT_EQ(mesh.bounds.max, cooked.bounds().max);
+
+        for (u32 i = 0; i < 2; i++)
+        {
+            const Mesh& source = *mesh.subMeshes[i];
+            const CookedMesh::SubMesh& subMesh = cooked.subMesh(i);
+            EXPECT_EQ(source.positions.size(), subMesh.vertexCount);
+            EXPECT_EQ(source.triangles.size(), subMesh.indexCount);
+            expect_same_bytes(source.readBuffer(0), subMesh.positions,
+                              source.bufferSize(0));
+            expect_same_bytes(source.readBuffer(1), subMesh.attributes,
+                              source.bufferSize(1));
+            expect_same_bytes(source.triangles.data(), subMesh.indices,
+                              source.triangles.size() * sizeof(u32));
+            EXPECT_EQ(source.bounds.max, subMesh.bounds.max);
+            EXPECT_EQ(source.boundingSphere.radius,
+                      subMesh.boundingSphere.radius);
+
+            // every blob can be handed to the device at its file offset
+            for (const span<const u8> blob :
+                 {subMesh.positions, subMesh.attributes, subMesh.indices})
+            {
+                EXPECT_EQ(0U, static_cast<size_t>(blob.data() - data.data()) %
+                                  64);
+            }
+        }
+    }
+}
+
+TEST(CookedMesh, LoadsFromAFile)
+{
+    Mesh mesh;
+    mesh.subMeshes.push_back(make_grid(16, 0.0f, EVertexFormat::PACKED));
+    mesh.calculateBounds();
+    const std::vector<u8> data = CookedMesh::cook(mesh);
+
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "helios_cooked_mesh_test")
+            .string();
+    ASSERT_TRUE(File::write_binary(path, data.data(), data.size()));
+
+    {
+        const CookedMesh cooked(path);
+        ASSERT_TRUE(cooked.valid());
+        ASSERT_EQ(1U, cooked.subMeshCount());
+        EXPECT_EQ(256U, cooked.subMesh(0).vertexCount);
+        expect_same_bytes(mesh.subMeshes[0]->readBuffer(1),
+                          cooked.subMesh(0).attributes,
+                          256 * sizeof(PackedVertexNoPosition));
+    }
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(CookedMesh(path).valid());
+}
+
+TEST(CookedMesh, RejectsDamagedData)
+{
+    Mesh mesh;
+    mesh.subMeshes.push_back(make_grid(4, 0.0f, EVertexFormat::FULL));
+    mesh.calculateBounds();
+    const std::vector<u8> data = CookedMesh::cook(mesh);
+
+    EXPECT_FALSE(CookedMesh(span<const u8>()).valid());
+    EXPECT_FALSE(
+        CookedMesh(span<const u8>(data.data(), data.size() - 1)).valid());
+
+    std::vector<u8> magic = data;
+    magic[0] ^= 0xFF;
+    EXPECT_FALSE(CookedMesh(span<const u8>(magic.data(), magic.size())).valid());
+
+    // a sub mesh claiming more vertices than its streams hold
+    std::vector<u8> count = data;
+    u32 vertices;
+    memcpy(&vertices, count.data() + 64, sizeof(vertices));
+    vertices += 1;
+    memcpy(count.data() + 64, &vertices, sizeof(vertices));
+    EXPECT_FALSE(CookedMesh(span<const u8>(count.data(), count.size())).valid());
+}
@@ -0,0 +1,214 @@
+#include <helios/core/cooked_texture.hpp>
+#include <helios/core/job_system.hpp>
+#include <helios/io/file.hpp>
+#include <helios/math/block_compression.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    std::vector<u8> make_checkerboard(const u32 width, const u32 height)
+    {
+        std::vector<u8> pixels(static_cast<size_t>(width) * height * 4);
+        for (u32 y = 0; y < height; y++)
+        {
+            for (u32 x = 0; x < width; x++)
+            {
+                const u8 value = ((x + y) % 2) == 0 ? 255 : 0;
+                u8* pixel = pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+                pixel[0] = value;
+                pixel[1] = value;
+                pixel[2] = value;
+                pixel[3] = 255;
+            }
+        }
+        return pixels;
+    }
+} // namespace
+
+TEST(CookedTexture, BuildsTheMipChain)
+{
+    EXPECT_EQ(1U, textureMipCount(1, 1));
+    EXPECT_EQ(9U, textureMipCount(256, 256));
+    EXPECT_EQ(7U, textureMipCount(100, 37));
+
+    const std::vector<u8> pixels = make_checkerboard(12, 5);
+    const auto mips =
+        buildTextureMips(pixels.data(), 12, 5, ETextureContent::LINEAR);
+    ASSERT_EQ(4U, mips.size());
+    EXPECT_EQ(12U * 5 * 4, mips[0].size());
+    EXPECT_EQ(6U * 2 * 4, mips[1].size());
+    EXPECT_EQ(3U * 1 * 4, mips[2].size());
+    EXPECT_EQ(1U * 1 * 4, mips[3].size());
+    EXPECT_EQ(0, memcmp(pixels.data(), mips[0].data(), pixels.size()));
+}
+
+TEST(CookedTexture, FiltersInLinearSpace)
+{
+    const std::vector<u8> pixels = make_checkerboard(8, 8);
+
+    // half white is 188 in sRGB, not the 128 of averaging the stored values
+    const auto srgb =
+        buildTextureMips(pixels.data(), 8, 8, ETextureContent::SRGB);
+    EXPECT_NEAR(188, srgb[1][0], 1);
+    EXPECT_NEAR(188, srgb.back()[2], 1);
+    EXPECT_EQ(255, srgb[1][3]);
+
+    const auto linear =
+        buildTextureMips(pixels.data(), 8, 8, ETextureContent::LINEAR);
+    EXPECT_NEAR(128, linear[1][0], 1);
+
+    // normals tilted either way average to straight up, at unit length
+    std::vector<u8> normals(8 * 8 * 4);
+    for (u32 i = 0; i < 64; i++)
+    {
+        normals[i * 4 + 0] = (i % 2) == 0 ? 218 : 37;
+        normals[i * 4 + 1] = 128;
+        normals[i * 4 + 2] = 218;
+        normals[i * 4 + 3] = 255;
+    }
+    const auto normal =
+        buildTextureMips(normals.data(), 8, 8, ETextureContent::NORMAL);
+    EXPECT_NEAR(128, normal[1][0], 1);
+    EXPECT_NEAR(128, normal[1][1], 1);
+    EXPECT_NEAR(255, normal[1][2], 1);
+}
+
+TEST(CookedTexture, FiltersOddLevelsWithoutDroppingTexels)
+{
+    // only the last texel of a 5x1 row is lit, it must reach the 2x1 level
+    std::vector<u8> pixels(5 * 4, 0);
+    for (u32 i = 0; i < 5; i++)
+    {
+        pixels[i * 4 + 3] = 255;
+    }
+    pixels[4 * 4 + 0] = 255;
+
+    const auto mips =
+        buildTextureMips(pixels.data(), 5, 1, ETextureContent::LINEAR);
+    ASSERT_EQ(3U, mips.size());
+    EXPECT_EQ(0, mips[1][0]);
+    EXPECT_NEAR(102, mips[1][4], 1);
+    EXPECT_NEAR(51, mips[2][0], 1);
+    EXPECT_EQ(255, mips[2][3]);
+}
+
+TEST(CookedTexture, WeightsColourByAlpha)
+{
+    // one opaque red texel among transparent green ones
+    std::vector<u8> pixels(2 * 2 * 4, 0);
+    pixels[0] = 255;
+    pixels[3] = 255;
+    for (u32 i = 1; i < 4; i++)
+    {
+        pixels[i * 4 + 1] = 255;
+    }
+
+    const auto srgb =
+        buildTextureMips(pixels.data(), 2, 2, ETextureContent::SRGB);
+    ASSERT_EQ(2U, srgb.size());
+    EXPECT_EQ(255, srgb[1][0]);
+    EXPECT_EQ(0, srgb[1][1]);
+    EXPECT_EQ(0, srgb[1][2]);
+    EXPECT_NEAR(64, srgb[1][3], 1);
+}
+
+TEST(CookedTexture, RoundTripsEveryFormat)
+{
+    JobSystem jobs(2);
+    const std::vector<u8> pixels = make_checkerboard(30, 18);
+    for (const ETextureFormat format :
+         {ETextureFormat::RGBA8, ETextureFormat::BC1, ETextureFormat::BC3,
+          ETextureFormat::BC5, ETextureFormat::BC7})
+    {
+        const std::vector<u8> data = CookedTexture::cook(
+            pixels.data(), 30, 18, format, ETextureContent::SRGB, &jobs);
+        const CookedTexture cooked(span<const u8>(data.data(), data.size()));
+        ASSERT_TRUE(cooked.valid());
+        EXPECT_EQ(format, cooked.format());
+        EXPECT_EQ(ETextureContent::SRGB, cooked.content());
+        EXPECT_EQ(30U, cooked.width());
+        EXPECT_EQ(18U, cooked.height());
+        ASSERT_EQ(5U, cooked.levelCount());
+
+        // the levels follow each other in one payload, aligned for copies
+        u64 end = 0;
+        for (u32 i = 0; i < cooked.levelCount(); i++)
+        {
+            const CookedTexture::Level& level = cooked.level(i);
+            EXPECT_EQ(std::max(30U >> i, 1U), level.width);
+            EXPECT_EQ(std::max(18U >> i, 1U), level.height);
+            EXPECT_EQ(0U, level.offset % 16);
+            EXPECT_GE(level.offset, end);
+            EXPECT_EQ(textureLevelSize(format, level.width, level.height),
+                      level.bytes.size());
+            EXPECT_EQ(cooked.payload().data() + level.offset,
+                      level.bytes.data());
+            end = level.offset + level.bytes.size();
+        }
+        EXPECT_EQ(end, cooked.payload().size());
+    }
+
+    // a serial and a parallel encode give the same bytes
+    const std::vector<u8> serial = compressTexture(
+        pixels.data(), 30, 18, ETextureFormat::BC7);
+    const std::vector<u8> parallel = compressTexture(
+        pixels.data(), 30, 18, ETextureFormat::BC7, &jobs);
+    EXPECT_EQ(serial, parallel);
+    EXPECT_EQ(8U * 5 * 16, serial.size());
+}
+
+TEST(CookedTexture, LoadsFromAFile)
+{
+    const std::vector<u8> pixels = make_checkerboard(16, 16);
+    const std::vector<u8> data = CookedTexture::cook(
+        pixels.data(), 16, 16, ETextureFormat::BC1, ETextureContent::SRGB);
+
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "helios_cooked_texture_test")
+            .string();
+    ASSERT_TRUE(File::write_binary(path, data.data(), data.size()));
+
+    {
+        const CookedTexture cooked(path);
+        ASSERT_TRUE(cooked.valid());
+        EXPECT_EQ(5U, cooked.levelCount());
+        EXPECT_EQ(4U * 4 * bc1_block_size, cooked.level(0).bytes.size());
+    }
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(CookedTexture(path).valid());
+}
+
+TEST(CookedTexture, RejectsDamagedData)
+{
+    const std::vector<u8> pixels = make_checkerboard(8, 8);
+    const std::vector<u8> data = CookedTexture::cook(
+        pixels.data(), 8, 8, ETextureFormat::BC7, ETextureContent::LINEAR);
+
+    EXPECT_FALSE(CookedTexture(span<const u8>()).valid());
+    EXPECT_FALSE(
+        CookedTexture(span<const u8>(data.data(), data.size() - 1)).valid());
+
+    std::vector<u8> magic = data;
+    magic[0] ^= 0xFF;
+    EXPECT_FALSE(
+        CookedTexture(span<const u8>(magic.data(), magic.size())).valid());
+
+    // a level whose size does not match its dimensions
+    std::vector<u8> level = data;
+    u32 width;
+    memcpy(&width, level.data() + 48, sizeof(width));
+    width += 4;
+    memcpy(level.data() + 48, &width, sizeof(width));
+    EXPECT_FALSE(
+        CookedTexture(span<const u8>(level.data(), level.size())).valid());
+}
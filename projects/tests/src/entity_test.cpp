@@ -0,0 +1,350 @@
+#include <helios/ecs/entity.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace helios;
+
+namespace
+{
+    struct Position
+    {
+        f32 x;
+        f32 y;
+    };
+
+    struct Velocity
+    {
+        f32 x;
+        f32 y;
+    };
+
+    struct Frozen
+    {
+        u32 frame;
+    };
+} // namespace
+
+TEST(EntityManager, ParallelEachUpdatesEveryMatch)
+{
+    JobSystem jobs(3);
+    EntityManager manager(&jobs);
+
+    for (u32 i = 0; i < 100000; i++)
+    {
+        Entity e = manager.create();
+        e.assign<Position>(Position{static_cast<f32>(i), 0.0f});
+        if (i % 3 == 0)
+        {
+            e.assign<Velocity>(Velocity{1.0f, 2.0f});
+        }
+    }
+
+    manager.parallel_each<Read<Velocity>, Write<Position>>(
+        [](const Velocity& v, Position& p) {
+            p.x += v.x;
+            p.y += v.y;
+        },
+        512);
+
+    std::atomic<u32> moved(0);
+    manager.parallel_each<Read<Position>>([&](Entity e, const Position& p) {
+        if (e.has<Velocity>())
+        {
+            EXPECT_FLOAT_EQ(p.y, 2.0f);
+            moved.fetch_add(1);
+        }
+        else
+        {
+            EXPECT_FLOAT_EQ(p.y, 0.0f);
+        }
+    });
+    EXPECT_EQ(moved.load(), 33334u);
+}
+
+TEST(EntityManager, ParallelReduceIsDeterministic)
+{
+    JobSystem jobs(3);
+    EntityManager parallel(&jobs);
+    EntityManager serial;
+
+    for (u32 i = 0; i < 50000; i++)
+    {
+        const Position p{1.0f / static_cast<f32>(i + 1), 0.0f};
+        parallel.create().assign<Position>(p);
+        serial.create().assign<Position>(p);
+    }
+
+    auto sum = [](f32& acc, const Position& p) { acc += p.x; };
+    auto combine = [](f32 lhs, f32 rhs) { return lhs + rhs; };
+
+    const f32 a = parallel.parallel_reduce<Read<Position>>(0.0f, sum, combine, 256);
+    const f32 b = parallel.parallel_reduce<Read<Position>>(0.0f, sum, combine, 256);
+    const f32 c = serial.parallel_reduce<Read<Position>>(0.0f, sum, combine, 256);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, c);
+    EXPECT_NEAR(a, 11.397f, 1e-2f);
+}
+
+TEST(EntityManager, NestedConflictingQueriesRunInline)
+{
+    JobSystem jobs(3);
+    EntityManager parallel(&jobs);
+    EntityManager serial;
+
+    for (EntityManager* manager : {&parallel, &serial})
+    {
+        for (u32 i = 0; i < 5000; i++)
+        {
+            Entity e = manager->create();
+            e.assign<Position>(Position{1.0f, 0.0f});
+            if (i == 0)
+            {
+                e.assign<Frozen>(Frozen{i});
+            }
+        }
+        auto positions = manager->group<>(Get<Position>{}, Exclude<Velocity>{});
+
+        // both nested queries conflict with the outer write, they used to
+        // wait for the outer query and so for themselves
+        u32 visits = 0;
+        manager->parallel_each<Read<Frozen>, Write<Position>>(
+            [&](const Frozen&, Position& p) {
+                p.y = manager->parallel_reduce<Read<Position>>(
+                    0.0f, [](f32& acc, const Position& q) { acc += q.x; },
+                    [](f32 lhs, f32 rhs) { return lhs + rhs; }, 256);
+                positions.parallel_each([](Position& q) { q.x += 1.0f; }, 256);
+                ++visits;
+            });
+        EXPECT_EQ(visits, 1u);
+
+        f32 sum = 0.0f;
+        manager->parallel_each<Read<Frozen, Position>>(
+            [&](const Frozen&, const Position& p) { sum += p.y; });
+        EXPECT_FLOAT_EQ(sum, 5000.0f);
+        positions.each([](const Position& p) { EXPECT_FLOAT_EQ(p.x, 2.0f); });
+
+        // the outer guard is gone, a conflicting query on another thread
+        // does not wait any more
+        manager->parallel_each<Read<>, Write<Position>>([](Position& p) { p.x = 0.0f; });
+    }
+}
+
+// Sibling ranges keep writing while a range runs its callbacks, so a
+// conflicting query from one of them cannot run inline. Debug builds assert,
+// release builds skip it.
+TEST(EntityManager, ConflictingQueryFromParallelRangeIsRejected)
+{
+    auto run = []() {
+        JobSystem jobs(3);
+        EntityManager manager(&jobs);
+        for (u32 i = 0; i < 4096; i++)
+        {
+            manager.create().assign<Position>(Position{1.0f, 0.0f});
+        }
+
+        std::atomic<u32> visits(0);
+        std::atomic<u32> nested(0);
+        manager.parallel_each<Read<>, Write<Position>>(
+            [&](Position& p) {
+                p.y = 1.0f;
+                visits.fetch_add(1);
+                manager.parallel_each<Read<Position>>(
+                    [&](const Position&) { nested.fetch_add(1); });
+            },
+            256);
+        EXPECT_EQ(visits.load(), 4096u);
+        return nested.load();
+    };
+
+    u32 nested = 0;
+    EXPECT_DEBUG_DEATH(nested = run(), "parallel range");
+    EXPECT_EQ(nested, 0u);
+}
+
+// A thread waiting for jobs runs queued ones meanwhile. Those must not be
+// mistaken for callbacks of the query the thread is inside of, a conflicting
+// query from one of them would have run inline next to it.
+TEST(EntityManager, JobsRunWhileWaitingDoNotInheritQueries)
+{
+    auto run = []() {
+        JobSystem jobs(1);
+        EntityManager manager;
+        for (u32 i = 0; i < 100; i++)
+        {
+            Entity e = manager.create();
+            e.assign<Position>(Position{1.0f, 0.0f});
+            e.assign<Velocity>(Velocity{2.0f, 0.0f});
+        }
+
+        // park the only worker, so the waiting thread runs the job itself
+        std::atomic<bool> parked(false);
+        std::atomic<bool> release(false);
+        jobs.submit([&]() {
+            parked.store(true);
+            while (!release.load())
+            {
+                std::this_thread::yield();
+            }
+        });
+        while (!parked.load())
+        {
+            std::this_thread::yield();
+        }
+
+        f32 velocities = 0.0f;
+        u32 conflicting = 0;
+        bool submitted = false;
+        manager.parallel_each<Read<Velocity>, Write<Position>>(
+            [&](const Velocity&, Position&) {
+                if (submitted)
+                {
+                    return;
+                }
+                submitted = true;
+
+                std::atomic<size_t> pending(1);
+                jobs.submit([&]() {
+                    // reads what the outer query reads, no conflict
+                    velocities = manager.parallel_reduce<Read<Velocity>>(
+                        0.0f, [](f32& acc, const Velocity& v) { acc += v.x; },
+                        [](f32 lhs, f32 rhs) { return lhs + rhs; });
+                    manager.parallel_each<Read<Position>>(
+                        [&](const Position&) { ++conflicting; });
+                    pending.fetch_sub(1);
+                });
+                jobs.wait(pending);
+            });
+        EXPECT_FLOAT_EQ(velocities, 200.0f);
+
+        release.store(true);
+        jobs.wait();
+        return conflicting;
+    };
+
+    u32 conflicting = 0;
+    EXPECT_DEBUG_DEATH(conflicting = run(), "waiting on it");
+    EXPECT_EQ(conflicting, 0u);
+}
+
+TEST(EntityManager, ComponentAccessConflicts)
+{
+    const auto readPosition = ComponentAccess::of(Read<Position>{}, Write<>{});
+    const auto readBoth = ComponentAccess::of(Read<Position, Velocity>{}, Write<>{});
+    const auto writePosition = ComponentAccess::of(Read<Velocity>{}, Write<Position>{});
+    const auto writeVelocity = ComponentAccess::of(Read<>{}, Write<Velocity>{});
+
+    EXPECT_FALSE(readPosition.conflicts(readBoth));
+    EXPECT_TRUE(readPosition.conflicts(writePosition));
+    EXPECT_TRUE(writePosition.conflicts(readPosition));
+    EXPECT_TRUE(writePosition.conflicts(writeVelocity));
+    EXPECT_FALSE(readPosition.conflicts(writeVelocity));
+}
+
+TEST(EntityManager, OwningGroupIteratesMatches)
+{
+    JobSystem jobs(3);
+    EntityManager manager(&jobs);
+    auto group = manager.group<Position, Velocity>(Exclude<Frozen>{});
+
+    for (u32 i = 0; i < 10000; i++)
+    {
+        Entity e = manager.create();
+        e.assign<Position>(Position{static_cast<f32>(i), 0.0f});
+        if (i % 2 == 0)
+        {
+            e.assign<Velocity>(Velocity{0.0f, 1.0f});
+        }
+        if (i % 10 == 0)
+        {
+            e.assign<Frozen>(Frozen{i});
+        }
+    }
+
+    EXPECT_EQ(group.size(), 4000u);
+    group.parallel_each(
+        [](Position& p, Velocity& v) {
+            p.y += v.y;
+        },
+        256);
+
+    u32 moved = 0;
+    group.each([&](Entity e, const Position& p, const Velocity&) {
+        EXPECT_FALSE(e.has<Frozen>());
+        EXPECT_FLOAT_EQ(p.y, 1.0f);
+        ++moved;
+    });
+    EXPECT_EQ(moved, 4000u);
+}
+
+TEST(EntityManager, PartialGroupTracksMembership)
+{
+    EntityManager manager;
+    auto group = manager.group<Position>(Get<Velocity>{});
+
+    Entity a = manager.create();
+    a.assign<Position>(Position{1.0f, 0.0f});
+    Entity b = manager.create();
+    b.assign<Position>(Position{2.0f, 0.0f});
+    b.assign<Velocity>(Velocity{3.0f, 0.0f});
+
+    EXPECT_EQ(group.size(), 1u);
+    EXPECT_FALSE(group.contains(a));
+    EXPECT_TRUE(group.contains(b));
+
+    a.assign<Velocity>(Velocity{4.0f, 0.0f});
+    b.remove<Velocity>();
+
+    f32 sum = 0.0f;
+    group.each([&](const Position& p, const Velocity& v) { sum += p.x + v.x; });
+    EXPECT_TRUE(group.contains(a));
+    EXPECT_FALSE(group.contains(b));
+    EXPECT_FLOAT_EQ(sum, 5.0f);
+}
+
+TEST(EntityManager, ChangedSinceReturnsStampedComponents)
+{
+    EntityManager manager;
+    Entity a = manager.create();
+    a.assign<Position>(Position{1.0f, 0.0f});
+    manager.track<Position>();
+    EXPECT_TRUE(manager.tracked<Position>());
+    EXPECT_FALSE(manager.tracked<Velocity>());
+
+    Entity b = manager.create();
+    b.assign<Position>(Position{2.0f, 0.0f});
+    Entity c = manager.create();
+    c.assign<Position>(Position{3.0f, 0.0f});
+
+    u32 count = 0;
+    manager.changed_since<Position>(0, [&](const Position&) { ++count; });
+    EXPECT_EQ(count, 3u);
+
+    const u64 seen = manager.advanceVersion();
+    count = 0;
+    manager.changed_since<Position>(seen, [&](const Position&) { ++count; });
+    EXPECT_EQ(count, 0u);
+
+    b.replace<Position>(Position{4.0f, 0.0f});
+    c.get<Position>().x = 5.0f;
+    c.touch<Position>();
+    a.get<Position>().x = 6.0f;
+
+    f32 sum = 0.0f;
+    manager.changed_since<Position>(seen, [&](Entity e, const Position& p) {
+        EXPECT_NE(e.handle(), a.handle());
+        sum += p.x;
+    });
+    EXPECT_FLOAT_EQ(sum, 9.0f);
+
+    const u64 next = manager.advanceVersion();
+    a.patch<Position>([](Position& p) { p.y = 1.0f; });
+    count = 0;
+    manager.changed_since<Position>(next, [&](Entity e, const Position&) {
+        EXPECT_EQ(e.handle(), a.handle());
+        ++count;
+    });
+    EXPECT_EQ(count, 1u);
+}
@@ -0,0 +1,117 @@
+#include <helios/io/file.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // removes the file again when the test is done with it
+    struct TemporaryFile
+    {
+        std::string path;
+
+        explicit TemporaryFile(const std::vector<u8>& contents)
+        {
+            static u32 counter = 0;
+            path = (std::filesystem::temp_directory_path() /
+                    ("helios_file_test_" + std::to_string(counter++)))
+                       .string();
+            File::write_binary(path, contents.data(), contents.size());
+        }
+
+        ~TemporaryFile()
+        {
+            std::remove(path.c_str());
+        }
+    };
+
+    std::vector<u8> pattern(const size_t size)
+    {
+        std::vector<u8> bytes(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            bytes[i] = static_cast<u8>(i * 31 + 7);
+        }
+        return bytes;
+    }
+} // namespace
+
+TEST(MappedFile, MapsTheWholeFile)
+{
+    const std::vector<u8> contents = pattern(100000);
+    const TemporaryFile file(contents);
+
+    const MappedFile mapped(file.path, EFileAccess::RANDOM);
+    ASSERT_TRUE(mapped.valid());
+    ASSERT_EQ(contents.size(), mapped.size());
+    mapped.prefetch(4096, 8192);
+
+    const span<const u8> bytes = mapped.bytes();
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), contents.begin()));
+    EXPECT_EQ(contents[99999], bytes.subspan(99990, 10)[9]);
+}
+
+TEST(MappedFile, HandlesEmptyAndMissingFiles)
+{
+    const TemporaryFile empty({});
+    const MappedFile mapped(empty.path);
+    EXPECT_TRUE(mapped.valid());
+    EXPECT_TRUE(mapped.bytes().empty());
+    EXPECT_TRUE(mapped.text().empty());
+
+    const MappedFile missing(empty.path + ".missing");
+    EXPECT_FALSE(missing.valid());
+    EXPECT_FALSE(static_cast<bool>(missing));
+    EXPECT_TRUE(File::read_binary(empty.path + ".missing").empty());
+}
+
+TEST(MappedFile, MovesOwnership)
+{
+    const std::string text = "{\"name\": \"helios\"}";
+    const TemporaryFile file(std::vector<u8>(text.begin(), text.end()));
+
+    MappedFile first(file.path);
+    MappedFile second(std::move(first));
+    EXPECT_FALSE(first.valid());
+    EXPECT_EQ(text, second.text());
+
+    MappedFile third;
+    third = std::move(second);
+    EXPECT_FALSE(second.valid());
+    EXPECT_EQ(text, third.text());
+    EXPECT_EQ(text, File::read_text(file.path));
+}
+
+TEST(FileChunkReader, ReadsTheFileInChunks)
+{
+    const std::vector<u8> contents = pattern(10000);
+    const TemporaryFile file(contents);
+
+    FileChunkReader reader(file.path, 4096);
+    ASSERT_TRUE(reader.valid());
+    EXPECT_EQ(contents.size(), reader.size());
+
+    std::vector<u8> read;
+    std::vector<size_t> sizes;
+    for (span<const u8> chunk = reader.next(); !chunk.empty();
+         chunk = reader.next())
+    {
+        sizes.push_back(chunk.size());
+        read.insert(read.end(), chunk.begin(), chunk.end());
+    }
+
+    EXPECT_EQ((std::vector<size_t>{4096, 4096, 1808}), sizes);
+    EXPECT_EQ(contents, read);
+    EXPECT_EQ(contents.size(), reader.offset());
+
+    const vector<u8> binary = File::read_binary(file.path);
+    ASSERT_EQ(contents.size(), binary.size());
+    EXPECT_TRUE(std::equal(binary.begin(), binary.end(), contents.begin()));
+}
@@ -0,0 +1,126 @@
+#include <helios/core/frame_loop.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // one step per frame, render records the simulated value it was given
+    std::vector<u32> rendered_values(JobSystem& jobs, const bool pipelined)
+    {
+        FrameLoop::Settings settings;
+        settings.fixedStep = 0.25;
+        settings.pipelined = pipelined;
+        FrameLoop loop(jobs, settings);
+
+        u32 simulated = 0;
+        u32 extracted = 0;
+        std::vector<u32> rendered;
+        loop.onSimulate([&](f64) { ++simulated; });
+        loop.onExtract([&](f64) { extracted = simulated; });
+        loop.onRender([&](f64) { rendered.push_back(extracted); });
+
+        for (u32 i = 0; i < 5; i++)
+        {
+            loop.advance(0.25);
+        }
+        EXPECT_EQ(5U, simulated);
+        return rendered;
+    }
+} // namespace
+
+TEST(FrameLoop, StepsAtAFixedRateAndCarriesTheRemainder)
+{
+    JobSystem jobs(0);
+    FrameLoop::Settings settings;
+    settings.fixedStep = 0.25;
+    FrameLoop loop(jobs, settings);
+
+    std::vector<f64> steps;
+    f64 alpha = -1.0;
+    loop.onSimulate([&](const f64 step) { steps.push_back(step); });
+    loop.onRender([&](const f64 a) { alpha = a; });
+
+    loop.advance(0.625);
+    EXPECT_EQ(2U, loop.timings().steps);
+    EXPECT_EQ(0.5, alpha);
+
+    loop.advance(0.125);
+    EXPECT_EQ(1U, loop.timings().steps);
+    EXPECT_EQ(0.0, alpha);
+
+    loop.advance(0.125);
+    EXPECT_EQ(0U, loop.timings().steps);
+    EXPECT_EQ(0.5, alpha);
+
+    EXPECT_EQ(std::vector<f64>(3, 0.25), steps);
+    EXPECT_EQ(3U, loop.stepCount());
+    EXPECT_EQ(0.75, loop.simulationTime());
+    EXPECT_EQ(3U, loop.frameCount());
+}
+
+TEST(FrameLoop, DropsStepsBeyondTheLimit)
+{
+    JobSystem jobs(0);
+    FrameLoop::Settings settings;
+    settings.fixedStep = 0.25;
+    settings.maxStepsPerFrame = 4;
+    FrameLoop loop(jobs, settings);
+
+    loop.advance(10.125);
+    EXPECT_EQ(4U, loop.timings().steps);
+
+    // the backlog is gone, the next frame only steps for its own time
+    loop.advance(0.25);
+    EXPECT_EQ(1U, loop.timings().steps);
+}
+
+TEST(FrameLoop, PipelinedRenderSeesThePreviousFrame)
+{
+    JobSystem jobs(2);
+    EXPECT_EQ((std::vector<u32>{1, 2, 3, 4, 5}), rendered_values(jobs, false));
+    EXPECT_EQ((std::vector<u32>{0, 1, 2, 3, 4}), rendered_values(jobs, true));
+
+    // without workers there is nothing to overlap with
+    JobSystem serial(0);
+    EXPECT_EQ((std::vector<u32>{1, 2, 3, 4, 5}), rendered_values(serial, true));
+}
+
+TEST(FrameLoop, PipelinedSimulationRunsOnAWorker)
+{
+    JobSystem jobs(1);
+    FrameLoop::Settings settings;
+    settings.fixedStep = 0.25;
+    settings.pipelined = true;
+    FrameLoop loop(jobs, settings);
+
+    std::thread::id simulateThread;
+    std::thread::id renderThread;
+    loop.onSimulate([&](f64) { simulateThread = std::this_thread::get_id(); });
+    // a render long enough for the worker to take the simulation before the
+    // main thread starts helping with the queue
+    loop.onRender([&](f64) {
+        renderThread = std::this_thread::get_id();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+
+    loop.advance(0.25);
+    EXPECT_EQ(std::this_thread::get_id(), renderThread);
+    EXPECT_NE(std::this_thread::get_id(), simulateThread);
+}
+
+TEST(FrameLoop, RunStopsWhenInputDeclines)
+{
+    JobSystem jobs(1);
+    FrameLoop loop(jobs, FrameLoop::Settings());
+
+    u32 polls = 0;
+    loop.onInput([&]() { return ++polls < 3; });
+    loop.run();
+    EXPECT_EQ(3U, loop.frameCount());
+}
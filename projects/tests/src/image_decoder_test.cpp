@@ -0,0 +1,394 @@
+#include <helios/core/job_system.hpp>
+#include <helios/io/file.hpp>
+#include <helios/io/image_decoder.hpp>
+
+#include <gtest/gtest.h>
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    u32 png_crc(const u8* bytes, const size_t size)
+    {
+        u32 crc = ~0u;
+        for (size_t i = 0; i < size; i++)
+        {
+            crc ^= bytes[i];
+            for (u32 bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+            }
+        }
+        return ~crc;
+    }
+
+    void append_be32(std::vector<u8>& bytes, const u32 value)
+    {
+        bytes.push_back(static_cast<u8>(value >> 24));
+        bytes.push_back(static_cast<u8>(value >> 16));
+        bytes.push_back(static_cast<u8>(value >> 8));
+        bytes.push_back(static_cast<u8>(value));
+    }
+
+    void append_chunk(std::vector<u8>& png, const char* type,
+                      const std::vector<u8>& data)
+    {
+        append_be32(png, static_cast<u32>(data.size()));
+        const size_t start = png.size();
+        png.insert(png.end(), type, type + 4);
+        png.insert(png.end(), data.begin(), data.end());
+        append_be32(png, png_crc(png.data() + start, png.size() - start));
+    }
+
+    u8 paeth(const i32 a, const i32 b, const i32 c)
+    {
+        const i32 p = a + b - c;
+        const i32 pa = std::abs(p - a);
+        const i32 pb = std::abs(p - b);
+        const i32 pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc)
+        {
+            return static_cast<u8>(a);
+        }
+        return static_cast<u8>(pb <= pc ? b : c);
+    }
+
+    struct TestPng
+    {
+        u32 width;
+        u32 height;
+        u32 depth;
+        u32 colorType;
+        std::vector<u8> palette;
+        std::vector<u8> transparency;
+    };
+
+    // Encodes random samples as a PNG, row y filtered with filter y % 5 and
+    // the image data stored uncompressed over several IDAT chunks.
+    std::vector<u8> make_test_png(const TestPng& image, const u32 seed)
+    {
+        const u32 channels = image.colorType == 2   ? 3
+                             : image.colorType == 4 ? 2
+                             : image.colorType == 6 ? 4
+                                                    : 1;
+        const u32 bitsPerPixel = channels * image.depth;
+        const size_t rowSize = (image.width * bitsPerPixel + 7) / 8;
+        const size_t bpp = bitsPerPixel >= 8 ? bitsPerPixel / 8 : 1;
+
+        u32 state = seed;
+        std::vector<u8> raw(rowSize * image.height);
+        for (u8& value : raw)
+        {
+            state = state * 1664525u + 1013904223u;
+            value = static_cast<u8>(state >> 24);
+        }
+        if (image.colorType == 3)
+        {
+            // keep the indices inside the palette
+            const u32 entries = static_cast<u32>(image.palette.size() / 3);
+            const u32 perByte = 8 / image.depth;
+            for (u8& value : raw)
+            {
+                u8 packed = 0;
+                for (u32 i = 0; i < perByte; i++)
+                {
+                    const u32 index =
+                        ((value >> (i * image.depth)) & ((1u << image.depth) - 1)) %
+                        entries;
+                    packed = static_cast<u8>(packed | (index << (i * image.depth)));
+                }
+                value = packed;
+            }
+        }
+
+        std::vector<u8> filtered;
+        std::vector<u8> zeros(rowSize, 0);
+        for (u32 y = 0; y < image.height; y++)
+        {
+            const u8* row = raw.data() + y * rowSize;
+            const u8* prior = y > 0 ? row - rowSize : zeros.data();
+            const u32 filter = y % 5;
+            filtered.push_back(static_cast<u8>(filter));
+            for (size_t i = 0; i < rowSize; i++)
+            {
+                const i32 a = i >= bpp ? row[i - bpp] : 0;
+                const i32 b = prior[i];
+                const i32 c = i >= bpp ? prior[i - bpp] : 0;
+                const i32 predictor = filter == 1   ? a
+                                      : filter == 2 ? b
+                                      : filter == 3 ? (a + b) / 2
+                                      : filter == 4 ? paeth(a, b, c)
+                                                    : 0;
+                filtered.push_back(static_cast<u8>(row[i] - predictor));
+            }
+        }
+
+        std::vector<u8> stream = {0x78, 0x01};
+        size_t offset = 0;
+        do
+        {
+            const size_t size = std::min<size_t>(1000, filtered.size() - offset);
+            stream.push_back(offset + size == filtered.size() ? 1 : 0);
+            stream.push_back(static_cast<u8>(size));
+            stream.push_back(static_cast<u8>(size >> 8));
+            stream.push_back(static_cast<u8>(~size));
+            stream.push_back(static_cast<u8>(~size >> 8));
+            stream.insert(stream.end(), filtered.begin() + offset,
+                          filtered.begin() + offset + size);
+            offset += size;
+        } while (offset < filtered.size());
+        u32 a = 1;
+        u32 b = 0;
+        for (const u8 value : filtered)
+        {
+            a = (a + value) % 65521;
+            b = (b + a) % 65521;
+        }
+        append_be32(stream, (b << 16) | a);
+
+        std::vector<u8> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        std::vector<u8> header;
+        append_be32(header, image.width);
+        append_be32(header, image.height);
+        header.push_back(static_cast<u8>(image.depth));
+        header.push_back(static_cast<u8>(image.colorType));
+        header.push_back(0);
+        header.push_back(0);
+        header.push_back(0);
+        append_chunk(png, "IHDR", header);
+        if (!image.palette.empty())
+        {
+            append_chunk(png, "PLTE", image.palette);
+        }
+        if (!image.transparency.empty())
+        {
+            append_chunk(png, "tRNS", image.transparency);
+        }
+        for (size_t chunk = 0; chunk < stream.size(); chunk += 777)
+        {
+            const size_t end = std::min<size_t>(chunk + 777, stream.size());
+            append_chunk(png, "IDAT",
+                         std::vector<u8>(stream.begin() + chunk,
+                                         stream.begin() + end));
+        }
+        append_chunk(png, "IEND", {});
+        return png;
+    }
+
+    // stb_image's RGBA8 decode of the same bytes, empty when it fails
+    std::vector<u8> decode_with_stb_image(const std::vector<u8>& bytes)
+    {
+        i32 width;
+        i32 height;
+        i32 channels;
+        stbi_uc* pixels =
+            stbi_load_from_memory(bytes.data(), static_cast<i32>(bytes.size()),
+                                  &width, &height, &channels, STBI_rgb_alpha);
+        if (pixels == nullptr)
+        {
+            return std::vector<u8>();
+        }
+        std::vector<u8> result(pixels, pixels + static_cast<size_t>(width) * height * 4);
+        stbi_image_free(pixels);
+        return result;
+    }
+
+    void expect_matches_stb_image(const std::vector<u8>& bytes)
+    {
+        ImageInfo info;
+        ASSERT_TRUE(readImageInfo(span<const u8>(bytes.data(), bytes.size()), info));
+        const std::vector<u8> expected = decode_with_stb_image(bytes);
+        ASSERT_EQ(static_cast<size_t>(info.width) * info.height * 4, expected.size());
+
+        std::vector<u8> pixels(expected.size());
+        ASSERT_TRUE(decodeImage(span<const u8>(bytes.data(), bytes.size()),
+                                pixels.data()));
+        EXPECT_EQ(expected, pixels);
+    }
+
+    std::vector<u8> make_palette(const u32 entries)
+    {
+        std::vector<u8> palette;
+        for (u32 i = 0; i < entries; i++)
+        {
+            palette.push_back(static_cast<u8>(i * 37));
+            palette.push_back(static_cast<u8>(255 - i * 11));
+            palette.push_back(static_cast<u8>(i * 101));
+        }
+        return palette;
+    }
+
+    std::string find_reference_image(const std::string& path)
+    {
+        std::string prefix;
+        for (u32 depth = 0; depth < 5; depth++)
+        {
+            if (std::filesystem::exists(prefix + "assets/" + path))
+            {
+                return prefix + "assets/" + path;
+            }
+            prefix += "../";
+        }
+        return std::string();
+    }
+} // namespace
+
+TEST(ImageDecoder, MatchesStbImageForEveryFilterAndPixelSize)
+{
+    // odd widths leave partial bytes and pixels at the end of rows
+    const TestPng images[] = {
+        {37, 23, 8, 6, {}, {}},  {41, 17, 8, 2, {}, {}},
+        {19, 11, 16, 6, {}, {}}, {23, 13, 16, 2, {}, {}},
+        {29, 15, 8, 4, {}, {}},  {13, 9, 16, 4, {}, {}},
+        {33, 12, 1, 0, {}, {}},  {35, 12, 2, 0, {}, {}},
+        {31, 12, 4, 0, {}, {}},  {27, 12, 8, 0, {}, {}},
+        {21, 12, 16, 0, {}, {}},
+    };
+    for (const TestPng& image : images)
+    {
+        SCOPED_TRACE(std::to_string(image.colorType) + "/" +
+                     std::to_string(image.depth));
+        expect_matches_stb_image(make_test_png(image, image.width * 31 + image.depth));
+    }
+}
+
+TEST(ImageDecoder, ExpandsPalettesAndTransparency)
+{
+    for (const u32 depth : {1u, 2u, 4u, 8u})
+    {
+        SCOPED_TRACE(depth);
+        // palettes shorter than the index range, samples wrap into them
+        const u32 entries = depth == 8 ? 200 : std::max(2u, (1u << depth) - 1);
+        const std::vector<u8> alpha = {0, 128};
+        expect_matches_stb_image(
+            make_test_png({29, 14, depth, 3, make_palette(entries), alpha}, depth));
+    }
+
+    // a grey and an RGB colour key
+    expect_matches_stb_image(make_test_png({16, 16, 2, 0, {}, {0, 1}}, 5));
+    expect_matches_stb_image(make_test_png({16, 16, 8, 2, {}, {0, 12, 0, 34, 0, 56}}, 6));
+}
+
+TEST(ImageDecoder, FlipsVertically)
+{
+    const std::vector<u8> png = make_test_png({17, 9, 8, 6, {}, {}}, 3);
+    const span<const u8> bytes(png.data(), png.size());
+    std::vector<u8> upright(17 * 9 * 4);
+    std::vector<u8> flipped(upright.size());
+    ASSERT_TRUE(decodeImage(bytes, upright.data()));
+    ASSERT_TRUE(decodeImage(bytes, flipped.data(), true));
+
+    for (u32 y = 0; y < 9; y++)
+    {
+        EXPECT_EQ(0, memcmp(upright.data() + y * 17 * 4,
+                            flipped.data() + (8 - y) * 17 * 4, 17 * 4));
+    }
+}
+
+TEST(ImageDecoder, RejectsBrokenImages)
+{
+    std::vector<u8> png = make_test_png({17, 9, 8, 6, {}, {}}, 4);
+    std::vector<u8> pixels(17 * 9 * 4);
+
+    // cut inside the image data
+    std::vector<u8> truncated(png.begin(), png.begin() + png.size() / 2);
+    EXPECT_FALSE(decodeImage(span<const u8>(truncated.data(), truncated.size()),
+                             pixels.data()));
+
+    // an unknown colour type in the header
+    png[25] = 5;
+    EXPECT_FALSE(decodeImage(span<const u8>(png.data(), png.size()), pixels.data()));
+
+    const u8 garbage[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    ImageInfo info;
+    EXPECT_FALSE(readImageInfo(span<const u8>(garbage, sizeof(garbage)), info));
+}
+
+TEST(ImageDecoder, DecodesABatchIntoOneBlock)
+{
+    std::vector<std::vector<u8>> pngs;
+    for (u32 i = 0; i < 6; i++)
+    {
+        pngs.push_back(make_test_png({13 + i * 7, 5 + i, 8, i % 2 == 0 ? 6u : 2u, {}, {}}, i));
+    }
+    const u8 garbage[] = {1, 2, 3, 4};
+
+    JobSystem jobs(3);
+    ImageDecoder decoder(&jobs);
+    for (const std::vector<u8>& png : pngs)
+    {
+        decoder.add(span<const u8>(png.data(), png.size()), true);
+    }
+    const u32 broken = decoder.add(span<const u8>(garbage, sizeof(garbage)));
+
+    ASSERT_EQ(7U, decoder.imageCount());
+    EXPECT_FALSE(decoder.valid(broken));
+    EXPECT_EQ(0U, decoder.info(broken).width);
+
+    u64 end = 0;
+    for (u32 i = 0; i < 6; i++)
+    {
+        EXPECT_TRUE(decoder.valid(i));
+        EXPECT_EQ(0U, decoder.offset(i) % ImageDecoder::image_alignment);
+        EXPECT_GE(decoder.offset(i), end);
+        end = decoder.offset(i) + u64(decoder.info(i).width) * decoder.info(i).height * 4;
+    }
+    EXPECT_EQ(end, decoder.size());
+
+    std::vector<u8> block(decoder.size());
+    // one image is broken, the rest still decode
+    EXPECT_FALSE(decoder.decode(block.data()));
+    EXPECT_FALSE(decoder.decoded(broken));
+    for (u32 i = 0; i < 6; i++)
+    {
+        ASSERT_TRUE(decoder.decoded(i));
+        std::vector<u8> expected(u64(decoder.info(i).width) * decoder.info(i).height * 4);
+        ASSERT_TRUE(decodeImage(span<const u8>(pngs[i].data(), pngs[i].size()),
+                                expected.data(), true));
+        EXPECT_EQ(0, memcmp(expected.data(), block.data() + decoder.offset(i),
+                            expected.size()));
+    }
+
+    decoder.clear();
+    EXPECT_EQ(0U, decoder.imageCount());
+    EXPECT_EQ(0U, decoder.size());
+}
+
+TEST(ImageDecoder, MatchesStbImageOnTheAssets)
+{
+    const std::string paths[] = {
+        "textures/dragon.png",
+        "models/cube/Cube_BaseColor.png",
+        "models/cube/Cube_MetallicRoughness.png",
+        "models/barramundi/BarramundiFish_normal.png",
+    };
+
+    u32 found = 0;
+    for (const std::string& path : paths)
+    {
+        const std::string file = find_reference_image(path);
+        if (file.empty())
+        {
+            continue;
+        }
+        SCOPED_TRACE(path);
+        found++;
+        const MappedFile mapped(file);
+        ASSERT_TRUE(mapped.valid());
+        const span<const u8> bytes = mapped.bytes();
+        expect_matches_stb_image(std::vector<u8>(bytes.data(), bytes.data() + bytes.size()));
+    }
+
+    if (found == 0)
+    {
+        GTEST_SKIP() << "assets not found from the working directory";
+    }
+}
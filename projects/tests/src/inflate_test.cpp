@@ -0,0 +1,161 @@
+#include <helios/io/inflate.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // "abcabcabcabc helios helios helios" compressed with fixed codes
+    const u8 fixed_stream[] = {
+        0x78, 0xDA, 0x4B, 0x4C, 0x4A, 0x4E, 0x84, 0x21, 0x85, 0x8C, 0xD4,
+        0x9C, 0xCC, 0xFC, 0x62, 0x54, 0x0A, 0x00, 0xD2, 0x70, 0x0C, 0x85,
+    };
+
+    // inflate_test_text() compressed with dynamic codes, with a full flush
+    // half way that splits it into two blocks around an empty stored block
+    const u8 dynamic_stream[] = {
+        0x78, 0xDA, 0xEC, 0xD4, 0xB1, 0x0D, 0xC3, 0x30, 0x0C, 0x44, 0xD1, 0x3E,
+        0x53, 0x70, 0x84, 0xF0, 0x18, 0x3B, 0xCE, 0x38, 0x29, 0x64, 0xD8, 0x80,
+        0x60, 0x17, 0xD6, 0xFE, 0x08, 0x3C, 0x00, 0x7F, 0x1F, 0x80, 0xF5, 0xAF,
+        0xF4, 0x40, 0x5D, 0xDF, 0x8F, 0x66, 0x4F, 0x3B, 0x57, 0x1B, 0x5B, 0xB3,
+        0xFD, 0x58, 0xFB, 0x77, 0x34, 0x1B, 0xED, 0x1A, 0x8F, 0x7E, 0x27, 0xCF,
+        0x93, 0xF2, 0x14, 0x79, 0x7A, 0xE5, 0x69, 0xCA, 0xD3, 0x9C, 0xA7, 0x77,
+        0x9E, 0x96, 0x3C, 0x7D, 0xE0, 0xC9, 0xC4, 0x01, 0x1E, 0x0E, 0x20, 0x0E,
+        0x22, 0x0E, 0x24, 0x0E, 0x26, 0x0E, 0x28, 0x0E, 0x2A, 0x0E, 0x2C, 0x0E,
+        0x2E, 0x02, 0x17, 0xD1, 0x9D, 0x80, 0x8B, 0xC0, 0x45, 0xE0, 0x22, 0x70,
+        0x11, 0xB8, 0x08, 0x5C, 0x04, 0x2E, 0x02, 0x97, 0x00, 0x97, 0x00, 0x97,
+        0xA0, 0x0F, 0x04, 0x2E, 0x01, 0x2E, 0x01, 0x2E, 0x01, 0x2E, 0xB5, 0x00,
+        0xB5, 0x00, 0xB5, 0x00, 0xB5, 0x00, 0xB5, 0x00, 0xB5, 0x00, 0x7F, 0xBE,
+        0x00, 0x3F, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xED, 0x94, 0x3B, 0x0A, 0x80,
+        0x40, 0x0C, 0x05, 0x7B, 0x4F, 0x91, 0x23, 0xF8, 0xB2, 0x7E, 0x8F, 0x63,
+        0xB1, 0xA2, 0xB0, 0x68, 0xE1, 0xDE, 0x1F, 0xC1, 0x7E, 0xA7, 0x17, 0x52,
+        0x4F, 0x93, 0x4C, 0xC2, 0x94, 0xF3, 0xCA, 0xE6, 0x93, 0xDD, 0xBB, 0xD5,
+        0x23, 0xDB, 0x79, 0xED, 0x65, 0xAB, 0xD9, 0x6A, 0x7E, 0x6A, 0x57, 0x3E,
+        0x36, 0x03, 0x5B, 0x80, 0xAD, 0x6D, 0x96, 0x7A, 0x60, 0x02, 0xE6, 0xC0,
+        0x12, 0xB0, 0x01, 0xD8, 0x08, 0x0C, 0xBC, 0xC0, 0x0A, 0xB0, 0x01, 0x2D,
+        0xD0, 0x46, 0x30, 0x3E, 0x4C, 0x0F, 0xC3, 0xC3, 0x4D, 0xE1, 0xA4, 0x70,
+        0x51, 0x91, 0x0E, 0xF0, 0x21, 0x10, 0x22, 0x30, 0x22, 0x50, 0x22, 0x70,
+        0x22, 0x90, 0x22, 0xB0, 0x22, 0xD0, 0x22, 0xF0, 0xE2, 0xE0, 0xC5, 0xE9,
+        0x4F, 0xC0, 0x8B, 0x83, 0x17, 0x07, 0x2F, 0x0E, 0x5E, 0xA2, 0x00, 0x51,
+        0x80, 0x28, 0x40, 0x14, 0x20, 0x0A, 0x10, 0x05, 0xF8, 0x79, 0x01, 0x5E,
+        0xCA, 0xEA, 0x55, 0x09,
+    };
+
+    std::string inflate_test_text()
+    {
+        std::string text;
+        char line[64];
+        for (u32 i = 0; i < 200; i++)
+        {
+            snprintf(line, sizeof(line), "line %u of the inflate test\n",
+                     i % 37);
+            text += line;
+        }
+        return text;
+    }
+
+    // Wraps data in stored blocks of at most blockSize bytes, no zlib header
+    std::vector<u8> make_stored_stream(const std::vector<u8>& data,
+                                       const size_t blockSize)
+    {
+        std::vector<u8> stream;
+        size_t offset = 0;
+        do
+        {
+            const size_t size = std::min(blockSize, data.size() - offset);
+            const bool last = offset + size == data.size();
+            stream.push_back(last ? 1 : 0);
+            stream.push_back(static_cast<u8>(size));
+            stream.push_back(static_cast<u8>(size >> 8));
+            stream.push_back(static_cast<u8>(~size));
+            stream.push_back(static_cast<u8>(~size >> 8));
+            stream.insert(stream.end(), data.begin() + offset,
+                          data.begin() + offset + size);
+            offset += size;
+        } while (offset < data.size());
+        return stream;
+    }
+} // namespace
+
+TEST(Inflate, DecodesFixedCodes)
+{
+    const std::string expected = "abcabcabcabc helios helios helios";
+    std::vector<u8> output(expected.size());
+    const size_t written = inflateZlib(
+        span<const u8>(fixed_stream, sizeof(fixed_stream)), output.data(),
+        output.size());
+
+    ASSERT_EQ(expected.size(), written);
+    EXPECT_EQ(expected, std::string(output.begin(), output.end()));
+}
+
+TEST(Inflate, DecodesDynamicCodesAcrossBlocks)
+{
+    const std::string expected = inflate_test_text();
+    std::vector<u8> output(expected.size() + 64);
+    const size_t written = inflateZlib(
+        span<const u8>(dynamic_stream, sizeof(dynamic_stream)), output.data(),
+        output.size());
+
+    ASSERT_EQ(expected.size(), written);
+    EXPECT_EQ(expected, std::string(output.begin(), output.begin() + written));
+}
+
+TEST(Inflate, DecodesStoredBlocks)
+{
+    std::vector<u8> data(70000);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<u8>((i * 7) ^ (i >> 8));
+    }
+    const std::vector<u8> stream = make_stored_stream(data, 65535);
+
+    std::vector<u8> output(data.size());
+    const size_t written = inflate(span<const u8>(stream.data(), stream.size()),
+                                   output.data(), output.size());
+
+    ASSERT_EQ(data.size(), written);
+    EXPECT_EQ(data, output);
+}
+
+TEST(Inflate, RejectsOutputThatDoesNotFit)
+{
+    const std::string expected = inflate_test_text();
+    std::vector<u8> output(expected.size() - 1);
+    EXPECT_EQ(inflate_error,
+              inflateZlib(span<const u8>(dynamic_stream, sizeof(dynamic_stream)),
+                          output.data(), output.size()));
+}
+
+TEST(Inflate, RejectsTruncatedAndMalformedStreams)
+{
+    std::vector<u8> output(8192);
+    for (const size_t size : {size_t(0), size_t(2), size_t(40), size_t(200)})
+    {
+        EXPECT_EQ(inflate_error,
+                  inflateZlib(span<const u8>(dynamic_stream, size),
+                              output.data(), output.size()))
+            << size;
+    }
+
+    // block type 3 is reserved
+    const u8 reserved[] = {0x07, 0x00};
+    EXPECT_EQ(inflate_error, inflate(span<const u8>(reserved, sizeof(reserved)),
+                                     output.data(), output.size()));
+
+    // the stored length does not match its complement
+    const u8 stored[] = {0x01, 0x04, 0x00, 0x00, 0x00, 1, 2, 3, 4};
+    EXPECT_EQ(inflate_error, inflate(span<const u8>(stored, sizeof(stored)),
+                                     output.data(), output.size()));
+
+    // not a zlib header
+    const u8 header[] = {0x78, 0x00, 0x03, 0x00};
+    EXPECT_EQ(inflate_error, inflateZlib(span<const u8>(header, sizeof(header)),
+                                         output.data(), output.size()));
+}
@@ -0,0 +1,59 @@
+#include <helios/core/job_system.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace helios;
+
+TEST(JobSystem, ParallelForCoversRangeOnce)
+{
+    JobSystem jobs(3);
+    std::vector<std::atomic<u32>> hits(10000);
+
+    jobs.parallelFor(hits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            hits[i].fetch_add(1);
+        }
+    });
+
+    for (const auto& hit : hits)
+    {
+        EXPECT_EQ(hit.load(), 1u);
+    }
+}
+
+TEST(JobSystem, NestedParallelFor)
+{
+    JobSystem jobs(2);
+    std::atomic<u32> total(0);
+
+    jobs.parallelFor(8, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            jobs.parallelFor(100, 10, [&](size_t b, size_t e) {
+                total.fetch_add(static_cast<u32>(e - b));
+            });
+        }
+    });
+
+    EXPECT_EQ(total.load(), 800u);
+}
+
+TEST(JobSystem, SubmitAndWait)
+{
+    JobSystem jobs(2);
+    std::atomic<u32> count(0);
+    for (u32 i = 0; i < 100; ++i)
+    {
+        jobs.submit([&]() { count.fetch_add(1); });
+    }
+    jobs.wait();
+    EXPECT_EQ(count.load(), 100u);
+
+    JobSystem inline_jobs(0);
+    inline_jobs.submit([&]() { count.fetch_add(1); });
+    EXPECT_EQ(count.load(), 101u);
+}
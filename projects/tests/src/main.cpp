@@ -1,8 +1,33 @@
+#include "application_test.cpp"
+#include "async_file_test.cpp"
+#include "block_compression_test.cpp"
+#include "bounds_test.cpp"
+#include "command_buffer_test.cpp"
+#include "cooked_mesh_test.cpp"
+#include "cooked_texture_test.cpp"
+#include "entity_test.cpp"
+#include "file_test.cpp"
+#include "frame_loop_test.cpp"
+#include "image_decoder_test.cpp"
+#include "inflate_test.cpp"
+#include "job_system_test.cpp"
 #include "linked_list_test.cpp"
 #include "matrix_test.cpp"
+#include "mesh_optimizer_test.cpp"
+#include "mesh_simplifier_test.cpp"
+#include "mesh_test.cpp"
+#include "meshlet_test.cpp"
+#include "packed_test.cpp"
 #include "pool_test.cpp"
 #include "slot_map_test.cpp"
+#include "snapshot_test.cpp"
+#include "span_test.cpp"
+#include "spatial_index_test.cpp"
+#include "system_scheduler_test.cpp"
+#include "transform_batch_test.cpp"
+#include "transform_system_test.cpp"
 #include "transformations_test.cpp"
+#include "vec_test.cpp"
 #include "vector_test.cpp"
 
 #include <gtest/gtest.h>
@@ -0,0 +1,262 @@
+#include <helios/core/job_system.hpp>
+#include <helios/core/mesh_optimizer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // A side x side grid of quads in the xz plane with a little height so
+    // triangle normals differ. Unshared grids give every quad its own four
+    // corners, as exporters do for flat shaded meshes.
+    void fill_optimizer_grid(Mesh& mesh, const u32 side, const bool shared)
+    {
+        const auto height = [](const u32 x, const u32 y) {
+            return 0.1f * f32((x * 7 + y * 3) % 5);
+        };
+
+        const u32 corners = side + 1;
+        if (shared)
+        {
+            for (u32 y = 0; y < corners; y++)
+            {
+                for (u32 x = 0; x < corners; x++)
+                {
+                    mesh.positions.push_back(
+                        Vector3f(f32(x), height(x, y), f32(y)));
+                    mesh.uvs.push_back(Vector2f(f32(x), f32(y)));
+                }
+            }
+        }
+
+        mesh.triangles.reserve(side * side * 6);
+        for (u32 y = 0; y < side; y++)
+        {
+            for (u32 x = 0; x < side; x++)
+            {
+                u32 quad[4];
+                for (u32 corner = 0; corner < 4; corner++)
+                {
+                    const u32 cx = x + (corner & 1);
+                    const u32 cy = y + (corner >> 1);
+                    if (shared)
+                    {
+                        quad[corner] = cy * corners + cx;
+                    }
+                    else
+                    {
+                        quad[corner] = static_cast<u32>(mesh.positions.size());
+                        mesh.positions.push_back(
+                            Vector3f(f32(cx), height(cx, cy), f32(cy)));
+                        mesh.uvs.push_back(Vector2f(f32(cx), f32(cy)));
+                    }
+                }
+                for (const u32 corner : {0, 2, 1, 1, 2, 3})
+                {
+                    mesh.triangles.push_back(quad[corner]);
+                }
+            }
+        }
+        mesh.calculateBounds();
+    }
+
+    // deterministic Fisher-Yates over whole triangles
+    void shuffle_optimizer_triangles(Mesh& mesh)
+    {
+        u32 state = 12345;
+        const size_t triangles = mesh.triangles.size() / 3;
+        for (size_t i = triangles - 1; i > 0; i--)
+        {
+            state = state * 1664525u + 1013904223u;
+            const size_t j = (state >> 8) % (i + 1);
+            for (size_t corner = 0; corner < 3; corner++)
+            {
+                std::swap(mesh.triangles[i * 3 + corner],
+                          mesh.triangles[j * 3 + corner]);
+            }
+        }
+    }
+
+    VertexCacheStatistics optimizer_statistics(const Mesh& mesh)
+    {
+        return analyzeVertexCache(
+            span<const u32>(mesh.triangles.data(), mesh.triangles.size()),
+            static_cast<u32>(mesh.positions.size()));
+    }
+
+    void record_optimizer_stage(const std::string& stage,
+                                const VertexCacheStatistics& statistics)
+    {
+        ::testing::Test::RecordProperty(stage + "_acmr",
+                                        std::to_string(statistics.acmr));
+        ::testing::Test::RecordProperty(stage + "_atvr",
+                                        std::to_string(statistics.atvr));
+    }
+
+    // every triangle as its corner positions, rotated to start at the
+    // smallest so the winding is kept but the first corner does not matter
+    using OptimizerTriangle = std::array<f32, 9>;
+
+    std::vector<OptimizerTriangle> optimizer_triangles(const Mesh& mesh)
+    {
+        std::vector<OptimizerTriangle> triangles;
+        for (size_t t = 0; t < mesh.triangles.size(); t += 3)
+        {
+            std::array<OptimizerTriangle, 3> rotations;
+            for (u32 r = 0; r < 3; r++)
+            {
+                for (u32 corner = 0; corner < 3; corner++)
+                {
+                    const Vector3f& p =
+                        mesh.positions[mesh.triangles[t + (corner + r) % 3]];
+                    rotations[r][corner * 3 + 0] = p.x;
+                    rotations[r][corner * 3 + 1] = p.y;
+                    rotations[r][corner * 3 + 2] = p.z;
+                }
+            }
+            triangles.push_back(
+                *std::min_element(rotations.begin(), rotations.end()));
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+} // namespace
+
+TEST(MeshOptimizer, AnalyzesAFifoCache)
+{
+    const u32 quad[6] = {0, 1, 2, 0, 2, 3};
+    const VertexCacheStatistics statistics =
+        analyzeVertexCache(span<const u32>(quad, 6), 4);
+    EXPECT_EQ(4U, statistics.vertexTransforms);
+    EXPECT_EQ(2.0f, statistics.acmr);
+    EXPECT_EQ(1.0f, statistics.atvr);
+
+    // the first triangle is evicted by the time it is drawn again
+    const u32 evicted[9] = {0, 1, 2, 3, 4, 5, 0, 1, 2};
+    EXPECT_EQ(9U, analyzeVertexCache(span<const u32>(evicted, 9), 6, 3)
+                      .vertexTransforms);
+    EXPECT_EQ(6U, analyzeVertexCache(span<const u32>(evicted, 9), 6, 6)
+                      .vertexTransforms);
+}
+
+TEST(MeshOptimizer, DeduplicatesSharedCorners)
+{
+    Mesh mesh;
+    fill_optimizer_grid(mesh, 8, false);
+    const std::vector<OptimizerTriangle> before = optimizer_triangles(mesh);
+    ASSERT_EQ(256U, mesh.positions.size());
+
+    EXPECT_EQ(81U, deduplicateVertices(mesh));
+    EXPECT_EQ(81U, mesh.positions.size());
+    EXPECT_EQ(81U, mesh.uvs.size());
+    EXPECT_EQ(before, optimizer_triangles(mesh));
+
+    // corners with a different uv stay apart
+    Mesh seams;
+    fill_optimizer_grid(seams, 2, false);
+    seams.uvs[3] = Vector2f(0.5f, 0.5f);
+    EXPECT_EQ(10U, deduplicateVertices(seams));
+}
+
+// Runs the stages one by one on a shuffled grid, recording ACMR and ATVR
+// after each in the test report.
+TEST(MeshOptimizer, EveryStageKeepsOrImprovesCacheReuse)
+{
+    Mesh mesh;
+    fill_optimizer_grid(mesh, 32, false);
+    shuffle_optimizer_triangles(mesh);
+    const std::vector<OptimizerTriangle> before = optimizer_triangles(mesh);
+
+    const VertexCacheStatistics input = optimizer_statistics(mesh);
+    record_optimizer_stage("input", input);
+
+    deduplicateVertices(mesh);
+    const VertexCacheStatistics deduplicated = optimizer_statistics(mesh);
+    record_optimizer_stage("deduplicated", deduplicated);
+    EXPECT_LT(deduplicated.acmr, input.acmr);
+
+    const u32 vertexCount = static_cast<u32>(mesh.positions.size());
+    const span<u32> indices(mesh.triangles.data(), mesh.triangles.size());
+    optimizeVertexCache(indices, vertexCount);
+    const VertexCacheStatistics cached = optimizer_statistics(mesh);
+    record_optimizer_stage("vertex_cache", cached);
+    EXPECT_LT(cached.acmr, 0.8f);
+    EXPECT_LT(cached.atvr, 1.5f);
+    EXPECT_LT(cached.acmr, deduplicated.acmr * 0.5f);
+
+    optimizeOverdraw(indices, span<const Vector3f>(mesh.positions.data(),
+                                                   mesh.positions.size()));
+    const VertexCacheStatistics overdraw = optimizer_statistics(mesh);
+    record_optimizer_stage("overdraw", overdraw);
+    EXPECT_LE(overdraw.acmr, cached.acmr * default_overdraw_threshold + 0.05f);
+
+    // renumbering does not change which vertices hit the cache
+    optimizeVertexFetch(mesh);
+    const VertexCacheStatistics fetch = optimizer_statistics(mesh);
+    record_optimizer_stage("vertex_fetch", fetch);
+    EXPECT_EQ(overdraw.vertexTransforms, fetch.vertexTransforms);
+
+    EXPECT_EQ(before, optimizer_triangles(mesh));
+}
+
+TEST(MeshOptimizer, VertexFetchFollowsFirstUse)
+{
+    Mesh mesh;
+    fill_optimizer_grid(mesh, 4, true);
+    shuffle_optimizer_triangles(mesh);
+    // an unreferenced vertex is dropped
+    mesh.positions.push_back(Vector3f(100, 100, 100));
+    mesh.uvs.push_back(Vector2f(0, 0));
+    const std::vector<OptimizerTriangle> before = optimizer_triangles(mesh);
+
+    EXPECT_EQ(25U, optimizeVertexFetch(mesh));
+    EXPECT_EQ(25U, mesh.positions.size());
+
+    u32 next = 0;
+    for (const u32 index : mesh.triangles)
+    {
+        EXPECT_LE(index, next);
+        if (index == next)
+        {
+            next++;
+        }
+    }
+    EXPECT_EQ(before, optimizer_triangles(mesh));
+}
+
+TEST(MeshOptimizer, OptimizesAndRebuildsSubMeshes)
+{
+    Mesh mesh;
+    for (u32 i = 0; i < 4; i++)
+    {
+        Mesh* subMesh = new Mesh();
+        fill_optimizer_grid(*subMesh, 16, false);
+        shuffle_optimizer_triangles(*subMesh);
+        subMesh->build(EVertexFormat::PACKED);
+        mesh.subMeshes.push_back(subMesh);
+    }
+    mesh.calculateBounds();
+    const std::vector<OptimizerTriangle> before =
+        optimizer_triangles(*mesh.subMeshes[2]);
+
+    JobSystem jobs(3);
+    optimizeMesh(mesh, &jobs);
+
+    for (const Mesh* subMesh : mesh.subMeshes)
+    {
+        EXPECT_EQ(289U, subMesh->positions.size());
+        EXPECT_LT(optimizer_statistics(*subMesh).acmr, 0.8f);
+        ASSERT_EQ(2U, subMesh->bufferCount());
+        EXPECT_EQ(EVertexFormat::PACKED, subMesh->vertexFormat());
+        EXPECT_EQ(289 * sizeof(PackedVertexNoPosition),
+                  subMesh->bufferSize(1));
+    }
+    EXPECT_EQ(before, optimizer_triangles(*mesh.subMeshes[2]));
+    EXPECT_EQ(16.0f, mesh.bounds.max.x);
+}
@@ -0,0 +1,301 @@
+#include <helios/core/job_system.hpp>
+#include <helios/core/mesh_simplifier.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // side x side quads over [0, side] in xz with the height given by
+    // bump. With a seam column, the quads right of it use their own copies
+    // of the vertices on that column, as a uv seam would.
+    template <typename Bump>
+    void fill_simplifier_grid(Mesh& mesh, const u32 side, Bump&& bump,
+                              const u32 seamColumn = 0)
+    {
+        const u32 corners = side + 1;
+        for (u32 y = 0; y < corners; y++)
+        {
+            for (u32 x = 0; x < corners; x++)
+            {
+                mesh.positions.push_back(
+                    Vector3f(f32(x), bump(f32(x), f32(y)), f32(y)));
+                mesh.uvs.push_back(Vector2f(f32(x), f32(y)));
+            }
+        }
+        const u32 seamStart = static_cast<u32>(mesh.positions.size());
+        if (seamColumn > 0)
+        {
+            for (u32 y = 0; y < corners; y++)
+            {
+                // copied first, push_back may move the storage it points into
+                const Vector3f position = mesh.positions[y * corners + seamColumn];
+                mesh.positions.push_back(position);
+                mesh.uvs.push_back(Vector2f(100.0f, f32(y)));
+            }
+        }
+
+        for (u32 y = 0; y < side; y++)
+        {
+            for (u32 x = 0; x < side; x++)
+            {
+                u32 quad[4];
+                for (u32 corner = 0; corner < 4; corner++)
+                {
+                    const u32 cx = x + (corner & 1);
+                    const u32 cy = y + (corner >> 1);
+                    quad[corner] = seamColumn > 0 && x >= seamColumn &&
+                                           cx == seamColumn
+                                       ? seamStart + cy
+                                       : cy * corners + cx;
+                }
+                for (const u32 corner : {0, 2, 1, 1, 2, 3})
+                {
+                    mesh.triangles.push_back(quad[corner]);
+                }
+            }
+        }
+        mesh.calculateBounds();
+    }
+
+    f32 flat_simplifier_grid(const f32, const f32)
+    {
+        return 0.0f;
+    }
+
+    f32 bumpy_simplifier_grid(const f32 x, const f32 z)
+    {
+        return 1.5f * std::sin(x * 0.4f) * std::cos(z * 0.3f);
+    }
+
+    f32 simplified_area(const vector<u32>& indices, const Mesh& mesh)
+    {
+        f32 area = 0.0f;
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            const Vector3f& p0 = mesh.positions[indices[t + 0]];
+            const Vector3f& p1 = mesh.positions[indices[t + 1]];
+            const Vector3f& p2 = mesh.positions[indices[t + 2]];
+            area += 0.5f * (p1 - p0).cross(p2 - p0).length();
+        }
+        return area;
+    }
+
+    // Largest vertical distance between the original grid vertices and the
+    // simplified heightfield.
+    f32 simplified_deviation(const vector<u32>& indices, const Mesh& mesh,
+                             const u32 side)
+    {
+        f32 deviation = 0.0f;
+        for (u32 i = 0; i < (side + 1) * (side + 1); i++)
+        {
+            const Vector3f& p = mesh.positions[i];
+            for (size_t t = 0; t < indices.size(); t += 3)
+            {
+                const Vector3f& a = mesh.positions[indices[t + 0]];
+                const Vector3f& b = mesh.positions[indices[t + 1]];
+                const Vector3f& c = mesh.positions[indices[t + 2]];
+                const f32 det = (b.z - c.z) * (a.x - c.x) +
+                                (c.x - b.x) * (a.z - c.z);
+                if (std::fabs(det) < 1e-8f)
+                {
+                    continue;
+                }
+                const f32 u =
+                    ((b.z - c.z) * (p.x - c.x) + (c.x - b.x) * (p.z - c.z)) /
+                    det;
+                const f32 v =
+                    ((c.z - a.z) * (p.x - c.x) + (a.x - c.x) * (p.z - c.z)) /
+                    det;
+                const f32 w = 1.0f - u - v;
+                if (u < -1e-4f || v < -1e-4f || w < -1e-4f)
+                {
+                    continue;
+                }
+                const f32 height = u * a.y + v * b.y + w * c.y;
+                deviation = std::max(deviation, std::fabs(height - p.y));
+                break;
+            }
+        }
+        return deviation;
+    }
+
+    // Edges, by position, that only one triangle uses. On an intact grid
+    // these all lie on its outline.
+    std::vector<std::pair<Vector3f, Vector3f>> simplified_open_edges(
+        const vector<u32>& indices, const Mesh& mesh)
+    {
+        const auto key = [](const Vector3f& p) {
+            return std::make_pair(p.x, p.z);
+        };
+        std::multiset<std::pair<std::pair<f32, f32>, std::pair<f32, f32>>>
+            edges;
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            for (u32 e = 0; e < 3; e++)
+            {
+                edges.insert({key(mesh.positions[indices[t + e]]),
+                              key(mesh.positions[indices[t + (e + 1) % 3]])});
+            }
+        }
+
+        std::vector<std::pair<Vector3f, Vector3f>> open;
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            for (u32 e = 0; e < 3; e++)
+            {
+                const Vector3f& a = mesh.positions[indices[t + e]];
+                const Vector3f& b = mesh.positions[indices[t + (e + 1) % 3]];
+                if (edges.count({key(b), key(a)}) == 0)
+                {
+                    open.push_back({a, b});
+                }
+            }
+        }
+        return open;
+    }
+
+    bool on_simplifier_outline(const Vector3f& p, const f32 side)
+    {
+        return p.x == 0.0f || p.z == 0.0f || p.x == side || p.z == side;
+    }
+} // namespace
+
+TEST(MeshSimplifier, FlatGridCollapsesKeepingItsOutline)
+{
+    Mesh mesh;
+    fill_simplifier_grid(mesh, 16, flat_simplifier_grid);
+
+    f32 error = 1.0f;
+    const vector<u32> simplified = simplify(
+        span<const u32>(mesh.triangles.data(), mesh.triangles.size()),
+        span<const Vector3f>(mesh.positions.data(), mesh.positions.size()), 6,
+        1e-4f, &error);
+
+    EXPECT_LE(simplified.size(), 8U * 3U);
+    EXPECT_LE(error, 1e-4f);
+    EXPECT_NEAR(256.0f, simplified_area(simplified, mesh), 1e-2f);
+    for (const auto& edge : simplified_open_edges(simplified, mesh))
+    {
+        EXPECT_TRUE(on_simplifier_outline(edge.first, 16.0f));
+        EXPECT_TRUE(on_simplifier_outline(edge.second, 16.0f));
+    }
+}
+
+TEST(MeshSimplifier, StopsAtTheTargetCountOrError)
+{
+    Mesh mesh;
+    fill_simplifier_grid(mesh, 32, bumpy_simplifier_grid);
+    const span<const u32> indices(mesh.triangles.data(), mesh.triangles.size());
+    const span<const Vector3f> positions(mesh.positions.data(),
+                                         mesh.positions.size());
+
+    // a generous error leaves the count in charge
+    f32 error = 0.0f;
+    const vector<u32> half =
+        simplify(indices, positions, indices.size() / 2, 1.0f, &error);
+    EXPECT_LE(half.size(), indices.size() / 2);
+    EXPECT_GT(half.size(), indices.size() / 4);
+
+    // a tight one stops early, and the surface moved no further than it
+    // allows for
+    const f32 targetError = 0.01f;
+    const vector<u32> bounded =
+        simplify(indices, positions, 0, targetError, &error);
+    EXPECT_LT(bounded.size(), indices.size() / 2);
+    EXPECT_GT(bounded.size(), 0U);
+    EXPECT_LE(error, targetError);
+
+    const f32 extent = 32.0f;
+    RecordProperty("triangles", std::to_string(bounded.size() / 3));
+    RecordProperty("deviation",
+                   std::to_string(simplified_deviation(bounded, mesh, 32)));
+    EXPECT_LE(simplified_deviation(bounded, mesh, 32),
+              4.0f * targetError * extent);
+}
+
+TEST(MeshSimplifier, KeepsSeamsClosed)
+{
+    Mesh mesh;
+    fill_simplifier_grid(mesh, 16, flat_simplifier_grid, 8);
+    const u32 seamStart = 17 * 17;
+
+    const vector<u32> simplified = simplify(
+        span<const u32>(mesh.triangles.data(), mesh.triangles.size()),
+        span<const Vector3f>(mesh.positions.data(), mesh.positions.size()), 0,
+        1e-4f);
+    EXPECT_LT(simplified.size(), mesh.triangles.size() / 8);
+    EXPECT_NEAR(256.0f, simplified_area(simplified, mesh), 1e-2f);
+
+    // no crack opened along the seam
+    for (const auto& edge : simplified_open_edges(simplified, mesh))
+    {
+        EXPECT_TRUE(on_simplifier_outline(edge.first, 16.0f));
+        EXPECT_TRUE(on_simplifier_outline(edge.second, 16.0f));
+    }
+
+    // and each side still uses its own copy of the seam vertices
+    for (size_t t = 0; t < simplified.size(); t += 3)
+    {
+        bool left = false;
+        bool right = false;
+        for (u32 corner = 0; corner < 3; corner++)
+        {
+            const u32 index = simplified[t + corner];
+            const f32 x = mesh.positions[index].x;
+            left |= x < 8.0f || (x == 8.0f && index < seamStart);
+            right |= x > 8.0f || index >= seamStart;
+        }
+        EXPECT_FALSE(left && right);
+    }
+}
+
+TEST(MeshSimplifier, GeneratesLodsAndSelectsThemByScreenSize)
+{
+    Mesh mesh;
+    for (u32 i = 0; i < 3; i++)
+    {
+        Mesh* subMesh = new Mesh();
+        fill_simplifier_grid(*subMesh, 24, bumpy_simplifier_grid, i * 8);
+        mesh.subMeshes.push_back(subMesh);
+    }
+    mesh.calculateBounds();
+
+    JobSystem jobs(2);
+    LodSettings settings;
+    settings.maxError = 0.02f;
+    generateLods(mesh, settings, &jobs);
+
+    for (const Mesh* subMesh : mesh.subMeshes)
+    {
+        ASSERT_GE(subMesh->lodCount(), 3U);
+        for (u32 level = 1; level < subMesh->lodCount(); level++)
+        {
+            EXPECT_LT(subMesh->lodTriangles(level).size(),
+                      subMesh->lodTriangles(level - 1).size());
+            EXPECT_GT(subMesh->lods[level - 1].error, 0.0f);
+            if (level > 1)
+            {
+                EXPECT_GE(subMesh->lods[level - 1].error,
+                          subMesh->lods[level - 2].error);
+            }
+            // each level adds at most maxError of the mesh extent
+            EXPECT_LE(subMesh->lods[level - 1].error,
+                      f32(level) * settings.maxError * 24.0f);
+        }
+
+        // close up the full mesh, far away the coarsest level
+        EXPECT_EQ(0U, subMesh->selectLod(10000.0f));
+        EXPECT_EQ(subMesh->lodCount() - 1, subMesh->selectLod(1.0f));
+        const u32 middle = subMesh->selectLod(
+            1.0f / subMesh->lods[0].error * subMesh->boundingSphere.radius);
+        EXPECT_GE(middle, 1U);
+    }
+}
@@ -0,0 +1,407 @@
+#include <helios/core/job_system.hpp>
+#include <helios/core/mesh.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // Vertex buffer of the test document, interleaved position, normal and
+    // uv so the accessors need the buffer view stride.
+    struct ImportVertex
+    {
+        f32 position[3];
+        f32 normal[3];
+        f32 uv[2];
+    };
+
+    ImportVertex import_vertex(const u32 primitive, const u32 corner)
+    {
+        const f32 x = f32(corner & 1) + f32(primitive) * 2.0f;
+        const f32 z = f32(corner >> 1);
+        return {{x, 0.5f * f32(primitive), z},
+                {0.0f, 1.0f, 0.0f},
+                {f32(corner & 1), f32(corner >> 1)}};
+    }
+
+    template <typename T>
+    void append_import_bytes(std::vector<u8>& out, const T* data,
+                             const size_t count)
+    {
+        const size_t offset = out.size();
+        out.resize(offset + count * sizeof(T));
+        memcpy(out.data() + offset, data, count * sizeof(T));
+    }
+
+    // Wraps a document body (everything after the asset and buffer) and
+    // its binary chunk into a .glb.
+    std::vector<u8> import_glb(std::vector<u8> bin, const std::string& body)
+    {
+        while (bin.size() % 4 != 0)
+        {
+            bin.push_back(0);
+        }
+
+        std::string json = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{"
+                           "\"byteLength\":" +
+                           std::to_string(bin.size()) + "}]," + body + "}";
+        while (json.size() % 4 != 0)
+        {
+            json.push_back(' ');
+        }
+
+        const u32 header[3] = {
+            0x46546C67, 2,
+            static_cast<u32>(12 + 8 + json.size() + 8 + bin.size())};
+        const u32 jsonChunk[2] = {static_cast<u32>(json.size()), 0x4E4F534A};
+        const u32 binChunk[2] = {static_cast<u32>(bin.size()), 0x004E4942};
+
+        std::vector<u8> glb;
+        append_import_bytes(glb, header, 3);
+        append_import_bytes(glb, jsonChunk, 2);
+        append_import_bytes(glb, json.data(), json.size());
+        append_import_bytes(glb, binChunk, 2);
+        append_import_bytes(glb, bin.data(), bin.size());
+        return glb;
+    }
+
+    // A .glb with one quad per primitive, all in one mesh. Primitives
+    // alternate between u8, u16 and u32 indices and every fourth one has
+    // none at all.
+    std::vector<u8> import_test_glb(const u32 primitives)
+    {
+        std::vector<u8> bin;
+        std::string views;
+        std::string accessors;
+        std::string primitiveList;
+
+        long viewCount = 0;
+        const auto view = [&](const size_t offset, const size_t length,
+                              const u32 stride) {
+            if (!views.empty())
+            {
+                views += ",";
+            }
+            views += "{\"buffer\":0,\"byteOffset\":" + std::to_string(offset) +
+                     ",\"byteLength\":" + std::to_string(length);
+            if (stride != 0)
+            {
+                views += ",\"byteStride\":" + std::to_string(stride);
+            }
+            views += "}";
+            return viewCount++;
+        };
+        u32 accessorCount = 0;
+        const auto accessor = [&](const long bufferView, const size_t offset,
+                                  const u32 componentType, const u32 count,
+                                  const char* type) {
+            if (!accessors.empty())
+            {
+                accessors += ",";
+            }
+            accessors += "{\"bufferView\":" + std::to_string(bufferView) +
+                         ",\"byteOffset\":" + std::to_string(offset) +
+                         ",\"componentType\":" +
+                         std::to_string(componentType) +
+                         ",\"count\":" + std::to_string(count) +
+                         ",\"type\":\"" + type + "\"}";
+            return accessorCount++;
+        };
+
+        const u8 quad[6] = {0, 2, 1, 1, 2, 3};
+        for (u32 p = 0; p < primitives; p++)
+        {
+            ImportVertex vertices[4];
+            for (u32 corner = 0; corner < 4; corner++)
+            {
+                vertices[corner] = import_vertex(p, corner);
+            }
+
+            const size_t vertexOffset = bin.size();
+            append_import_bytes(bin, vertices, 4);
+            const long vertexView =
+                view(vertexOffset, sizeof(vertices), sizeof(ImportVertex));
+            const u32 position = accessor(vertexView, 0, 5126, 4, "VEC3");
+            const u32 normal = accessor(vertexView, 12, 5126, 4, "VEC3");
+            const u32 uv = accessor(vertexView, 24, 5126, 4, "VEC2");
+
+            std::string entry = "{\"attributes\":{\"POSITION\":" +
+                                std::to_string(position) +
+                                ",\"NORMAL\":" + std::to_string(normal) +
+                                ",\"TEXCOORD_0\":" + std::to_string(uv) + "}";
+
+            const size_t indexOffset = bin.size();
+            long indexView = -1;
+            u32 componentType = 0;
+            switch (p % 4)
+            {
+            case 0:
+                append_import_bytes(bin, quad, 6);
+                indexView = view(indexOffset, 6, 0);
+                componentType = 5121;
+                break;
+            case 1: {
+                const u16 wide[6] = {0, 2, 1, 1, 2, 3};
+                append_import_bytes(bin, wide, 6);
+                indexView = view(indexOffset, sizeof(wide), 0);
+                componentType = 5123;
+                break;
+            }
+            case 2: {
+                const u32 wide[6] = {0, 2, 1, 1, 2, 3};
+                append_import_bytes(bin, wide, 6);
+                indexView = view(indexOffset, sizeof(wide), 0);
+                componentType = 5125;
+                break;
+            }
+            default:
+                break;
+            }
+            if (indexView >= 0)
+            {
+                entry += ",\"indices\":" +
+                         std::to_string(accessor(indexView, 0, componentType,
+                                                 6, "SCALAR"));
+            }
+            entry += "}";
+
+            if (!primitiveList.empty())
+            {
+                primitiveList += ",";
+            }
+            primitiveList += entry;
+
+            while (bin.size() % 4 != 0)
+            {
+                bin.push_back(0);
+            }
+        }
+
+        return import_glb(bin, "\"bufferViews\":[" + views +
+                                   "],\"accessors\":[" + accessors +
+                                   "],\"meshes\":[{\"primitives\":[" +
+                                   primitiveList + "]}]");
+    }
+
+    // Two primitives. The first stores KHR_mesh_quantization style
+    // attributes: u16 positions interleaved with snorm16 normals, unorm16
+    // uvs and a unorm8 rgb colour padded to four bytes. The second has
+    // float positions with one vertex moved by a sparse accessor and uvs
+    // given only by a sparse accessor.
+    std::vector<u8> quantized_test_glb()
+    {
+        std::vector<u8> bin;
+        for (u32 corner = 0; corner < 4; corner++)
+        {
+            const u16 position[4] = {static_cast<u16>((corner & 1) * 100), 7,
+                                     static_cast<u16>((corner >> 1) * 100), 0};
+            const i16 normal[4] = {static_cast<i16>(corner == 1 ? -32768 : 0),
+                                   static_cast<i16>(corner == 1 ? 0 : 32767),
+                                   0, 0};
+            append_import_bytes(bin, position, 4);
+            append_import_bytes(bin, normal, 4);
+        }
+        for (u32 corner = 0; corner < 4; corner++)
+        {
+            const u16 uv[2] = {static_cast<u16>((corner & 1) * 65535),
+                               static_cast<u16>((corner >> 1) * 32768)};
+            append_import_bytes(bin, uv, 2);
+        }
+        for (u32 corner = 0; corner < 4; corner++)
+        {
+            const u8 color[4] = {255, static_cast<u8>(corner * 51), 0, 0};
+            append_import_bytes(bin, color, 4);
+        }
+        const u16 indices[6] = {0, 2, 1, 1, 2, 3};
+        append_import_bytes(bin, indices, 6);
+
+        for (u32 corner = 0; corner < 4; corner++)
+        {
+            const f32 position[3] = {f32(corner & 1), 0.0f, f32(corner >> 1)};
+            append_import_bytes(bin, position, 3);
+        }
+        const u8 movedVertex[4] = {3, 0, 0, 0};
+        append_import_bytes(bin, movedVertex, 4);
+        const f32 movedPosition[3] = {9.0f, 9.0f, 9.0f};
+        append_import_bytes(bin, movedPosition, 3);
+        const u16 uvVertex[2] = {2, 0};
+        append_import_bytes(bin, uvVertex, 2);
+        const f32 uv[2] = {0.25f, 0.75f};
+        append_import_bytes(bin, uv, 2);
+
+        return import_glb(
+            bin,
+            R"("bufferViews":[
+                {"buffer":0,"byteOffset":0,"byteLength":64,"byteStride":16},
+                {"buffer":0,"byteOffset":64,"byteLength":16},
+                {"buffer":0,"byteOffset":80,"byteLength":16,"byteStride":4},
+                {"buffer":0,"byteOffset":96,"byteLength":12},
+                {"buffer":0,"byteOffset":108,"byteLength":48},
+                {"buffer":0,"byteOffset":156,"byteLength":1},
+                {"buffer":0,"byteOffset":160,"byteLength":12},
+                {"buffer":0,"byteOffset":172,"byteLength":2},
+                {"buffer":0,"byteOffset":176,"byteLength":8}],
+            "accessors":[
+                {"bufferView":0,"componentType":5123,"count":4,"type":"VEC3"},
+                {"bufferView":0,"byteOffset":8,"componentType":5122,
+                 "normalized":true,"count":4,"type":"VEC3"},
+                {"bufferView":1,"componentType":5123,"normalized":true,
+                 "count":4,"type":"VEC2"},
+                {"bufferView":2,"componentType":5121,"normalized":true,
+                 "count":4,"type":"VEC3"},
+                {"bufferView":3,"componentType":5123,"count":6,
+                 "type":"SCALAR"},
+                {"bufferView":4,"componentType":5126,"count":4,"type":"VEC3",
+                 "sparse":{"count":1,
+                           "indices":{"bufferView":5,"componentType":5121},
+                           "values":{"bufferView":6}}},
+                {"componentType":5126,"count":4,"type":"VEC2",
+                 "sparse":{"count":1,
+                           "indices":{"bufferView":7,"componentType":5123},
+                           "values":{"bufferView":8}}}],
+            "meshes":[{"primitives":[
+                {"attributes":{"POSITION":0,"NORMAL":1,"TEXCOORD_0":2,
+                               "COLOR_0":3},"indices":4},
+                {"attributes":{"POSITION":5,"TEXCOORD_0":6}}]}])");
+    }
+
+    void expect_imported_quads(const Mesh& mesh, const u32 primitives)
+    {
+        ASSERT_EQ(primitives, mesh.subMeshes.size());
+        for (u32 p = 0; p < primitives; p++)
+        {
+            const Mesh& subMesh = *mesh.subMeshes[p];
+            ASSERT_EQ(4U, subMesh.positions.size());
+            ASSERT_EQ(4U, subMesh.normals.size());
+            ASSERT_EQ(4U, subMesh.uvs.size());
+            for (u32 corner = 0; corner < 4; corner++)
+            {
+                const ImportVertex expected = import_vertex(p, corner);
+                EXPECT_EQ(expected.position[0], subMesh.positions[corner].x);
+                EXPECT_EQ(expected.position[1], subMesh.positions[corner].y);
+                EXPECT_EQ(expected.position[2], subMesh.positions[corner].z);
+                EXPECT_EQ(1.0f, subMesh.normals[corner].y);
+                EXPECT_EQ(expected.uv[0], subMesh.uvs[corner].x);
+                EXPECT_EQ(expected.uv[1], subMesh.uvs[corner].y);
+            }
+
+            const std::vector<u32> triangles(subMesh.triangles.begin(),
+                                             subMesh.triangles.end());
+            if (p % 4 == 3)
+            {
+                EXPECT_EQ((std::vector<u32>{0, 1, 2, 3}), triangles);
+            }
+            else
+            {
+                EXPECT_EQ((std::vector<u32>{0, 2, 1, 1, 2, 3}), triangles);
+            }
+
+            EXPECT_EQ(2U, subMesh.bufferCount());
+            EXPECT_EQ(4 * sizeof(Vector3fView), subMesh.bufferSize(0));
+        }
+        EXPECT_EQ(f32(primitives - 1) * 2.0f + 1.0f, mesh.bounds.max.x);
+    }
+} // namespace
+
+TEST(Mesh, ImportsStridedAttributesAndEveryIndexType)
+{
+    const std::vector<u8> glb = import_test_glb(8);
+    const Mesh mesh(span<const u8>(glb.data(), glb.size()), "");
+    expect_imported_quads(mesh, 8);
+}
+
+TEST(Mesh, ImportsPrimitivesInParallel)
+{
+    const std::vector<u8> glb = import_test_glb(64);
+
+    JobSystem jobs(3);
+    const Mesh mesh(span<const u8>(glb.data(), glb.size()), "",
+                    EVertexFormat::PACKED, &jobs);
+    expect_imported_quads(mesh, 64);
+    EXPECT_EQ(EVertexFormat::PACKED, mesh.subMeshes[63]->vertexFormat());
+}
+
+TEST(Mesh, ImportsQuantizedAndSparseAccessors)
+{
+    const std::vector<u8> glb = quantized_test_glb();
+    const Mesh mesh(span<const u8>(glb.data(), glb.size()), "");
+    ASSERT_EQ(2U, mesh.subMeshes.size());
+
+    const Mesh& quantized = *mesh.subMeshes[0];
+    ASSERT_EQ(4U, quantized.positions.size());
+    ASSERT_EQ(4U, quantized.normals.size());
+    ASSERT_EQ(4U, quantized.uvs.size());
+    ASSERT_EQ(4U, quantized.colors.size());
+    for (u32 corner = 0; corner < 4; corner++)
+    {
+        // integer positions keep their value, the rest are normalised
+        EXPECT_EQ(f32((corner & 1) * 100), quantized.positions[corner].x);
+        EXPECT_EQ(7.0f, quantized.positions[corner].y);
+        EXPECT_EQ(f32((corner >> 1) * 100), quantized.positions[corner].z);
+        EXPECT_EQ(corner == 1 ? -1.0f : 0.0f, quantized.normals[corner].x);
+        EXPECT_EQ(corner == 1 ? 0.0f : 1.0f, quantized.normals[corner].y);
+        EXPECT_EQ(f32(corner & 1), quantized.uvs[corner].x);
+        EXPECT_NEAR((corner >> 1) * 0.5f, quantized.uvs[corner].y, 1e-4f);
+        EXPECT_EQ(1.0f, quantized.colors[corner].x);
+        EXPECT_EQ(f32(corner) * 0.2f, quantized.colors[corner].y);
+        EXPECT_EQ(1.0f, quantized.colors[corner].w);
+    }
+    const std::vector<u32> triangles(quantized.triangles.begin(),
+                                     quantized.triangles.end());
+    EXPECT_EQ((std::vector<u32>{0, 2, 1, 1, 2, 3}), triangles);
+
+    const Mesh& sparse = *mesh.subMeshes[1];
+    ASSERT_EQ(4U, sparse.positions.size());
+    ASSERT_EQ(4U, sparse.uvs.size());
+    EXPECT_EQ(1.0f, sparse.positions[1].x);
+    EXPECT_EQ(9.0f, sparse.positions[3].x);
+    EXPECT_EQ(9.0f, sparse.positions[3].y);
+    EXPECT_EQ(0.0f, sparse.uvs[0].x);
+    EXPECT_EQ(0.25f, sparse.uvs[2].x);
+    EXPECT_EQ(0.75f, sparse.uvs[2].y);
+    EXPECT_EQ(9.0f, mesh.bounds.max.y);
+}
+
+TEST(Mesh, RejectsPrimitivesIndexingPastTheirVertices)
+{
+    std::vector<u8> bin;
+    for (u32 corner = 0; corner < 4; corner++)
+    {
+        const f32 position[3] = {f32(corner & 1), 0.0f, f32(corner >> 1)};
+        append_import_bytes(bin, position, 3);
+    }
+    const u16 valid[6] = {0, 2, 1, 1, 2, 3};
+    append_import_bytes(bin, valid, 6);
+    const u16 outOfRange[6] = {0, 2, 1, 1, 2, 4};
+    append_import_bytes(bin, outOfRange, 6);
+
+    const std::vector<u8> glb = import_glb(
+        bin,
+        R"("bufferViews":[
+            {"buffer":0,"byteOffset":0,"byteLength":48},
+            {"buffer":0,"byteOffset":48,"byteLength":12},
+            {"buffer":0,"byteOffset":60,"byteLength":12}],
+        "accessors":[
+            {"bufferView":0,"componentType":5126,"count":4,"type":"VEC3"},
+            {"bufferView":1,"componentType":5123,"count":6,"type":"SCALAR"},
+            {"bufferView":2,"componentType":5123,"count":6,"type":"SCALAR"}],
+        "meshes":[{"primitives":[
+            {"attributes":{"POSITION":0},"indices":1},
+            {"attributes":{"POSITION":0},"indices":2}]}])");
+    const Mesh mesh(span<const u8>(glb.data(), glb.size()), "");
+    ASSERT_EQ(2U, mesh.subMeshes.size());
+
+    EXPECT_EQ(4U, mesh.subMeshes[0]->positions.size());
+    EXPECT_EQ(6U, mesh.subMeshes[0]->triangles.size());
+
+    const Mesh& rejected = *mesh.subMeshes[1];
+    EXPECT_TRUE(rejected.positions.empty());
+    EXPECT_TRUE(rejected.triangles.empty());
+    EXPECT_EQ(0U, rejected.bufferCount());
+    EXPECT_EQ(1.0f, mesh.bounds.max.x);
+}
@@ -0,0 +1,330 @@
+#include <helios/core/job_system.hpp>
+#include <helios/core/mesh_optimizer.hpp>
+#include <helios/core/meshlet.hpp>
+#include <helios/math/transformations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    // A uv sphere of the given radius, counter clockwise seen from outside
+    void fill_meshlet_sphere(Mesh& mesh, const u32 rings, const u32 segments,
+                             const f32 radius)
+    {
+        for (u32 ring = 0; ring <= rings; ring++)
+        {
+            const f32 theta = 3.14159265f * f32(ring) / f32(rings);
+            for (u32 segment = 0; segment <= segments; segment++)
+            {
+                const f32 phi = 2.0f * 3.14159265f * f32(segment) / f32(segments);
+                mesh.positions.push_back(Vector3f(
+                    radius * std::sin(theta) * std::cos(phi),
+                    radius * std::cos(theta),
+                    radius * std::sin(theta) * std::sin(phi)));
+            }
+        }
+
+        for (u32 ring = 0; ring < rings; ring++)
+        {
+            for (u32 segment = 0; segment < segments; segment++)
+            {
+                const u32 a = ring * (segments + 1) + segment;
+                const u32 b = a + segments + 1;
+                for (const std::array<u32, 3>& triangle :
+                     {std::array<u32, 3>{a, a + 1, b},
+                      std::array<u32, 3>{a + 1, b + 1, b}})
+                {
+                    const Vector3f& p0 = mesh.positions[triangle[0]];
+                    const Vector3f& p1 = mesh.positions[triangle[1]];
+                    const Vector3f& p2 = mesh.positions[triangle[2]];
+                    if ((p1 - p0).cross(p2 - p0).length() <= 0.0f)
+                    {
+                        continue;
+                    }
+                    mesh.triangles.push_back(triangle[0]);
+                    mesh.triangles.push_back(triangle[1]);
+                    mesh.triangles.push_back(triangle[2]);
+                }
+            }
+        }
+        mesh.calculateBounds();
+    }
+
+    std::vector<std::array<u32, 3>> sorted_meshlet_triangles(const u32* indices,
+                                                             const size_t count)
+    {
+        std::vector<std::array<u32, 3>> triangles;
+        for (size_t t = 0; t < count; t += 3)
+        {
+            // rotate the smallest index first, keeping the winding
+            std::array<u32, 3> triangle = {indices[t], indices[t + 1],
+                                           indices[t + 2]};
+            std::rotate(triangle.begin(),
+                        std::min_element(triangle.begin(), triangle.end()),
+                        triangle.end());
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    // Checks the limits, that the meshlets hold every triangle exactly
+    // once and that their bounds enclose them.
+    void expect_valid_meshlets(const Mesh& mesh)
+    {
+        for (const Meshlet& meshlet : mesh.meshlets)
+        {
+            EXPECT_GT(meshlet.triangleCount, 0U);
+            EXPECT_LE(meshlet.vertexCount, max_meshlet_vertices);
+            EXPECT_LE(meshlet.triangleCount, max_meshlet_triangles);
+
+            const f32 tolerance = 1e-4f * (1.0f + meshlet.bounds.radius);
+            for (u32 i = 0; i < meshlet.vertexCount; i++)
+            {
+                const Vector3f& p =
+                    mesh.positions[mesh.meshletVertices[meshlet.vertexOffset + i]];
+                EXPECT_LE((p - meshlet.bounds.center).length(),
+                          meshlet.bounds.radius + tolerance);
+            }
+
+            for (u32 t = 0; t < meshlet.triangleCount; t++)
+            {
+                const u8* triangle =
+                    mesh.meshletTriangles.data() + meshlet.triangleOffset + t * 3;
+                const u32* vertices =
+                    mesh.meshletVertices.data() + meshlet.vertexOffset;
+                ASSERT_LT(triangle[0], meshlet.vertexCount);
+                ASSERT_LT(triangle[1], meshlet.vertexCount);
+                ASSERT_LT(triangle[2], meshlet.vertexCount);
+
+                const Vector3f& p0 = mesh.positions[vertices[triangle[0]]];
+                const Vector3f& p1 = mesh.positions[vertices[triangle[1]]];
+                const Vector3f& p2 = mesh.positions[vertices[triangle[2]]];
+                const Vector3f normal = (p1 - p0).cross(p2 - p0);
+                if (meshlet.coneCutoff < 1.0f && normal.length() > 0.0f)
+                {
+                    // the sine of the angle to the axis is at most coneCutoff
+                    const f32 cosine =
+                        normal.dot(meshlet.coneAxis) / normal.length();
+                    EXPECT_GE(cosine, 0.0f);
+                    EXPECT_LE(std::sqrt(std::max(0.0f, 1.0f - cosine * cosine)),
+                              meshlet.coneCutoff + 1e-4f);
+                }
+            }
+        }
+
+        const vector<u32> indices = meshletIndices(mesh);
+        EXPECT_EQ(sorted_meshlet_triangles(mesh.triangles.data(),
+                                           mesh.triangles.size()),
+                  sorted_meshlet_triangles(indices.data(), indices.size()));
+    }
+
+    // A frustum around everything, leaving the cone test in charge
+    Frustum meshlet_everything_frustum()
+    {
+        return Frustum(
+            orthographic(-1000.0f, 1000.0f, -1000.0f, 1000.0f, -1000.0f, 1000.0f));
+    }
+
+    // The reference models are found relative to the working directory,
+    // which differs between the IDE and the post build step.
+    std::string find_reference_model(const std::string& path)
+    {
+        std::string prefix;
+        for (u32 depth = 0; depth < 5; depth++)
+        {
+            if (std::filesystem::exists(prefix + "assets/models/" + path))
+            {
+                return prefix + "assets/models/" + path;
+            }
+            prefix += "../";
+        }
+        return std::string();
+    }
+} // namespace
+
+TEST(Meshlet, PartitionsEveryTriangleWithinTheLimits)
+{
+    Mesh mesh;
+    fill_meshlet_sphere(mesh, 48, 64, 2.0f);
+    optimizeMesh(mesh);
+    buildMeshlets(mesh);
+
+    ASSERT_FALSE(mesh.meshlets.empty());
+    expect_valid_meshlets(mesh);
+
+    // a closed surface packs meshlets close to full
+    const size_t triangleCount = mesh.triangles.size() / 3;
+    RecordProperty("meshlets", std::to_string(mesh.meshlets.size()));
+    EXPECT_LE(mesh.meshlets.size(), triangleCount / (max_meshlet_triangles / 2));
+}
+
+TEST(Meshlet, BuildsSubMeshesInParallel)
+{
+    Mesh mesh;
+    for (u32 i = 0; i < 4; i++)
+    {
+        Mesh* subMesh = new Mesh();
+        fill_meshlet_sphere(*subMesh, 16 + i * 8, 24, 1.0f + f32(i));
+        mesh.subMeshes.push_back(subMesh);
+    }
+
+    JobSystem jobs(2);
+    buildMeshlets(mesh, &jobs);
+
+    EXPECT_TRUE(mesh.meshlets.empty());
+    for (const Mesh* subMesh : mesh.subMeshes)
+    {
+        ASSERT_FALSE(subMesh->meshlets.empty());
+        expect_valid_meshlets(*subMesh);
+    }
+}
+
+TEST(Meshlet, ConeCullingNeverDropsAFrontFacingTriangle)
+{
+    Mesh mesh;
+    fill_meshlet_sphere(mesh, 48, 64, 2.0f);
+    optimizeMesh(mesh);
+    buildMeshlets(mesh);
+
+    const Frustum frustum = meshlet_everything_frustum();
+    const Vector3f cameras[] = {
+        Vector3f(0.0f, 0.0f, 10.0f),  Vector3f(0.0f, 0.0f, -10.0f),
+        Vector3f(6.0f, 7.0f, 3.0f),   Vector3f(-3.0f, 2.5f, 0.5f),
+        Vector3f(0.0f, -40.0f, 1.0f), Vector3f(2.1f, 0.0f, 0.0f),
+    };
+    for (const Vector3f& camera : cameras)
+    {
+        size_t culled = 0;
+        for (const Meshlet& meshlet : mesh.meshlets)
+        {
+            if (isMeshletVisible(meshlet, frustum, camera))
+            {
+                continue;
+            }
+            culled++;
+
+            const u32* vertices = mesh.meshletVertices.data() + meshlet.vertexOffset;
+            for (u32 t = 0; t < meshlet.triangleCount; t++)
+            {
+                const u8* triangle =
+                    mesh.meshletTriangles.data() + meshlet.triangleOffset + t * 3;
+                const Vector3f& p0 = mesh.positions[vertices[triangle[0]]];
+                const Vector3f& p1 = mesh.positions[vertices[triangle[1]]];
+                const Vector3f& p2 = mesh.positions[vertices[triangle[2]]];
+                const Vector3f normal = (p1 - p0).cross(p2 - p0);
+                EXPECT_GE((p0 - camera).dot(normal), 0.0f);
+            }
+        }
+
+        // from outside, a good part of the far side goes
+        if (camera.length() > 5.0f)
+        {
+            EXPECT_GT(culled, mesh.meshlets.size() / 5);
+        }
+    }
+}
+
+TEST(Meshlet, CullsOutsideTheFrustumAndCompactsTheRest)
+{
+    Mesh mesh;
+    fill_meshlet_sphere(mesh, 32, 48, 2.0f);
+    optimizeMesh(mesh);
+    buildMeshlets(mesh);
+    const vector<u32> allIndices = meshletIndices(mesh);
+
+    // looking down -z from z = 20
+    const Matrix4f view = translate(Vector3f(0.0f, 0.0f, -20.0f));
+    const Vector3f camera(0.0f, 0.0f, 20.0f);
+    const Frustum front(perspective(60.0f, 1.0f, 0.1f, 100.0f) * view);
+
+    // the commands cover the visible meshlets and nothing else
+    vector<DrawIndexedIndirectCommand> commands;
+    const size_t visible = cullMeshlets(
+        span<const Meshlet>(mesh.meshlets.data(), mesh.meshlets.size()), front,
+        camera, commands);
+    EXPECT_GT(visible, 0U);
+    EXPECT_LT(visible, mesh.meshlets.size());
+    EXPECT_LE(commands.size(), visible);
+
+    std::vector<u32> drawn;
+    for (const DrawIndexedIndirectCommand& command : commands)
+    {
+        EXPECT_EQ(1U, command.instanceCount);
+        EXPECT_LE(command.firstIndex + command.indexCount, allIndices.size());
+        for (u32 i = 0; i < command.indexCount; i++)
+        {
+            drawn.push_back(allIndices[command.firstIndex + i]);
+        }
+    }
+
+    vector<u32> indices;
+    EXPECT_EQ(visible, cullMeshlets(mesh, front, camera, indices));
+    ASSERT_EQ(drawn.size(), indices.size());
+    EXPECT_TRUE(std::equal(drawn.begin(), drawn.end(), indices.begin()));
+
+    // turned around, nothing is left
+    const Frustum behind(perspective(60.0f, 1.0f, 0.1f, 100.0f) *
+                         translate(Vector3f(0.0f, 0.0f, 30.0f)));
+    EXPECT_EQ(0U, cullMeshlets(mesh, behind, Vector3f(0.0f, 0.0f, -30.0f),
+                               indices));
+    EXPECT_TRUE(indices.empty());
+
+    // without cones everything is visible, drawn as one merged command
+    std::vector<Meshlet> coneless(mesh.meshlets.begin(), mesh.meshlets.end());
+    for (Meshlet& meshlet : coneless)
+    {
+        meshlet.coneCutoff = 1.0f;
+    }
+    EXPECT_EQ(coneless.size(),
+              cullMeshlets(span<const Meshlet>(coneless.data(), coneless.size()),
+                           meshlet_everything_frustum(), camera, commands));
+    ASSERT_EQ(1U, commands.size());
+    EXPECT_EQ(0U, commands[0].firstIndex);
+    EXPECT_EQ(allIndices.size(), commands[0].indexCount);
+}
+
+TEST(Meshlet, PartitionsTheReferenceModel)
+{
+    const std::string path =
+        find_reference_model("barramundi/BarramundiFish.gltf");
+    if (path.empty())
+    {
+        GTEST_SKIP() << "assets/models not found from the working directory";
+    }
+
+    Mesh mesh(path);
+    optimizeMesh(mesh);
+    buildMeshlets(mesh);
+
+    size_t meshlets = 0;
+    for (const Mesh* subMesh : mesh.subMeshes)
+    {
+        expect_valid_meshlets(*subMesh);
+        meshlets += subMesh->meshlets.size();
+
+        // every meshlet survives a view from the side it faces
+        for (const Meshlet& meshlet : subMesh->meshlets)
+        {
+            if (meshlet.coneCutoff < 1.0f)
+            {
+                const Vector3f camera = meshlet.bounds.center +
+                                        meshlet.coneAxis *
+                                            (meshlet.bounds.radius * 4.0f + 1.0f);
+                EXPECT_TRUE(isMeshletVisible(
+                    meshlet, meshlet_everything_frustum(), camera));
+            }
+        }
+    }
+    EXPECT_GT(meshlets, 0U);
+    RecordProperty("meshlets", std::to_string(meshlets));
+}
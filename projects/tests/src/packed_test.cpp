@@ -0,0 +1,198 @@
+#include <helios/math/packed.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace helios;
+
+TEST(Packed, HalfRoundTrip)
+{
+    const f32 values[] = {0.0f, 1.0f, -2.5f, 0.333333f, 65504.0f, 6.1035156e-5f, 5.9604645e-8f};
+    for (const f32 value : values)
+    {
+        const f32 result = unpackHalf(packHalf(value));
+        EXPECT_NEAR(result, value, fabsf(value) * 0.001f);
+    }
+
+    EXPECT_EQ(packHalf(1.0f), 0x3C00);
+    EXPECT_EQ(packHalf(-2.0f), 0xC000);
+    EXPECT_EQ(packHalf(1.0e6f), 0x7C00);
+    EXPECT_TRUE(std::isinf(unpackHalf(0x7C00)));
+    EXPECT_TRUE(std::isnan(unpackHalf(packHalf(NAN))));
+}
+
+TEST(Packed, NormalizedRoundTrip)
+{
+    EXPECT_EQ(packSnorm16(1.0f), 32767);
+    EXPECT_EQ(packSnorm16(-1.0f), -32767);
+    EXPECT_EQ(packSnorm16(2.0f), 32767);
+    EXPECT_EQ(packSnorm8(-3.0f), -127);
+    EXPECT_EQ(packUnorm8(1.0f), 255);
+    EXPECT_EQ(packUnorm8(-1.0f), 0);
+
+    EXPECT_NEAR(unpackSnorm16(packSnorm16(0.123f)), 0.123f, 1.0f / 32767.0f);
+    EXPECT_NEAR(unpackSnorm8(packSnorm8(-0.5f)), -0.5f, 1.0f / 127.0f);
+    EXPECT_NEAR(unpackUnorm8(packUnorm8(0.75f)), 0.75f, 1.0f / 255.0f);
+    EXPECT_EQ(unpackSnorm16(-32768), -1.0f);
+    EXPECT_EQ(packUnorm16(1.0f), 65535);
+    EXPECT_EQ(unpackUnorm16(65535), 1.0f);
+    EXPECT_NEAR(unpackUnorm16(packUnorm16(0.3f)), 0.3f, 1.0f / 65535.0f);
+}
+
+TEST(Packed, Packed1010102)
+{
+    const Vector4f color(0.25f, 0.5f, 1.0f, 1.0f);
+    const Vector4f unorm = Unorm1010102(color).unpack();
+    EXPECT_NEAR(unorm.x, color.x, 1.0f / 1023.0f);
+    EXPECT_NEAR(unorm.y, color.y, 1.0f / 1023.0f);
+    EXPECT_NEAR(unorm.z, color.z, 1.0f / 1023.0f);
+    EXPECT_EQ(unorm.w, 1.0f);
+
+    const Vector4f tangent(-0.6f, 0.0f, 0.8f, -1.0f);
+    const Vector4f snorm = Snorm1010102(tangent).unpack();
+    EXPECT_NEAR(snorm.x, tangent.x, 1.0f / 511.0f);
+    EXPECT_NEAR(snorm.y, tangent.y, 1.0f / 511.0f);
+    EXPECT_NEAR(snorm.z, tangent.z, 1.0f / 511.0f);
+    EXPECT_EQ(snorm.w, -1.0f);
+}
+
+TEST(Packed, OctahedralRoundTrip)
+{
+    const Vector3f normals[] = {
+        {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, -1.0f, 0.0f},
+        {0.577f, 0.577f, -0.577f}, {-0.267f, 0.535f, -0.802f},
+    };
+
+    for (const auto& n : normals)
+    {
+        const Vector3f normal = n / n.length();
+        const Vector3f decoded = decodeOctahedral(Snorm16x2(encodeOctahedral(normal)).unpack());
+        EXPECT_GT(decoded.dot(normal), 0.99999f);
+    }
+}
+
+TEST(Packed, BatchMatchesScalar)
+{
+    constexpr size_t count = 21;
+
+    f32 scalars[count];
+    Vector2f uvs[count];
+    Vector3f normals[count];
+    Vector4f colors[count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        const f32 t = static_cast<f32>(i) / static_cast<f32>(count - 1);
+        scalars[i] = t * 2.6f - 1.3f;
+        uvs[i] = Vector2f(t * 4.0f, 1.0f - t);
+        const Vector3f n(cosf(t * 6.0f), sinf(t * 6.0f), t - 0.5f);
+        normals[i] = n / n.length();
+        colors[i] = Vector4f(t, 1.0f - t, t * 0.5f, i % 2 ? 1.0f : -1.0f);
+    }
+
+    u16 halves[count];
+    f32 unpacked[count];
+    Half2 half2s[count];
+    i16 snorm16s[count];
+    i8 snorm8s[count];
+    u8 unorm8s[count];
+    Unorm8x4 unorm8x4s[count];
+    Snorm1010102 snorm1010102s[count];
+    Unorm1010102 unorm1010102s[count];
+    Snorm16x2 octahedrals[count];
+
+    packHalf(scalars, halves, count);
+    unpackHalf(halves, unpacked, count);
+    packHalf(uvs, half2s, count);
+    packSnorm16(scalars, snorm16s, count);
+    packSnorm8(scalars, snorm8s, count);
+    packUnorm8(scalars, unorm8s, count);
+    packUnorm8(colors, unorm8x4s, count);
+    packSnorm1010102(colors, snorm1010102s, count);
+    packUnorm1010102(colors, unorm1010102s, count);
+    packOctahedral(normals, octahedrals, count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(halves[i], packHalf(scalars[i]));
+        EXPECT_EQ(unpacked[i], unpackHalf(halves[i]));
+        EXPECT_EQ(half2s[i].x, Half2(uvs[i]).x);
+        EXPECT_EQ(half2s[i].y, Half2(uvs[i]).y);
+        EXPECT_EQ(snorm16s[i], packSnorm16(scalars[i]));
+        EXPECT_EQ(snorm8s[i], packSnorm8(scalars[i]));
+        EXPECT_EQ(unorm8s[i], packUnorm8(scalars[i]));
+
+        const Unorm8x4 color = Unorm8x4(colors[i]);
+        EXPECT_EQ(unorm8x4s[i].x, color.x);
+        EXPECT_EQ(unorm8x4s[i].y, color.y);
+        EXPECT_EQ(unorm8x4s[i].z, color.z);
+        EXPECT_EQ(unorm8x4s[i].w, color.w);
+
+        EXPECT_EQ(snorm1010102s[i].bits, Snorm1010102(colors[i]).bits);
+        EXPECT_EQ(unorm1010102s[i].bits, Unorm1010102(colors[i]).bits);
+
+        const Snorm16x2 octahedral = Snorm16x2(encodeOctahedral(normals[i]));
+        EXPECT_NEAR(octahedrals[i].x, octahedral.x, 1);
+        EXPECT_NEAR(octahedrals[i].y, octahedral.y, 1);
+    }
+}
+
+TEST(Packed, BatchUnpackMatchesScalar)
+{
+    constexpr size_t count = 37;
+
+    i16 snorm16s[count];
+    i8 snorm8s[count];
+    u16 unorm16s[count];
+    u8 unorm8s[count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        snorm16s[i] = static_cast<i16>(-32768 + static_cast<i32>(i) * 1771);
+        snorm8s[i] = static_cast<i8>(-128 + static_cast<i32>(i) * 7);
+        unorm16s[i] = static_cast<u16>(i * 1771);
+        unorm8s[i] = static_cast<u8>(i * 7);
+    }
+
+    f32 fromSnorm16[count];
+    f32 fromSnorm8[count];
+    f32 fromUnorm16[count];
+    f32 fromUnorm8[count];
+    unpackSnorm16(snorm16s, fromSnorm16, count);
+    unpackSnorm8(snorm8s, fromSnorm8, count);
+    unpackUnorm16(unorm16s, fromUnorm16, count);
+    unpackUnorm8(unorm8s, fromUnorm8, count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(fromSnorm16[i], unpackSnorm16(snorm16s[i]));
+        EXPECT_EQ(fromSnorm8[i], unpackSnorm8(snorm8s[i]));
+        EXPECT_EQ(fromUnorm16[i], unpackUnorm16(unorm16s[i]));
+        EXPECT_EQ(fromUnorm8[i], unpackUnorm8(unorm8s[i]));
+    }
+    EXPECT_EQ(fromSnorm16[0], -1.0f);
+    EXPECT_EQ(fromSnorm8[0], -1.0f);
+}
+
+TEST(Packed, WidenIndices)
+{
+    constexpr size_t count = 45;
+
+    u8 bytes[count];
+    u16 shorts[count];
+    for (size_t i = 0; i < count; ++i)
+    {
+        bytes[i] = static_cast<u8>(255 - i);
+        shorts[i] = static_cast<u16>(65535 - i * 997);
+    }
+
+    u32 fromBytes[count];
+    u32 fromShorts[count];
+    widenIndices(bytes, fromBytes, count);
+    widenIndices(shorts, fromShorts, count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(fromBytes[i], bytes[i]);
+        EXPECT_EQ(fromShorts[i], shorts[i]);
+    }
+}
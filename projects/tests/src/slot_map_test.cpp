@@ -214,6 +214,43 @@ TEST(SlotMap, EraseThenInsert)
     EXPECT_FALSE(map.contains(it3));
 }
 
+TEST(SlotMap, KeysSurviveResizeAndErase)
+{
+    slot_map<i32> map;
+    slot_key<i32, allocator<i32>> keys[64];
+    for (i32 i = 0; i < 64; i++)
+    {
+        keys[i] = map.insert(i);
+    }
+
+    for (i32 i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(map.get(keys[i]), i);
+    }
+
+    for (i32 i = 0; i < 64; i += 2)
+    {
+        EXPECT_TRUE(map.erase(keys[i]));
+    }
+    EXPECT_EQ(map.size(), 32);
+
+    for (i32 i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(map.contains(keys[i]), i % 2 == 1);
+        if (i % 2 == 1)
+        {
+            EXPECT_EQ(map.get(keys[i]), i);
+        }
+    }
+
+    slot_map<i32> copy;
+    copy.insert(-1);
+    copy = map;
+    map.clear();
+    EXPECT_FALSE(map.contains(keys[1]));
+    EXPECT_EQ(copy.size(), 32);
+}
+
 TEST(ChunkSlotMap, DefaultConstructor)
 {
     chunk_slot_map<i32, 4> map;
@@ -0,0 +1,291 @@
+#include <helios/core/transformation.hpp>
+#include <helios/ecs/snapshot.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace helios
+{
+    extern entt::registry& get_entt(EntityManager& manager);
+}
+
+using namespace helios;
+
+namespace
+{
+    struct SavedId
+    {
+        u32 id;
+    };
+
+    struct SavedTag
+    {
+        u32 tag;
+    };
+
+    struct SavedPosition
+    {
+        f32 x;
+        f32 y;
+        f32 z;
+    };
+
+    struct SavedWide
+    {
+        f64 x;
+        f64 y;
+        f64 z;
+    };
+
+    Snapshot scene_snapshot()
+    {
+        Snapshot snapshot;
+        snapshot.component<SavedId>("id")
+            .component<SavedPosition>("position")
+            .component<HierarchyComponent>(
+                "hierarchy",
+                [](HierarchyComponent& hierarchy, const EntityRemap& remap) {
+                    hierarchy.parent = remap(hierarchy.parent);
+                });
+        return snapshot;
+    }
+
+    // every third entity has a position, every other one is parented to the
+    // entity before it, and a few are released to leave holes
+    void build_scene(EntityManager& manager)
+    {
+        std::vector<Entity> entities;
+        for (u32 i = 0; i < 1000; i++)
+        {
+            Entity e = manager.create();
+            e.assign<SavedId>(SavedId{i});
+            if (i % 3 == 0)
+            {
+                e.assign<SavedPosition>(
+                    SavedPosition{f32(i), f32(i) * 2.0f, -f32(i)});
+            }
+            if (i % 2 == 1)
+            {
+                e.assign<HierarchyComponent>(
+                    HierarchyComponent{entities.back().handle()});
+            }
+            entities.push_back(e);
+        }
+
+        for (u32 i = 0; i < 1000; i += 100)
+        {
+            manager.release(entities[i]);
+        }
+    }
+
+    std::unordered_map<u32, entt::entity> by_id(EntityManager& manager)
+    {
+        std::unordered_map<u32, entt::entity> result;
+        get_entt(manager).view<SavedId>().each(
+            [&](const entt::entity entity, const SavedId& id) {
+                result[id.id] = entity;
+            });
+        return result;
+    }
+
+    // Offsets of the pool headers in saved data. The 24 byte file header
+    // holds the pool count at byte 8 and the entity count at byte 16, the
+    // entities follow. Each pool then has an 8 byte aligned header of type,
+    // size, alignment and count, its entities and a 64 byte aligned blob.
+    std::vector<size_t> snapshot_pool_offsets(const std::vector<u8>& data)
+    {
+        u32 pools;
+        u64 entities;
+        memcpy(&pools, data.data() + 8, sizeof(pools));
+        memcpy(&entities, data.data() + 16, sizeof(entities));
+
+        std::vector<size_t> offsets;
+        size_t offset = 24 + entities * sizeof(entt::entity);
+        for (u32 i = 0; i < pools; i++)
+        {
+            offset = (offset + 7) & ~size_t(7);
+            offsets.push_back(offset);
+
+            u32 size;
+            u64 count;
+            memcpy(&size, data.data() + offset + 8, sizeof(size));
+            memcpy(&count, data.data() + offset + 16, sizeof(count));
+            offset = (offset + 24 + count * sizeof(entt::entity) + 63) & ~size_t(63);
+            offset += count * size;
+        }
+        return offsets;
+    }
+} // namespace
+
+TEST(Snapshot, RoundTripsComponentsAndRemapsEntities)
+{
+    EntityManager source;
+    build_scene(source);
+    const std::vector<u8> data = scene_snapshot().save(source);
+
+    EntityManager target;
+    for (u32 i = 0; i < 37; i++)
+    {
+        target.create();
+    }
+    ASSERT_EQ(ESnapshotResult::SUCCESS,
+              scene_snapshot().load(target, data.data(), data.size()));
+
+    entt::registry& saved = get_entt(source);
+    entt::registry& loaded = get_entt(target);
+    EXPECT_EQ(saved.alive() + 37, loaded.alive());
+    EXPECT_EQ(saved.size<SavedPosition>(), loaded.size<SavedPosition>());
+    EXPECT_EQ(saved.size<HierarchyComponent>(),
+              loaded.size<HierarchyComponent>());
+
+    const auto savedIds = by_id(source);
+    const auto loadedIds = by_id(target);
+    ASSERT_EQ(savedIds.size(), loadedIds.size());
+    for (const auto& [id, original] : savedIds)
+    {
+        const entt::entity copy = loadedIds.at(id);
+        ASSERT_EQ(saved.has<SavedPosition>(original),
+                  loaded.has<SavedPosition>(copy));
+        if (saved.has<SavedPosition>(original))
+        {
+            const SavedPosition& expected = saved.get<SavedPosition>(original);
+            const SavedPosition& actual = loaded.get<SavedPosition>(copy);
+            EXPECT_EQ(expected.x, actual.x);
+            EXPECT_EQ(expected.y, actual.y);
+            EXPECT_EQ(expected.z, actual.z);
+        }
+
+        ASSERT_EQ(saved.has<HierarchyComponent>(original),
+                  loaded.has<HierarchyComponent>(copy));
+        if (saved.has<HierarchyComponent>(original))
+        {
+            const entt::entity parent =
+                saved.get<HierarchyComponent>(original).parent;
+            const entt::entity loadedParent =
+                loaded.get<HierarchyComponent>(copy).parent;
+            if (saved.valid(parent))
+            {
+                EXPECT_EQ(loadedIds.at(saved.get<SavedId>(parent).id),
+                          loadedParent);
+            }
+            else
+            {
+                // parents released before saving do not survive the trip
+                EXPECT_EQ(entt::entity(entt::null), loadedParent);
+            }
+        }
+    }
+}
+
+TEST(Snapshot, LoadsIntoOwningGroups)
+{
+    EntityManager source;
+    build_scene(source);
+    const std::vector<u8> data = scene_snapshot().save(source);
+
+    EntityManager target;
+    auto group = target.group<SavedPosition>(Get<SavedId>{});
+    ASSERT_EQ(ESnapshotResult::SUCCESS,
+              scene_snapshot().load(target, data.data(), data.size()));
+
+    EXPECT_EQ(get_entt(source).size<SavedPosition>(), group.size());
+    group.each([](Entity, const SavedPosition& position, const SavedId& id) {
+        EXPECT_EQ(f32(id.id), position.x);
+        EXPECT_EQ(f32(id.id) * 2.0f, position.y);
+    });
+}
+
+TEST(Snapshot, SkipsComponentsItDoesNotKnow)
+{
+    EntityManager source;
+    build_scene(source);
+    const std::vector<u8> data = scene_snapshot().save(source);
+
+    Snapshot partial;
+    partial.component<SavedId>("id");
+
+    EntityManager target;
+    ASSERT_EQ(ESnapshotResult::SUCCESS,
+              partial.load(target, data.data(), data.size()));
+    EXPECT_EQ(get_entt(source).alive(), get_entt(target).alive());
+    EXPECT_EQ(get_entt(source).size<SavedId>(),
+              get_entt(target).size<SavedId>());
+    EXPECT_EQ(0U, get_entt(target).size<SavedPosition>());
+}
+
+TEST(Snapshot, RejectsInvalidDataWithoutCreatingEntities)
+{
+    EntityManager source;
+    build_scene(source);
+    std::vector<u8> data = scene_snapshot().save(source);
+
+    EntityManager target;
+    const entt::registry& registry = get_entt(target);
+
+    Snapshot mismatched;
+    mismatched.component<SavedWide>("position");
+    EXPECT_EQ(ESnapshotResult::COMPONENT_MISMATCH,
+              mismatched.load(target, data.data(), data.size()));
+
+    EXPECT_EQ(ESnapshotResult::TRUNCATED,
+              scene_snapshot().load(target, data.data(), data.size() - 1));
+    EXPECT_EQ(ESnapshotResult::INVALID_HEADER,
+              scene_snapshot().load(target, data.data(), 4));
+
+    std::vector<u8> newer = data;
+    newer[4] = static_cast<u8>(Snapshot::format_version + 1);
+    EXPECT_EQ(ESnapshotResult::UNSUPPORTED_VERSION,
+              scene_snapshot().load(target, newer.data(), newer.size()));
+
+    data[0] ^= 0xFF;
+    EXPECT_EQ(ESnapshotResult::INVALID_HEADER,
+              scene_snapshot().load(target, data.data(), data.size()));
+
+    EXPECT_EQ(0U, registry.alive());
+}
+
+TEST(Snapshot, RejectsDuplicateEntitiesInAPool)
+{
+    EntityManager source;
+    build_scene(source);
+    std::vector<u8> data = scene_snapshot().save(source);
+
+    // list the first entity of the first pool twice
+    const size_t ids = snapshot_pool_offsets(data)[0] + 24;
+    memcpy(data.data() + ids + sizeof(entt::entity), data.data() + ids,
+           sizeof(entt::entity));
+
+    EntityManager target;
+    EXPECT_EQ(ESnapshotResult::INVALID_ENTITY,
+              scene_snapshot().load(target, data.data(), data.size()));
+    EXPECT_EQ(0U, get_entt(target).alive());
+}
+
+TEST(Snapshot, RejectsRepeatedPoolTypes)
+{
+    Snapshot snapshot;
+    snapshot.component<SavedId>("id").component<SavedTag>("tag");
+
+    EntityManager source;
+    for (u32 i = 0; i < 10; i++)
+    {
+        Entity e = source.create();
+        e.assign<SavedId>(SavedId{i});
+        e.assign<SavedTag>(SavedTag{i * 2});
+    }
+    std::vector<u8> data = snapshot.save(source);
+
+    // both components are four bytes, so only the type of the second pool
+    // changes and its blob would be loaded as ids a second time
+    const std::vector<size_t> offsets = snapshot_pool_offsets(data);
+    ASSERT_EQ(2U, offsets.size());
+    memcpy(data.data() + offsets[1], data.data() + offsets[0], sizeof(u64));
+
+    EntityManager target;
+    EXPECT_EQ(ESnapshotResult::COMPONENT_MISMATCH,
+              snapshot.load(target, data.data(), data.size()));
+    EXPECT_EQ(0U, get_entt(target).alive());
+}
@@ -0,0 +1,40 @@
+#include <helios/containers/span.hpp>
+#include <helios/containers/vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace helios;
+
+TEST(Span, ViewsContainersWithoutCopying)
+{
+    vector<u32> values = {1, 2, 3, 4, 5};
+    const span<u32> all(values);
+    EXPECT_EQ(values.data(), all.data());
+    EXPECT_EQ(5U, all.size());
+    EXPECT_EQ(5 * sizeof(u32), all.size_bytes());
+
+    all[0] = 10;
+    EXPECT_EQ(10U, values[0]);
+
+    const span<const u32> readOnly = all;
+    EXPECT_EQ(10U, readOnly[0]);
+
+    u32 sum = 0;
+    for (const u32 value : readOnly.subspan(1, 3))
+    {
+        sum += value;
+    }
+    EXPECT_EQ(9U, sum);
+    EXPECT_EQ(2U, readOnly.first(2).size());
+
+    const std::string text = "helios";
+    const span<const char> chars(text);
+    EXPECT_EQ('h', chars[0]);
+    EXPECT_EQ(text.size(), chars.size());
+
+    const span<const u8> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+}
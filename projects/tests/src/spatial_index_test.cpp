@@ -0,0 +1,173 @@
+#include <helios/core/spatial_index.hpp>
+#include <helios/core/transform_system.hpp>
+#include <helios/math/transformations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    AABB randomBox(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<f32> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<f32> size(0.1f, 3.0f);
+        const Vector3f min(position(rng), position(rng), position(rng));
+        return AABB(min, min + Vector3f(size(rng), size(rng), size(rng)));
+    }
+
+    // proxies overlapping query according to the tree, checked against the
+    // fat bounds by brute force
+    void expectMatchesBruteForce(const DynamicAABBTree& tree,
+                                 const std::vector<u32>& proxies,
+                                 const AABB& query)
+    {
+        std::vector<u32> found;
+        tree.query(query, [&](const u32 proxy) { found.push_back(proxy); });
+
+        std::vector<u32> expected;
+        for (const u32 proxy : proxies)
+        {
+            if (tree.fatBounds(proxy).intersects(query))
+            {
+                expected.push_back(proxy);
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(found, expected);
+    }
+} // namespace
+
+TEST(DynamicAABBTree, QueriesMatchBruteForce)
+{
+    std::mt19937 rng(7);
+    DynamicAABBTree tree;
+    std::vector<u32> proxies;
+    for (u32 i = 0; i < 2000; i++)
+    {
+        proxies.push_back(tree.insert(randomBox(rng), i));
+    }
+    EXPECT_EQ(tree.size(), 2000u);
+    EXPECT_LT(tree.height(), 32u);
+
+    for (u32 i = 0; i < 500; i++)
+    {
+        tree.move(proxies[i], randomBox(rng));
+    }
+    for (u32 i = 500; i < 800; i++)
+    {
+        tree.remove(proxies[i]);
+    }
+    proxies.erase(proxies.begin() + 500, proxies.begin() + 800);
+
+    for (u32 i = 0; i < 20; i++)
+    {
+        expectMatchesBruteForce(tree, proxies, randomBox(rng));
+    }
+
+    // batched moves, refit in parallel and then rebuilt
+    JobSystem jobs(3);
+    for (const u32 proxy : proxies)
+    {
+        const AABB moved = randomBox(rng);
+        tree.setBounds(proxy, moved);
+        EXPECT_TRUE(tree.fatBounds(proxy).contains(moved));
+    }
+    tree.refit(&jobs);
+    for (u32 i = 0; i < 20; i++)
+    {
+        expectMatchesBruteForce(tree, proxies, randomBox(rng));
+    }
+
+    const f32 refitCost = tree.cost();
+    tree.rebuild(&jobs);
+    EXPECT_LT(tree.cost(), refitCost);
+    EXPECT_EQ(tree.size(), proxies.size());
+    for (u32 i = 0; i < 20; i++)
+    {
+        expectMatchesBruteForce(tree, proxies, randomBox(rng));
+    }
+    EXPECT_EQ(tree.userData(proxies.back()), 1999u);
+}
+
+TEST(DynamicAABBTree, RaycastFindsClosest)
+{
+    DynamicAABBTree tree(0.0f);
+    for (u32 i = 0; i < 10; i++)
+    {
+        const f32 z = -5.0f * static_cast<f32>(i + 1);
+        tree.insert(AABB(Vector3f(-1.0f, -1.0f, z - 1.0f), Vector3f(1.0f, 1.0f, z + 1.0f)), i);
+    }
+
+    u32 closest = ~0U;
+    tree.raycast(Ray(Vector3f(0.0f), Vector3f(0.0f, 0.0f, -1.0f)), 100.0f, [&](const u32 proxy, const f32 distance) {
+        closest = tree.userData(proxy);
+        return distance;
+    });
+    EXPECT_EQ(closest, 0u);
+
+    u32 hits = 0;
+    tree.raycast(Ray(Vector3f(0.0f), Vector3f(0.0f, 0.0f, -1.0f)), 22.0f, [&](const u32, const f32) {
+        ++hits;
+        return 22.0f;
+    });
+    EXPECT_EQ(hits, 4u);
+}
+
+TEST(SpatialIndex, FollowsTransforms)
+{
+    EntityManager manager;
+    JobSystem jobs(2);
+    TransformSystem transforms(manager, jobs);
+    SpatialIndex index(manager, jobs);
+
+    std::vector<Entity> entities;
+    for (u32 i = 0; i < 100; i++)
+    {
+        Entity e = manager.create();
+        e.assign<TransformationComponent>(Vector3f(static_cast<f32>(i) * 10.0f, 0.0f, 0.0f), Vector3f(0.0f),
+                                          Vector3f(1.0f));
+        e.assign<BoundsComponent>(BoundsComponent{AABB(Vector3f(-1.0f), Vector3f(1.0f))});
+        entities.push_back(e);
+    }
+    transforms.update();
+    index.update();
+    EXPECT_EQ(index.size(), 100u);
+
+    u32 found = 0;
+    index.query(BoundingSphere(Vector3f(50.0f, 0.0f, 0.0f), 2.0f), [&](Entity e) {
+        EXPECT_EQ(e.handle(), entities[5].handle());
+        ++found;
+    });
+    EXPECT_EQ(found, 1u);
+
+    entities[5].get<TransformationComponent>().setPosition(Vector3f(0.0f, 500.0f, 0.0f));
+    transforms.update();
+    index.update();
+
+    found = 0;
+    index.query(AABB(Vector3f(45.0f, -5.0f, -5.0f), Vector3f(55.0f, 5.0f, 5.0f)), [&](Entity) { ++found; });
+    EXPECT_EQ(found, 0u);
+
+    Entity hit = entities[0];
+    f32 distance = 0.0f;
+    EXPECT_TRUE(index.raycastClosest(Ray(Vector3f(0.0f, 1000.0f, 0.0f), Vector3f(0.0f, -1.0f, 0.0f)), 2000.0f, hit,
+                                     distance));
+    EXPECT_EQ(hit.handle(), entities[5].handle());
+    EXPECT_FLOAT_EQ(distance, 499.0f);
+
+    const Matrix4f viewProjection = perspective(90.0f, 1.0f, 0.1f, 100.0f) * translate(Vector3f(0.0f, 0.0f, -20.0f));
+    found = 0;
+    index.query(Frustum(viewProjection), [&](Entity) { ++found; });
+    EXPECT_EQ(found, 3u);
+
+    manager.release(entities[3]);
+    index.update();
+    EXPECT_EQ(index.size(), 99u);
+}
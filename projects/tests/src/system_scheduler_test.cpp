@@ -0,0 +1,109 @@
+#include <helios/ecs/system_scheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    struct SchedulerA
+    {
+        u32 value;
+    };
+
+    struct SchedulerB
+    {
+        u32 value;
+    };
+} // namespace
+
+TEST(SystemScheduler, ConflictingSystemsRunInRegistrationOrder)
+{
+    JobSystem jobs(3);
+    EntityManager manager(&jobs);
+    SystemScheduler scheduler(manager, jobs);
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    const auto record = [&](const char* name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.emplace_back(name);
+    };
+
+    scheduler.add<Read<>, Write<SchedulerA>>(
+        "writeA", [&](EntityManager&) { record("writeA"); });
+    scheduler.add<Read<SchedulerA>, Write<SchedulerB>>(
+        "readA", [&](EntityManager&) { record("readA"); });
+    scheduler.add<Read<SchedulerB>>(
+        "readB", [&](EntityManager&) { record("readB"); });
+
+    for (u32 frame = 0; frame < 50; ++frame)
+    {
+        order.clear();
+        scheduler.run();
+        ASSERT_EQ(order.size(), 3u);
+        EXPECT_EQ(order[0], "writeA");
+        EXPECT_EQ(order[1], "readA");
+        EXPECT_EQ(order[2], "readB");
+    }
+}
+
+TEST(SystemScheduler, ReadersRunConcurrently)
+{
+    JobSystem jobs(2);
+    EntityManager manager(&jobs);
+    SystemScheduler scheduler(manager, jobs);
+
+    // each reader waits until the other has started, so the frame only
+    // finishes if both are in flight at once
+    std::atomic<u32> started(0);
+    const auto reader = [&](EntityManager&) {
+        started.fetch_add(1);
+        while (started.load() < 2)
+        {
+            std::this_thread::yield();
+        }
+    };
+    scheduler.add<Read<SchedulerA>>("first", reader);
+    scheduler.add<Read<SchedulerA>>("second", reader);
+
+    scheduler.run();
+    EXPECT_EQ(started.load(), 2u);
+}
+
+TEST(SystemScheduler, ReportsTimingsPerSystem)
+{
+    JobSystem jobs(0);
+    EntityManager manager(&jobs);
+    SystemScheduler scheduler(manager, jobs);
+
+    for (u32 i = 0; i < 100; ++i)
+    {
+        manager.create().assign<SchedulerA>(SchedulerA{i});
+    }
+
+    u64 sum = 0;
+    scheduler.add<Read<SchedulerA>>("sum", [&](EntityManager& entities) {
+        sum = entities.parallel_reduce<Read<SchedulerA>>(
+            u64(0),
+            [](u64& acc, const SchedulerA& a) { acc += a.value; },
+            [](u64 a, u64 b) { return a + b; });
+    });
+    scheduler.add<Read<>, Write<SchedulerB>>("idle", [](EntityManager&) {});
+
+    scheduler.run();
+
+    EXPECT_EQ(sum, 4950u);
+    const auto& timings = scheduler.timings();
+    ASSERT_EQ(timings.size(), 2u);
+    EXPECT_EQ(timings[0].name, "sum");
+    EXPECT_EQ(timings[1].name, "idle");
+    EXPECT_GE(timings[0].milliseconds, 0.0);
+    EXPECT_GE(scheduler.frameMilliseconds(), timings[0].milliseconds);
+}
@@ -0,0 +1,146 @@
+#include <helios/core/transform_batch.hpp>
+#include <helios/math/transformations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace helios;
+
+namespace
+{
+    Vector3f randomVector(std::mt19937& rng, const f32 lo, const f32 hi)
+    {
+        std::uniform_real_distribution<f32> dist(lo, hi);
+        return Vector3f(dist(rng), dist(rng), dist(rng));
+    }
+
+    void expectNear(const Matrix4f& expected, const Matrix4f& actual)
+    {
+        for (u32 i = 0; i < 16; i++)
+        {
+            const f32 tolerance =
+                1e-5f * std::fmax(1.0f, std::fabs(expected.data[i]));
+            EXPECT_NEAR(expected.data[i], actual.data[i], tolerance)
+                << "element " << i;
+        }
+    }
+
+    void fill(TransformBatch& batch, const u32 count, std::mt19937& rng)
+    {
+        for (u32 i = 0; i < count; i++)
+        {
+            batch.add(randomVector(rng, -100.0f, 100.0f),
+                      randomVector(rng, -720.0f, 720.0f),
+                      randomVector(rng, 0.1f, 4.0f));
+        }
+    }
+} // namespace
+
+TEST(TransformBatch, ComposeMatchesScalarTransform)
+{
+    std::mt19937 rng(11);
+    std::vector<f32> components[9];
+    std::vector<Vector3f> positions, rotations, scales;
+    for (u32 i = 0; i < 29; i++)
+    {
+        positions.push_back(randomVector(rng, -100.0f, 100.0f));
+        rotations.push_back(randomVector(rng, -720.0f, 720.0f));
+        scales.push_back(randomVector(rng, 0.1f, 4.0f));
+        for (u32 axis = 0; axis < 3; axis++)
+        {
+            components[axis].push_back(positions.back().data[axis]);
+            components[3 + axis].push_back(rotations.back().data[axis]);
+            components[6 + axis].push_back(scales.back().data[axis]);
+        }
+    }
+
+    TransformArrays arrays;
+    for (u32 axis = 0; axis < 3; axis++)
+    {
+        arrays.position[axis] = components[axis].data();
+        arrays.rotation[axis] = components[3 + axis].data();
+        arrays.scale[axis] = components[6 + axis].data();
+    }
+
+    // an offset start and a count that leaves a scalar tail
+    std::vector<Matrix4f> out(27);
+    composeTransforms(arrays, 2, out.size(), out.data());
+    for (u32 i = 0; i < out.size(); i++)
+    {
+        expectNear(transform(positions[i + 2], rotations[i + 2],
+                             scales[i + 2]),
+                   out[i]);
+    }
+}
+
+TEST(TransformBatch, RebuildsChangedBlocks)
+{
+    std::mt19937 rng(5);
+    TransformBatch batch;
+    fill(batch, 37, rng);
+    EXPECT_TRUE(batch.dirty(36));
+
+    batch.rebuild();
+    for (u32 i = 0; i < batch.size(); i++)
+    {
+        EXPECT_FALSE(batch.dirty(i));
+        expectNear(transform(batch.position(i), batch.rotation(i),
+                             batch.scale(i)),
+                   batch.matrices()[i]);
+    }
+
+    batch.setRotation(20, Vector3f(0.0f, 90.0f, 0.0f));
+    EXPECT_TRUE(batch.dirty(16));
+    EXPECT_TRUE(batch.dirty(23));
+    EXPECT_FALSE(batch.dirty(15));
+    EXPECT_FALSE(batch.dirty(24));
+
+    batch.rebuild();
+    expectNear(transform(batch.position(20), Vector3f(0.0f, 90.0f, 0.0f),
+                         batch.scale(20)),
+               batch.matrices()[20]);
+    EXPECT_EQ(37 * sizeof(Matrix4f), batch.matrixBytes());
+}
+
+TEST(TransformBatch, RemoveMovesTheLastTransformation)
+{
+    TransformBatch batch;
+    for (u32 i = 0; i < 10; i++)
+    {
+        batch.add(Vector3f(f32(i), 0.0f, 0.0f), Vector3f(0.0f, 0.0f, 0.0f),
+                  Vector3f(1.0f, 1.0f, 1.0f));
+    }
+    batch.rebuild();
+
+    EXPECT_EQ(9U, batch.remove(2));
+    EXPECT_EQ(9U, batch.size());
+    EXPECT_EQ(9.0f, batch.position(2).x);
+    EXPECT_TRUE(batch.dirty(2));
+
+    EXPECT_EQ(8U, batch.remove(8));
+    EXPECT_EQ(8U, batch.size());
+
+    batch.rebuild();
+    EXPECT_EQ(9.0f, batch.matrices()[2].data[12]);
+}
+
+TEST(TransformBatch, ParallelRebuildMatchesSerial)
+{
+    std::mt19937 serialRng(3);
+    std::mt19937 parallelRng(3);
+    TransformBatch serial;
+    TransformBatch parallel;
+    fill(serial, 5000, serialRng);
+    fill(parallel, 5000, parallelRng);
+
+    JobSystem jobs(3);
+    serial.rebuild();
+    parallel.rebuild(&jobs);
+    for (u32 i = 0; i < serial.size(); i++)
+    {
+        EXPECT_EQ(serial.matrices()[i], parallel.matrices()[i]);
+    }
+}
@@ -0,0 +1,190 @@
+#include <helios/core/transform_system.hpp>
+#include <helios/math/transformations.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace helios;
+
+// joins an owning group over TransformationComponent in the tests below
+struct TransformGroupMember
+{
+    u32 pass = 0;
+};
+
+static void expectMatrixNear(const Matrix4f& lhs, const Matrix4f& rhs)
+{
+    for (i32 i = 0; i < 16; i++)
+    {
+        EXPECT_NEAR(lhs.data[i], rhs.data[i], 1e-4f);
+    }
+}
+
+TEST(TransformSystem, SettersOnlyMarkDirty)
+{
+    TransformationComponent t(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(0.0f), Vector3f(1.0f));
+    EXPECT_TRUE(t.isDirty());
+    t.setPosition(Vector3f(4.0f, 5.0f, 6.0f));
+    t.setScale(Vector3f(2.0f));
+    EXPECT_TRUE(t.isDirty());
+    expectMatrixNear(t.getTransform(), transform(Vector3f(4.0f, 5.0f, 6.0f), Vector3f(0.0f), Vector3f(2.0f)));
+}
+
+TEST(TransformSystem, WorldMatricesFollowHierarchy)
+{
+    EntityManager manager;
+    JobSystem jobs(2);
+    TransformSystem system(manager, jobs);
+
+    Entity root = manager.create();
+    Entity child = manager.create();
+    Entity grandchild = manager.create();
+    root.assign<TransformationComponent>(Vector3f(10.0f, 0.0f, 0.0f), Vector3f(0.0f, 90.0f, 0.0f), Vector3f(1.0f));
+    child.assign<TransformationComponent>(Vector3f(0.0f, 0.0f, 5.0f), Vector3f(0.0f), Vector3f(2.0f));
+    grandchild.assign<TransformationComponent>(Vector3f(1.0f, 1.0f, 1.0f), Vector3f(0.0f), Vector3f(1.0f));
+
+    EXPECT_TRUE(system.setParent(child, root));
+    EXPECT_TRUE(system.setParent(grandchild, child));
+    EXPECT_FALSE(system.setParent(root, grandchild));
+    system.update();
+
+    const Matrix4f rootLocal = root.get<TransformationComponent>().getTransform();
+    const Matrix4f childLocal = child.get<TransformationComponent>().getTransform();
+    const Matrix4f grandchildLocal = grandchild.get<TransformationComponent>().getTransform();
+    expectMatrixNear(root.get<TransformationComponent>().getWorldTransform(), rootLocal);
+    expectMatrixNear(child.get<TransformationComponent>().getWorldTransform(), rootLocal * childLocal);
+    expectMatrixNear(grandchild.get<TransformationComponent>().getWorldTransform(),
+                     rootLocal * childLocal * grandchildLocal);
+    EXPECT_FALSE(root.get<TransformationComponent>().isDirty());
+
+    // moving the root propagates down the whole subtree
+    root.get<TransformationComponent>().setPosition(Vector3f(-3.0f, 0.0f, 0.0f));
+    system.update();
+    const Matrix4f movedRoot = root.get<TransformationComponent>().getTransform();
+    expectMatrixNear(grandchild.get<TransformationComponent>().getWorldTransform(),
+                     movedRoot * childLocal * grandchildLocal);
+
+    // detaching makes the child a root again
+    system.removeParent(child);
+    system.update();
+    expectMatrixNear(child.get<TransformationComponent>().getWorldTransform(), childLocal);
+    expectMatrixNear(grandchild.get<TransformationComponent>().getWorldTransform(), childLocal * grandchildLocal);
+}
+
+TEST(TransformSystem, WideLevelsAcrossWorkers)
+{
+    EntityManager manager;
+    JobSystem jobs(3);
+    TransformSystem system(manager, jobs);
+
+    Entity root = manager.create();
+    root.assign<TransformationComponent>(Vector3f(0.0f, 1.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f));
+
+    std::vector<Entity> leaves;
+    for (u32 i = 0; i < 2000; i++)
+    {
+        Entity leaf = manager.create();
+        leaf.assign<TransformationComponent>(Vector3f(static_cast<f32>(i), 0.0f, 0.0f), Vector3f(0.0f),
+                                             Vector3f(1.0f));
+        system.setParent(leaf, root);
+        leaves.push_back(leaf);
+    }
+    system.update();
+
+    for (u32 i = 0; i < 2000; i += 97)
+    {
+        const Matrix4f world = leaves[i].get<TransformationComponent>().getWorldTransform();
+        EXPECT_FLOAT_EQ(world.data[12], static_cast<f32>(i));
+        EXPECT_FLOAT_EQ(world.data[13], 1.0f);
+    }
+}
+
+TEST(TransformSystem, StampsOnlyMovedSubtree)
+{
+    EntityManager manager;
+    JobSystem jobs(2);
+    TransformSystem system(manager, jobs);
+
+    Entity root = manager.create();
+    Entity child = manager.create();
+    Entity other = manager.create();
+    root.assign<TransformationComponent>(Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f));
+    child.assign<TransformationComponent>(Vector3f(0.0f, 1.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f));
+    other.assign<TransformationComponent>(Vector3f(0.0f, 0.0f, 1.0f), Vector3f(0.0f), Vector3f(1.0f));
+    system.setParent(child, root);
+    system.update();
+
+    const u64 seen = manager.advanceVersion();
+    system.update();
+    u32 count = 0;
+    manager.changed_since<TransformationComponent>(seen, [&](const TransformationComponent&) { ++count; });
+    EXPECT_EQ(count, 0u);
+
+    root.get<TransformationComponent>().setPosition(Vector3f(2.0f, 0.0f, 0.0f));
+    system.update();
+    count = 0;
+    manager.changed_since<TransformationComponent>(seen, [&](Entity e, const TransformationComponent&) {
+        EXPECT_NE(e.handle(), other.handle());
+        ++count;
+    });
+    EXPECT_EQ(count, 2u);
+}
+
+TEST(TransformSystem, FollowsOwningGroupReorders)
+{
+    EntityManager manager;
+    JobSystem jobs(2);
+    TransformSystem system(manager, jobs);
+
+    Entity parent = manager.create();
+    Entity child = manager.create();
+    parent.assign<TransformationComponent>(Vector3f(10.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f));
+    child.assign<TransformationComponent>(Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f));
+    system.setParent(child, parent);
+
+    auto group = manager.group<TransformationComponent>(Get<TransformGroupMember>{});
+    system.update();
+
+    // joining swaps the child to the front of the transformation pool
+    child.assign<TransformGroupMember>();
+    ASSERT_TRUE(group.contains(child));
+    parent.get<TransformationComponent>().setPosition(Vector3f(20.0f, 0.0f, 0.0f));
+    system.update();
+    expectMatrixNear(parent.get<TransformationComponent>().getWorldTransform(),
+                     transform(Vector3f(20.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f)));
+    expectMatrixNear(child.get<TransformationComponent>().getWorldTransform(),
+                     transform(Vector3f(21.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f)));
+
+    // and leaving swaps it back out
+    child.remove<TransformGroupMember>();
+    parent.get<TransformationComponent>().setPosition(Vector3f(30.0f, 0.0f, 0.0f));
+    system.update();
+    expectMatrixNear(parent.get<TransformationComponent>().getWorldTransform(),
+                     transform(Vector3f(30.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f)));
+    expectMatrixNear(child.get<TransformationComponent>().getWorldTransform(),
+                     transform(Vector3f(31.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f)));
+}
+
+TEST(TransformSystem, FollowsOwningGroupCreation)
+{
+    EntityManager manager;
+    JobSystem jobs(2);
+    TransformSystem system(manager, jobs);
+
+    Entity parent = manager.create();
+    Entity child = manager.create();
+    parent.assign<TransformationComponent>(Vector3f(10.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f));
+    child.assign<TransformationComponent>(Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f));
+    child.assign<TransformGroupMember>();
+    system.setParent(child, parent);
+    system.update();
+
+    // creating the group packs the child at the front of the pool
+    auto group = manager.group<TransformationComponent>(Get<TransformGroupMember>{});
+    ASSERT_EQ(1u, group.size());
+    parent.get<TransformationComponent>().setPosition(Vector3f(20.0f, 0.0f, 0.0f));
+    system.update();
+    expectMatrixNear(parent.get<TransformationComponent>().getWorldTransform(),
+                     transform(Vector3f(20.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f)));
+    expectMatrixNear(child.get<TransformationComponent>().getWorldTransform(),
+                     transform(Vector3f(21.0f, 0.0f, 0.0f), Vector3f(0.0f), Vector3f(1.0f)));
+}
@@ -93,3 +93,38 @@ TEST(Transformations, Transform)
     EXPECT_NEAR(res.z, 0.0f, 0.0001f);
     EXPECT_NEAR(res.w, 1.0f, 0.0001f);
 }
+
+TEST(Transformations, ConstantEvaluation)
+{
+    constexpr Matrix4f translation = translate(Vector3f(5.0f, 2.0f, 4.0f));
+    static_assert(translation.data[12] == 5.0f && translation.data[15] == 1.0f);
+
+    constexpr Matrix4f composed = translation * scale(Vector3f(2.0f));
+    static_assert(composed.data[0] == 2.0f && composed.data[13] == 2.0f);
+
+    constexpr Vector4f point = composed * Vector4f(1.0f, 1.0f, 1.0f, 1.0f);
+    static_assert(point.data[0] == 7.0f && point.data[1] == 4.0f && point.data[2] == 6.0f);
+
+    // folded projections and rotations should match the runtime path
+    constexpr Matrix4f projections[] = {
+        perspective(90.0f, 16.0f / 9.0f, 0.01f, 500.0f),
+        orthographic(-1.0f, 1.0f, -1.0f, 1.0f, 0.1f, 10.0f),
+        transform(Vector3f(1.0f, 0.0f, 0.0f), Vector3f(30.0f, 45.0f, 90.0f), Vector3f(2.0f, 1.0f, 1.0f)),
+    };
+
+    volatile f32 fov = 90.0f;
+    volatile f32 angle = 30.0f;
+    const Matrix4f runtime[] = {
+        perspective(fov, 16.0f / 9.0f, 0.01f, 500.0f),
+        orthographic(-1.0f, 1.0f, -1.0f, 1.0f, 0.1f, 10.0f),
+        transform(Vector3f(1.0f, 0.0f, 0.0f), Vector3f(angle, 45.0f, 90.0f), Vector3f(2.0f, 1.0f, 1.0f)),
+    };
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        for (size_t j = 0; j < 16; ++j)
+        {
+            EXPECT_NEAR(projections[i].data[j], runtime[i].data[j], 0.00001f);
+        }
+    }
+}
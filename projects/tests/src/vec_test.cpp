@@ -0,0 +1,89 @@
+#include <helios/math/vector.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace helios;
+
+TEST(Vec, AliasesKeepExistingTypes)
+{
+    static_assert(std::is_same_v<Vector3f, Vec<f32, 3>>);
+    static_assert(sizeof(Vector3f) == 16 && alignof(Vector3f) == 16);
+    static_assert(sizeof(Vector3d) == 32 && alignof(Vector3d) == 32);
+    static_assert(sizeof(Vector4i) == 16 && alignof(Vector4i) == 16);
+    static_assert(sizeof(Vector8i) == 32 && alignof(Vector8i) == 32);
+    static_assert(sizeof(Vector2i) == 8);
+
+    constexpr Vector3d v(1.0, 2.0, 3.0);
+    static_assert(v[0] == 1.0 && v.data[3] == 0.0);
+}
+
+TEST(Vec, DoubleArithmetic)
+{
+    const Vector4d a(1.0, 2.0, 3.0, 4.0);
+    const Vector4d b(0.5, 0.25, 2.0, -1.0);
+
+    EXPECT_EQ(a + b, Vector4d(1.5, 2.25, 5.0, 3.0));
+    EXPECT_EQ(a - b, Vector4d(0.5, 1.75, 1.0, 5.0));
+    EXPECT_EQ(a * b, Vector4d(0.5, 0.5, 6.0, -4.0));
+    EXPECT_EQ(a / b, Vector4d(2.0, 8.0, 1.5, -4.0));
+    EXPECT_EQ(a * 2.0, Vector4d(2.0, 4.0, 6.0, 8.0));
+    EXPECT_EQ(1.0 + a, Vector4d(2.0, 3.0, 4.0, 5.0));
+    EXPECT_DOUBLE_EQ(dot(a, b), 3.0);
+
+    const Vector3d c(3.0, 0.0, 4.0);
+    const Vector3d d = c / Vector3d(2.0, 1.0, 4.0);
+    EXPECT_EQ(d, Vector3d(1.5, 0.0, 1.0));
+    EXPECT_EQ(d.data[3], 0.0);
+    EXPECT_DOUBLE_EQ(c.length(), 5.0);
+    EXPECT_EQ(cross(Vector3d(1.0, 0.0, 0.0), Vector3d(0.0, 1.0, 0.0)), Vector3d(0.0, 0.0, 1.0));
+}
+
+TEST(Vec, IntegerArithmetic)
+{
+    const Vector3i a(1, -2, 3);
+    const Vector3i b(4, 5, -6);
+
+    EXPECT_EQ(a + b, Vector3i(5, 3, -3));
+    EXPECT_EQ(a - b, Vector3i(-3, -7, 9));
+    EXPECT_EQ(a * b, Vector3i(4, -10, -18));
+    EXPECT_EQ(b / 2, Vector3i(2, 2, -3));
+    EXPECT_EQ(dot(a, b), -24);
+    EXPECT_EQ(a.abs(), Vector3i(1, 2, 3));
+
+    Vector8i c(1, 2, 3, 4, 5, 6, 7, 8);
+    c *= Vector8i(2);
+    c -= 1;
+    EXPECT_EQ(c, Vector8i(1, 3, 5, 7, 9, 11, 13, 15));
+    EXPECT_EQ(c.dot(Vector8i(1)), 64);
+
+    const Vector2i grid(7, -3);
+    EXPECT_EQ(grid * 3, Vector2i(21, -9));
+}
+
+TEST(Vec, Conversion)
+{
+    const Vector3i cell(1, 2, 3);
+    const Vector3d asDouble(cell);
+    EXPECT_EQ(asDouble, Vector3d(1.0, 2.0, 3.0));
+
+    const Vector3f asFloat = asDouble.as<f32>();
+    EXPECT_EQ(asFloat, Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+TEST(Vec, CameraRelative)
+{
+    const Vector3d origin(1.0e7, -2.5e6, 4.0e8);
+    Vector3d positions[] = {
+        origin + Vector3d(0.125, 0.25, -0.5),
+        origin + Vector3d(-1000.0, 3.0, 0.0625),
+        origin,
+    };
+
+    Vector3f relative[3];
+    toCameraRelative(positions, origin, relative, 3);
+
+    EXPECT_EQ(relative[0], Vector3f(0.125f, 0.25f, -0.5f));
+    EXPECT_EQ(relative[1], Vector3f(-1000.0f, 3.0f, 0.0625f));
+    EXPECT_EQ(relative[2], Vector3f(0.0f));
+    EXPECT_EQ(relative[0].data[3], 0.0f);
+}